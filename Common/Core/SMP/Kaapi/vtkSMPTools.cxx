@@ -18,6 +18,7 @@
 #include "vtkCriticalSection.h"
 
 #include <kaapic.h>
+#include <vtksys/SystemTools.hxx>
 
 VTKCOMMONCORE_EXPORT void vtkSMPToolsInitialize()
 {
@@ -56,3 +57,14 @@ int vtkSMPTools::GetEstimatedNumberOfThreads()
 {
   return kaapic_get_concurrency();
 }
+
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  return backend &&
+    vtksys::SystemTools::Strucmp(backend, vtkSMPTools::GetBackend()) == 0;
+}
+
+const char* vtkSMPTools::GetBackend()
+{
+  return "Kaapi";
+}
@@ -19,6 +19,8 @@
 
 #include <algorithm>
 
+#include <vtksys/SystemTools.hxx>
+
 namespace
 {
 int vtkSMPNumberOfSpecifiedThreads = 0;
@@ -61,3 +63,14 @@ void vtk::detail::smp::vtkSMPTools_Impl_For_OpenMP(vtkIdType first,
     functorExecuter(functor, from, grain, last);
     }
 }
+
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  return backend &&
+    vtksys::SystemTools::Strucmp(backend, vtkSMPTools::GetBackend()) == 0;
+}
+
+const char* vtkSMPTools::GetBackend()
+{
+  return "OpenMP";
+}
@@ -0,0 +1,244 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPTools.h"
+
+#include "vtkAtomicTypes.h"
+#include "vtkCriticalSection.h"
+#include "vtkSMPThreadPool.h"
+#include "vtkSMPToolsBackends.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+
+// Runtime implementation: every back-end that was compiled in is reached
+// through the same non-templated ExecuteFunctor entry point, and the
+// thread local storage is keyed on the thread id, so the back-end can be
+// switched between two parallel sections. The initial back-end comes from
+// the VTK_SMP_BACKEND environment variable, the ThreadPool being the
+// default.
+
+namespace
+{
+
+enum
+{
+  VTK_SMP_BACKEND_SEQUENTIAL = 0,
+  VTK_SMP_BACKEND_THREADPOOL,
+  VTK_SMP_BACKEND_OPENMP,
+  VTK_SMP_BACKEND_TBB,
+  VTK_SMP_NUMBER_OF_BACKENDS
+};
+
+const char* const vtkSMPToolsBackendNames[VTK_SMP_NUMBER_OF_BACKENDS] =
+{
+  "Sequential",
+  "ThreadPool",
+  "OpenMP",
+  "TBB"
+};
+
+// The back-end in use, -1 until it is chosen. It is read without the lock
+// once set, so it is set only after the back-end is initialized.
+vtkAtomicInt32 vtkSMPToolsBackend(-1);
+int vtkSMPToolsNumberOfThreads = 0;
+vtkSimpleCriticalSection vtkSMPToolsBackendCS;
+
+//--------------------------------------------------------------------------------
+bool vtkSMPToolsIsBackendAvailable(int backend)
+{
+  switch (backend)
+    {
+    case VTK_SMP_BACKEND_SEQUENTIAL:
+    case VTK_SMP_BACKEND_THREADPOOL:
+      return true;
+    case VTK_SMP_BACKEND_OPENMP:
+#ifdef VTK_SMP_ENABLE_OPENMP
+      return true;
+#else
+      return false;
+#endif
+    case VTK_SMP_BACKEND_TBB:
+#ifdef VTK_SMP_ENABLE_TBB
+      return true;
+#else
+      return false;
+#endif
+    default:
+      return false;
+    }
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPToolsFindBackend(const char* name)
+{
+  if (name)
+    {
+    for (int i = 0; i < VTK_SMP_NUMBER_OF_BACKENDS; ++i)
+      {
+      if (vtksys::SystemTools::Strucmp(name, vtkSMPToolsBackendNames[i]) == 0)
+        {
+        return vtkSMPToolsIsBackendAvailable(i) ? i : -1;
+        }
+      }
+    }
+  return -1;
+}
+
+//--------------------------------------------------------------------------------
+// Must be called with vtkSMPToolsBackendCS held.
+void vtkSMPToolsInitializeBackend(int backend, int numThreads)
+{
+  switch (backend)
+    {
+    case VTK_SMP_BACKEND_THREADPOOL:
+      vtk::detail::smp::vtkSMPThreadPoolInitialize(numThreads);
+      break;
+#ifdef VTK_SMP_ENABLE_OPENMP
+    case VTK_SMP_BACKEND_OPENMP:
+      vtk::detail::smp::vtkSMPToolsOpenMPInitialize(numThreads);
+      break;
+#endif
+#ifdef VTK_SMP_ENABLE_TBB
+    case VTK_SMP_BACKEND_TBB:
+      vtk::detail::smp::vtkSMPToolsTBBInitialize(numThreads);
+      break;
+#endif
+    default:
+      break;
+    }
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPToolsGetBackend()
+{
+  if (vtkSMPToolsBackend < 0)
+    {
+    vtkSMPToolsBackendCS.Lock();
+    if (vtkSMPToolsBackend < 0)
+      {
+      int backend = vtkSMPToolsFindBackend(getenv("VTK_SMP_BACKEND"));
+      if (backend < 0)
+        {
+        backend = VTK_SMP_BACKEND_THREADPOOL;
+        }
+      vtkSMPToolsInitializeBackend(backend, vtkSMPToolsNumberOfThreads);
+      vtkSMPToolsBackend = backend;
+      }
+    vtkSMPToolsBackendCS.Unlock();
+    }
+  return vtkSMPToolsBackend;
+}
+
+} // anonymous namespace
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::Initialize(int numThreads)
+{
+  int backend = vtkSMPToolsGetBackend();
+  vtkSMPToolsBackendCS.Lock();
+  if (numThreads > 0)
+    {
+    vtkSMPToolsNumberOfThreads = numThreads;
+    }
+  vtkSMPToolsInitializeBackend(backend, numThreads);
+  vtkSMPToolsBackendCS.Unlock();
+}
+
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  return vtk::detail::smp::GetNumberOfThreads();
+}
+
+bool vtkSMPTools::SetBackend(const char* name)
+{
+  int backend = vtkSMPToolsFindBackend(name);
+  if (backend < 0)
+    {
+    return false;
+    }
+
+  vtkSMPToolsGetBackend();
+  vtkSMPToolsBackendCS.Lock();
+  if (backend != vtkSMPToolsBackend)
+    {
+    vtkSMPToolsInitializeBackend(backend, vtkSMPToolsNumberOfThreads);
+    vtkSMPToolsBackend = backend;
+    }
+  vtkSMPToolsBackendCS.Unlock();
+  return true;
+}
+
+const char* vtkSMPTools::GetBackend()
+{
+  return vtkSMPToolsBackendNames[vtkSMPToolsGetBackend()];
+}
+
+//--------------------------------------------------------------------------------
+int vtk::detail::smp::GetNumberOfThreads()
+{
+  switch (vtkSMPToolsGetBackend())
+    {
+    case VTK_SMP_BACKEND_THREADPOOL:
+      return vtk::detail::smp::vtkSMPThreadPoolGetNumberOfThreads();
+#ifdef VTK_SMP_ENABLE_OPENMP
+    case VTK_SMP_BACKEND_OPENMP:
+      return vtk::detail::smp::vtkSMPToolsOpenMPGetNumberOfThreads();
+#endif
+#ifdef VTK_SMP_ENABLE_TBB
+    case VTK_SMP_BACKEND_TBB:
+      return vtk::detail::smp::vtkSMPToolsTBBGetNumberOfThreads();
+#endif
+    default:
+      return 1;
+    }
+}
+
+void vtk::detail::smp::vtkSMPTools_Impl_For_Runtime(vtkIdType first,
+  vtkIdType last, vtkIdType grain, ExecuteFunctorPtrType functorExecuter,
+  void *functor)
+{
+  switch (vtkSMPToolsGetBackend())
+    {
+    case VTK_SMP_BACKEND_THREADPOOL:
+      vtk::detail::smp::vtkSMPThreadPoolFor(first, last, grain,
+                                             functorExecuter, functor);
+      break;
+#ifdef VTK_SMP_ENABLE_OPENMP
+    case VTK_SMP_BACKEND_OPENMP:
+      vtk::detail::smp::vtkSMPToolsOpenMPFor(first, last, grain,
+                                              functorExecuter, functor);
+      break;
+#endif
+#ifdef VTK_SMP_ENABLE_TBB
+    case VTK_SMP_BACKEND_TBB:
+      vtk::detail::smp::vtkSMPToolsTBBFor(first, last, grain,
+                                           functorExecuter, functor);
+      break;
+#endif
+    default:
+      // Sequential: same chunking as the Sequential implementation.
+      if (grain <= 0)
+        {
+        grain = last - first;
+        }
+      for (vtkIdType from = first; from < last; from += grain)
+        {
+        functorExecuter(functor, from, grain, last);
+        }
+      break;
+    }
+}
@@ -0,0 +1,49 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsBackends.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Private entry points of the optional back-ends of the Runtime SMP
+// implementation. Each group is compiled in its own translation unit so that
+// only that unit needs the OpenMP flags or the TBB headers. Not installed.
+
+#ifndef vtkSMPToolsBackends_h
+#define vtkSMPToolsBackends_h
+
+#include "vtkSMPTools.h"
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+// Defined in vtkSMPToolsOpenMP.cxx when VTK_SMP_ENABLE_OPENMP is on.
+void vtkSMPToolsOpenMPInitialize(int numThreads);
+int vtkSMPToolsOpenMPGetNumberOfThreads();
+void vtkSMPToolsOpenMPFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+                          ExecuteFunctorPtrType functorExecuter,
+                          void *functor);
+
+// Defined in vtkSMPToolsTBB.cxx when VTK_SMP_ENABLE_TBB is on.
+void vtkSMPToolsTBBInitialize(int numThreads);
+int vtkSMPToolsTBBGetNumberOfThreads();
+void vtkSMPToolsTBBFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+                       ExecuteFunctorPtrType functorExecuter, void *functor);
+
+}
+}
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsBackends.h
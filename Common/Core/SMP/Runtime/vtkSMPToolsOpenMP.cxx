@@ -0,0 +1,54 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsOpenMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPToolsBackends.h"
+
+#include <omp.h>
+
+namespace
+{
+int vtkSMPOpenMPNumberOfSpecifiedThreads = 0;
+}
+
+void vtk::detail::smp::vtkSMPToolsOpenMPInitialize(int numThreads)
+{
+  // The number of threads is passed to every parallel region instead of
+  // calling omp_set_num_threads(), which only affects the calling thread.
+  vtkSMPOpenMPNumberOfSpecifiedThreads = numThreads > 0 ? numThreads : 0;
+}
+
+int vtk::detail::smp::vtkSMPToolsOpenMPGetNumberOfThreads()
+{
+  return vtkSMPOpenMPNumberOfSpecifiedThreads ?
+    vtkSMPOpenMPNumberOfSpecifiedThreads : omp_get_max_threads();
+}
+
+void vtk::detail::smp::vtkSMPToolsOpenMPFor(vtkIdType first,
+  vtkIdType last, vtkIdType grain, ExecuteFunctorPtrType functorExecuter,
+  void *functor)
+{
+  int numThreads = vtkSMPToolsOpenMPGetNumberOfThreads();
+  if (grain <= 0)
+    {
+    vtkIdType estimateGrain = (last - first)/(numThreads * 4);
+    grain = (estimateGrain > 0) ? estimateGrain : 1;
+    }
+
+# pragma omp parallel for schedule(runtime) num_threads(numThreads)
+  for (vtkIdType from = first; from < last; from += grain)
+    {
+    functorExecuter(functor, from, grain, last);
+    }
+}
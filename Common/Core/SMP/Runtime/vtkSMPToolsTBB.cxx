@@ -0,0 +1,80 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsTBB.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPToolsBackends.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_scheduler_init.h>
+
+namespace
+{
+tbb::task_scheduler_init vtkSMPToolsTBBScheduler(
+  tbb::task_scheduler_init::deferred);
+int vtkSMPToolsTBBNumSpecifiedThreads = 0;
+
+class vtkSMPToolsTBBFuncCall
+{
+  vtk::detail::smp::ExecuteFunctorPtrType Executer;
+  void *Functor;
+
+public:
+  vtkSMPToolsTBBFuncCall(vtk::detail::smp::ExecuteFunctorPtrType executer,
+                         void *functor)
+    : Executer(executer), Functor(functor)
+    {
+    }
+
+  void operator() (const tbb::blocked_range<vtkIdType>& r) const
+    {
+      this->Executer(this->Functor, r.begin(), r.end() - r.begin(), r.end());
+    }
+};
+}
+
+void vtk::detail::smp::vtkSMPToolsTBBInitialize(int numThreads)
+{
+  // The caller serializes Initialize() and SetBackend().
+  if (numThreads > 0 && numThreads != vtkSMPToolsTBBNumSpecifiedThreads)
+    {
+    if (vtkSMPToolsTBBScheduler.is_active())
+      {
+      vtkSMPToolsTBBScheduler.terminate();
+      }
+    vtkSMPToolsTBBScheduler.initialize(numThreads);
+    vtkSMPToolsTBBNumSpecifiedThreads = numThreads;
+    }
+}
+
+int vtk::detail::smp::vtkSMPToolsTBBGetNumberOfThreads()
+{
+  return vtkSMPToolsTBBNumSpecifiedThreads ?
+    vtkSMPToolsTBBNumSpecifiedThreads :
+    tbb::task_scheduler_init::default_num_threads();
+}
+
+void vtk::detail::smp::vtkSMPToolsTBBFor(vtkIdType first, vtkIdType last,
+  vtkIdType grain, ExecuteFunctorPtrType functorExecuter, void *functor)
+{
+  vtkSMPToolsTBBFuncCall call(functorExecuter, functor);
+  if (grain > 0)
+    {
+    tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last, grain), call);
+    }
+  else
+    {
+    tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last), call);
+    }
+}
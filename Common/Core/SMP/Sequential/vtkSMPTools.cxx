@@ -15,6 +15,8 @@
 
 #include "vtkSMPTools.h"
 
+#include <vtksys/SystemTools.hxx>
+
 // Simple implementation that runs everything sequentially.
 
 //--------------------------------------------------------------------------------
@@ -26,3 +28,14 @@ int vtkSMPTools::GetEstimatedNumberOfThreads()
 {
   return 1;
 }
+
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  return backend &&
+    vtksys::SystemTools::Strucmp(backend, vtkSMPTools::GetBackend()) == 0;
+}
+
+const char* vtkSMPTools::GetBackend()
+{
+  return "Sequential";
+}
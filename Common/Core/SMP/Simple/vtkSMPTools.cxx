@@ -17,6 +17,8 @@
 
 #include "vtkObjectFactory.h"
 
+#include <vtksys/SystemTools.hxx>
+
 #include <pthread.h>
 
 static bool vtkSMPToolsInitialized = false;
@@ -62,11 +64,14 @@ VTKCOMMONCORE_EXPORT std::vector<vtkMultiThreaderIDType>& vtkSMPToolsGetThreadId
 //--------------------------------------------------------------------------------
 void vtkSMPTools::Initialize(int nThreads)
 {
-  if (vtkSMPToolsInitialized)
+  // The threads are started by each parallel section: another number of
+  // threads only needs to be recorded.
+  if (vtkSMPToolsInitialized &&
+      (nThreads <= 0 || nThreads == vtkSMPToolsNumberOfThreads))
     {
     return;
     }
-  if (nThreads == 0)
+  if (nThreads <= 0)
     {
     vtkSMPToolsNumberOfThreads =
       vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
@@ -86,3 +91,14 @@ int vtkSMPTools::GetEstimatedNumberOfThreads()
 {
   return vtkSMPToolsNumberOfThreads;
 }
+
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  return backend &&
+    vtksys::SystemTools::Strucmp(backend, vtkSMPTools::GetBackend()) == 0;
+}
+
+const char* vtkSMPTools::GetBackend()
+{
+  return "Simple";
+}
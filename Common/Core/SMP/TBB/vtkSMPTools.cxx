@@ -19,16 +19,10 @@
 
 #include <tbb/task_scheduler_init.h>
 
-struct vtkSMPToolsInit
-{
-  tbb::task_scheduler_init Init;
+#include <vtksys/SystemTools.hxx>
 
-  vtkSMPToolsInit(int numThreads) : Init(numThreads)
-    {
-    }
-};
-
-static bool vtkSMPToolsInitialized = 0;
+static tbb::task_scheduler_init vtkSMPToolsTBBInit(
+  tbb::task_scheduler_init::deferred);
 static int vtkTBBNumSpecifiedThreads = 0;
 static vtkSimpleCriticalSection vtkSMPToolsCS;
 
@@ -36,16 +30,16 @@ static vtkSimpleCriticalSection vtkSMPToolsCS;
 void vtkSMPTools::Initialize(int numThreads)
 {
   vtkSMPToolsCS.Lock();
-  if (!vtkSMPToolsInitialized)
+  // If numThreads <= 0, don't initialize the scheduler and let TBB do the
+  // default thing. A different positive number re-creates the scheduler.
+  if (numThreads > 0 && numThreads != vtkTBBNumSpecifiedThreads)
     {
-    // If numThreads <= 0, don't create a task_scheduler_init
-    // and let TBB do the default thing.
-    if (numThreads > 0)
+    if (vtkSMPToolsTBBInit.is_active())
       {
-      static vtkSMPToolsInit aInit(numThreads);
-      vtkTBBNumSpecifiedThreads = numThreads;
+      vtkSMPToolsTBBInit.terminate();
       }
-    vtkSMPToolsInitialized = true;
+    vtkSMPToolsTBBInit.initialize(numThreads);
+    vtkTBBNumSpecifiedThreads = numThreads;
     }
   vtkSMPToolsCS.Unlock();
 }
@@ -55,3 +49,14 @@ int vtkSMPTools::GetEstimatedNumberOfThreads()
   return vtkTBBNumSpecifiedThreads ? vtkTBBNumSpecifiedThreads
     : tbb::task_scheduler_init::default_num_threads();
 }
+
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  return backend &&
+    vtksys::SystemTools::Strucmp(backend, vtkSMPTools::GetBackend()) == 0;
+}
+
+const char* vtkSMPTools::GetBackend()
+{
+  return "TBB";
+}
@@ -0,0 +1,510 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPThreadPool.h"
+
+#include "vtkConditionVariable.h"
+#include "vtkCriticalSection.h"
+#include "vtkDebugLeaksManager.h" // The pool owns a vtkMultiThreader.
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+
+#include <vector>
+
+// Persistent, work-stealing thread pool. The worker threads are spawned
+// on first use (or by vtkSMPTools::Initialize()) and sleep on a condition
+// variable between parallel sections. Every call to vtkSMPTools::For() becomes a
+// job: its range is cut into chunks of "grain" items and the chunk indices
+// are dealt out in contiguous partitions, one per pool thread. Each thread
+// consumes its own partition from the front and, once it is empty, steals
+// half of the remaining chunks from the back of another partition. The
+// calling thread always takes part in the job it created, so a For() called
+// from within a running functor (nested parallelism) simply publishes a new
+// job that idle workers can help with, without ever creating more threads
+// than the pool holds.
+
+namespace
+{
+
+typedef vtk::detail::smp::ExecuteFunctorPtrType ExecuteFunctorPtrType;
+
+//--------------------------------------------------------------------------------
+// Range of chunk indices [Begin, End) owned by one thread of a job.
+struct vtkSMPThreadPoolPartition
+{
+  vtkSimpleCriticalSection Lock;
+  vtkIdType Begin;
+  vtkIdType End;
+
+  vtkSMPThreadPoolPartition() : Begin(0), End(0)
+  {
+  }
+};
+
+//--------------------------------------------------------------------------------
+class vtkSMPThreadPoolJob
+{
+public:
+  vtkSMPThreadPoolJob(int numberOfPartitions, vtkIdType first,
+                      vtkIdType last, vtkIdType grain,
+                      ExecuteFunctorPtrType executer, void *functor)
+    : NumberOfPartitions(numberOfPartitions),
+      First(first),
+      Last(last),
+      Grain(grain),
+      Executer(executer),
+      Functor(functor),
+      Done(false),
+      Participants(0)
+  {
+    vtkIdType numberOfChunks = (last - first + grain - 1) / grain;
+    this->Unclaimed = numberOfChunks;
+    this->Remaining = numberOfChunks;
+
+    this->Partitions = new vtkSMPThreadPoolPartition[numberOfPartitions];
+    vtkIdType chunksPerPartition = numberOfChunks / numberOfPartitions;
+    vtkIdType extraChunks = numberOfChunks % numberOfPartitions;
+    vtkIdType begin = 0;
+    for (int i = 0; i < numberOfPartitions; ++i)
+      {
+      vtkIdType end = begin + chunksPerPartition + (i < extraChunks ? 1 : 0);
+      this->Partitions[i].Begin = begin;
+      this->Partitions[i].End = end;
+      begin = end;
+      }
+  }
+
+  ~vtkSMPThreadPoolJob()
+  {
+    delete [] this->Partitions;
+  }
+
+  // Description:
+  // Returns true if some chunks have not been claimed by any thread yet.
+  bool HasUnclaimedChunks() const
+  {
+    return this->Unclaimed.load() > 0;
+  }
+
+  // Description:
+  // Execute chunks on behalf of the pool thread owning the given partition
+  // until there is nothing left to claim in the whole job.
+  void Run(int partition)
+  {
+    vtkIdType chunk;
+    while (this->ClaimChunk(partition, chunk))
+      {
+      this->Executer(this->Functor, this->First + chunk * this->Grain,
+                     this->Grain, this->Last);
+      if (--this->Remaining == 0)
+        {
+        this->DoneLock.Lock();
+        this->Done = true;
+        this->DoneCondition.Broadcast();
+        this->DoneLock.Unlock();
+        }
+      }
+  }
+
+  // Description:
+  // Block until every chunk of the job has been executed.
+  void WaitForCompletion()
+  {
+    this->DoneLock.Lock();
+    while (!this->Done)
+      {
+      this->DoneCondition.Wait(this->DoneLock);
+      }
+    this->DoneLock.Unlock();
+  }
+
+  // Description:
+  // Record that a worker thread picked the job from the pool's list and may
+  // look at it until it calls Leave().
+  void Join()
+  {
+    this->DoneLock.Lock();
+    ++this->Participants;
+    this->DoneLock.Unlock();
+  }
+
+  // Description:
+  // Record that a worker thread returned from Run() and will not look at
+  // the job anymore.
+  void Leave()
+  {
+    this->DoneLock.Lock();
+    if (--this->Participants == 0)
+      {
+      this->DoneCondition.Broadcast();
+      }
+    this->DoneLock.Unlock();
+  }
+
+  // Description:
+  // Block until every worker thread that joined the job left it. The job
+  // cannot be destroyed before.
+  void WaitForParticipants()
+  {
+    this->DoneLock.Lock();
+    while (this->Participants > 0)
+      {
+      this->DoneCondition.Wait(this->DoneLock);
+      }
+    this->DoneLock.Unlock();
+  }
+
+private:
+  bool ClaimChunk(int partition, vtkIdType& chunk)
+  {
+    vtkSMPThreadPoolPartition& own = this->Partitions[partition];
+    own.Lock.Lock();
+    if (own.Begin < own.End)
+      {
+      chunk = own.Begin++;
+      own.Lock.Unlock();
+      --this->Unclaimed;
+      return true;
+      }
+    own.Lock.Unlock();
+
+    // Our partition is exhausted, steal the back half of someone else's.
+    for (int i = 1; i < this->NumberOfPartitions && this->HasUnclaimedChunks();
+         ++i)
+      {
+      vtkSMPThreadPoolPartition& victim =
+        this->Partitions[(partition + i) % this->NumberOfPartitions];
+      victim.Lock.Lock();
+      vtkIdType available = victim.End - victim.Begin;
+      if (available > 0)
+        {
+        vtkIdType end = victim.End;
+        vtkIdType begin = end - (available + 1) / 2;
+        victim.End = begin;
+        victim.Lock.Unlock();
+
+        chunk = begin;
+        if (end - begin > 1)
+          {
+          own.Lock.Lock();
+          own.Begin = begin + 1;
+          own.End = end;
+          own.Lock.Unlock();
+          }
+        --this->Unclaimed;
+        return true;
+        }
+      victim.Lock.Unlock();
+      }
+    return false;
+  }
+
+  vtkSMPThreadPoolPartition *Partitions;
+  int NumberOfPartitions;
+  vtkIdType First;
+  vtkIdType Last;
+  vtkIdType Grain;
+  ExecuteFunctorPtrType Executer;
+  void *Functor;
+
+  vtkAtomic<vtkIdType> Unclaimed;
+  vtkAtomic<vtkIdType> Remaining;
+  vtkSimpleMutexLock DoneLock;
+  vtkSimpleConditionVariable DoneCondition;
+  bool Done;
+  // Number of worker threads between Join() and Leave(), protected by
+  // DoneLock.
+  int Participants;
+
+  vtkSMPThreadPoolJob(const vtkSMPThreadPoolJob&); // Not implemented.
+  void operator=(const vtkSMPThreadPoolJob&); // Not implemented.
+};
+
+//--------------------------------------------------------------------------------
+class vtkSMPThreadPool
+{
+public:
+  vtkSMPThreadPool()
+    : NumberOfThreads(0), Initialized(false), Shutdown(false),
+      Threader(NULL), NumberOfStartedWorkers(0)
+  {
+  }
+
+  ~vtkSMPThreadPool()
+  {
+    this->Finalize();
+  }
+
+  void Initialize(int numThreads);
+
+  int GetNumberOfThreads()
+  {
+    this->Initialize(0);
+    return this->NumberOfThreads;
+  }
+
+  void For(vtkIdType first, vtkIdType last, vtkIdType grain,
+           ExecuteFunctorPtrType executer, void *functor);
+
+private:
+  struct WorkerInfo
+  {
+    vtkSMPThreadPool *Pool;
+    int Index;
+    int SpawnId;
+  };
+
+  static VTK_THREAD_RETURN_TYPE WorkerMain(void *arg);
+  void WorkerLoop(int index);
+  vtkSMPThreadPoolJob* FindJob();
+  int GetCurrentThreadIndex();
+  void Finalize();
+
+  int NumberOfThreads;
+  bool Initialized;
+  bool Shutdown;
+  vtkSimpleCriticalSection InitializeLock;
+
+  vtkMultiThreader *Threader;
+  std::vector<WorkerInfo> Workers;
+  // Raw ids of the worker threads, WorkerIds[i] belongs to pool thread i + 1.
+  // Pool thread 0 is whichever thread calls For() from outside the pool.
+  std::vector<vtkMultiThreaderIDType> WorkerIds;
+  int NumberOfStartedWorkers;
+
+  // Jobs that may still have unclaimed chunks, protected by JobsLock.
+  std::vector<vtkSMPThreadPoolJob*> Jobs;
+  vtkSimpleMutexLock JobsLock;
+  vtkSimpleConditionVariable JobsCondition;
+};
+
+vtkSMPThreadPool vtkSMPToolsThreadPool;
+
+//--------------------------------------------------------------------------------
+void vtkSMPThreadPool::Initialize(int numThreads)
+{
+  this->InitializeLock.Lock();
+  if (this->Initialized &&
+      (numThreads <= 0 || numThreads == this->NumberOfThreads))
+    {
+    this->InitializeLock.Unlock();
+    return;
+    }
+
+  // A different number of threads was requested: retire the current
+  // workers. This must not happen while a parallel section is running.
+  this->Finalize();
+
+  this->NumberOfThreads = numThreads > 0 ? numThreads :
+    vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  // Spawned threads are limited to VTK_MAX_THREADS by vtkMultiThreader and
+  // the calling thread always takes part in the work.
+  if (this->NumberOfThreads > VTK_MAX_THREADS + 1)
+    {
+    this->NumberOfThreads = VTK_MAX_THREADS + 1;
+    }
+
+  int numWorkers = this->NumberOfThreads - 1;
+  if (numWorkers > 0)
+    {
+    this->Threader = vtkMultiThreader::New();
+    this->Workers.resize(numWorkers);
+    this->WorkerIds.resize(numWorkers);
+
+    this->JobsLock.Lock();
+    for (int i = 0; i < numWorkers; ++i)
+      {
+      WorkerInfo& info = this->Workers[i];
+      info.Pool = this;
+      info.Index = i + 1;
+      info.SpawnId = this->Threader->SpawnThread(
+        vtkSMPThreadPool::WorkerMain, &info);
+      }
+    // Wait until every worker registered its id, after which WorkerIds is
+    // only ever read.
+    while (this->NumberOfStartedWorkers < numWorkers)
+      {
+      this->JobsCondition.Wait(this->JobsLock);
+      }
+    this->JobsLock.Unlock();
+    }
+
+  this->Initialized = true;
+  this->InitializeLock.Unlock();
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPThreadPool::Finalize()
+{
+  if (!this->Threader)
+    {
+    return;
+    }
+
+  this->JobsLock.Lock();
+  this->Shutdown = true;
+  this->JobsCondition.Broadcast();
+  this->JobsLock.Unlock();
+
+  for (size_t i = 0; i < this->Workers.size(); ++i)
+    {
+    this->Threader->TerminateThread(this->Workers[i].SpawnId);
+    }
+  this->Threader->Delete();
+  this->Threader = NULL;
+
+  this->Workers.clear();
+  this->WorkerIds.clear();
+  this->NumberOfStartedWorkers = 0;
+  this->Shutdown = false;
+}
+
+//--------------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkSMPThreadPool::WorkerMain(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *threadInfo =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  WorkerInfo *info = static_cast<WorkerInfo*>(threadInfo->UserData);
+  info->Pool->WorkerLoop(info->Index);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPThreadPool::WorkerLoop(int index)
+{
+  this->JobsLock.Lock();
+  this->WorkerIds[index - 1] = vtkMultiThreader::GetCurrentThreadID();
+  ++this->NumberOfStartedWorkers;
+  this->JobsCondition.Broadcast();
+
+  while (!this->Shutdown)
+    {
+    vtkSMPThreadPoolJob *job = this->FindJob();
+    if (!job)
+      {
+      this->JobsCondition.Wait(this->JobsLock);
+      continue;
+      }
+    job->Join();
+    this->JobsLock.Unlock();
+
+    job->Run(index);
+    job->Leave();
+
+    this->JobsLock.Lock();
+    }
+  this->JobsLock.Unlock();
+}
+
+//--------------------------------------------------------------------------------
+// Must be called with JobsLock held. The most recently published job is
+// preferred so that nested parallel sections, which block their parent
+// chunk, complete first.
+vtkSMPThreadPoolJob* vtkSMPThreadPool::FindJob()
+{
+  for (size_t i = this->Jobs.size(); i > 0; --i)
+    {
+    if (this->Jobs[i - 1]->HasUnclaimedChunks())
+      {
+      return this->Jobs[i - 1];
+      }
+    }
+  return NULL;
+}
+
+//--------------------------------------------------------------------------------
+int vtkSMPThreadPool::GetCurrentThreadIndex()
+{
+  vtkMultiThreaderIDType id = vtkMultiThreader::GetCurrentThreadID();
+  for (size_t i = 0; i < this->WorkerIds.size(); ++i)
+    {
+    if (vtkMultiThreader::ThreadsEqual(this->WorkerIds[i], id))
+      {
+      return static_cast<int>(i) + 1;
+      }
+    }
+  return 0;
+}
+
+//--------------------------------------------------------------------------------
+void vtkSMPThreadPool::For(vtkIdType first, vtkIdType last, vtkIdType grain,
+                           ExecuteFunctorPtrType executer, void *functor)
+{
+  this->Initialize(0);
+
+  if (this->NumberOfThreads == 1)
+    {
+    for (vtkIdType from = first; from < last; from += grain)
+      {
+      executer(functor, from, grain, last);
+      }
+    return;
+    }
+
+  vtkSMPThreadPoolJob job(this->NumberOfThreads, first, last, grain,
+                          executer, functor);
+
+  this->JobsLock.Lock();
+  this->Jobs.push_back(&job);
+  this->JobsCondition.Broadcast();
+  this->JobsLock.Unlock();
+
+  job.Run(this->GetCurrentThreadIndex());
+  job.WaitForCompletion();
+
+  this->JobsLock.Lock();
+  for (size_t i = 0; i < this->Jobs.size(); ++i)
+    {
+    if (this->Jobs[i] == &job)
+      {
+      this->Jobs.erase(this->Jobs.begin() + i);
+      break;
+      }
+    }
+  this->JobsLock.Unlock();
+
+  // Workers only pick jobs from the list, so once the job is removed no new
+  // participant can show up and the current ones are about to leave Run().
+  // They may be preempted before they leave, so sleep rather than spin.
+  job.WaitForParticipants();
+}
+
+} // anonymous namespace
+
+//--------------------------------------------------------------------------------
+void vtk::detail::smp::vtkSMPThreadPoolInitialize(int numThreads)
+{
+  vtkSMPToolsThreadPool.Initialize(numThreads);
+}
+
+int vtk::detail::smp::vtkSMPThreadPoolGetNumberOfThreads()
+{
+  return vtkSMPToolsThreadPool.GetNumberOfThreads();
+}
+
+void vtk::detail::smp::vtkSMPThreadPoolFor(vtkIdType first, vtkIdType last,
+  vtkIdType grain, ExecuteFunctorPtrType functorExecuter, void *functor)
+{
+  if (grain <= 0)
+    {
+    // Use several chunks per thread so that stealing has something to
+    // balance with when the cost per item is irregular.
+    vtkIdType estimateGrain = (last - first) /
+      (vtkSMPToolsThreadPool.GetNumberOfThreads() * 8);
+    grain = (estimateGrain > 0) ? estimateGrain : 1;
+    }
+
+  vtkSMPToolsThreadPool.For(first, last, grain, functorExecuter, functor);
+}
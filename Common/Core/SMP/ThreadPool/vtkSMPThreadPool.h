@@ -0,0 +1,46 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadPool.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Private entry points of the work-stealing thread pool. They are shared by
+// the ThreadPool back-end and by the Runtime back-end, which can switch to
+// the pool at run time. Not installed.
+
+#ifndef vtkSMPThreadPool_h
+#define vtkSMPThreadPool_h
+
+#include "vtkSMPTools.h"
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+// Start the pool with the given number of threads (0 means the number of
+// processors). Calling it again with a different positive count restarts
+// the workers; it must not be called while a parallel section is running.
+void vtkSMPThreadPoolInitialize(int numThreads);
+
+int vtkSMPThreadPoolGetNumberOfThreads();
+
+void vtkSMPThreadPoolFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+                         ExecuteFunctorPtrType functorExecuter, void *functor);
+
+}
+}
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPThreadPool.h
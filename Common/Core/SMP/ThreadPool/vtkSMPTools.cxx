@@ -0,0 +1,55 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPTools.h"
+
+#include "vtkSMPThreadPool.h"
+
+#include <vtksys/SystemTools.hxx>
+
+//--------------------------------------------------------------------------------
+void vtkSMPTools::Initialize(int numThreads)
+{
+  vtk::detail::smp::vtkSMPThreadPoolInitialize(numThreads);
+}
+
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  return vtk::detail::smp::vtkSMPThreadPoolGetNumberOfThreads();
+}
+
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  return backend &&
+    vtksys::SystemTools::Strucmp(backend, vtkSMPTools::GetBackend()) == 0;
+}
+
+const char* vtkSMPTools::GetBackend()
+{
+  return "ThreadPool";
+}
+
+int vtk::detail::smp::GetNumberOfThreads()
+{
+  return vtk::detail::smp::vtkSMPThreadPoolGetNumberOfThreads();
+}
+
+void vtk::detail::smp::vtkSMPTools_Impl_For_ThreadPool(vtkIdType first,
+  vtkIdType last, vtkIdType grain, ExecuteFunctorPtrType functorExecuter,
+  void *functor)
+{
+  vtk::detail::smp::vtkSMPThreadPoolFor(first, last, grain,
+                                         functorExecuter, functor);
+}
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArrayAllocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+
+// This test verifies that data arrays allocate their memory with their
+// allocator, or the default one, and that the allocators account for it.
+
+#define CHECK(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+bool IsAligned(void* pointer, size_t alignment)
+{
+  return reinterpret_cast<size_t>(pointer) % alignment == 0;
+}
+}
+
+int TestDataArrayAllocator(int, char *[])
+{
+  // Without allocator, arrays use malloc().
+  CHECK(vtkDataArrayAllocator::GetDefaultAllocator() == NULL,
+        "Unexpected default allocator.");
+
+  // Aligned memory, accounted for as it grows and shrinks.
+  vtkNew<vtkDataArrayAllocator> allocator;
+  CHECK(allocator->GetAlignment() == 64, "Wrong default alignment.");
+  vtkFloatArray* floats = vtkFloatArray::New();
+  floats->SetAllocator(allocator.GetPointer());
+  for (int i = 0; i < 10000; ++i)
+    {
+    floats->InsertNextValue(i);
+    CHECK(IsAligned(floats->GetPointer(0), 64), "Unaligned memory.");
+    }
+  CHECK(floats->GetValue(9999) == 9999.0f, "Values lost while growing.");
+  CHECK(allocator->GetAllocatedMemory(VTK_FLOAT) ==
+        floats->GetSize() * static_cast<vtkIdType>(sizeof(float)) &&
+        allocator->GetNumberOfAllocations() == 1, "Wrong accounting.");
+  floats->Squeeze();
+  CHECK(allocator->GetAllocatedMemory() == 10000 * 4 &&
+        floats->GetValue(9999) == 9999.0f, "Wrong accounting after Squeeze.");
+
+  // Shared memory is freed by the last array using it.
+  vtkFloatArray* copy = vtkFloatArray::New();
+  copy->ShallowCopy(floats);
+  floats->Delete();
+  CHECK(allocator->GetNumberOfAllocations() == 1 &&
+        copy->GetValue(42) == 42.0f, "Shared memory freed.");
+  copy->Delete();
+  CHECK(allocator->GetAllocatedMemory() == 0 &&
+        allocator->GetNumberOfAllocations() == 0, "Memory not freed.");
+
+  // The default allocator, used by all arrays, accounts per data type.
+  vtkDataArrayAllocator::SetDefaultAllocator(allocator.GetPointer());
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetNumberOfValues(100);
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetNumberOfComponents(3);
+  doubles->SetNumberOfTuples(100);
+  vtkDataArrayAllocator::SetDefaultAllocator(NULL);
+  CHECK(allocator->GetAllocatedMemory(VTK_ID_TYPE) ==
+        100 * static_cast<vtkTypeInt64>(sizeof(vtkIdType)) &&
+        allocator->GetAllocatedMemory(VTK_DOUBLE) == 300 * 8 &&
+        allocator->GetAllocatedMemory(VTK_FLOAT) == 0,
+        "Wrong accounting per data type.");
+  CHECK(IsAligned(doubles->GetPointer(0), 64), "Unaligned default memory.");
+
+  // Memory already allocated stays with its allocator until the array is
+  // reallocated.
+  doubles->SetValue(299, 3.0);
+  doubles->Resize(200);
+  CHECK(allocator->GetAllocatedMemory(VTK_DOUBLE) == 0 &&
+        doubles->GetValue(299) == 3.0, "Memory not moved to malloc().");
+  ids->Initialize();
+  CHECK(allocator->GetNumberOfAllocations() == 0, "Memory not freed.");
+
+  // Anonymous memory maps, grown without losing the values.
+  vtkNew<vtkDataArrayAllocator> mapped;
+  mapped->SetStorageToMemoryMap();
+  vtkNew<vtkIdTypeArray> mappedIds;
+  mappedIds->SetAllocator(mapped.GetPointer());
+  for (vtkIdType i = 0; i < 100000; ++i)
+    {
+    mappedIds->InsertNextValue(i);
+    }
+  CHECK(mappedIds->GetValue(99999) == 99999 &&
+        mappedIds->GetValue(0) == 0 &&
+        mapped->GetAllocatedMemory(VTK_ID_TYPE) ==
+        mappedIds->GetSize() * static_cast<vtkIdType>(sizeof(vtkIdType)),
+        "Wrong memory map.");
+  mappedIds->Initialize();
+  CHECK(mapped->GetAllocatedMemory() == 0, "Memory map not freed.");
+
+  // Huge pages and parallel first touch.
+  vtkNew<vtkDataArrayAllocator> touched;
+  touched->HugePagesOn();
+  touched->FirstTouchOn();
+  vtkNew<vtkFloatArray> large;
+  large->SetAllocator(touched.GetPointer());
+  large->SetNumberOfValues(4 << 20);
+  CHECK(large->GetValue(0) == 0.0f && large->GetValue(12345) == 0.0f &&
+        large->GetValue((4 << 20) - 1) == 0.0f, "Memory not touched.");
+  CHECK(IsAligned(large->GetPointer(0), 64), "Unaligned huge pages.");
+  large->SetValue(7, 7.0f);
+  large->Resize(8 << 20);
+  CHECK(large->GetValue(7) == 7.0f && large->GetValue((6 << 20)) == 0.0f,
+        "Values lost while growing touched memory.");
+
+  return EXIT_SUCCESS;
+}
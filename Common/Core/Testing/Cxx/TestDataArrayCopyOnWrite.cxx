@@ -0,0 +1,190 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayCopyOnWrite.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+
+// This test verifies that vtkDataArrayTemplate::ShallowCopy shares the
+// memory of arrays until one of them is modified, or gives out a pointer
+// to its memory, even to several threads at once.
+
+#define CHECK(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+// The number of threads getting the pointer of the same array.
+static const int THREAD_COUNT = 4;
+
+struct PointerArgs
+{
+  vtkFloatArray* Array;
+  float* Pointers[THREAD_COUNT];
+};
+
+static VTK_THREAD_RETURN_TYPE GetPointer(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  PointerArgs* args = static_cast<PointerArgs*>(info->UserData);
+  args->Pointers[info->ThreadID] = args->Array->GetPointer(0);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+int TestDataArrayCopyOnWrite(int, char *[])
+{
+  vtkNew<vtkFloatArray> source;
+  source->SetNumberOfComponents(3);
+  source->SetNumberOfTuples(1000);
+  for (vtkIdType i = 0; i < 3000; ++i)
+    {
+    source->SetValue(i, i);
+    }
+  double range[2];
+  source->GetRange(range, 0);
+
+  // The copy shares the memory, and the cached ranges.
+  vtkNew<vtkFloatArray> copy;
+  copy->ShallowCopy(source.GetPointer());
+  CHECK(copy->HasSharedBuffer() && source->HasSharedBuffer(),
+        "Arrays do not report sharing.");
+  CHECK(copy->GetNumberOfComponents() == 3 &&
+        copy->GetNumberOfTuples() == 1000, "Wrong copy dimensions.");
+  copy->GetRange(range, 0);
+  CHECK(range[0] == 0.0 && range[1] == 2997.0, "Wrong copy range.");
+
+  // Reading does not copy.
+  CHECK(copy->GetValue(42) == 42.0f && copy->GetComponent(1, 1) == 4.0 &&
+        copy->HasSharedBuffer(), "Reading copied.");
+
+  // Neither do the read pointers, nor the methods only reading the values.
+  CHECK(copy->GetReadPointer(0) == source->GetReadPointer(0) &&
+        copy->GetReadVoidPointer(3) == source->GetReadPointer(3),
+        "Read pointers differ.");
+  vtkNew<vtkFloatArray> tuples;
+  tuples->SetNumberOfComponents(3);
+  tuples->SetNumberOfTuples(10);
+  copy->GetTuples(0, 9, tuples.GetPointer());
+  vtkNew<vtkDoubleArray> deep;
+  deep->DeepCopy(copy.GetPointer());
+  vtkNew<vtkFloatArray> inserted3;
+  inserted3->SetNumberOfComponents(3);
+  inserted3->InsertNextTuple(5, copy.GetPointer());
+  CHECK(tuples->GetValue(29) == 29.0f && deep->GetValue(2999) == 2999.0 &&
+        inserted3->GetValue(2) == 17.0f, "Wrong values read.");
+  CHECK(copy->HasSharedBuffer() && source->HasSharedBuffer(),
+        "Reading methods copied.");
+
+  // The first modification copies, and the source is unchanged.
+  copy->SetValue(0, -1.0f);
+  CHECK(copy->GetPointer(0) != source->GetPointer(0), "Memory not copied.");
+  CHECK(copy->GetValue(0) == -1.0f && source->GetValue(0) == 0.0f,
+        "Modification seen by the source.");
+  CHECK(copy->GetValue(2999) == 2999.0f, "Data not copied.");
+  CHECK(!copy->HasSharedBuffer() && !source->HasSharedBuffer(),
+        "Arrays still report sharing.");
+  copy->Modified();
+  copy->GetRange(range, 0);
+  CHECK(range[0] == -1.0, "Stale copy range.");
+
+  // The source, last user of the memory, modifies it in place.
+  float* memory = source->GetPointer(0);
+  source->SetValue(1, 5.0f);
+  CHECK(source->GetPointer(0) == memory, "Memory copied needlessly.");
+
+  // Getting a pointer copies, as the data may be written through it.
+  vtkNew<vtkFloatArray> pointed;
+  pointed->ShallowCopy(source.GetPointer());
+  pointed->GetPointer(0)[0] = 6.0f;
+  CHECK(!pointed->HasSharedBuffer() && pointed->GetValue(0) == 6.0f &&
+        source->GetValue(0) == 0.0f, "GetPointer seen by the source.");
+  vtkNew<vtkFloatArray> voidPointed;
+  voidPointed->ShallowCopy(source.GetPointer());
+  static_cast<float*>(voidPointed->GetVoidPointer(0))[0] = 6.0f;
+  CHECK(source->GetValue(0) == 0.0f, "GetVoidPointer seen by the source.");
+
+  // Threads getting the pointer of the same array at once get the same
+  // copy.
+  vtkNew<vtkFloatArray> shared;
+  shared->ShallowCopy(source.GetPointer());
+  PointerArgs args;
+  args.Array = shared.GetPointer();
+  vtkNew<vtkMultiThreader> threader;
+  threader->SetNumberOfThreads(THREAD_COUNT);
+  threader->SetSingleMethod(GetPointer, &args);
+  threader->SingleMethodExecute();
+  for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+    CHECK(args.Pointers[i] == shared->GetPointer(0) &&
+          args.Pointers[i] != source->GetPointer(0),
+          "Threads got different or shared pointers.");
+    }
+  CHECK(!shared->HasSharedBuffer() && shared->GetValue(2999) == 2999.0f,
+        "Wrong copy made by the threads.");
+
+  // Every modifying method copies.
+  vtkNew<vtkFloatArray> inserted;
+  inserted->ShallowCopy(source.GetPointer());
+  inserted->InsertNextTuple3(1.0, 2.0, 3.0);
+  CHECK(inserted->GetNumberOfTuples() == 1001 &&
+        source->GetNumberOfTuples() == 1000, "Insertion seen by the source.");
+  vtkNew<vtkFloatArray> tupled;
+  tupled->ShallowCopy(source.GetPointer());
+  tupled->SetTuple3(0, 7.0, 7.0, 7.0);
+  CHECK(source->GetValue(0) == 0.0f, "SetTuple seen by the source.");
+  vtkNew<vtkFloatArray> written;
+  written->ShallowCopy(source.GetPointer());
+  written->WritePointer(0, 3)[0] = 9.0f;
+  CHECK(source->GetValue(0) == 0.0f, "WritePointer seen by the source.");
+  vtkNew<vtkFloatArray> resized;
+  resized->ShallowCopy(source.GetPointer());
+  resized->SetNumberOfTuples(10);
+  resized->SetValue(3, 8.0f);
+  CHECK(resized->GetValue(5) == 5.0f && source->GetValue(3) == 3.0f,
+        "SetNumberOfTuples lost the data, or modified the source.");
+
+  // Memory shared by several arrays is released by the last one.
+  vtkFloatArray* first = vtkFloatArray::New();
+  first->ShallowCopy(source.GetPointer());
+  vtkFloatArray* second = vtkFloatArray::New();
+  second->ShallowCopy(first);
+  source->Initialize();
+  first->Delete();
+  CHECK(second->GetValue(2999) == 2999.0f, "Shared memory released.");
+  second->Delete();
+
+  // Arrays of another type are deep copied.
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->ShallowCopy(tupled.GetPointer());
+  CHECK(doubles->GetNumberOfTuples() == 1000 && doubles->GetValue(0) == 7.0,
+        "Wrong deep copy.");
+
+  vtkNew<vtkIdTypeArray> ids;
+  ids->InsertNextValue(1);
+  vtkNew<vtkIdTypeArray> idsCopy;
+  idsCopy->ShallowCopy(ids.GetPointer());
+  CHECK(idsCopy->HasSharedBuffer() &&
+        idsCopy->GetReadPointer(0) == ids->GetReadPointer(0),
+        "Id array memory not shared.");
+  idsCopy->InsertNextValue(2);
+  CHECK(ids->GetNumberOfTuples() == 1 && idsCopy->GetNumberOfTuples() == 2,
+        "Wrong id array copy.");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayMapFile.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBitArray.h"
+#include "vtkDataArrayAllocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+
+#include <cstdio>
+
+// This test verifies that data arrays can use values mapped from a file,
+// read-only or copy-on-write, without ever modifying the file.
+
+#define CHECK(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+int TestDataArrayMapFile(int argc, char *argv[])
+{
+  if (argc < 2)
+    {
+    cerr << "Usage: " << argv[0] << " <temporary file>" << endl;
+    return EXIT_FAILURE;
+    }
+  const char* fileName = argv[1];
+
+  // A header of 100 bytes, so that the values are not on a page boundary,
+  // followed by 100000 doubles.
+  const vtkIdType numberOfValues = 100000;
+  FILE* file = fopen(fileName, "wb");
+  CHECK(file, "Cannot write " << fileName);
+  char header[100] = { 0 };
+  fwrite(header, 1, 100, file);
+  for (vtkIdType i = 0; i < numberOfValues; ++i)
+    {
+    double value = i;
+    fwrite(&value, sizeof(double), 1, file);
+    }
+  fclose(file);
+
+  // Read-only: the values are copied before their first modification.
+  vtkNew<vtkDataArrayAllocator> allocator;
+  vtkNew<vtkDoubleArray> readOnly;
+  readOnly->SetAllocator(allocator.GetPointer());
+  CHECK(readOnly->MapFile(fileName, 100, numberOfValues, 0),
+        "Cannot map the file.");
+  CHECK(readOnly->GetNumberOfTuples() == numberOfValues &&
+        readOnly->GetValue(0) == 0.0 && readOnly->GetValue(99999) == 99999.0,
+        "Wrong mapped values.");
+  CHECK(allocator->GetAllocatedMemory(VTK_DOUBLE) ==
+        numberOfValues * static_cast<vtkTypeInt64>(sizeof(double)),
+        "Mapped memory not accounted for.");
+  CHECK(readOnly->HasSharedBuffer(), "Read-only memory not reported.");
+  const double* mapped = readOnly->GetReadPointer(0);
+  readOnly->SetValue(1, -1.0);
+  CHECK(readOnly->GetReadPointer(0) != mapped && !readOnly->HasSharedBuffer() &&
+        readOnly->GetValue(1) == -1.0 && readOnly->GetValue(2) == 2.0,
+        "Read-only memory not copied.");
+  CHECK(allocator->GetNumberOfAllocations() == 1,
+        "Mapping not released.");
+
+  // So are they before a pointer they may be written through is given out.
+  vtkNew<vtkDoubleArray> pointed;
+  CHECK(pointed->MapFile(fileName, 100, 1000, 0), "Cannot map again.");
+  mapped = pointed->GetReadPointer(0);
+  double* writable = pointed->GetPointer(0);
+  writable[5] = -5.0;
+  static_cast<double*>(pointed->GetVoidPointer(0))[6] = -6.0;
+  CHECK(writable != mapped && !pointed->HasSharedBuffer() &&
+        pointed->GetValue(5) == -5.0 && pointed->GetValue(6) == -6.0 &&
+        pointed->GetValue(999) == 999.0,
+        "Read-only memory given out for writing.");
+
+  // Copy-on-write: the values are modified in place, but not in the file.
+  vtkNew<vtkDoubleArray> copyOnWrite;
+  copyOnWrite->SetNumberOfComponents(2);
+  CHECK(copyOnWrite->MapFile(fileName, 100, numberOfValues, 1),
+        "Cannot map the file copy-on-write.");
+  CHECK(copyOnWrite->GetNumberOfTuples() == numberOfValues / 2 &&
+        copyOnWrite->GetComponent(1, 1) == 3.0, "Wrong tuples.");
+  mapped = copyOnWrite->GetPointer(0);
+  copyOnWrite->SetValue(3, -3.0);
+  CHECK(copyOnWrite->GetPointer(0) == mapped &&
+        copyOnWrite->GetValue(3) == -3.0, "Copy-on-write memory copied.");
+
+  // Growing the array copies the values.
+  copyOnWrite->InsertNextTuple2(1.0, 2.0);
+  CHECK(copyOnWrite->GetNumberOfTuples() == numberOfValues / 2 + 1 &&
+        copyOnWrite->GetValue(3) == -3.0 &&
+        copyOnWrite->GetValue(numberOfValues + 1) == 2.0,
+        "Values lost while growing.");
+
+  // Shallow copies share the mapping.
+  vtkNew<vtkDoubleArray> shared;
+  CHECK(shared->MapFile(fileName, 100, 1000, 0), "Cannot map again.");
+  vtkNew<vtkDoubleArray> copy;
+  copy->ShallowCopy(shared.GetPointer());
+  CHECK(copy->GetReadPointer(0) == shared->GetReadPointer(0) &&
+        copy->GetValue(999) == 999.0, "Mapping not shared.");
+  shared->Initialize();
+  CHECK(copy->GetValue(3) == 3.0, "Mapping released too early.");
+
+  // The file is unchanged.
+  vtkNew<vtkDoubleArray> check;
+  CHECK(check->MapFile(fileName, 100, numberOfValues, 0) &&
+        check->GetValue(1) == 1.0 && check->GetValue(3) == 3.0,
+        "The file was modified.");
+
+  // Invalid requests leave the array unchanged.
+  vtkNew<vtkFloatArray> invalid;
+  invalid->InsertNextValue(1.0f);
+  CHECK(!invalid->MapFile(fileName, 100, 2 * numberOfValues + 1, 0) &&
+        !invalid->MapFile("/nonexistent/file.raw", 0, 1, 0) &&
+        invalid->GetNumberOfTuples() == 1 && invalid->GetValue(0) == 1.0f,
+        "Invalid mapping accepted.");
+  vtkNew<vtkBitArray> bits;
+  CHECK(!bits->MapFile(fileName, 0, 8, 0), "Bit array mapped.");
+
+  check->Initialize();
+  copy->Initialize();
+  remove(fileName);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitDataArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAffineCoordinatesDataArrayTemplate.h"
+#include "vtkConstantDataArrayTemplate.h"
+#include "vtkDataArrayIteratorMacro.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkRangeDataArrayTemplate.h"
+#include "vtkRectilinearCoordinatesDataArrayTemplate.h"
+
+namespace
+{
+
+// Written for vtkDataArrayIteratorMacro.
+template <class Iterator>
+double Sum(Iterator begin, Iterator end)
+{
+  double sum = 0.0;
+  for (; begin != end; ++begin)
+    {
+    sum += *begin;
+    }
+  return sum;
+}
+
+}
+
+int TestImplicitDataArrays(int, char *[])
+{
+  // A constant array of a billion tuples costs nothing.
+  vtkNew<vtkConstantDataArrayTemplate<float> > ones;
+  ones->SetNumberOfComponents(2);
+  ones->SetConstantValue(1.0f);
+  ones->SetNumberOfTuples(1000000000);
+  double range[2];
+  ones->GetRange(range, 1);
+  if (ones->GetNumberOfTuples() != 1000000000 ||
+      ones->GetActualMemorySize() > 1 ||
+      ones->GetComponent(123456789, 1) != 1.0 ||
+      range[0] != 1.0 || range[1] != 1.0)
+    {
+    cerr << "Wrong constant array." << endl;
+    return 1;
+    }
+
+  // Ids, as vtkIdFilter generates them.
+  vtkNew<vtkRangeDataArrayTemplate<vtkIdType> > ids;
+  ids->SetNumberOfTuples(100);
+  double sum = 0.0;
+  vtkDataArray *da = ids.GetPointer();
+  switch (da->GetDataType())
+    {
+    vtkDataArrayIteratorMacro(da, sum = Sum(vtkDABegin, vtkDAEnd));
+    }
+  vtkNew<vtkIdList> found;
+  ids->LookupTypedValue(42, found.GetPointer());
+  if (sum != 4950.0 || ids->GetValue(99) != 99 ||
+      found->GetNumberOfIds() != 1 || found->GetId(0) != 42)
+    {
+    cerr << "Wrong id array, sum " << sum << endl;
+    return 1;
+    }
+
+  vtkNew<vtkRangeDataArrayTemplate<double> > countdown;
+  countdown->SetStart(10.0);
+  countdown->SetStep(-0.5);
+  countdown->SetNumberOfTuples(21);
+  countdown->GetRange(range);
+  if (range[0] != 0.0 || range[1] != 10.0 || countdown->GetValue(3) != 8.5)
+    {
+    cerr << "Wrong range array." << endl;
+    return 1;
+    }
+
+  // Copies, made through the vtkDataArray API, are standard arrays.
+  da = countdown.GetPointer();
+  vtkDataArray *copy = da->NewInstance();
+  copy->DeepCopy(countdown.GetPointer());
+  if (!vtkDoubleArray::SafeDownCast(copy) || copy->GetTuple1(20) != 0.0)
+    {
+    cerr << "Wrong copy." << endl;
+    copy->Delete();
+    return 1;
+    }
+  copy->Delete();
+
+  // The points of a 4 x 3 x 2 image.
+  int extent[6] = {1, 4, 0, 2, -1, 0};
+  double origin[3] = {0.0, 10.0, 20.0};
+  double spacing[3] = {0.5, 1.0, 2.0};
+  vtkNew<vtkAffineCoordinatesDataArrayTemplate<double> > imageCoords;
+  imageCoords->SetGrid(extent, origin, spacing);
+  vtkNew<vtkPoints> imagePoints;
+  imagePoints->SetData(imageCoords.GetPointer());
+  double x[3];
+  imagePoints->GetPoint(2 + 4 * (1 + 3 * 1), x); // ijk offset (2, 1, 1)
+  double *bounds = imagePoints->GetBounds();
+  if (imagePoints->GetNumberOfPoints() != 24 ||
+      x[0] != 1.5 || x[1] != 11.0 || x[2] != 20.0 ||
+      bounds[0] != 0.5 || bounds[1] != 2.0 || bounds[2] != 10.0 ||
+      bounds[3] != 12.0 || bounds[4] != 18.0 || bounds[5] != 20.0)
+    {
+    cerr << "Wrong image coordinates." << endl;
+    return 1;
+    }
+
+  // The points of a 3 x 2 x 1 rectilinear grid.
+  vtkNew<vtkDoubleArray> xs;
+  vtkNew<vtkDoubleArray> ys;
+  vtkNew<vtkDoubleArray> zs;
+  xs->InsertNextValue(0.0);
+  xs->InsertNextValue(1.0);
+  xs->InsertNextValue(5.0);
+  ys->InsertNextValue(-1.0);
+  ys->InsertNextValue(-3.0);
+  zs->InsertNextValue(7.0);
+  vtkNew<vtkRectilinearCoordinatesDataArrayTemplate<float> > gridCoords;
+  gridCoords->SetCoordinates(xs.GetPointer(), ys.GetPointer(),
+                             zs.GetPointer());
+  vtkNew<vtkPoints> gridPoints;
+  gridPoints->SetData(gridCoords.GetPointer());
+  gridPoints->GetPoint(5, x);
+  bounds = gridPoints->GetBounds();
+  if (gridPoints->GetNumberOfPoints() != 6 ||
+      x[0] != 5.0 || x[1] != -3.0 || x[2] != 7.0 ||
+      gridCoords->GetValue(3 * 4 + 1) != -3.0f ||
+      bounds[0] != 0.0 || bounds[1] != 5.0 || bounds[2] != -3.0 ||
+      bounds[3] != -1.0 || bounds[4] != 7.0 || bounds[5] != 7.0)
+    {
+    cerr << "Wrong rectilinear coordinates." << endl;
+    return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,246 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestRegisterPerformance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test speed of reference counting.
+// .SECTION Description
+// Probe the throughput of vtkObjectBase::Register and
+// vtkObjectBase::UnRegister on an object shared by several threads, for
+// an object that does not participate in garbage collection and for one
+// that does, and check that the collection checks of the references
+// released by the threads wait for the main thread, but only up to a
+// bound past which the releasing thread does them.
+
+#include "vtkCallbackCommand.h"
+#include "vtkGarbageCollector.h"
+#include "vtkInformation.h"
+#include "vtkInformationInformationVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <vector>
+
+// How many references each thread takes and releases, fewer for objects
+// participating in garbage collection, as their references released by
+// the main thread are checked.
+static const int REGISTER_COUNT = 200000;
+static const int COLLECTED_REGISTER_COUNT = 2000;
+
+// The largest number of threads.
+static const int MAX_THREAD_COUNT = 8;
+
+//------------------------------------------------------------------------------
+// A key giving an information object references to report.
+class vtkRegisterTestKeys
+{
+public:
+  static vtkInformationInformationVectorKey* VECTOR();
+};
+vtkInformationKeyMacro(vtkRegisterTestKeys, VECTOR, InformationVector);
+
+//------------------------------------------------------------------------------
+// A reference loop participating in garbage collection.
+class vtkRegisterTestLoop : public vtkObject
+{
+public:
+  static vtkRegisterTestLoop* New() { return new vtkRegisterTestLoop; }
+  vtkTypeMacro(vtkRegisterTestLoop, vtkObject);
+
+  void Register(vtkObjectBase* o) { this->RegisterInternal(o, 1); }
+  void UnRegister(vtkObjectBase* o) { this->UnRegisterInternal(o, 1); }
+
+protected:
+  vtkRegisterTestLoop()
+    {
+    this->Other = new vtkRegisterTestLoop(this);
+    }
+  vtkRegisterTestLoop(vtkRegisterTestLoop* other)
+    {
+    this->Other = other;
+    this->Other->Register(this);
+    }
+  ~vtkRegisterTestLoop()
+    {
+    if (this->Other)
+      {
+      this->Other->UnRegister(this);
+      this->Other = 0;
+      }
+    }
+
+  void ReportReferences(vtkGarbageCollector* collector)
+    {
+    vtkGarbageCollectorReport(collector, this->Other, "Other");
+    }
+
+  vtkRegisterTestLoop* Other;
+
+private:
+  vtkRegisterTestLoop(const vtkRegisterTestLoop&);  // Not implemented.
+  void operator=(const vtkRegisterTestLoop&);  // Not implemented.
+};
+
+//------------------------------------------------------------------------------
+struct vtkRegisterTestArgs
+{
+  vtkObjectBase* Shared;
+  int Count;
+};
+
+//------------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE RegisterUnRegister(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkRegisterTestArgs* args =
+    static_cast<vtkRegisterTestArgs*>(info->UserData);
+  vtkObjectBase* shared = args->Shared;
+  for (int i = 0; i < args->Count; ++i)
+    {
+    vtkSmartPointer<vtkObjectBase> reference = shared;
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//------------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE DeleteObject(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  static_cast<vtkObjectBase*>(info->UserData)->Delete();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//------------------------------------------------------------------------------
+// Report the millions of Register/UnRegister pairs per second.
+static void StressRegister(vtkObjectBase* shared, int count,
+                           int threadCount)
+{
+  vtkRegisterTestArgs args = { shared, count };
+  vtkNew<vtkMultiThreader> threader;
+  threader->SetNumberOfThreads(threadCount);
+  threader->SetSingleMethod(RegisterUnRegister, &args);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  threader->SingleMethodExecute();
+  timer->StopTimer();
+  double time = timer->GetElapsedTime();
+  double pairs = static_cast<double>(count) * threadCount;
+  std::cout << "<DartMeasurement name=\"Register-" << shared->GetClassName()
+            << "-" << threadCount << "\" type=\"numeric/double\">"
+            << (time > 0 ? pairs / time * 1e-6 : 0.0)
+            << "</DartMeasurement>" << std::endl;
+}
+
+//------------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE DeleteObjects(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  std::vector<vtkObjectBase*>* objects =
+    static_cast<std::vector<vtkObjectBase*>*>(info->UserData);
+  for (size_t i = 0; i < objects->size(); ++i)
+    {
+    (*objects)[i]->Delete();
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//------------------------------------------------------------------------------
+static int Deleted = 0;
+static void DeleteCallback(vtkObject*, unsigned long, void*, void*)
+{
+  ++Deleted;
+}
+
+//------------------------------------------------------------------------------
+int TestRegisterPerformance(int, char*[])
+{
+  // An object that does not participate in garbage collection, and one
+  // that does, with references to report.
+  vtkNew<vtkObject> object;
+  vtkNew<vtkInformation> information;
+  vtkNew<vtkInformationVector> vector;
+  vector->SetNumberOfInformationObjects(100);
+  information->Set(vtkRegisterTestKeys::VECTOR(), vector.GetPointer());
+
+  for (int threadCount = 1; threadCount <= MAX_THREAD_COUNT; threadCount *= 2)
+    {
+    StressRegister(object.GetPointer(), REGISTER_COUNT, threadCount);
+    StressRegister(information.GetPointer(), COLLECTED_REGISTER_COUNT,
+                   threadCount);
+    }
+
+  // The references released by the threads are given back by the main
+  // thread.
+  vtkGarbageCollector::Collect();
+  if (object->GetReferenceCount() != 1 ||
+      information->GetReferenceCount() != 1)
+    {
+    cerr << "Wrong reference counts: " << object->GetReferenceCount()
+         << ", " << information->GetReferenceCount() << endl;
+    return EXIT_FAILURE;
+    }
+
+  // A reference loop released by another thread is collected by the main
+  // thread.
+  vtkNew<vtkCallbackCommand> callback;
+  callback->SetCallback(DeleteCallback);
+  vtkRegisterTestLoop* loop = vtkRegisterTestLoop::New();
+  loop->AddObserver(vtkCommand::DeleteEvent, callback.GetPointer());
+  Deleted = 0;
+  vtkNew<vtkMultiThreader> threader;
+  threader->TerminateThread(threader->SpawnThread(DeleteObject, loop));
+  if (Deleted)
+    {
+    cerr << "Reference loop collected by another thread." << endl;
+    return EXIT_FAILURE;
+    }
+  vtkGarbageCollector::Collect();
+  if (!Deleted)
+    {
+    cerr << "Reference loop not collected." << endl;
+    return EXIT_FAILURE;
+    }
+
+  // The reference loops released by another thread do not wait for the
+  // main thread past a few of them.
+  const int loopCount = 1000;
+  std::vector<vtkObjectBase*> loops;
+  for (int i = 0; i < loopCount; ++i)
+    {
+    loop = vtkRegisterTestLoop::New();
+    loop->AddObserver(vtkCommand::DeleteEvent, callback.GetPointer());
+    loops.push_back(loop);
+    }
+  Deleted = 0;
+  threader->TerminateThread(threader->SpawnThread(DeleteObjects, &loops));
+  if (Deleted < loopCount - 100)
+    {
+    cerr << "Only " << Deleted << " of " << loopCount
+         << " reference loops collected by another thread." << endl;
+    return EXIT_FAILURE;
+    }
+  vtkGarbageCollector::Collect();
+  if (Deleted != loopCount)
+    {
+    cerr << Deleted << " of " << loopCount
+         << " reference loops collected." << endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -19,6 +19,11 @@
 #include "vtkSMPTools.h"
 #include "vtkSMPThreadLocalObject.h"
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+
 static const int Target = 10000;
 
 class ARangeFunctor
@@ -89,10 +94,22 @@ public:
 
 };
 
-int TestSMP(int, char*[])
+class NestedFunctor
 {
-  //vtkSMPTools::Initialize(8);
+public:
+  ARangeFunctor Inner;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i=begin; i<end; i++)
+      {
+      vtkSMPTools::For(0, 100, this->Inner);
+      }
+  }
+};
 
+static int TestSMPBackend()
+{
   ARangeFunctor functor1;
 
   vtkSMPTools::For(0, Target, functor1);
@@ -135,5 +152,176 @@ int TestSMP(int, char*[])
     return 1;
     }
 
+  NestedFunctor functor3;
+
+  vtkSMPTools::For(0, Target / 100, functor3);
+
+  vtkSMPThreadLocal<int>::iterator itr3 = functor3.Inner.Counter.begin();
+  vtkSMPThreadLocal<int>::iterator end3 = functor3.Inner.Counter.end();
+
+  total = 0;
+  while(itr3 != end3)
+    {
+    total += *itr3;
+    ++itr3;
+    }
+
+  if (total != Target)
+    {
+    cerr << "Error: NestedFunctor did not generate " << Target << endl;
+    return 1;
+    }
+
+  return 0;
+}
+
+struct Square
+{
+  int operator()(int x) const
+  {
+    return x * x;
+  }
+};
+
+struct Maximum
+{
+  int operator()(int x, int y) const
+  {
+    return x > y ? x : y;
+  }
+};
+
+static int TestSMPAlgorithms()
+{
+  const int size = 100000;
+  std::vector<int> values(size);
+  for (int i = 0; i < size; i++)
+    {
+    values[i] = static_cast<int>((i * 7919L) % 1001) - 500;
+    }
+
+  std::vector<int> result(size);
+  vtkSMPTools::Fill(result.begin(), result.end(), 3);
+  if (std::count(result.begin(), result.end(), 3) != size)
+    {
+    cerr << "Error: Fill did not assign every element" << endl;
+    return 1;
+    }
+
+  vtkSMPTools::Transform(values.begin(), values.end(), result.begin(), Square());
+  vtkSMPTools::Transform(result.begin(), result.end(), values.begin(),
+                         result.begin(), std::minus<int>());
+  for (int i = 0; i < size; i++)
+    {
+    if (result[i] != values[i] * values[i] - values[i])
+      {
+      cerr << "Error: Transform gave " << result[i] << " at " << i << endl;
+      return 1;
+      }
+    }
+
+  if (vtkSMPTools::Reduce(values.begin(), values.end(), 0) !=
+      std::accumulate(values.begin(), values.end(), 0) ||
+      vtkSMPTools::Reduce(values.begin(), values.end(), -1000, Maximum()) !=
+      *std::max_element(values.begin(), values.end()))
+    {
+    cerr << "Error: Reduce did not match std::accumulate" << endl;
+    return 1;
+    }
+
+  std::vector<int> expected(size);
+  std::partial_sum(values.begin(), values.end(), expected.begin());
+  vtkSMPTools::InclusiveScan(values.begin(), values.end(), result.begin());
+  if (result != expected)
+    {
+    cerr << "Error: InclusiveScan did not match std::partial_sum" << endl;
+    return 1;
+    }
+
+  // In place, the way counts are turned into offsets.
+  result = values;
+  vtkSMPTools::ExclusiveScan(result.begin(), result.end(), result.begin(), 10);
+  for (int i = 0; i < size; i++)
+    {
+    if (result[i] != (i > 0 ? expected[i - 1] : 0) + 10)
+      {
+      cerr << "Error: ExclusiveScan gave " << result[i] << " at " << i << endl;
+      return 1;
+      }
+    }
+
+  result = values;
+  expected = values;
+  std::sort(expected.begin(), expected.end());
+  vtkSMPTools::Sort(result.begin(), result.end());
+  if (result != expected)
+    {
+    cerr << "Error: Sort did not match std::sort" << endl;
+    return 1;
+    }
+
+  // Odd size so that the last run has no partner in the merge passes.
+  result.assign(values.begin(), values.begin() + size / 3);
+  expected = result;
+  std::sort(expected.begin(), expected.end(), std::greater<int>());
+  vtkSMPTools::Sort(result.begin(), result.end(), std::greater<int>());
+  if (result != expected)
+    {
+    cerr << "Error: Sort with a comparison did not match std::sort" << endl;
+    return 1;
+    }
+
+  return 0;
+}
+
+int TestSMP(int, char*[])
+{
+  // Run the tests with every back-end available in this build. Only the
+  // Runtime implementation accepts more than the one it was built with.
+  const char* backends[] =
+    { vtkSMPTools::GetBackend(), "Sequential", "ThreadPool", "OpenMP", "TBB" };
+  const int numBackends = static_cast<int>(sizeof(backends) / sizeof(backends[0]));
+
+  int numTested = 0;
+  for (int i = 0; i < numBackends; i++)
+    {
+    if (!vtkSMPTools::SetBackend(backends[i]))
+      {
+      continue;
+      }
+    // These back-ends honor every number of threads given, not only the
+    // first one.
+    if (strcmp(vtkSMPTools::GetBackend(), "ThreadPool") == 0 ||
+        strcmp(vtkSMPTools::GetBackend(), "Simple") == 0)
+      {
+      const int numThreads[] = { 2, 4 };
+      for (int j = 0; j < 2; j++)
+        {
+        vtkSMPTools::Initialize(numThreads[j]);
+        if (vtkSMPTools::GetEstimatedNumberOfThreads() != numThreads[j])
+          {
+          cerr << "Error: Initialize(" << numThreads[j]
+               << ") was not honored by the " << vtkSMPTools::GetBackend()
+               << " back-end" << endl;
+          return 1;
+          }
+        }
+      }
+    if (TestSMPBackend() || TestSMPAlgorithms())
+      {
+      cerr << "Error: failure with the " << vtkSMPTools::GetBackend()
+           << " back-end" << endl;
+      return 1;
+      }
+    numTested++;
+    }
+
+  if (numTested == 0)
+    {
+    cerr << "Error: the " << vtkSMPTools::GetBackend()
+         << " back-end does not accept its own name" << endl;
+    return 1;
+    }
+
   return 0;
 }
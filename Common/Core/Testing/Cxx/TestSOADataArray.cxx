@@ -0,0 +1,200 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSOADataArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArrayIteratorMacro.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestErrorObserver.h"
+
+#include <typeinfo>
+#include <vector>
+
+namespace
+{
+
+// Written for vtkDataArrayIteratorMacro: scales every value in place and
+// returns the sum of the scaled values.
+template <class Iterator>
+double ScaleAndSum(Iterator begin, Iterator end, double factor)
+{
+  double sum = 0.0;
+  for (; begin != end; ++begin)
+    {
+    *begin = static_cast<typename std::iterator_traits<Iterator>::value_type>(
+      *begin * factor);
+    sum += *begin;
+    }
+  return sum;
+}
+
+}
+
+int TestSOADataArray(int, char *[])
+{
+  const vtkIdType numTuples = 1000;
+  std::vector<float> x(numTuples), y(numTuples), z(numTuples);
+  for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+    x[i] = static_cast<float>(i);
+    y[i] = static_cast<float>(2 * i);
+    z[i] = static_cast<float>(-i);
+    }
+
+  // Wrap the simulation fields without copying them.
+  vtkNew<vtkSOADataArrayTemplate<float> > array;
+  array->SetNumberOfComponents(3);
+  array->SetArray(0, &x[0], numTuples, 1);
+  array->SetArray(1, &y[0], numTuples, 1);
+  array->SetArray(2, &z[0], numTuples, 1);
+
+  // No warning or error is expected from the arrays.
+  vtkNew<vtkTest::ErrorObserver> observer;
+  array->AddObserver(vtkCommand::WarningEvent, observer.GetPointer());
+  array->AddObserver(vtkCommand::ErrorEvent, observer.GetPointer());
+
+  if (array->GetNumberOfTuples() != numTuples ||
+      array->GetComponentArrayPointer(1) != &y[0])
+    {
+    cerr << "Wrong number of tuples or buffer." << endl;
+    return 1;
+    }
+  double tuple[3];
+  array->GetTuple(10, tuple);
+  if (tuple[0] != 10.0 || tuple[1] != 20.0 || tuple[2] != -10.0 ||
+      array->GetValue(3 * 10 + 1) != 20.0f ||
+      array->GetComponentValue(10, 2) != -10.0f)
+    {
+    cerr << "Wrong values for tuple 10." << endl;
+    return 1;
+    }
+
+  // The generic casts still see a typed, mapped array.
+  vtkDataArray *da = array.GetPointer();
+  if (vtkSOADataArrayTemplate<float>::FastDownCast(da) != array.GetPointer() ||
+      vtkSOADataArrayTemplate<double>::FastDownCast(da) != NULL ||
+      vtkTypedDataArray<float>::FastDownCast(da) == NULL ||
+      vtkMappedDataArray<float>::FastDownCast(da) == NULL ||
+      vtkDataArray::FastDownCast(da) == NULL)
+    {
+    cerr << "FastDownCast failed." << endl;
+    return 1;
+    }
+
+  // The iterator macro writes into the user's buffers directly.
+  double sum = 0.0;
+  bool componentIterator = false;
+  switch (da->GetDataType())
+    {
+    vtkDataArrayIteratorMacro(da,
+      sum = ScaleAndSum(vtkDABegin, vtkDAEnd, 2.0);
+      componentIterator = typeid(vtkDAIteratorType) ==
+        typeid(vtkDataArrayComponentIterator<
+                 vtkSOADataArrayTemplate<float> >));
+    }
+  if (!componentIterator)
+    {
+    cerr << "vtkDataArrayIteratorMacro did not use the component iterator."
+         << endl;
+    return 1;
+    }
+  // sum of 2 * (i + 2i - i) for i < numTuples
+  if (sum != 2.0 * numTuples * (numTuples - 1) || x[5] != 10.0f ||
+      y[5] != 20.0f || z[5] != -10.0f)
+    {
+    cerr << "Wrong values after iterating: sum " << sum << endl;
+    return 1;
+    }
+
+  double range[2];
+  array->GetRange(range, 1);
+  if (range[0] != 0.0 || range[1] != 4.0 * (numTuples - 1))
+    {
+    cerr << "Wrong range " << range[0] << " " << range[1] << endl;
+    return 1;
+    }
+
+  // Pipeline copies, made through the vtkDataArray API, are standard arrays.
+  vtkSmartPointer<vtkDataArray> copy;
+  copy.TakeReference(da->NewInstance());
+  if (!vtkFloatArray::SafeDownCast(copy))
+    {
+    cerr << "NewInstance is a " << copy->GetClassName() << endl;
+    return 1;
+    }
+  copy->DeepCopy(array.GetPointer());
+  vtkNew<vtkIdList> ids;
+  ids->InsertNextId(7);
+  ids->InsertNextId(3);
+  vtkNew<vtkFloatArray> picked;
+  picked->SetNumberOfComponents(3);
+  picked->SetNumberOfTuples(2);
+  array->GetTuples(ids.GetPointer(), picked.GetPointer());
+  if (copy->GetNumberOfTuples() != numTuples ||
+      copy->GetComponent(42, 2) != -84.0 ||
+      picked->GetComponent(0, 1) != 28.0 || picked->GetComponent(1, 0) != 6.0)
+    {
+    cerr << "Wrong copied values." << endl;
+    return 1;
+    }
+
+  // Growing the array moves it to its own buffers and leaves the user's
+  // alone.
+  double next[3] = {1.0, 2.0, 3.0};
+  if (array->InsertNextTuple(next) != numTuples ||
+      array->GetNumberOfTuples() != numTuples + 1 ||
+      array->GetComponentArrayPointer(0) == &x[0] ||
+      array->GetComponentValue(numTuples, 2) != 3.0f ||
+      array->GetComponentValue(5, 0) != 10.0f)
+    {
+    cerr << "InsertNextTuple failed." << endl;
+    return 1;
+    }
+
+  // Deep copy into the structure of arrays. Removing a tuple discards the
+  // values copied by GetVoidPointer(), which warns that it is expensive,
+  // rather than writing them back.
+  vtkNew<vtkSOADataArrayTemplate<float> > soaCopy;
+  soaCopy->AddObserver(vtkCommand::WarningEvent, observer.GetPointer());
+  soaCopy->AddObserver(vtkCommand::ErrorEvent, observer.GetPointer());
+  soaCopy->DeepCopy(copy);
+  soaCopy->RemoveTuple(0);
+  if (observer->GetWarning() || observer->GetError())
+    {
+    cerr << "Unexpected messages:\n" << observer->GetWarningMessage()
+         << observer->GetErrorMessage() << endl;
+    return 1;
+    }
+  soaCopy->GetVoidPointer(0);
+  observer->Clear();
+  soaCopy->RemoveTuple(0);
+  if (soaCopy->GetNumberOfComponents() != 3 ||
+      soaCopy->GetNumberOfTuples() != numTuples - 2 ||
+      soaCopy->GetComponentValue(40, 2) != -84.0f)
+    {
+    cerr << "DeepCopy or RemoveTuple failed." << endl;
+    return 1;
+    }
+
+  if (observer->GetWarning() || observer->GetError())
+    {
+    cerr << "Unexpected messages:\n" << observer->GetWarningMessage()
+         << observer->GetErrorMessage() << endl;
+    return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,158 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStridedDataArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArrayIteratorMacro.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkStridedDataArrayTemplate.h"
+#include "vtkTestErrorObserver.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+// Written for vtkDataArrayIteratorMacro.
+template <class Iterator>
+void Reverse(Iterator begin, Iterator end)
+{
+  std::reverse(begin, end);
+}
+
+}
+
+int TestStridedDataArray(int, char *[])
+{
+  // Records of 5 values: an id, a flag and a 3D position.
+  const vtkIdType numRecords = 100;
+  const int recordSize = 5;
+  std::vector<double> records(numRecords * recordSize);
+  for (vtkIdType i = 0; i < numRecords; ++i)
+    {
+    records[i * recordSize] = -1.0;
+    records[i * recordSize + 1] = -2.0;
+    for (int c = 0; c < 3; ++c)
+      {
+      records[i * recordSize + 2 + c] = static_cast<double>(3 * i + c);
+      }
+    }
+
+  // View the positions only.
+  vtkNew<vtkStridedDataArrayTemplate<double> > view;
+  view->SetNumberOfComponents(3);
+  view->SetArray(&records[0], numRecords, recordSize, 2, 1);
+
+  // No warning or error is expected from the views.
+  vtkNew<vtkTest::ErrorObserver> observer;
+  view->AddObserver(vtkCommand::WarningEvent, observer.GetPointer());
+  view->AddObserver(vtkCommand::ErrorEvent, observer.GetPointer());
+  if (view->GetNumberOfTuples() != numRecords ||
+      view->HasStandardMemoryLayout())
+    {
+    cerr << "Wrong view." << endl;
+    return 1;
+    }
+  for (vtkIdType i = 0; i < 3 * numRecords; ++i)
+    {
+    if (view->GetValue(i) != static_cast<double>(i))
+      {
+      cerr << "Wrong value " << view->GetValue(i) << " at " << i << endl;
+      return 1;
+      }
+    }
+
+  // Reverse the positions through the iterator macro; the other fields
+  // must not move.
+  vtkDataArray *da = view.GetPointer();
+  switch (da->GetDataType())
+    {
+    vtkDataArrayIteratorMacro(da, Reverse(vtkDABegin, vtkDAEnd));
+    }
+  for (vtkIdType i = 0; i < numRecords; ++i)
+    {
+    const double *record = &records[i * recordSize];
+    const double last = 3.0 * numRecords - 1.0;
+    if (record[0] != -1.0 || record[1] != -2.0 ||
+        record[2] != last - 3 * i || record[4] != last - 3 * i - 2)
+      {
+      cerr << "Wrong record " << i << " after reversal." << endl;
+      return 1;
+      }
+    }
+
+  // Generic vtkDataArray algorithms go through the iterator too.
+  double range[2];
+  view->GetRange(range, 0);
+  vtkNew<vtkDoubleArray> copy;
+  copy->DeepCopy(view.GetPointer());
+  if (range[0] != 2.0 || range[1] != 3.0 * numRecords - 1.0 ||
+      copy->GetNumberOfTuples() != numRecords ||
+      copy->GetComponent(1, 0) != 3.0 * numRecords - 4.0)
+    {
+    cerr << "Wrong range or copy." << endl;
+    return 1;
+    }
+
+  // Setting values writes into the records.
+  double tuple[3] = {7.0, 8.0, 9.0};
+  view->SetTuple(4, tuple);
+  view->SetComponent(5, 1, 11.0);
+  if (records[4 * recordSize + 3] != 8.0 || records[5 * recordSize + 3] != 11.0)
+    {
+    cerr << "SetTuple did not write into the records." << endl;
+    return 1;
+    }
+
+  // A contiguous view hands out raw pointers without copying.
+  vtkNew<vtkStridedDataArrayTemplate<double> > contiguous;
+  contiguous->SetNumberOfComponents(recordSize);
+  contiguous->SetArray(&records[0], numRecords, recordSize, 0, 1);
+  if (!contiguous->HasStandardMemoryLayout() ||
+      contiguous->GetVoidPointer(recordSize) != &records[recordSize] ||
+      contiguous->WriteVoidPointer(0, recordSize) != &records[0])
+    {
+    cerr << "The contiguous view is not zero-copy." << endl;
+    return 1;
+    }
+
+  // Removing a tuple moves the next positions in the records, and
+  // discards the values copied by GetVoidPointer(), which warns that it is
+  // expensive, rather than writing them back.
+  if (observer->GetWarning() || observer->GetError())
+    {
+    cerr << "Unexpected messages:\n" << observer->GetWarningMessage()
+         << observer->GetErrorMessage() << endl;
+    return 1;
+    }
+  view->GetVoidPointer(0);
+  observer->Clear();
+  view->RemoveTuple(4);
+  if (view->GetNumberOfTuples() != numRecords - 1 ||
+      view->GetComponent(4, 1) != 11.0 ||
+      records[4 * recordSize + 3] != 11.0 || records[4 * recordSize] != -1.0)
+    {
+    cerr << "RemoveTuple failed." << endl;
+    return 1;
+    }
+
+  if (observer->GetWarning() || observer->GetError())
+    {
+    cerr << "Unexpected messages:\n" << observer->GetWarningMessage()
+         << observer->GetErrorMessage() << endl;
+    return 1;
+    }
+
+  return 0;
+}
@@ -197,6 +197,14 @@ public:
   // member directly.
   virtual void *GetVoidPointer(vtkIdType id) = 0;
 
+  // Description:
+  // Return a pointer to the values for reading only. Unlike
+  // GetVoidPointer(), arrays sharing their memory with other arrays do not
+  // copy it first, see vtkDataArrayTemplate::ShallowCopy(). The values
+  // must not be modified through this pointer.
+  virtual const void *GetReadVoidPointer(vtkIdType id)
+    { return this->GetVoidPointer(id); }
+
   // Description:
   // Deep copy of data. Implementation left to subclasses, which
   // should support as many type conversions as possible given the
@@ -485,7 +493,9 @@ public:
     DataArray,
     TypedDataArray,
     DataArrayTemplate,
-    MappedDataArray
+    MappedDataArray,
+    SOADataArrayTemplate,
+    StridedDataArrayTemplate
     };
 
   // Description:
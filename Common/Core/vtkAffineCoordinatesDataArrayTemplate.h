@@ -0,0 +1,104 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAffineCoordinatesDataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkAffineCoordinatesDataArrayTemplate - Implicit array holding the
+// point coordinates of a uniform grid.
+//
+// .SECTION Description
+// vtkAffineCoordinatesDataArrayTemplate is a 3 component implicit array
+// whose tuple id is the point id of a uniform grid of the given extent,
+// origin and spacing, i varying fastest as in vtkImageData. Tuple id holds
+// origin + ijk * spacing. It lets vtkPoints describe the points of a
+// vtkImageData without storing them.
+//
+// SetExtent() sets the number of tuples.
+//
+// .SECTION See Also
+// vtkImplicitDataArrayTemplate vtkRectilinearCoordinatesDataArrayTemplate
+// vtkImageDataToPointSet
+
+#ifndef vtkAffineCoordinatesDataArrayTemplate_h
+#define vtkAffineCoordinatesDataArrayTemplate_h
+
+#include "vtkImplicitDataArrayTemplate.h"
+
+#include "vtkObjectFactory.h" // For VTK_STANDARD_NEW_BODY
+#include "vtkTypeTemplate.h" // For templated vtkObject API
+
+template <class Scalar>
+class vtkAffineCoordinatesDataArrayTemplate:
+    public vtkTypeTemplate<vtkAffineCoordinatesDataArrayTemplate<Scalar>,
+                           vtkImplicitDataArrayTemplate<Scalar> >
+{
+public:
+  vtkMappedDataArrayNewInstanceMacro(
+    vtkAffineCoordinatesDataArrayTemplate<Scalar>)
+  static vtkAffineCoordinatesDataArrayTemplate *New();
+  virtual void PrintSelf(ostream &os, vtkIndent indent);
+
+  // Description:
+  // Set the grid. The array gets 3 components and one tuple per point of
+  // extent.
+  void SetGrid(const int extent[6], const double origin[3],
+               const double spacing[3]);
+
+  // Description:
+  // Get the grid.
+  void GetExtent(int extent[6]);
+  void GetOrigin(double origin[3]);
+  void GetSpacing(double spacing[3]);
+
+  // Reimplemented virtuals -- see superclasses for descriptions:
+  Scalar GetValue(vtkIdType idx);
+  void GetTupleValue(vtkIdType idx, Scalar *t);
+  void GetTuple(vtkIdType i, double *tuple);
+  double* GetTuple(vtkIdType i)
+    { return this->vtkImplicitDataArrayTemplate<Scalar>::GetTuple(i); }
+
+protected:
+  vtkAffineCoordinatesDataArrayTemplate();
+  ~vtkAffineCoordinatesDataArrayTemplate();
+
+  virtual bool ComputeScalarRange(double *ranges);
+
+  // Description:
+  // Compute the point coordinates of tuple i.
+  void ComputePoint(vtkIdType i, double x[3])
+  {
+    const vtkIdType ij = i / this->Dimensions[0];
+    x[0] = this->Origin[0] + this->Spacing[0] *
+      (this->Extent[0] + i % this->Dimensions[0]);
+    x[1] = this->Origin[1] + this->Spacing[1] *
+      (this->Extent[2] + ij % this->Dimensions[1]);
+    x[2] = this->Origin[2] + this->Spacing[2] *
+      (this->Extent[4] + ij / this->Dimensions[1]);
+  }
+
+  int Extent[6];
+  vtkIdType Dimensions[3];
+  double Origin[3];
+  double Spacing[3];
+
+private:
+  vtkAffineCoordinatesDataArrayTemplate(
+    const vtkAffineCoordinatesDataArrayTemplate &); // Not implemented.
+  void operator=(
+    const vtkAffineCoordinatesDataArrayTemplate &); // Not implemented.
+};
+
+#include "vtkAffineCoordinatesDataArrayTemplate.txx"
+
+#endif //vtkAffineCoordinatesDataArrayTemplate_h
+
+// VTK-HeaderTest-Exclude: vtkAffineCoordinatesDataArrayTemplate.h
@@ -0,0 +1,161 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAffineCoordinatesDataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkAffineCoordinatesDataArrayTemplate_txx
+#define vtkAffineCoordinatesDataArrayTemplate_txx
+
+#include "vtkAffineCoordinatesDataArrayTemplate.h"
+
+#include <algorithm> // For std::min and std::max
+
+//------------------------------------------------------------------------------
+// Can't use vtkStandardNewMacro with a template.
+template <class Scalar> vtkAffineCoordinatesDataArrayTemplate<Scalar> *
+vtkAffineCoordinatesDataArrayTemplate<Scalar>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkAffineCoordinatesDataArrayTemplate<Scalar>)
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkAffineCoordinatesDataArrayTemplate<Scalar>
+::vtkAffineCoordinatesDataArrayTemplate()
+{
+  for (int i = 0; i < 3; ++i)
+    {
+    this->Extent[2 * i] = 0;
+    this->Extent[2 * i + 1] = -1;
+    this->Dimensions[i] = 0;
+    this->Origin[i] = 0.0;
+    this->Spacing[i] = 1.0;
+    }
+  this->NumberOfComponents = 3;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkAffineCoordinatesDataArrayTemplate<Scalar>
+::~vtkAffineCoordinatesDataArrayTemplate()
+{
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkAffineCoordinatesDataArrayTemplate<Scalar>
+::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->vtkAffineCoordinatesDataArrayTemplate<Scalar>::Superclass::PrintSelf(
+        os, indent);
+  os << indent << "Extent: " << this->Extent[0] << " " << this->Extent[1]
+     << " " << this->Extent[2] << " " << this->Extent[3] << " "
+     << this->Extent[4] << " " << this->Extent[5] << "\n";
+  os << indent << "Origin: " << this->Origin[0] << " " << this->Origin[1]
+     << " " << this->Origin[2] << "\n";
+  os << indent << "Spacing: " << this->Spacing[0] << " " << this->Spacing[1]
+     << " " << this->Spacing[2] << "\n";
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkAffineCoordinatesDataArrayTemplate<Scalar>
+::SetGrid(const int extent[6], const double origin[3],
+          const double spacing[3])
+{
+  vtkIdType numTuples = 1;
+  for (int i = 0; i < 3; ++i)
+    {
+    this->Extent[2 * i] = extent[2 * i];
+    this->Extent[2 * i + 1] = extent[2 * i + 1];
+    this->Dimensions[i] = std::max(extent[2 * i + 1] - extent[2 * i] + 1, 0);
+    this->Origin[i] = origin[i];
+    this->Spacing[i] = spacing[i];
+    numTuples *= this->Dimensions[i];
+    }
+  this->NumberOfComponents = 3;
+  this->SetNumberOfTuples(numTuples);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkAffineCoordinatesDataArrayTemplate<Scalar>
+::GetExtent(int extent[6])
+{
+  std::copy(this->Extent, this->Extent + 6, extent);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkAffineCoordinatesDataArrayTemplate<Scalar>
+::GetOrigin(double origin[3])
+{
+  std::copy(this->Origin, this->Origin + 3, origin);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkAffineCoordinatesDataArrayTemplate<Scalar>
+::GetSpacing(double spacing[3])
+{
+  std::copy(this->Spacing, this->Spacing + 3, spacing);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar vtkAffineCoordinatesDataArrayTemplate<Scalar>
+::GetValue(vtkIdType idx)
+{
+  double x[3];
+  this->ComputePoint(idx / 3, x);
+  return static_cast<Scalar>(x[idx % 3]);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkAffineCoordinatesDataArrayTemplate<Scalar>
+::GetTupleValue(vtkIdType idx, Scalar *t)
+{
+  double x[3];
+  this->ComputePoint(idx, x);
+  t[0] = static_cast<Scalar>(x[0]);
+  t[1] = static_cast<Scalar>(x[1]);
+  t[2] = static_cast<Scalar>(x[2]);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkAffineCoordinatesDataArrayTemplate<Scalar>
+::GetTuple(vtkIdType i, double *tuple)
+{
+  Scalar t[3];
+  this->GetTupleValue(i, t);
+  tuple[0] = static_cast<double>(t[0]);
+  tuple[1] = static_cast<double>(t[1]);
+  tuple[2] = static_cast<double>(t[2]);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> bool vtkAffineCoordinatesDataArrayTemplate<Scalar>
+::ComputeScalarRange(double *ranges)
+{
+  if (this->MaxId < 0)
+    {
+    return false;
+    }
+  // The extremes are the coordinates of the first and the last points.
+  Scalar first[3];
+  Scalar last[3];
+  this->GetTupleValue(0, first);
+  this->GetTupleValue(this->MaxId / 3, last);
+  for (int comp = 0; comp < 3; ++comp)
+    {
+    ranges[2 * comp] = std::min(static_cast<double>(first[comp]),
+                                static_cast<double>(last[comp]));
+    ranges[2 * comp + 1] = std::max(static_cast<double>(first[comp]),
+                                    static_cast<double>(last[comp]));
+    }
+  return true;
+}
+
+#endif //vtkAffineCoordinatesDataArrayTemplate_txx
@@ -0,0 +1,74 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConstantDataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkConstantDataArrayTemplate - Implicit array holding the same value
+// everywhere.
+//
+// .SECTION Description
+// vtkConstantDataArrayTemplate returns ConstantValue for every value of
+// every tuple. Set the number of components and tuples as for any other
+// array; nothing is allocated.
+//
+// .SECTION See Also
+// vtkImplicitDataArrayTemplate vtkRangeDataArrayTemplate
+
+#ifndef vtkConstantDataArrayTemplate_h
+#define vtkConstantDataArrayTemplate_h
+
+#include "vtkImplicitDataArrayTemplate.h"
+
+#include "vtkObjectFactory.h" // For VTK_STANDARD_NEW_BODY
+#include "vtkTypeTemplate.h" // For templated vtkObject API
+
+template <class Scalar>
+class vtkConstantDataArrayTemplate:
+    public vtkTypeTemplate<vtkConstantDataArrayTemplate<Scalar>,
+                           vtkImplicitDataArrayTemplate<Scalar> >
+{
+public:
+  vtkMappedDataArrayNewInstanceMacro(vtkConstantDataArrayTemplate<Scalar>)
+  static vtkConstantDataArrayTemplate *New();
+  virtual void PrintSelf(ostream &os, vtkIndent indent);
+
+  // Description:
+  // Set/Get the value of the array. Default is 0.
+  void SetConstantValue(Scalar value);
+  Scalar GetConstantValue() { return this->ConstantValue; }
+
+  // Reimplemented virtuals -- see superclasses for descriptions:
+  Scalar GetValue(vtkIdType) { return this->ConstantValue; }
+  void GetTupleValue(vtkIdType idx, Scalar *t);
+  void GetTuple(vtkIdType i, double *tuple);
+  double* GetTuple(vtkIdType i)
+    { return this->vtkImplicitDataArrayTemplate<Scalar>::GetTuple(i); }
+
+protected:
+  vtkConstantDataArrayTemplate();
+  ~vtkConstantDataArrayTemplate();
+
+  virtual bool ComputeScalarRange(double *ranges);
+
+  Scalar ConstantValue;
+
+private:
+  vtkConstantDataArrayTemplate(
+    const vtkConstantDataArrayTemplate &); // Not implemented.
+  void operator=(const vtkConstantDataArrayTemplate &); // Not implemented.
+};
+
+#include "vtkConstantDataArrayTemplate.txx"
+
+#endif //vtkConstantDataArrayTemplate_h
+
+// VTK-HeaderTest-Exclude: vtkConstantDataArrayTemplate.h
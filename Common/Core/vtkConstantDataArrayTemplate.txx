@@ -0,0 +1,92 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConstantDataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkConstantDataArrayTemplate_txx
+#define vtkConstantDataArrayTemplate_txx
+
+#include "vtkConstantDataArrayTemplate.h"
+
+#include <algorithm> // For std::fill
+
+//------------------------------------------------------------------------------
+// Can't use vtkStandardNewMacro with a template.
+template <class Scalar> vtkConstantDataArrayTemplate<Scalar> *
+vtkConstantDataArrayTemplate<Scalar>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkConstantDataArrayTemplate<Scalar>)
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkConstantDataArrayTemplate<Scalar>
+::vtkConstantDataArrayTemplate()
+  : ConstantValue(0)
+{
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkConstantDataArrayTemplate<Scalar>
+::~vtkConstantDataArrayTemplate()
+{
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkConstantDataArrayTemplate<Scalar>
+::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->vtkConstantDataArrayTemplate<Scalar>::Superclass::PrintSelf(
+        os, indent);
+  os << indent << "ConstantValue: " << this->ConstantValue << "\n";
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkConstantDataArrayTemplate<Scalar>
+::SetConstantValue(Scalar value)
+{
+  if (this->ConstantValue != value)
+    {
+    this->ConstantValue = value;
+    this->Modified();
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkConstantDataArrayTemplate<Scalar>
+::GetTupleValue(vtkIdType, Scalar *t)
+{
+  std::fill(t, t + this->NumberOfComponents, this->ConstantValue);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkConstantDataArrayTemplate<Scalar>
+::GetTuple(vtkIdType, double *tuple)
+{
+  std::fill(tuple, tuple + this->NumberOfComponents,
+            static_cast<double>(this->ConstantValue));
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> bool vtkConstantDataArrayTemplate<Scalar>
+::ComputeScalarRange(double *ranges)
+{
+  if (this->MaxId < 0)
+    {
+    return false;
+    }
+  std::fill(ranges, ranges + 2 * this->NumberOfComponents,
+            static_cast<double>(this->ConstantValue));
+  return true;
+}
+
+#endif //vtkConstantDataArrayTemplate_txx
@@ -276,7 +276,7 @@ void vtkDataArray::DeepCopy(vtkDataArray *da)
       {
       switch (da->GetDataType())
         {
-        vtkDataArrayIteratorMacro(
+        vtkDataArrayReadIteratorMacro(
           da, vtkDeepCopySwitchOnOutput(vtkDABegin, vtkDAEnd, this)
           );
 
@@ -305,6 +305,18 @@ void vtkDataArray::DeepCopy(vtkDataArray *da)
   this->Squeeze();
 }
 
+//----------------------------------------------------------------------------
+void vtkDataArray::ShallowCopy(vtkDataArray *da)
+{
+  this->DeepCopy(da);
+}
+
+//----------------------------------------------------------------------------
+int vtkDataArray::MapFile(const char*, vtkTypeInt64, vtkIdType, int)
+{
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 // These can be overridden for more efficiency
 double vtkDataArray::GetComponent(vtkIdType i, int j)
@@ -432,7 +444,7 @@ void vtkDataArray::InterpolateTuple(vtkIdType i, vtkIdList *ptIndices,
           }
         }
       break;
-        vtkDataArrayIteratorMacro(fromData,
+        vtkDataArrayReadIteratorMacro(fromData,
           vtkDataArrayInterpolateTuple(vtkDABegin,
                                        static_cast<vtkDAValueType*>(vto),
                                        numComp, ids, numIds, weights)
@@ -491,10 +503,11 @@ void vtkDataArray::InterpolateTuple(vtkIdType i,
         {
         // Use pointers:
         void *vto = this->WriteVoidPointer(loc, numComp);
-        void *vfrom1 = source1->GetVoidPointer(id1 * numComp);
-        void *vfrom2 = source2->GetVoidPointer(id2 * numComp);
-        vtkDataArrayInterpolateTuple<VTK_TT>(static_cast<VTK_TT*>(vfrom1),
-                                             static_cast<VTK_TT*>(vfrom2),
+        const void *vfrom1 = source1->GetReadVoidPointer(id1 * numComp);
+        const void *vfrom2 = source2->GetReadVoidPointer(id2 * numComp);
+        vtkDataArrayInterpolateTuple<VTK_TT>(
+                                         static_cast<const VTK_TT*>(vfrom1),
+                                         static_cast<const VTK_TT*>(vfrom2),
                                              static_cast<VTK_TT*>(vto),
                                              numComp, t);
         }
@@ -924,7 +937,7 @@ void vtkDataArray::GetTuples(vtkIdList *ptIds, vtkAbstractArray *aa)
 
   switch (this->GetDataType())
     {
-    vtkDataArrayIteratorMacro(this,
+    vtkDataArrayReadIteratorMacro(this,
       vtkDataArrayGetTuplesTemplate1(ids, idsEnd, vtkDABegin, outArray,
                                      this->NumberOfComponents)
       );
@@ -956,7 +969,7 @@ void vtkDataArray::GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *aa)
 
   switch (this->GetDataType())
     {
-    vtkTemplateMacro(vtkCopyTuples1( static_cast<VTK_TT *>(this->GetVoidPointer(0)), da,
+    vtkTemplateMacro(vtkCopyTuples1( static_cast<const VTK_TT *>(this->GetReadVoidPointer(0)), da,
                                      p1, p2 ) );
     // This is not supported by the template macro.
     // Switch to using the double interface.
@@ -1138,7 +1151,7 @@ bool vtkDataArray::ComputeScalarRange(double* ranges)
   bool computed = false;
   switch (this->GetDataType())
       {
-      vtkDataArrayIteratorMacro(this,
+      vtkDataArrayReadIteratorMacro(this,
         computed = vtkDataArrayPrivate::DoComputeScalarRange<vtkDAValueType>(
                                          vtkDABegin, vtkDAEnd,
                                          this->GetNumberOfComponents(),
@@ -1156,7 +1169,7 @@ bool vtkDataArray::ComputeVectorRange(double range[2])
   bool computed = false;
   switch (this->GetDataType())
     {
-    vtkDataArrayIteratorMacro(this,
+    vtkDataArrayReadIteratorMacro(this,
       computed = vtkDataArrayPrivate::DoComputeVectorRange<vtkDAValueType>(
                                        vtkDABegin, vtkDAEnd,
                                        this->GetNumberOfComponents(),
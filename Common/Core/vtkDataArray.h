@@ -252,6 +252,25 @@ public:
   virtual void DeepCopy(vtkAbstractArray *aa);
   virtual void DeepCopy(vtkDataArray *da);
 
+  // Description:
+  // Shallow copy of data. Arrays that can share their memory, like
+  // vtkDataArrayTemplate, share it and copy it on write; the default
+  // implementation makes a deep copy.
+  virtual void ShallowCopy(vtkDataArray *da);
+
+  // Description:
+  // Use numberOfValues values stored in a file from the given byte offset,
+  // mapped in memory instead of read: the system reads the values when
+  // they are accessed. The values must be stored in the native byte order.
+  // With copyOnWrite, the values can be modified in place and the
+  // modifications are never written to the file; otherwise the memory is
+  // read-only, and is copied before its first modification through the API
+  // of the array, or before GetVoidPointer() returns a pointer to it.
+  // Returns 1 on success, 0 if the file cannot be mapped or the array does
+  // not support it; the array is then unchanged.
+  virtual int MapFile(const char* fileName, vtkTypeInt64 offset,
+                      vtkIdType numberOfValues, int copyOnWrite);
+
   // Description:
   // Fill a component of a data array with a specified value. This method
   // sets the specified component to specified value for all tuples in the
@@ -442,6 +461,8 @@ inline vtkDataArray* vtkDataArray::FastDownCast(vtkAbstractArray *source)
     case TypedDataArray:
     case DataArray:
     case MappedDataArray:
+    case SOADataArrayTemplate:
+    case StridedDataArrayTemplate:
       return static_cast<vtkDataArray*>(source);
     default:
       return NULL;
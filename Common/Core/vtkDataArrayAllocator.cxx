@@ -0,0 +1,604 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArrayAllocator.h"
+
+#include "vtkAtomicTypes.h"
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+#include "vtkSMPTools.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <utility>
+
+#if defined(_WIN32)
+# include "vtkWindows.h"
+# include <malloc.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+# if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#  define MAP_ANONYMOUS MAP_ANON
+# endif
+#endif
+
+vtkStandardNewMacro(vtkDataArrayAllocator);
+
+namespace
+{
+// Alignment of the memory returned by malloc().
+const size_t MallocAlignment = 2 * sizeof(void*);
+
+// Size of the transparent huge pages.
+const size_t HugePageSize = 2 << 20;
+
+// Number of data types accounted for.
+const int NumberOfDataTypes = VTK_UNICODE_STRING + 1;
+
+size_t GetPageSize()
+{
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return static_cast<size_t>(info.dwPageSize);
+#else
+  return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// Alignment of the offsets of file maps.
+size_t GetMapGranularity()
+{
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return static_cast<size_t>(info.dwAllocationGranularity);
+#else
+  return GetPageSize();
+#endif
+}
+
+void AdviseHugePages(void* memory, size_t size)
+{
+#if defined(MADV_HUGEPAGE)
+  // madvise() needs page-aligned ranges.
+  size_t pageSize = GetPageSize();
+  size_t address = reinterpret_cast<size_t>(memory);
+  size_t first = (address + pageSize - 1) / pageSize * pageSize;
+  size_t last = (address + size) / pageSize * pageSize;
+  if (last > first)
+    {
+    madvise(reinterpret_cast<void*>(first), last - first, MADV_HUGEPAGE);
+    }
+#else
+  (void)memory;
+  (void)size;
+#endif
+}
+
+// Zero the pages of a block of memory.
+class vtkDataArrayAllocatorTouch
+{
+public:
+  char* Memory;
+  size_t Size;
+  size_t PageSize;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    size_t first = static_cast<size_t>(begin) * this->PageSize;
+    size_t last = static_cast<size_t>(end) * this->PageSize;
+    if (last > this->Size)
+      {
+      last = this->Size;
+      }
+    memset(this->Memory + first, 0, last - first);
+  }
+};
+
+// Holds the default allocator, and releases it on exit.
+class vtkDataArrayAllocatorDefault
+{
+public:
+  vtkDataArrayAllocatorDefault() : Allocator(0) {}
+  ~vtkDataArrayAllocatorDefault()
+  {
+    if (this->Allocator)
+      {
+      this->Allocator->UnRegister(0);
+      }
+  }
+  vtkDataArrayAllocator* Allocator;
+};
+
+vtkDataArrayAllocatorDefault DefaultAllocator;
+}
+
+//----------------------------------------------------------------------------
+class vtkDataArrayAllocatorInternals
+{
+public:
+  vtkAtomicInt64 AllocatedMemory[NumberOfDataTypes];
+  vtkAtomicInt64 NumberOfAllocations;
+
+  // The memory returned by MapFile(), with the address and length of its
+  // mapping, which starts on a page.
+  typedef std::map<void*, std::pair<void*, size_t> > MappedFilesType;
+  MappedFilesType MappedFiles;
+  vtkAtomicInt32 NumberOfMappedFiles;
+  vtkSimpleCriticalSection MappedFilesLock;
+};
+
+//----------------------------------------------------------------------------
+vtkDataArrayAllocator::vtkDataArrayAllocator()
+{
+  this->Alignment = 64;
+  this->Storage = HEAP;
+  this->HugePages = 0;
+  this->FirstTouch = 0;
+  this->Internals = new vtkDataArrayAllocatorInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArrayAllocator::~vtkDataArrayAllocator()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayAllocator::SetAlignment(int alignment)
+{
+  if (alignment < 1 || (alignment & (alignment - 1)) != 0)
+    {
+    vtkErrorMacro("The alignment must be a power of two, not "
+                  << alignment << ".");
+    return;
+    }
+  if (alignment == this->Alignment)
+    {
+    return;
+    }
+  if (this->GetNumberOfAllocations() > 0)
+    {
+    vtkErrorMacro("Cannot change the alignment while memory is allocated.");
+    return;
+    }
+  this->Alignment = alignment;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayAllocator::SetStorage(int storage)
+{
+  if (storage != HEAP && storage != MEMORY_MAP)
+    {
+    vtkErrorMacro("Unknown storage " << storage << ".");
+    return;
+    }
+  if (storage == this->Storage)
+    {
+    return;
+    }
+  if (this->GetNumberOfAllocations() > 0)
+    {
+    vtkErrorMacro("Cannot change the storage while memory is allocated.");
+    return;
+    }
+  this->Storage = storage;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void* vtkDataArrayAllocator::Allocate(size_t size, int dataType)
+{
+  void* memory = this->AllocateMemory(size);
+  if (memory)
+    {
+    if (this->FirstTouch)
+      {
+      this->TouchMemory(memory, size);
+      }
+    this->Account(static_cast<vtkTypeInt64>(size), 1, dataType);
+    }
+  return memory;
+}
+
+//----------------------------------------------------------------------------
+void* vtkDataArrayAllocator::Reallocate(void* memory, size_t oldSize,
+                                        size_t newSize, int dataType)
+{
+  if (!memory)
+    {
+    return this->Allocate(newSize, dataType);
+    }
+
+  void* newMemory;
+  bool mapped = this->IsMappedFile(memory);
+  if (this->FirstTouch || mapped)
+    {
+    newMemory = this->AllocateMemory(newSize);
+    if (newMemory)
+      {
+      if (this->FirstTouch)
+        {
+        this->TouchMemory(newMemory, newSize);
+        }
+      memcpy(newMemory, memory, oldSize < newSize ? oldSize : newSize);
+      if (!mapped || !this->UnmapFile(memory))
+        {
+        this->FreeMemory(memory, oldSize);
+        }
+      }
+    }
+  else
+    {
+    newMemory = this->ReallocateMemory(memory, oldSize, newSize);
+    }
+
+  if (newMemory)
+    {
+    this->Account(static_cast<vtkTypeInt64>(newSize) -
+                  static_cast<vtkTypeInt64>(oldSize), 0, dataType);
+    }
+  return newMemory;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayAllocator::Free(void* memory, size_t size, int dataType)
+{
+  if (memory)
+    {
+    if (!this->UnmapFile(memory))
+      {
+      this->FreeMemory(memory, size);
+      }
+    this->Account(-static_cast<vtkTypeInt64>(size), -1, dataType);
+    }
+}
+
+//----------------------------------------------------------------------------
+void* vtkDataArrayAllocator::MapFile(const char* fileName,
+                                     vtkTypeInt64 offset, size_t size,
+                                     int copyOnWrite, int dataType)
+{
+  if (!fileName || offset < 0 || size == 0)
+    {
+    return NULL;
+    }
+
+  // The mapping starts on a page, before the offset.
+  vtkTypeInt64 granularity = static_cast<vtkTypeInt64>(GetMapGranularity());
+  vtkTypeInt64 mapOffset = offset / granularity * granularity;
+  size_t length = size + static_cast<size_t>(offset - mapOffset);
+  vtkTypeInt64 end = offset + static_cast<vtkTypeInt64>(size);
+  void* base = NULL;
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    {
+    return NULL;
+    }
+  LARGE_INTEGER fileSize;
+  if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= end)
+    {
+    HANDLE mapping = CreateFileMappingA(
+      file, NULL, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+    if (mapping)
+      {
+      // The view keeps the mapping open.
+      base = MapViewOfFile(
+        mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ,
+        static_cast<DWORD>(mapOffset >> 32),
+        static_cast<DWORD>(mapOffset & 0xffffffff), length);
+      CloseHandle(mapping);
+      }
+    }
+  CloseHandle(file);
+#else
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+    {
+    return NULL;
+    }
+  // Accessing pages past the end of the file would crash.
+  struct stat fs;
+  if (fstat(fd, &fs) == 0 && static_cast<vtkTypeInt64>(fs.st_size) >= end)
+    {
+    base = mmap(NULL, length,
+                copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ,
+                MAP_PRIVATE, fd, static_cast<off_t>(mapOffset));
+    if (base == MAP_FAILED)
+      {
+      base = NULL;
+      }
+    }
+  close(fd);
+#endif
+
+  if (!base)
+    {
+    return NULL;
+    }
+
+  void* memory = static_cast<char*>(base) + (offset - mapOffset);
+  this->Internals->MappedFilesLock.Lock();
+  this->Internals->MappedFiles[memory] = std::make_pair(base, length);
+  this->Internals->MappedFilesLock.Unlock();
+  ++this->Internals->NumberOfMappedFiles;
+  this->Account(static_cast<vtkTypeInt64>(size), 1, dataType);
+  return memory;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataArrayAllocator::IsMappedFile(void* memory)
+{
+  if (this->Internals->NumberOfMappedFiles == 0)
+    {
+    return false;
+    }
+  this->Internals->MappedFilesLock.Lock();
+  bool mapped = this->Internals->MappedFiles.find(memory) !=
+    this->Internals->MappedFiles.end();
+  this->Internals->MappedFilesLock.Unlock();
+  return mapped;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataArrayAllocator::UnmapFile(void* memory)
+{
+  // Most allocators never map files.
+  if (this->Internals->NumberOfMappedFiles == 0)
+    {
+    return false;
+    }
+
+  this->Internals->MappedFilesLock.Lock();
+  vtkDataArrayAllocatorInternals::MappedFilesType::iterator it =
+    this->Internals->MappedFiles.find(memory);
+  if (it == this->Internals->MappedFiles.end())
+    {
+    this->Internals->MappedFilesLock.Unlock();
+    return false;
+    }
+  std::pair<void*, size_t> mapping = it->second;
+  this->Internals->MappedFiles.erase(it);
+  this->Internals->MappedFilesLock.Unlock();
+  --this->Internals->NumberOfMappedFiles;
+
+#if defined(_WIN32)
+  UnmapViewOfFile(mapping.first);
+#else
+  munmap(mapping.first, mapping.second);
+#endif
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void* vtkDataArrayAllocator::AllocateMemory(size_t size)
+{
+  bool hugePages = this->HugePages && size >= HugePageSize;
+
+  if (this->Storage == MEMORY_MAP)
+    {
+#if defined(_WIN32)
+    return VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE,
+                        PAGE_READWRITE);
+#else
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+      {
+      return NULL;
+      }
+    if (hugePages)
+      {
+      AdviseHugePages(memory, size);
+      }
+    return memory;
+#endif
+    }
+
+  size_t alignment = static_cast<size_t>(this->Alignment);
+#if defined(_WIN32)
+  return _aligned_malloc(size, alignment < sizeof(void*) ?
+                         sizeof(void*) : alignment);
+#else
+  if (hugePages)
+    {
+    // Huge pages are only used for aligned ranges.
+    alignment = HugePageSize;
+    }
+  else if (alignment <= MallocAlignment)
+    {
+    return malloc(size);
+    }
+  void* memory = NULL;
+  if (posix_memalign(&memory, alignment, size) != 0)
+    {
+    return NULL;
+    }
+  if (hugePages)
+    {
+    AdviseHugePages(memory, size);
+    }
+  return memory;
+#endif
+}
+
+//----------------------------------------------------------------------------
+void* vtkDataArrayAllocator::ReallocateMemory(void* memory, size_t oldSize,
+                                              size_t newSize)
+{
+#if defined(_WIN32)
+  if (this->Storage == HEAP)
+    {
+    size_t alignment = static_cast<size_t>(this->Alignment);
+    return _aligned_realloc(memory, newSize, alignment < sizeof(void*) ?
+                            sizeof(void*) : alignment);
+    }
+#else
+# if !defined(__APPLE__)
+  // OS X's realloc does not free memory when the new block is smaller.
+  if (this->Storage == HEAP && !this->HugePages &&
+      static_cast<size_t>(this->Alignment) <= MallocAlignment)
+    {
+    return realloc(memory, newSize);
+    }
+# endif
+# if defined(MREMAP_MAYMOVE)
+  if (this->Storage == MEMORY_MAP)
+    {
+    // The pages are moved, not copied.
+    void* newMemory = mremap(memory, oldSize, newSize, MREMAP_MAYMOVE);
+    if (newMemory == MAP_FAILED)
+      {
+      return NULL;
+      }
+    if (this->HugePages && newSize >= HugePageSize)
+      {
+      AdviseHugePages(newMemory, newSize);
+      }
+    return newMemory;
+    }
+# endif
+#endif
+
+  void* newMemory = this->AllocateMemory(newSize);
+  if (newMemory)
+    {
+    memcpy(newMemory, memory, oldSize < newSize ? oldSize : newSize);
+    this->FreeMemory(memory, oldSize);
+    }
+  return newMemory;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayAllocator::FreeMemory(void* memory, size_t size)
+{
+  if (this->Storage == MEMORY_MAP)
+    {
+#if defined(_WIN32)
+    (void)size;
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    munmap(memory, size);
+#endif
+    return;
+    }
+
+  (void)size;
+#if defined(_WIN32)
+  _aligned_free(memory);
+#else
+  free(memory);
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayAllocator::TouchMemory(void* memory, size_t size)
+{
+  vtkDataArrayAllocatorTouch touch;
+  touch.Memory = static_cast<char*>(memory);
+  touch.Size = size;
+  touch.PageSize = GetPageSize();
+  vtkIdType numberOfPages =
+    static_cast<vtkIdType>((size + touch.PageSize - 1) / touch.PageSize);
+  // Chunks of 64 pages keep small allocations serial.
+  vtkSMPTools::For(0, numberOfPages, 64, touch);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayAllocator::Account(vtkTypeInt64 size,
+                                    vtkTypeInt64 allocations, int dataType)
+{
+  if (dataType < 0 || dataType >= NumberOfDataTypes)
+    {
+    dataType = VTK_VOID;
+    }
+  this->Internals->AllocatedMemory[dataType] += size;
+  this->Internals->NumberOfAllocations += allocations;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkDataArrayAllocator::GetAllocatedMemory(int dataType)
+{
+  if (dataType < 0 || dataType >= NumberOfDataTypes)
+    {
+    dataType = VTK_VOID;
+    }
+  return this->Internals->AllocatedMemory[dataType];
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkDataArrayAllocator::GetAllocatedMemory()
+{
+  vtkTypeInt64 total = 0;
+  for (int i = 0; i < NumberOfDataTypes; ++i)
+    {
+    total += this->Internals->AllocatedMemory[i];
+    }
+  return total;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkDataArrayAllocator::GetNumberOfAllocations()
+{
+  return this->Internals->NumberOfAllocations;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayAllocator::SetDefaultAllocator(
+  vtkDataArrayAllocator* allocator)
+{
+  if (allocator == DefaultAllocator.Allocator)
+    {
+    return;
+    }
+  if (allocator)
+    {
+    allocator->Register(0);
+    }
+  if (DefaultAllocator.Allocator)
+    {
+    DefaultAllocator.Allocator->UnRegister(0);
+    }
+  DefaultAllocator.Allocator = allocator;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArrayAllocator* vtkDataArrayAllocator::GetDefaultAllocator()
+{
+  return DefaultAllocator.Allocator;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Alignment: " << this->Alignment << "\n";
+  os << indent << "Storage: "
+     << (this->Storage == MEMORY_MAP ? "MEMORY_MAP" : "HEAP") << "\n";
+  os << indent << "HugePages: " << this->HugePages << "\n";
+  os << indent << "FirstTouch: " << this->FirstTouch << "\n";
+  os << indent << "AllocatedMemory: " << this->GetAllocatedMemory() << "\n";
+  os << indent << "NumberOfAllocations: "
+     << this->GetNumberOfAllocations() << "\n";
+}
@@ -0,0 +1,181 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkDataArrayAllocator - allocates the memory of data arrays
+// .SECTION Description
+// vtkDataArrayAllocator controls how vtkDataArrayTemplate subclasses
+// (vtkFloatArray, vtkIdTypeArray, ...) allocate their values. By default,
+// arrays use malloc(); an allocator can be given to a single array with
+// vtkDataArrayTemplate::SetAllocator(), or to every array with
+// SetDefaultAllocator().
+//
+// The memory is aligned on Alignment bytes, 64 by default, so that
+// vectorized kernels can use aligned loads on the first value. It comes
+// from the heap, or from anonymous memory maps with SetStorageToMemoryMap(),
+// which return the memory to the system as soon as it is freed. With
+// HugePages on, the allocations of 2 MiB or more use transparent huge
+// pages, where the system supports them (Linux), reducing TLB misses on
+// large arrays. With FirstTouch on, new memory is zeroed in parallel with
+// vtkSMPTools, so that on NUMA systems its pages are placed near the
+// threads that will process it, rather than all on the node of the thread
+// allocating it.
+//
+// MapFile() maps a region of a file in memory instead of reading it: the
+// system reads the pages when they are accessed, and can evict them under
+// memory pressure, so that arrays larger than the physical memory can be
+// used.
+//
+// The allocator accounts for the memory it currently provides, per data
+// type, see GetAllocatedMemory().
+//
+// Subclasses can obtain the memory elsewhere, e.g. from a NUMA aware
+// library, by overriding AllocateMemory(), ReallocateMemory() and
+// FreeMemory().
+//
+// .SECTION See Also
+// vtkDataArrayTemplate
+
+#ifndef vtkDataArrayAllocator_h
+#define vtkDataArrayAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <cstddef> // For size_t
+
+class vtkDataArrayAllocatorInternals;
+
+class VTKCOMMONCORE_EXPORT vtkDataArrayAllocator : public vtkObject
+{
+public:
+  static vtkDataArrayAllocator *New();
+  vtkTypeMacro(vtkDataArrayAllocator,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+//BTX
+  enum StorageTypes
+  {
+    HEAP,
+    MEMORY_MAP
+  };
+//ETX
+
+  // Description:
+  // The alignment of the memory in bytes, a power of two. 64 by default,
+  // the size of a cache line. Memory maps are aligned on pages. It cannot
+  // be changed while memory is allocated.
+  void SetAlignment(int alignment);
+  vtkGetMacro(Alignment, int);
+
+  // Description:
+  // Where the memory comes from: HEAP, the default, or MEMORY_MAP for
+  // anonymous memory maps. It cannot be changed while memory is
+  // allocated.
+  void SetStorage(int storage);
+  vtkGetMacro(Storage, int);
+  void SetStorageToHeap() { this->SetStorage(HEAP); }
+  void SetStorageToMemoryMap() { this->SetStorage(MEMORY_MAP); }
+
+  // Description:
+  // Use transparent huge pages for the allocations of 2 MiB or more. Off by
+  // default. Ignored where the system does not support them.
+  vtkSetMacro(HugePages, int);
+  vtkGetMacro(HugePages, int);
+  vtkBooleanMacro(HugePages, int);
+
+  // Description:
+  // Zero new memory in parallel with vtkSMPTools, so that its pages are
+  // placed near the threads that will use them. Off by default.
+  vtkSetMacro(FirstTouch, int);
+  vtkGetMacro(FirstTouch, int);
+  vtkBooleanMacro(FirstTouch, int);
+
+  // Description:
+  // Allocate, reallocate and free size bytes of memory for values of the
+  // given VTK data type (VTK_FLOAT, ...). Free() and Reallocate() must be
+  // given the size of the memory, as given to Allocate(). Allocate() and
+  // Reallocate() return NULL when out of memory; Reallocate() then leaves
+  // the memory unchanged. These methods are thread safe.
+  void* Allocate(size_t size, int dataType);
+  void* Reallocate(void* memory, size_t oldSize, size_t newSize,
+                   int dataType);
+  void Free(void* memory, size_t size, int dataType);
+
+  // Description:
+  // Map size bytes of a file in memory, from the given offset, for values
+  // of the given data type. With copyOnWrite, the memory can be modified,
+  // and the modifications remain private to this process; otherwise the
+  // memory is read-only. The file is never modified. Returns NULL if the
+  // file cannot be opened, is too short, or cannot be mapped. The memory
+  // is released with Free(), and reallocated to memory of this allocator
+  // with Reallocate(). This method is thread safe.
+  void* MapFile(const char* fileName, vtkTypeInt64 offset, size_t size,
+                int copyOnWrite, int dataType);
+
+  // Description:
+  // Bytes currently allocated by this allocator for values of the given
+  // data type, or for all data types.
+  vtkTypeInt64 GetAllocatedMemory(int dataType);
+  vtkTypeInt64 GetAllocatedMemory();
+
+  // Description:
+  // Number of blocks of memory currently allocated by this allocator.
+  vtkTypeInt64 GetNumberOfAllocations();
+
+  // Description:
+  // The allocator used by the data arrays without allocator of their own.
+  // NULL, the default, means malloc(). Memory already allocated by arrays
+  // is freed by the allocator it came from.
+  static void SetDefaultAllocator(vtkDataArrayAllocator* allocator);
+  static vtkDataArrayAllocator* GetDefaultAllocator();
+
+protected:
+  vtkDataArrayAllocator();
+  ~vtkDataArrayAllocator();
+
+  // Description:
+  // Obtain and release the memory. Override these to obtain the memory
+  // elsewhere; the accounting and first touch are done by the callers.
+  // ReallocateMemory() is not used when FirstTouch is on, as the new
+  // memory must be touched before the values are copied to it. They are
+  // never given memory from MapFile().
+  virtual void* AllocateMemory(size_t size);
+  virtual void* ReallocateMemory(void* memory, size_t oldSize,
+                                 size_t newSize);
+  virtual void FreeMemory(void* memory, size_t size);
+
+  // Description:
+  // Zero the memory in parallel.
+  void TouchMemory(void* memory, size_t size);
+
+  int Alignment;
+  int Storage;
+  int HugePages;
+  int FirstTouch;
+
+private:
+  vtkDataArrayAllocator(const vtkDataArrayAllocator&);  // Not implemented.
+  void operator=(const vtkDataArrayAllocator&);  // Not implemented.
+
+  void Account(vtkTypeInt64 size, vtkTypeInt64 allocations, int dataType);
+
+  // Unmap memory from MapFile(). Returns false if the memory does not come
+  // from MapFile().
+  bool UnmapFile(void* memory);
+  bool IsMappedFile(void* memory);
+
+  vtkDataArrayAllocatorInternals* Internals;
+};
+
+#endif
@@ -0,0 +1,212 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayComponentIterator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkDataArrayComponentIterator - STL-style random access iterator for
+// arrays addressed by (tuple, component).
+//
+// .SECTION Description
+// vtkDataArrayComponentIterator walks the values of an array in the usual
+// vtkDataArray order (all components of a tuple before the next tuple) but
+// reaches each value through ArrayType::GetComponentReference(tuple, comp),
+// a non-virtual inline method. It is the iterator of arrays such as
+// vtkSOADataArrayTemplate and vtkStridedDataArrayTemplate whose memory is
+// not laid out as a single contiguous block: unlike
+// vtkTypedDataArrayIterator, dereferencing involves no virtual call and
+// no division, so loops over these arrays are as cheap as indexing the
+// underlying buffers directly.
+//
+// ArrayType must define ValueType, GetNumberOfComponents() and
+// ValueType& GetComponentReference(vtkIdType tuple, int comp).
+//
+// .SECTION See Also
+// vtkTypedDataArrayIterator vtkDataArrayIteratorMacro
+
+#ifndef vtkDataArrayComponentIterator_h
+#define vtkDataArrayComponentIterator_h
+
+#include <iterator> // For iterator traits
+
+#include "vtkType.h" // For vtkIdType
+
+template<class ArrayType>
+class vtkDataArrayComponentIterator
+{
+public:
+  typedef typename ArrayType::ValueType Scalar;
+
+  typedef std::random_access_iterator_tag iterator_category;
+  typedef Scalar value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef Scalar& reference;
+  typedef Scalar* pointer;
+
+  vtkDataArrayComponentIterator()
+    : Data(NULL), NumberOfComponents(1), Tuple(0), Component(0) {}
+
+  explicit vtkDataArrayComponentIterator(ArrayType *arr,
+                                         const vtkIdType index = 0)
+    : Data(arr),
+      NumberOfComponents(arr->GetNumberOfComponents())
+  {
+    this->SetIndex(index);
+  }
+
+  vtkDataArrayComponentIterator(const vtkDataArrayComponentIterator &o)
+    : Data(o.Data),
+      NumberOfComponents(o.NumberOfComponents),
+      Tuple(o.Tuple),
+      Component(o.Component)
+  {
+  }
+
+  vtkDataArrayComponentIterator&
+  operator=(const vtkDataArrayComponentIterator &o)
+  {
+    this->Data = o.Data;
+    this->NumberOfComponents = o.NumberOfComponents;
+    this->Tuple = o.Tuple;
+    this->Component = o.Component;
+    return *this;
+  }
+
+  bool operator==(const vtkDataArrayComponentIterator &o) const
+  {
+    return this->Data == o.Data && this->Tuple == o.Tuple &&
+      this->Component == o.Component;
+  }
+
+  bool operator!=(const vtkDataArrayComponentIterator &o) const
+  {
+    return !(*this == o);
+  }
+
+  bool operator>(const vtkDataArrayComponentIterator &o) const
+  {
+    return this->GetIndex() > o.GetIndex();
+  }
+
+  bool operator>=(const vtkDataArrayComponentIterator &o) const
+  {
+    return this->GetIndex() >= o.GetIndex();
+  }
+
+  bool operator<(const vtkDataArrayComponentIterator &o) const
+  {
+    return this->GetIndex() < o.GetIndex();
+  }
+
+  bool operator<=(const vtkDataArrayComponentIterator &o) const
+  {
+    return this->GetIndex() <= o.GetIndex();
+  }
+
+  Scalar& operator*() const
+  {
+    return this->Data->GetComponentReference(this->Tuple, this->Component);
+  }
+
+  Scalar* operator->() const
+  {
+    return &this->Data->GetComponentReference(this->Tuple, this->Component);
+  }
+
+  Scalar& operator[](const difference_type &n) const
+  {
+    return *(*this + n);
+  }
+
+  vtkDataArrayComponentIterator& operator++()
+  {
+    if (++this->Component == this->NumberOfComponents)
+      {
+      this->Component = 0;
+      ++this->Tuple;
+      }
+    return *this;
+  }
+
+  vtkDataArrayComponentIterator& operator--()
+  {
+    if (--this->Component < 0)
+      {
+      this->Component = this->NumberOfComponents - 1;
+      --this->Tuple;
+      }
+    return *this;
+  }
+
+  vtkDataArrayComponentIterator operator++(int)
+  {
+    vtkDataArrayComponentIterator tmp(*this);
+    ++(*this);
+    return tmp;
+  }
+
+  vtkDataArrayComponentIterator operator--(int)
+  {
+    vtkDataArrayComponentIterator tmp(*this);
+    --(*this);
+    return tmp;
+  }
+
+  vtkDataArrayComponentIterator operator+(const difference_type& n) const
+  {
+    vtkDataArrayComponentIterator tmp(*this);
+    return tmp += n;
+  }
+
+  vtkDataArrayComponentIterator operator-(const difference_type& n) const
+  {
+    vtkDataArrayComponentIterator tmp(*this);
+    return tmp -= n;
+  }
+
+  difference_type operator-(const vtkDataArrayComponentIterator& other) const
+  {
+    return this->GetIndex() - other.GetIndex();
+  }
+
+  vtkDataArrayComponentIterator& operator+=(const difference_type& n)
+  {
+    this->SetIndex(this->GetIndex() + n);
+    return *this;
+  }
+
+  vtkDataArrayComponentIterator& operator-=(const difference_type& n)
+  {
+    this->SetIndex(this->GetIndex() - n);
+    return *this;
+  }
+
+private:
+  vtkIdType GetIndex() const
+  {
+    return this->Tuple * this->NumberOfComponents + this->Component;
+  }
+
+  void SetIndex(vtkIdType index)
+  {
+    this->Tuple = index / this->NumberOfComponents;
+    this->Component = static_cast<int>(index % this->NumberOfComponents);
+  }
+
+  ArrayType *Data;
+  int NumberOfComponents;
+  vtkIdType Tuple;
+  int Component;
+};
+
+#endif // vtkDataArrayComponentIterator_h
+
+// VTK-HeaderTest-Exclude: vtkDataArrayComponentIterator.h
@@ -42,7 +42,11 @@
 // optimizations in the standard template library to occur (such as reducing
 // std::copy to memmove).
 //
-// For arrays that are subclasses of vtkTypedDataArray (but not
+// For vtkSOADataArrayTemplate and vtkStridedDataArrayTemplate, the iterators
+// are vtkDataArrayComponentIterators, which reach the values through inline,
+// non-virtual accessors of these classes.
+//
+// For other arrays that are subclasses of vtkTypedDataArray (but not
 // vtkDataArrayTemplate), a vtkTypedDataArrayIterator is used.
 // Such iterators safely traverse the array using API calls and have
 // pointer-like semantics, but add about a 35% performance overhead compared
@@ -56,6 +60,11 @@
 // vtkAbstractArray::GetVoidPointer(...) to vtkDAValueType* to create the
 // iterators.
 //
+// vtkDataArrayReadIteratorMacro is the same macro for code that only reads
+// the values. For vtkDataArrayTemplate, its iterators point to const values
+// and are obtained without first copying memory that the array shares with
+// other arrays (see vtkDataArrayTemplate::ShallowCopy()).
+//
 // To use this macro, create a templated worker function:
 //
 // template <class Iterator>
@@ -71,12 +80,14 @@
 //   }
 //
 // .SECTION See Also
-// vtkTemplateMacro vtkTypedDataArrayIterator
+// vtkTemplateMacro vtkTypedDataArrayIterator vtkDataArrayComponentIterator
 
 #ifndef vtkDataArrayIteratorMacro_h
 #define vtkDataArrayIteratorMacro_h
 
 #include "vtkDataArrayTemplate.h" // For all classes referred to in the macro
+#include "vtkSOADataArrayTemplate.h" // For all classes referred to in the macro
+#include "vtkStridedDataArrayTemplate.h" // For all classes referred to in the macro
 #include "vtkSetGet.h" // For vtkTemplateMacro
 
 // Silence 'unused typedef' warnings on GCC.
@@ -88,7 +99,11 @@
 #define _vtkDAIMUnused
 #endif
 
-#define vtkDataArrayIteratorMacro(_array, _call)                           \
+// Expands to the branches of vtkDataArrayIteratorMacro, with the iterator
+// type, the begin and end methods of vtkDataArrayTemplate, and the method
+// of vtkAbstractArray used for the other arrays as arguments.
+#define vtkDataArrayIteratorMacroInternal(_array, _call, _iterator,        \
+                                          _begin, _end, _pointer)          \
   vtkTemplateMacro(                                                        \
     vtkAbstractArray *_aa(_array);                                         \
     if (vtkDataArrayTemplate<VTK_TT> *_dat =                               \
@@ -96,13 +111,38 @@
       {                                                                    \
       typedef VTK_TT vtkDAValueType;                                       \
       typedef vtkDataArrayTemplate<vtkDAValueType> vtkDAContainerType;     \
-      typedef vtkDAContainerType::Iterator vtkDAIteratorType;              \
-      vtkDAIteratorType vtkDABegin(_dat->Begin());                         \
-      vtkDAIteratorType vtkDAEnd(_dat->End());                             \
+      typedef vtkDAContainerType::_iterator vtkDAIteratorType;             \
+      vtkDAIteratorType vtkDABegin(_dat->_begin());                        \
+      vtkDAIteratorType vtkDAEnd(_dat->_end());                            \
       (void)vtkDABegin; /* Prevent warnings when unused */                 \
       (void)vtkDAEnd;                                                      \
       _call;                                                               \
       }                                                                    \
+    else if (vtkSOADataArrayTemplate<VTK_TT> *_soa =                       \
+             vtkSOADataArrayTemplate<VTK_TT>::FastDownCast(_aa))           \
+      {                                                                    \
+      typedef VTK_TT vtkDAValueType;                                       \
+      typedef vtkSOADataArrayTemplate<vtkDAValueType> vtkDAContainerType;  \
+      typedef vtkDAContainerType::Iterator vtkDAIteratorType;              \
+      vtkDAIteratorType vtkDABegin(_soa->Begin());                         \
+      vtkDAIteratorType vtkDAEnd(_soa->End());                             \
+      (void)vtkDABegin;                                                    \
+      (void)vtkDAEnd;                                                      \
+      _call;                                                               \
+      }                                                                    \
+    else if (vtkStridedDataArrayTemplate<VTK_TT> *_sda =                   \
+             vtkStridedDataArrayTemplate<VTK_TT>::FastDownCast(_aa))       \
+      {                                                                    \
+      typedef VTK_TT vtkDAValueType;                                       \
+      typedef vtkStridedDataArrayTemplate<vtkDAValueType>                  \
+        vtkDAContainerType;                                                \
+      typedef vtkDAContainerType::Iterator vtkDAIteratorType;              \
+      vtkDAIteratorType vtkDABegin(_sda->Begin());                         \
+      vtkDAIteratorType vtkDAEnd(_sda->End());                             \
+      (void)vtkDABegin;                                                    \
+      (void)vtkDAEnd;                                                      \
+      _call;                                                               \
+      }                                                                    \
     else if (vtkTypedDataArray<VTK_TT> *_tda =                             \
              vtkTypedDataArray<VTK_TT>::FastDownCast(_aa))                 \
       {                                                                    \
@@ -121,9 +161,9 @@
        * Cast the void pointer and hope for the best! */                   \
       typedef VTK_TT vtkDAValueType;                                       \
       typedef vtkAbstractArray vtkDAContainerType _vtkDAIMUnused;          \
-      typedef vtkDAValueType* vtkDAIteratorType;                           \
+      typedef vtkDataArrayTemplate<VTK_TT>::_iterator vtkDAIteratorType;   \
       vtkDAIteratorType vtkDABegin =                                       \
-        static_cast<vtkDAIteratorType>(_aa->GetVoidPointer(0));            \
+        static_cast<vtkDAIteratorType>(_aa->_pointer(0));                  \
       vtkDAIteratorType vtkDAEnd = vtkDABegin + _aa->GetMaxId() + 1;       \
       (void)vtkDABegin;                                                    \
       (void)vtkDAEnd;                                                      \
@@ -131,6 +171,17 @@
       }                                                                    \
     )
 
+#define vtkDataArrayIteratorMacro(_array, _call)                           \
+  vtkDataArrayIteratorMacroInternal(_array, _call, Iterator, Begin, End,   \
+                                    GetVoidPointer)
+
+// Same as vtkDataArrayIteratorMacro, for code that only reads the values:
+// the iterators of vtkDataArrayTemplate arrays are then pointers to const
+// values, and memory shared with other arrays is not copied first.
+#define vtkDataArrayReadIteratorMacro(_array, _call)                       \
+  vtkDataArrayIteratorMacroInternal(_array, _call, ConstIterator,          \
+                                    ReadBegin, ReadEnd, GetReadVoidPointer)
+
 #endif //vtkDataArrayIteratorMacro_h
 
 // VTK-HeaderTest-Exclude: vtkDataArrayIteratorMacro.h
@@ -23,12 +23,18 @@
 
 #include "vtkCommonCoreModule.h" // For export macro
 #include "vtkTypedDataArray.h"
+#include "vtkAtomicTypes.h" // For vtkAtomic
 #include "vtkTypeTemplate.h" // For templated vtkObject API
 #include <cassert> // for assert()
 
+class vtkDataArrayAllocator;
+
 template <class T>
 class vtkDataArrayTemplateLookup;
 
+template <class T>
+class vtkDataArrayTemplateSharedBuffer;
+
 template <class T>
 class VTKCOMMONCORE_EXPORT vtkDataArrayTemplate:
     public vtkTypeTemplate<vtkDataArrayTemplate<T>, vtkTypedDataArray<T> >
@@ -45,6 +51,7 @@ public:
   // Rather than using this member directly, consider using
   // vtkDataArrayIteratorMacro for safety and efficiency.
   typedef ValueType* Iterator;
+  typedef const ValueType* ConstIterator;
 
   // Description:
   // Return an iterator initialized to the first element of the data.
@@ -58,6 +65,13 @@ public:
   // vtkDataArrayIteratorMacro for safety and efficiency.
   Iterator End() { return Iterator(this->GetVoidPointer(this->MaxId + 1)); }
 
+  // Description:
+  // Return iterators to read the data, which unlike Begin() and End() do
+  // not copy memory shared with other arrays. Rather than using these
+  // members directly, consider using vtkDataArrayReadIteratorMacro.
+  ConstIterator ReadBegin() { return this->GetReadPointer(0); }
+  ConstIterator ReadEnd() { return this->GetReadPointer(this->MaxId + 1); }
+
   // Description:
   // Perform a fast, safe cast from a vtkAbstractArray to a
   // vtkDataArrayTemplate.
@@ -77,6 +91,37 @@ public:
   // Release storage and reset array to initial state.
   void Initialize();
 
+  // Description:
+  // Share the memory of an array of the same type instead of copying it.
+  // The memory is reference counted, and an array copies it before its
+  // first modification through the API of the array (SetValue(),
+  // InsertNextTuple(), WritePointer(), ...), so the other arrays never see
+  // the modification. Since the data may be written through the pointer
+  // returned by GetPointer() or GetVoidPointer(), these methods copy the
+  // memory too while other arrays share it; GetReadPointer() and
+  // GetReadVoidPointer() do not. Arrays of another type are deep copied.
+  virtual void ShallowCopy(vtkDataArray* da);
+
+  // Description:
+  // Map values stored in a file in memory, see vtkDataArray::MapFile().
+  // The file is mapped by the allocator of this array, or the default
+  // allocator, which account for it.
+  virtual int MapFile(const char* fileName, vtkTypeInt64 offset,
+                      vtkIdType numberOfValues, int copyOnWrite);
+
+  // Description:
+  // Return true if the memory of this array is shared with other arrays,
+  // or mapped read-only, and will be copied before its next modification.
+  bool HasSharedBuffer();
+
+  // Description:
+  // The allocator used for the memory of this array. NULL, the default,
+  // means vtkDataArrayAllocator::GetDefaultAllocator(), or malloc() if
+  // there is no default allocator. Memory already allocated is kept until
+  // the array is reallocated.
+  void SetAllocator(vtkDataArrayAllocator* allocator);
+  vtkDataArrayAllocator* GetAllocator() { return this->Allocator; }
+
   // Description:
   // Return the size of the data type.
   int GetDataTypeSize() { return static_cast<int>(sizeof(T)); }
@@ -172,7 +217,14 @@ public:
 
   // Description:
   // Resize object to just fit data requirement. Reclaims extra memory.
-  void Squeeze() { this->ResizeAndExtend (this->MaxId+1); }
+  // Shared memory is left untouched, as reclaiming it would copy it.
+  void Squeeze()
+    {
+    if (!this->SharedBuffer)
+      {
+      this->ResizeAndExtend(this->MaxId+1);
+      }
+    }
 
   // Description:
   // Return the capacity in typeof T units of the current array.
@@ -196,7 +248,14 @@ public:
   // Set the data at a particular index. Does not do range checking. Make sure
   // you use the method SetNumberOfValues() before inserting data.
   void SetValue(vtkIdType id, T value)
-    { assert(id >= 0 && id < this->Size); this->Array[id] = value;};
+    {
+    assert(id >= 0 && id < this->Size);
+    if (this->SharedBuffer)
+      {
+      this->DetachSharedBuffer();
+      }
+    this->Array[id] = value;
+    }
 
   // Description:
   // Specify the number of values for this object to hold. Does an
@@ -252,13 +311,31 @@ public:
 
   // Description:
   // Get the address of a particular data index. Performs no checks
-  // to verify that the memory has been allocated etc.
+  // to verify that the memory has been allocated etc. If the memory is
+  // shared with other arrays, see ShallowCopy(), or mapped read-only by
+  // MapFile(), this array first gets its own copy, since the values may be
+  // written through the pointer. Use GetReadPointer() to only read them.
   // If the data is simply being iterated over, consider using
   // vtkDataArrayIteratorMacro for safety and efficiency, rather than using this
   // member directly.
-  T* GetPointer(vtkIdType id) { return this->Array + id; }
+  T* GetPointer(vtkIdType id)
+    {
+    if (this->SharedBuffer)
+      {
+      this->DetachSharedBuffer();
+      }
+    return this->Array + id;
+    }
   virtual void* GetVoidPointer(vtkIdType id) { return this->GetPointer(id); }
 
+  // Description:
+  // Get the address of a particular data index for reading only. Memory
+  // shared with other arrays or mapped read-only is not copied, so the
+  // values must not be modified through this pointer.
+  const T* GetReadPointer(vtkIdType id) { return this->Array + id; }
+  virtual const void* GetReadVoidPointer(vtkIdType id)
+    { return this->GetReadPointer(id); }
+
 //BTX
   enum DeleteMethod
   {
@@ -353,15 +430,41 @@ protected:
 
   virtual bool ComputeScalarRange(double* ranges);
   virtual bool ComputeVectorRange(double range[2]);
+
+  // Give this array its own copy of the memory it shares with other
+  // arrays, or of the read-only memory it maps. Several threads may call
+  // it at once for the same array.
+  void DetachSharedBuffer();
+
+  // The allocator set by SetAllocator(), and the one that allocated Array,
+  // if any, with the data type the memory was accounted for.
+  vtkDataArrayAllocator* Allocator;
+  vtkDataArrayAllocator* ArrayAllocator;
+  int ArrayAllocatorDataType;
+
+  // Allocate memory for sz values with the allocator of this array, the
+  // default allocator or malloc(). The allocator used is returned in
+  // allocator. Returns NULL when out of memory.
+  T* AllocateArray(vtkIdType sz, vtkDataArrayAllocator*& allocator);
+
+  // Make this array the owner of memory from the given allocator.
+  void SetArrayAllocator(vtkDataArrayAllocator* allocator);
 private:
   vtkDataArrayTemplate(const vtkDataArrayTemplate&);  // Not implemented.
   void operator=(const vtkDataArrayTemplate&);  // Not implemented.
 
   vtkDataArrayTemplateLookup<T>* Lookup;
   bool RebuildLookup;
+  // Read without lock before each modification, and cleared only once the
+  // array owns its memory, hence atomic.
+  vtkAtomic<vtkDataArrayTemplateSharedBuffer<T>*> SharedBuffer;
   void UpdateLookup();
 
   void DeleteArray();
+
+  // Release the shared memory of this array, freeing it if no other array
+  // uses it. Called with the shared buffers locked.
+  void ReleaseSharedBuffer();
 };
 
 #if !defined(VTK_NO_EXPLICIT_TEMPLATE_INSTANTIATION)
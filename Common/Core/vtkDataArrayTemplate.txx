@@ -19,6 +19,8 @@
 #include "vtkDataArrayPrivate.txx"
 
 #include "vtkArrayIteratorTemplate.h"
+#include "vtkAtomicTypes.h"
+#include "vtkDataArrayAllocator.h"
 #include "vtkDataArrayTemplateHelper.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
@@ -70,6 +72,25 @@ public:
   std::multimap<T, vtkIdType> CachedUpdates;
 };
 
+//----------------------------------------------------------------------------
+// Memory shared by several arrays after ShallowCopy(), or mapped
+// read-only by MapFile(). The last array releasing it frees the memory, as
+// its original owner would have. Read-only memory is always copied before
+// a modification.
+template <class T>
+class vtkDataArrayTemplateSharedBuffer
+{
+public:
+  T* Array;
+  vtkIdType Size;
+  int SaveUserArray;
+  int DeleteMethod;
+  vtkDataArrayAllocator* Allocator;
+  int DataType;
+  int ReadOnly;
+  vtkAtomicInt32 ReferenceCount;
+};
+
 //----------------------------------------------------------------------------
 template <class T>
 vtkDataArrayTemplate<T>::vtkDataArrayTemplate()
@@ -83,6 +104,10 @@ vtkDataArrayTemplate<T>::vtkDataArrayTemplate()
   this->DeleteMethod = VTK_DATA_ARRAY_FREE;
   this->Lookup = 0;
   this->RebuildLookup = true;
+  this->SharedBuffer = 0;
+  this->Allocator = 0;
+  this->ArrayAllocator = 0;
+  this->ArrayAllocatorDataType = VTK_VOID;
 }
 
 //----------------------------------------------------------------------------
@@ -92,6 +117,72 @@ vtkDataArrayTemplate<T>::~vtkDataArrayTemplate()
   this->DeleteArray();
   free(this->Tuple);
   delete this->Lookup;
+  if (this->Allocator)
+    {
+    this->Allocator->UnRegister(this);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::SetAllocator(vtkDataArrayAllocator* allocator)
+{
+  if (allocator == this->Allocator)
+    {
+    return;
+    }
+  if (allocator)
+    {
+    allocator->Register(this);
+    }
+  if (this->Allocator)
+    {
+    this->Allocator->UnRegister(this);
+    }
+  this->Allocator = allocator;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T* vtkDataArrayTemplate<T>::AllocateArray(vtkIdType sz,
+                                          vtkDataArrayAllocator*& allocator)
+{
+  allocator = this->Allocator ?
+    this->Allocator : vtkDataArrayAllocator::GetDefaultAllocator();
+  size_t size = static_cast<size_t>(sz) * sizeof(T);
+  T* array = static_cast<T*>(
+    allocator ? allocator->Allocate(size, this->GetDataType()) : malloc(size));
+  if (!array)
+    {
+    vtkErrorMacro("Unable to allocate " << sz
+                  << " elements of size " << sizeof(T)
+                  << " bytes. ");
+    #if !defined NDEBUG
+    // We're debugging, crash here preserving the stack
+    abort();
+    #elif !defined VTK_DONT_THROW_BAD_ALLOC
+    // We can throw something that has universal meaning
+    throw std::bad_alloc();
+    #else
+    // We indicate that malloc failed by return
+    return 0;
+    #endif
+    }
+  return array;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::SetArrayAllocator(
+  vtkDataArrayAllocator* allocator)
+{
+  if (allocator)
+    {
+    allocator->Register(0);
+    this->ArrayAllocatorDataType = this->GetDataType();
+    }
+  this->ArrayAllocator = allocator;
 }
 
 //----------------------------------------------------------------------------
@@ -124,6 +215,12 @@ void vtkDataArrayTemplate<T>::SetArray(T* array,
 template <class T>
 int vtkDataArrayTemplate<T>::Allocate(vtkIdType sz, vtkIdType)
 {
+  if (this->SharedBuffer && sz <= this->Size)
+    {
+    // The memory is kept, and about to be written to.
+    this->DetachSharedBuffer();
+    }
+
   this->MaxId = -1;
 
   if(sz > this->Size)
@@ -133,24 +230,13 @@ int vtkDataArrayTemplate<T>::Allocate(vtkIdType sz, vtkIdType)
     this->Size = 0;
 
     vtkIdType newSize = (sz > 0 ? sz : 1);
-    this->Array = static_cast<T*>(malloc(static_cast<size_t>(newSize)
-                                         * sizeof(T)));
+    vtkDataArrayAllocator* allocator;
+    this->Array = this->AllocateArray(newSize, allocator);
     if(this->Array==0)
       {
-      vtkErrorMacro("Unable to allocate " << newSize
-                    << " elements of size " << sizeof(T)
-                    << " bytes. ");
-      #if !defined NDEBUG
-      // We're debugging, crash here preserving the stack
-      abort();
-      #elif !defined VTK_DONT_THROW_BAD_ALLOC
-      // We can throw something that has universal meaning
-      throw std::bad_alloc();
-      #else
-      // We indicate that malloc failed by return
       return 0;
-      #endif
       }
+    this->SetArrayAllocator(allocator);
     this->Size = newSize;
     }
   this->DataChanged();
@@ -201,11 +287,253 @@ vtkDataArrayTemplate<T>::FastDownCast(vtkAbstractArray *src)
     }
 }
 
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::ShallowCopy(vtkDataArray* da)
+{
+  if (da == this)
+    {
+    return;
+    }
+  // FastDownCast() does not recognize vtkIdTypeArray, whose data type is
+  // VTK_ID_TYPE: compare the data types of the arrays instead.
+  vtkDataArrayTemplate<T>* other = 0;
+  if (da && da->GetArrayType() == vtkAbstractArray::DataArrayTemplate &&
+      da->GetDataType() == this->GetDataType())
+    {
+    other = static_cast<vtkDataArrayTemplate<T>*>(da);
+    }
+  if (!other || !other->Array)
+    {
+    this->Superclass::ShallowCopy(da);
+    return;
+    }
+
+  this->DeleteArray();
+
+  // The first copy turns the memory of the other array into a shared
+  // buffer.
+  vtkDataArrayTemplateHelper::LockSharedBuffers();
+  if (!other->SharedBuffer)
+    {
+    vtkDataArrayTemplateSharedBuffer<T>* buffer =
+      new vtkDataArrayTemplateSharedBuffer<T>;
+    buffer->Array = other->Array;
+    buffer->Size = other->Size;
+    buffer->SaveUserArray = other->SaveUserArray;
+    buffer->DeleteMethod = other->DeleteMethod;
+    buffer->Allocator = other->ArrayAllocator;
+    buffer->DataType = other->ArrayAllocatorDataType;
+    buffer->ReadOnly = 0;
+    buffer->ReferenceCount = 1;
+    other->SharedBuffer = buffer;
+    other->SaveUserArray = 1;
+    other->ArrayAllocator = 0;
+    }
+  vtkDataArrayTemplateSharedBuffer<T>* shared = other->SharedBuffer;
+  ++shared->ReferenceCount;
+  this->SharedBuffer = shared;
+  vtkDataArrayTemplateHelper::UnlockSharedBuffers();
+
+  this->Array = other->Array;
+  this->SaveUserArray = 1;
+  this->Size = other->Size;
+  this->MaxId = other->MaxId;
+  this->NumberOfComponents = other->NumberOfComponents;
+  this->SetLookupTable(other->GetLookupTable());
+  this->CopyComponentNames(other);
+  this->DataChanged();
+  if (this->HasInformation())
+    {
+    this->GetInformation()->Clear();
+    }
+  this->Modified();
+
+  // Copy the information last, so that the cached ranges remain valid,
+  // unless they were out of date in the other array already.
+  if (other->HasInformation())
+    {
+    vtkInformation* info = this->GetInformation();
+    info->Copy(other->GetInformation(), /*deep=*/1);
+    if (other->GetMTime() > other->GetInformation()->GetMTime())
+      {
+      info->Remove(vtkAbstractArray::PER_COMPONENT());
+      info->Remove(vtkDataArray::L2_NORM_RANGE());
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkDataArrayTemplate<T>::MapFile(const char* fileName,
+                                     vtkTypeInt64 offset,
+                                     vtkIdType numberOfValues,
+                                     int copyOnWrite)
+{
+  if (numberOfValues <= 0)
+    {
+    return 0;
+    }
+
+  // Without allocator, the mapping gets one of its own.
+  vtkDataArrayAllocator* allocator = this->Allocator ?
+    this->Allocator : vtkDataArrayAllocator::GetDefaultAllocator();
+  vtkDataArrayAllocator* ownAllocator = 0;
+  if (!allocator)
+    {
+    allocator = ownAllocator = vtkDataArrayAllocator::New();
+    }
+
+  T* array = static_cast<T*>(allocator->MapFile(
+    fileName, offset, static_cast<size_t>(numberOfValues) * sizeof(T),
+    copyOnWrite, this->GetDataType()));
+  if (!array)
+    {
+    vtkDebugMacro("Cannot map " << numberOfValues << " values from "
+                  << fileName << " at offset " << offset << ".");
+    if (ownAllocator)
+      {
+      ownAllocator->Delete();
+      }
+    return 0;
+    }
+
+  this->DeleteArray();
+  this->Array = array;
+  this->Size = numberOfValues;
+  this->MaxId = numberOfValues - 1;
+  if (copyOnWrite)
+    {
+    this->SetArrayAllocator(allocator);
+    }
+  else
+    {
+    vtkDataArrayTemplateSharedBuffer<T>* buffer =
+      new vtkDataArrayTemplateSharedBuffer<T>;
+    buffer->Array = array;
+    buffer->Size = numberOfValues;
+    buffer->SaveUserArray = 0;
+    buffer->DeleteMethod = VTK_DATA_ARRAY_FREE;
+    buffer->Allocator = allocator;
+    buffer->Allocator->Register(0);
+    buffer->DataType = this->GetDataType();
+    buffer->ReadOnly = 1;
+    buffer->ReferenceCount = 1;
+    this->SharedBuffer = buffer;
+    this->SaveUserArray = 1;
+    }
+  if (ownAllocator)
+    {
+    ownAllocator->Delete();
+    }
+  this->DataChanged();
+  this->Modified();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+bool vtkDataArrayTemplate<T>::HasSharedBuffer()
+{
+  vtkDataArrayTemplateHelper::LockSharedBuffers();
+  vtkDataArrayTemplateSharedBuffer<T>* buffer = this->SharedBuffer;
+  bool shared = buffer && (buffer->ReadOnly || buffer->ReferenceCount > 1);
+  vtkDataArrayTemplateHelper::UnlockSharedBuffers();
+  return shared;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::DetachSharedBuffer()
+{
+  // The memory is copied with the shared buffers locked, so that the
+  // threads getting the pointer of the same array at once copy it only
+  // once, and see the copy. SharedBuffer is cleared last, once Array is
+  // the copy, for the threads that test it without the lock.
+  vtkDataArrayTemplateHelper::LockSharedBuffers();
+  vtkDataArrayTemplateSharedBuffer<T>* buffer = this->SharedBuffer;
+  if (!buffer)
+    {
+    vtkDataArrayTemplateHelper::UnlockSharedBuffers();
+    return;
+    }
+  if (buffer->ReferenceCount == 1 && !buffer->ReadOnly)
+    {
+    // No other array uses the memory anymore, take it back.
+    this->SaveUserArray = buffer->SaveUserArray;
+    this->DeleteMethod = buffer->DeleteMethod;
+    this->ArrayAllocator = buffer->Allocator;
+    this->ArrayAllocatorDataType = buffer->DataType;
+    this->SharedBuffer = 0;
+    vtkDataArrayTemplateHelper::UnlockSharedBuffers();
+    delete buffer;
+    return;
+    }
+
+  vtkDataArrayAllocator* allocator;
+  T* newArray = this->AllocateArray(this->Size, allocator);
+  if (newArray)
+    {
+    memcpy(newArray, this->Array,
+           static_cast<size_t>(this->MaxId + 1) * sizeof(T));
+    this->SaveUserArray = 0;
+    this->DeleteMethod = VTK_DATA_ARRAY_FREE;
+    this->Array = newArray;
+    this->SetArrayAllocator(allocator);
+    this->ReleaseSharedBuffer();
+    }
+  vtkDataArrayTemplateHelper::UnlockSharedBuffers();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::ReleaseSharedBuffer()
+{
+  vtkDataArrayTemplateSharedBuffer<T>* buffer = this->SharedBuffer;
+  this->SharedBuffer = 0;
+  if (--buffer->ReferenceCount == 0)
+    {
+    if (buffer->Allocator)
+      {
+      buffer->Allocator->Free(
+        buffer->Array, static_cast<size_t>(buffer->Size) * sizeof(T),
+        buffer->DataType);
+      buffer->Allocator->UnRegister(0);
+      }
+    else if (!buffer->SaveUserArray)
+      {
+      if (buffer->DeleteMethod == VTK_DATA_ARRAY_FREE)
+        {
+        free(buffer->Array);
+        }
+      else
+        {
+        delete[] buffer->Array;
+        }
+      }
+    delete buffer;
+    }
+}
+
 //----------------------------------------------------------------------------
 template <class T>
 void vtkDataArrayTemplate<T>::DeleteArray()
 {
-  if ((this->Array) && (!this->SaveUserArray))
+  if (this->SharedBuffer)
+    {
+    vtkDataArrayTemplateHelper::LockSharedBuffers();
+    this->ReleaseSharedBuffer();
+    vtkDataArrayTemplateHelper::UnlockSharedBuffers();
+    }
+  else if (this->ArrayAllocator)
+    {
+    this->ArrayAllocator->Free(
+      this->Array, static_cast<size_t>(this->Size) * sizeof(T),
+      this->ArrayAllocatorDataType);
+    this->ArrayAllocator->UnRegister(0);
+    this->ArrayAllocator = 0;
+    }
+  else if ((this->Array) && (!this->SaveUserArray))
     {
     if (this->DeleteMethod == VTK_DATA_ARRAY_FREE)
       {
@@ -263,29 +591,23 @@ T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
   dontUseRealloc=true;
   #endif
 
+  // The memory is reallocated in place only if it comes from the allocator
+  // to use.
+  vtkDataArrayAllocator* allocator = this->Allocator ?
+    this->Allocator : vtkDataArrayAllocator::GetDefaultAllocator();
+
   // Allocate the new array or reallocate the old.
   if (this->Array
       &&
       (this->SaveUserArray
        || this->DeleteMethod==VTK_DATA_ARRAY_DELETE
-       || dontUseRealloc ))
+       || this->ArrayAllocator != allocator
+       || (!allocator && dontUseRealloc)))
     {
-    newArray = static_cast<T*>(malloc(static_cast<size_t>(newSize)*sizeof(T)));
+    newArray = this->AllocateArray(newSize, allocator);
     if(!newArray)
       {
-      vtkErrorMacro("Unable to allocate " << newSize
-                    << " elements of size " << sizeof(T)
-                    << " bytes. ");
-      #if !defined NDEBUG
-      // We're debugging, crash here preserving the stack
-      abort();
-      #elif !defined VTK_DONT_THROW_BAD_ALLOC
-      // We can throw something that has universal meaning
-      throw std::bad_alloc();
-      #else
-      // We indicate that malloc failed by return
       return 0;
-      #endif
       }
     // Copy the data from the old array.
     memcpy(newArray, this->Array,
@@ -294,13 +616,33 @@ T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
 
     // Realease old array if we own
     this->DeleteArray();
+    this->SetArrayAllocator(allocator);
     }
   else
     {
     // Try to reallocate with minimal memory usage and possibly avoid
     // copying.
-    newArray = static_cast<T*>(
-      realloc(this->Array,static_cast<size_t>(newSize)*sizeof(T)));
+    if (!allocator)
+      {
+      newArray = static_cast<T*>(
+        realloc(this->Array,static_cast<size_t>(newSize)*sizeof(T)));
+      }
+    else if (this->Array)
+      {
+      newArray = static_cast<T*>(allocator->Reallocate(
+        this->Array, static_cast<size_t>(this->Size)*sizeof(T),
+        static_cast<size_t>(newSize)*sizeof(T),
+        this->ArrayAllocatorDataType));
+      }
+    else
+      {
+      newArray = static_cast<T*>(allocator->Allocate(
+        static_cast<size_t>(newSize)*sizeof(T), this->GetDataType()));
+      if (newArray)
+        {
+        this->SetArrayAllocator(allocator);
+        }
+      }
     if(!newArray)
       {
       vtkErrorMacro("Unable to allocate " << newSize
@@ -374,10 +716,15 @@ void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, vtkIdType j,
     return;
     }
 
+  if (this->SharedBuffer)
+    {
+    this->DetachSharedBuffer();
+    }
+
   vtkIdType loci = i * this->NumberOfComponents;
   vtkIdType locj = j * source->GetNumberOfComponents();
 
-  T* data = static_cast<T*>(source->GetVoidPointer(0));
+  const T* data = static_cast<const T*>(source->GetReadVoidPointer(0));
 
   for (vtkIdType cur = 0; cur < this->NumberOfComponents; cur++)
     {
@@ -405,6 +752,11 @@ void vtkDataArrayTemplate<T>::InsertTuple(vtkIdType i, vtkIdType j,
     return;
     }
 
+  if (this->SharedBuffer)
+    {
+    this->DetachSharedBuffer();
+    }
+
   vtkIdType locOut = i * inNumComp;
   vtkIdType maxSize = locOut + inNumComp;
   if (maxSize > this->Size)
@@ -465,6 +817,11 @@ void vtkDataArrayTemplate<T>::InsertTuples(vtkIdList *dstIds, vtkIdList *srcIds,
     return;
     }
 
+  if (this->SharedBuffer)
+    {
+    this->DetachSharedBuffer();
+    }
+
   // Find maximum destination id and resize if needed
   vtkIdType maxDstId = 0;
   for (vtkIdType idIndex = 0; idIndex < numIds; ++idIndex)
@@ -540,6 +897,11 @@ void vtkDataArrayTemplate<T>::InsertTuples(vtkIdType dstStart, vtkIdType n,
     return;
     }
 
+  if (this->SharedBuffer)
+    {
+    this->DetachSharedBuffer();
+    }
+
   vtkDataArrayTemplateHelper::InsertTuples(this, dstStart, n, srcStart, source);
 }
 
@@ -701,6 +1063,10 @@ void vtkDataArrayTemplate<T>::GetTupleValue(vtkIdType i, T* tuple)
 template <class T>
 void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, const float* tuple)
 {
+  if (this->SharedBuffer)
+    {
+    this->DetachSharedBuffer();
+    }
   vtkIdType loc = i * this->NumberOfComponents;
   for(int j=0; j < this->NumberOfComponents; ++j)
     {
@@ -712,6 +1078,10 @@ void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, const float* tuple)
 template <class T>
 void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, const double* tuple)
 {
+  if (this->SharedBuffer)
+    {
+    this->DetachSharedBuffer();
+    }
   vtkIdType loc = i * this->NumberOfComponents;
   for(int j=0; j < this->NumberOfComponents; ++j)
     {
@@ -723,6 +1093,10 @@ void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, const double* tuple)
 template <class T>
 void vtkDataArrayTemplate<T>::SetTupleValue(vtkIdType i, const T* tuple)
 {
+  if (this->SharedBuffer)
+    {
+    this->DetachSharedBuffer();
+    }
   vtkIdType loc = i * this->NumberOfComponents;
   for(int j=0; j < this->NumberOfComponents; ++j)
     {
@@ -856,6 +1230,10 @@ void vtkDataArrayTemplate<T>::RemoveTuple(vtkIdType id)
     this->RemoveLastTuple();
     return;
     }
+  if (this->SharedBuffer)
+    {
+    this->DetachSharedBuffer();
+    }
   // Remove the element by moving those after it over by one.  We must
   // use memmove instead of memcpy because the memory areas overlap.
   vtkIdType len = (this->GetNumberOfTuples() - id) - 1;
@@ -936,6 +1314,10 @@ T* vtkDataArrayTemplate<T>::WritePointer(vtkIdType id,
       return 0;
       }
     }
+  else if (this->SharedBuffer)
+    {
+    this->DetachSharedBuffer();
+    }
   if ( (--newSize) > this->MaxId )
     {
     this->MaxId = newSize;
@@ -955,6 +1337,10 @@ void vtkDataArrayTemplate<T>::InsertValue(vtkIdType id, T f)
       return;
       }
     }
+  else if (this->SharedBuffer)
+    {
+    this->DetachSharedBuffer();
+    }
   this->Array[id] = f;
   if ( id > this->MaxId )
     {
@@ -17,6 +17,12 @@
 
 #include "vtkDataArrayIteratorMacro.h"
 #include "vtkDataArrayTemplate.h"
+#include "vtkSimpleCriticalSection.h"
+
+namespace
+{
+vtkSimpleCriticalSection SharedBuffersLock;
+}
 
 //------------------------------------------------------------------------------
 void vtkDataArrayTemplateHelper::InsertTuples(
@@ -57,7 +63,7 @@ void vtkDataArrayTemplateHelper::InsertTuples(
     {
     switch (source->GetDataType())
       {
-      vtkDataArrayIteratorMacro(
+      vtkDataArrayReadIteratorMacro(
             source,
             std::copy(vtkDABegin + srcStart, vtkDABegin + srcEnd,
                       static_cast<vtkDataArrayTemplate<vtkDAValueType>*>(dst)
@@ -88,3 +94,15 @@ void vtkDataArrayTemplateHelper::InsertTuples(
 
   dst->DataChanged();
 }
+
+//------------------------------------------------------------------------------
+void vtkDataArrayTemplateHelper::LockSharedBuffers()
+{
+  SharedBuffersLock.Lock();
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArrayTemplateHelper::UnlockSharedBuffers()
+{
+  SharedBuffersLock.Unlock();
+}
@@ -37,6 +37,12 @@ public:
   static void InsertTuples(vtkDataArray *dst, vtkIdType dstStart, vtkIdType n,
                            vtkIdType srcStart, vtkAbstractArray *source);
 
+  // Description:
+  // Serialize the creation of the buffers shared by
+  // vtkDataArrayTemplate::ShallowCopy.
+  static void LockSharedBuffers();
+  static void UnlockSharedBuffers();
+
 };
 
 #endif // VTKDATAARRAYTEMPLATEHELPER_H
@@ -14,8 +14,11 @@
 =========================================================================*/
 #include "vtkGarbageCollector.h"
 
+#include "vtkConditionVariable.h"
 #include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
 #include "vtkSmartPointerBase.h"
 
 #include <vtksys/ios/sstream>
@@ -134,6 +137,12 @@ public:
     // try to report the call back to the garbage collector.
     obj->RegisterInternal(from, 0);
     }
+  static void UnRegisterChecked(vtkObjectBase* obj)
+    {
+    // Call UnRegisterInternal directly to release a reference held by
+    // the garbage collector as the object's owner would.
+    obj->UnRegisterInternal(0, 1);
+    }
   static void UnRegister(vtkObjectBase* obj, vtkObjectBase* from)
     {
     // Call UnRegisterInternal directly to make sure the object does
@@ -151,6 +160,73 @@ static int vtkGarbageCollectorIsMainThread()
                                    vtkMultiThreader::GetCurrentThreadID());
 }
 
+//----------------------------------------------------------------------------
+// The lock held while walking the reference graph, by the main thread or
+// by another thread checking the references it released.  The thread
+// holding it may lock it again, as a walk may start others when it
+// deletes objects.
+class vtkGarbageCollectorCheckLock
+{
+public:
+  vtkGarbageCollectorCheckLock(): Depth(0) {}
+
+  void Lock()
+    {
+    vtkMultiThreaderIDType self = vtkMultiThreader::GetCurrentThreadID();
+    this->Mutex.Lock();
+    while(this->Depth > 0 && !vtkMultiThreader::ThreadsEqual(this->Owner, self))
+      {
+      this->Released.Wait(this->Mutex);
+      }
+    this->Owner = self;
+    ++this->Depth;
+    this->Mutex.Unlock();
+    }
+
+  // Lock unless another thread holds the lock.
+  bool TryLock()
+    {
+    vtkMultiThreaderIDType self = vtkMultiThreader::GetCurrentThreadID();
+    this->Mutex.Lock();
+    bool locked = this->Depth == 0 ||
+      vtkMultiThreader::ThreadsEqual(this->Owner, self);
+    if(locked)
+      {
+      this->Owner = self;
+      ++this->Depth;
+      }
+    this->Mutex.Unlock();
+    return locked;
+    }
+
+  void Unlock()
+    {
+    this->Mutex.Lock();
+    if(--this->Depth == 0)
+      {
+      this->Released.Broadcast();
+      }
+    this->Mutex.Unlock();
+    }
+
+  // Whether the calling thread holds the lock.
+  bool IsLockedByThisThread()
+    {
+    vtkMultiThreaderIDType self = vtkMultiThreader::GetCurrentThreadID();
+    this->Mutex.Lock();
+    bool owned = this->Depth > 0 &&
+      vtkMultiThreader::ThreadsEqual(this->Owner, self);
+    this->Mutex.Unlock();
+    return owned;
+    }
+
+private:
+  vtkSimpleMutexLock Mutex;
+  vtkSimpleConditionVariable Released;
+  vtkMultiThreaderIDType Owner;
+  int Depth;
+};
+
 //----------------------------------------------------------------------------
 // Singleton to hold discarded references.
 class vtkGarbageCollectorSingleton
@@ -172,6 +248,19 @@ public:
   void DeferredCollectionPush();
   void DeferredCollectionPop();
 
+  // Internal implementation of vtkGarbageCollector::GiveReference in
+  // threads other than the main thread.
+  int GivePendingReference(vtkObjectBase* obj);
+
+  // Release the references given by other threads, checking their
+  // objects as their owners would have in the main thread.
+  void ReleasePendingReferences();
+
+  // Release the references given by other threads in the calling
+  // thread, other than the main thread, unless another thread is
+  // walking the reference graph.
+  void FlushPendingReferences();
+
   // Map from object to number of stored references.
 #if VTK_GARBAGE_COLLECTOR_HASH
   typedef vtksys::hash_map<vtkObjectBase*, int, vtkGarbageCollectorHash>
@@ -187,6 +276,33 @@ public:
   // The number of times DeferredCollectionPush has been called not
   // matched by a DeferredCollectionPop.
   int DeferredCollectionCount;
+
+  // The objects whose references were given by other threads than the
+  // main thread, one reference per object at most, waiting for their
+  // collection check.  The number of references can be read without
+  // the lock.
+#if VTK_GARBAGE_COLLECTOR_HASH
+  typedef vtksys::hash_set<vtkObjectBase*, vtkGarbageCollectorHash>
+    PendingReferencesType;
+#else
+  typedef std::set<vtkObjectBase*> PendingReferencesType;
+#endif
+  PendingReferencesType PendingReferences;
+  vtkAtomicInt32 NumberOfPendingReferences;
+  vtkSimpleCriticalSection PendingReferencesLock;
+
+  // The number of pending references from which the thread giving one
+  // flushes them.
+  static const int MaximumNumberOfPendingReferences = 64;
+
+  // Serializes the reference graph walks of other threads flushing
+  // pending references with the walks of the main thread.  The main
+  // thread takes it only while another thread tries to flush: the
+  // number of such threads, and of walks in progress in the main thread
+  // without the lock, keep them apart otherwise.
+  vtkGarbageCollectorCheckLock CheckLock;
+  vtkAtomicInt32 NumberOfFlushingThreads;
+  vtkAtomicInt32 NumberOfUnlockedWalks;
 };
 
 //----------------------------------------------------------------------------
@@ -857,6 +973,9 @@ void vtkGarbageCollector::ClassInitialize()
 //----------------------------------------------------------------------------
 void vtkGarbageCollector::ClassFinalize()
 {
+  // Check the objects released by other threads first.
+  vtkGarbageCollectorSingletonInstance->ReleasePendingReferences();
+
   // We are done with the singleton.  Delete it and reset the pointer.
   // Other singletons may still cause garbage collection of VTK
   // objects, they just will not have the option of deferred
@@ -879,6 +998,13 @@ void vtkGarbageCollector::Collect()
   // This must be called only from the main thread.
   assert(vtkGarbageCollectorIsMainThread());
 
+  // Check the objects released by other threads.  Their references may
+  // be handed back to the singleton if collection is deferred.
+  if(vtkGarbageCollectorSingletonInstance)
+    {
+    vtkGarbageCollectorSingletonInstance->ReleasePendingReferences();
+    }
+
   // Keep collecting until no deferred checks exist.
   while(vtkGarbageCollectorSingletonInstance &&
         vtkGarbageCollectorSingletonInstance->TotalNumberOfReferences > 0)
@@ -895,6 +1021,31 @@ void vtkGarbageCollector::Collect()
 //----------------------------------------------------------------------------
 void vtkGarbageCollector::Collect(vtkObjectBase* root)
 {
+  // Walk the reference graph in one thread at a time.  The main thread
+  // does not lock unless another thread is flushing pending references:
+  // it announces its walk first, and checks for such a thread after.
+  vtkGarbageCollectorSingleton* singleton =
+    vtkGarbageCollectorSingletonInstance;
+  bool locked = false;
+  if(singleton)
+    {
+    bool isMainThread = vtkGarbageCollectorIsMainThread() != 0;
+    if(isMainThread)
+      {
+      ++singleton->NumberOfUnlockedWalks;
+      }
+    if(!isMainThread || singleton->NumberOfFlushingThreads > 0)
+      {
+      if(isMainThread)
+        {
+        --singleton->NumberOfUnlockedWalks;
+        }
+      singleton->CheckLock.Lock();
+      locked = true;
+      }
+    }
+
+  {
   // Create a collector instance.
   vtkGarbageCollectorImpl collector;
 
@@ -904,6 +1055,16 @@ void vtkGarbageCollector::Collect(vtkObjectBase* root)
   collector.CollectInternal(root);
 
   vtkDebugWithObjectMacro((&collector), "Finished collection check.");
+  }
+
+  if(locked)
+    {
+    singleton->CheckLock.Unlock();
+    }
+  else if(singleton)
+    {
+    --singleton->NumberOfUnlockedWalks;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -938,15 +1099,23 @@ int vtkGarbageCollector::GiveReference(vtkObjectBase* obj)
   // We must have an object.
   assert(obj != 0);
 
-  // See if the singleton will accept a reference.
-  if(vtkGarbageCollectorIsMainThread() &&
-     vtkGarbageCollectorSingletonInstance)
+  // Could not accept the reference.
+  if(!vtkGarbageCollectorSingletonInstance)
     {
-    return vtkGarbageCollectorSingletonInstance->GiveReference(obj);
+    return 0;
     }
 
-  // Could not accept the reference.
-  return 0;
+  // Collection checks walk the reference graph, which must not be
+  // modified meanwhile: other threads leave them to the main thread.
+  if(!vtkGarbageCollectorIsMainThread())
+    {
+    return vtkGarbageCollectorSingletonInstance->GivePendingReference(obj);
+    }
+
+  // See if the singleton will accept a reference, after checking the
+  // objects released by other threads.
+  vtkGarbageCollectorSingletonInstance->ReleasePendingReferences();
+  return vtkGarbageCollectorSingletonInstance->GiveReference(obj);
 }
 
 //----------------------------------------------------------------------------
@@ -971,6 +1140,9 @@ vtkGarbageCollectorSingleton::vtkGarbageCollectorSingleton()
 {
   this->TotalNumberOfReferences = 0;
   this->DeferredCollectionCount = 0;
+  this->NumberOfPendingReferences = 0;
+  this->NumberOfFlushingThreads = 0;
+  this->NumberOfUnlockedWalks = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -1008,6 +1180,12 @@ int vtkGarbageCollectorSingleton::GiveReference(vtkObjectBase* obj)
 //----------------------------------------------------------------------------
 int vtkGarbageCollectorSingleton::TakeReference(vtkObjectBase* obj)
 {
+  // Most of the time there is no reference at all.
+  if(this->TotalNumberOfReferences == 0)
+    {
+    return 0;
+    }
+
   // If we have a reference to the object hand it back to the caller.
   ReferencesType::iterator i = this->References.find(obj);
   if(i != this->References.end())
@@ -1027,6 +1205,79 @@ int vtkGarbageCollectorSingleton::TakeReference(vtkObjectBase* obj)
   return 0;
 }
 
+//----------------------------------------------------------------------------
+int vtkGarbageCollectorSingleton::GivePendingReference(vtkObjectBase* obj)
+{
+  // A thread flushing the pending references checks the references it
+  // releases right away.
+  if(this->NumberOfFlushingThreads > 0 &&
+     this->CheckLock.IsLockedByThisThread())
+    {
+    return 0;
+    }
+
+  // Keep the first reference released, to check the object once.  The
+  // next ones are released as usual, without check, as they all leave
+  // the object referenced by the pending one.
+  this->PendingReferencesLock.Lock();
+  if(!this->PendingReferences.insert(obj).second)
+    {
+    this->PendingReferencesLock.Unlock();
+    return -1;
+    }
+  int numberOfPendingReferences = ++this->NumberOfPendingReferences;
+  this->PendingReferencesLock.Unlock();
+
+  // Do not let the pending references, and the objects they keep alive,
+  // pile up until the main thread checks them.
+  if(numberOfPendingReferences >= MaximumNumberOfPendingReferences)
+    {
+    this->FlushPendingReferences();
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkGarbageCollectorSingleton::FlushPendingReferences()
+{
+  // If the main thread or another thread is walking the reference graph,
+  // leave the references to the next thread giving one, or to the main
+  // thread.  This thread announces itself before checking for walks of
+  // the main thread, which do the opposite, so that they never both go
+  // on without the lock.
+  ++this->NumberOfFlushingThreads;
+  if(this->NumberOfUnlockedWalks == 0 && this->CheckLock.TryLock())
+    {
+    this->ReleasePendingReferences();
+    this->CheckLock.Unlock();
+    }
+  --this->NumberOfFlushingThreads;
+}
+
+//----------------------------------------------------------------------------
+void vtkGarbageCollectorSingleton::ReleasePendingReferences()
+{
+  // This is called for every reference released in the main thread.
+  if(this->NumberOfPendingReferences == 0)
+    {
+    return;
+    }
+
+  PendingReferencesType references;
+  this->PendingReferencesLock.Lock();
+  references.swap(this->PendingReferences);
+  this->NumberOfPendingReferences = 0;
+  this->PendingReferencesLock.Unlock();
+
+  // Releasing the references may release others, given back to this
+  // method or to the singleton.
+  for(PendingReferencesType::iterator i = references.begin(),
+        iend = references.end(); i != iend; ++i)
+    {
+    vtkGarbageCollectorToObjectBaseFriendship::UnRegisterChecked(*i);
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkGarbageCollectorSingleton::CheckAccept()
 {
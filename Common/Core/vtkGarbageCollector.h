@@ -72,6 +72,20 @@
 //
 // If subclassing from a class that already supports garbage
 // collection, one need only provide the ReportReferences method.
+//
+// When a thread other than the main thread releases a reference to an
+// object that participates in garbage collection, the collector takes
+// the reference and checks the object later, so that the threads sharing
+// objects do not walk the reference graph on every release.  Only one
+// check per object waits at a time: the other references released
+// meanwhile just decrement the reference count.  The waiting checks are
+// done the next time the main thread releases such a reference or calls
+// Collect().  Once 64 checks wait, the thread giving the last one does
+// them all itself, unless another thread is walking the reference graph,
+// in which case the next thread giving one tries again.  So at most
+// about 64 objects, and the objects they reference, are kept alive
+// until the main thread runs VTK code again.  The reference graph is
+// walked by one thread at a time.
 
 #ifndef vtkGarbageCollector_h
 #define vtkGarbageCollector_h
@@ -107,7 +121,8 @@ public:
   // are held by objects in the original component.  These removed
   // references are handled as any other and their corresponding
   // checks may be deferred.  This method keeps collecting until no
-  // deferred collection checks remain.
+  // deferred collection checks remain, including the checks left by
+  // other threads.  It must be called from the main thread.
   static void Collect();
 
   // Description:
@@ -150,7 +165,10 @@ private:
   // from the caller by returning 1.  If the reference cannot be
   // accepted then it returns 0.  This may be the case when delayed
   // garbage collection is disabled, or when the collector has decided
-  // it is time to do a check.
+  // it is time to do a check.  Called from another thread than the
+  // main thread, the reference is accepted to check the object later,
+  // unless a check is already pending: then it returns -1, and the
+  // caller need not check the object.
   static int GiveReference(vtkObjectBase* obj);
 
   // Description:
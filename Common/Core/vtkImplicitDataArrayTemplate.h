@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitDataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImplicitDataArrayTemplate - Superclass of read-only arrays whose
+// values are computed on the fly.
+//
+// .SECTION Description
+// vtkImplicitDataArrayTemplate is the superclass of vtkDataArrays that
+// store no values: subclasses compute value idx from a few parameters in
+// GetValue(), so the array takes O(1) memory whatever its number of tuples.
+// SetNumberOfComponents() and SetNumberOfTuples() set the shape of the
+// array and allocate nothing. All methods modifying values print an error.
+//
+// Subclasses implement GetValue() and may reimplement GetTupleValue(),
+// GetTuple() and ComputeScalarRange() when they can do better than one
+// GetValue() call per value.
+//
+// GetValueReference() returns a reference to a temporary owned by the
+// array, valid until the next call. Iterators over an implicit array (see
+// vtkDataArrayIteratorMacro) are therefore read-only and the array may not
+// be read from several threads at once through them.
+//
+// .SECTION See Also
+// vtkConstantDataArrayTemplate vtkRangeDataArrayTemplate
+// vtkAffineCoordinatesDataArrayTemplate
+// vtkRectilinearCoordinatesDataArrayTemplate vtkMappedDataArray
+
+#ifndef vtkImplicitDataArrayTemplate_h
+#define vtkImplicitDataArrayTemplate_h
+
+#include "vtkMappedDataArray.h"
+
+#include "vtkTypeTemplate.h" // For templated vtkObject API
+
+template <class Scalar>
+class vtkImplicitDataArrayTemplate:
+    public vtkTypeTemplate<vtkImplicitDataArrayTemplate<Scalar>,
+                           vtkMappedDataArray<Scalar> >
+{
+public:
+  virtual void PrintSelf(ostream &os, vtkIndent indent);
+
+  // Description:
+  // Set the number of tuples of the array. Nothing is allocated.
+  void SetNumberOfTuples(vtkIdType number);
+  int Resize(vtkIdType numTuples);
+
+  // Description:
+  // Compute value idx. Implemented by subclasses.
+  virtual Scalar GetValue(vtkIdType idx) = 0;
+
+  // Description:
+  // Compute value idx into a temporary owned by the array and return it.
+  Scalar& GetValueReference(vtkIdType idx);
+
+  // Description:
+  // Compute a tuple. The default implementation calls GetValue() once per
+  // component.
+  virtual void GetTupleValue(vtkIdType idx, Scalar *t);
+  virtual void GetTuple(vtkIdType i, double *tuple);
+  double* GetTuple(vtkIdType i);
+
+  // Description:
+  // Return the memory used by the parameters of the array: always 1 kibibyte.
+  unsigned long GetActualMemorySize();
+
+  // Reimplemented virtuals -- see superclasses for descriptions:
+  void Initialize();
+  void GetTuples(vtkIdList *ptIds, vtkAbstractArray *output);
+  void GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *output);
+  void Squeeze();
+  vtkArrayIterator *NewIterator();
+  vtkIdType LookupValue(vtkVariant value);
+  void LookupValue(vtkVariant value, vtkIdList *ids);
+  vtkVariant GetVariantValue(vtkIdType idx);
+  void ClearLookup();
+  vtkIdType LookupTypedValue(Scalar value);
+  void LookupTypedValue(Scalar value, vtkIdList *ids);
+
+  // Description:
+  // Read only container -- these methods do nothing but print an error.
+  int Allocate(vtkIdType sz, vtkIdType ext);
+  void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source);
+  void SetTuple(vtkIdType i, const float *source);
+  void SetTuple(vtkIdType i, const double *source);
+  void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source);
+  void InsertTuple(vtkIdType i, const float *source);
+  void InsertTuple(vtkIdType i, const double *source);
+  void InsertTuples(vtkIdList *dstIds, vtkIdList *srcIds,
+                    vtkAbstractArray *source);
+  void InsertTuples(vtkIdType dstStart, vtkIdType n, vtkIdType srcStart,
+                    vtkAbstractArray* source);
+  vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray *source);
+  vtkIdType InsertNextTuple(const float *source);
+  vtkIdType InsertNextTuple(const double *source);
+  void DeepCopy(vtkAbstractArray *aa);
+  void DeepCopy(vtkDataArray *da);
+  void InterpolateTuple(vtkIdType i, vtkIdList *ptIndices,
+                        vtkAbstractArray* source,  double* weights);
+  void InterpolateTuple(vtkIdType i, vtkIdType id1, vtkAbstractArray *source1,
+                        vtkIdType id2, vtkAbstractArray *source2, double t);
+  void SetVariantValue(vtkIdType idx, vtkVariant value);
+  void RemoveTuple(vtkIdType id);
+  void RemoveFirstTuple();
+  void RemoveLastTuple();
+  void SetTupleValue(vtkIdType i, const Scalar *t);
+  void InsertTupleValue(vtkIdType i, const Scalar *t);
+  vtkIdType InsertNextTupleValue(const Scalar *t);
+  void SetValue(vtkIdType idx, Scalar value);
+  vtkIdType InsertNextValue(Scalar v);
+  void InsertValue(vtkIdType idx, Scalar v);
+
+protected:
+  vtkImplicitDataArrayTemplate();
+  ~vtkImplicitDataArrayTemplate();
+
+private:
+  vtkImplicitDataArrayTemplate(
+    const vtkImplicitDataArrayTemplate &); // Not implemented.
+  void operator=(const vtkImplicitDataArrayTemplate &); // Not implemented.
+
+  vtkIdType Lookup(const Scalar &val, vtkIdType startIndex);
+
+  Scalar TempValue; // returned by GetValueReference()
+  double *TempDoubleArray; // returned by GetTuple()
+  int TempDoubleArraySize;
+};
+
+#include "vtkImplicitDataArrayTemplate.txx"
+
+#endif //vtkImplicitDataArrayTemplate_h
+
+// VTK-HeaderTest-Exclude: vtkImplicitDataArrayTemplate.h
@@ -0,0 +1,421 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitDataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkImplicitDataArrayTemplate_txx
+#define vtkImplicitDataArrayTemplate_txx
+
+#include "vtkImplicitDataArrayTemplate.h"
+
+#include "vtkIdList.h"
+#include "vtkVariant.h"
+#include "vtkVariantCast.h"
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkImplicitDataArrayTemplate<Scalar>
+::vtkImplicitDataArrayTemplate()
+  : TempValue(),
+    TempDoubleArray(NULL),
+    TempDoubleArraySize(0)
+{
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkImplicitDataArrayTemplate<Scalar>
+::~vtkImplicitDataArrayTemplate()
+{
+  delete [] this->TempDoubleArray;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->vtkImplicitDataArrayTemplate<Scalar>::Superclass::PrintSelf(
+        os, indent);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::Initialize()
+{
+  this->MaxId = -1;
+  this->Size = 0;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::SetNumberOfTuples(vtkIdType number)
+{
+  this->Resize(number);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkImplicitDataArrayTemplate<Scalar>
+::Resize(vtkIdType numTuples)
+{
+  if (numTuples < 0)
+    {
+    vtkErrorMacro("Invalid number of tuples " << numTuples);
+    return 0;
+    }
+  this->Size = numTuples * this->NumberOfComponents;
+  this->MaxId = this->Size - 1;
+  this->Modified();
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::GetTuples(vtkIdList *ptIds, vtkAbstractArray *output)
+{
+  this->vtkDataArray::GetTuples(ptIds, output);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *output)
+{
+  this->vtkDataArray::GetTuples(p1, p2, output);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>::Squeeze()
+{
+  // noop
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkArrayIterator*
+vtkImplicitDataArrayTemplate<Scalar>::NewIterator()
+{
+  vtkErrorMacro(<<"Not implemented.");
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkImplicitDataArrayTemplate<Scalar>
+::Lookup(const Scalar &val, vtkIdType index)
+{
+  for (; index <= this->MaxId; ++index)
+    {
+    if (this->GetValue(index) == val)
+      {
+      return index;
+      }
+    }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkImplicitDataArrayTemplate<Scalar>
+::LookupValue(vtkVariant value)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  if (valid)
+    {
+    return this->Lookup(val, 0);
+    }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::LookupValue(vtkVariant value, vtkIdList *ids)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  ids->Reset();
+  if (valid)
+    {
+    this->LookupTypedValue(val, ids);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkImplicitDataArrayTemplate<Scalar>
+::LookupTypedValue(Scalar value)
+{
+  return this->Lookup(value, 0);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::LookupTypedValue(Scalar value, vtkIdList *ids)
+{
+  ids->Reset();
+  vtkIdType index = 0;
+  while ((index = this->Lookup(value, index)) >= 0)
+    {
+    ids->InsertNextId(index++);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::ClearLookup()
+{
+  // no-op, no fast lookup implemented.
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkVariant vtkImplicitDataArrayTemplate<Scalar>
+::GetVariantValue(vtkIdType idx)
+{
+  return vtkVariant(this->GetValue(idx));
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar& vtkImplicitDataArrayTemplate<Scalar>
+::GetValueReference(vtkIdType idx)
+{
+  this->TempValue = this->GetValue(idx);
+  return this->TempValue;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::GetTupleValue(vtkIdType idx, Scalar *t)
+{
+  const int numComps = this->NumberOfComponents;
+  for (int comp = 0; comp < numComps; ++comp)
+    {
+    t[comp] = this->GetValue(idx * numComps + comp);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> double* vtkImplicitDataArrayTemplate<Scalar>
+::GetTuple(vtkIdType i)
+{
+  if (this->TempDoubleArraySize < this->NumberOfComponents)
+    {
+    delete [] this->TempDoubleArray;
+    this->TempDoubleArraySize = this->NumberOfComponents;
+    this->TempDoubleArray = new double[this->TempDoubleArraySize];
+    }
+  this->GetTuple(i, this->TempDoubleArray);
+  return this->TempDoubleArray;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::GetTuple(vtkIdType i, double *tuple)
+{
+  const int numComps = this->NumberOfComponents;
+  for (int comp = 0; comp < numComps; ++comp)
+    {
+    tuple[comp] = static_cast<double>(this->GetValue(i * numComps + comp));
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> unsigned long vtkImplicitDataArrayTemplate<Scalar>
+::GetActualMemorySize()
+{
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkImplicitDataArrayTemplate<Scalar>
+::Allocate(vtkIdType, vtkIdType)
+{
+  vtkErrorMacro("Read only container.");
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::SetTuple(vtkIdType, vtkIdType, vtkAbstractArray*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::SetTuple(vtkIdType, const float*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::SetTuple(vtkIdType, const double*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType, vtkIdType, vtkAbstractArray*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType, const float*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType, const double*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::InsertTuples(vtkIdList*, vtkIdList*, vtkAbstractArray*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::InsertTuples(vtkIdType, vtkIdType, vtkIdType, vtkAbstractArray*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkImplicitDataArrayTemplate<Scalar>
+::InsertNextTuple(vtkIdType, vtkAbstractArray*)
+{
+  vtkErrorMacro("Read only container.");
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkImplicitDataArrayTemplate<Scalar>
+::InsertNextTuple(const float*)
+{
+  vtkErrorMacro("Read only container.");
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkImplicitDataArrayTemplate<Scalar>
+::InsertNextTuple(const double*)
+{
+  vtkErrorMacro("Read only container.");
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::DeepCopy(vtkAbstractArray*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::DeepCopy(vtkDataArray*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::InterpolateTuple(vtkIdType, vtkIdList*, vtkAbstractArray*, double*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::InterpolateTuple(vtkIdType, vtkIdType, vtkAbstractArray*, vtkIdType,
+                   vtkAbstractArray*, double)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::SetVariantValue(vtkIdType, vtkVariant)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::RemoveTuple(vtkIdType)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::RemoveFirstTuple()
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::RemoveLastTuple()
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::SetTupleValue(vtkIdType, const Scalar*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::InsertTupleValue(vtkIdType, const Scalar*)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkImplicitDataArrayTemplate<Scalar>
+::InsertNextTupleValue(const Scalar*)
+{
+  vtkErrorMacro("Read only container.");
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::SetValue(vtkIdType, Scalar)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkImplicitDataArrayTemplate<Scalar>
+::InsertNextValue(Scalar)
+{
+  vtkErrorMacro("Read only container.");
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkImplicitDataArrayTemplate<Scalar>
+::InsertValue(vtkIdType, Scalar)
+{
+  vtkErrorMacro("Read only container.");
+}
+
+#endif //vtkImplicitDataArrayTemplate_txx
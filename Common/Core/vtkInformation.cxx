@@ -25,7 +25,6 @@
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationIntegerPointerKey.h"
 #include "vtkInformationIntegerVectorKey.h"
-#include "vtkInformationIterator.h"
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationRequestKey.h"
@@ -35,7 +34,6 @@
 #include "vtkInformationVariantKey.h"
 #include "vtkInformationVariantVectorKey.h"
 #include "vtkObjectFactory.h"
-#include "vtkSmartPointer.h"
 #include "vtkVariant.h"
 
 #include <algorithm>
@@ -79,12 +77,11 @@ void vtkInformation::PrintSelf(ostream& os, vtkIndent indent)
 //----------------------------------------------------------------------------
 void vtkInformation::PrintKeys(ostream& os, vtkIndent indent)
 {
-  typedef vtkInformationInternals::MapType MapType;
-  for(MapType::const_iterator i = this->Internal->Map.begin();
-      i != this->Internal->Map.end(); ++i)
+  vtkInformationInternals* internal = this->Internal;
+  for(int i = internal->Begin(); i != internal->End(); i = internal->Next(i))
     {
     // Print the key name first.
-    vtkInformationKey* key = i->first;
+    vtkInformationKey* key = internal->Table[i].Key;
     os << indent << key->GetName() << ": ";
 
     // Ask the key to print its value.
@@ -111,20 +108,10 @@ void vtkInformation::Modified(vtkInformationKey* key)
 }
 
 //----------------------------------------------------------------------------
-// Return the number of keys as a result of iteration.
+// Return the number of keys with a value.
 int vtkInformation::GetNumberOfKeys()
 {
-  vtkSmartPointer<vtkInformationIterator> infoIterator =
-    vtkSmartPointer<vtkInformationIterator>::New();
-  infoIterator->SetInformation( this );
-
-  int numberOfKeys = 0;
-  for (infoIterator->InitTraversal(); !infoIterator->IsDoneWithTraversal();
-    infoIterator->GoToNextItem())
-    {
-    numberOfKeys++;
-    }
-  return numberOfKeys;
+  return this->Internal->NumberOfValues;
 }
 
 //----------------------------------------------------------------------------
@@ -135,27 +122,30 @@ void vtkInformation::SetAsObjectBase(vtkInformationKey* key,
     {
     return;
     }
-  typedef vtkInformationInternals::MapType MapType;
-  MapType::iterator i = this->Internal->Map.find(key);
-  if(i != this->Internal->Map.end())
+  vtkInformationInternals::Entry* entry = this->Internal->Find(key);
+  vtkObjectBase* oldvalue = entry ? entry->Value : 0;
+  if(newvalue)
     {
-    vtkObjectBase* oldvalue = i->second;
-    if(newvalue)
+    if(!entry)
       {
-      i->second = newvalue;
-      newvalue->Register(0);
+      entry = this->Internal->Insert(key);
       }
-    else
+    if(!oldvalue)
       {
-      this->Internal->Map.erase(i);
+      ++this->Internal->NumberOfValues;
       }
-    oldvalue->UnRegister(0);
+    entry->Value = newvalue;
+    newvalue->Register(0);
     }
-  else if(newvalue)
+  else if(oldvalue)
     {
-    MapType::value_type entry(key, newvalue);
-    this->Internal->Map.insert(entry);
-    newvalue->Register(0);
+    // Keep the key, to reuse the entry when it is set again.
+    entry->Value = 0;
+    --this->Internal->NumberOfValues;
+    }
+  if(oldvalue)
+    {
+    oldvalue->UnRegister(0);
     }
   this->Modified(key);
 }
@@ -166,11 +156,11 @@ const vtkObjectBase* vtkInformation::GetAsObjectBase(
 {
   if(key)
     {
-    typedef vtkInformationInternals::MapType MapType;
-    MapType::const_iterator i = this->Internal->Map.find(const_cast<vtkInformationKey*>(key));
-    if(i != this->Internal->Map.end())
+    vtkInformationInternals::Entry* entry =
+      this->Internal->Find(const_cast<vtkInformationKey*>(key));
+    if(entry)
       {
-      return i->second;
+      return entry->Value;
       }
     }
   return 0;
@@ -181,11 +171,10 @@ vtkObjectBase* vtkInformation::GetAsObjectBase(vtkInformationKey* key)
 {
   if(key)
     {
-    typedef vtkInformationInternals::MapType MapType;
-    MapType::const_iterator i = this->Internal->Map.find(key);
-    if(i != this->Internal->Map.end())
+    vtkInformationInternals::Entry* entry = this->Internal->Find(key);
+    if(entry)
       {
-      return i->second;
+      return entry->Value;
       }
     }
   return 0;
@@ -204,11 +193,16 @@ void vtkInformation::Copy(vtkInformation* from, int deep)
   this->Internal = new vtkInformationInternals;
   if(from)
     {
-    typedef vtkInformationInternals::MapType MapType;
-    for(MapType::const_iterator i = from->Internal->Map.begin();
-        i != from->Internal->Map.end(); ++i)
+    // Allocate the table once for all the entries.
+    vtkInformationInternals* internal = from->Internal;
+    if(internal->NumberOfValues)
+      {
+      this->Internal->Rehash(internal->NumberOfValues);
+      }
+    for(int i = internal->Begin(); i != internal->End();
+        i = internal->Next(i))
       {
-      this->CopyEntry(from, i->first, deep);
+      this->CopyEntry(from, internal->Table[i].Key, deep);
       }
     }
   delete oldInternal;
@@ -906,11 +900,10 @@ void vtkInformation::ReportReferences(vtkGarbageCollector* collector)
 {
   this->Superclass::ReportReferences(collector);
   // Ask each key/value pair to report any references it holds.
-  typedef vtkInformationInternals::MapType MapType;
-  for(MapType::const_iterator i = this->Internal->Map.begin();
-      i != this->Internal->Map.end(); ++i)
+  vtkInformationInternals* internal = this->Internal;
+  for(int i = internal->Begin(); i != internal->End(); i = internal->Next(i))
     {
-    i->first->Report(this, collector);
+    internal->Table[i].Key->Report(this, collector);
     }
 }
 
@@ -920,11 +913,10 @@ void vtkInformation::ReportAsObjectBase(vtkInformationKey* key,
 {
   if(key)
     {
-    typedef vtkInformationInternals::MapType MapType;
-    MapType::iterator i = this->Internal->Map.find(key);
-    if(i != this->Internal->Map.end())
+    vtkInformationInternals::Entry* entry = this->Internal->Find(key);
+    if(entry && entry->Value)
       {
-      vtkGarbageCollectorReport(collector, i->second, key->GetName());
+      vtkGarbageCollectorReport(collector, entry->Value, key->GetName());
       }
     }
 }
@@ -24,50 +24,133 @@
 #include "vtkInformationKey.h"
 #include "vtkObjectBase.h"
 
-#define VTK_INFORMATION_USE_HASH_MAP
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-# include <vtksys/hash_map.hxx>
-#else
-# include <vtksys/stl/map>
-#endif
-
 //----------------------------------------------------------------------------
+// The entries are stored in an open-addressed table with linear probing,
+// hashed by the identifier of their key.  A removed entry keeps its key
+// with a null value: setting the key again reuses the entry, and
+// removing keys does not move the other entries while iterating.  The
+// removed entries are dropped when the table is rehashed.
 class vtkInformationInternals
 {
 public:
   typedef vtkInformationKey* KeyType;
   typedef vtkObjectBase* DataType;
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  struct HashFun
+  struct Entry
   {
-    size_t operator()(KeyType key) const
-      {
-      return static_cast<size_t>(key - KeyType(0));
-      }
+    KeyType Key;
+    DataType Value;
   };
-  typedef vtksys::hash_map<KeyType, DataType, HashFun> MapType;
-#else
-  typedef vtksys_stl::map<KeyType, DataType> MapType;
-#endif
-  MapType Map;
 
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  vtkInformationInternals(): Map(33) {}
-#endif
+  // The table, allocated with the first key, its capacity minus one, a
+  // power of two minus one, the number of entries with a key and the
+  // number of entries with a value.
+  Entry* Table;
+  int Mask;
+  int NumberOfKeys;
+  int NumberOfValues;
+
+  vtkInformationInternals():
+    Table(0), Mask(0), NumberOfKeys(0), NumberOfValues(0) {}
 
   ~vtkInformationInternals()
     {
-    for(MapType::iterator i = this->Map.begin(); i != this->Map.end(); ++i)
+    for(int i = this->Begin(); i != this->End(); i = this->Next(i))
       {
-      if(vtkObjectBase* value = i->second)
+      this->Table[i].Value->UnRegister(0);
+      }
+    delete [] this->Table;
+    }
+
+  // Find the entry of a key, possibly removed, or return NULL.
+  Entry* Find(KeyType key) const
+    {
+    if(this->Table)
+      {
+      for(int i = key->GetId() & this->Mask;; i = (i + 1) & this->Mask)
         {
-        value->UnRegister(0);
+        Entry* entry = this->Table + i;
+        if(entry->Key == key)
+          {
+          return entry;
+          }
+        else if(!entry->Key)
+          {
+          return 0;
+          }
         }
       }
+    return 0;
+    }
+
+  // Add an entry without value for a key that has none.
+  Entry* Insert(KeyType key)
+    {
+    // Keep at least half of the table empty.
+    if(2 * (this->NumberOfKeys + 1) > this->End())
+      {
+      this->Rehash(this->NumberOfValues + 1);
+      }
+    int i = key->GetId() & this->Mask;
+    while(this->Table[i].Key)
+      {
+      i = (i + 1) & this->Mask;
+      }
+    this->Table[i].Key = key;
+    ++this->NumberOfKeys;
+    return this->Table + i;
     }
-};
 
-#undef VTK_INFORMATION_USE_HASH_MAP
+  // Reallocate the table for the given number of keys, keeping the
+  // entries with a value only.
+  void Rehash(int numberOfKeys)
+    {
+    int capacity = 16;
+    while(capacity < 4 * numberOfKeys)
+      {
+      capacity *= 2;
+      }
+    Entry* table = this->Table;
+    int end = this->End();
+    this->Table = new Entry[capacity];
+    this->Mask = capacity - 1;
+    this->NumberOfKeys = 0;
+    for(int i = 0; i < capacity; ++i)
+      {
+      this->Table[i].Key = 0;
+      this->Table[i].Value = 0;
+      }
+    for(int i = 0; i < end; ++i)
+      {
+      if(table[i].Value)
+        {
+        this->Insert(table[i].Key)->Value = table[i].Value;
+        }
+      }
+    delete [] table;
+    }
+
+  // Iterate over the indices of the entries with a value.
+  int Begin() const
+    {
+    return this->Next(-1);
+    }
+  int End() const
+    {
+    return this->Table ? this->Mask + 1 : 0;
+    }
+  int Next(int i) const
+    {
+    int end = this->End();
+    for(++i; i < end && !this->Table[i].Value; ++i)
+      {
+      }
+    return i;
+    }
+
+private:
+  vtkInformationInternals(const vtkInformationInternals&);  // Not implemented.
+  void operator=(const vtkInformationInternals&);  // Not implemented.
+};
 
 #endif
 // VTK-HeaderTest-Exclude: vtkInformationInternals.h
@@ -24,13 +24,15 @@ vtkStandardNewMacro(vtkInformationIterator);
 class vtkInformationIteratorInternals
 {
 public:
-  vtkInformationInternals::MapType::iterator Iterator;
+  // The index of the current entry in the table of the information.
+  int Index;
 };
 
 //----------------------------------------------------------------------------
 vtkInformationIterator::vtkInformationIterator()
 {
   this->Internal = new vtkInformationIteratorInternals;
+  this->Internal->Index = 0;
   this->Information = 0;
   this->ReferenceIsWeak = false;
 }
@@ -86,7 +88,7 @@ void vtkInformationIterator::GoToFirstItem()
     vtkErrorMacro("No information has been set.");
     return;
     }
-  this->Internal->Iterator = this->Information->Internal->Map.begin();
+  this->Internal->Index = this->Information->Internal->Begin();
 }
 
 //----------------------------------------------------------------------------
@@ -98,7 +100,8 @@ void vtkInformationIterator::GoToNextItem()
     return;
     }
 
-  ++this->Internal->Iterator;
+  this->Internal->Index =
+    this->Information->Internal->Next(this->Internal->Index);
 }
 
 //----------------------------------------------------------------------------
@@ -110,7 +113,7 @@ int vtkInformationIterator::IsDoneWithTraversal()
     return 1;
     }
 
-  if(this->Internal->Iterator == this->Information->Internal->Map.end())
+  if(this->Internal->Index >= this->Information->Internal->End())
     {
     return 1;
     }
@@ -125,7 +128,7 @@ vtkInformationKey* vtkInformationIterator::GetCurrentKey()
     return 0;
     }
 
-  return this->Internal->Iterator->first;
+  return this->Information->Internal->Table[this->Internal->Index].Key;
 }
 
 //----------------------------------------------------------------------------
@@ -43,6 +43,16 @@ public:
     }
 };
 
+//----------------------------------------------------------------------------
+// The identifier of the last key created.  Keys are created during the
+// static initialization of every library, before a file scope counter
+// could be.
+static vtkAtomicInt32& vtkInformationKeyLastId()
+{
+  static vtkAtomicInt32 lastId(0);
+  return lastId;
+}
+
 //----------------------------------------------------------------------------
 vtkInformationKey::vtkInformationKey(const char* name, const char* location)
 {
@@ -52,6 +62,8 @@ vtkInformationKey::vtkInformationKey(const char* name, const char* location)
 
   this->Location = 0;
   this->SetLocation(location);
+
+  this->Id = ++vtkInformationKeyLastId();
 }
 
 //----------------------------------------------------------------------------
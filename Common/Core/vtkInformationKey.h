@@ -56,6 +56,12 @@ public:
   // which the key is defined.
   const char* GetLocation();
 
+  // Description:
+  // Get the identifier of the key, unique among the keys created.
+  // Keys are numbered as they are created, and vtkInformation hashes
+  // them by their identifier.
+  int GetId() { return this->Id; }
+
   // Description:
   // Key instances are static data that need to be created and
   // destroyed.  The constructor and destructor must be public.  The
@@ -138,6 +144,7 @@ public:
 protected:
   char* Name;
   char* Location;
+  int Id;
 
 #define vtkInformationKeySetStringMacro(name) \
 virtual void Set##name (const char* _arg) \
@@ -126,6 +126,8 @@ vtkMappedDataArray<Scalar>::FastDownCast(vtkAbstractArray *source)
   switch (source->GetArrayType())
     {
     case vtkAbstractArray::MappedDataArray:
+    case vtkAbstractArray::SOADataArrayTemplate:
+    case vtkAbstractArray::StridedDataArrayTemplate:
       if (source->GetDataType() == vtkTypeTraits<Scalar>::VTK_TYPE_ID)
         {
         return static_cast<vtkMappedDataArray<Scalar>*>(source);
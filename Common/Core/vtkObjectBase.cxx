@@ -206,11 +206,19 @@ void vtkObjectBase::RegisterInternal(vtkObjectBase*, int check)
 void vtkObjectBase::UnRegisterInternal(vtkObjectBase*, int check)
 {
   // If the garbage collector accepts a reference, do not decrement
-  // the count.
-  if(check && this->ReferenceCount > 1 &&
-     vtkObjectBaseToGarbageCollectorFriendship::GiveReference(this))
+  // the count.  If a check of this object is already pending, another
+  // one is not needed.
+  if(check && this->ReferenceCount > 1)
     {
-    return;
+    int given = vtkObjectBaseToGarbageCollectorFriendship::GiveReference(this);
+    if(given > 0)
+      {
+      return;
+      }
+    else if(given < 0)
+      {
+      check = 0;
+      }
     }
 
   // Decrement the reference count, delete object if count goes to zero.
@@ -0,0 +1,78 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkRangeDataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkRangeDataArrayTemplate - Implicit array holding an arithmetic
+// progression.
+//
+// .SECTION Description
+// Value idx of a vtkRangeDataArrayTemplate is Start + idx * Step, idx being
+// the flat value index (tuple * NumberOfComponents + component). With the
+// default Start 0 and Step 1 and one component, the array holds the tuple
+// ids 0, 1, 2, ..., which is what vtkIdFilter generates.
+//
+// .SECTION See Also
+// vtkImplicitDataArrayTemplate vtkConstantDataArrayTemplate
+
+#ifndef vtkRangeDataArrayTemplate_h
+#define vtkRangeDataArrayTemplate_h
+
+#include "vtkImplicitDataArrayTemplate.h"
+
+#include "vtkObjectFactory.h" // For VTK_STANDARD_NEW_BODY
+#include "vtkTypeTemplate.h" // For templated vtkObject API
+
+template <class Scalar>
+class vtkRangeDataArrayTemplate:
+    public vtkTypeTemplate<vtkRangeDataArrayTemplate<Scalar>,
+                           vtkImplicitDataArrayTemplate<Scalar> >
+{
+public:
+  vtkMappedDataArrayNewInstanceMacro(vtkRangeDataArrayTemplate<Scalar>)
+  static vtkRangeDataArrayTemplate *New();
+  virtual void PrintSelf(ostream &os, vtkIndent indent);
+
+  // Description:
+  // Set/Get the first value of the progression. Default is 0.
+  void SetStart(Scalar start);
+  Scalar GetStart() { return this->Start; }
+
+  // Description:
+  // Set/Get the difference between two consecutive values. Default is 1.
+  void SetStep(Scalar step);
+  Scalar GetStep() { return this->Step; }
+
+  // Reimplemented virtuals -- see superclasses for descriptions:
+  Scalar GetValue(vtkIdType idx)
+    { return static_cast<Scalar>(this->Start + idx * this->Step); }
+
+protected:
+  vtkRangeDataArrayTemplate();
+  ~vtkRangeDataArrayTemplate();
+
+  virtual bool ComputeScalarRange(double *ranges);
+
+  Scalar Start;
+  Scalar Step;
+
+private:
+  vtkRangeDataArrayTemplate(
+    const vtkRangeDataArrayTemplate &); // Not implemented.
+  void operator=(const vtkRangeDataArrayTemplate &); // Not implemented.
+};
+
+#include "vtkRangeDataArrayTemplate.txx"
+
+#endif //vtkRangeDataArrayTemplate_h
+
+// VTK-HeaderTest-Exclude: vtkRangeDataArrayTemplate.h
@@ -0,0 +1,99 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkRangeDataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkRangeDataArrayTemplate_txx
+#define vtkRangeDataArrayTemplate_txx
+
+#include "vtkRangeDataArrayTemplate.h"
+
+#include <algorithm> // For std::min and std::max
+
+//------------------------------------------------------------------------------
+// Can't use vtkStandardNewMacro with a template.
+template <class Scalar> vtkRangeDataArrayTemplate<Scalar> *
+vtkRangeDataArrayTemplate<Scalar>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkRangeDataArrayTemplate<Scalar>)
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkRangeDataArrayTemplate<Scalar>
+::vtkRangeDataArrayTemplate()
+  : Start(0),
+    Step(1)
+{
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkRangeDataArrayTemplate<Scalar>
+::~vtkRangeDataArrayTemplate()
+{
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkRangeDataArrayTemplate<Scalar>
+::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->vtkRangeDataArrayTemplate<Scalar>::Superclass::PrintSelf(os, indent);
+  os << indent << "Start: " << this->Start << "\n";
+  os << indent << "Step: " << this->Step << "\n";
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkRangeDataArrayTemplate<Scalar>
+::SetStart(Scalar start)
+{
+  if (this->Start != start)
+    {
+    this->Start = start;
+    this->Modified();
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkRangeDataArrayTemplate<Scalar>
+::SetStep(Scalar step)
+{
+  if (this->Step != step)
+    {
+    this->Step = step;
+    this->Modified();
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> bool vtkRangeDataArrayTemplate<Scalar>
+::ComputeScalarRange(double *ranges)
+{
+  if (this->MaxId < 0)
+    {
+    return false;
+    }
+  // The values of a component are monotonic: its extremes are in the first
+  // and the last tuples.
+  const int numComps = this->NumberOfComponents;
+  const vtkIdType lastTuple = this->MaxId / numComps;
+  for (int comp = 0; comp < numComps; ++comp)
+    {
+    double first = static_cast<double>(this->GetValue(comp));
+    double last = static_cast<double>(
+      this->GetValue(lastTuple * numComps + comp));
+    ranges[2 * comp] = std::min(first, last);
+    ranges[2 * comp + 1] = std::max(first, last);
+    }
+  return true;
+}
+
+#endif //vtkRangeDataArrayTemplate_txx
@@ -0,0 +1,95 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkRectilinearCoordinatesDataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkRectilinearCoordinatesDataArrayTemplate - Implicit array holding
+// the point coordinates of a rectilinear grid.
+//
+// .SECTION Description
+// vtkRectilinearCoordinatesDataArrayTemplate is a 3 component implicit
+// array built on the X, Y and Z coordinate arrays of a rectilinear grid.
+// Tuple id is the point id, i varying fastest as in vtkRectilinearGrid, and
+// holds (x[i], y[j], z[k]). Only the three coordinate arrays are kept (by
+// reference), so the memory used grows with nx + ny + nz instead of
+// nx * ny * nz.
+//
+// SetCoordinates() sets the number of tuples.
+//
+// .SECTION See Also
+// vtkImplicitDataArrayTemplate vtkAffineCoordinatesDataArrayTemplate
+// vtkRectilinearGridToPointSet
+
+#ifndef vtkRectilinearCoordinatesDataArrayTemplate_h
+#define vtkRectilinearCoordinatesDataArrayTemplate_h
+
+#include "vtkImplicitDataArrayTemplate.h"
+
+#include "vtkObjectFactory.h" // For VTK_STANDARD_NEW_BODY
+#include "vtkTypeTemplate.h" // For templated vtkObject API
+
+template <class Scalar>
+class vtkRectilinearCoordinatesDataArrayTemplate:
+    public vtkTypeTemplate<vtkRectilinearCoordinatesDataArrayTemplate<Scalar>,
+                           vtkImplicitDataArrayTemplate<Scalar> >
+{
+public:
+  vtkMappedDataArrayNewInstanceMacro(
+    vtkRectilinearCoordinatesDataArrayTemplate<Scalar>)
+  static vtkRectilinearCoordinatesDataArrayTemplate *New();
+  virtual void PrintSelf(ostream &os, vtkIndent indent);
+
+  // Description:
+  // Set the coordinate arrays along each axis. The first component of each
+  // array is used. The array gets 3 components and nx * ny * nz tuples.
+  void SetCoordinates(vtkDataArray *x, vtkDataArray *y, vtkDataArray *z);
+
+  // Description:
+  // Get the coordinate array along axis.
+  vtkDataArray* GetCoordinates(int axis) { return this->Coordinates[axis]; }
+
+  // Description:
+  // Return the memory used by the coordinate arrays.
+  unsigned long GetActualMemorySize();
+
+  // Description:
+  // Take into account the modification times of the coordinate arrays.
+  unsigned long GetMTime();
+
+  // Reimplemented virtuals -- see superclasses for descriptions:
+  Scalar GetValue(vtkIdType idx);
+  void GetTupleValue(vtkIdType idx, Scalar *t);
+  void GetTuple(vtkIdType i, double *tuple);
+  double* GetTuple(vtkIdType i)
+    { return this->vtkImplicitDataArrayTemplate<Scalar>::GetTuple(i); }
+
+protected:
+  vtkRectilinearCoordinatesDataArrayTemplate();
+  ~vtkRectilinearCoordinatesDataArrayTemplate();
+
+  virtual bool ComputeScalarRange(double *ranges);
+
+  vtkDataArray *Coordinates[3];
+  vtkIdType Dimensions[3];
+
+private:
+  vtkRectilinearCoordinatesDataArrayTemplate(
+    const vtkRectilinearCoordinatesDataArrayTemplate &); // Not implemented.
+  void operator=(
+    const vtkRectilinearCoordinatesDataArrayTemplate &); // Not implemented.
+};
+
+#include "vtkRectilinearCoordinatesDataArrayTemplate.txx"
+
+#endif //vtkRectilinearCoordinatesDataArrayTemplate_h
+
+// VTK-HeaderTest-Exclude: vtkRectilinearCoordinatesDataArrayTemplate.h
@@ -0,0 +1,186 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkRectilinearCoordinatesDataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkRectilinearCoordinatesDataArrayTemplate_txx
+#define vtkRectilinearCoordinatesDataArrayTemplate_txx
+
+#include "vtkRectilinearCoordinatesDataArrayTemplate.h"
+
+//------------------------------------------------------------------------------
+// Can't use vtkStandardNewMacro with a template.
+template <class Scalar> vtkRectilinearCoordinatesDataArrayTemplate<Scalar> *
+vtkRectilinearCoordinatesDataArrayTemplate<Scalar>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkRectilinearCoordinatesDataArrayTemplate<Scalar>)
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkRectilinearCoordinatesDataArrayTemplate<Scalar>
+::vtkRectilinearCoordinatesDataArrayTemplate()
+{
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    this->Coordinates[axis] = NULL;
+    this->Dimensions[axis] = 0;
+    }
+  this->NumberOfComponents = 3;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkRectilinearCoordinatesDataArrayTemplate<Scalar>
+::~vtkRectilinearCoordinatesDataArrayTemplate()
+{
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    if (this->Coordinates[axis])
+      {
+      this->Coordinates[axis]->UnRegister(this);
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkRectilinearCoordinatesDataArrayTemplate<Scalar>
+::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->vtkRectilinearCoordinatesDataArrayTemplate<Scalar>::Superclass
+    ::PrintSelf(os, indent);
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    os << indent << "Coordinates " << axis << ": "
+       << this->Coordinates[axis] << "\n";
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkRectilinearCoordinatesDataArrayTemplate<Scalar>
+::SetCoordinates(vtkDataArray *x, vtkDataArray *y, vtkDataArray *z)
+{
+  vtkDataArray *coords[3] = {x, y, z};
+  vtkIdType numTuples = 1;
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    if (coords[axis])
+      {
+      coords[axis]->Register(this);
+      }
+    if (this->Coordinates[axis])
+      {
+      this->Coordinates[axis]->UnRegister(this);
+      }
+    this->Coordinates[axis] = coords[axis];
+    this->Dimensions[axis] =
+      coords[axis] ? coords[axis]->GetNumberOfTuples() : 0;
+    numTuples *= this->Dimensions[axis];
+    }
+  this->NumberOfComponents = 3;
+  this->SetNumberOfTuples(numTuples);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> unsigned long
+vtkRectilinearCoordinatesDataArrayTemplate<Scalar>::GetActualMemorySize()
+{
+  unsigned long size = 1;
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    if (this->Coordinates[axis])
+      {
+      size += this->Coordinates[axis]->GetActualMemorySize();
+      }
+    }
+  return size;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> unsigned long
+vtkRectilinearCoordinatesDataArrayTemplate<Scalar>::GetMTime()
+{
+  unsigned long mTime = this->vtkImplicitDataArrayTemplate<Scalar>::GetMTime();
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    if (this->Coordinates[axis] &&
+        this->Coordinates[axis]->GetMTime() > mTime)
+      {
+      mTime = this->Coordinates[axis]->GetMTime();
+      }
+    }
+  return mTime;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar
+vtkRectilinearCoordinatesDataArrayTemplate<Scalar>::GetValue(vtkIdType idx)
+{
+  const vtkIdType tupleIdx = idx / 3;
+  const int axis = static_cast<int>(idx % 3);
+  vtkIdType axisIdx;
+  switch (axis)
+    {
+    case 0:
+      axisIdx = tupleIdx % this->Dimensions[0];
+      break;
+    case 1:
+      axisIdx = (tupleIdx / this->Dimensions[0]) % this->Dimensions[1];
+      break;
+    default:
+      axisIdx = tupleIdx / (this->Dimensions[0] * this->Dimensions[1]);
+      break;
+    }
+  return static_cast<Scalar>(
+    this->Coordinates[axis]->GetComponent(axisIdx, 0));
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkRectilinearCoordinatesDataArrayTemplate<Scalar>
+::GetTupleValue(vtkIdType idx, Scalar *t)
+{
+  const vtkIdType ij = idx / this->Dimensions[0];
+  t[0] = static_cast<Scalar>(
+    this->Coordinates[0]->GetComponent(idx % this->Dimensions[0], 0));
+  t[1] = static_cast<Scalar>(
+    this->Coordinates[1]->GetComponent(ij % this->Dimensions[1], 0));
+  t[2] = static_cast<Scalar>(
+    this->Coordinates[2]->GetComponent(ij / this->Dimensions[1], 0));
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkRectilinearCoordinatesDataArrayTemplate<Scalar>
+::GetTuple(vtkIdType i, double *tuple)
+{
+  Scalar t[3];
+  this->GetTupleValue(i, t);
+  tuple[0] = static_cast<double>(t[0]);
+  tuple[1] = static_cast<double>(t[1]);
+  tuple[2] = static_cast<double>(t[2]);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> bool vtkRectilinearCoordinatesDataArrayTemplate<Scalar>
+::ComputeScalarRange(double *ranges)
+{
+  if (this->MaxId < 0)
+    {
+    return false;
+    }
+  // The range along each axis is the range of its coordinate array.
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    this->Coordinates[axis]->GetRange(ranges + 2 * axis, 0);
+    }
+  return true;
+}
+
+#endif //vtkRectilinearCoordinatesDataArrayTemplate_txx
@@ -17,8 +17,15 @@
 // vtkSMPTools provides a set of utility functions that can
 // be used to parallelize parts of VTK code using multiple threads.
 // There are several back-end implementations of parallel functionality
-// (currently Sequential, TBB and X-Kaapi) that actual execution is
-// delegated to.
+// (currently Sequential, Simple, ThreadPool, OpenMP, TBB and X-Kaapi) that
+// actual execution is delegated to. Calling For() from within a functor
+// executed by For() is supported; the ThreadPool, TBB and OpenMP back-ends
+// execute such nested loops on the threads they already own.
+// Built on For(), Transform(), Fill(), Sort(), Reduce(), InclusiveScan()
+// and ExclusiveScan() are parallel versions of the STL algorithms of the
+// same name that work with every back-end. ExclusiveScan() in particular
+// turns per-item counts into output offsets, which lets a filter count in
+// a first parallel pass and write its output in place in a second one.
 
 #ifndef vtkSMPTools_h__
 #define vtkSMPTools_h__
@@ -29,6 +36,13 @@
 #include "vtkSMPThreadLocal.h" // For Initialized
 #include "vtkSMPToolsInternal.h"
 
+#ifndef __WRAP__
+#include <algorithm> // For std::sort
+#include <functional> // For std::plus
+#include <iterator> // For std::iterator_traits
+#include <vector> // For std::vector
+#endif
+
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 #ifndef __WRAP__
@@ -126,6 +140,292 @@ class vtkSMPTools_Lookup_For<Functor const>
 public:
   typedef vtkSMPTools_FunctorInternal<Functor const, init> type;
 };
+
+// Elements below this count per block are not worth a parallel pass in the
+// Sort, Scan and Reduce algorithms.
+static const vtkIdType vtkSMPTools_MinimumBlockSize = 1024;
+
+// Split size elements into numBlocks contiguous blocks of blockSize elements
+// (the last one may be shorter), a few blocks per thread so that the
+// back-ends can balance the load.
+inline void vtkSMPTools_ComputeBlocks(vtkIdType size, int numThreads,
+                                      vtkIdType& numBlocks,
+                                      vtkIdType& blockSize)
+{
+  numBlocks = 1;
+  if (numThreads > 1)
+    {
+    numBlocks = static_cast<vtkIdType>(numThreads) * 4;
+    if (numBlocks > size / vtkSMPTools_MinimumBlockSize)
+      {
+      numBlocks = size / vtkSMPTools_MinimumBlockSize;
+      }
+    if (numBlocks < 1)
+      {
+      numBlocks = 1;
+      }
+    }
+  blockSize = (size + numBlocks - 1) / numBlocks;
+  numBlocks = blockSize > 0 ? (size + blockSize - 1) / blockSize : 0;
+}
+
+template <typename InputIt, typename OutputIt, typename UnaryOp>
+class vtkSMPTools_UnaryTransformCall
+{
+  InputIt In;
+  OutputIt Out;
+  UnaryOp Op;
+public:
+  vtkSMPTools_UnaryTransformCall(InputIt in, OutputIt out, UnaryOp op)
+    : In(in), Out(out), Op(op) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    InputIt in = this->In + begin;
+    OutputIt out = this->Out + begin;
+    for (vtkIdType i = begin; i < end; ++i, ++in, ++out)
+      {
+      *out = this->Op(*in);
+      }
+  }
+};
+
+template <typename InputIt1, typename InputIt2, typename OutputIt,
+          typename BinaryOp>
+class vtkSMPTools_BinaryTransformCall
+{
+  InputIt1 In1;
+  InputIt2 In2;
+  OutputIt Out;
+  BinaryOp Op;
+public:
+  vtkSMPTools_BinaryTransformCall(InputIt1 in1, InputIt2 in2, OutputIt out,
+                                  BinaryOp op)
+    : In1(in1), In2(in2), Out(out), Op(op) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    InputIt1 in1 = this->In1 + begin;
+    InputIt2 in2 = this->In2 + begin;
+    OutputIt out = this->Out + begin;
+    for (vtkIdType i = begin; i < end; ++i, ++in1, ++in2, ++out)
+      {
+      *out = this->Op(*in1, *in2);
+      }
+  }
+};
+
+template <typename Iterator, typename T>
+class vtkSMPTools_FillCall
+{
+  Iterator Begin;
+  const T& Value;
+public:
+  vtkSMPTools_FillCall(Iterator begin, const T& value)
+    : Begin(begin), Value(value) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::fill(this->Begin + begin, this->Begin + end, this->Value);
+  }
+private:
+  vtkSMPTools_FillCall& operator=(const vtkSMPTools_FillCall&);
+};
+
+// Combine the elements of each block into Partials[block].
+template <typename Iterator, typename T, typename BinaryOp>
+class vtkSMPTools_BlockReduceCall
+{
+  Iterator Begin;
+  vtkIdType Size;
+  vtkIdType BlockSize;
+  T* Partials;
+  BinaryOp Op;
+public:
+  vtkSMPTools_BlockReduceCall(Iterator begin, vtkIdType size,
+                              vtkIdType blockSize, T* partials, BinaryOp op)
+    : Begin(begin), Size(size), BlockSize(blockSize), Partials(partials),
+      Op(op) {}
+  void operator()(vtkIdType beginBlock, vtkIdType endBlock)
+  {
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+      {
+      vtkIdType first = block * this->BlockSize;
+      vtkIdType last = std::min(first + this->BlockSize, this->Size);
+      Iterator it = this->Begin + first;
+      T sum = *it;
+      for (vtkIdType i = first + 1; i < last; ++i)
+        {
+        sum = this->Op(sum, *(++it));
+        }
+      this->Partials[block] = sum;
+      }
+  }
+};
+
+// Scan each block starting from Offsets[block], the combination of all the
+// elements of the previous blocks. The first block of an inclusive scan
+// without initial value starts from its first element instead.
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+class vtkSMPTools_BlockScanCall
+{
+  InputIt In;
+  OutputIt Out;
+  vtkIdType Size;
+  vtkIdType BlockSize;
+  const T* Offsets;
+  BinaryOp Op;
+  bool Inclusive;
+  bool HasInit;
+public:
+  vtkSMPTools_BlockScanCall(InputIt in, OutputIt out, vtkIdType size,
+                            vtkIdType blockSize, const T* offsets,
+                            BinaryOp op, bool inclusive, bool hasInit)
+    : In(in), Out(out), Size(size), BlockSize(blockSize), Offsets(offsets),
+      Op(op), Inclusive(inclusive), HasInit(hasInit) {}
+  void operator()(vtkIdType beginBlock, vtkIdType endBlock)
+  {
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+      {
+      vtkIdType first = block * this->BlockSize;
+      vtkIdType last = std::min(first + this->BlockSize, this->Size);
+      InputIt in = this->In + first;
+      OutputIt out = this->Out + first;
+      if (!this->Inclusive)
+        {
+        T running = this->Offsets[block];
+        for (vtkIdType i = first; i < last; ++i, ++in, ++out)
+          {
+          // Read before writing so that the scan can be done in place.
+          T value = *in;
+          *out = running;
+          running = this->Op(running, value);
+          }
+        continue;
+        }
+      bool fromFirst = (block == 0 && !this->HasInit);
+      T running = fromFirst ? T(*in) : this->Offsets[block];
+      if (fromFirst)
+        {
+        *out = running;
+        ++in;
+        ++out;
+        ++first;
+        }
+      for (vtkIdType i = first; i < last; ++i, ++in, ++out)
+        {
+        running = this->Op(running, *in);
+        *out = running;
+        }
+      }
+  }
+};
+
+template <typename Iterator, typename Compare>
+class vtkSMPTools_BlockSortCall
+{
+  Iterator Begin;
+  vtkIdType Size;
+  vtkIdType BlockSize;
+  Compare Comp;
+public:
+  vtkSMPTools_BlockSortCall(Iterator begin, vtkIdType size,
+                            vtkIdType blockSize, Compare comp)
+    : Begin(begin), Size(size), BlockSize(blockSize), Comp(comp) {}
+  void operator()(vtkIdType beginBlock, vtkIdType endBlock)
+  {
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+      {
+      vtkIdType first = block * this->BlockSize;
+      vtkIdType last = std::min(first + this->BlockSize, this->Size);
+      std::sort(this->Begin + first, this->Begin + last, this->Comp);
+      }
+  }
+};
+
+// Merge of [LeftBegin, LeftEnd) and [RightBegin, RightEnd) written at Out.
+struct vtkSMPTools_MergeTask
+{
+  vtkIdType LeftBegin;
+  vtkIdType LeftEnd;
+  vtkIdType RightBegin;
+  vtkIdType RightEnd;
+  vtkIdType Out;
+};
+
+// Plan one merge pass over sorted runs of width elements. Each pair of runs
+// is cut into up to numSplits independent merges: the left run is cut evenly
+// and the matching cut in the right run is found by binary search, so that
+// the last passes, which only have a few pairs left, still use every thread.
+template <typename Iterator, typename Compare>
+void vtkSMPTools_PlanMerges(Iterator src, vtkIdType size, vtkIdType width,
+                            vtkIdType numSplits, Compare comp,
+                            std::vector<vtkSMPTools_MergeTask>& tasks)
+{
+  tasks.clear();
+  for (vtkIdType lo = 0; lo < size; lo += 2 * width)
+    {
+    vtkIdType mid = std::min(lo + width, size);
+    vtkIdType hi = std::min(lo + 2 * width, size);
+    vtkIdType leftSize = mid - lo;
+    vtkIdType splits = (hi > mid) ? std::min(numSplits, leftSize) : 1;
+    vtkSMPTools_MergeTask task;
+    task.LeftBegin = lo;
+    task.RightBegin = mid;
+    for (vtkIdType k = 1; k <= splits; ++k)
+      {
+      if (k == splits)
+        {
+        task.LeftEnd = mid;
+        task.RightEnd = hi;
+        }
+      else
+        {
+        task.LeftEnd = lo + leftSize * k / splits;
+        task.RightEnd = static_cast<vtkIdType>(
+          std::lower_bound(src + mid, src + hi, *(src + task.LeftEnd), comp)
+          - src);
+        }
+      task.Out = task.LeftBegin + task.RightBegin - mid;
+      tasks.push_back(task);
+      task.LeftBegin = task.LeftEnd;
+      task.RightBegin = task.RightEnd;
+      }
+    }
+}
+
+template <typename SrcIt, typename DstIt, typename Compare>
+class vtkSMPTools_MergeCall
+{
+  SrcIt Src;
+  DstIt Dst;
+  const vtkSMPTools_MergeTask* Tasks;
+  Compare Comp;
+public:
+  vtkSMPTools_MergeCall(SrcIt src, DstIt dst,
+                        const vtkSMPTools_MergeTask* tasks, Compare comp)
+    : Src(src), Dst(dst), Tasks(tasks), Comp(comp) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      const vtkSMPTools_MergeTask& task = this->Tasks[i];
+      std::merge(this->Src + task.LeftBegin, this->Src + task.LeftEnd,
+                 this->Src + task.RightBegin, this->Src + task.RightEnd,
+                 this->Dst + task.Out, this->Comp);
+      }
+  }
+};
+
+template <typename SrcIt, typename DstIt>
+class vtkSMPTools_CopyCall
+{
+  SrcIt Src;
+  DstIt Dst;
+public:
+  vtkSMPTools_CopyCall(SrcIt src, DstIt dst) : Src(src), Dst(dst) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::copy(this->Src + begin, this->Src + end, this->Dst + begin);
+  }
+};
 } // namespace smp
 } // namespace detail
 } // namespace vtk
@@ -194,23 +494,275 @@ public:
     vtkSMPTools::For(first, last, 0, f);
   }
 
+  // Description:
+  // Apply transform to every element of [inBegin, inEnd) and store the
+  // results starting at outBegin, as std::transform does, in parallel. The
+  // iterators must be random access and transform must be safe to call from
+  // several threads at once. The output may be the input.
+  template <typename InputIt, typename OutputIt, typename UnaryOp>
+  static void Transform(InputIt inBegin, InputIt inEnd, OutputIt outBegin,
+                        UnaryOp transform)
+  {
+    vtk::detail::smp::vtkSMPTools_UnaryTransformCall<InputIt, OutputIt, UnaryOp>
+      call(inBegin, outBegin, transform);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(inEnd - inBegin), call);
+  }
+
+  // Description:
+  // Apply transform to the pairs of elements of [inBegin1, inEnd) and of the
+  // range starting at inBegin2 and store the results starting at outBegin,
+  // in parallel. Same requirements as the unary version.
+  template <typename InputIt1, typename InputIt2, typename OutputIt,
+            typename BinaryOp>
+  static void Transform(InputIt1 inBegin1, InputIt1 inEnd, InputIt2 inBegin2,
+                        OutputIt outBegin, BinaryOp transform)
+  {
+    vtk::detail::smp::vtkSMPTools_BinaryTransformCall<
+      InputIt1, InputIt2, OutputIt, BinaryOp>
+      call(inBegin1, inBegin2, outBegin, transform);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(inEnd - inBegin1), call);
+  }
+
+  // Description:
+  // Assign value to every element of [begin, end) in parallel. The
+  // iterators must be random access.
+  template <typename Iterator, typename T>
+  static void Fill(Iterator begin, Iterator end, const T& value)
+  {
+    vtk::detail::smp::vtkSMPTools_FillCall<Iterator, T> call(begin, value);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(end - begin), call);
+  }
+
+  // Description:
+  // Sort [begin, end) in ascending order (or the order defined by comp) in
+  // parallel: the range is cut into a few blocks per thread that are sorted
+  // with std::sort, then merged pairwise, each merge being itself split
+  // between the threads. Like std::sort, the sort is not stable. It uses a
+  // temporary copy of the range; small ranges and a single thread fall back
+  // to std::sort.
+  template <typename RandomAccessIterator>
+  static void Sort(RandomAccessIterator begin, RandomAccessIterator end)
+  {
+    vtkSMPTools::Sort(begin, end, std::less<
+      typename std::iterator_traits<RandomAccessIterator>::value_type>());
+  }
+  template <typename RandomAccessIterator, typename Compare>
+  static void Sort(RandomAccessIterator begin, RandomAccessIterator end,
+                   Compare comp)
+  {
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type
+      ValueType;
+    typedef typename std::vector<ValueType>::iterator BufferIterator;
+
+    vtkIdType size = static_cast<vtkIdType>(end - begin);
+    int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+    vtkIdType numBlocks, blockSize;
+    vtk::detail::smp::vtkSMPTools_ComputeBlocks(
+      size, numThreads, numBlocks, blockSize);
+    if (numBlocks <= 1)
+      {
+      std::sort(begin, end, comp);
+      return;
+      }
+
+    vtk::detail::smp::vtkSMPTools_BlockSortCall<RandomAccessIterator, Compare>
+      sorter(begin, size, blockSize, comp);
+    vtkSMPTools::For(0, numBlocks, 1, sorter);
+
+    std::vector<ValueType> buffer(begin, end);
+    std::vector<vtk::detail::smp::vtkSMPTools_MergeTask> tasks;
+    bool inBuffer = false;
+    for (vtkIdType width = blockSize; width < size; width *= 2)
+      {
+      vtkIdType numPairs = (size + 2 * width - 1) / (2 * width);
+      vtkIdType numSplits = (numBlocks + numPairs - 1) / numPairs;
+      if (!inBuffer)
+        {
+        vtk::detail::smp::vtkSMPTools_PlanMerges(
+          begin, size, width, numSplits, comp, tasks);
+        vtk::detail::smp::vtkSMPTools_MergeCall<
+          RandomAccessIterator, BufferIterator, Compare>
+          merger(begin, buffer.begin(), &tasks[0], comp);
+        vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), 1, merger);
+        }
+      else
+        {
+        vtk::detail::smp::vtkSMPTools_PlanMerges(
+          buffer.begin(), size, width, numSplits, comp, tasks);
+        vtk::detail::smp::vtkSMPTools_MergeCall<
+          BufferIterator, RandomAccessIterator, Compare>
+          merger(buffer.begin(), begin, &tasks[0], comp);
+        vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), 1, merger);
+        }
+      inBuffer = !inBuffer;
+      }
+
+    if (inBuffer)
+      {
+      vtk::detail::smp::vtkSMPTools_CopyCall<
+        BufferIterator, RandomAccessIterator> copier(buffer.begin(), begin);
+      vtkSMPTools::For(0, size, copier);
+      }
+  }
+
+  // Description:
+  // Combine the elements of [begin, end) and init with op (std::plus by
+  // default) in parallel and return the result, as std::accumulate does.
+  // op must be associative since the elements are combined block by block;
+  // for a given number of threads the order of the operations, and thus
+  // the result of a floating point sum, does not change between runs.
+  template <typename Iterator, typename T>
+  static T Reduce(Iterator begin, Iterator end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<T>());
+  }
+  template <typename Iterator, typename T, typename BinaryOp>
+  static T Reduce(Iterator begin, Iterator end, T init, BinaryOp op)
+  {
+    vtkIdType size = static_cast<vtkIdType>(end - begin);
+    vtkIdType numBlocks, blockSize;
+    vtk::detail::smp::vtkSMPTools_ComputeBlocks(
+      size, vtkSMPTools::GetEstimatedNumberOfThreads(), numBlocks, blockSize);
+    if (numBlocks <= 1)
+      {
+      for (; begin != end; ++begin)
+        {
+        init = op(init, *begin);
+        }
+      return init;
+      }
+
+    std::vector<T> partials(numBlocks, init);
+    vtk::detail::smp::vtkSMPTools_BlockReduceCall<Iterator, T, BinaryOp>
+      reducer(begin, size, blockSize, &partials[0], op);
+    vtkSMPTools::For(0, numBlocks, 1, reducer);
+    for (vtkIdType i = 0; i < numBlocks; ++i)
+      {
+      init = op(init, partials[i]);
+      }
+    return init;
+  }
+
+  // Description:
+  // Store at outBegin + i the combination with op (std::plus by default)
+  // of the elements [inBegin, inBegin + i], and of init when given, as
+  // std::partial_sum does, in parallel. op must be associative. The output
+  // may be the input.
+  template <typename InputIt, typename OutputIt>
+  static void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin)
+  {
+    vtkSMPTools::InclusiveScan(inBegin, inEnd, outBegin, std::plus<
+      typename std::iterator_traits<InputIt>::value_type>());
+  }
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  static void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin,
+                            BinaryOp op)
+  {
+    if (inBegin != inEnd)
+      {
+      typename std::iterator_traits<InputIt>::value_type first = *inBegin;
+      vtkSMPTools::Scan(inBegin, inEnd, outBegin, first, op, true, false);
+      }
+  }
+  template <typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+  static void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin,
+                            BinaryOp op, T init)
+  {
+    vtkSMPTools::Scan(inBegin, inEnd, outBegin, init, op, true, true);
+  }
+
+  // Description:
+  // Store at outBegin + i the combination with op (std::plus by default) of
+  // init and the elements [inBegin, inBegin + i), in parallel. This is the
+  // usual way of turning counts into offsets. op must be associative. The
+  // output may be the input.
+  template <typename InputIt, typename OutputIt, typename T>
+  static void ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin,
+                            T init)
+  {
+    vtkSMPTools::ExclusiveScan(inBegin, inEnd, outBegin, init, std::plus<T>());
+  }
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static void ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin,
+                            T init, BinaryOp op)
+  {
+    vtkSMPTools::Scan(inBegin, inEnd, outBegin, init, op, false, true);
+  }
+
   // Description:
   // Initialize the underlying libraries for execution. This is
   // not required as it is automatically called before the first
   // execution of any parallel code. However, it can be used to
   // control the maximum number of threads used when the back-end
-  // supports it (currently Simple and TBB only). Make sure to call
-  // it before any other parallel operation.
+  // supports it (ThreadPool, Simple, OpenMP, TBB and Runtime). Calling it
+  // again with a different number of threads changes the size of the
+  // thread pool; never call it from within a parallel section. With the
+  // Simple back-end, the vtkSMPThreadLocal objects created before such a
+  // call must not be used after it.
   // When using Kaapi, use the KAAPI_CPUCOUNT env. variable to control
   // the number of threads used in the thread pool.
   static void Initialize(int numThreads=0);
 
+  // Description:
+  // Select the back-end used by the parallel operations. This is only
+  // possible when VTK was configured with VTK_SMP_IMPLEMENTATION_TYPE set
+  // to Runtime, in which case the valid names are Sequential, ThreadPool
+  // and, when they were enabled at configure time, OpenMP and TBB. The
+  // initial back-end can also be picked with the VTK_SMP_BACKEND
+  // environment variable. Any number of threads given to Initialize() is
+  // carried over to the new back-end. Returns false, leaving the back-end
+  // unchanged, if the name is not available in this build. Names are not
+  // case sensitive. Never call it from within a parallel section.
+  static bool SetBackend(const char* backend);
+
+  // Description:
+  // Return the name of the back-end currently executing the parallel
+  // operations.
+  static const char* GetBackend();
+
   // Description:
   // Get the estimated number of threads being used by the backend.
   // This should be used as just an estimate since the number of threads may
   // vary dynamically and a particular task may not be executed on all the
   // available threads.
   static int GetEstimatedNumberOfThreads();
+
+private:
+  // Two passes over a few blocks per thread: the blocks are reduced, the
+  // block offsets are accumulated serially and each block is then scanned
+  // from its offset.
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static void Scan(InputIt inBegin, InputIt inEnd, OutputIt outBegin,
+                   T init, BinaryOp op, bool inclusive, bool hasInit)
+  {
+    vtkIdType size = static_cast<vtkIdType>(inEnd - inBegin);
+    vtkIdType numBlocks, blockSize;
+    vtk::detail::smp::vtkSMPTools_ComputeBlocks(
+      size, vtkSMPTools::GetEstimatedNumberOfThreads(), numBlocks, blockSize);
+    if (numBlocks == 0)
+      {
+      return;
+      }
+
+    std::vector<T> offsets(numBlocks, init);
+    if (numBlocks > 1)
+      {
+      std::vector<T> partials(numBlocks - 1, init);
+      vtk::detail::smp::vtkSMPTools_BlockReduceCall<InputIt, T, BinaryOp>
+        reducer(inBegin, size, blockSize, &partials[0], op);
+      vtkSMPTools::For(0, numBlocks - 1, 1, reducer);
+      offsets[1] = hasInit ? op(init, partials[0]) : partials[0];
+      for (vtkIdType i = 2; i < numBlocks; ++i)
+        {
+        offsets[i] = op(offsets[i - 1], partials[i - 1]);
+        }
+      }
+
+    vtk::detail::smp::vtkSMPTools_BlockScanCall<InputIt, OutputIt, T, BinaryOp>
+      scanner(inBegin, outBegin, size, blockSize, &offsets[0], op,
+              inclusive, hasInit);
+    vtkSMPTools::For(0, numBlocks, 1, scanner);
+  }
 };
 
 #endif
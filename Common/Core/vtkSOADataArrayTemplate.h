@@ -0,0 +1,193 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSOADataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSOADataArrayTemplate - Data array storing each component in its
+// own buffer (structure of arrays).
+//
+// .SECTION Description
+// vtkSOADataArrayTemplate holds one contiguous buffer per component instead
+// of the interleaved (array of structures) layout of vtkDataArrayTemplate.
+// It is meant to wrap the x[], y[], z[] fields of simulation codes without
+// copying them: SetArray() hands over the buffer of one component, and the
+// save flag tells whether the array may free it. The array can also
+// allocate its own buffers through SetNumberOfTuples(), Allocate() and the
+// Insert methods, like any other vtkDataArray.
+//
+// GetComponentValue(), SetComponentValue() and GetComponentReference() are
+// non-virtual and inline. They are what Iterator (returned by Begin() and
+// End()) is built on, and vtkDataArrayIteratorMacro picks this iterator
+// for vtkSOADataArrayTemplate, so templated code written for the macro
+// reads and writes the component buffers directly, without a virtual call
+// per value.
+//
+// GetVoidPointer() has no zero-copy answer for this layout: like all
+// vtkMappedDataArray subclasses, it copies the values into a temporary
+// interleaved buffer. NewInstance() returns a standard vtkDataArray of the
+// same value type.
+//
+// .SECTION See Also
+// vtkStridedDataArrayTemplate vtkMappedDataArray vtkDataArrayIteratorMacro
+
+#ifndef vtkSOADataArrayTemplate_h
+#define vtkSOADataArrayTemplate_h
+
+#include "vtkMappedDataArray.h"
+
+#include "vtkDataArrayComponentIterator.h" // For Iterator
+#include "vtkObjectFactory.h" // For VTK_STANDARD_NEW_BODY
+#include "vtkTypeTemplate.h" // For templated vtkObject API
+
+template <class Scalar>
+class vtkSOADataArrayTemplate:
+    public vtkTypeTemplate<vtkSOADataArrayTemplate<Scalar>,
+                           vtkMappedDataArray<Scalar> >
+{
+public:
+  vtkMappedDataArrayNewInstanceMacro(vtkSOADataArrayTemplate<Scalar>)
+  static vtkSOADataArrayTemplate *New();
+  virtual void PrintSelf(ostream &os, vtkIndent indent);
+
+  typedef Scalar ValueType;
+  typedef vtkDataArrayComponentIterator<vtkSOADataArrayTemplate<Scalar> >
+    Iterator;
+
+  // Description:
+  // Perform a fast, safe cast from a vtkAbstractArray to a
+  // vtkSOADataArrayTemplate. Returns NULL if source is not a
+  // vtkSOADataArrayTemplate holding Scalar values.
+  static vtkSOADataArrayTemplate<Scalar>* FastDownCast(
+    vtkAbstractArray *source);
+
+  // Description:
+  // Return iterators to the first value and past the last value, in
+  // tuple-major order.
+  Iterator Begin() { return Iterator(this, 0); }
+  Iterator End() { return Iterator(this, this->MaxId + 1); }
+
+  // Description:
+  // Inline access to component comp of tuple tupleIdx. No range checking.
+  Scalar& GetComponentReference(vtkIdType tupleIdx, int comp)
+    { return this->Arrays[comp][tupleIdx]; }
+  Scalar GetComponentValue(vtkIdType tupleIdx, int comp)
+    { return this->Arrays[comp][tupleIdx]; }
+  void SetComponentValue(vtkIdType tupleIdx, int comp, Scalar value)
+    { this->Arrays[comp][tupleIdx] = value; }
+
+  // Description:
+  // Use array, which holds numTuples values, as the buffer of component
+  // comp. SetNumberOfComponents() must be called first, and all the
+  // components must be given buffers of the same number of tuples. Set
+  // save to 1 to keep the array from deleting the buffer when it is
+  // released; otherwise it is released with free(), or with delete[] if
+  // deleteMethod is VTK_DATA_ARRAY_DELETE.
+  enum DeleteMethod
+  {
+    VTK_DATA_ARRAY_FREE,
+    VTK_DATA_ARRAY_DELETE
+  };
+  void SetArray(int comp, Scalar *array, vtkIdType numTuples, int save,
+                int deleteMethod = VTK_DATA_ARRAY_FREE);
+
+  // Description:
+  // Return the buffer of component comp.
+  Scalar* GetComponentArrayPointer(int comp)
+    { return this->Arrays[comp]; }
+
+  // Reimplemented virtuals -- see superclasses for descriptions:
+  void Initialize();
+  void GetTuples(vtkIdList *ptIds, vtkAbstractArray *output);
+  void GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *output);
+  void Squeeze();
+  vtkArrayIterator *NewIterator();
+  vtkIdType LookupValue(vtkVariant value);
+  void LookupValue(vtkVariant value, vtkIdList *ids);
+  vtkVariant GetVariantValue(vtkIdType idx);
+  void ClearLookup();
+  double* GetTuple(vtkIdType i);
+  void GetTuple(vtkIdType i, double *tuple);
+  vtkIdType LookupTypedValue(Scalar value);
+  void LookupTypedValue(Scalar value, vtkIdList *ids);
+  Scalar GetValue(vtkIdType idx);
+  Scalar& GetValueReference(vtkIdType idx);
+  void GetTupleValue(vtkIdType idx, Scalar *t);
+  unsigned long GetActualMemorySize();
+  int Allocate(vtkIdType sz, vtkIdType ext);
+  int Resize(vtkIdType numTuples);
+  void SetNumberOfTuples(vtkIdType number);
+  void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source);
+  void SetTuple(vtkIdType i, const float *source);
+  void SetTuple(vtkIdType i, const double *source);
+  void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source);
+  void InsertTuple(vtkIdType i, const float *source);
+  void InsertTuple(vtkIdType i, const double *source);
+  void InsertTuples(vtkIdList *dstIds, vtkIdList *srcIds,
+                    vtkAbstractArray *source);
+  void InsertTuples(vtkIdType dstStart, vtkIdType n, vtkIdType srcStart,
+                    vtkAbstractArray* source);
+  vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray *source);
+  vtkIdType InsertNextTuple(const float *source);
+  vtkIdType InsertNextTuple(const double *source);
+  void DeepCopy(vtkAbstractArray *aa);
+  void DeepCopy(vtkDataArray *da);
+  void InterpolateTuple(vtkIdType i, vtkIdList *ptIndices,
+                        vtkAbstractArray* source,  double* weights);
+  void InterpolateTuple(vtkIdType i, vtkIdType id1, vtkAbstractArray *source1,
+                        vtkIdType id2, vtkAbstractArray *source2, double t);
+  void SetVariantValue(vtkIdType idx, vtkVariant value);
+  void RemoveTuple(vtkIdType id);
+  void RemoveFirstTuple();
+  void RemoveLastTuple();
+  void SetTupleValue(vtkIdType i, const Scalar *t);
+  void InsertTupleValue(vtkIdType i, const Scalar *t);
+  vtkIdType InsertNextTupleValue(const Scalar *t);
+  void SetValue(vtkIdType idx, Scalar value);
+  vtkIdType InsertNextValue(Scalar v);
+  void InsertValue(vtkIdType idx, Scalar v);
+
+  // Description:
+  // Method for type-checking in FastDownCast implementations.
+  virtual int GetArrayType()
+    { return vtkAbstractArray::SOADataArrayTemplate; }
+
+protected:
+  vtkSOADataArrayTemplate();
+  ~vtkSOADataArrayTemplate();
+
+  // Description:
+  // Release the component buffers that the array owns and reset the
+  // buffer table to numComps empty entries.
+  void ReleaseArrays(int numComps);
+
+  // Description:
+  // Make room for at least numTuples tuples, growing geometrically.
+  bool EnsureCapacity(vtkIdType numTuples);
+
+  Scalar **Arrays; // one buffer per component
+  int NumberOfArrays; // entries in Arrays, follows NumberOfComponents
+  int *SaveUserArrays; // per component, 1 if the buffer is not ours
+  int *DeleteMethods; // per component, how to release the buffer
+
+private:
+  vtkSOADataArrayTemplate(const vtkSOADataArrayTemplate &); // Not implemented.
+  void operator=(const vtkSOADataArrayTemplate &); // Not implemented.
+
+  vtkIdType Lookup(const Scalar &val, vtkIdType startIndex);
+  double *TempDoubleArray; // returned by GetTuple(), one per component
+};
+
+#include "vtkSOADataArrayTemplate.txx"
+
+#endif //vtkSOADataArrayTemplate_h
+
+// VTK-HeaderTest-Exclude: vtkSOADataArrayTemplate.h
@@ -0,0 +1,745 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSOADataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkSOADataArrayTemplate_txx
+#define vtkSOADataArrayTemplate_txx
+
+#include "vtkSOADataArrayTemplate.h"
+
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkVariant.h"
+#include "vtkVariantCast.h"
+
+#include <algorithm> // For std::copy
+#include <cmath> // For ceil
+#include <cstdlib> // For malloc
+#include <limits> // For std::numeric_limits
+
+//------------------------------------------------------------------------------
+// Can't use vtkStandardNewMacro with a template.
+template <class Scalar> vtkSOADataArrayTemplate<Scalar> *
+vtkSOADataArrayTemplate<Scalar>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkSOADataArrayTemplate<Scalar>)
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkSOADataArrayTemplate<Scalar>
+::vtkSOADataArrayTemplate()
+  : Arrays(NULL),
+    NumberOfArrays(0),
+    SaveUserArrays(NULL),
+    DeleteMethods(NULL),
+    TempDoubleArray(NULL)
+{
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkSOADataArrayTemplate<Scalar>
+::~vtkSOADataArrayTemplate()
+{
+  this->ReleaseArrays(0);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> inline vtkSOADataArrayTemplate<Scalar>*
+vtkSOADataArrayTemplate<Scalar>::FastDownCast(vtkAbstractArray *source)
+{
+  if (source->GetArrayType() == vtkAbstractArray::SOADataArrayTemplate &&
+      source->GetDataType() == vtkTypeTraits<Scalar>::VTK_TYPE_ID)
+    {
+    return static_cast<vtkSOADataArrayTemplate<Scalar>*>(source);
+    }
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->vtkSOADataArrayTemplate<Scalar>::Superclass::PrintSelf(os, indent);
+  for (int comp = 0; comp < this->NumberOfArrays; ++comp)
+    {
+    os << indent << "Array " << comp << ": " << this->Arrays[comp]
+       << (this->SaveUserArrays[comp] ? " (user)" : "") << "\n";
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::ReleaseArrays(int numComps)
+{
+  for (int comp = 0; comp < this->NumberOfArrays; ++comp)
+    {
+    if (this->Arrays[comp] && !this->SaveUserArrays[comp])
+      {
+      if (this->DeleteMethods[comp] == VTK_DATA_ARRAY_FREE)
+        {
+        free(this->Arrays[comp]);
+        }
+      else
+        {
+        delete [] this->Arrays[comp];
+        }
+      }
+    }
+  delete [] this->Arrays;
+  delete [] this->SaveUserArrays;
+  delete [] this->DeleteMethods;
+  delete [] this->TempDoubleArray;
+  this->Arrays = NULL;
+  this->SaveUserArrays = NULL;
+  this->DeleteMethods = NULL;
+  this->TempDoubleArray = NULL;
+
+  this->NumberOfArrays = numComps;
+  if (numComps > 0)
+    {
+    this->Arrays = new Scalar*[numComps];
+    this->SaveUserArrays = new int[numComps];
+    this->DeleteMethods = new int[numComps];
+    this->TempDoubleArray = new double[numComps];
+    for (int comp = 0; comp < this->NumberOfArrays; ++comp)
+      {
+      this->Arrays[comp] = NULL;
+      this->SaveUserArrays[comp] = 0;
+      this->DeleteMethods[comp] = VTK_DATA_ARRAY_FREE;
+      }
+    }
+  this->Size = 0;
+  this->MaxId = -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetArray(int comp, Scalar *array, vtkIdType numTuples, int save,
+           int deleteMethod)
+{
+  if (comp < 0 || comp >= this->NumberOfComponents)
+    {
+    vtkErrorMacro(<< "Invalid component " << comp << " for an array of "
+                  << this->NumberOfComponents << " components.");
+    return;
+    }
+  if (this->NumberOfArrays != this->NumberOfComponents)
+    {
+    this->ReleaseArrays(this->NumberOfComponents);
+    }
+
+  Scalar *old = this->Arrays[comp];
+  if (old && old != array && !this->SaveUserArrays[comp])
+    {
+    if (this->DeleteMethods[comp] == VTK_DATA_ARRAY_FREE)
+      {
+      free(old);
+      }
+    else
+      {
+      delete [] old;
+      }
+    }
+
+  this->Arrays[comp] = array;
+  this->SaveUserArrays[comp] = save;
+  this->DeleteMethods[comp] = deleteMethod;
+  this->Size = numTuples * this->NumberOfComponents;
+  this->MaxId = this->Size - 1;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>::Initialize()
+{
+  this->ReleaseArrays(this->NumberOfComponents);
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkSOADataArrayTemplate<Scalar>
+::Resize(vtkIdType numTuples)
+{
+  if (this->NumberOfArrays != this->NumberOfComponents)
+    {
+    this->ReleaseArrays(this->NumberOfComponents);
+    }
+  if (numTuples <= 0)
+    {
+    this->Initialize();
+    return 1;
+    }
+
+  const vtkIdType oldTuples = this->Size / this->NumberOfComponents;
+  const vtkIdType numCopy = std::min(oldTuples, numTuples);
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    Scalar *old = this->Arrays[comp];
+    Scalar *array;
+    if (old && !this->SaveUserArrays[comp] &&
+        this->DeleteMethods[comp] == VTK_DATA_ARRAY_FREE)
+      {
+      array = static_cast<Scalar*>(
+        realloc(old, static_cast<size_t>(numTuples) * sizeof(Scalar)));
+      }
+    else
+      {
+      array = static_cast<Scalar*>(
+        malloc(static_cast<size_t>(numTuples) * sizeof(Scalar)));
+      if (array && old)
+        {
+        std::copy(old, old + numCopy, array);
+        if (!this->SaveUserArrays[comp])
+          {
+          delete [] old;
+          }
+        }
+      }
+    if (!array)
+      {
+      vtkErrorMacro("Unable to allocate " << numTuples
+                    << " elements of size " << sizeof(Scalar) << " bytes.");
+      return 0;
+      }
+    this->Arrays[comp] = array;
+    this->SaveUserArrays[comp] = 0;
+    this->DeleteMethods[comp] = VTK_DATA_ARRAY_FREE;
+    }
+
+  this->Size = numTuples * this->NumberOfComponents;
+  if (this->MaxId >= this->Size)
+    {
+    this->MaxId = this->Size - 1;
+    }
+  this->Modified();
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> bool vtkSOADataArrayTemplate<Scalar>
+::EnsureCapacity(vtkIdType numTuples)
+{
+  if (numTuples * this->NumberOfComponents <= this->Size &&
+      this->NumberOfArrays == this->NumberOfComponents)
+    {
+    return true;
+    }
+  const vtkIdType capacity = this->Size / this->NumberOfComponents;
+  return this->Resize(std::max(numTuples, 2 * capacity)) != 0;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkSOADataArrayTemplate<Scalar>
+::Allocate(vtkIdType sz, vtkIdType)
+{
+  if (sz > this->Size || this->NumberOfArrays != this->NumberOfComponents)
+    {
+    this->ReleaseArrays(this->NumberOfComponents);
+    const vtkIdType numComps = this->NumberOfComponents;
+    if (!this->Resize((std::max(sz, static_cast<vtkIdType>(1)) + numComps - 1)
+                      / numComps))
+      {
+      return 0;
+      }
+    }
+  this->MaxId = -1;
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetNumberOfTuples(vtkIdType number)
+{
+  if (number * this->NumberOfComponents > this->Size ||
+      this->NumberOfArrays != this->NumberOfComponents)
+    {
+    if (!this->Resize(number))
+      {
+      return;
+      }
+    }
+  this->MaxId = number * this->NumberOfComponents - 1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>::Squeeze()
+{
+  this->Resize(this->GetNumberOfTuples());
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::GetTuples(vtkIdList *ptIds, vtkAbstractArray *output)
+{
+  this->vtkDataArray::GetTuples(ptIds, output);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *output)
+{
+  this->vtkDataArray::GetTuples(p1, p2, output);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkArrayIterator*
+vtkSOADataArrayTemplate<Scalar>::NewIterator()
+{
+  vtkErrorMacro(<<"Not implemented.");
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::Lookup(const Scalar &val, vtkIdType index)
+{
+  const int numComps = this->NumberOfComponents;
+  for (; index <= this->MaxId; ++index)
+    {
+    if (this->Arrays[index % numComps][index / numComps] == val)
+      {
+      return index;
+      }
+    }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::LookupValue(vtkVariant value)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  if (valid)
+    {
+    return this->Lookup(val, 0);
+    }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::LookupValue(vtkVariant value, vtkIdList *ids)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  ids->Reset();
+  if (valid)
+    {
+    this->LookupTypedValue(val, ids);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::LookupTypedValue(Scalar value)
+{
+  return this->Lookup(value, 0);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::LookupTypedValue(Scalar value, vtkIdList *ids)
+{
+  ids->Reset();
+  vtkIdType index = 0;
+  while ((index = this->Lookup(value, index)) >= 0)
+    {
+    ids->InsertNextId(index++);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>::ClearLookup()
+{
+  // no-op, no fast lookup implemented.
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkVariant vtkSOADataArrayTemplate<Scalar>
+::GetVariantValue(vtkIdType idx)
+{
+  return vtkVariant(this->GetValue(idx));
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetVariantValue(vtkIdType idx, vtkVariant value)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  if (valid)
+    {
+    this->SetValue(idx, val);
+    }
+  else
+    {
+    vtkErrorMacro("Could not convert the variant to the array type.");
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> double* vtkSOADataArrayTemplate<Scalar>
+::GetTuple(vtkIdType i)
+{
+  this->GetTuple(i, this->TempDoubleArray);
+  return this->TempDoubleArray;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::GetTuple(vtkIdType i, double *tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    tuple[comp] = static_cast<double>(this->Arrays[comp][i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar vtkSOADataArrayTemplate<Scalar>
+::GetValue(vtkIdType idx)
+{
+  return this->GetValueReference(idx);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar& vtkSOADataArrayTemplate<Scalar>
+::GetValueReference(vtkIdType idx)
+{
+  const int numComps = this->NumberOfComponents;
+  return this->Arrays[idx % numComps][idx / numComps];
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::GetTupleValue(vtkIdType i, Scalar *tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    tuple[comp] = this->Arrays[comp][i];
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> unsigned long vtkSOADataArrayTemplate<Scalar>
+::GetActualMemorySize()
+{
+  return static_cast<unsigned long>(
+    ceil(static_cast<double>(this->Size) * sizeof(Scalar) / 1024.0));
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source)
+{
+  if (source->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+    vtkWarningMacro("Input and output component sizes do not match.");
+    return;
+    }
+  if (vtkTypedDataArray<Scalar> *typedSource =
+      vtkTypedDataArray<Scalar>::FastDownCast(source))
+    {
+    const vtkIdType loc = j * this->NumberOfComponents;
+    for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+      {
+      this->Arrays[comp][i] = typedSource->GetValue(loc + comp);
+      }
+    }
+  else if (vtkDataArray *dataSource = vtkDataArray::FastDownCast(source))
+    {
+    this->SetTuple(i, dataSource->GetTuple(j));
+    }
+  else
+    {
+    vtkWarningMacro("Input array is not a vtkDataArray.");
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetTuple(vtkIdType i, const float *source)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    this->Arrays[comp][i] = static_cast<Scalar>(source[comp]);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetTuple(vtkIdType i, const double *source)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    this->Arrays[comp][i] = static_cast<Scalar>(source[comp]);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetTupleValue(vtkIdType i, const Scalar *tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    this->Arrays[comp][i] = tuple[comp];
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::SetValue(vtkIdType idx, Scalar value)
+{
+  this->GetValueReference(idx) = value;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source)
+{
+  if (this->EnsureCapacity(i + 1))
+    {
+    this->SetTuple(i, j, source);
+    this->MaxId = std::max(this->MaxId, (i + 1) * this->NumberOfComponents - 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType i, const float *source)
+{
+  if (this->EnsureCapacity(i + 1))
+    {
+    this->SetTuple(i, source);
+    this->MaxId = std::max(this->MaxId, (i + 1) * this->NumberOfComponents - 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType i, const double *source)
+{
+  if (this->EnsureCapacity(i + 1))
+    {
+    this->SetTuple(i, source);
+    this->MaxId = std::max(this->MaxId, (i + 1) * this->NumberOfComponents - 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertTupleValue(vtkIdType i, const Scalar *tuple)
+{
+  if (this->EnsureCapacity(i + 1))
+    {
+    this->SetTupleValue(i, tuple);
+    this->MaxId = std::max(this->MaxId, (i + 1) * this->NumberOfComponents - 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertTuples(vtkIdList *dstIds, vtkIdList *srcIds, vtkAbstractArray *source)
+{
+  const vtkIdType numIds = dstIds->GetNumberOfIds();
+  if (srcIds->GetNumberOfIds() != numIds)
+    {
+    vtkWarningMacro("Input and output id array sizes do not match.");
+    return;
+    }
+  for (vtkIdType k = 0; k < numIds; ++k)
+    {
+    this->InsertTuple(dstIds->GetId(k), srcIds->GetId(k), source);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertTuples(vtkIdType dstStart, vtkIdType n, vtkIdType srcStart,
+               vtkAbstractArray *source)
+{
+  if (n > 0 && this->EnsureCapacity(dstStart + n))
+    {
+    for (vtkIdType k = 0; k < n; ++k)
+      {
+      this->InsertTuple(dstStart + k, srcStart + k, source);
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::InsertNextTuple(vtkIdType j, vtkAbstractArray *source)
+{
+  const vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, j, source);
+  return i;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::InsertNextTuple(const float *source)
+{
+  const vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, source);
+  return i;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::InsertNextTuple(const double *source)
+{
+  const vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, source);
+  return i;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::InsertNextTupleValue(const Scalar *tuple)
+{
+  const vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTupleValue(i, tuple);
+  return i;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InsertValue(vtkIdType idx, Scalar v)
+{
+  if (this->EnsureCapacity(idx / this->NumberOfComponents + 1))
+    {
+    this->GetValueReference(idx) = v;
+    this->MaxId = std::max(this->MaxId, idx);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkSOADataArrayTemplate<Scalar>
+::InsertNextValue(Scalar v)
+{
+  this->InsertValue(this->MaxId + 1, v);
+  return this->MaxId;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::RemoveTuple(vtkIdType id)
+{
+  const vtkIdType numTuples = this->GetNumberOfTuples();
+  if (id < 0 || id >= numTuples)
+    {
+    return;
+    }
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    Scalar *array = this->Arrays[comp];
+    std::copy(array + id + 1, array + numTuples, array + id);
+    }
+  this->MaxId -= this->NumberOfComponents;
+  // Not DataChanged(): that copies the values of GetVoidPointer() back.
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::RemoveFirstTuple()
+{
+  this->RemoveTuple(0);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::RemoveLastTuple()
+{
+  this->RemoveTuple(this->GetNumberOfTuples() - 1);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::DeepCopy(vtkAbstractArray *aa)
+{
+  this->vtkDataArray::DeepCopy(aa);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::DeepCopy(vtkDataArray *da)
+{
+  this->vtkDataArray::DeepCopy(da);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InterpolateTuple(vtkIdType i, vtkIdList *ptIndices, vtkAbstractArray *source,
+                   double *weights)
+{
+  vtkDataArray *from = vtkDataArray::FastDownCast(source);
+  if (!from || from->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+    vtkErrorMacro("Cannot interpolate from " << source->GetClassName());
+    return;
+    }
+  if (!this->EnsureCapacity(i + 1))
+    {
+    return;
+    }
+
+  const vtkIdType numIds = ptIndices->GetNumberOfIds();
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    double c = 0.0;
+    for (vtkIdType k = 0; k < numIds; ++k)
+      {
+      c += weights[k] * from->GetComponent(ptIndices->GetId(k), comp);
+      }
+    if (std::numeric_limits<Scalar>::is_integer)
+      {
+      c = (c >= 0.0) ? c + 0.5 : c - 0.5;
+      }
+    this->Arrays[comp][i] = static_cast<Scalar>(c);
+    }
+  this->MaxId = std::max(this->MaxId, (i + 1) * this->NumberOfComponents - 1);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkSOADataArrayTemplate<Scalar>
+::InterpolateTuple(vtkIdType i, vtkIdType id1, vtkAbstractArray *source1,
+                   vtkIdType id2, vtkAbstractArray *source2, double t)
+{
+  vtkDataArray *from1 = vtkDataArray::FastDownCast(source1);
+  vtkDataArray *from2 = vtkDataArray::FastDownCast(source2);
+  if (!from1 || !from2 ||
+      from1->GetNumberOfComponents() != this->NumberOfComponents ||
+      from2->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+    vtkErrorMacro("Cannot interpolate from the given arrays.");
+    return;
+    }
+  if (!this->EnsureCapacity(i + 1))
+    {
+    return;
+    }
+
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    const double c1 = from1->GetComponent(id1, comp);
+    const double c2 = from2->GetComponent(id2, comp);
+    this->Arrays[comp][i] = static_cast<Scalar>(c1 + t * (c2 - c1));
+    }
+  this->MaxId = std::max(this->MaxId, (i + 1) * this->NumberOfComponents - 1);
+}
+
+#endif //vtkSOADataArrayTemplate_txx
@@ -0,0 +1,212 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStridedDataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStridedDataArrayTemplate - Data array viewing a buffer whose
+// tuples are separated by a stride.
+//
+// .SECTION Description
+// vtkStridedDataArrayTemplate presents part of an existing buffer as a
+// vtkDataArray without copying it. Component comp of tuple i is the value
+// at array[Offset + i * Stride + comp], where Offset and Stride count
+// values of type Scalar. This fits the records of simulation codes that
+// interleave several fields (x, y, z, pressure, ...), or a subset of the
+// components of another array: the view onto the coordinates of a record
+// of 5 doubles whose first two values are ids has Stride 5 and Offset 2.
+//
+// The view has a fixed capacity: values may be set and tuples inserted
+// within the numTuples given to SetArray(), but the array cannot grow
+// beyond them. Allocate() and Resize() fail if asked for more.
+//
+// GetComponentValue(), SetComponentValue() and GetComponentReference() are
+// non-virtual and inline. They are what Iterator (returned by Begin() and
+// End()) is built on, and vtkDataArrayIteratorMacro picks this iterator
+// for vtkStridedDataArrayTemplate, so templated code written for the macro
+// reaches the buffer directly, without a virtual call per value.
+//
+// When Stride equals the number of components the view is contiguous:
+// HasStandardMemoryLayout() is then true and GetVoidPointer() and
+// WriteVoidPointer() return pointers into the buffer, so code using raw
+// pointers, vtkDataArrayDispatcher for instance, stays zero-copy too.
+// Otherwise GetVoidPointer() copies the values into a temporary
+// interleaved buffer like all vtkMappedDataArray subclasses. NewInstance()
+// returns a standard vtkDataArray of the same value type.
+//
+// .SECTION See Also
+// vtkSOADataArrayTemplate vtkMappedDataArray vtkDataArrayIteratorMacro
+
+#ifndef vtkStridedDataArrayTemplate_h
+#define vtkStridedDataArrayTemplate_h
+
+#include "vtkMappedDataArray.h"
+
+#include "vtkDataArrayComponentIterator.h" // For Iterator
+#include "vtkObjectFactory.h" // For VTK_STANDARD_NEW_BODY
+#include "vtkTypeTemplate.h" // For templated vtkObject API
+
+template <class Scalar>
+class vtkStridedDataArrayTemplate:
+    public vtkTypeTemplate<vtkStridedDataArrayTemplate<Scalar>,
+                           vtkMappedDataArray<Scalar> >
+{
+public:
+  vtkMappedDataArrayNewInstanceMacro(vtkStridedDataArrayTemplate<Scalar>)
+  static vtkStridedDataArrayTemplate *New();
+  virtual void PrintSelf(ostream &os, vtkIndent indent);
+
+  typedef Scalar ValueType;
+  typedef vtkDataArrayComponentIterator<vtkStridedDataArrayTemplate<Scalar> >
+    Iterator;
+
+  // Description:
+  // Perform a fast, safe cast from a vtkAbstractArray to a
+  // vtkStridedDataArrayTemplate. Returns NULL if source is not a
+  // vtkStridedDataArrayTemplate holding Scalar values.
+  static vtkStridedDataArrayTemplate<Scalar>* FastDownCast(
+    vtkAbstractArray *source);
+
+  // Description:
+  // Return iterators to the first value and past the last value, in
+  // tuple-major order.
+  Iterator Begin() { return Iterator(this, 0); }
+  Iterator End() { return Iterator(this, this->MaxId + 1); }
+
+  // Description:
+  // Inline access to component comp of tuple tupleIdx. No range checking.
+  Scalar& GetComponentReference(vtkIdType tupleIdx, int comp)
+    { return this->Data[tupleIdx * this->Stride + comp]; }
+  Scalar GetComponentValue(vtkIdType tupleIdx, int comp)
+    { return this->Data[tupleIdx * this->Stride + comp]; }
+  void SetComponentValue(vtkIdType tupleIdx, int comp, Scalar value)
+    { this->Data[tupleIdx * this->Stride + comp] = value; }
+
+  // Description:
+  // View array, which holds at least offset + (numTuples - 1) * stride +
+  // NumberOfComponents values, as numTuples tuples starting at offset and
+  // stride values apart. SetNumberOfComponents() must be called first, and
+  // stride must be at least the number of components. Set save to 1 to
+  // keep the array from deleting the buffer when it is released; otherwise
+  // it is released with free(), or with delete[] if deleteMethod is
+  // VTK_DATA_ARRAY_DELETE.
+  enum DeleteMethod
+  {
+    VTK_DATA_ARRAY_FREE,
+    VTK_DATA_ARRAY_DELETE
+  };
+  void SetArray(Scalar *array, vtkIdType numTuples, vtkIdType stride,
+                vtkIdType offset, int save,
+                int deleteMethod = VTK_DATA_ARRAY_FREE);
+
+  // Description:
+  // Get the buffer, and the stride and offset of the view in it.
+  Scalar* GetArray() { return this->Array; }
+  vtkGetMacro(Stride, vtkIdType);
+  vtkGetMacro(Offset, vtkIdType);
+
+  // Description:
+  // Return pointers into the buffer when the view is contiguous, that is
+  // when Stride equals the number of components. Otherwise GetVoidPointer()
+  // returns a temporary copy and WriteVoidPointer() fails.
+  void* GetVoidPointer(vtkIdType id);
+  void* WriteVoidPointer(vtkIdType id, vtkIdType number);
+  bool HasStandardMemoryLayout();
+
+  // Reimplemented virtuals -- see superclasses for descriptions:
+  void Initialize();
+  void GetTuples(vtkIdList *ptIds, vtkAbstractArray *output);
+  void GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *output);
+  void Squeeze();
+  vtkArrayIterator *NewIterator();
+  vtkIdType LookupValue(vtkVariant value);
+  void LookupValue(vtkVariant value, vtkIdList *ids);
+  vtkVariant GetVariantValue(vtkIdType idx);
+  void ClearLookup();
+  double* GetTuple(vtkIdType i);
+  void GetTuple(vtkIdType i, double *tuple);
+  vtkIdType LookupTypedValue(Scalar value);
+  void LookupTypedValue(Scalar value, vtkIdList *ids);
+  Scalar GetValue(vtkIdType idx);
+  Scalar& GetValueReference(vtkIdType idx);
+  void GetTupleValue(vtkIdType idx, Scalar *t);
+  unsigned long GetActualMemorySize();
+  int Allocate(vtkIdType sz, vtkIdType ext);
+  int Resize(vtkIdType numTuples);
+  void SetNumberOfTuples(vtkIdType number);
+  void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source);
+  void SetTuple(vtkIdType i, const float *source);
+  void SetTuple(vtkIdType i, const double *source);
+  void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source);
+  void InsertTuple(vtkIdType i, const float *source);
+  void InsertTuple(vtkIdType i, const double *source);
+  void InsertTuples(vtkIdList *dstIds, vtkIdList *srcIds,
+                    vtkAbstractArray *source);
+  void InsertTuples(vtkIdType dstStart, vtkIdType n, vtkIdType srcStart,
+                    vtkAbstractArray* source);
+  vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray *source);
+  vtkIdType InsertNextTuple(const float *source);
+  vtkIdType InsertNextTuple(const double *source);
+  void DeepCopy(vtkAbstractArray *aa);
+  void DeepCopy(vtkDataArray *da);
+  void InterpolateTuple(vtkIdType i, vtkIdList *ptIndices,
+                        vtkAbstractArray* source,  double* weights);
+  void InterpolateTuple(vtkIdType i, vtkIdType id1, vtkAbstractArray *source1,
+                        vtkIdType id2, vtkAbstractArray *source2, double t);
+  void SetVariantValue(vtkIdType idx, vtkVariant value);
+  void RemoveTuple(vtkIdType id);
+  void RemoveFirstTuple();
+  void RemoveLastTuple();
+  void SetTupleValue(vtkIdType i, const Scalar *t);
+  void InsertTupleValue(vtkIdType i, const Scalar *t);
+  vtkIdType InsertNextTupleValue(const Scalar *t);
+  void SetValue(vtkIdType idx, Scalar value);
+  vtkIdType InsertNextValue(Scalar v);
+  void InsertValue(vtkIdType idx, Scalar v);
+
+  // Description:
+  // Method for type-checking in FastDownCast implementations.
+  virtual int GetArrayType()
+    { return vtkAbstractArray::StridedDataArrayTemplate; }
+
+protected:
+  vtkStridedDataArrayTemplate();
+  ~vtkStridedDataArrayTemplate();
+
+  // Description:
+  // Release the buffer if the array owns it.
+  void ReleaseArray();
+
+  // Description:
+  // Check that the view holds at least numTuples tuples.
+  bool EnsureCapacity(vtkIdType numTuples);
+
+  Scalar *Array; // the buffer
+  Scalar *Data; // Array + Offset, first value of the view
+  vtkIdType Stride; // values between consecutive tuples
+  vtkIdType Offset; // values before the first tuple
+  int SaveUserArray; // 1 if the buffer is not ours
+  int DeleteMethod; // how to release the buffer
+
+private:
+  vtkStridedDataArrayTemplate(const vtkStridedDataArrayTemplate &); // Not implemented.
+  void operator=(const vtkStridedDataArrayTemplate &); // Not implemented.
+
+  vtkIdType Lookup(const Scalar &val, vtkIdType startIndex);
+  double *TempDoubleArray; // returned by GetTuple()
+  int TempDoubleArraySize;
+};
+
+#include "vtkStridedDataArrayTemplate.txx"
+
+#endif //vtkStridedDataArrayTemplate_h
+
+// VTK-HeaderTest-Exclude: vtkStridedDataArrayTemplate.h
@@ -0,0 +1,711 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStridedDataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkStridedDataArrayTemplate_txx
+#define vtkStridedDataArrayTemplate_txx
+
+#include "vtkStridedDataArrayTemplate.h"
+
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkVariant.h"
+#include "vtkVariantCast.h"
+
+#include <algorithm> // For std::copy
+#include <cmath> // For ceil
+#include <cstdlib> // For free
+#include <limits> // For std::numeric_limits
+
+//------------------------------------------------------------------------------
+// Can't use vtkStandardNewMacro with a template.
+template <class Scalar> vtkStridedDataArrayTemplate<Scalar> *
+vtkStridedDataArrayTemplate<Scalar>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkStridedDataArrayTemplate<Scalar>)
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkStridedDataArrayTemplate<Scalar>
+::vtkStridedDataArrayTemplate()
+  : Array(NULL),
+    Data(NULL),
+    Stride(1),
+    Offset(0),
+    SaveUserArray(0),
+    DeleteMethod(VTK_DATA_ARRAY_FREE),
+    TempDoubleArray(NULL),
+    TempDoubleArraySize(0)
+{
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkStridedDataArrayTemplate<Scalar>
+::~vtkStridedDataArrayTemplate()
+{
+  this->ReleaseArray();
+  delete [] this->TempDoubleArray;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> inline vtkStridedDataArrayTemplate<Scalar>*
+vtkStridedDataArrayTemplate<Scalar>::FastDownCast(vtkAbstractArray *source)
+{
+  if (source->GetArrayType() == vtkAbstractArray::StridedDataArrayTemplate &&
+      source->GetDataType() == vtkTypeTraits<Scalar>::VTK_TYPE_ID)
+    {
+    return static_cast<vtkStridedDataArrayTemplate<Scalar>*>(source);
+    }
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->vtkStridedDataArrayTemplate<Scalar>::Superclass::PrintSelf(os, indent);
+  os << indent << "Array: " << this->Array
+     << (this->SaveUserArray ? " (user)" : "") << "\n";
+  os << indent << "Stride: " << this->Stride << "\n";
+  os << indent << "Offset: " << this->Offset << "\n";
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>::ReleaseArray()
+{
+  if (this->Array && !this->SaveUserArray)
+    {
+    if (this->DeleteMethod == VTK_DATA_ARRAY_FREE)
+      {
+      free(this->Array);
+      }
+    else
+      {
+      delete [] this->Array;
+      }
+    }
+  this->Array = NULL;
+  this->Data = NULL;
+  this->Stride = 1;
+  this->Offset = 0;
+  this->SaveUserArray = 0;
+  this->DeleteMethod = VTK_DATA_ARRAY_FREE;
+  this->Size = 0;
+  this->MaxId = -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::SetArray(Scalar *array, vtkIdType numTuples, vtkIdType stride,
+           vtkIdType offset, int save, int deleteMethod)
+{
+  if (stride < this->NumberOfComponents || offset < 0 || numTuples < 0)
+    {
+    vtkErrorMacro(<< "Invalid view: stride " << stride << " and offset "
+                  << offset << " for " << this->NumberOfComponents
+                  << " components.");
+    return;
+    }
+  if (array != this->Array)
+    {
+    this->ReleaseArray();
+    }
+
+  this->Array = array;
+  this->Data = array + offset;
+  this->Stride = stride;
+  this->Offset = offset;
+  this->SaveUserArray = save;
+  this->DeleteMethod = deleteMethod;
+  this->Size = numTuples * this->NumberOfComponents;
+  this->MaxId = this->Size - 1;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>::Initialize()
+{
+  this->ReleaseArray();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void* vtkStridedDataArrayTemplate<Scalar>
+::GetVoidPointer(vtkIdType id)
+{
+  if (this->HasStandardMemoryLayout())
+    {
+    return this->Data + id;
+    }
+  return this->Superclass::GetVoidPointer(id);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void* vtkStridedDataArrayTemplate<Scalar>
+::WriteVoidPointer(vtkIdType id, vtkIdType number)
+{
+  if (!this->HasStandardMemoryLayout())
+    {
+    vtkErrorMacro(<<"WriteVoidPointer: the view is not contiguous.");
+    return NULL;
+    }
+  if (id + number > this->Size)
+    {
+    vtkErrorMacro(<<"WriteVoidPointer: cannot grow the view.");
+    return NULL;
+    }
+  this->MaxId = std::max(this->MaxId, id + number - 1);
+  return this->Data + id;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> bool vtkStridedDataArrayTemplate<Scalar>
+::HasStandardMemoryLayout()
+{
+  return this->Stride == this->NumberOfComponents;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkStridedDataArrayTemplate<Scalar>
+::Resize(vtkIdType numTuples)
+{
+  if (numTuples * this->NumberOfComponents > this->Size)
+    {
+    vtkErrorMacro(<< "Cannot grow a view of " << this->Size
+                  << " values to " << numTuples << " tuples.");
+    return 0;
+    }
+  if (this->MaxId >= numTuples * this->NumberOfComponents)
+    {
+    this->MaxId = numTuples * this->NumberOfComponents - 1;
+    }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> bool vtkStridedDataArrayTemplate<Scalar>
+::EnsureCapacity(vtkIdType numTuples)
+{
+  if (numTuples * this->NumberOfComponents > this->Size)
+    {
+    vtkErrorMacro(<< "Cannot grow a view of " << this->Size
+                  << " values to " << numTuples << " tuples.");
+    return false;
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> int vtkStridedDataArrayTemplate<Scalar>
+::Allocate(vtkIdType sz, vtkIdType)
+{
+  if (sz > this->Size)
+    {
+    vtkErrorMacro(<< "Cannot grow a view of " << this->Size
+                  << " values to " << sz << " values.");
+    return 0;
+    }
+  this->MaxId = -1;
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::SetNumberOfTuples(vtkIdType number)
+{
+  if (this->EnsureCapacity(number))
+    {
+    this->MaxId = number * this->NumberOfComponents - 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>::Squeeze()
+{
+  // noop, the buffer belongs to the view's owner.
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::GetTuples(vtkIdList *ptIds, vtkAbstractArray *output)
+{
+  this->vtkDataArray::GetTuples(ptIds, output);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *output)
+{
+  this->vtkDataArray::GetTuples(p1, p2, output);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkArrayIterator*
+vtkStridedDataArrayTemplate<Scalar>::NewIterator()
+{
+  vtkErrorMacro(<<"Not implemented.");
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStridedDataArrayTemplate<Scalar>
+::Lookup(const Scalar &val, vtkIdType index)
+{
+  const int numComps = this->NumberOfComponents;
+  for (; index <= this->MaxId; ++index)
+    {
+    if (this->Data[(index / numComps) * this->Stride + index % numComps] ==
+        val)
+      {
+      return index;
+      }
+    }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStridedDataArrayTemplate<Scalar>
+::LookupValue(vtkVariant value)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  if (valid)
+    {
+    return this->Lookup(val, 0);
+    }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::LookupValue(vtkVariant value, vtkIdList *ids)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  ids->Reset();
+  if (valid)
+    {
+    this->LookupTypedValue(val, ids);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStridedDataArrayTemplate<Scalar>
+::LookupTypedValue(Scalar value)
+{
+  return this->Lookup(value, 0);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::LookupTypedValue(Scalar value, vtkIdList *ids)
+{
+  ids->Reset();
+  vtkIdType index = 0;
+  while ((index = this->Lookup(value, index)) >= 0)
+    {
+    ids->InsertNextId(index++);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>::ClearLookup()
+{
+  // no-op, no fast lookup implemented.
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkVariant vtkStridedDataArrayTemplate<Scalar>
+::GetVariantValue(vtkIdType idx)
+{
+  return vtkVariant(this->GetValue(idx));
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::SetVariantValue(vtkIdType idx, vtkVariant value)
+{
+  bool valid = true;
+  Scalar val = vtkVariantCast<Scalar>(value, &valid);
+  if (valid)
+    {
+    this->SetValue(idx, val);
+    }
+  else
+    {
+    vtkErrorMacro("Could not convert the variant to the array type.");
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> double* vtkStridedDataArrayTemplate<Scalar>
+::GetTuple(vtkIdType i)
+{
+  if (this->TempDoubleArraySize < this->NumberOfComponents)
+    {
+    delete [] this->TempDoubleArray;
+    this->TempDoubleArray = new double[this->NumberOfComponents];
+    this->TempDoubleArraySize = this->NumberOfComponents;
+    }
+  this->GetTuple(i, this->TempDoubleArray);
+  return this->TempDoubleArray;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::GetTuple(vtkIdType i, double *tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    tuple[comp] = static_cast<double>(this->Data[i * this->Stride + comp]);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar vtkStridedDataArrayTemplate<Scalar>
+::GetValue(vtkIdType idx)
+{
+  return this->GetValueReference(idx);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> Scalar& vtkStridedDataArrayTemplate<Scalar>
+::GetValueReference(vtkIdType idx)
+{
+  const int numComps = this->NumberOfComponents;
+  return this->Data[(idx / numComps) * this->Stride + idx % numComps];
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::GetTupleValue(vtkIdType i, Scalar *tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    tuple[comp] = this->Data[i * this->Stride + comp];
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> unsigned long vtkStridedDataArrayTemplate<Scalar>
+::GetActualMemorySize()
+{
+  return static_cast<unsigned long>(
+    ceil(static_cast<double>(this->Size) * sizeof(Scalar) / 1024.0));
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source)
+{
+  if (source->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+    vtkWarningMacro("Input and output component sizes do not match.");
+    return;
+    }
+  if (vtkTypedDataArray<Scalar> *typedSource =
+      vtkTypedDataArray<Scalar>::FastDownCast(source))
+    {
+    const vtkIdType loc = j * this->NumberOfComponents;
+    for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+      {
+      this->Data[i * this->Stride + comp] = typedSource->GetValue(loc + comp);
+      }
+    }
+  else if (vtkDataArray *dataSource = vtkDataArray::FastDownCast(source))
+    {
+    this->SetTuple(i, dataSource->GetTuple(j));
+    }
+  else
+    {
+    vtkWarningMacro("Input array is not a vtkDataArray.");
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::SetTuple(vtkIdType i, const float *source)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    this->Data[i * this->Stride + comp] = static_cast<Scalar>(source[comp]);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::SetTuple(vtkIdType i, const double *source)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    this->Data[i * this->Stride + comp] = static_cast<Scalar>(source[comp]);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::SetTupleValue(vtkIdType i, const Scalar *tuple)
+{
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    this->Data[i * this->Stride + comp] = tuple[comp];
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::SetValue(vtkIdType idx, Scalar value)
+{
+  this->GetValueReference(idx) = value;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray *source)
+{
+  if (this->EnsureCapacity(i + 1))
+    {
+    this->SetTuple(i, j, source);
+    this->MaxId = std::max(this->MaxId, (i + 1) * this->NumberOfComponents - 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType i, const float *source)
+{
+  if (this->EnsureCapacity(i + 1))
+    {
+    this->SetTuple(i, source);
+    this->MaxId = std::max(this->MaxId, (i + 1) * this->NumberOfComponents - 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::InsertTuple(vtkIdType i, const double *source)
+{
+  if (this->EnsureCapacity(i + 1))
+    {
+    this->SetTuple(i, source);
+    this->MaxId = std::max(this->MaxId, (i + 1) * this->NumberOfComponents - 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::InsertTupleValue(vtkIdType i, const Scalar *tuple)
+{
+  if (this->EnsureCapacity(i + 1))
+    {
+    this->SetTupleValue(i, tuple);
+    this->MaxId = std::max(this->MaxId, (i + 1) * this->NumberOfComponents - 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::InsertTuples(vtkIdList *dstIds, vtkIdList *srcIds, vtkAbstractArray *source)
+{
+  const vtkIdType numIds = dstIds->GetNumberOfIds();
+  if (srcIds->GetNumberOfIds() != numIds)
+    {
+    vtkWarningMacro("Input and output id array sizes do not match.");
+    return;
+    }
+  for (vtkIdType k = 0; k < numIds; ++k)
+    {
+    this->InsertTuple(dstIds->GetId(k), srcIds->GetId(k), source);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::InsertTuples(vtkIdType dstStart, vtkIdType n, vtkIdType srcStart,
+               vtkAbstractArray *source)
+{
+  if (n > 0 && this->EnsureCapacity(dstStart + n))
+    {
+    for (vtkIdType k = 0; k < n; ++k)
+      {
+      this->InsertTuple(dstStart + k, srcStart + k, source);
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStridedDataArrayTemplate<Scalar>
+::InsertNextTuple(vtkIdType j, vtkAbstractArray *source)
+{
+  const vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, j, source);
+  return i;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStridedDataArrayTemplate<Scalar>
+::InsertNextTuple(const float *source)
+{
+  const vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, source);
+  return i;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStridedDataArrayTemplate<Scalar>
+::InsertNextTuple(const double *source)
+{
+  const vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, source);
+  return i;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStridedDataArrayTemplate<Scalar>
+::InsertNextTupleValue(const Scalar *tuple)
+{
+  const vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTupleValue(i, tuple);
+  return i;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::InsertValue(vtkIdType idx, Scalar v)
+{
+  if (this->EnsureCapacity(idx / this->NumberOfComponents + 1))
+    {
+    this->GetValueReference(idx) = v;
+    this->MaxId = std::max(this->MaxId, idx);
+    }
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> vtkIdType vtkStridedDataArrayTemplate<Scalar>
+::InsertNextValue(Scalar v)
+{
+  this->InsertValue(this->MaxId + 1, v);
+  return this->MaxId;
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::RemoveTuple(vtkIdType id)
+{
+  const vtkIdType numTuples = this->GetNumberOfTuples();
+  if (id < 0 || id >= numTuples)
+    {
+    return;
+    }
+  const int numComps = this->NumberOfComponents;
+  for (vtkIdType tuple = id; tuple < numTuples - 1; ++tuple)
+    {
+    Scalar *to = this->Data + tuple * this->Stride;
+    std::copy(to + this->Stride, to + this->Stride + numComps, to);
+    }
+  this->MaxId -= this->NumberOfComponents;
+  // Not DataChanged(): that copies the values of GetVoidPointer() back.
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::RemoveFirstTuple()
+{
+  this->RemoveTuple(0);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::RemoveLastTuple()
+{
+  this->RemoveTuple(this->GetNumberOfTuples() - 1);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::DeepCopy(vtkAbstractArray *aa)
+{
+  this->vtkDataArray::DeepCopy(aa);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::DeepCopy(vtkDataArray *da)
+{
+  this->vtkDataArray::DeepCopy(da);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::InterpolateTuple(vtkIdType i, vtkIdList *ptIndices, vtkAbstractArray *source,
+                   double *weights)
+{
+  vtkDataArray *from = vtkDataArray::FastDownCast(source);
+  if (!from || from->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+    vtkErrorMacro("Cannot interpolate from " << source->GetClassName());
+    return;
+    }
+  if (!this->EnsureCapacity(i + 1))
+    {
+    return;
+    }
+
+  const vtkIdType numIds = ptIndices->GetNumberOfIds();
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    double c = 0.0;
+    for (vtkIdType k = 0; k < numIds; ++k)
+      {
+      c += weights[k] * from->GetComponent(ptIndices->GetId(k), comp);
+      }
+    if (std::numeric_limits<Scalar>::is_integer)
+      {
+      c = (c >= 0.0) ? c + 0.5 : c - 0.5;
+      }
+    this->Data[i * this->Stride + comp] = static_cast<Scalar>(c);
+    }
+  this->MaxId = std::max(this->MaxId, (i + 1) * this->NumberOfComponents - 1);
+}
+
+//------------------------------------------------------------------------------
+template <class Scalar> void vtkStridedDataArrayTemplate<Scalar>
+::InterpolateTuple(vtkIdType i, vtkIdType id1, vtkAbstractArray *source1,
+                   vtkIdType id2, vtkAbstractArray *source2, double t)
+{
+  vtkDataArray *from1 = vtkDataArray::FastDownCast(source1);
+  vtkDataArray *from2 = vtkDataArray::FastDownCast(source2);
+  if (!from1 || !from2 ||
+      from1->GetNumberOfComponents() != this->NumberOfComponents ||
+      from2->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+    vtkErrorMacro("Cannot interpolate from the given arrays.");
+    return;
+    }
+  if (!this->EnsureCapacity(i + 1))
+    {
+    return;
+    }
+
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+    const double c1 = from1->GetComponent(id1, comp);
+    const double c2 = from2->GetComponent(id2, comp);
+    this->Data[i * this->Stride + comp] = static_cast<Scalar>(c1 + t * (c2 - c1));
+    }
+  this->MaxId = std::max(this->MaxId, (i + 1) * this->NumberOfComponents - 1);
+}
+
+#endif //vtkStridedDataArrayTemplate_txx
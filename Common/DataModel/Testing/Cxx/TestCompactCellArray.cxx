@@ -0,0 +1,262 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompactCellArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkCompactCellArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkTypeInt32Array.h"
+
+namespace
+{
+
+// Cell i has (i % 5) + 1 points: i, i + 1, ...
+void FillLegacy(vtkCellArray *cells, vtkIdType numCells)
+{
+  for (vtkIdType i = 0; i < numCells; i++)
+    {
+    vtkIdType npts = (i % 5) + 1;
+    cells->InsertNextCell(static_cast<int>(npts));
+    for (vtkIdType j = 0; j < npts; j++)
+      {
+      cells->InsertCellPoint(i + j);
+      }
+    }
+}
+
+// Check every cell from several threads at once.
+class CheckCells
+{
+public:
+  vtkCompactCellArray *Cells;
+  vtkSMPThreadLocal<int> Errors;
+  vtkSMPThreadLocal<vtkIdList*> Ids;
+
+  CheckCells(vtkCompactCellArray *cells) : Cells(cells), Errors(0), Ids(NULL)
+  {
+  }
+
+  ~CheckCells()
+  {
+    vtkSMPThreadLocal<vtkIdList*>::iterator itr = this->Ids.begin();
+    for (; itr != this->Ids.end(); ++itr)
+      {
+      if (*itr)
+        {
+        (*itr)->Delete();
+        }
+      }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *&ids = this->Ids.Local();
+    if (!ids)
+      {
+      ids = vtkIdList::New();
+      }
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      vtkIdType npts;
+      const vtkIdType *pts;
+      this->Cells->GetCellAtId(i, npts, pts, ids);
+      if (npts != (i % 5) + 1 || this->Cells->GetCellSize(i) != npts)
+        {
+        this->Errors.Local()++;
+        continue;
+        }
+      for (vtkIdType j = 0; j < npts; j++)
+        {
+        if (pts[j] != i + j)
+          {
+          this->Errors.Local()++;
+          }
+        }
+      }
+  }
+
+  int GetNumberOfErrors()
+  {
+    int total = 0;
+    vtkSMPThreadLocal<int>::iterator itr = this->Errors.begin();
+    for (; itr != this->Errors.end(); ++itr)
+      {
+      total += *itr;
+      }
+    return total;
+  }
+};
+
+int CheckCompactCells(vtkCompactCellArray *cells, vtkIdType numCells,
+                      const char *what)
+{
+  if (cells->GetNumberOfCells() != numCells || cells->GetMaxCellSize() != 5)
+    {
+    cerr << what << ": wrong number of cells " << cells->GetNumberOfCells()
+         << " or maximum cell size " << cells->GetMaxCellSize() << endl;
+    return 1;
+    }
+  CheckCells checker(cells);
+  vtkSMPTools::For(0, numCells, checker);
+  if (checker.GetNumberOfErrors())
+    {
+    cerr << what << ": " << checker.GetNumberOfErrors()
+         << " wrong point ids" << endl;
+    return 1;
+    }
+  return 0;
+}
+
+}
+
+int TestCompactCellArray(int, char*[])
+{
+  const vtkIdType numCells = 10000;
+
+  vtkNew<vtkCellArray> legacy;
+  FillLegacy(legacy.GetPointer(), numCells);
+
+  vtkNew<vtkCompactCellArray> cells;
+  cells->ImportLegacyFormat(legacy.GetPointer());
+  if (CheckCompactCells(cells.GetPointer(), numCells, "Import"))
+    {
+    return 1;
+    }
+
+  // The offsets are the locations of the cells, followed by the size.
+  vtkDataArray *offsets = cells->GetOffsetsArray();
+  if (offsets->GetNumberOfTuples() != numCells + 1 ||
+      offsets->GetComponent(0, 0) != 0 ||
+      offsets->GetComponent(numCells, 0) !=
+      cells->GetNumberOfConnectivityIds() ||
+      cells->GetNumberOfConnectivityIds() !=
+      legacy->GetNumberOfConnectivityEntries() - numCells)
+    {
+    cerr << "Wrong offsets" << endl;
+    return 1;
+    }
+
+#ifdef VTK_USE_64BIT_IDS
+  // The ids fit: the import picked the narrow storage.
+  if (!cells->IsStorage32Bit())
+    {
+    cerr << "ImportLegacyFormat did not use 32-bit storage" << endl;
+    return 1;
+    }
+#endif
+  cells->ConvertToIdTypeStorage();
+  if (cells->IsStorage32Bit() ||
+      CheckCompactCells(cells.GetPointer(), numCells, "vtkIdType storage"))
+    {
+    cerr << "Could not convert to vtkIdType storage" << endl;
+    return 1;
+    }
+
+  if (!cells->CanConvertTo32BitStorage() || !cells->ConvertTo32BitStorage())
+    {
+    cerr << "Could not convert to 32-bit storage" << endl;
+    return 1;
+    }
+  if (CheckCompactCells(cells.GetPointer(), numCells, "32-bit storage"))
+    {
+    return 1;
+    }
+
+#ifdef VTK_USE_64BIT_IDS
+  // The 32-bit storage takes half the memory of the vtkIdType storage, and
+  // at most half the memory of the legacy array, which also stores the
+  // number of points of each cell.
+  vtkNew<vtkCompactCellArray> wide;
+  wide->ImportLegacyFormat(legacy.GetPointer());
+  wide->ConvertToIdTypeStorage();
+  unsigned long narrowSize = cells->GetActualMemorySize();
+  unsigned long wideSize = wide->GetActualMemorySize();
+  unsigned long legacySize = legacy->GetActualMemorySize();
+  if (2 * narrowSize > wideSize + 2 || 2 * narrowSize > legacySize + 2)
+    {
+    cerr << "32-bit storage takes " << narrowSize << " KiB, vtkIdType storage "
+         << wideSize << " KiB, legacy array " << legacySize << " KiB" << endl;
+    return 1;
+    }
+#endif
+
+  vtkNew<vtkCellArray> exported;
+  cells->ExportLegacyFormat(exported.GetPointer());
+  if (exported->GetNumberOfCells() != numCells ||
+      exported->GetNumberOfConnectivityEntries() !=
+      legacy->GetNumberOfConnectivityEntries())
+    {
+    cerr << "Wrong export" << endl;
+    return 1;
+    }
+  for (vtkIdType i = 0; i < legacy->GetNumberOfConnectivityEntries(); i++)
+    {
+    if (exported->GetPointer()[i] != legacy->GetPointer()[i])
+      {
+      cerr << "Wrong export at " << i << endl;
+      return 1;
+      }
+    }
+
+  // SetData() references the arrays.
+  vtkNew<vtkCompactCellArray> shared;
+  if (!shared->SetData(cells->GetOffsetsArray(),
+                       cells->GetConnectivityArray()) ||
+      shared->GetConnectivityArray() != cells->GetConnectivityArray())
+    {
+    cerr << "SetData did not reference the arrays" << endl;
+    return 1;
+    }
+  vtkNew<vtkIdTypeArray> wrongType;
+  wrongType->InsertNextValue(0);
+  if (shared->SetData(wrongType.GetPointer(), cells->GetConnectivityArray()))
+    {
+    cerr << "SetData accepted arrays of different types" << endl;
+    return 1;
+    }
+
+  vtkNew<vtkCompactCellArray> copy;
+  copy->DeepCopy(cells.GetPointer());
+  if (CheckCompactCells(copy.GetPointer(), numCells, "DeepCopy"))
+    {
+    return 1;
+    }
+
+  // Inserting ids that do not fit widens the storage.
+  vtkIdType next = numCells;
+  copy->InsertNextCell(1, &next);
+  if (CheckCompactCells(copy.GetPointer(), numCells + 1, "Insert"))
+    {
+    return 1;
+    }
+#ifdef VTK_USE_64BIT_IDS
+  vtkIdType big = static_cast<vtkIdType>(VTK_INT_MAX) + 1;
+  copy->InsertNextCell(1, &big);
+  vtkIdList *ids = vtkIdList::New();
+  copy->GetCellAtId(numCells + 1, ids);
+  if (copy->IsStorage32Bit() || ids->GetNumberOfIds() != 1 ||
+      ids->GetId(0) != big)
+    {
+    cerr << "The storage was not widened" << endl;
+    ids->Delete();
+    return 1;
+    }
+  ids->Delete();
+#endif
+
+  return 0;
+}
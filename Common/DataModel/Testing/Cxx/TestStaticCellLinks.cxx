@@ -0,0 +1,178 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticCellLinks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkCompactCellArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLinks.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+
+namespace
+{
+
+// Compare the static links with the cells reported by the dataset.
+int CompareLinks(vtkDataSet *data, vtkStaticCellLinks *links,
+                 const char *what)
+{
+  if (links->GetNumberOfPoints() != data->GetNumberOfPoints())
+    {
+    cerr << what << ": wrong number of points" << endl;
+    return 1;
+    }
+  vtkNew<vtkIdList> cellIds;
+  for (vtkIdType ptId = 0; ptId < data->GetNumberOfPoints(); ptId++)
+    {
+    data->GetPointCells(ptId, cellIds.GetPointer());
+    if (links->GetNcells(ptId) != cellIds->GetNumberOfIds())
+      {
+      cerr << what << ": point " << ptId << " has " << links->GetNcells(ptId)
+           << " cells instead of " << cellIds->GetNumberOfIds() << endl;
+      return 1;
+      }
+    // The static links are sorted by increasing cell id.
+    vtkIdType *expected = cellIds->GetPointer(0);
+    std::sort(expected, expected + cellIds->GetNumberOfIds());
+    const vtkIdType *cells = links->GetCells(ptId);
+    for (vtkIdType i = 0; i < cellIds->GetNumberOfIds(); i++)
+      {
+      if (cells[i] != expected[i])
+        {
+        cerr << what << ": wrong cell for point " << ptId << endl;
+        return 1;
+        }
+      }
+    }
+  return 0;
+}
+
+}
+
+int TestStaticCellLinks(int, char*[])
+{
+  // A strip of quads and triangles on a grid of points.
+  const int dim = 60;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < dim; j++)
+    {
+    for (int i = 0; i < dim; i++)
+      {
+      points->InsertNextPoint(i, j, 0.0);
+      }
+    }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < dim - 1; j++)
+    {
+    for (int i = 0; i < dim - 1; i++)
+      {
+      vtkIdType p0 = j * dim + i;
+      if ((i + j) % 2)
+        {
+        vtkIdType quad[4] = { p0, p0 + 1, p0 + dim + 1, p0 + dim };
+        polys->InsertNextCell(4, quad);
+        }
+      else
+        {
+        vtkIdType tri1[3] = { p0, p0 + 1, p0 + dim + 1 };
+        vtkIdType tri2[3] = { p0, p0 + dim + 1, p0 + dim };
+        polys->InsertNextCell(3, tri1);
+        polys->InsertNextCell(3, tri2);
+        }
+      }
+    }
+
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points.GetPointer());
+  polyData->SetPolys(polys.GetPointer());
+
+  vtkNew<vtkStaticCellLinks> links;
+  links->BuildLinks(polyData.GetPointer());
+  polyData->BuildLinks();
+  if (CompareLinks(polyData.GetPointer(), links.GetPointer(), "vtkPolyData"))
+    {
+    return 1;
+    }
+
+  // Edge neighbors match the ones found through vtkCellLinks.
+  vtkNew<vtkIdList> expected;
+  vtkNew<vtkIdList> neighbors;
+  for (vtkIdType cellId = 0; cellId < polyData->GetNumberOfCells(); cellId++)
+    {
+    vtkIdType npts, *pts;
+    polyData->GetCellPoints(cellId, npts, pts);
+    for (vtkIdType i = 0; i < npts; i++)
+      {
+      vtkIdType p1 = pts[i];
+      vtkIdType p2 = pts[(i + 1) % npts];
+      polyData->GetCellEdgeNeighbors(cellId, p1, p2, expected.GetPointer());
+      links->GetCellEdgeNeighbors(cellId, p1, p2, neighbors.GetPointer());
+      if (neighbors->GetNumberOfIds() != expected->GetNumberOfIds() ||
+          (expected->GetNumberOfIds() &&
+           neighbors->GetId(0) != expected->GetId(0)))
+        {
+        cerr << "Wrong edge neighbors for cell " << cellId << endl;
+        return 1;
+        }
+      }
+    }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points.GetPointer());
+  grid->Allocate(polys->GetNumberOfCells());
+  vtkIdType npts, *pts;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); )
+    {
+    grid->InsertNextCell(npts == 3 ? VTK_TRIANGLE : VTK_QUAD, npts, pts);
+    }
+  links->BuildLinks(grid.GetPointer());
+  grid->BuildLinks();
+  if (CompareLinks(grid.GetPointer(), links.GetPointer(),
+                   "vtkUnstructuredGrid"))
+    {
+    return 1;
+    }
+
+  // Datasets without explicit connectivity.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(20, 15, 10);
+  links->BuildLinks(image.GetPointer());
+  if (CompareLinks(image.GetPointer(), links.GetPointer(), "vtkImageData"))
+    {
+    return 1;
+    }
+
+  vtkNew<vtkCompactCellArray> compact;
+  compact->ImportLegacyFormat(polys.GetPointer());
+  links->BuildLinks(points->GetNumberOfPoints(), compact.GetPointer());
+  if (CompareLinks(polyData.GetPointer(), links.GetPointer(),
+                   "vtkCompactCellArray"))
+    {
+    return 1;
+    }
+
+  links->Initialize();
+  if (links->GetNumberOfPoints() != 0)
+    {
+    cerr << "Initialize did not release the links" << endl;
+    return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,335 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkCellLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+const int NumberOfQueries = 500;
+
+// Find the cells containing the query points from several threads at once.
+// The cell found must contain the point, and a cell must be found if and
+// only if vtkCellLocator finds one.
+class CheckFindCell
+{
+public:
+  vtkDataSet *Data;
+  vtkStaticCellLocator *Locator;
+  const double *Queries;
+  const vtkIdType *Expected;
+  vtkSMPThreadLocal<int> Errors;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  CheckFindCell(vtkDataSet *data, vtkStaticCellLocator *locator,
+                const double *queries, const vtkIdType *expected)
+    : Data(data), Locator(locator), Queries(queries), Expected(expected),
+      Errors(0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell *cell = this->Cell.Local();
+    int& errors = this->Errors.Local();
+    double pcoords[3], weights[8], closest[3], dist2;
+    int subId;
+    for (vtkIdType q = begin; q < end; q++)
+      {
+      double x[3] = {this->Queries[3*q], this->Queries[3*q+1],
+                     this->Queries[3*q+2]};
+      vtkIdType cellId =
+        this->Locator->FindCell(x, 0.0, cell, pcoords, weights);
+      if ((cellId < 0) != (this->Expected[q] < 0))
+        {
+        errors++;
+        }
+      else if (cellId >= 0 &&
+               cell->EvaluatePosition(x, closest, subId, pcoords, dist2,
+                                      weights) != 1)
+        {
+        errors++;
+        }
+      }
+  }
+
+  int GetNumberOfErrors()
+  {
+    int total = 0;
+    vtkSMPThreadLocal<int>::iterator itr = this->Errors.begin();
+    for (; itr != this->Errors.end(); ++itr)
+      {
+      total += *itr;
+      }
+    return total;
+  }
+};
+
+// Intersect lines with a surface from several threads at once and compare
+// the parametric coordinate of the hit with vtkCellLocator's.
+class CheckIntersect
+{
+public:
+  vtkStaticCellLocator *Locator;
+  const double *Lines;
+  const double *Expected;
+  vtkSMPThreadLocal<int> Errors;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  CheckIntersect(vtkStaticCellLocator *locator, const double *lines,
+                 const double *expected)
+    : Locator(locator), Lines(lines), Expected(expected), Errors(0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell *cell = this->Cell.Local();
+    int& errors = this->Errors.Local();
+    double t, x[3], pcoords[3];
+    int subId;
+    vtkIdType cellId;
+    for (vtkIdType q = begin; q < end; q++)
+      {
+      double p1[3] = {this->Lines[6*q], this->Lines[6*q+1],
+                      this->Lines[6*q+2]};
+      double p2[3] = {this->Lines[6*q+3], this->Lines[6*q+4],
+                      this->Lines[6*q+5]};
+      int hit = this->Locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords,
+                                                 subId, cellId, cell);
+      if (hit != (this->Expected[q] >= 0.0) ||
+          (hit && (fabs(t - this->Expected[q]) > 1.0e-6 || cellId < 0)))
+        {
+        errors++;
+        }
+      }
+  }
+
+  int GetNumberOfErrors()
+  {
+    int total = 0;
+    vtkSMPThreadLocal<int>::iterator itr = this->Errors.begin();
+    for (; itr != this->Errors.end(); ++itr)
+      {
+      total += *itr;
+      }
+    return total;
+  }
+};
+
+// A grid of n^3 jittered points split into 6 tetrahedra per hexahedron.
+void MakeTetrahedra(int n, vtkUnstructuredGrid *grid)
+{
+  vtkNew<vtkPoints> points;
+  double h = 1.0 / (n - 1);
+  for (int k = 0; k < n; k++)
+    {
+    for (int j = 0; j < n; j++)
+      {
+      for (int i = 0; i < n; i++)
+        {
+        points->InsertNextPoint(i*h + vtkMath::Random(-0.1, 0.1)*h,
+                                j*h + vtkMath::Random(-0.1, 0.1)*h,
+                                k*h + vtkMath::Random(-0.1, 0.1)*h);
+        }
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+
+  // The 6 paths from corner 0 to corner 7 of the hexahedron.
+  const int axes[6][3] = {{1,2,4},{1,4,2},{2,1,4},{2,4,1},{4,1,2},{4,2,1}};
+  grid->Allocate(6 * (n-1) * (n-1) * (n-1));
+  for (int k = 0; k < n - 1; k++)
+    {
+    for (int j = 0; j < n - 1; j++)
+      {
+      for (int i = 0; i < n - 1; i++)
+        {
+        vtkIdType corners[8];
+        for (int c = 0; c < 8; c++)
+          {
+          corners[c] = (i + (c & 1)) + n * ((j + ((c >> 1) & 1)) +
+                                            n * (k + ((c >> 2) & 1)));
+          }
+        for (int t = 0; t < 6; t++)
+          {
+          int c1 = axes[t][0], c2 = c1 + axes[t][1];
+          vtkIdType tet[4] = {corners[0], corners[c1], corners[c2],
+                              corners[7]};
+          grid->InsertNextCell(VTK_TETRA, 4, tet);
+          }
+        }
+      }
+    }
+}
+
+// A height field z = 0.5 + 0.1 sin(..) triangulated on an n x n grid.
+void MakeSurface(int n, vtkPolyData *surface)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> triangles;
+  double h = 1.0 / (n - 1);
+  for (int j = 0; j < n; j++)
+    {
+    for (int i = 0; i < n; i++)
+      {
+      points->InsertNextPoint(i*h, j*h,
+                              0.5 + 0.1*sin(6.0*i*h) * cos(4.0*j*h));
+      }
+    }
+  for (int j = 0; j < n - 1; j++)
+    {
+    for (int i = 0; i < n - 1; i++)
+      {
+      vtkIdType p0 = i + j*n;
+      vtkIdType tri1[3] = {p0, p0 + 1, p0 + n + 1};
+      vtkIdType tri2[3] = {p0, p0 + n + 1, p0 + n};
+      triangles->InsertNextCell(3, tri1);
+      triangles->InsertNextCell(3, tri2);
+      }
+    }
+  surface->SetPoints(points.GetPointer());
+  surface->SetPolys(triangles.GetPointer());
+}
+
+}
+
+int TestStaticCellLocator(int, char*[])
+{
+  vtkMath::RandomSeed(8775070);
+
+  //
+  // FindCell in a volume mesh.
+  //
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeTetrahedra(12, grid.GetPointer());
+
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(grid.GetPointer());
+  locator->BuildLocator();
+
+  vtkNew<vtkCellLocator> reference;
+  reference->SetDataSet(grid.GetPointer());
+  reference->BuildLocator();
+
+  std::vector<double> queries(3 * NumberOfQueries);
+  std::vector<vtkIdType> expected(NumberOfQueries);
+  for (int q = 0; q < NumberOfQueries; q++)
+    {
+    for (int i = 0; i < 3; i++)
+      {
+      queries[3*q+i] = vtkMath::Random(-0.1, 1.1);
+      }
+    expected[q] = reference->FindCell(&queries[3*q]);
+    }
+
+  CheckFindCell findChecker(grid.GetPointer(), locator.GetPointer(),
+                            &queries[0], &expected[0]);
+  vtkSMPTools::For(0, NumberOfQueries, findChecker);
+  if (findChecker.GetNumberOfErrors())
+    {
+    cerr << findChecker.GetNumberOfErrors() << " wrong FindCell results"
+         << endl;
+    return 1;
+    }
+
+  // Every cell overlapping a box is returned, once.
+  double bbox[6] = {0.2, 0.35, 0.4, 0.5, 0.0, 0.3};
+  vtkNew<vtkIdList> cells;
+  locator->FindCellsWithinBounds(bbox, cells.GetPointer());
+  vtkIdType numOverlapping = 0;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); cellId++)
+    {
+    double bounds[6];
+    grid->GetCellBounds(cellId, bounds);
+    if (bounds[0] <= bbox[1] && bbox[0] <= bounds[1] &&
+        bounds[2] <= bbox[3] && bbox[2] <= bounds[3] &&
+        bounds[4] <= bbox[5] && bbox[4] <= bounds[5])
+      {
+      if (cells->IsId(cellId) < 0)
+        {
+        cerr << "FindCellsWithinBounds missed cell " << cellId << endl;
+        return 1;
+        }
+      numOverlapping++;
+      }
+    }
+  if (cells->GetNumberOfIds() != numOverlapping)
+    {
+    cerr << "FindCellsWithinBounds returned " << cells->GetNumberOfIds()
+         << " cells instead of " << numOverlapping << endl;
+    return 1;
+    }
+
+  //
+  // IntersectWithLine with a surface.
+  //
+  vtkNew<vtkPolyData> surface;
+  MakeSurface(40, surface.GetPointer());
+  locator->SetDataSet(surface.GetPointer());
+  locator->BuildLocator();
+  reference->SetDataSet(surface.GetPointer());
+  reference->BuildLocator();
+
+  std::vector<double> lines(6 * NumberOfQueries);
+  std::vector<double> hits(NumberOfQueries);
+  for (int q = 0; q < NumberOfQueries; q++)
+    {
+    double *p1 = &lines[6*q];
+    double *p2 = &lines[6*q+3];
+    p1[0] = vtkMath::Random(-0.2, 1.2);
+    p1[1] = vtkMath::Random(-0.2, 1.2);
+    p1[2] = 0.0;
+    p2[0] = vtkMath::Random(-0.2, 1.2);
+    p2[1] = vtkMath::Random(-0.2, 1.2);
+    p2[2] = 1.0;
+    double t, x[3], pcoords[3];
+    int subId;
+    hits[q] = -1.0;
+    if (reference->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId))
+      {
+      hits[q] = t;
+      }
+    }
+
+  CheckIntersect lineChecker(locator.GetPointer(), &lines[0], &hits[0]);
+  vtkSMPTools::For(0, NumberOfQueries, lineChecker);
+  if (lineChecker.GetNumberOfErrors())
+    {
+    cerr << lineChecker.GetNumberOfErrors()
+         << " wrong IntersectWithLine results" << endl;
+    return 1;
+    }
+
+  vtkNew<vtkPolyData> representation;
+  locator->GenerateRepresentation(0, representation.GetPointer());
+  if (representation->GetNumberOfCells() == 0)
+    {
+    cerr << "Empty representation" << endl;
+    return 1;
+    }
+
+  return 0;
+}
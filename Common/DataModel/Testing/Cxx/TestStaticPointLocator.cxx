@@ -0,0 +1,203 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticPointLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+const int NumberOfQueries = 200;
+const int NumberOfClosest = 10;
+const double Radius = 0.1;
+
+// Answer the queries by brute force and compare with the locator, from
+// several threads at once.
+class CheckQueries
+{
+public:
+  vtkPolyData *Data;
+  vtkStaticPointLocator *Locator;
+  const double *Queries;
+  vtkSMPThreadLocal<int> Errors;
+  vtkSMPThreadLocalObject<vtkIdList> Result;
+
+  CheckQueries(vtkPolyData *data, vtkStaticPointLocator *locator,
+               const double *queries)
+    : Data(data), Locator(locator), Queries(queries), Errors(0) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *result = this->Result.Local();
+    int& errors = this->Errors.Local();
+    vtkIdType numPts = this->Data->GetNumberOfPoints();
+    std::vector<double> dist2(numPts);
+    double pt[3];
+    for (vtkIdType q = begin; q < end; q++)
+      {
+      const double *x = this->Queries + 3*q;
+      vtkIdType numInRadius = 0;
+      for (vtkIdType i = 0; i < numPts; i++)
+        {
+        this->Data->GetPoint(i, pt);
+        dist2[i] = vtkMath::Distance2BetweenPoints(x, pt);
+        numInRadius += (dist2[i] <= Radius * Radius);
+        }
+      std::vector<double> sorted(dist2);
+      std::sort(sorted.begin(), sorted.end());
+
+      vtkIdType closest = this->Locator->FindClosestPoint(x);
+      if (closest < 0 || dist2[closest] != sorted[0])
+        {
+        errors++;
+        }
+
+      this->Locator->FindClosestNPoints(NumberOfClosest, x, result);
+      if (result->GetNumberOfIds() != NumberOfClosest)
+        {
+        errors++;
+        continue;
+        }
+      for (int i = 0; i < NumberOfClosest; i++)
+        {
+        if (dist2[result->GetId(i)] != sorted[i])
+          {
+          errors++;
+          }
+        }
+
+      this->Locator->FindPointsWithinRadius(Radius, x, result);
+      if (result->GetNumberOfIds() != numInRadius)
+        {
+        errors++;
+        }
+      for (vtkIdType i = 0; i < result->GetNumberOfIds(); i++)
+        {
+        if (dist2[result->GetId(i)] > Radius * Radius)
+          {
+          errors++;
+          }
+        }
+
+      double d2;
+      closest = this->Locator->FindClosestPointWithinRadius(Radius, x, d2);
+      if (numInRadius ? (closest < 0 || d2 != sorted[0]) : closest != -1)
+        {
+        errors++;
+        }
+      }
+  }
+
+  int GetNumberOfErrors()
+  {
+    int total = 0;
+    vtkSMPThreadLocal<int>::iterator itr = this->Errors.begin();
+    for (; itr != this->Errors.end(); ++itr)
+      {
+      total += *itr;
+      }
+    return total;
+  }
+};
+
+int CheckLocator(vtkPolyData *data, const char *what)
+{
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(data);
+  locator->BuildLocator();
+
+  // Every point is in exactly one bucket.
+  vtkIdType total = 0;
+  for (vtkIdType b = 0; b < locator->GetNumberOfBuckets(); b++)
+    {
+    total += locator->GetNumberOfPointsInBucket(b);
+    }
+  if (total != data->GetNumberOfPoints())
+    {
+    cerr << what << ": the buckets hold " << total << " points" << endl;
+    return 1;
+    }
+
+  // Queries inside and around the bounds.
+  std::vector<double> queries(3 * NumberOfQueries);
+  for (int i = 0; i < 3 * NumberOfQueries; i++)
+    {
+    queries[i] = vtkMath::Random(-0.2, 1.2);
+    }
+
+  CheckQueries checker(data, locator.GetPointer(), &queries[0]);
+  vtkSMPTools::For(0, NumberOfQueries, checker);
+  if (checker.GetNumberOfErrors())
+    {
+    cerr << what << ": " << checker.GetNumberOfErrors()
+         << " wrong query results" << endl;
+    return 1;
+    }
+
+  vtkNew<vtkPolyData> representation;
+  locator->GenerateRepresentation(0, representation.GetPointer());
+  if (representation->GetNumberOfCells() == 0)
+    {
+    cerr << what << ": empty representation" << endl;
+    return 1;
+    }
+  return 0;
+}
+
+}
+
+int TestStaticPointLocator(int, char*[])
+{
+  vtkMath::RandomSeed(314159);
+  const int numPts = 5000;
+
+  // Points in a cube.
+  vtkNew<vtkPoints> volumePoints;
+  for (int i = 0; i < numPts; i++)
+    {
+    volumePoints->InsertNextPoint(vtkMath::Random(), vtkMath::Random(),
+                                  vtkMath::Random());
+    }
+  vtkNew<vtkPolyData> volume;
+  volume->SetPoints(volumePoints.GetPointer());
+  if (CheckLocator(volume.GetPointer(), "Volume"))
+    {
+    return 1;
+    }
+
+  // Points in a plane, which gets a single division across.
+  vtkNew<vtkPoints> planePoints;
+  for (int i = 0; i < numPts; i++)
+    {
+    planePoints->InsertNextPoint(vtkMath::Random(), vtkMath::Random(), 0.5);
+    }
+  vtkNew<vtkPolyData> plane;
+  plane->SetPoints(planePoints.GetPointer());
+  if (CheckLocator(plane.GetPointer(), "Plane"))
+    {
+    return 1;
+    }
+
+  return 0;
+}
@@ -22,8 +22,10 @@
 #include "vtkCellTypes.h"
 #include "vtkCellType.h"
 
-void TestOCT()
+bool TestOCT()
 {
+  bool ok = true;
+
   // actual test
   vtkCellTypes *ct = vtkCellTypes::New();
   ct->Allocate();
@@ -66,15 +68,32 @@ void TestOCT()
   ct->Reset();
   ct->Squeeze();
 
+#ifdef VTK_USE_64BIT_IDS
+  // Locations are widened when they no longer fit in 32 bits.
+  ct->Allocate();
+  ct->InsertNextCell(VTK_TRIANGLE, 4);
+  vtkIdType farLocation = static_cast<vtkIdType>(VTK_INT_MAX) + 4;
+  ct->InsertNextCell(VTK_QUAD, farLocation);
+  ct1->DeepCopy(ct);
+  if (ct->IsStorage32Bit() || ct->GetCellLocation(0) != 4 ||
+      ct->GetCellLocation(1) != farLocation ||
+      ct1->GetCellLocation(1) != farLocation)
+    {
+    cerr << "vtkCellTypes did not widen its locations" << endl;
+    ok = false;
+    }
+#endif
+
   ct1->Delete();
   ct->Delete();
   cellLocations->Delete();
   cellTypes->Delete();
+  return ok;
 }
 
 int otherCellTypes(int, char *[])
 {
-  TestOCT();
+  bool fail0 = !TestOCT();
 
   // Might need to be ajusted if vtkCellTypes changes
   bool fail1 = (VTK_NUMBER_OF_CELL_TYPES <= VTK_HIGHER_ORDER_HEXAHEDRON);
@@ -82,5 +101,5 @@ int otherCellTypes(int, char *[])
   // vtkUnstructuredGrid uses uchar to store cellId
   bool fail2 = (VTK_NUMBER_OF_CELL_TYPES > 255);
 
-  return (fail1 || fail2);
+  return (fail0 || fail1 || fail2);
 }
@@ -56,6 +56,30 @@ int otherFieldData(int,char *[])
   fd2->ShallowCopy(fd);
   fd2->DeepCopy(fd);
 
+  // Shallow copies hold the same arrays, unless copy-on-write is requested:
+  // they then share the memory of the arrays until they are modified.
+  fd2->ShallowCopy(fd);
+  if (fd2->GetArray(2) != fd->GetArray(2))
+    {
+    return 1;
+    }
+  vtkFieldData* fd3 = vtkFieldData::New();
+  fd3->CopyOnWriteOn();
+  fd3->ShallowCopy(fd);
+  vtkFloatArray* original = vtkFloatArray::SafeDownCast(fd->GetArray(2));
+  vtkFloatArray* copied = vtkFloatArray::SafeDownCast(fd3->GetArray(2));
+  if (!copied || copied == original || !copied->HasSharedBuffer() ||
+      strcmp(copied->GetName(), "Array2") != 0)
+    {
+    return 1;
+    }
+  copied->SetTuple1(0, 1.0);
+  if (original->GetValue(0) != 0.0 || copied->GetValue(0) != 1.0)
+    {
+    return 1;
+    }
+  fd3->Delete();
+
   vtkIdList* ptIds = vtkIdList::New();
   ptIds->InsertNextId(0);
   ptIds->InsertNextId(2);
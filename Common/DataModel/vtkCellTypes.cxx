@@ -142,6 +142,7 @@ vtkCellTypes::vtkCellTypes ()
 
   this->TypeArray = NULL;
   this->LocationArray = NULL;
+  this->IdLocationArray = NULL;
   this->Size = 0;
   this->MaxId = -1;
   this->Extend = 1000;
@@ -165,6 +166,12 @@ vtkCellTypes::~vtkCellTypes()
     this->LocationArray = NULL;
     }
 
+  if ( this->IdLocationArray )
+    {
+    this->IdLocationArray->UnRegister(this);
+    this->IdLocationArray = NULL;
+    }
+
 }
 
 //----------------------------------------------------------------------------
@@ -194,17 +201,53 @@ int vtkCellTypes::Allocate(int sz, int ext)
   this->LocationArray->Register(this);
   this->LocationArray->Delete();
 
+  // Start again with 32-bit locations.
+  if ( this->IdLocationArray )
+    {
+    this->IdLocationArray->UnRegister(this);
+    this->IdLocationArray = NULL;
+    }
+
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Copy the 32-bit locations into a vtkIdTypeArray used from then on.
+void vtkCellTypes::WidenLocations()
+{
+  vtkDebugMacro(<<"Widening the cell locations to vtkIdType");
+  this->IdLocationArray = vtkIdTypeArray::New();
+  this->IdLocationArray->DeepCopy(this->LocationArray);
+  this->IdLocationArray->Register(this);
+  this->IdLocationArray->Delete();
+
+  this->LocationArray->UnRegister(this);
+  this->LocationArray = NULL;
+}
+
 //----------------------------------------------------------------------------
 // Add a cell at specified id.
-void vtkCellTypes::InsertCell(int cellId, unsigned char type, int loc)
+void vtkCellTypes::InsertCell(vtkIdType cellId, unsigned char type,
+                              vtkIdType loc)
 {
   vtkDebugMacro(<<"Insert Cell id: " << cellId << " at location " << loc);
   TypeArray->InsertValue(cellId, type);
 
-  LocationArray->InsertValue(cellId, loc);
+#ifdef VTK_USE_64BIT_IDS
+  if ( this->LocationArray && loc > VTK_INT_MAX )
+    {
+    this->WidenLocations();
+    }
+#endif
+
+  if ( this->LocationArray )
+    {
+    this->LocationArray->InsertValue(cellId, static_cast<int>(loc));
+    }
+  else
+    {
+    this->IdLocationArray->InsertValue(cellId, loc);
+    }
 
   if ( cellId > this->MaxId )
     {
@@ -215,7 +258,7 @@ void vtkCellTypes::InsertCell(int cellId, unsigned char type, int loc)
 
 //----------------------------------------------------------------------------
 // Add a cell to the object in the next available slot.
-vtkIdType vtkCellTypes::InsertNextCell(unsigned char type, int loc)
+vtkIdType vtkCellTypes::InsertNextCell(unsigned char type, vtkIdType loc)
 {
   vtkDebugMacro(<<"Insert Next Cell " << type << " location " << loc);
   this->InsertCell (++this->MaxId,type,loc);
@@ -242,17 +285,61 @@ void vtkCellTypes::SetCellTypes(int ncells, vtkUnsignedCharArray *cellTypes, vtk
     }
   this->LocationArray = cellLocations;
   cellLocations->Register(this);
+
+  if (this->IdLocationArray)
+    {
+    this->IdLocationArray->UnRegister(this);
+    this->IdLocationArray = NULL;
+    }
   this->Extend = 1;
   this->MaxId = -1;
 
 }
 
+//----------------------------------------------------------------------------
+// Specify a group of cell types with vtkIdType locations.
+void vtkCellTypes::SetCellTypes(vtkIdType ncells,
+                                vtkUnsignedCharArray *cellTypes,
+                                vtkIdTypeArray *cellLocations)
+{
+  this->Size = ncells;
+
+  cellTypes->Register(this);
+  if (this->TypeArray)
+    {
+    this->TypeArray->UnRegister(this);
+    }
+  this->TypeArray = cellTypes;
+
+  cellLocations->Register(this);
+  if (this->IdLocationArray)
+    {
+    this->IdLocationArray->UnRegister(this);
+    }
+  this->IdLocationArray = cellLocations;
+
+  if (this->LocationArray)
+    {
+    this->LocationArray->UnRegister(this);
+    this->LocationArray = NULL;
+    }
+  this->Extend = 1;
+  this->MaxId = -1;
+}
+
 //----------------------------------------------------------------------------
 // Reclaim any extra memory.
 void vtkCellTypes::Squeeze()
 {
   this->TypeArray->Squeeze();
-  this->LocationArray->Squeeze();
+  if ( this->LocationArray )
+    {
+    this->LocationArray->Squeeze();
+    }
+  else
+    {
+    this->IdLocationArray->Squeeze();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -277,6 +364,11 @@ unsigned long vtkCellTypes::GetActualMemorySize()
     size += this->LocationArray->GetActualMemorySize();
     }
 
+  if ( this->IdLocationArray )
+    {
+    size += this->IdLocationArray->GetActualMemorySize();
+    }
+
   return static_cast<unsigned long>(ceil(size/1024.0)); // kibibytes
 }
 
@@ -310,7 +402,22 @@ void vtkCellTypes::DeepCopy(vtkCellTypes *src)
       this->LocationArray->Delete();
     }
 
-  this->Allocate(src->Size, src->Extend);
+  if (this->IdLocationArray)
+    {
+      this->IdLocationArray->UnRegister(this);
+      this->IdLocationArray = NULL;
+    }
+  if (src->IdLocationArray)
+    {
+      this->IdLocationArray = vtkIdTypeArray::New();
+      this->IdLocationArray->DeepCopy(src->IdLocationArray);
+      this->IdLocationArray->Register(this);
+      this->IdLocationArray->Delete();
+    }
+
+  // Allocate() would discard the copied arrays.
+  this->Size = src->Size;
+  this->Extend = src->Extend;
   this->MaxId = src->MaxId;
 }
 
@@ -322,7 +429,14 @@ void vtkCellTypes::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "TypeArray:\n";
   this->TypeArray->PrintSelf(os,indent.GetNextIndent());
   os << indent << "LocationArray:\n";
-  this->LocationArray->PrintSelf(os,indent.GetNextIndent());
+  if ( this->LocationArray )
+    {
+    this->LocationArray->PrintSelf(os,indent.GetNextIndent());
+    }
+  else
+    {
+    this->IdLocationArray->PrintSelf(os,indent.GetNextIndent());
+    }
 
   os << indent << "Size: " << this->Size << "\n";
   os << indent << "MaxId: " << this->MaxId << "\n";
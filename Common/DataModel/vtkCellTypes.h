@@ -21,6 +21,10 @@
 // and inter-process communication. The type information is defined in the
 // file vtkCellType.h.
 //
+// The locations are stored as 32-bit integers. The storage is widened to
+// vtkIdType the first time a location that does not fit is inserted,
+// instead of truncating it.
+//
 // .SECTION Caveats
 // Sometimes this class is used to pass type information independent of the
 // random access (i.e., location) information. For example, see
@@ -36,6 +40,7 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 #include "vtkObject.h"
 
+#include "vtkIdTypeArray.h" // Needed for inline methods
 #include "vtkIntArray.h" // Needed for inline methods
 #include "vtkUnsignedCharArray.h" // Needed for inline methods
 #include "vtkCellType.h" // Needed for VTK_EMPTY_CELL
@@ -53,19 +58,25 @@ public:
 
   // Description:
   // Add a cell at specified id.
-  void InsertCell(int id, unsigned char type, int loc);
+  void InsertCell(vtkIdType id, unsigned char type, vtkIdType loc);
 
   // Description:
   // Add a cell to the object in the next available slot.
-  vtkIdType InsertNextCell(unsigned char type, int loc);
+  vtkIdType InsertNextCell(unsigned char type, vtkIdType loc);
 
   // Description:
   // Specify a group of cell types.
   void SetCellTypes(int ncells, vtkUnsignedCharArray *cellTypes, vtkIntArray *cellLocations);
+  void SetCellTypes(vtkIdType ncells, vtkUnsignedCharArray *cellTypes,
+                    vtkIdTypeArray *cellLocations);
 
   // Description:
   // Return the location of the cell in the associated vtkCellArray.
-  vtkIdType GetCellLocation(int cellId) { return this->LocationArray->GetValue(cellId);};
+  vtkIdType GetCellLocation(vtkIdType cellId)
+    {
+    return this->LocationArray ? this->LocationArray->GetValue(cellId) :
+      this->IdLocationArray->GetValue(cellId);
+    };
 
   // Description:
   // Delete cell by setting to NULL cell type.
@@ -104,6 +115,11 @@ public:
   // been updated.
   unsigned long GetActualMemorySize();
 
+  // Description:
+  // Return 1 if the locations are stored as 32-bit integers, 0 once they
+  // have been widened to vtkIdType.
+  int IsStorage32Bit() { return this->LocationArray != NULL; };
+
   // Description:
   // Standard DeepCopy method.  Since this object contains no reference
   // to other objects, there is no ShallowCopy.
@@ -132,10 +148,13 @@ protected:
 
   vtkUnsignedCharArray *TypeArray; // pointer to types array
   vtkIntArray *LocationArray;   // pointer to array of offsets
+  vtkIdTypeArray *IdLocationArray; // offsets once widened, NULL until then
   vtkIdType Size;            // allocated size of data
   vtkIdType MaxId;           // maximum index inserted thus far
   vtkIdType Extend;          // grow array by this point
 
+  void WidenLocations();
+
 private:
   vtkCellTypes(const vtkCellTypes&);  // Not implemented.
   void operator=(const vtkCellTypes&);    // Not implemented.
@@ -0,0 +1,584 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompactCellArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCompactCellArray.h"
+
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkTypeInt32Array.h"
+
+vtkStandardNewMacro(vtkCompactCellArray);
+
+namespace
+{
+// Largest offset or point id held by the 32-bit storage.
+const vtkIdType vtkCompactCellArrayMaxInt32 = VTK_INT_MAX;
+
+//----------------------------------------------------------------------------
+// Append the cells of a legacy (n,id1,...,idn, ...) list to the arrays,
+// which must be large enough.
+template <typename ValueType>
+void vtkCompactCellArrayImport(const vtkIdType *legacy, vtkIdType numCells,
+                               ValueType *offsets, ValueType *connectivity)
+{
+  ValueType offset = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    vtkIdType npts = *legacy++;
+    offsets[cellId] = offset;
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      *connectivity++ = static_cast<ValueType>(*legacy++);
+      }
+    offset += static_cast<ValueType>(npts);
+    }
+  offsets[numCells] = offset;
+}
+
+//----------------------------------------------------------------------------
+template <typename ValueType>
+void vtkCompactCellArrayExport(const ValueType *offsets,
+                               const ValueType *connectivity,
+                               vtkIdType numCells, vtkIdType *legacy)
+{
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    const ValueType *pts = connectivity + offsets[cellId];
+    const ValueType *end = connectivity + offsets[cellId + 1];
+    *legacy++ = static_cast<vtkIdType>(end - pts);
+    while (pts != end)
+      {
+      *legacy++ = static_cast<vtkIdType>(*pts++);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <typename ValueType>
+int vtkCompactCellArrayMaxCellSize(const ValueType *offsets,
+                                   vtkIdType numCells)
+{
+  ValueType maxSize = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+    if (offsets[cellId + 1] - offsets[cellId] > maxSize)
+      {
+      maxSize = offsets[cellId + 1] - offsets[cellId];
+      }
+    }
+  return static_cast<int>(maxSize);
+}
+
+//----------------------------------------------------------------------------
+// Copy the values of an array into another one of a different type.
+template <typename SourceArray, typename TargetArray, typename TargetValue>
+void vtkCompactCellArrayConvert(SourceArray *source, TargetArray *target,
+                                TargetValue *)
+{
+  vtkIdType size = source->GetNumberOfTuples();
+  target->SetNumberOfTuples(size);
+  TargetValue *out = target->GetPointer(0);
+  for (vtkIdType i = 0; i < size; ++i)
+    {
+    out[i] = static_cast<TargetValue>(source->GetValue(i));
+    }
+}
+}
+
+//----------------------------------------------------------------------------
+vtkCompactCellArray::vtkCompactCellArray()
+{
+  this->Storage32Bit = 0;
+  this->IdOffsets = NULL;
+  this->IdConnectivity = NULL;
+  this->Int32Offsets = NULL;
+  this->Int32Connectivity = NULL;
+  this->SetStorage(1);
+}
+
+//----------------------------------------------------------------------------
+vtkCompactCellArray::~vtkCompactCellArray()
+{
+  this->SetArrays(NULL, NULL);
+}
+
+//----------------------------------------------------------------------------
+// Replace the arrays in use, which must be of the same type (or NULL), and
+// set the storage type accordingly.
+void vtkCompactCellArray::SetArrays(vtkDataArray *offsets,
+                                    vtkDataArray *connectivity)
+{
+  if (offsets)
+    {
+    offsets->Register(this);
+    connectivity->Register(this);
+    }
+  if (this->IdOffsets)
+    {
+    this->IdOffsets->UnRegister(this);
+    this->IdConnectivity->UnRegister(this);
+    }
+  if (this->Int32Offsets)
+    {
+    this->Int32Offsets->UnRegister(this);
+    this->Int32Connectivity->UnRegister(this);
+    }
+  this->IdOffsets = vtkIdTypeArray::SafeDownCast(offsets);
+  this->IdConnectivity = vtkIdTypeArray::SafeDownCast(connectivity);
+  this->Int32Offsets = vtkTypeInt32Array::SafeDownCast(offsets);
+  this->Int32Connectivity = vtkTypeInt32Array::SafeDownCast(connectivity);
+  this->Storage32Bit = this->Int32Offsets ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+// Replace the arrays by empty ones of the requested storage. 32-bit storage
+// is only used when vtkIdType is wider.
+void vtkCompactCellArray::SetStorage(int use32Bit)
+{
+#ifdef VTK_USE_64BIT_IDS
+  if (use32Bit)
+    {
+    vtkTypeInt32Array *offsets = vtkTypeInt32Array::New();
+    vtkTypeInt32Array *connectivity = vtkTypeInt32Array::New();
+    offsets->InsertNextValue(0);
+    this->SetArrays(offsets, connectivity);
+    offsets->Delete();
+    connectivity->Delete();
+    return;
+    }
+#else
+  (void)use32Bit;
+#endif
+  vtkIdTypeArray *offsets = vtkIdTypeArray::New();
+  vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+  offsets->InsertNextValue(0);
+  this->SetArrays(offsets, connectivity);
+  offsets->Delete();
+  connectivity->Delete();
+}
+
+//----------------------------------------------------------------------------
+int vtkCompactCellArray::Allocate(vtkIdType numCells,
+                                  vtkIdType connectivitySize)
+{
+  this->Reset();
+  if (this->Storage32Bit)
+    {
+    return this->Int32Offsets->Allocate(numCells + 1) &&
+      this->Int32Connectivity->Allocate(connectivitySize);
+    }
+  return this->IdOffsets->Allocate(numCells + 1) &&
+    this->IdConnectivity->Allocate(connectivitySize);
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactCellArray::Initialize()
+{
+  this->SetStorage(1);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactCellArray::Reset()
+{
+  this->GetConnectivityArray()->Reset();
+  if (this->Storage32Bit)
+    {
+    this->Int32Offsets->Reset();
+    this->Int32Offsets->InsertNextValue(0);
+    }
+  else
+    {
+    this->IdOffsets->Reset();
+    this->IdOffsets->InsertNextValue(0);
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactCellArray::Squeeze()
+{
+  this->GetOffsetsArray()->Squeeze();
+  this->GetConnectivityArray()->Squeeze();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCompactCellArray::GetNumberOfCells()
+{
+  return this->GetOffsetsArray()->GetNumberOfTuples() - 1;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCompactCellArray::GetNumberOfConnectivityIds()
+{
+  return this->GetConnectivityArray()->GetNumberOfTuples();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCompactCellArray::GetCellSize(vtkIdType cellId)
+{
+  if (this->Storage32Bit)
+    {
+    return static_cast<vtkIdType>(this->Int32Offsets->GetValue(cellId + 1) -
+                                  this->Int32Offsets->GetValue(cellId));
+    }
+  return this->IdOffsets->GetValue(cellId + 1) -
+    this->IdOffsets->GetValue(cellId);
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactCellArray::GetCellAtId32(vtkIdType cellId, vtkIdType& npts,
+                                        const vtkIdType* &pts,
+                                        vtkIdList *ptIds)
+{
+  const vtkTypeInt32 *offsets = this->Int32Offsets->GetPointer(cellId);
+  const vtkTypeInt32 *ids = this->Int32Connectivity->GetPointer(offsets[0]);
+  npts = static_cast<vtkIdType>(offsets[1] - offsets[0]);
+  ptIds->SetNumberOfIds(npts);
+  vtkIdType *out = ptIds->GetPointer(0);
+  for (vtkIdType i = 0; i < npts; ++i)
+    {
+    out[i] = static_cast<vtkIdType>(ids[i]);
+    }
+  pts = out;
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactCellArray::GetCellAtId(vtkIdType cellId, vtkIdList *pts)
+{
+  vtkIdType npts;
+  const vtkIdType *ids;
+  this->GetCellAtId(cellId, npts, ids, pts);
+  if (ids != pts->GetPointer(0))
+    {
+    pts->SetNumberOfIds(npts);
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      pts->SetId(i, ids[i]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCompactCellArray::InsertNextCell(vtkIdType npts,
+                                              const vtkIdType* pts)
+{
+  vtkIdType cellId = this->GetNumberOfCells();
+  if (this->Storage32Bit)
+    {
+    // Widen the storage rather than truncating ids that do not fit.
+    vtkIdType size = this->Int32Connectivity->GetNumberOfTuples() + npts;
+    for (vtkIdType i = 0; i < npts && size <= vtkCompactCellArrayMaxInt32;
+         ++i)
+      {
+      if (pts[i] > vtkCompactCellArrayMaxInt32)
+        {
+        size = vtkCompactCellArrayMaxInt32 + 1;
+        }
+      }
+    if (size > vtkCompactCellArrayMaxInt32)
+      {
+      this->ConvertToIdTypeStorage();
+      }
+    }
+
+  if (this->Storage32Bit)
+    {
+    vtkIdType loc = this->Int32Connectivity->GetNumberOfTuples();
+    vtkTypeInt32 *ids = this->Int32Connectivity->WritePointer(loc, npts);
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      ids[i] = static_cast<vtkTypeInt32>(pts[i]);
+      }
+    this->Int32Offsets->InsertNextValue(static_cast<vtkTypeInt32>(loc + npts));
+    }
+  else
+    {
+    vtkIdType loc = this->IdConnectivity->GetNumberOfTuples();
+    vtkIdType *ids = this->IdConnectivity->WritePointer(loc, npts);
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      ids[i] = pts[i];
+      }
+    this->IdOffsets->InsertNextValue(loc + npts);
+    }
+  this->Modified();
+  return cellId;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCompactCellArray::InsertNextCell(vtkIdList *pts)
+{
+  return this->InsertNextCell(pts->GetNumberOfIds(), pts->GetPointer(0));
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCompactCellArray::InsertNextCell(vtkCell *cell)
+{
+  return this->InsertNextCell(cell->GetNumberOfPoints(),
+                              cell->PointIds->GetPointer(0));
+}
+
+//----------------------------------------------------------------------------
+int vtkCompactCellArray::GetMaxCellSize()
+{
+  vtkIdType numCells = this->GetNumberOfCells();
+  if (this->Storage32Bit)
+    {
+    return vtkCompactCellArrayMaxCellSize(
+      this->Int32Offsets->GetPointer(0), numCells);
+    }
+  return vtkCompactCellArrayMaxCellSize(this->IdOffsets->GetPointer(0),
+                                        numCells);
+}
+
+//----------------------------------------------------------------------------
+int vtkCompactCellArray::SetData(vtkDataArray *offsets,
+                                 vtkDataArray *connectivity)
+{
+  if (!offsets || !connectivity || offsets->GetNumberOfComponents() != 1 ||
+      connectivity->GetNumberOfComponents() != 1 ||
+      offsets->GetNumberOfTuples() < 1)
+    {
+    vtkErrorMacro("Offsets must have at least one value and both arrays "
+                  "a single component.");
+    return 0;
+    }
+
+  int idArrays = vtkIdTypeArray::SafeDownCast(offsets) &&
+    vtkIdTypeArray::SafeDownCast(connectivity);
+  int int32Arrays = vtkTypeInt32Array::SafeDownCast(offsets) &&
+    vtkTypeInt32Array::SafeDownCast(connectivity);
+  if (!idArrays && !int32Arrays)
+    {
+    vtkErrorMacro("Offsets and connectivity must both be vtkIdTypeArray or "
+                  "both be vtkTypeInt32Array.");
+    return 0;
+    }
+
+#ifdef VTK_USE_64BIT_IDS
+  this->SetArrays(offsets, connectivity);
+#else
+  if (int32Arrays)
+    {
+    // vtkIdType is 32-bit already: keep a single storage type.
+    vtkIdTypeArray *idOffsets = vtkIdTypeArray::New();
+    vtkIdTypeArray *idConnectivity = vtkIdTypeArray::New();
+    idOffsets->DeepCopy(offsets);
+    idConnectivity->DeepCopy(connectivity);
+    this->SetArrays(idOffsets, idConnectivity);
+    idOffsets->Delete();
+    idConnectivity->Delete();
+    }
+  else
+    {
+    this->SetArrays(offsets, connectivity);
+    }
+#endif
+  this->Modified();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray* vtkCompactCellArray::GetOffsetsArray()
+{
+  if (this->Storage32Bit)
+    {
+    return this->Int32Offsets;
+    }
+  return this->IdOffsets;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray* vtkCompactCellArray::GetConnectivityArray()
+{
+  if (this->Storage32Bit)
+    {
+    return this->Int32Connectivity;
+    }
+  return this->IdConnectivity;
+}
+
+//----------------------------------------------------------------------------
+int vtkCompactCellArray::CanConvertTo32BitStorage()
+{
+  if (this->Storage32Bit)
+    {
+    return 1;
+    }
+  // The offsets are bounded by the size of the connectivity array.
+  vtkIdType size = this->IdConnectivity->GetNumberOfTuples();
+  if (size > vtkCompactCellArrayMaxInt32)
+    {
+    return 0;
+    }
+  const vtkIdType *ids = this->IdConnectivity->GetPointer(0);
+  for (vtkIdType i = 0; i < size; ++i)
+    {
+    if (ids[i] > vtkCompactCellArrayMaxInt32)
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkCompactCellArray::ConvertTo32BitStorage()
+{
+#ifdef VTK_USE_64BIT_IDS
+  if (this->Storage32Bit)
+    {
+    return 1;
+    }
+  if (!this->CanConvertTo32BitStorage())
+    {
+    return 0;
+    }
+  vtkTypeInt32Array *offsets = vtkTypeInt32Array::New();
+  vtkTypeInt32Array *connectivity = vtkTypeInt32Array::New();
+  vtkCompactCellArrayConvert(this->IdOffsets, offsets,
+                             static_cast<vtkTypeInt32*>(NULL));
+  vtkCompactCellArrayConvert(this->IdConnectivity, connectivity,
+                             static_cast<vtkTypeInt32*>(NULL));
+  this->SetArrays(offsets, connectivity);
+  offsets->Delete();
+  connectivity->Delete();
+  this->Modified();
+#endif
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactCellArray::ConvertToIdTypeStorage()
+{
+  if (!this->Storage32Bit)
+    {
+    return;
+    }
+  vtkIdTypeArray *offsets = vtkIdTypeArray::New();
+  vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+  vtkCompactCellArrayConvert(this->Int32Offsets, offsets,
+                             static_cast<vtkIdType*>(NULL));
+  vtkCompactCellArrayConvert(this->Int32Connectivity, connectivity,
+                             static_cast<vtkIdType*>(NULL));
+  this->SetArrays(offsets, connectivity);
+  offsets->Delete();
+  connectivity->Delete();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactCellArray::ImportLegacyFormat(vtkCellArray *cells)
+{
+  vtkIdType numCells = cells->GetNumberOfCells();
+  vtkIdType numEntries = cells->GetNumberOfConnectivityEntries();
+  vtkIdType size = numEntries - numCells;
+  const vtkIdType *legacy = cells->GetPointer();
+
+  // Use the narrowest storage that holds these cells.
+  int fits = size <= vtkCompactCellArrayMaxInt32;
+  for (vtkIdType i = 0; fits && i < numEntries; ++i)
+    {
+    fits = legacy[i] <= vtkCompactCellArrayMaxInt32;
+    }
+  this->SetStorage(fits);
+
+  if (this->Storage32Bit)
+    {
+    vtkCompactCellArrayImport(legacy, numCells,
+      this->Int32Offsets->WritePointer(0, numCells + 1),
+      this->Int32Connectivity->WritePointer(0, size));
+    }
+  else
+    {
+    vtkCompactCellArrayImport(legacy, numCells,
+      this->IdOffsets->WritePointer(0, numCells + 1),
+      this->IdConnectivity->WritePointer(0, size));
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactCellArray::ExportLegacyFormat(vtkCellArray *cells)
+{
+  vtkIdType numCells = this->GetNumberOfCells();
+  vtkIdType *legacy = cells->WritePointer(numCells,
+    numCells + this->GetNumberOfConnectivityIds());
+  if (this->Storage32Bit)
+    {
+    vtkCompactCellArrayExport(this->Int32Offsets->GetPointer(0),
+                              this->Int32Connectivity->GetPointer(0),
+                              numCells, legacy);
+    }
+  else
+    {
+    vtkCompactCellArrayExport(this->IdOffsets->GetPointer(0),
+                              this->IdConnectivity->GetPointer(0),
+                              numCells, legacy);
+    }
+  cells->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactCellArray::DeepCopy(vtkCompactCellArray *ca)
+{
+  // Do nothing on a NULL input.
+  if (ca == NULL || ca == this)
+    {
+    return;
+    }
+
+  vtkDataArray *offsets = ca->GetOffsetsArray()->NewInstance();
+  vtkDataArray *connectivity = ca->GetConnectivityArray()->NewInstance();
+  offsets->DeepCopy(ca->GetOffsetsArray());
+  connectivity->DeepCopy(ca->GetConnectivityArray());
+  this->SetArrays(offsets, connectivity);
+  offsets->Delete();
+  connectivity->Delete();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactCellArray::ShallowCopy(vtkCompactCellArray *ca)
+{
+  if (ca == NULL || ca == this)
+    {
+    return;
+    }
+
+  this->SetArrays(ca->GetOffsetsArray(), ca->GetConnectivityArray());
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkCompactCellArray::GetActualMemorySize()
+{
+  return this->GetOffsetsArray()->GetActualMemorySize() +
+    this->GetConnectivityArray()->GetActualMemorySize();
+}
+
+//----------------------------------------------------------------------------
+void vtkCompactCellArray::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number Of Cells: " << this->GetNumberOfCells() << endl;
+  os << indent << "Number Of Connectivity Ids: "
+     << this->GetNumberOfConnectivityIds() << endl;
+  os << indent << "Storage: "
+     << (this->Storage32Bit ? "32-bit" : "vtkIdType") << endl;
+}
@@ -0,0 +1,233 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompactCellArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkCompactCellArray - cell connectivity stored as offsets and point ids
+// .SECTION Description
+// vtkCompactCellArray represents the same cell connectivity as vtkCellArray
+// with two arrays instead of one interleaved (n,id1,id2,...,idn, ...) list:
+// Connectivity holds the point ids of all the cells back to back and Offsets
+// holds, for each cell, the location of its first point id in Connectivity,
+// followed by one last entry equal to the size of Connectivity. The points of
+// cell i are thus Connectivity[Offsets[i]] to Connectivity[Offsets[i+1]-1].
+//
+// Since the location of any cell is known without traversing the previous
+// ones, cells are accessed at random in constant time and there is no
+// traversal cursor: GetCellAtId() may be called from several threads at
+// once. GetOffsetsArray(), GetConnectivityArray() and SetData() give access
+// to the two arrays without copy.
+//
+// When VTK is built with 64-bit ids, the offsets and point ids of this
+// class are stored as 32-bit integers whenever they fit. A new or
+// initialized cell array starts with 32-bit storage, ImportLegacyFormat()
+// picks the narrowest storage that holds the cells, and the storage is
+// widened to vtkIdType automatically when a cell that does not fit is
+// inserted. ConvertTo32BitStorage() and ConvertToIdTypeStorage() force
+// either storage. No other class is affected: vtkCellArray, vtkCellLinks,
+// vtkStaticCellLinks, vtkIdList and the datasets store vtkIdType values.
+//
+// ImportLegacyFormat() and ExportLegacyFormat() convert from and to a
+// vtkCellArray. vtkStaticCellLinks builds its point-to-cell links from a
+// vtkCompactCellArray; vtkPolyDataNormals uses both to find the neighbors
+// of the input polygons from several threads. These are its only users:
+// the datasets, readers, writers and rendering code do not use it.
+//
+// .SECTION See Also
+// vtkCellArray vtkCellTypes vtkCellLinks vtkStaticCellLinks
+
+#ifndef vtkCompactCellArray_h
+#define vtkCompactCellArray_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include "vtkIdTypeArray.h" // Needed for inline methods
+
+class vtkCell;
+class vtkCellArray;
+class vtkDataArray;
+class vtkIdList;
+class vtkTypeInt32Array;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkCompactCellArray : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkCompactCellArray,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Instantiate an empty cell array, using 32-bit storage on 64-bit id
+  // builds.
+  static vtkCompactCellArray *New();
+
+  // Description:
+  // Allocate memory for numCells cells using connectivitySize point ids in
+  // total. The cell array is left empty. Returns 1 on success, 0 otherwise.
+  int Allocate(vtkIdType numCells, vtkIdType connectivitySize);
+
+  // Description:
+  // Free any memory and reset to an empty state, using 32-bit storage on
+  // 64-bit id builds.
+  void Initialize();
+
+  // Description:
+  // Reuse the memory. Reset to an empty state. The storage type is kept.
+  void Reset();
+
+  // Description:
+  // Reclaim any extra memory.
+  void Squeeze();
+
+  // Description:
+  // Get the number of cells in the array.
+  vtkIdType GetNumberOfCells();
+
+  // Description:
+  // Get the total number of point ids stored in the connectivity array.
+  vtkIdType GetNumberOfConnectivityIds();
+
+  // Description:
+  // Return the number of points defining the cell.
+  vtkIdType GetCellSize(vtkIdType cellId);
+
+  // Description:
+  // Get the number of points and the point ids of a cell in constant time.
+  // With vtkIdType storage, pts points directly into the connectivity
+  // array and ptIds is not used; with 32-bit storage the ids are copied
+  // into ptIds and pts points to its ids. Since nothing else is modified,
+  // this may be called from several threads at once, as long as each
+  // thread uses its own ptIds. pts is valid until the cell array or ptIds
+  // is modified.
+  void GetCellAtId(vtkIdType cellId, vtkIdType& npts, const vtkIdType* &pts,
+                   vtkIdList *ptIds);
+
+  // Description:
+  // Copy the point ids of a cell into pts. Thread safe when each thread
+  // uses its own pts.
+  void GetCellAtId(vtkIdType cellId, vtkIdList *pts);
+
+  // Description:
+  // Create a cell by specifying the number of points and an array of point
+  // id's. Return the cell id of the cell.
+  vtkIdType InsertNextCell(vtkIdType npts, const vtkIdType* pts);
+
+  // Description:
+  // Create a cell by specifying a list of point ids. Return the cell id of
+  // the cell.
+  vtkIdType InsertNextCell(vtkIdList *pts);
+
+  // Description:
+  // Insert a cell object. Return the cell id of the cell.
+  vtkIdType InsertNextCell(vtkCell *cell);
+
+  // Description:
+  // Returns the size of the largest cell. The size is the number of points
+  // defining the cell.
+  int GetMaxCellSize();
+
+  // Description:
+  // Define all the cells at once from an offsets array (number of cells + 1
+  // entries, the first being 0 and the last the size of connectivity) and a
+  // connectivity array. Both must be vtkIdTypeArray, or both
+  // vtkTypeInt32Array, in which case the storage becomes 32-bit. The arrays
+  // are referenced, not copied (except for 32-bit arrays in a build with
+  // 32-bit vtkIdType where they are converted). Returns 0, leaving the cell
+  // array unchanged, if the arrays are not suitable.
+  int SetData(vtkDataArray *offsets, vtkDataArray *connectivity);
+
+  // Description:
+  // Return the arrays holding the cells, a vtkIdTypeArray or a
+  // vtkTypeInt32Array depending on the storage.
+  vtkDataArray* GetOffsetsArray();
+  vtkDataArray* GetConnectivityArray();
+
+  // Description:
+  // Return 1 if the offsets and point ids are stored as 32-bit integers
+  // instead of vtkIdType.
+  int IsStorage32Bit()
+    {return this->Storage32Bit;}
+
+  // Description:
+  // Return 1 if every offset and point id fits in a 32-bit integer.
+  int CanConvertTo32BitStorage();
+
+  // Description:
+  // Store the offsets and point ids as 32-bit integers. Returns 0, leaving
+  // the storage unchanged, if some value does not fit. This is a no-op when
+  // vtkIdType itself is 32-bit.
+  int ConvertTo32BitStorage();
+
+  // Description:
+  // Store the offsets and point ids as vtkIdType.
+  void ConvertToIdTypeStorage();
+
+  // Description:
+  // Replace the content of this cell array by the cells of a vtkCellArray,
+  // using 32-bit storage if they fit in it.
+  void ImportLegacyFormat(vtkCellArray *cells);
+
+  // Description:
+  // Replace the content of a vtkCellArray by the cells of this array.
+  void ExportLegacyFormat(vtkCellArray *cells);
+
+  // Description:
+  // Perform a deep copy (no reference counting) of the given cell array.
+  void DeepCopy(vtkCompactCellArray *ca);
+
+  // Description:
+  // Reference the arrays of the given cell array.
+  void ShallowCopy(vtkCompactCellArray *ca);
+
+  // Description:
+  // Return the memory in kibibytes (1024 bytes) consumed by this cell array.
+  unsigned long GetActualMemorySize();
+
+protected:
+  vtkCompactCellArray();
+  ~vtkCompactCellArray();
+
+  void GetCellAtId32(vtkIdType cellId, vtkIdType& npts,
+                     const vtkIdType* &pts, vtkIdList *ptIds);
+  void SetArrays(vtkDataArray *offsets, vtkDataArray *connectivity);
+  void SetStorage(int use32Bit);
+
+  int Storage32Bit;
+
+  // Only one pair of arrays is used, depending on Storage32Bit.
+  vtkIdTypeArray *IdOffsets;
+  vtkIdTypeArray *IdConnectivity;
+  vtkTypeInt32Array *Int32Offsets;
+  vtkTypeInt32Array *Int32Connectivity;
+
+private:
+  vtkCompactCellArray(const vtkCompactCellArray&);  // Not implemented.
+  void operator=(const vtkCompactCellArray&);  // Not implemented.
+};
+
+//----------------------------------------------------------------------------
+inline void vtkCompactCellArray::GetCellAtId(vtkIdType cellId,
+                                             vtkIdType& npts,
+                                             const vtkIdType* &pts,
+                                             vtkIdList *ptIds)
+{
+  if (this->Storage32Bit)
+    {
+    this->GetCellAtId32(cellId, npts, pts, ptIds);
+    return;
+    }
+  const vtkIdType *offsets = this->IdOffsets->GetPointer(cellId);
+  npts = offsets[1] - offsets[0];
+  pts = this->IdConnectivity->GetPointer(offsets[0]);
+}
+
+#endif
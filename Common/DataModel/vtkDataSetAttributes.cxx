@@ -203,7 +203,7 @@ void vtkDataSetAttributes::ShallowCopy(vtkFieldData *fd)
     for (i=0; i < numArrays; i++ )
       {
       this->NumberOfActiveArrays++;
-      this->SetArray(i, fd->GetAbstractArray(i));
+      this->ShallowCopyArray(i, fd->GetAbstractArray(i));
       }
 
     // Copy the copy flags
@@ -422,7 +422,7 @@ void vtkDataSetAttributes::PassData(vtkFieldData* fd)
     int i, arrayIndex;
     for(i=it.BeginIndex(); !it.End(); i=it.NextIndex())
       {
-      arrayIndex = this->AddArray(dsa->GetAbstractArray(i));
+      arrayIndex = this->PassArray(dsa->GetAbstractArray(i));
       // If necessary, make the array an attribute
       if ( ((attributeType = dsa->IsArrayAnAttribute(i)) != -1 ) &&
            this->CopyAttributeFlags[PASSDATA][attributeType] )
@@ -493,13 +493,14 @@ void vtkDataSetAttributesCopyValues(
   // For vtkDataArray subclasses.
   int data_type_size = srcIter->GetArray()->GetDataTypeSize();
   vtkIdType rowLength = outIncs[1];
-  unsigned char *inPtr;
+  const unsigned char *inPtr;
   unsigned char *outPtr;
-  unsigned char *inZPtr;
+  const unsigned char *inZPtr;
   unsigned char *outZPtr;
 
   // Get the starting input pointer.
-  inZPtr = static_cast<unsigned char*>(srcIter->GetArray()->GetVoidPointer(0));
+  inZPtr = static_cast<const unsigned char*>(
+    srcIter->GetArray()->GetReadVoidPointer(0));
   // Shift to the start of the subextent.
   inZPtr +=
       (outExt[0] - inExt[0]) * inIncs[0] * data_type_size +
@@ -616,6 +616,7 @@ public:
     vtkIdList *ids, double *weights);
 
   friend class vtkDataSetAttributes::FieldList;
+  friend class vtkDataSetAttributesCopier;
 //ETX
 
 //BTX
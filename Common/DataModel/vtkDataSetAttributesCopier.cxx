@@ -0,0 +1,117 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataSetAttributesCopier.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataSetAttributesCopier.h"
+
+#include "vtkAbstractArray.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkSimpleCriticalSection.h"
+
+#include <cstring>
+#include <vector>
+
+//----------------------------------------------------------------------------
+class vtkDataSetAttributesCopier::vtkInternals
+{
+public:
+  // The arrays whose tuples are copied with memcpy.
+  struct Block
+  {
+    const unsigned char* From;
+    unsigned char* To;
+    size_t TupleSize;
+  };
+  std::vector<Block> Blocks;
+
+  // The arrays whose tuples are inserted under the lock.
+  std::vector<vtkAbstractArray*> FromArrays;
+  std::vector<vtkAbstractArray*> ToArrays;
+  vtkSimpleCriticalSection Lock;
+};
+
+//----------------------------------------------------------------------------
+vtkDataSetAttributesCopier::vtkDataSetAttributesCopier()
+{
+  this->Internals = new vtkInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkDataSetAttributesCopier::~vtkDataSetAttributesCopier()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataSetAttributesCopier::Initialize(vtkDataSetAttributes* from,
+                                            vtkDataSetAttributes* to)
+{
+  this->Internals->Blocks.clear();
+  this->Internals->FromArrays.clear();
+  this->Internals->ToArrays.clear();
+
+  // Go over a copy of the iterator, so that the one of to is left as is.
+  vtkFieldData::BasicIterator required = to->RequiredArrays;
+  for (int i = required.BeginIndex(); !required.End(); i = required.NextIndex())
+    {
+    vtkAbstractArray* fromArray = from->GetAbstractArray(i);
+    vtkAbstractArray* toArray = to->GetAbstractArray(to->TargetIndices[i]);
+    if (fromArray->HasStandardMemoryLayout() &&
+        toArray->HasStandardMemoryLayout() &&
+        fromArray->IsA("vtkDataArray") && toArray->IsA("vtkDataArray") &&
+        fromArray->GetDataType() == toArray->GetDataType() &&
+        fromArray->GetDataType() != VTK_BIT &&
+        fromArray->GetNumberOfComponents() ==
+        toArray->GetNumberOfComponents())
+      {
+      vtkInternals::Block block;
+      block.TupleSize = static_cast<size_t>(
+        fromArray->GetNumberOfComponents() * fromArray->GetDataTypeSize());
+      block.From = static_cast<const unsigned char*>(
+        fromArray->GetReadVoidPointer(0));
+      block.To = static_cast<unsigned char*>(toArray->GetVoidPointer(0));
+      toArray->DataChanged();
+      this->Internals->Blocks.push_back(block);
+      }
+    else
+      {
+      this->Internals->FromArrays.push_back(fromArray);
+      this->Internals->ToArrays.push_back(toArray);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkDataSetAttributesCopier::Copy(vtkIdType fromId, vtkIdType toId)
+{
+  const vtkInternals::Block* blocks = this->Internals->Blocks.empty() ?
+    NULL : &this->Internals->Blocks[0];
+  size_t numBlocks = this->Internals->Blocks.size();
+  for (size_t i = 0; i < numBlocks; ++i)
+    {
+    size_t size = blocks[i].TupleSize;
+    memcpy(blocks[i].To + toId * size, blocks[i].From + fromId * size, size);
+    }
+
+  size_t numArrays = this->Internals->ToArrays.size();
+  if (numArrays > 0)
+    {
+    this->Internals->Lock.Lock();
+    for (size_t i = 0; i < numArrays; ++i)
+      {
+      this->Internals->ToArrays[i]->InsertTuple(
+        toId, fromId, this->Internals->FromArrays[i]);
+      }
+    this->Internals->Lock.Unlock();
+    }
+}
@@ -0,0 +1,70 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataSetAttributesCopier.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkDataSetAttributesCopier - copy attribute tuples from several threads
+// .SECTION Description
+// vtkDataSetAttributesCopier copies tuples between the same arrays as
+// vtkDataSetAttributes::CopyData(), for the filters that copy the point or
+// cell data of their output with vtkSMPTools. CopyData() goes over the
+// arrays with an iterator stored in the attributes, so two threads cannot
+// call it at the same time, even for different tuples.
+//
+// Initialize() is called from one thread, once CopyAllocate() has been
+// called on the output attributes and their arrays have been given their
+// final number of tuples. It lists the pairs of input and output arrays
+// that CopyData() would copy. Copy() then only reads this list and can be
+// called from several threads for different output tuples. The tuples of
+// data arrays with the standard memory layout are copied with memcpy; the
+// tuples of the other arrays, such as string arrays or mapped arrays, are
+// inserted one thread at a time.
+// .SECTION See Also
+// vtkDataSetAttributes vtkSMPTools
+
+#ifndef vtkDataSetAttributesCopier_h
+#define vtkDataSetAttributesCopier_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkType.h" // For vtkIdType
+
+class vtkDataSetAttributes;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkDataSetAttributesCopier
+{
+public:
+  vtkDataSetAttributesCopier();
+  ~vtkDataSetAttributesCopier();
+
+  // Description:
+  // List the arrays of from that to->CopyData(from, ...) copies, and the
+  // arrays of to they are copied to. to->CopyAllocate(from, ...) must have
+  // been called, and the arrays of to must have been resized to hold every
+  // tuple Copy() writes.
+  void Initialize(vtkDataSetAttributes* from, vtkDataSetAttributes* to);
+
+  // Description:
+  // Copy the tuple fromId of the arrays listed by Initialize() to the tuple
+  // toId, as to->CopyData(from, fromId, toId) does. Several threads may
+  // call this method at the same time for different values of toId.
+  void Copy(vtkIdType fromId, vtkIdType toId);
+
+private:
+  class vtkInternals;
+  vtkInternals* Internals;
+
+  vtkDataSetAttributesCopier(const vtkDataSetAttributesCopier&);  // Not implemented.
+  void operator=(const vtkDataSetAttributesCopier&);  // Not implemented.
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkDataSetAttributesCopier.h
@@ -195,6 +195,8 @@ vtkFieldData::vtkFieldData()
   this->DoCopyAllOn = 1;
   this->DoCopyAllOff = 0;
 
+  this->CopyOnWrite = 0;
+
   this->CopyAllOn();
 }
 
@@ -434,11 +436,53 @@ void vtkFieldData::ShallowCopy(vtkFieldData *f)
   for ( int i=0; i < f->GetNumberOfArrays(); i++ )
     {
     this->NumberOfActiveArrays++;
-    this->SetArray(i, f->GetAbstractArray(i));
+    this->ShallowCopyArray(i, f->GetAbstractArray(i));
     }
   this->CopyFlags(f);
 }
 
+//----------------------------------------------------------------------------
+// Return a new array sharing the memory of the given array, or NULL if the
+// memory of this kind of array cannot be shared.
+static vtkDataArray* vtkFieldDataNewCopyOnWriteArray(vtkAbstractArray *data)
+{
+  if (!data || data->GetArrayType() != vtkAbstractArray::DataArrayTemplate)
+    {
+    return 0;
+    }
+  vtkDataArray* copy = static_cast<vtkDataArray*>(data->NewInstance());
+  copy->ShallowCopy(static_cast<vtkDataArray*>(data));
+  copy->SetName(data->GetName());
+  return copy;
+}
+
+//----------------------------------------------------------------------------
+void vtkFieldData::ShallowCopyArray(int i, vtkAbstractArray *data)
+{
+  vtkDataArray* copy = this->CopyOnWrite ?
+    vtkFieldDataNewCopyOnWriteArray(data) : 0;
+  if (!copy)
+    {
+    this->SetArray(i, data);
+    return;
+    }
+  this->SetArray(i, copy);
+  copy->Delete();
+}
+
+//----------------------------------------------------------------------------
+int vtkFieldData::PassArray(vtkAbstractArray *array)
+{
+  vtkDataArray* copy = this->CopyOnWrite ?
+    vtkFieldDataNewCopyOnWriteArray(array) : 0;
+  if (!copy)
+    {
+    return this->AddArray(array);
+    }
+  int index = this->AddArray(copy);
+  copy->Delete();
+  return index;
+}
 
 //----------------------------------------------------------------------------
 // Squeezes each data array in the field (Squeeze() reclaims unused memory.)
@@ -756,7 +800,7 @@ void vtkFieldData::PassData(vtkFieldData* fd)
          !(this->DoCopyAllOff && (this->GetFlag(arrayName) != 1)) &&
          fd->GetAbstractArray(i))
       {
-      this->AddArray(fd->GetAbstractArray(i));
+      this->PassArray(fd->GetAbstractArray(i));
       }
     }
 }
@@ -782,6 +826,8 @@ void vtkFieldData::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Components: " << this->GetNumberOfComponents()
      << "\n";
   os << indent << "Number Of Tuples: " << this->GetNumberOfTuples() << "\n";
+  os << indent << "Copy On Write: "
+     << (this->CopyOnWrite ? "On\n" : "Off\n");
 }
 
 //----------------------------------------------------------------------------
@@ -97,6 +97,12 @@ public:
   // Return the index of the added array.
   int AddArray(vtkAbstractArray *array);
 
+  // Description:
+  // Add an array of another field, as AddArray() does, or, when
+  // CopyOnWrite is on, a new array sharing its memory if it can be shared.
+  // Used by PassData(). Return the index of the added array.
+  int PassArray(vtkAbstractArray *array);
+
   // Description:
   // Remove an array (with the given name) from the list of arrays.
   virtual void RemoveArray(const char *name)
@@ -171,7 +177,7 @@ public:
 
   // Description:
   // Pass entire arrays of input data through to output. Obey the "copy"
-  // flags.
+  // flags, and the CopyOnWrite flag.
   virtual void PassData(vtkFieldData* fd);
 
   // Description:
@@ -210,9 +216,23 @@ public:
   virtual void DeepCopy(vtkFieldData *da);
 
   // Description:
-  // Copy a field by reference counting the data arrays.
+  // Copy a field by reference counting the data arrays. When CopyOnWrite
+  // is on, the numeric arrays that can share their memory
+  // (vtkDataArrayTemplate subclasses) are instead replaced by new arrays
+  // sharing it, see vtkDataArrayTemplate::ShallowCopy().
   virtual void ShallowCopy(vtkFieldData *da);
 
+  // Description:
+  // When on, ShallowCopy() and PassData() give this field its own numeric
+  // arrays sharing the memory of the arrays of the copied field, instead of
+  // the arrays themselves. The memory is copied before the first modification of
+  // either array, so that an algorithm passing data through can modify its
+  // output arrays without touching its input. The arrays of the field are
+  // then not the arrays of the copied field. Off by default.
+  vtkSetMacro(CopyOnWrite, int);
+  vtkGetMacro(CopyOnWrite, int);
+  vtkBooleanMacro(CopyOnWrite, int);
+
   // Description:
   // Squeezes each data array in the field (Squeeze() reclaims unused memory.)
   void Squeeze();
@@ -311,6 +331,12 @@ protected:
   // Set an array to define the field.
   void SetArray(int i, vtkAbstractArray *array);
 
+  // Description:
+  // Set the ith array to the given array, or, when CopyOnWrite is on, to a
+  // copy of it sharing its memory if it can be shared. Used by
+  // ShallowCopy().
+  void ShallowCopyArray(int i, vtkAbstractArray *array);
+
   virtual void RemoveArray(int index);
 
   // Description:
@@ -335,6 +361,8 @@ protected:
   int DoCopyAllOn;
   int DoCopyAllOff;
 
+  int CopyOnWrite;
+
 
 private:
   vtkFieldData(const vtkFieldData&);  // Not implemented.
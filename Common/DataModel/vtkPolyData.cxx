@@ -1081,7 +1081,7 @@ void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
 void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
                                 vtkIdType* &pts)
 {
-  int loc;
+  vtkIdType loc;
   unsigned char type;
 
   type = this->Cells->GetCellType(cellId);
@@ -1412,7 +1412,8 @@ void vtkPolyData::Reset()
 // Reverse the order of point ids defining the cell.
 void vtkPolyData::ReverseCell(vtkIdType cellId)
 {
-  int loc, type;
+  vtkIdType loc;
+  int type;
 
   if ( this->Cells == NULL )
     {
@@ -1510,7 +1511,8 @@ void vtkPolyData::AddReferenceToCell(vtkIdType ptId, vtkIdType cellId)
 // ReplaceLinkedCell() to replace a cell when cell structure has been built.
 void vtkPolyData::ReplaceCell(vtkIdType cellId, int npts, vtkIdType *pts)
 {
-  int loc, type;
+  vtkIdType loc;
+  int type;
 
   if ( this->Cells == NULL )
     {
@@ -1551,7 +1553,7 @@ void vtkPolyData::ReplaceCell(vtkIdType cellId, int npts, vtkIdType *pts)
 // link list is changing size.
 void vtkPolyData::ReplaceLinkedCell(vtkIdType cellId, int npts, vtkIdType *pts)
 {
-  int loc = this->Cells->GetCellLocation(cellId);
+  vtkIdType loc = this->Cells->GetCellLocation(cellId);
   int type = this->Cells->GetCellType(cellId);
 
   switch (type)
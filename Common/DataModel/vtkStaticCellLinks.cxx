@@ -0,0 +1,350 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticCellLinks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticCellLinks.h"
+
+#include "vtkAtomic.h"
+#include "vtkCompactCellArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+vtkStandardNewMacro(vtkStaticCellLinks);
+
+namespace
+{
+
+// The sources below give thread-safe access to the point ids of the cells.
+class vtkStaticCellLinksPolyData
+{
+  vtkPolyData *Data;
+public:
+  vtkStaticCellLinksPolyData(vtkPolyData *data) : Data(data) {}
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts, const vtkIdType* &pts)
+  {
+    vtkIdType *ids;
+    this->Data->GetCellPoints(cellId, npts, ids);
+    pts = ids;
+  }
+};
+
+class vtkStaticCellLinksUnstructuredGrid
+{
+  vtkUnstructuredGrid *Data;
+public:
+  vtkStaticCellLinksUnstructuredGrid(vtkUnstructuredGrid *data) : Data(data) {}
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts, const vtkIdType* &pts)
+  {
+    vtkIdType *ids;
+    this->Data->GetCellPoints(cellId, npts, ids);
+    pts = ids;
+  }
+};
+
+class vtkStaticCellLinksCompact
+{
+  vtkCompactCellArray *Cells;
+  vtkSMPThreadLocalObject<vtkIdList> Ids;
+public:
+  vtkStaticCellLinksCompact(vtkCompactCellArray *cells) : Cells(cells) {}
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts, const vtkIdType* &pts)
+  {
+    this->Cells->GetCellAtId(cellId, npts, pts, this->Ids.Local());
+  }
+};
+
+class vtkStaticCellLinksDataSet
+{
+  vtkDataSet *Data;
+  vtkSMPThreadLocalObject<vtkIdList> Ids;
+public:
+  vtkStaticCellLinksDataSet(vtkDataSet *data) : Data(data) {}
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts, const vtkIdType* &pts)
+  {
+    vtkIdList *ids = this->Ids.Local();
+    this->Data->GetCellPoints(cellId, ids);
+    npts = ids->GetNumberOfIds();
+    pts = ids->GetPointer(0);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Count the cells using each point.
+template <typename CellSource>
+class vtkStaticCellLinksCount
+{
+  CellSource& Source;
+  vtkAtomic<vtkIdType> *Counts;
+public:
+  vtkStaticCellLinksCount(CellSource& source, vtkAtomic<vtkIdType> *counts)
+    : Source(source), Counts(counts) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Source.GetCellPoints(cellId, npts, pts);
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        ++this->Counts[pts[i]];
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Scatter the cell ids, each point claiming the next free slot of its list.
+template <typename CellSource>
+class vtkStaticCellLinksInsert
+{
+  CellSource& Source;
+  vtkAtomic<vtkIdType> *Cursors;
+  vtkIdType *Links;
+public:
+  vtkStaticCellLinksInsert(CellSource& source, vtkAtomic<vtkIdType> *cursors,
+                           vtkIdType *links)
+    : Source(source), Cursors(cursors), Links(links) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Source.GetCellPoints(cellId, npts, pts);
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        this->Links[this->Cursors[pts[i]]++] = cellId;
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+class vtkStaticCellLinksInitializeCursors
+{
+  const vtkIdType *Offsets;
+  vtkAtomic<vtkIdType> *Cursors;
+public:
+  vtkStaticCellLinksInitializeCursors(const vtkIdType *offsets,
+                                      vtkAtomic<vtkIdType> *cursors)
+    : Offsets(offsets), Cursors(cursors) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      this->Cursors[ptId] = this->Offsets[ptId];
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// The scatter inserts the cells of a point in any order: sort them so that
+// the links do not depend on the scheduling.
+class vtkStaticCellLinksSort
+{
+  const vtkIdType *Offsets;
+  vtkIdType *Links;
+public:
+  vtkStaticCellLinksSort(const vtkIdType *offsets, vtkIdType *links)
+    : Offsets(offsets), Links(links) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      std::sort(this->Links + this->Offsets[ptId],
+                this->Links + this->Offsets[ptId + 1]);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+template <typename CellSource>
+void vtkStaticCellLinksBuild(CellSource& source, vtkIdType numCells,
+                             vtkIdType numPts, vtkIdType *offsets,
+                             vtkIdType* &links)
+{
+  vtkAtomic<vtkIdType> *counts = new vtkAtomic<vtkIdType>[numPts];
+
+  vtkStaticCellLinksCount<CellSource> counter(source, counts);
+  vtkSMPTools::For(0, numCells, counter);
+
+  vtkSMPTools::ExclusiveScan(counts, counts + numPts, offsets,
+                             static_cast<vtkIdType>(0));
+  offsets[numPts] = numPts > 0 ?
+    offsets[numPts - 1] + static_cast<vtkIdType>(counts[numPts - 1]) : 0;
+  links = new vtkIdType[offsets[numPts]];
+
+  vtkStaticCellLinksInitializeCursors initializer(offsets, counts);
+  vtkSMPTools::For(0, numPts, initializer);
+  vtkStaticCellLinksInsert<CellSource> inserter(source, counts, links);
+  vtkSMPTools::For(0, numCells, inserter);
+  delete [] counts;
+
+  vtkStaticCellLinksSort sorter(offsets, links);
+  vtkSMPTools::For(0, numPts, sorter);
+}
+
+}
+
+//----------------------------------------------------------------------------
+vtkStaticCellLinks::vtkStaticCellLinks()
+{
+  this->NumberOfPoints = 0;
+  this->Offsets = NULL;
+  this->Links = NULL;
+  this->AllocateLinks(0);
+}
+
+//----------------------------------------------------------------------------
+vtkStaticCellLinks::~vtkStaticCellLinks()
+{
+  delete [] this->Offsets;
+  delete [] this->Links;
+}
+
+//----------------------------------------------------------------------------
+// Release the links and allocate the offsets of numPts points.
+void vtkStaticCellLinks::AllocateLinks(vtkIdType numPts)
+{
+  delete [] this->Offsets;
+  delete [] this->Links;
+  this->NumberOfPoints = numPts;
+  this->Offsets = new vtkIdType[numPts + 1];
+  this->Offsets[numPts] = 0;
+  this->Links = NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::Initialize()
+{
+  this->AllocateLinks(0);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::BuildLinks(vtkDataSet *data)
+{
+  vtkIdType numPts = data->GetNumberOfPoints();
+  vtkIdType numCells = data->GetNumberOfCells();
+  this->AllocateLinks(numPts);
+
+  vtkPolyData *polyData = vtkPolyData::SafeDownCast(data);
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(data);
+  if (polyData)
+    {
+    // Build the cell locations, if needed, before the threads read them.
+    if (numCells > 0)
+      {
+      polyData->GetCellType(0);
+      }
+    vtkStaticCellLinksPolyData source(polyData);
+    vtkStaticCellLinksBuild(source, numCells, numPts,
+                            this->Offsets, this->Links);
+    }
+  else if (grid)
+    {
+    vtkStaticCellLinksUnstructuredGrid source(grid);
+    vtkStaticCellLinksBuild(source, numCells, numPts,
+                            this->Offsets, this->Links);
+    }
+  else
+    {
+    // GetCellPoints() is only thread safe once it was called from a single
+    // thread.
+    if (numCells > 0)
+      {
+      vtkIdList *ids = vtkIdList::New();
+      data->GetCellPoints(0, ids);
+      ids->Delete();
+      }
+    vtkStaticCellLinksDataSet source(data);
+    vtkStaticCellLinksBuild(source, numCells, numPts,
+                            this->Offsets, this->Links);
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::BuildLinks(vtkIdType numPts,
+                                    vtkCompactCellArray *cells)
+{
+  this->AllocateLinks(numPts);
+  vtkStaticCellLinksCompact source(cells);
+  vtkStaticCellLinksBuild(source, cells->GetNumberOfCells(), numPts,
+                          this->Offsets, this->Links);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::GetCellEdgeNeighbors(vtkIdType cellId,
+                                              vtkIdType p1, vtkIdType p2,
+                                              vtkIdList *cellIds)
+{
+  cellIds->Reset();
+
+  // Both lists are sorted: intersect them.
+  const vtkIdType *cells1 = this->GetCells(p1);
+  const vtkIdType *end1 = cells1 + this->GetNcells(p1);
+  const vtkIdType *cells2 = this->GetCells(p2);
+  const vtkIdType *end2 = cells2 + this->GetNcells(p2);
+  while (cells1 != end1 && cells2 != end2)
+    {
+    if (*cells1 < *cells2)
+      {
+      ++cells1;
+      }
+    else if (*cells2 < *cells1)
+      {
+      ++cells2;
+      }
+    else
+      {
+      if (*cells1 != cellId &&
+          (cellIds->GetNumberOfIds() == 0 ||
+           cellIds->GetId(cellIds->GetNumberOfIds() - 1) != *cells1))
+        {
+        cellIds->InsertNextId(*cells1);
+        }
+      ++cells1;
+      ++cells2;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkStaticCellLinks::GetActualMemorySize()
+{
+  vtkIdType size = this->NumberOfPoints + 1 +
+    this->Offsets[this->NumberOfPoints];
+  return static_cast<unsigned long>(
+    ceil(size * static_cast<double>(sizeof(vtkIdType)) / 1024.0));
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLinks::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number Of Points: " << this->NumberOfPoints << "\n";
+  os << indent << "Number Of Links: "
+     << this->Offsets[this->NumberOfPoints] << "\n";
+}
@@ -0,0 +1,108 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticCellLinks.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStaticCellLinks - immutable upward links from points to the cells using them
+// .SECTION Description
+// vtkStaticCellLinks provides the same information as vtkCellLinks, the list
+// of cells using each point, in two flat arrays: Links holds the cell ids of
+// all the points back to back and Offsets holds, for each point, the
+// location of its first cell id in Links, followed by one last entry equal
+// to the size of Links. Instead of one heap allocation per point, the whole
+// structure takes two allocations, and it is built in parallel with
+// vtkSMPTools: the cells using each point are counted, the counts are turned
+// into offsets with a prefix sum, and the cell ids are scattered in place.
+// The cells of each point are sorted by increasing id, as with vtkCellLinks.
+//
+// The structure cannot be edited once built; use vtkCellLinks, through
+// vtkPolyData::BuildLinks() or vtkUnstructuredGrid::BuildLinks(), when cells
+// are inserted, replaced or removed afterwards. The accessors mirror those of
+// vtkCellLinks (GetNcells(), GetCells()) so that read-only consumers can use
+// either, and they may be called from several threads at once.
+//
+// .SECTION See Also
+// vtkCellLinks vtkCompactCellArray vtkSMPTools
+
+#ifndef vtkStaticCellLinks_h
+#define vtkStaticCellLinks_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkCompactCellArray;
+class vtkDataSet;
+class vtkIdList;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkStaticCellLinks : public vtkObject
+{
+public:
+  static vtkStaticCellLinks *New();
+  vtkTypeMacro(vtkStaticCellLinks,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Build the links of all the points of the dataset. vtkPolyData and
+  // vtkUnstructuredGrid are traversed directly; other datasets through
+  // vtkDataSet::GetCellPoints().
+  void BuildLinks(vtkDataSet *data);
+
+  // Description:
+  // Build the links of numPts points from a compact cell array.
+  void BuildLinks(vtkIdType numPts, vtkCompactCellArray *cells);
+
+  // Description:
+  // Release the memory used by the links.
+  void Initialize();
+
+  // Description:
+  // Get the number of points the links were built for.
+  vtkIdType GetNumberOfPoints()
+    {return this->NumberOfPoints;}
+
+  // Description:
+  // Get the number of cells using the point specified by ptId.
+  vtkIdType GetNcells(vtkIdType ptId)
+    {return this->Offsets[ptId+1] - this->Offsets[ptId];}
+
+  // Description:
+  // Return the list of cell ids using the point, sorted by increasing id.
+  const vtkIdType *GetCells(vtkIdType ptId)
+    {return this->Links + this->Offsets[ptId];}
+
+  // Description:
+  // Get the cells, other than cellId, that use both points p1 and p2. This
+  // is the equivalent of vtkPolyData::GetCellEdgeNeighbors() when p1 and p2
+  // form an edge of cellId.
+  void GetCellEdgeNeighbors(vtkIdType cellId, vtkIdType p1, vtkIdType p2,
+                            vtkIdList *cellIds);
+
+  // Description:
+  // Return the memory in kibibytes (1024 bytes) consumed by the links.
+  unsigned long GetActualMemorySize();
+
+protected:
+  vtkStaticCellLinks();
+  ~vtkStaticCellLinks();
+
+  void AllocateLinks(vtkIdType numPts);
+
+  vtkIdType NumberOfPoints;
+  vtkIdType *Offsets;   // NumberOfPoints + 1 locations into Links
+  vtkIdType *Links;     // cell ids of all the points
+
+private:
+  vtkStaticCellLinks(const vtkStaticCellLinks&);  // Not implemented.
+  void operator=(const vtkStaticCellLinks&);  // Not implemented.
+};
+
+#endif
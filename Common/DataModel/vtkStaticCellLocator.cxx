@@ -0,0 +1,817 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticCellLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkDataSet.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+vtkStandardNewMacro(vtkStaticCellLocator);
+
+namespace
+{
+
+// A cell and one of the buckets its bounds overlap.
+struct vtkStaticCellLocatorTuple
+{
+  vtkIdType Bucket;
+  vtkIdType CellId;
+
+  bool operator<(const vtkStaticCellLocatorTuple& other) const
+  {
+    return this->Bucket < other.Bucket ||
+      (this->Bucket == other.Bucket && this->CellId < other.CellId);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Range of the buckets overlapped by a box, clamped to the locator.
+void vtkStaticCellLocatorBucketRange(const double bounds[6],
+                                     const double *origin, const double *h,
+                                     const int *divs, int min[3], int max[3])
+{
+  for (int i = 0; i < 3; i++)
+    {
+    double lo = (bounds[2*i] - origin[i]) / h[i];
+    double hi = (bounds[2*i+1] - origin[i]) / h[i];
+    min[i] = (lo < 1.0 ? 0 : (lo >= divs[i] - 1 ? divs[i] - 1 :
+                              static_cast<int>(lo)));
+    max[i] = (hi < 1.0 ? 0 : (hi >= divs[i] - 1 ? divs[i] - 1 :
+                              static_cast<int>(hi)));
+    }
+}
+
+//----------------------------------------------------------------------------
+// Compute the bounds of each cell and the number of buckets they overlap.
+class vtkStaticCellLocatorBounds
+{
+  vtkDataSet *DataSet;
+  double (*CellBounds)[6];
+  vtkIdType *Counts;
+  double Origin[3];
+  double H[3];
+  int Divisions[3];
+  vtkSMPThreadLocalObject<vtkIdList> PtIds;
+public:
+  vtkStaticCellLocatorBounds(vtkDataSet *ds, double (*cellBounds)[6],
+                             vtkIdType *counts, const double origin[3],
+                             const double h[3], const int divs[3])
+    : DataSet(ds), CellBounds(cellBounds), Counts(counts)
+  {
+    for (int i = 0; i < 3; i++)
+      {
+      this->Origin[i] = origin[i];
+      this->H[i] = h[i];
+      this->Divisions[i] = divs[i];
+      }
+  }
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *ptIds = this->PtIds.Local();
+    double x[3];
+    int min[3], max[3];
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      double *bounds = this->CellBounds[cellId];
+      this->DataSet->GetCellPoints(cellId, ptIds);
+      vtkIdType npts = ptIds->GetNumberOfIds();
+      if (npts == 0)
+        {
+        bounds[0] = bounds[2] = bounds[4] = VTK_DOUBLE_MAX;
+        bounds[1] = bounds[3] = bounds[5] = -VTK_DOUBLE_MAX;
+        this->Counts[cellId] = 0;
+        continue;
+        }
+      this->DataSet->GetPoint(ptIds->GetId(0), x);
+      bounds[0] = bounds[1] = x[0];
+      bounds[2] = bounds[3] = x[1];
+      bounds[4] = bounds[5] = x[2];
+      for (vtkIdType i = 1; i < npts; ++i)
+        {
+        this->DataSet->GetPoint(ptIds->GetId(i), x);
+        for (int j = 0; j < 3; ++j)
+          {
+          bounds[2*j] = (x[j] < bounds[2*j] ? x[j] : bounds[2*j]);
+          bounds[2*j+1] = (x[j] > bounds[2*j+1] ? x[j] : bounds[2*j+1]);
+          }
+        }
+      vtkStaticCellLocatorBucketRange(bounds, this->Origin, this->H,
+                                      this->Divisions, min, max);
+      this->Counts[cellId] = static_cast<vtkIdType>(max[0] - min[0] + 1) *
+        (max[1] - min[1] + 1) * (max[2] - min[2] + 1);
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Write the (bucket, cell id) pairs of each cell at its offset.
+class vtkStaticCellLocatorBin
+{
+  const double (*CellBounds)[6];
+  const vtkIdType *CellOffsets;
+  vtkStaticCellLocatorTuple *Map;
+  double Origin[3];
+  double H[3];
+  int Divisions[3];
+public:
+  vtkStaticCellLocatorBin(const double (*cellBounds)[6],
+                          const vtkIdType *cellOffsets,
+                          vtkStaticCellLocatorTuple *map,
+                          const double origin[3], const double h[3],
+                          const int divs[3])
+    : CellBounds(cellBounds), CellOffsets(cellOffsets), Map(map)
+  {
+    for (int i = 0; i < 3; i++)
+      {
+      this->Origin[i] = origin[i];
+      this->H[i] = h[i];
+      this->Divisions[i] = divs[i];
+      }
+  }
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType sliceSize =
+      static_cast<vtkIdType>(this->Divisions[0]) * this->Divisions[1];
+    int min[3], max[3];
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      vtkIdType loc = this->CellOffsets[cellId];
+      if (this->CellOffsets[cellId+1] == loc)
+        {
+        continue;
+        }
+      vtkStaticCellLocatorBucketRange(this->CellBounds[cellId], this->Origin,
+                                      this->H, this->Divisions, min, max);
+      for (int k = min[2]; k <= max[2]; ++k)
+        {
+        for (int j = min[1]; j <= max[1]; ++j)
+          {
+          for (int i = min[0]; i <= max[0]; ++i)
+            {
+            this->Map[loc].Bucket = i + j*this->Divisions[0] + k*sliceSize;
+            this->Map[loc].CellId = cellId;
+            ++loc;
+            }
+          }
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Copy the sorted cell ids, and record the first location of each bucket
+// where the bucket changes in the sorted pairs. Empty buckets get the
+// location of the next non-empty one.
+class vtkStaticCellLocatorOffsets
+{
+  const vtkStaticCellLocatorTuple *Map;
+  vtkIdType *Offsets;
+  vtkIdType *CellIds;
+public:
+  vtkStaticCellLocatorOffsets(const vtkStaticCellLocatorTuple *map,
+                              vtkIdType *offsets, vtkIdType *cellIds)
+    : Map(map), Offsets(offsets), CellIds(cellIds) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->CellIds[i] = this->Map[i].CellId;
+      vtkIdType prev = (i > 0 ? this->Map[i-1].Bucket : -1);
+      for (vtkIdType bucket = prev + 1; bucket <= this->Map[i].Bucket;
+           ++bucket)
+        {
+        this->Offsets[bucket] = i;
+        }
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Clip the parametric range [t0,t1] of the line p1 + t*dir to the box
+// inflated by tol. Returns false if the line misses the box.
+bool vtkStaticCellLocatorClipLine(const double p1[3], const double dir[3],
+                                  const double bounds[6], double tol,
+                                  double& t0, double& t1)
+{
+  for (int i = 0; i < 3; i++)
+    {
+    double lo = bounds[2*i] - tol;
+    double hi = bounds[2*i+1] + tol;
+    if (dir[i] == 0.0)
+      {
+      if (p1[i] < lo || p1[i] > hi)
+        {
+        return false;
+        }
+      continue;
+      }
+    double ta = (lo - p1[i]) / dir[i];
+    double tb = (hi - p1[i]) / dir[i];
+    if (ta > tb)
+      {
+      std::swap(ta, tb);
+      }
+    t0 = (ta > t0 ? ta : t0);
+    t1 = (tb < t1 ? tb : t1);
+    if (t0 > t1)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Walk the buckets traversed by the line p1 + t*dir, t in [0,1], in order
+// (3D digital differential analyzer). All the state lives in the walker so
+// that several lines can be walked at once.
+class vtkStaticCellLocatorLineWalker
+{
+  int Divisions[3];
+  int IJK[3];
+  int Step[3];
+  double TNext[3];
+  double TDelta[3];
+  double TEnd;
+  bool Done;
+public:
+  vtkStaticCellLocatorLineWalker(const double p1[3], const double dir[3],
+                                 const double bounds[6], const double h[3],
+                                 const int divs[3])
+  {
+    double t0 = 0.0, t1 = 1.0;
+    this->Done =
+      !vtkStaticCellLocatorClipLine(p1, dir, bounds, 0.0, t0, t1);
+    this->TEnd = t1;
+    double x[3];
+    for (int i = 0; i < 3; i++)
+      {
+      this->Divisions[i] = divs[i];
+      x[i] = p1[i] + t0 * dir[i];
+      double t = (x[i] - bounds[2*i]) / h[i];
+      this->IJK[i] = (t < 1.0 ? 0 : (t >= divs[i] - 1 ? divs[i] - 1 :
+                                     static_cast<int>(t)));
+      if (dir[i] > 0.0)
+        {
+        this->Step[i] = 1;
+        this->TNext[i] =
+          (bounds[2*i] + (this->IJK[i] + 1) * h[i] - p1[i]) / dir[i];
+        this->TDelta[i] = h[i] / dir[i];
+        }
+      else if (dir[i] < 0.0)
+        {
+        this->Step[i] = -1;
+        this->TNext[i] =
+          (bounds[2*i] + this->IJK[i] * h[i] - p1[i]) / dir[i];
+        this->TDelta[i] = -h[i] / dir[i];
+        }
+      else
+        {
+        this->Step[i] = 0;
+        this->TNext[i] = VTK_DOUBLE_MAX;
+        this->TDelta[i] = 0.0;
+        }
+      }
+  }
+
+  // Return the current bucket indices and the parameter where the line
+  // leaves it, or false once the line is exhausted.
+  bool GetBucket(int ijk[3], double& tExit)
+  {
+    if (this->Done)
+      {
+      return false;
+      }
+    ijk[0] = this->IJK[0];
+    ijk[1] = this->IJK[1];
+    ijk[2] = this->IJK[2];
+    tExit = std::min(this->TNext[0], std::min(this->TNext[1], this->TNext[2]));
+    return true;
+  }
+
+  void Next()
+  {
+    int axis = (this->TNext[0] < this->TNext[1] ?
+                (this->TNext[0] < this->TNext[2] ? 0 : 2) :
+                (this->TNext[1] < this->TNext[2] ? 1 : 2));
+    if (this->TNext[axis] > this->TEnd)
+      {
+      this->Done = true;
+      return;
+      }
+    this->IJK[axis] += this->Step[axis];
+    this->TNext[axis] += this->TDelta[axis];
+    if (this->IJK[axis] < 0 || this->IJK[axis] >= this->Divisions[axis])
+      {
+      this->Done = true;
+      }
+  }
+};
+
+}
+
+//----------------------------------------------------------------------------
+vtkStaticCellLocator::vtkStaticCellLocator()
+{
+  this->NumberOfCellsPerNode = 10;
+  for (int i=0; i<6; i++)
+    {
+    this->Bounds[i] = 0.0;
+    }
+  this->Divisions[0] = this->Divisions[1] = this->Divisions[2] = 50;
+  this->H[0] = this->H[1] = this->H[2] = 0.0;
+  this->NumberOfBuckets = 0;
+  this->Offsets = NULL;
+  this->CellIds = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkStaticCellLocator::~vtkStaticCellLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::FreeSearchStructure()
+{
+  delete [] this->Offsets;
+  this->Offsets = NULL;
+  delete [] this->CellIds;
+  this->CellIds = NULL;
+  this->NumberOfBuckets = 0;
+  this->FreeCellBounds();
+}
+
+//----------------------------------------------------------------------------
+// Distribute numCells / NumberOfCellsPerNode buckets in proportion to the
+// size of the bounds in each direction. Directions much thinner than the
+// others get a single division.
+void vtkStaticCellLocator::ComputeDivisions(vtkIdType numCells)
+{
+  double lengths[3], maxLength = 0.0;
+  int i;
+  for (i=0; i<3; i++)
+    {
+    lengths[i] = this->Bounds[2*i+1] - this->Bounds[2*i];
+    maxLength = (lengths[i] > maxLength ? lengths[i] : maxLength);
+    }
+
+  double volume = 1.0;
+  int numDims = 0;
+  for (i=0; i<3; i++)
+    {
+    if ( lengths[i] > 1.0e-03 * maxLength )
+      {
+      volume *= lengths[i];
+      numDims++;
+      }
+    }
+
+  double numBuckets = static_cast<double>(numCells) /
+    this->NumberOfCellsPerNode;
+  double f = (numDims > 0 ?
+              pow(numBuckets / volume, 1.0 / numDims) : 0.0);
+  for (i=0; i<3; i++)
+    {
+    if ( lengths[i] > 1.0e-03 * maxLength )
+      {
+      double ndivs = ceil(lengths[i] * f);
+      this->Divisions[i] = static_cast<int>(
+        ndivs < VTK_INT_MAX ? ndivs : VTK_INT_MAX);
+      }
+    else
+      {
+      this->Divisions[i] = 1;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::BuildLocator()
+{
+  vtkIdType numCells;
+
+  if ( (this->Offsets != NULL) && (this->BuildTime > this->MTime)
+       && (this->BuildTime > this->DataSet->GetMTime()) )
+    {
+    return;
+    }
+  if ( (this->Offsets != NULL) && this->UseExistingSearchStructure )
+    {
+    this->BuildTime.Modified();
+    vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
+    return;
+    }
+
+  vtkDebugMacro( << "Binning cells..." );
+  this->Level = 1; //only single lowest level
+
+  if ( !this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1 )
+    {
+    vtkErrorMacro( << "No cells to subdivide");
+    return;
+    }
+
+  this->FreeSearchStructure();
+
+  //
+  //  Size the root bucket and compute the divisions.
+  //
+  double *bounds = this->DataSet->GetBounds();
+  int i;
+  for (i=0; i<6; i++)
+    {
+    this->Bounds[i] = bounds[i];
+    }
+  if ( this->Automatic )
+    {
+    this->ComputeDivisions(numCells);
+    }
+  double origin[3];
+  for (i=0; i<3; i++)
+    {
+    if ( this->Bounds[2*i+1] <= this->Bounds[2*i] ) //prevent zero width
+      {
+      this->Bounds[2*i+1] = this->Bounds[2*i] + 1.0;
+      }
+    this->Divisions[i] = (this->Divisions[i] > 0 ? this->Divisions[i] : 1);
+    this->H[i] = (this->Bounds[2*i+1] - this->Bounds[2*i]) /
+      this->Divisions[i];
+    origin[i] = this->Bounds[2*i];
+    }
+  this->NumberOfBuckets = static_cast<vtkIdType>(this->Divisions[0]) *
+    this->Divisions[1] * this->Divisions[2];
+
+  //
+  //  Compute the cell bounds and count the buckets they overlap, turn the
+  //  counts into offsets, then write and sort the (bucket, cell id) pairs.
+  //  The first cell is accessed serially so that the dataset builds the
+  //  structures it needs before the threads query it.
+  //
+  this->DataSet->GetCell(0, this->GenericCell);
+  this->CellBounds = new double [numCells][6];
+  vtkIdType *cellOffsets = new vtkIdType[numCells + 1];
+  vtkStaticCellLocatorBounds bounder(this->DataSet, this->CellBounds,
+                                     cellOffsets, origin, this->H,
+                                     this->Divisions);
+  vtkSMPTools::For(0, numCells, bounder);
+
+  vtkIdType lastCount = cellOffsets[numCells-1];
+  vtkSMPTools::ExclusiveScan(cellOffsets, cellOffsets + numCells,
+                             cellOffsets, static_cast<vtkIdType>(0));
+  vtkIdType numPairs = cellOffsets[numCells-1] + lastCount;
+  cellOffsets[numCells] = numPairs;
+
+  vtkStaticCellLocatorTuple *map = new vtkStaticCellLocatorTuple[numPairs];
+  vtkStaticCellLocatorBin binner(this->CellBounds, cellOffsets, map, origin,
+                                 this->H, this->Divisions);
+  vtkSMPTools::For(0, numCells, binner);
+  delete [] cellOffsets;
+  vtkSMPTools::Sort(map, map + numPairs);
+
+  this->Offsets = new vtkIdType[this->NumberOfBuckets + 1];
+  this->CellIds = new vtkIdType[numPairs];
+  vtkStaticCellLocatorOffsets offsets(map, this->Offsets, this->CellIds);
+  vtkSMPTools::For(0, numPairs, offsets);
+  std::fill(this->Offsets + (numPairs > 0 ? map[numPairs-1].Bucket + 1 : 0),
+            this->Offsets + this->NumberOfBuckets + 1, numPairs);
+  delete [] map;
+
+  this->BuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::GetBucketIndices(const double x[3], int ijk[3])
+{
+  for (int j=0; j<3; j++)
+    {
+    double t = (x[j] - this->Bounds[2*j]) / this->H[j];
+    ijk[j] = (t < 1.0 ? 0 : (t >= this->Divisions[j] - 1 ?
+                             this->Divisions[j] - 1 : static_cast<int>(t)));
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkStaticCellLocator::InsideCellBounds(double x[3], vtkIdType cellId)
+{
+  if ( !this->CellBounds )
+    {
+    return this->Superclass::InsideCellBounds(x, cellId);
+    }
+  const double *bounds = this->CellBounds[cellId];
+  return bounds[0] <= x[0] && x[0] <= bounds[1] &&
+    bounds[2] <= x[1] && x[1] <= bounds[3] &&
+    bounds[4] <= x[2] && x[2] <= bounds[5];
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticCellLocator::FindCell(
+  double x[3], double tol2, vtkGenericCell *cell,
+  double pcoords[3], double *weights)
+{
+  if ( !this->Offsets )
+    {
+    return -1;
+    }
+
+  double tol = sqrt(tol2);
+  for (int i=0; i<3; i++)
+    {
+    if ( x[i] < this->Bounds[2*i] - tol || x[i] > this->Bounds[2*i+1] + tol )
+      {
+      return -1;
+      }
+    }
+
+  int ijk[3], subId;
+  double closest[3], dist2;
+  this->GetBucketIndices(x, ijk);
+  vtkIdType bucket = ijk[0] + ijk[1]*this->Divisions[0] +
+    ijk[2]*static_cast<vtkIdType>(this->Divisions[0])*this->Divisions[1];
+
+  for (vtkIdType p=this->Offsets[bucket]; p < this->Offsets[bucket+1]; p++)
+    {
+    vtkIdType cellId = this->CellIds[p];
+    const double *bounds = this->CellBounds[cellId];
+    if ( x[0] < bounds[0] - tol || x[0] > bounds[1] + tol ||
+         x[1] < bounds[2] - tol || x[1] > bounds[3] + tol ||
+         x[2] < bounds[4] - tol || x[2] > bounds[5] + tol )
+      {
+      continue;
+      }
+    this->DataSet->GetCell(cellId, cell);
+    if ( cell->EvaluatePosition(x, closest, subId, pcoords, dist2, weights) == 1
+         && dist2 <= tol2 )
+      {
+      return cellId;
+      }
+    }
+
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+int vtkStaticCellLocator::IntersectWithLine(
+  double p1[3], double p2[3], double tol, double& t, double x[3],
+  double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell)
+{
+  cellId = -1;
+  if ( !this->Offsets )
+    {
+    return 0;
+    }
+
+  double dir[3] = {p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2]};
+  vtkStaticCellLocatorLineWalker walker(p1, dir, this->Bounds, this->H,
+                                        this->Divisions);
+  vtkIdType sliceSize =
+    static_cast<vtkIdType>(this->Divisions[0]) * this->Divisions[1];
+  double tHit, xHit[3], pcoordsHit[3], tExit;
+  int subIdHit, ijk[3];
+  t = VTK_DOUBLE_MAX;
+
+  // The cells of a bucket can only be beaten by cells of the next buckets
+  // if the intersection found lies past the bucket.
+  for ( ; walker.GetBucket(ijk, tExit) && (cellId < 0 || t > tExit);
+        walker.Next() )
+    {
+    vtkIdType bucket = ijk[0] + ijk[1]*this->Divisions[0] + ijk[2]*sliceSize;
+    for (vtkIdType p=this->Offsets[bucket]; p < this->Offsets[bucket+1]; p++)
+      {
+      vtkIdType cId = this->CellIds[p];
+      double t0 = 0.0, t1 = 1.0;
+      if ( !vtkStaticCellLocatorClipLine(p1, dir, this->CellBounds[cId], tol,
+                                         t0, t1) || t0 >= t )
+        {
+        continue;
+        }
+      this->DataSet->GetCell(cId, cell);
+      if ( cell->IntersectWithLine(p1, p2, tol, tHit, xHit, pcoordsHit,
+                                   subIdHit) && tHit < t )
+        {
+        cellId = cId;
+        t = tHit;
+        subId = subIdHit;
+        for (int i=0; i<3; i++)
+          {
+          x[i] = xHit[i];
+          pcoords[i] = pcoordsHit[i];
+          }
+        }
+      }
+    }
+
+  if ( cellId < 0 )
+    {
+    return 0;
+    }
+  this->DataSet->GetCell(cellId, cell);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::FindCellsWithinBounds(double *bbox,
+                                                 vtkIdList *cells)
+{
+  cells->Reset();
+  if ( !this->Offsets )
+    {
+    return;
+    }
+  for (int i=0; i<3; i++)
+    {
+    if ( bbox[2*i+1] < this->Bounds[2*i] || bbox[2*i] > this->Bounds[2*i+1] )
+      {
+      return;
+      }
+    }
+
+  int min[3], max[3];
+  double origin[3] = {this->Bounds[0], this->Bounds[2], this->Bounds[4]};
+  vtkStaticCellLocatorBucketRange(bbox, origin, this->H, this->Divisions,
+                                  min, max);
+  vtkIdType sliceSize =
+    static_cast<vtkIdType>(this->Divisions[0]) * this->Divisions[1];
+  std::vector<vtkIdType> found;
+  for (int k=min[2]; k <= max[2]; k++)
+    {
+    for (int j=min[1]; j <= max[1]; j++)
+      {
+      for (int i=min[0]; i <= max[0]; i++)
+        {
+        vtkIdType bucket = i + j*this->Divisions[0] + k*sliceSize;
+        for (vtkIdType p=this->Offsets[bucket]; p < this->Offsets[bucket+1];
+             p++)
+          {
+          vtkIdType cellId = this->CellIds[p];
+          const double *bounds = this->CellBounds[cellId];
+          if ( bounds[0] <= bbox[1] && bbox[0] <= bounds[1] &&
+               bounds[2] <= bbox[3] && bbox[2] <= bounds[3] &&
+               bounds[4] <= bbox[5] && bbox[4] <= bounds[5] )
+            {
+            found.push_back(cellId);
+            }
+          }
+        }
+      }
+    }
+
+  std::sort(found.begin(), found.end());
+  found.erase(std::unique(found.begin(), found.end()), found.end());
+  cells->SetNumberOfIds(static_cast<vtkIdType>(found.size()));
+  for (size_t n=0; n < found.size(); n++)
+    {
+    cells->SetId(static_cast<vtkIdType>(n), found[n]);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::FindCellsAlongLine(
+  double p1[3], double p2[3], double vtkNotUsed(tolerance), vtkIdList *cells)
+{
+  cells->Reset();
+  if ( !this->Offsets )
+    {
+    return;
+    }
+
+  double dir[3] = {p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2]};
+  vtkStaticCellLocatorLineWalker walker(p1, dir, this->Bounds, this->H,
+                                        this->Divisions);
+  vtkIdType sliceSize =
+    static_cast<vtkIdType>(this->Divisions[0]) * this->Divisions[1];
+  std::vector<vtkIdType> found;
+  double tExit;
+  int ijk[3];
+  for ( ; walker.GetBucket(ijk, tExit); walker.Next() )
+    {
+    vtkIdType bucket = ijk[0] + ijk[1]*this->Divisions[0] + ijk[2]*sliceSize;
+    found.insert(found.end(), this->CellIds + this->Offsets[bucket],
+                 this->CellIds + this->Offsets[bucket+1]);
+    }
+
+  std::sort(found.begin(), found.end());
+  found.erase(std::unique(found.begin(), found.end()), found.end());
+  cells->SetNumberOfIds(static_cast<vtkIdType>(found.size()));
+  for (size_t n=0; n < found.size(); n++)
+    {
+    cells->SetId(static_cast<vtkIdType>(n), found[n]);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Build polygonal representation of locator. Create faces that separate
+// inside/outside buckets, or separate inside/boundary of locator.
+void vtkStaticCellLocator::GenerateRepresentation(int vtkNotUsed(level),
+                                                  vtkPolyData *pd)
+{
+  if ( this->Offsets == NULL )
+    {
+    vtkErrorMacro(<<"Can't build representation...no data!");
+    return;
+    }
+
+  vtkPoints *pts = vtkPoints::New();
+  pts->Allocate(5000);
+  vtkCellArray *polys = vtkCellArray::New();
+  polys->Allocate(10000);
+
+  int *divs = this->Divisions;
+  vtkIdType strides[3] = {1, divs[0], static_cast<vtkIdType>(divs[0])*divs[1]};
+  int ijk[3];
+  for (ijk[2]=0; ijk[2] < divs[2]; ijk[2]++)
+    {
+    for (ijk[1]=0; ijk[1] < divs[1]; ijk[1]++)
+      {
+      for (ijk[0]=0; ijk[0] < divs[0]; ijk[0]++)
+        {
+        vtkIdType idx = ijk[0] + ijk[1]*strides[1] + ijk[2]*strides[2];
+        int inside = this->Offsets[idx+1] > this->Offsets[idx];
+        for (int ii=0; ii < 3; ii++)
+          {
+          // faces between this bucket and its "negative" neighbor
+          int neiInside = 0;
+          if ( ijk[ii] > 0 )
+            {
+            vtkIdType nei = idx - strides[ii];
+            neiInside = this->Offsets[nei+1] > this->Offsets[nei];
+            }
+          if ( inside != neiInside )
+            {
+            this->GenerateFace(ii,ijk[0],ijk[1],ijk[2],pts,polys);
+            }
+          // buckets on "positive" boundaries
+          if ( inside && ijk[ii] + 1 >= divs[ii] )
+            {
+            int next[3] = {ijk[0], ijk[1], ijk[2]};
+            next[ii]++;
+            this->GenerateFace(ii,next[0],next[1],next[2],pts,polys);
+            }
+          }
+        }
+      }
+    }
+
+  pd->SetPoints(pts);
+  pts->Delete();
+  pd->SetPolys(polys);
+  polys->Delete();
+  pd->Squeeze();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::GenerateFace(int face, int i, int j, int k,
+                                        vtkPoints *pts, vtkCellArray *polys)
+{
+  vtkIdType ids[4];
+  double origin[3], x[3];
+  int u = (face + 1) % 3, v = (face + 2) % 3;
+
+  // define first corner, then walk around the face
+  origin[0] = this->Bounds[0] + i * this->H[0];
+  origin[1] = this->Bounds[2] + j * this->H[1];
+  origin[2] = this->Bounds[4] + k * this->H[2];
+  ids[0] = pts->InsertNextPoint(origin);
+
+  x[0] = origin[0]; x[1] = origin[1]; x[2] = origin[2];
+  x[u] += this->H[u];
+  ids[1] = pts->InsertNextPoint(x);
+  x[v] += this->H[v];
+  ids[2] = pts->InsertNextPoint(x);
+  x[u] = origin[u];
+  ids[3] = pts->InsertNextPoint(x);
+
+  polys->InsertNextCell(4,ids);
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Divisions: (" << this->Divisions[0] << ", "
+     << this->Divisions[1] << ", " << this->Divisions[2] << ")\n";
+  os << indent << "Number of Buckets: " << this->NumberOfBuckets << "\n";
+}
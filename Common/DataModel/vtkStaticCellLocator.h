@@ -0,0 +1,147 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticCellLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStaticCellLocator - cell locator built in parallel for concurrent queries
+// .SECTION Description
+// vtkStaticCellLocator divides the bounds of a dataset into uniform buckets
+// and records each cell in every bucket its bounding box overlaps. The
+// buckets are stored in two flat arrays, like vtkStaticPointLocator:
+// CellIds holds the cell ids sorted by bucket and Offsets holds, for each
+// bucket, the location of its first cell id in CellIds. The bounds of the
+// cells, the (bucket, cell id) pairs and the offsets are all computed in
+// parallel with vtkSMPTools.
+//
+// Unlike vtkCellLocator, the queries do not modify the locator: the cell
+// being evaluated is the vtkGenericCell passed by the caller, and no other
+// state is kept between calls. FindCell(), IntersectWithLine(),
+// FindCellsWithinBounds() and FindCellsAlongLine() taking a vtkGenericCell
+// may therefore be called from several threads at once after
+// BuildLocator() was called, each thread passing its own cell. The
+// overloads without a vtkGenericCell use one owned by the locator and are
+// not thread safe.
+//
+// The locator can be used wherever a vtkAbstractCellLocator is expected,
+// for instance as the prototype of
+// vtkCellLocatorInterpolatedVelocityField.
+//
+// .SECTION Caveats
+// FindClosestPoint() and FindClosestPointWithinRadius() are not supported.
+//
+// .SECTION See Also
+// vtkCellLocator vtkAbstractCellLocator vtkStaticPointLocator vtkSMPTools
+
+#ifndef vtkStaticCellLocator_h
+#define vtkStaticCellLocator_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkAbstractCellLocator.h"
+
+class vtkCellArray;
+class vtkPoints;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkStaticCellLocator : public vtkAbstractCellLocator
+{
+public:
+  // Description:
+  // Construct with automatic computation of divisions, averaging
+  // 10 cells per bucket.
+  static vtkStaticCellLocator *New();
+
+  vtkTypeMacro(vtkStaticCellLocator,vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Re-use any superclass signatures that we don't override.
+  using vtkAbstractCellLocator::IntersectWithLine;
+  using vtkAbstractCellLocator::FindCell;
+
+  // Description:
+  // Set the number of divisions in x-y-z directions. Only used when
+  // Automatic is off.
+  vtkSetVector3Macro(Divisions,int);
+  vtkGetVectorMacro(Divisions,int,3);
+
+  // Description:
+  // Return the intersection point closest to p1, if any, of the finite
+  // line (p1,p2) with the cells, and the cell intersected. cell is used as
+  // scratch space and holds the intersected cell on return. Thread safe
+  // after BuildLocator() was called, as long as each thread passes its own
+  // cell.
+  virtual int IntersectWithLine(
+    double p1[3], double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell);
+
+  // Description:
+  // Find the cell containing x within the squared tolerance tol2. Returns
+  // -1 if no cell is found. cell receives the cell and weights its
+  // interpolation weights, which must hold as many values as the cell has
+  // points. Thread safe after BuildLocator() was called, as long as each
+  // thread passes its own cell and weights.
+  virtual vtkIdType FindCell(
+    double x[3], double tol2, vtkGenericCell *cell,
+    double pcoords[3], double *weights);
+
+  // Description:
+  // Return the unique ids, sorted, of the cells whose bounds overlap the
+  // bounding box. Thread safe after BuildLocator() was called.
+  virtual void FindCellsWithinBounds(double *bbox, vtkIdList *cells);
+
+  // Description:
+  // Return the unique ids, sorted, of the cells in the buckets traversed
+  // by the line (p1,p2). Thread safe after BuildLocator() was called.
+  virtual void FindCellsAlongLine(
+    double p1[3], double p2[3], double tolerance, vtkIdList *cells);
+
+  // Description:
+  // Quickly test if a point is inside the bounds of a particular cell.
+  virtual bool InsideCellBounds(double x[3], vtkIdType cellId);
+
+  // Description:
+  // Get the number of buckets, and the number and ids of the cells in a
+  // bucket. The buckets are ordered by increasing i, then j, then k.
+  vtkIdType GetNumberOfBuckets()
+    {return this->NumberOfBuckets;}
+  vtkIdType GetNumberOfCellsInBucket(vtkIdType bucket)
+    {return this->Offsets[bucket+1] - this->Offsets[bucket];}
+  const vtkIdType *GetCellIdsInBucket(vtkIdType bucket)
+    {return this->CellIds + this->Offsets[bucket];}
+
+  // Description:
+  // See vtkLocator interface documentation.
+  // These methods are not thread safe.
+  virtual void FreeSearchStructure();
+  virtual void BuildLocator();
+  virtual void GenerateRepresentation(int level, vtkPolyData *pd);
+
+protected:
+  vtkStaticCellLocator();
+  ~vtkStaticCellLocator();
+
+  void ComputeDivisions(vtkIdType numCells);
+  void GetBucketIndices(const double x[3], int ijk[3]);
+  void GenerateFace(int face, int i, int j, int k,
+                    vtkPoints *pts, vtkCellArray *polys);
+
+  double Bounds[6]; // bounding box of the buckets
+  int Divisions[3]; // Number of sub-divisions in x-y-z directions
+  double H[3]; // Width of each bucket in x-y-z directions
+  vtkIdType NumberOfBuckets;
+  vtkIdType *Offsets; // NumberOfBuckets + 1 locations into CellIds
+  vtkIdType *CellIds; // cell ids sorted by bucket
+
+private:
+  vtkStaticCellLocator(const vtkStaticCellLocator&);  // Not implemented.
+  void operator=(const vtkStaticCellLocator&);  // Not implemented.
+};
+
+#endif
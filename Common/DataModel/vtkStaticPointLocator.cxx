@@ -0,0 +1,720 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticPointLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticPointLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkStaticPointLocator);
+
+namespace
+{
+
+// A point and the bucket containing it. Sorting the pairs groups the points
+// by bucket, by increasing id within each bucket.
+struct vtkStaticPointLocatorTuple
+{
+  vtkIdType Bucket;
+  vtkIdType PtId;
+
+  bool operator<(const vtkStaticPointLocatorTuple& other) const
+  {
+    return this->Bucket < other.Bucket ||
+      (this->Bucket == other.Bucket && this->PtId < other.PtId);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Compute the bucket of each point.
+class vtkStaticPointLocatorBin
+{
+  vtkStaticPointLocator *Locator;
+  vtkDataSet *DataSet;
+  vtkStaticPointLocatorTuple *Map;
+  vtkIdType Strides[2];
+public:
+  vtkStaticPointLocatorBin(vtkStaticPointLocator *locator, vtkDataSet *ds,
+                           const int divs[3], vtkStaticPointLocatorTuple *map)
+    : Locator(locator), DataSet(ds), Map(map)
+  {
+    this->Strides[0] = divs[0];
+    this->Strides[1] = static_cast<vtkIdType>(divs[0]) * divs[1];
+  }
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    int ijk[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      this->DataSet->GetPoint(ptId, x);
+      this->Locator->GetBucketIndices(x, ijk);
+      this->Map[ptId].Bucket = ijk[0] + ijk[1] * this->Strides[0] +
+        ijk[2] * this->Strides[1];
+      this->Map[ptId].PtId = ptId;
+      }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Copy the sorted point ids, and record the first location of each bucket
+// where the bucket changes in the sorted pairs. Empty buckets get the
+// location of the next non-empty one.
+class vtkStaticPointLocatorOffsets
+{
+  const vtkStaticPointLocatorTuple *Map;
+  vtkIdType *Offsets;
+  vtkIdType *PointIds;
+public:
+  vtkStaticPointLocatorOffsets(const vtkStaticPointLocatorTuple *map,
+                               vtkIdType *offsets, vtkIdType *ptIds)
+    : Map(map), Offsets(offsets), PointIds(ptIds) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->PointIds[i] = this->Map[i].PtId;
+      vtkIdType prev = (i > 0 ? this->Map[i-1].Bucket : -1);
+      for (vtkIdType bucket = prev + 1; bucket <= this->Map[i].Bucket;
+           ++bucket)
+        {
+        this->Offsets[bucket] = i;
+        }
+      }
+  }
+};
+
+}
+
+//----------------------------------------------------------------------------
+vtkStaticPointLocator::vtkStaticPointLocator()
+{
+  this->Divisions[0] = this->Divisions[1] = this->Divisions[2] = 50;
+  this->NumberOfPointsPerBucket = 3;
+  this->H[0] = this->H[1] = this->H[2] = 0.0;
+  this->NumberOfBuckets = 0;
+  this->Offsets = NULL;
+  this->PointIds = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkStaticPointLocator::~vtkStaticPointLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FreeSearchStructure()
+{
+  delete [] this->Offsets;
+  this->Offsets = NULL;
+  delete [] this->PointIds;
+  this->PointIds = NULL;
+  this->NumberOfBuckets = 0;
+}
+
+//----------------------------------------------------------------------------
+// Distribute numPts / NumberOfPointsPerBucket buckets in proportion to the
+// size of the bounds in each direction. Directions much thinner than the
+// others get a single division.
+void vtkStaticPointLocator::ComputeDivisions(vtkIdType numPts)
+{
+  double lengths[3], maxLength = 0.0;
+  int i;
+  for (i=0; i<3; i++)
+    {
+    lengths[i] = this->Bounds[2*i+1] - this->Bounds[2*i];
+    maxLength = (lengths[i] > maxLength ? lengths[i] : maxLength);
+    }
+
+  double volume = 1.0;
+  int numDims = 0;
+  for (i=0; i<3; i++)
+    {
+    if ( lengths[i] > 1.0e-03 * maxLength )
+      {
+      volume *= lengths[i];
+      numDims++;
+      }
+    }
+
+  double numBuckets = static_cast<double>(numPts) /
+    this->NumberOfPointsPerBucket;
+  double f = (numDims > 0 ?
+              pow(numBuckets / volume, 1.0 / numDims) : 0.0);
+  for (i=0; i<3; i++)
+    {
+    if ( lengths[i] > 1.0e-03 * maxLength )
+      {
+      double ndivs = ceil(lengths[i] * f);
+      this->Divisions[i] = static_cast<int>(
+        ndivs < VTK_INT_MAX ? ndivs : VTK_INT_MAX);
+      }
+    else
+      {
+      this->Divisions[i] = 1;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::BuildLocator()
+{
+  vtkIdType numPts;
+
+  if ( (this->Offsets != NULL) && (this->BuildTime > this->MTime)
+       && (this->BuildTime > this->DataSet->GetMTime()) )
+    {
+    return;
+    }
+
+  vtkDebugMacro( << "Binning points..." );
+  this->Level = 1; //only single lowest level
+
+  if ( !this->DataSet || (numPts = this->DataSet->GetNumberOfPoints()) < 1 )
+    {
+    vtkErrorMacro( << "No points to subdivide");
+    return;
+    }
+
+  this->FreeSearchStructure();
+
+  //
+  //  Size the root bucket and compute the divisions.
+  //
+  double *bounds = this->DataSet->GetBounds();
+  int i;
+  for (i=0; i<3; i++)
+    {
+    this->Bounds[2*i] = bounds[2*i];
+    this->Bounds[2*i+1] = bounds[2*i+1];
+    }
+  if ( this->Automatic )
+    {
+    this->ComputeDivisions(numPts);
+    }
+  for (i=0; i<3; i++)
+    {
+    if ( this->Bounds[2*i+1] <= this->Bounds[2*i] ) //prevent zero width
+      {
+      this->Bounds[2*i+1] = this->Bounds[2*i] + 1.0;
+      }
+    this->Divisions[i] = (this->Divisions[i] > 0 ? this->Divisions[i] : 1);
+    this->H[i] = (this->Bounds[2*i+1] - this->Bounds[2*i]) /
+      this->Divisions[i];
+    }
+  this->NumberOfBuckets = static_cast<vtkIdType>(this->Divisions[0]) *
+    this->Divisions[1] * this->Divisions[2];
+
+  //
+  //  Bin the points, sort them by bucket and find where each bucket starts.
+  //  The dataset must be able to return points from several threads.
+  //
+  double x[3];
+  this->DataSet->GetPoint(0, x);
+  vtkStaticPointLocatorTuple *map = new vtkStaticPointLocatorTuple[numPts];
+  vtkStaticPointLocatorBin binner(this, this->DataSet, this->Divisions,
+                                  map);
+  vtkSMPTools::For(0, numPts, binner);
+  vtkSMPTools::Sort(map, map + numPts);
+
+  this->Offsets = new vtkIdType[this->NumberOfBuckets + 1];
+  this->PointIds = new vtkIdType[numPts];
+  vtkStaticPointLocatorOffsets offsets(map, this->Offsets, this->PointIds);
+  vtkSMPTools::For(0, numPts, offsets);
+  std::fill(this->Offsets + map[numPts-1].Bucket + 1,
+            this->Offsets + this->NumberOfBuckets + 1, numPts);
+  delete [] map;
+
+  this->BuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::GetBucketIndices(const double x[3], int ijk[3])
+{
+  for (int j=0; j<3; j++)
+    {
+    // Clamp before the conversion so that far away positions do not
+    // overflow.
+    double t = ((x[j] - this->Bounds[2*j]) /
+                (this->Bounds[2*j+1] - this->Bounds[2*j])) * this->Divisions[j];
+    if ( t < 1.0 )
+      {
+      ijk[j] = 0;
+      }
+    else if ( t >= this->Divisions[j] - 1 )
+      {
+      ijk[j] = this->Divisions[j] - 1;
+      }
+    else
+      {
+      ijk[j] = static_cast<int>(t);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Get the range of buckets overlapping the box of half width radius
+// centered at x.
+void vtkStaticPointLocator::GetBucketRange(const double x[3], double radius,
+                                           int min[3], int max[3])
+{
+  double lo[3], hi[3];
+  for (int i=0; i<3; i++)
+    {
+    lo[i] = x[i] - radius;
+    hi[i] = x[i] + radius;
+    }
+  this->GetBucketIndices(lo, min);
+  this->GetBucketIndices(hi, max);
+}
+
+//----------------------------------------------------------------------------
+double vtkStaticPointLocator::Distance2ToBucket(const double x[3],
+                                                int i, int j, int k)
+{
+  int ijk[3] = {i, j, k};
+  double d2 = 0.0;
+  for (int n=0; n<3; n++)
+    {
+    double lo = this->Bounds[2*n] + ijk[n] * this->H[n];
+    double hi = lo + this->H[n];
+    double delta = 0.0;
+    if ( x[n] < lo )
+      {
+      delta = lo - x[n];
+      }
+    else if ( x[n] > hi )
+      {
+      delta = x[n] - hi;
+      }
+    d2 += delta * delta;
+    }
+  return d2;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticPointLocator::FindClosestPoint(const double x[3])
+{
+  if ( !this->DataSet || this->DataSet->GetNumberOfPoints() < 1 )
+    {
+    return -1;
+    }
+
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+
+  int ijk[3], i, j, k;
+  this->GetBucketIndices(x, ijk);
+  int *divs = this->Divisions;
+  vtkIdType sliceSize = static_cast<vtkIdType>(divs[0]) * divs[1];
+  vtkIdType closest = -1, ptId, bucket;
+  double minDist2 = VTK_DOUBLE_MAX, dist2, pt[3];
+
+  //
+  //  Search the shells of buckets around the bucket of x, one level at a
+  //  time, until a point is found.
+  //
+  int level;
+  for (level=0; closest == -1 &&
+         (level < divs[0] || level < divs[1] || level < divs[2]); level++)
+    {
+    int min[3], max[3];
+    for (i=0; i<3; i++)
+      {
+      min[i] = (ijk[i] - level > 0 ? ijk[i] - level : 0);
+      max[i] = (ijk[i] + level < divs[i] ? ijk[i] + level : divs[i] - 1);
+      }
+    for (k=min[2]; k <= max[2]; k++)
+      {
+      for (j=min[1]; j <= max[1]; j++)
+        {
+        for (i=min[0]; i <= max[0]; i++)
+          {
+          if ( abs(i - ijk[0]) != level && abs(j - ijk[1]) != level &&
+               abs(k - ijk[2]) != level )
+            {
+            continue; // inside the shell, already searched
+            }
+          bucket = i + j*divs[0] + k*sliceSize;
+          for (vtkIdType p=this->Offsets[bucket]; p < this->Offsets[bucket+1];
+               p++)
+            {
+            ptId = this->PointIds[p];
+            this->DataSet->GetPoint(ptId, pt);
+            if ( (dist2 = vtkMath::Distance2BetweenPoints(x,pt)) < minDist2 )
+              {
+              closest = ptId;
+              minDist2 = dist2;
+              }
+            }
+          }
+        }
+      }
+    }
+
+  //
+  // A closer point may lie in a bucket outside the shells searched so far,
+  // within the sphere through the point found.
+  //
+  if ( minDist2 > 0.0 )
+    {
+    level--;
+    int min[3], max[3];
+    this->GetBucketRange(x, sqrt(minDist2), min, max);
+    for (k=min[2]; k <= max[2]; k++)
+      {
+      for (j=min[1]; j <= max[1]; j++)
+        {
+        for (i=min[0]; i <= max[0]; i++)
+          {
+          if ( (abs(i - ijk[0]) <= level && abs(j - ijk[1]) <= level &&
+                abs(k - ijk[2]) <= level) ||
+               this->Distance2ToBucket(x, i, j, k) >= minDist2 )
+            {
+            continue;
+            }
+          bucket = i + j*divs[0] + k*sliceSize;
+          for (vtkIdType p=this->Offsets[bucket]; p < this->Offsets[bucket+1];
+               p++)
+            {
+            ptId = this->PointIds[p];
+            this->DataSet->GetPoint(ptId, pt);
+            if ( (dist2 = vtkMath::Distance2BetweenPoints(x,pt)) < minDist2 )
+              {
+              closest = ptId;
+              minDist2 = dist2;
+              }
+            }
+          }
+        }
+      }
+    }
+
+  return closest;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticPointLocator::FindClosestPointWithinRadius(
+  double radius, const double x[3], double& dist2)
+{
+  vtkIdType closest = -1;
+  dist2 = VTK_DOUBLE_MAX;
+
+  if ( !this->DataSet || this->DataSet->GetNumberOfPoints() < 1 )
+    {
+    return -1;
+    }
+
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+
+  int min[3], max[3], i, j, k;
+  this->GetBucketRange(x, radius, min, max);
+  int *divs = this->Divisions;
+  vtkIdType sliceSize = static_cast<vtkIdType>(divs[0]) * divs[1];
+  double minDist2 = radius * radius, d2, pt[3];
+
+  for (k=min[2]; k <= max[2]; k++)
+    {
+    for (j=min[1]; j <= max[1]; j++)
+      {
+      for (i=min[0]; i <= max[0]; i++)
+        {
+        if ( this->Distance2ToBucket(x, i, j, k) > minDist2 )
+          {
+          continue;
+          }
+        vtkIdType bucket = i + j*divs[0] + k*sliceSize;
+        for (vtkIdType p=this->Offsets[bucket]; p < this->Offsets[bucket+1];
+             p++)
+          {
+          vtkIdType ptId = this->PointIds[p];
+          this->DataSet->GetPoint(ptId, pt);
+          if ( (d2 = vtkMath::Distance2BetweenPoints(x,pt)) <= minDist2 &&
+               (closest == -1 || d2 < minDist2) )
+            {
+            closest = ptId;
+            minDist2 = d2;
+            }
+          }
+        }
+      }
+    }
+
+  if ( closest != -1 )
+    {
+    dist2 = minDist2;
+    }
+  return closest;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestNPoints(int N, const double x[3],
+                                               vtkIdList *result)
+{
+  result->Reset();
+  if ( N <= 0 || !this->DataSet || this->DataSet->GetNumberOfPoints() < 1 )
+    {
+    return;
+    }
+
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+
+  vtkIdType numPts = this->DataSet->GetNumberOfPoints();
+  vtkIdType numWanted = (N < numPts ? N : numPts);
+  int ijk[3], min[3], max[3], i, j, k;
+  this->GetBucketIndices(x, ijk);
+  int *divs = this->Divisions;
+  vtkIdType sliceSize = static_cast<vtkIdType>(divs[0]) * divs[1];
+  double pt[3];
+  typedef std::vector<std::pair<double, vtkIdType> > DistanceList;
+  DistanceList candidates;
+
+  //
+  //  Grow a cube of buckets around the bucket of x until it holds N points.
+  //  The N-th closest of them bounds the distance to the N closest points.
+  //
+  for (int level=0; ; level++)
+    {
+    vtkIdType count = 0;
+    for (i=0; i<3; i++)
+      {
+      min[i] = (ijk[i] - level > 0 ? ijk[i] - level : 0);
+      max[i] = (ijk[i] + level < divs[i] ? ijk[i] + level : divs[i] - 1);
+      }
+    for (k=min[2]; k <= max[2]; k++)
+      {
+      for (j=min[1]; j <= max[1]; j++)
+        {
+        vtkIdType row = j*divs[0] + k*sliceSize;
+        count += this->Offsets[row + max[0] + 1] - this->Offsets[row + min[0]];
+        }
+      }
+    if ( count >= numWanted )
+      {
+      break;
+      }
+    }
+
+  for (k=min[2]; k <= max[2]; k++)
+    {
+    for (j=min[1]; j <= max[1]; j++)
+      {
+      vtkIdType row = j*divs[0] + k*sliceSize;
+      for (vtkIdType p=this->Offsets[row + min[0]];
+           p < this->Offsets[row + max[0] + 1]; p++)
+        {
+        vtkIdType ptId = this->PointIds[p];
+        this->DataSet->GetPoint(ptId, pt);
+        candidates.push_back(
+          std::make_pair(vtkMath::Distance2BetweenPoints(x,pt), ptId));
+        }
+      }
+    }
+  std::nth_element(candidates.begin(), candidates.begin() + (numWanted - 1),
+                   candidates.end());
+  double maxDist2 = candidates[numWanted - 1].first;
+
+  //
+  //  Gather all the points within that distance, then keep the N closest.
+  //
+  candidates.clear();
+  this->GetBucketRange(x, sqrt(maxDist2), min, max);
+  for (k=min[2]; k <= max[2]; k++)
+    {
+    for (j=min[1]; j <= max[1]; j++)
+      {
+      for (i=min[0]; i <= max[0]; i++)
+        {
+        if ( this->Distance2ToBucket(x, i, j, k) > maxDist2 )
+          {
+          continue;
+          }
+        vtkIdType bucket = i + j*divs[0] + k*sliceSize;
+        for (vtkIdType p=this->Offsets[bucket]; p < this->Offsets[bucket+1];
+             p++)
+          {
+          vtkIdType ptId = this->PointIds[p];
+          this->DataSet->GetPoint(ptId, pt);
+          double d2 = vtkMath::Distance2BetweenPoints(x,pt);
+          if ( d2 <= maxDist2 )
+            {
+            candidates.push_back(std::make_pair(d2, ptId));
+            }
+          }
+        }
+      }
+    }
+  std::partial_sort(candidates.begin(), candidates.begin() + numWanted,
+                    candidates.end());
+
+  result->SetNumberOfIds(numWanted);
+  for (vtkIdType n=0; n < numWanted; n++)
+    {
+    result->SetId(n, candidates[n].second);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FindPointsWithinRadius(double R, const double x[3],
+                                                   vtkIdList *result)
+{
+  result->Reset();
+  if ( !this->DataSet || this->DataSet->GetNumberOfPoints() < 1 )
+    {
+    return;
+    }
+
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+
+  int min[3], max[3], i, j, k;
+  this->GetBucketRange(x, R, min, max);
+  int *divs = this->Divisions;
+  vtkIdType sliceSize = static_cast<vtkIdType>(divs[0]) * divs[1];
+  double R2 = R * R, pt[3];
+
+  for (k=min[2]; k <= max[2]; k++)
+    {
+    for (j=min[1]; j <= max[1]; j++)
+      {
+      for (i=min[0]; i <= max[0]; i++)
+        {
+        if ( this->Distance2ToBucket(x, i, j, k) > R2 )
+          {
+          continue;
+          }
+        vtkIdType bucket = i + j*divs[0] + k*sliceSize;
+        for (vtkIdType p=this->Offsets[bucket]; p < this->Offsets[bucket+1];
+             p++)
+          {
+          vtkIdType ptId = this->PointIds[p];
+          this->DataSet->GetPoint(ptId, pt);
+          if ( vtkMath::Distance2BetweenPoints(x,pt) <= R2 )
+            {
+            result->InsertNextId(ptId);
+            }
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Build polygonal representation of locator. Create faces that separate
+// inside/outside buckets, or separate inside/boundary of locator.
+void vtkStaticPointLocator::GenerateRepresentation(int vtkNotUsed(level),
+                                                   vtkPolyData *pd)
+{
+  if ( this->Offsets == NULL )
+    {
+    vtkErrorMacro(<<"Can't build representation...no data!");
+    return;
+    }
+
+  vtkPoints *pts = vtkPoints::New();
+  pts->Allocate(5000);
+  vtkCellArray *polys = vtkCellArray::New();
+  polys->Allocate(10000);
+
+  int *divs = this->Divisions;
+  vtkIdType sliceSize = static_cast<vtkIdType>(divs[0]) * divs[1];
+  vtkIdType strides[3] = {1, divs[0], sliceSize};
+  int ijk[3];
+  for (ijk[2]=0; ijk[2] < divs[2]; ijk[2]++)
+    {
+    for (ijk[1]=0; ijk[1] < divs[1]; ijk[1]++)
+      {
+      for (ijk[0]=0; ijk[0] < divs[0]; ijk[0]++)
+        {
+        vtkIdType idx = ijk[0] + ijk[1]*strides[1] + ijk[2]*strides[2];
+        int inside = this->Offsets[idx+1] > this->Offsets[idx];
+        for (int ii=0; ii < 3; ii++)
+          {
+          // faces between this bucket and its "negative" neighbor
+          int neiInside = 0;
+          if ( ijk[ii] > 0 )
+            {
+            vtkIdType nei = idx - strides[ii];
+            neiInside = this->Offsets[nei+1] > this->Offsets[nei];
+            }
+          if ( inside != neiInside )
+            {
+            this->GenerateFace(ii,ijk[0],ijk[1],ijk[2],pts,polys);
+            }
+          // buckets on "positive" boundaries
+          if ( inside && ijk[ii] + 1 >= divs[ii] )
+            {
+            int next[3] = {ijk[0], ijk[1], ijk[2]};
+            next[ii]++;
+            this->GenerateFace(ii,next[0],next[1],next[2],pts,polys);
+            }
+          }
+        }
+      }
+    }
+
+  pd->SetPoints(pts);
+  pts->Delete();
+  pd->SetPolys(polys);
+  polys->Delete();
+  pd->Squeeze();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::GenerateFace(int face, int i, int j, int k,
+                                         vtkPoints *pts, vtkCellArray *polys)
+{
+  vtkIdType ids[4];
+  double origin[3], x[3];
+  int u = (face + 1) % 3, v = (face + 2) % 3;
+
+  // define first corner, then walk around the face
+  origin[0] = this->Bounds[0] + i * this->H[0];
+  origin[1] = this->Bounds[2] + j * this->H[1];
+  origin[2] = this->Bounds[4] + k * this->H[2];
+  ids[0] = pts->InsertNextPoint(origin);
+
+  x[0] = origin[0]; x[1] = origin[1]; x[2] = origin[2];
+  x[u] += this->H[u];
+  ids[1] = pts->InsertNextPoint(x);
+  x[v] += this->H[v];
+  ids[2] = pts->InsertNextPoint(x);
+  x[u] = origin[u];
+  ids[3] = pts->InsertNextPoint(x);
+
+  polys->InsertNextCell(4,ids);
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number of Points Per Bucket: "
+     << this->NumberOfPointsPerBucket << "\n";
+  os << indent << "Divisions: (" << this->Divisions[0] << ", "
+     << this->Divisions[1] << ", " << this->Divisions[2] << ")\n";
+  os << indent << "Number of Buckets: " << this->NumberOfBuckets << "\n";
+}
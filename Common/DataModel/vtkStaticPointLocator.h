@@ -0,0 +1,140 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticPointLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStaticPointLocator - point locator built in parallel for read-only queries
+// .SECTION Description
+// vtkStaticPointLocator divides the bounds of the points of a dataset into
+// uniform buckets, like vtkPointLocator, but stores them in two flat arrays
+// instead of one vtkIdList per bucket: PointIds holds the point ids sorted
+// by bucket and Offsets holds, for each bucket, the location of its first
+// point id in PointIds, followed by the number of points. The locator is
+// built with vtkSMPTools: the bucket of each point is computed in parallel,
+// the (bucket, point id) pairs are sorted with vtkSMPTools::Sort() and the
+// offsets are found from the sorted pairs.
+//
+// Points cannot be inserted once the locator is built. The queries do not
+// modify the locator, so that FindClosestPoint(), FindClosestNPoints(),
+// FindPointsWithinRadius() and FindClosestPointWithinRadius() may be called
+// from several threads at once after BuildLocator() was called, each thread
+// passing its own result list.
+//
+// When the number of divisions is computed automatically, the buckets are
+// distributed according to the aspect ratio of the bounds, and flat
+// directions get a single division.
+//
+// .SECTION See Also
+// vtkPointLocator vtkAbstractPointLocator vtkStaticCellLinks vtkSMPTools
+
+#ifndef vtkStaticPointLocator_h
+#define vtkStaticPointLocator_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkAbstractPointLocator.h"
+
+class vtkCellArray;
+class vtkIdList;
+class vtkPoints;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkStaticPointLocator : public vtkAbstractPointLocator
+{
+public:
+  // Description:
+  // Construct with automatic computation of divisions, averaging
+  // 3 points per bucket.
+  static vtkStaticPointLocator *New();
+
+  vtkTypeMacro(vtkStaticPointLocator,vtkAbstractPointLocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set the number of divisions in x-y-z directions. Only used when
+  // Automatic is off.
+  vtkSetVector3Macro(Divisions,int);
+  vtkGetVectorMacro(Divisions,int,3);
+
+  // Description:
+  // Specify the average number of points in each bucket.
+  vtkSetClampMacro(NumberOfPointsPerBucket,int,1,VTK_INT_MAX);
+  vtkGetMacro(NumberOfPointsPerBucket,int);
+
+  // Description:
+  // Given a position x, return the id of the point closest to it, or -1 if
+  // there are no points. Thread safe once BuildLocator() was called.
+  virtual vtkIdType FindClosestPoint(const double x[3]);
+
+  // Description:
+  // Given a position x and a radius, return the id of the point closest to
+  // x within that radius, or -1 if there is none. dist2 returns the squared
+  // distance to the point. Thread safe once BuildLocator() was called.
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double radius, const double x[3], double& dist2);
+
+  // Description:
+  // Find the closest N points to a position, sorted from closest to
+  // farthest. Thread safe once BuildLocator() was called.
+  virtual void FindClosestNPoints(int N, const double x[3], vtkIdList *result);
+
+  // Description:
+  // Find all points within a specified radius R of position x. The result
+  // is not sorted in any specific manner. Thread safe once BuildLocator()
+  // was called.
+  virtual void FindPointsWithinRadius(double R, const double x[3],
+                                      vtkIdList *result);
+
+  // Description:
+  // Given a position x, return the indices of the bucket containing it.
+  // Positions outside the bounds are clamped to the closest bucket.
+  void GetBucketIndices(const double x[3], int ijk[3]);
+
+  // Description:
+  // Get the number of buckets, and the number and ids of the points in a
+  // bucket. The buckets are ordered by increasing i, then j, then k.
+  vtkIdType GetNumberOfBuckets()
+    {return this->NumberOfBuckets;}
+  vtkIdType GetNumberOfPointsInBucket(vtkIdType bucket)
+    {return this->Offsets[bucket+1] - this->Offsets[bucket];}
+  const vtkIdType *GetPointIdsInBucket(vtkIdType bucket)
+    {return this->PointIds + this->Offsets[bucket];}
+
+  // Description:
+  // See vtkLocator interface documentation.
+  // These methods are not thread safe.
+  virtual void FreeSearchStructure();
+  virtual void BuildLocator();
+  virtual void GenerateRepresentation(int level, vtkPolyData *pd);
+
+protected:
+  vtkStaticPointLocator();
+  virtual ~vtkStaticPointLocator();
+
+  void ComputeDivisions(vtkIdType numPts);
+  void GetBucketRange(const double x[3], double radius, int min[3],
+                      int max[3]);
+  double Distance2ToBucket(const double x[3], int i, int j, int k);
+  void GenerateFace(int face, int i, int j, int k,
+                    vtkPoints *pts, vtkCellArray *polys);
+
+  int Divisions[3]; // Number of sub-divisions in x-y-z directions
+  int NumberOfPointsPerBucket; // Used when Automatic is on
+  double H[3]; // Width of each bucket in x-y-z directions
+  vtkIdType NumberOfBuckets;
+  vtkIdType *Offsets;  // NumberOfBuckets + 1 locations into PointIds
+  vtkIdType *PointIds; // point ids sorted by bucket
+
+private:
+  vtkStaticPointLocator(const vtkStaticPointLocator&);  // Not implemented.
+  void operator=(const vtkStaticPointLocator&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,220 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOutputCachePipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test verifies that vtkOutputCachePipeline answers repeated time
+// step and piece requests from its cache, within its memory limit.
+
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkOutputCachePipeline.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// Produces 10000 points per piece requested, at x = time step. Time step 0
+// is slow to produce.
+class TestTimeSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TestTimeSource *New();
+  vtkTypeMacro(TestTimeSource,vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions;
+  unsigned int Delay;
+
+protected:
+  TestTimeSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfExecutions = 0;
+    this->Delay = 0;
+  }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double timeSteps[] = { 0.0, 1.0, 2.0, 3.0 };
+    double timeRange[] = { 0.0, 3.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timeSteps, 4);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeRange, 2);
+    outInfo->Set(vtkAlgorithm::CAN_HANDLE_PIECE_REQUEST(), 1);
+    return 1;
+  }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+  {
+    this->NumberOfExecutions++;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double time =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    int piece =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    if (time == 0.0 && this->Delay)
+      {
+      vtksys::SystemTools::Delay(this->Delay);
+      }
+
+    vtkNew<vtkPoints> points;
+    vtkIdType numberOfPoints = 10000 * (piece + 1);
+    points->SetNumberOfPoints(numberOfPoints);
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+      {
+      points->SetPoint(i, time, i, 0.0);
+      }
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->SetPoints(points.GetPointer());
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+
+private:
+  TestTimeSource(const TestTimeSource&); // Not implemented.
+  void operator=(const TestTimeSource&); // Not implemented.
+};
+
+vtkStandardNewMacro(TestTimeSource);
+
+namespace
+{
+// Update the algorithm for the given time step and piece, and check that
+// its output is the one requested.
+bool UpdateAndCheck(vtkAlgorithm* algorithm, double time, int piece = 0)
+{
+  algorithm->UpdateInformation();
+  vtkInformation* outInfo = algorithm->GetOutputInformation(0);
+  vtkStreamingDemandDrivenPipeline::SetUpdateTimeStep(outInfo, time);
+  algorithm->SetUpdateExtent(0, piece, 2, 0);
+  algorithm->Update();
+
+  vtkPolyData* output = vtkPolyData::SafeDownCast(
+    algorithm->GetOutputDataObject(0));
+  return output->GetNumberOfPoints() == 10000 * (piece + 1) &&
+    output->GetPoint(0)[0] == time &&
+    output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) == time;
+}
+}
+
+int TestOutputCachePipeline(int, char*[])
+{
+  vtkNew<TestTimeSource> source;
+  vtkNew<vtkOutputCachePipeline> cache;
+  source->SetExecutive(cache.GetPointer());
+
+  // Scrub forward then back.
+  if (!UpdateAndCheck(source.GetPointer(), 0.0) ||
+      !UpdateAndCheck(source.GetPointer(), 1.0) ||
+      !UpdateAndCheck(source.GetPointer(), 2.0) ||
+      !UpdateAndCheck(source.GetPointer(), 1.0) ||
+      !UpdateAndCheck(source.GetPointer(), 0.0) ||
+      source->NumberOfExecutions != 3 ||
+      cache->GetNumberOfMisses() != 3 || cache->GetNumberOfHits() != 2 ||
+      cache->GetNumberOfCachedOutputs() != 3)
+    {
+    cerr << "Wrong time step replay." << endl;
+    cache->Print(cerr);
+    return TEST_FAILURE;
+    }
+
+  // Pieces are cached separately.
+  if (!UpdateAndCheck(source.GetPointer(), 0.0, 1) ||
+      !UpdateAndCheck(source.GetPointer(), 0.0, 0) ||
+      !UpdateAndCheck(source.GetPointer(), 0.0, 1) ||
+      source->NumberOfExecutions != 4 || cache->GetNumberOfHits() != 4)
+    {
+    cerr << "Wrong piece replay." << endl;
+    cache->Print(cerr);
+    return TEST_FAILURE;
+    }
+
+  // Downstream consumers see the cached outputs.
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(source->GetOutputPort());
+  if (!UpdateAndCheck(elevation.GetPointer(), 2.0) ||
+      !UpdateAndCheck(elevation.GetPointer(), 1.0) ||
+      source->NumberOfExecutions != 4)
+    {
+    cerr << "Wrong output downstream." << endl;
+    return TEST_FAILURE;
+    }
+
+  // Modifying the algorithm invalidates the cache.
+  source->Modified();
+  if (!UpdateAndCheck(source.GetPointer(), 2.0) ||
+      source->NumberOfExecutions != 5 ||
+      cache->GetNumberOfCachedOutputs() != 1)
+    {
+    cerr << "Cache not invalidated." << endl;
+    return TEST_FAILURE;
+    }
+
+  // Room for two outputs: the least recently used is evicted.
+  unsigned long size = cache->GetCacheMemorySize();
+  cache->ClearCache();
+  cache->ResetStatistics();
+  cache->SetMemoryLimit(2 * size + size / 2);
+  source->Delay = 100;
+  if (!UpdateAndCheck(source.GetPointer(), 0.0) ||
+      !UpdateAndCheck(source.GetPointer(), 1.0) ||
+      !UpdateAndCheck(source.GetPointer(), 2.0) ||
+      !UpdateAndCheck(source.GetPointer(), 1.0) ||
+      !UpdateAndCheck(source.GetPointer(), 0.0) ||
+      cache->GetNumberOfHits() != 1 || cache->GetNumberOfMisses() != 4 ||
+      cache->GetNumberOfEvictions() != 2 ||
+      cache->GetCacheMemorySize() > cache->GetMemoryLimit())
+    {
+    cerr << "Wrong least recently used eviction." << endl;
+    cache->Print(cerr);
+    return TEST_FAILURE;
+    }
+
+  // The slow time step is kept. The current output is time step 0, modify
+  // the source so that it executes again.
+  source->Modified();
+  cache->ResetStatistics();
+  cache->SetEvictionPolicyToCostAware();
+  if (!UpdateAndCheck(source.GetPointer(), 0.0) ||
+      !UpdateAndCheck(source.GetPointer(), 1.0) ||
+      !UpdateAndCheck(source.GetPointer(), 2.0) ||
+      !UpdateAndCheck(source.GetPointer(), 0.0) ||
+      !UpdateAndCheck(source.GetPointer(), 1.0) ||
+      cache->GetNumberOfHits() != 1 || cache->GetNumberOfMisses() != 4)
+    {
+    cerr << "Wrong cost aware eviction." << endl;
+    cache->Print(cerr);
+    return TEST_FAILURE;
+    }
+
+  // Outputs larger than the limit are not cached.
+  cache->SetMemoryLimit(size / 2);
+  if (cache->GetNumberOfCachedOutputs() != 0 ||
+      !UpdateAndCheck(source.GetPointer(), 3.0) ||
+      cache->GetNumberOfCachedOutputs() != 0)
+    {
+    cerr << "Output larger than the limit cached." << endl;
+    return TEST_FAILURE;
+    }
+
+  return TEST_SUCCESS;
+}
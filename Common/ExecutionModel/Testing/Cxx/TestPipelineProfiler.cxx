@@ -0,0 +1,176 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test verifies that vtkPipelineProfiler records every pass of every
+// algorithm and exports them.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkExecutive.h"
+#include "vtkNew.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTrivialProducer.h"
+
+#include <cstdlib>
+#include <set>
+#include <sstream>
+#include <string>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+int TestPipelineProfiler(int, char*[])
+{
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType i = 0; i < 1000; ++i)
+    {
+    points->InsertNextPoint(i, 2 * i, 3 * i);
+    verts->InsertNextCell(1, &i);
+    }
+  polyData->SetPoints(points.GetPointer());
+  polyData->SetVerts(verts.GetPointer());
+
+  //        producer
+  //        /      \.
+  //  elevation1  elevation2
+  //        \      /
+  //         append
+  vtkNew<vtkTrivialProducer> producer;
+  producer->SetOutput(polyData.GetPointer());
+  vtkNew<vtkElevationFilter> elevation1;
+  elevation1->SetInputConnection(producer->GetOutputPort());
+  vtkNew<vtkElevationFilter> elevation2;
+  elevation2->SetInputConnection(producer->GetOutputPort());
+  vtkNew<vtkAppendPolyData> append;
+  append->AddInputConnection(elevation1->GetOutputPort());
+  append->AddInputConnection(elevation2->GetOutputPort());
+
+  vtkNew<vtkPipelineProfiler> profiler;
+  vtkExecutive::SetProfiler(profiler.GetPointer());
+  append->Update();
+  vtkExecutive::SetProfiler(NULL);
+
+  if (profiler->GetNumberOfPasses(elevation1.GetPointer(),
+                                  "REQUEST_DATA") != 1 ||
+      profiler->GetNumberOfPasses(append.GetPointer(), "REQUEST_DATA") != 1 ||
+      profiler->GetNumberOfPasses(append.GetPointer(),
+                                  "REQUEST_INFORMATION") != 1 ||
+      profiler->GetNumberOfPasses(append.GetPointer(),
+                                  "REQUEST_UPDATE_EXTENT") != 1 ||
+      profiler->GetWallTime(append.GetPointer(), "REQUEST_DATA") < 0.0)
+    {
+    cerr << "Wrong passes." << endl;
+    profiler->PrintSummary(cerr);
+    return TEST_FAILURE;
+    }
+
+  // Not recorded anymore.
+  int numberOfEvents = profiler->GetNumberOfEvents();
+  elevation2->Modified();
+  append->Update();
+  if (profiler->GetNumberOfEvents() != numberOfEvents)
+    {
+    cerr << "Profiler still recording." << endl;
+    return TEST_FAILURE;
+    }
+
+  // One line per event, and the inputs of each algorithm.
+  std::ostringstream csv;
+  profiler->PrintCSV(csv);
+  std::istringstream lines(csv.str());
+  std::string line;
+  int numberOfLines = 0;
+  bool inputsFound = true;
+  while (std::getline(lines, line))
+    {
+    std::istringstream inputs(line.substr(line.rfind(',') + 1));
+    int numberOfInputs = 0;
+    int id;
+    while (inputs >> id)
+      {
+      ++numberOfInputs;
+      }
+    if ((line.find(",vtkAppendPolyData,") != std::string::npos &&
+         numberOfInputs != 2) ||
+        (line.find(",vtkElevationFilter,") != std::string::npos &&
+         numberOfInputs != 1) ||
+        (line.find(",vtkTrivialProducer,") != std::string::npos &&
+         numberOfInputs != 0))
+      {
+      inputsFound = false;
+      }
+    ++numberOfLines;
+    }
+  if (numberOfLines != numberOfEvents + 1 || !inputsFound)
+    {
+    cerr << "Wrong CSV export:\n" << csv.str() << endl;
+    return TEST_FAILURE;
+    }
+
+  std::ostringstream trace;
+  profiler->PrintChromeTrace(trace);
+  if (trace.str().find("{\"traceEvents\":[") != 0 ||
+      trace.str().find("\"cat\":\"REQUEST_DATA\"") == std::string::npos ||
+      trace.str().find("vtkElevationFilter") == std::string::npos)
+    {
+    cerr << "Wrong Chrome trace export:\n" << trace.str() << endl;
+    return TEST_FAILURE;
+    }
+
+  profiler->Clear();
+  if (profiler->GetNumberOfEvents() != 0)
+    {
+    cerr << "Events not cleared." << endl;
+    return TEST_FAILURE;
+    }
+
+  // An algorithm deleted and the one allocated after it, most likely at
+  // the same address, have different ids. The profiler is left set: it is
+  // released at exit.
+  vtkExecutive::SetProfiler(profiler.GetPointer());
+  for (int i = 0; i < 2; ++i)
+    {
+    vtkElevationFilter* elevation = vtkElevationFilter::New();
+    elevation->SetInputConnection(producer->GetOutputPort());
+    elevation->Update();
+    elevation->Delete();
+    }
+  csv.str("");
+  profiler->PrintCSV(csv);
+  lines.clear();
+  lines.str(csv.str());
+  std::set<int> elevationIds;
+  while (std::getline(lines, line))
+    {
+    if (line.find(",vtkElevationFilter,") != std::string::npos)
+      {
+      elevationIds.insert(atoi(line.c_str()));
+      }
+    }
+  vtkNew<vtkElevationFilter> unknown;
+  if (elevationIds.size() != 2 ||
+      profiler->GetNumberOfPasses(unknown.GetPointer(), "REQUEST_DATA") != 0)
+    {
+    cerr << "Deleted algorithms not forgotten:\n" << csv.str() << endl;
+    return TEST_FAILURE;
+    }
+
+  return TEST_SUCCESS;
+}
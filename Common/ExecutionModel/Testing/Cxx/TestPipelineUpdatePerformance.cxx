@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineUpdatePerformance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test measures the latency of the pipeline passes of a deep
+// pipeline: an Update() of a 100 stage pipeline that is up to date, which
+// only runs the REQUEST_INFORMATION and REQUEST_UPDATE_EXTENT passes and
+// compares the requests, and one after a parameter change at the top of
+// the pipeline.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPassInputTypeAlgorithm.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkTrivialProducer.h"
+
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// The number of stages of the pipeline and of updates timed.
+static const int NUMBER_OF_STAGES = 100;
+static const int NUMBER_OF_UPDATES = 1000;
+
+//------------------------------------------------------------------------------
+// A filter passing its input through, counting its executions.
+class vtkPipelineUpdateTestFilter : public vtkPassInputTypeAlgorithm
+{
+public:
+  static vtkPipelineUpdateTestFilter* New();
+  vtkTypeMacro(vtkPipelineUpdateTestFilter, vtkPassInputTypeAlgorithm);
+
+  static int NumberOfExecutions;
+
+protected:
+  vtkPipelineUpdateTestFilter() {}
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector)
+    {
+    vtkDataObject* input = vtkDataObject::GetData(inputVector[0]);
+    vtkDataObject* output = vtkDataObject::GetData(outputVector);
+    output->ShallowCopy(input);
+    ++NumberOfExecutions;
+    return 1;
+    }
+
+private:
+  vtkPipelineUpdateTestFilter(const vtkPipelineUpdateTestFilter&);  // Not implemented.
+  void operator=(const vtkPipelineUpdateTestFilter&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkPipelineUpdateTestFilter);
+int vtkPipelineUpdateTestFilter::NumberOfExecutions = 0;
+
+//------------------------------------------------------------------------------
+int TestPipelineUpdatePerformance(int, char*[])
+{
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkTrivialProducer> producer;
+  producer->SetOutput(polyData.GetPointer());
+
+  std::vector<vtkSmartPointer<vtkPipelineUpdateTestFilter> > stages;
+  vtkAlgorithm* previous = producer.GetPointer();
+  for (int i = 0; i < NUMBER_OF_STAGES; ++i)
+    {
+    vtkSmartPointer<vtkPipelineUpdateTestFilter> stage =
+      vtkSmartPointer<vtkPipelineUpdateTestFilter>::New();
+    stage->SetInputConnection(previous->GetOutputPort());
+    stages.push_back(stage);
+    previous = stage;
+    }
+  vtkPipelineUpdateTestFilter* last = stages.back();
+  last->Update();
+  if (vtkPipelineUpdateTestFilter::NumberOfExecutions != NUMBER_OF_STAGES)
+    {
+    cerr << "Wrong number of executions: "
+         << vtkPipelineUpdateTestFilter::NumberOfExecutions << endl;
+    return TEST_FAILURE;
+    }
+
+  // Updates of the pipeline up to date.
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (int i = 0; i < NUMBER_OF_UPDATES; ++i)
+    {
+    last->Update();
+    }
+  timer->StopTimer();
+  cout << "<DartMeasurement name=\"NoOpUpdate\" type=\"numeric/double\">"
+       << timer->GetElapsedTime() / NUMBER_OF_UPDATES * 1e6
+       << "</DartMeasurement> microseconds" << endl;
+  if (vtkPipelineUpdateTestFilter::NumberOfExecutions != NUMBER_OF_STAGES)
+    {
+    cerr << "Pipeline up to date executed." << endl;
+    return TEST_FAILURE;
+    }
+
+  // Updates after a change at the top of the pipeline, as in a parameter
+  // sweep.
+  timer->StartTimer();
+  for (int i = 0; i < NUMBER_OF_UPDATES / 10; ++i)
+    {
+    stages.front()->Modified();
+    last->Update();
+    }
+  timer->StopTimer();
+  cout << "<DartMeasurement name=\"ModifiedUpdate\" type=\"numeric/double\">"
+       << timer->GetElapsedTime() / (NUMBER_OF_UPDATES / 10) * 1e6
+       << "</DartMeasurement> microseconds" << endl;
+  if (vtkPipelineUpdateTestFilter::NumberOfExecutions !=
+      NUMBER_OF_STAGES * (1 + NUMBER_OF_UPDATES / 10))
+    {
+    cerr << "Wrong number of executions after modifications: "
+         << vtkPipelineUpdateTestFilter::NumberOfExecutions << endl;
+    return TEST_FAILURE;
+    }
+
+  return TEST_SUCCESS;
+}
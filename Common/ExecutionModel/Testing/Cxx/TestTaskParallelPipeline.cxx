@@ -0,0 +1,277 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTaskParallelPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test verifies that vtkTaskParallelPipeline executes what needs to,
+// once, producers first, and never runs algorithms that are not thread
+// safe concurrently with others.
+
+#include "vtkAppendPolyData.h"
+#include "vtkAtomicTypes.h"
+#include "vtkCellArray.h"
+#include "vtkCollection.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkTaskParallelPipeline.h"
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+namespace
+{
+vtkAtomicInt32 Sequence(0);
+vtkAtomicInt32 Running(0);
+vtkAtomicInt32 SerialRunning(0);
+vtkAtomicInt32 Overlaps(0);
+}
+
+// Adds Increment vertices to its input, or creates them without input.
+class MyFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static MyFilter *New();
+  vtkTypeMacro(MyFilter,vtkPolyDataAlgorithm);
+
+  void SetThreadSafe(int threadSafe)
+  {
+    this->GetInformation()->Set(vtkTaskParallelPipeline::THREAD_SAFE(),
+                                threadSafe);
+  }
+
+  int Increment;
+  bool Fail;
+  int NumberOfExecutions;
+  int Start;
+  int Finish;
+
+protected:
+  MyFilter()
+  {
+    this->Increment = 1;
+    this->Fail = false;
+    this->NumberOfExecutions = 0;
+    this->Start = 0;
+    this->Finish = 0;
+    this->SetThreadSafe(1);
+  }
+
+  virtual int FillInputPortInformation(int port, vtkInformation* info)
+  {
+    info->Set(vtkAlgorithm::INPUT_IS_OPTIONAL(), 1);
+    return this->Superclass::FillInputPortInformation(port, info);
+  }
+
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+  {
+    bool threadSafe =
+      this->GetInformation()->Get(vtkTaskParallelPipeline::THREAD_SAFE()) != 0;
+    int running = ++Running;
+    if (!threadSafe)
+      {
+      ++SerialRunning;
+      if (running > 1)
+        {
+        ++Overlaps;
+        }
+      }
+    else if (SerialRunning > 0)
+      {
+      ++Overlaps;
+      }
+    this->Start = ++Sequence;
+    this->NumberOfExecutions++;
+
+    vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    vtkNew<vtkPoints> points;
+    if (input && input->GetPoints())
+      {
+      points->DeepCopy(input->GetPoints());
+      }
+    for (int i = 0; i < this->Increment; ++i)
+      {
+      points->InsertNextPoint(i, 0.0, 0.0);
+      }
+    vtkNew<vtkCellArray> verts;
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+      {
+      verts->InsertNextCell(1, &i);
+      }
+    output->SetPoints(points.GetPointer());
+    output->SetVerts(verts.GetPointer());
+
+    this->Finish = ++Sequence;
+    if (!threadSafe)
+      {
+      --SerialRunning;
+      }
+    --Running;
+    return this->Fail ? 0 : 1;
+  }
+
+private:
+  MyFilter(const MyFilter&); // Not implemented.
+  void operator=(const MyFilter&); // Not implemented.
+};
+
+vtkStandardNewMacro(MyFilter);
+
+namespace
+{
+bool Before(MyFilter* producer, MyFilter* consumer)
+{
+  return producer->Finish < consumer->Start;
+}
+
+void UseTaskParallelPipeline(vtkAlgorithm* algorithm)
+{
+  vtkTaskParallelPipeline* executive = vtkTaskParallelPipeline::New();
+  algorithm->SetExecutive(executive);
+  executive->Delete();
+}
+}
+
+int TestTaskParallelPipeline(int, char*[])
+{
+  //        source
+  //   /   |      |    \.
+  //  a    b   serial   e
+  //   \   |      |
+  //    \  |      d
+  //     \ |     /
+  //     append
+  vtkNew<MyFilter> source;
+  vtkNew<MyFilter> a;
+  vtkNew<MyFilter> b;
+  vtkNew<MyFilter> serial;
+  vtkNew<MyFilter> d;
+  vtkNew<MyFilter> e;
+  vtkNew<vtkAppendPolyData> append;
+
+  MyFilter* filters[] = { source.GetPointer(), a.GetPointer(),
+                          b.GetPointer(), serial.GetPointer(),
+                          d.GetPointer(), e.GetPointer() };
+  const int numFilters = 6;
+  for (int i = 0; i < numFilters; ++i)
+    {
+    UseTaskParallelPipeline(filters[i]);
+    }
+  UseTaskParallelPipeline(append.GetPointer());
+
+  source->Increment = 10;
+  b->Increment = 2;
+  serial->Increment = 3;
+  serial->SetThreadSafe(0);
+  d->Increment = 4;
+  a->SetInputConnection(source->GetOutputPort());
+  b->SetInputConnection(source->GetOutputPort());
+  serial->SetInputConnection(source->GetOutputPort());
+  e->SetInputConnection(source->GetOutputPort());
+  d->SetInputConnection(serial->GetOutputPort());
+  append->AddInputConnection(a->GetOutputPort());
+  append->AddInputConnection(b->GetOutputPort());
+  append->AddInputConnection(d->GetOutputPort());
+
+  if (!append->GetExecutive()->Update() ||
+      append->GetOutput()->GetNumberOfPoints() != 3 * 10 + 1 + 2 + 3 + 4)
+    {
+    cerr << "Wrong output." << endl;
+    return TEST_FAILURE;
+    }
+  for (int i = 0; i < numFilters; ++i)
+    {
+    int expected = filters[i] == e.GetPointer() ? 0 : 1;
+    if (filters[i]->NumberOfExecutions != expected)
+      {
+      cerr << "Wrong number of executions for filter " << i << endl;
+      return TEST_FAILURE;
+      }
+    }
+  if (!Before(source.GetPointer(), a.GetPointer()) ||
+      !Before(source.GetPointer(), b.GetPointer()) ||
+      !Before(source.GetPointer(), serial.GetPointer()) ||
+      !Before(serial.GetPointer(), d.GetPointer()))
+    {
+    cerr << "Consumer executed before its producer." << endl;
+    return TEST_FAILURE;
+    }
+
+  // Up to date.
+  append->Update();
+  // Only b and what depends on it.
+  b->Increment = 5;
+  b->Modified();
+  append->Update();
+  if (source->NumberOfExecutions != 1 || a->NumberOfExecutions != 1 ||
+      b->NumberOfExecutions != 2 || d->NumberOfExecutions != 1 ||
+      append->GetOutput()->GetNumberOfPoints() != 3 * 10 + 1 + 5 + 3 + 4)
+    {
+    cerr << "Wrong re-execution." << endl;
+    return TEST_FAILURE;
+    }
+
+  // Two sinks sharing the source, updated together.
+  source->Modified();
+  vtkNew<vtkCollection> sinks;
+  sinks->AddItem(append.GetPointer());
+  sinks->AddItem(e.GetPointer());
+  if (!vtkTaskParallelPipeline::UpdateAlgorithms(sinks.GetPointer()) ||
+      source->NumberOfExecutions != 2 || a->NumberOfExecutions != 2 ||
+      e->NumberOfExecutions != 1 ||
+      e->GetOutput()->GetNumberOfPoints() != 11 ||
+      !Before(source.GetPointer(), e.GetPointer()))
+    {
+    cerr << "Wrong update of several sinks." << endl;
+    return TEST_FAILURE;
+    }
+
+  // A failure skips the consumers.
+  serial->Fail = true;
+  serial->Modified();
+  vtkObject::GlobalWarningDisplayOff();
+  int result = append->GetExecutive()->Update();
+  vtkObject::GlobalWarningDisplayOn();
+  serial->Fail = false;
+  if (result || serial->NumberOfExecutions != 3 || d->NumberOfExecutions != 2)
+    {
+    cerr << "Failure not reported." << endl;
+    return TEST_FAILURE;
+    }
+
+  // Released data is kept until every consumer executed.
+  source->ReleaseDataFlagOn();
+  source->Modified();
+  if (!append->GetExecutive()->Update() ||
+      source->GetOutput()->GetNumberOfPoints() != 0 ||
+      append->GetOutput()->GetNumberOfPoints() != 3 * 10 + 1 + 5 + 3 + 4)
+    {
+    cerr << "Wrong release of data." << endl;
+    return TEST_FAILURE;
+    }
+
+  if (Overlaps > 0)
+    {
+    cerr << "Algorithm not thread safe executed concurrently." << endl;
+    return TEST_FAILURE;
+    }
+
+  return TEST_SUCCESS;
+}
@@ -0,0 +1,275 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTemporalPrefetcher.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test verifies that vtkTemporalPrefetcher executes the pipeline
+// upstream in the background for the time steps requested next, in
+// forward, backward and looping playback, unless the output upstream has
+// other consumers.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPassInputTypeAlgorithm.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTemporalPrefetcher.h"
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// Produces 100 points at x = time step, for time steps 0 to 9.
+class TestTimeSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TestTimeSource *New();
+  vtkTypeMacro(TestTimeSource,vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions[10];
+  int NumberOfBackgroundExecutions;
+  vtkMultiThreaderIDType MainThread;
+
+protected:
+  TestTimeSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    for (int i = 0; i < 10; ++i)
+      {
+      this->NumberOfExecutions[i] = 0;
+      }
+    this->NumberOfBackgroundExecutions = 0;
+    this->MainThread = vtkMultiThreader::GetCurrentThreadID();
+  }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double timeSteps[10];
+    for (int i = 0; i < 10; ++i)
+      {
+      timeSteps[i] = i;
+      }
+    double timeRange[] = { 0.0, 9.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timeSteps, 10);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeRange, 2);
+    return 1;
+  }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double time =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    this->NumberOfExecutions[static_cast<int>(time)]++;
+    if (!vtkMultiThreader::ThreadsEqual(
+          this->MainThread, vtkMultiThreader::GetCurrentThreadID()))
+      {
+      this->NumberOfBackgroundExecutions++;
+      }
+
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(100);
+    for (vtkIdType i = 0; i < 100; ++i)
+      {
+      points->SetPoint(i, time, i, 0.0);
+      }
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->SetPoints(points.GetPointer());
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+
+private:
+  TestTimeSource(const TestTimeSource&); // Not implemented.
+  void operator=(const TestTimeSource&); // Not implemented.
+};
+
+vtkStandardNewMacro(TestTimeSource);
+
+namespace
+{
+// Request the time steps in order, letting the prefetches complete between
+// requests, and check the outputs.
+bool Play(vtkTemporalPrefetcher* prefetcher, const int* timeSteps, int count)
+{
+  for (int i = 0; i < count; ++i)
+    {
+    double time = timeSteps[i];
+    prefetcher->UpdateInformation();
+    vtkStreamingDemandDrivenPipeline::SetUpdateTimeStep(
+      prefetcher->GetOutputInformation(0), time);
+    prefetcher->Update();
+    prefetcher->WaitForPrefetches();
+
+    vtkPolyData* output =
+      vtkPolyData::SafeDownCast(prefetcher->GetOutputDataObject(0));
+    if (!output || output->GetNumberOfPoints() != 100 ||
+        output->GetPoint(0)[0] != time ||
+        output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != time)
+      {
+      cerr << "Wrong output for time step " << time << endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestTemporalPrefetcher(int, char*[])
+{
+  vtkNew<TestTimeSource> source;
+  vtkNew<vtkTemporalPrefetcher> prefetcher;
+  prefetcher->SetInputConnection(source->GetOutputPort());
+  prefetcher->SetNumberOfPrefetchedTimeSteps(2);
+  prefetcher->SetBufferSize(4);
+
+  // Forward: only the first time step waits for the pipeline.
+  const int forward[] = { 0, 1, 2, 3, 4, 5 };
+  if (!Play(prefetcher.GetPointer(), forward, 6) ||
+      prefetcher->GetNumberOfMisses() != 1 ||
+      prefetcher->GetNumberOfHits() != 5)
+    {
+    cerr << "Wrong forward playback." << endl;
+    prefetcher->Print(cerr);
+    return TEST_FAILURE;
+    }
+  for (int i = 0; i < 8; ++i)
+    {
+    if (source->NumberOfExecutions[i] != 1)
+      {
+      cerr << "Time step " << i << " executed "
+           << source->NumberOfExecutions[i] << " times." << endl;
+      return TEST_FAILURE;
+      }
+    }
+  if (source->NumberOfBackgroundExecutions != 7)
+    {
+    cerr << "Time steps not prefetched in the background." << endl;
+    return TEST_FAILURE;
+    }
+
+  // Backward, after a jump. Modifying the source invalidates the buffer.
+  prefetcher->CancelPrefetches();
+  source->Modified();
+  prefetcher->ResetStatistics();
+  const int backward[] = { 9, 8, 7, 6, 5 };
+  if (!Play(prefetcher.GetPointer(), backward, 5) ||
+      prefetcher->GetNumberOfMisses() != 2 ||
+      prefetcher->GetNumberOfHits() != 3)
+    {
+    cerr << "Wrong backward playback." << endl;
+    prefetcher->Print(cerr);
+    return TEST_FAILURE;
+    }
+
+  // Looping: the first time step follows the last one.
+  prefetcher->CancelPrefetches();
+  source->Modified();
+  prefetcher->ResetStatistics();
+  prefetcher->LoopOn();
+  const int loop[] = { 8, 9, 0, 1, 2 };
+  if (!Play(prefetcher.GetPointer(), loop, 5) ||
+      prefetcher->GetNumberOfMisses() != 2 ||
+      prefetcher->GetNumberOfHits() != 3)
+    {
+    cerr << "Wrong looping playback." << endl;
+    prefetcher->Print(cerr);
+    return TEST_FAILURE;
+    }
+
+  // Requests while prefetching, without waiting.
+  for (int i = 0; i < 20; ++i)
+    {
+    double time = i % 10;
+    prefetcher->UpdateInformation();
+    vtkStreamingDemandDrivenPipeline::SetUpdateTimeStep(
+      prefetcher->GetOutputInformation(0), time);
+    prefetcher->Update();
+    vtkPolyData* output =
+      vtkPolyData::SafeDownCast(prefetcher->GetOutputDataObject(0));
+    if (output->GetPoint(0)[0] != time)
+      {
+      cerr << "Wrong output while prefetching." << endl;
+      return TEST_FAILURE;
+      }
+    }
+
+  // Reconnecting stops the prefetches from the previous input.
+  vtkNew<TestTimeSource> other;
+  prefetcher->SetInputConnection(other->GetOutputPort());
+  int numberOfExecutions = 0;
+  for (int i = 0; i < 10; ++i)
+    {
+    numberOfExecutions += source->NumberOfExecutions[i];
+    }
+  const int reconnected[] = { 3, 4 };
+  if (!Play(prefetcher.GetPointer(), reconnected, 2))
+    {
+    cerr << "Wrong playback after reconnecting." << endl;
+    return TEST_FAILURE;
+    }
+  for (int i = 0; i < 10; ++i)
+    {
+    numberOfExecutions -= source->NumberOfExecutions[i];
+    }
+  if (numberOfExecutions != 0 || other->NumberOfBackgroundExecutions == 0)
+    {
+    cerr << "Previous input executed after reconnecting." << endl;
+    return TEST_FAILURE;
+    }
+
+  // Nothing is prefetched while the source has another consumer.
+  vtkNew<TestTimeSource> shared;
+  vtkNew<vtkTemporalPrefetcher> prefetcher3;
+  prefetcher3->SetInputConnection(shared->GetOutputPort());
+  vtkNew<vtkPassInputTypeAlgorithm> consumer;
+  consumer->SetInputConnection(shared->GetOutputPort());
+  const int sharedSteps[] = { 0, 1, 2 };
+  if (!Play(prefetcher3.GetPointer(), sharedSteps, 3) ||
+      prefetcher3->GetNumberOfMisses() != 3 ||
+      shared->NumberOfBackgroundExecutions != 0)
+    {
+    cerr << "Prefetched the output of a source with another consumer."
+         << endl;
+    return TEST_FAILURE;
+    }
+  consumer->RemoveAllInputConnections(0);
+  const int unsharedSteps[] = { 3, 4 };
+  if (!Play(prefetcher3.GetPointer(), unsharedSteps, 2) ||
+      shared->NumberOfBackgroundExecutions == 0)
+    {
+    cerr << "Not prefetched once the other consumer is gone." << endl;
+    return TEST_FAILURE;
+    }
+
+  // Release the pipeline, whose only references are held by the prefetcher,
+  // while a time step is prefetched.
+  TestTimeSource* released = TestTimeSource::New();
+  vtkTemporalPrefetcher* prefetcher2 = vtkTemporalPrefetcher::New();
+  prefetcher2->SetInputConnection(released->GetOutputPort());
+  released->Delete();
+  prefetcher2->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SetUpdateTimeStep(
+    prefetcher2->GetOutputInformation(0), 0.0);
+  prefetcher2->Update();
+  prefetcher2->Delete();
+
+  return TEST_SUCCESS;
+}
@@ -17,6 +17,7 @@
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
 #include "vtkDataObject.h"
+#include "vtkDebugLeaksManager.h" // Must be included before the cleanup.
 #include "vtkGarbageCollector.h"
 #include "vtkInformation.h"
 #include "vtkInformationExecutivePortKey.h"
@@ -26,6 +27,7 @@
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
 
 #include <vector>
@@ -42,6 +44,20 @@ vtkInformationKeyMacro(vtkExecutive, FROM_OUTPUT_PORT, Integer);
 vtkInformationKeyMacro(vtkExecutive, KEYS_TO_COPY, KeyVector);
 vtkInformationKeyMacro(vtkExecutive, PRODUCER, ExecutivePort);
 
+vtkPipelineProfiler* vtkExecutive::Profiler = 0;
+
+//----------------------------------------------------------------------------
+// Releases the profiler still set at exit, before the leaks are reported.
+class vtkExecutiveProfilerCleanup
+{
+public:
+  ~vtkExecutiveProfilerCleanup()
+  {
+    vtkExecutive::SetProfiler(0);
+  }
+};
+static vtkExecutiveProfilerCleanup vtkExecutiveProfilerCleanupInstance;
+
 //----------------------------------------------------------------------------
 class vtkExecutiveInternals
 {
@@ -771,9 +787,19 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
   // Invoke the request on the algorithm.
+  vtkPipelineProfiler* profiler = vtkExecutive::Profiler;
+  double start[2];
+  if(profiler)
+    {
+    profiler->StartPass(start);
+    }
   this->InAlgorithm = 1;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
   this->InAlgorithm = 0;
+  if(profiler)
+    {
+    profiler->EndPass(start, this->Algorithm, request, outInfo);
+    }
 
   // If the algorithm failed report it now.
   if(!result)
@@ -787,6 +813,30 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   return result;
 }
 
+//----------------------------------------------------------------------------
+void vtkExecutive::SetProfiler(vtkPipelineProfiler* profiler)
+{
+  if(vtkExecutive::Profiler == profiler)
+    {
+    return;
+    }
+  if(profiler)
+    {
+    profiler->Register(0);
+    }
+  if(vtkExecutive::Profiler)
+    {
+    vtkExecutive::Profiler->UnRegister(0);
+    }
+  vtkExecutive::Profiler = profiler;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler* vtkExecutive::GetProfiler()
+{
+  return vtkExecutive::Profiler;
+}
+
 //----------------------------------------------------------------------------
 int vtkExecutive::CheckAlgorithm(const char* method,
                                  vtkInformation* request)
@@ -39,6 +39,7 @@ class vtkInformationIntegerKey;
 class vtkInformationRequestKey;
 class vtkInformationKeyVectorKey;
 class vtkInformationVector;
+class vtkPipelineProfiler;
 
 class VTKCOMMONEXECUTIONMODEL_EXPORT vtkExecutive : public vtkObject
 {
@@ -187,6 +188,14 @@ public:
                             vtkInformationVector** inInfo,
                             vtkInformationVector* outInfo);
 
+  // Description:
+  // Set/Get the profiler recording the requests that all executives invoke
+  // on their algorithm. NULL, the default, disables profiling. Set it
+  // while no pipeline is updating. The profiler still set at exit is
+  // released then.
+  static void SetProfiler(vtkPipelineProfiler* profiler);
+  static vtkPipelineProfiler* GetProfiler();
+
 protected:
   vtkExecutive();
   ~vtkExecutive();
@@ -242,6 +251,8 @@ private:
   // Internal implementation details.
   vtkExecutiveInternals* ExecutiveInternal;
 
+  static vtkPipelineProfiler* Profiler;
+
   //BTX
   friend class vtkAlgorithmToExecutiveFriendship;
   //ETX
@@ -0,0 +1,47 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkInformationDoubleVectorMetaDataKey.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkInformationDoubleVectorMetaDataKey.h"
+
+#include "vtkInformation.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+//----------------------------------------------------------------------------
+vtkInformationDoubleVectorMetaDataKey::vtkInformationDoubleVectorMetaDataKey(const char* name, const char* location) :
+  vtkInformationDoubleVectorKey(name, location)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkInformationDoubleVectorMetaDataKey::~vtkInformationDoubleVectorMetaDataKey()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkInformationDoubleVectorMetaDataKey::CopyDefaultInformation(
+  vtkInformation* request,
+  vtkInformation* fromInfo,
+  vtkInformation* toInfo)
+{
+  if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_INFORMATION()))
+    {
+    this->ShallowCopy(fromInfo, toInfo);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkInformationDoubleVectorMetaDataKey::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
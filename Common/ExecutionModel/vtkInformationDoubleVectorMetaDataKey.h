@@ -0,0 +1,60 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkInformationDoubleVectorMetaDataKey.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkInformationDoubleVectorMetaDataKey - key used to define meta-data of type double vector
+// vtkInformationDoubleVectorMetaDataKey is a vtkInformationDoubleVectorKey
+// that copies itself downstream during the REQUEST_INFORMATION pass. Hence
+// it can be used to provide numerical meta-data, such as per-piece bounds
+// or ranges, to the filters downstream.
+
+#ifndef vtkInformationDoubleVectorMetaDataKey_h
+#define vtkInformationDoubleVectorMetaDataKey_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkInformationDoubleVectorKey.h"
+
+#include "vtkCommonInformationKeyManager.h" // Manage instances of this type.
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkInformationDoubleVectorMetaDataKey : public vtkInformationDoubleVectorKey
+{
+public:
+  vtkTypeMacro(vtkInformationDoubleVectorMetaDataKey,vtkInformationDoubleVectorKey);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  vtkInformationDoubleVectorMetaDataKey(const char* name, const char* location);
+  ~vtkInformationDoubleVectorMetaDataKey();
+
+  // Description:
+  // This method simply returns a new vtkInformationDoubleVectorMetaDataKey, given a
+  // name and a location. This method is provided for wrappers. Use the
+  // constructor directly from C++ instead.
+  static vtkInformationDoubleVectorMetaDataKey* MakeKey(const char* name, const char* location)
+    {
+    return new vtkInformationDoubleVectorMetaDataKey(name, location);
+    }
+
+  // Description:
+  // Simply copies the key from fromInfo to toInfo if request
+  // has the REQUEST_INFORMATION() key.
+  // This is used by the pipeline to propagate this key downstream.
+  virtual void CopyDefaultInformation(vtkInformation* request,
+                                      vtkInformation* fromInfo,
+                                      vtkInformation* toInfo);
+
+private:
+  vtkInformationDoubleVectorMetaDataKey(const vtkInformationDoubleVectorMetaDataKey&);  // Not implemented.
+  void operator=(const vtkInformationDoubleVectorMetaDataKey&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,424 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkOutputCachePipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkOutputCachePipeline.h"
+
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <list>
+#include <vector>
+
+vtkStandardNewMacro(vtkOutputCachePipeline);
+
+//----------------------------------------------------------------------------
+class vtkOutputCachePipelineInternals
+{
+public:
+  // What was requested from the algorithm.
+  struct Key
+  {
+    int Port;
+    int HasTime;
+    double Time;
+    int Piece;
+    int NumberOfPieces;
+    int GhostLevel;
+    int HasExtent;
+    int Extent[6];
+
+    bool operator==(const Key& other) const
+    {
+      if (this->Port != other.Port ||
+          this->HasTime != other.HasTime ||
+          (this->HasTime && this->Time != other.Time) ||
+          this->Piece != other.Piece ||
+          this->NumberOfPieces != other.NumberOfPieces ||
+          this->GhostLevel != other.GhostLevel ||
+          this->HasExtent != other.HasExtent)
+        {
+        return false;
+        }
+      for (int i = 0; this->HasExtent && i < 6; ++i)
+        {
+        if (this->Extent[i] != other.Extent[i])
+          {
+          return false;
+          }
+        }
+      return true;
+    }
+  };
+
+  struct Entry
+  {
+    Key RequestKey;
+    // Shallow copies of the outputs and of their information, one per
+    // output port.
+    std::vector<vtkSmartPointer<vtkDataObject> > Outputs;
+    std::vector<vtkSmartPointer<vtkInformation> > DataInformation;
+    // Memory used by the outputs, in kibibytes.
+    unsigned long Size;
+    // Execution time, in seconds.
+    double Cost;
+    // GreedyDual-Size priority, the smallest is evicted first.
+    double Priority;
+    // When the outputs were generated, compared to the pipeline MTime.
+    unsigned long Time;
+  };
+
+  typedef std::list<Entry> EntriesType;
+
+  vtkOutputCachePipelineInternals() : Inflation(0.0) {}
+
+  // Build the key of the request in the output information. Returns false
+  // if the request cannot be cached.
+  static bool GetKey(vtkInformation* outInfo, int port, Key& key)
+  {
+    if (outInfo->Has(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES()))
+      {
+      return false;
+      }
+    key.Port = port;
+    // Like vtkStreamingDemandDrivenPipeline, ignore the time requests when
+    // the pipeline does not provide time.
+    key.HasTime =
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_RANGE()) &&
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    key.Time = key.HasTime ?
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()) : 0.0;
+    key.Piece =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    key.NumberOfPieces =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    key.GhostLevel = outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+    key.HasExtent =
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
+    if (key.HasExtent)
+      {
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
+                   key.Extent);
+      }
+    return true;
+  }
+
+  EntriesType::iterator Find(const Key& key)
+  {
+    EntriesType::iterator it = this->Entries.begin();
+    while (it != this->Entries.end() && !(it->RequestKey == key))
+      {
+      ++it;
+      }
+    return it;
+  }
+
+  // Most recently used first.
+  EntriesType Entries;
+  // GreedyDual-Size inflation value, the priority of the last entry
+  // evicted.
+  double Inflation;
+};
+
+//----------------------------------------------------------------------------
+vtkOutputCachePipeline::vtkOutputCachePipeline()
+{
+  this->MemoryLimit = 1048576;
+  this->EvictionPolicy = LEAST_RECENTLY_USED;
+  this->CacheMemorySize = 0;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+  this->Internals = new vtkOutputCachePipelineInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkOutputCachePipeline::~vtkOutputCachePipeline()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkOutputCachePipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MemoryLimit: " << this->MemoryLimit << "\n";
+  os << indent << "EvictionPolicy: "
+     << (this->EvictionPolicy == COST_AWARE ?
+         "CostAware" : "LeastRecentlyUsed") << "\n";
+  os << indent << "NumberOfCachedOutputs: "
+     << this->GetNumberOfCachedOutputs() << "\n";
+  os << indent << "CacheMemorySize: " << this->CacheMemorySize << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
+  os << indent << "NumberOfEvictions: " << this->NumberOfEvictions << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkOutputCachePipeline::SetMemoryLimit(unsigned long limit)
+{
+  if (limit == this->MemoryLimit)
+    {
+    return;
+    }
+  this->MemoryLimit = limit;
+  this->EvictEntries(limit);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkOutputCachePipeline::ClearCache()
+{
+  this->Internals->Entries.clear();
+  this->Internals->Inflation = 0.0;
+  this->CacheMemorySize = 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkOutputCachePipeline::GetNumberOfCachedOutputs()
+{
+  return static_cast<int>(this->Internals->Entries.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkOutputCachePipeline::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkOutputCachePipeline::NeedToExecuteData(
+  int outputPort,
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec)
+{
+  if (!this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
+    {
+    return 0;
+    }
+
+  // Requests for all the ports and the iterations of algorithms executing
+  // several times are not cached.
+  if (outputPort < 0 || this->ContinueExecuting)
+    {
+    return 1;
+    }
+
+  return !this->RestoreOutputs(outputPort, inInfoVec, outInfoVec);
+}
+
+//----------------------------------------------------------------------------
+int vtkOutputCachePipeline::RestoreOutputs(int outputPort,
+                                           vtkInformationVector** inInfoVec,
+                                           vtkInformationVector* outInfoVec)
+{
+  this->RemoveStaleEntries();
+
+  vtkOutputCachePipelineInternals::Key key;
+  if (!vtkOutputCachePipelineInternals::GetKey(
+        outInfoVec->GetInformationObject(outputPort), outputPort, key))
+    {
+    return 0;
+    }
+  vtkOutputCachePipelineInternals::EntriesType& entries =
+    this->Internals->Entries;
+  vtkOutputCachePipelineInternals::EntriesType::iterator entry =
+    this->Internals->Find(key);
+  if (entry == entries.end())
+    {
+    return 0;
+    }
+
+  // The output data objects may have been replaced since.
+  int numberOfPorts = outInfoVec->GetNumberOfInformationObjects();
+  if (static_cast<int>(entry->Outputs.size()) != numberOfPorts)
+    {
+    return 0;
+    }
+  int i;
+  for (i = 0; i < numberOfPorts; ++i)
+    {
+    vtkDataObject* data =
+      outInfoVec->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+    vtkDataObject* cached = entry->Outputs[i];
+    if (cached && (!data || !data->IsA(cached->GetClassName())))
+      {
+      return 0;
+      }
+    }
+
+  for (i = 0; i < numberOfPorts; ++i)
+    {
+    vtkDataObject* data =
+      outInfoVec->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+    if (vtkDataObject* cached = entry->Outputs[i])
+      {
+      data->ShallowCopy(cached);
+      data->GetInformation()->Copy(entry->DataInformation[i]);
+      }
+    }
+
+  // Finish as an execution would.
+  vtkSmartPointer<vtkInformation> request =
+    vtkSmartPointer<vtkInformation>::New();
+  request->Set(FROM_OUTPUT_PORT(), outputPort);
+  this->MarkOutputsGenerated(request, inInfoVec, outInfoVec);
+  this->DataTime.Modified();
+
+  entry->Priority = this->Internals->Inflation + entry->Cost / entry->Size;
+  entries.splice(entries.begin(), entries, entry);
+  ++this->NumberOfHits;
+  vtkDebugMacro("Restored the outputs of "
+                << this->Algorithm->GetClassName() << " from the cache.");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkOutputCachePipeline::ExecuteData(vtkInformation* request,
+                                        vtkInformationVector** inInfoVec,
+                                        vtkInformationVector* outInfoVec)
+{
+  // The key must be built before execution, which may change the update
+  // extent.
+  vtkOutputCachePipelineInternals::Key key;
+  int outputPort =
+    request->Has(FROM_OUTPUT_PORT()) ? request->Get(FROM_OUTPUT_PORT()) : -1;
+  bool cacheable = outputPort >= 0 && !this->ContinueExecuting &&
+    vtkOutputCachePipelineInternals::GetKey(
+      outInfoVec->GetInformationObject(outputPort), outputPort, key);
+
+  double start = vtkTimerLog::GetUniversalTime();
+  int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  double cost = vtkTimerLog::GetUniversalTime() - start;
+
+  if (!cacheable)
+    {
+    return result;
+    }
+  ++this->NumberOfMisses;
+  if (!result || this->ContinueExecuting)
+    {
+    return result;
+    }
+
+  this->RemoveStaleEntries();
+  vtkOutputCachePipelineInternals::EntriesType& entries =
+    this->Internals->Entries;
+  vtkOutputCachePipelineInternals::EntriesType::iterator previous =
+    this->Internals->Find(key);
+  if (previous != entries.end())
+    {
+    this->CacheMemorySize -= previous->Size;
+    entries.erase(previous);
+    }
+
+  vtkOutputCachePipelineInternals::Entry entry;
+  entry.RequestKey = key;
+  unsigned long size = 0;
+  int numberOfPorts = outInfoVec->GetNumberOfInformationObjects();
+  for (int i = 0; i < numberOfPorts; ++i)
+    {
+    vtkDataObject* data =
+      outInfoVec->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+    vtkSmartPointer<vtkDataObject> copy;
+    vtkSmartPointer<vtkInformation> dataInfo;
+    if (data)
+      {
+      copy.TakeReference(data->NewInstance());
+      copy->ShallowCopy(data);
+      dataInfo = vtkSmartPointer<vtkInformation>::New();
+      dataInfo->Copy(data->GetInformation());
+      size += data->GetActualMemorySize();
+      }
+    entry.Outputs.push_back(copy);
+    entry.DataInformation.push_back(dataInfo);
+    }
+  entry.Size = size > 0 ? size : 1;
+  if (entry.Size > this->MemoryLimit)
+    {
+    vtkDebugMacro("Outputs of " << this->Algorithm->GetClassName()
+                  << " larger than the memory limit, not cached.");
+    return result;
+    }
+  entry.Cost = cost;
+  entry.Priority = this->Internals->Inflation + entry.Cost / entry.Size;
+  vtkTimeStamp generated;
+  generated.Modified();
+  entry.Time = generated.GetMTime();
+
+  // Make room among the existing entries first, a new entry is never the
+  // one evicted.
+  this->EvictEntries(this->MemoryLimit - entry.Size);
+  entries.push_front(entry);
+  this->CacheMemorySize += entry.Size;
+
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkOutputCachePipeline::EvictEntries(unsigned long size)
+{
+  vtkOutputCachePipelineInternals::EntriesType& entries =
+    this->Internals->Entries;
+  while (this->CacheMemorySize > size && !entries.empty())
+    {
+    vtkOutputCachePipelineInternals::EntriesType::iterator victim =
+      entries.end();
+    --victim;
+    if (this->EvictionPolicy == COST_AWARE)
+      {
+      // Of equal priorities, evict the least recently used.
+      vtkOutputCachePipelineInternals::EntriesType::iterator it;
+      for (it = entries.begin(); it != entries.end(); ++it)
+        {
+        if (it->Priority < victim->Priority)
+          {
+          victim = it;
+          }
+        }
+      this->Internals->Inflation = victim->Priority;
+      }
+    this->CacheMemorySize -= victim->Size;
+    entries.erase(victim);
+    ++this->NumberOfEvictions;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkOutputCachePipeline::RemoveStaleEntries()
+{
+  vtkOutputCachePipelineInternals::EntriesType& entries =
+    this->Internals->Entries;
+  vtkOutputCachePipelineInternals::EntriesType::iterator it = entries.begin();
+  while (it != entries.end())
+    {
+    if (this->PipelineMTime > it->Time)
+      {
+      this->CacheMemorySize -= it->Size;
+      it = entries.erase(it);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+}
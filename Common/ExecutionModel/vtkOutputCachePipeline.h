@@ -0,0 +1,140 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkOutputCachePipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkOutputCachePipeline - Executive keeping recent outputs of its
+// algorithm within a memory budget.
+// .SECTION Description
+// vtkOutputCachePipeline keeps a shallow copy of the outputs of its
+// algorithm after each execution, keyed by the request that produced them:
+// the output port, the update time step (when the pipeline provides time),
+// the update piece, number of pieces and ghost levels, and the update
+// extent. When a later request matches a cached key and neither the
+// algorithm nor anything upstream has been modified since, the cached
+// outputs are restored and neither the algorithm nor its inputs execute.
+// Going back to a recent time step or piece, as when scrubbing through
+// time, then costs no reading or filtering.
+//
+// The cache holds at most MemoryLimit kibibytes, as reported by
+// vtkDataObject::GetActualMemorySize() for the outputs of each entry.
+// Outputs larger than the limit are not cached. When the cache is full the
+// least recently used entry is evicted, or, with the COST_AWARE policy,
+// the entry with the smallest execution time per kibibyte, aged with the
+// GreedyDual-Size algorithm so that entries not used anymore are
+// eventually evicted however costly they were.
+//
+// The number of hits, misses and evictions are counted for
+// instrumentation. A miss is an execution of the algorithm for a request
+// that could have been cached.
+//
+// Requests for composite indices, and other request keys of the output
+// information than those listed above, are not part of the cache key: the
+// cache should not be used with algorithms answering such requests.
+// Since the entries are shallow copies, the cached arrays are shared with
+// the outputs and stay in memory when the outputs are released.
+//
+// .SECTION See Also
+// vtkCompositeDataPipeline vtkCachedStreamingDemandDrivenPipeline
+
+#ifndef vtkOutputCachePipeline_h
+#define vtkOutputCachePipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class vtkOutputCachePipelineInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkOutputCachePipeline :
+  public vtkCompositeDataPipeline
+{
+public:
+  static vtkOutputCachePipeline* New();
+  vtkTypeMacro(vtkOutputCachePipeline,vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  enum EvictionPolicies
+  {
+    LEAST_RECENTLY_USED = 0,
+    COST_AWARE = 1
+  };
+
+  // Description:
+  // Maximum memory held by the cache, in kibibytes. Defaults to 1 GiB.
+  // Reducing it evicts entries right away.
+  void SetMemoryLimit(unsigned long limit);
+  vtkGetMacro(MemoryLimit, unsigned long);
+
+  // Description:
+  // How entries are chosen for eviction. Defaults to LEAST_RECENTLY_USED.
+  vtkSetClampMacro(EvictionPolicy, int, LEAST_RECENTLY_USED, COST_AWARE);
+  vtkGetMacro(EvictionPolicy, int);
+  void SetEvictionPolicyToLeastRecentlyUsed()
+    { this->SetEvictionPolicy(LEAST_RECENTLY_USED); }
+  void SetEvictionPolicyToCostAware()
+    { this->SetEvictionPolicy(COST_AWARE); }
+
+  // Description:
+  // Remove all the entries from the cache.
+  void ClearCache();
+
+  // Description:
+  // Number of entries in the cache and memory they use, in kibibytes.
+  int GetNumberOfCachedOutputs();
+  vtkGetMacro(CacheMemorySize, unsigned long);
+
+  // Description:
+  // Number of requests answered from the cache, of executions of the
+  // algorithm for cacheable requests, and of entries evicted to respect
+  // the memory limit, since construction or ResetStatistics().
+  vtkGetMacro(NumberOfHits, vtkIdType);
+  vtkGetMacro(NumberOfMisses, vtkIdType);
+  vtkGetMacro(NumberOfEvictions, vtkIdType);
+  void ResetStatistics();
+
+protected:
+  vtkOutputCachePipeline();
+  ~vtkOutputCachePipeline();
+
+  virtual int NeedToExecuteData(int outputPort,
+                                vtkInformationVector** inInfoVec,
+                                vtkInformationVector* outInfoVec);
+  virtual int ExecuteData(vtkInformation* request,
+                          vtkInformationVector** inInfoVec,
+                          vtkInformationVector* outInfoVec);
+
+  // Restore the outputs cached for the request on the given port. Returns
+  // 1 on a hit.
+  int RestoreOutputs(int outputPort, vtkInformationVector** inInfoVec,
+                     vtkInformationVector* outInfoVec);
+
+  // Evict entries until the cache holds at most size kibibytes.
+  void EvictEntries(unsigned long size);
+
+  // Remove the entries older than the pipeline.
+  void RemoveStaleEntries();
+
+  unsigned long MemoryLimit;
+  int EvictionPolicy;
+  unsigned long CacheMemorySize;
+  vtkIdType NumberOfHits;
+  vtkIdType NumberOfMisses;
+  vtkIdType NumberOfEvictions;
+
+  vtkOutputCachePipelineInternals* Internals;
+
+private:
+  vtkOutputCachePipeline(const vtkOutputCachePipeline&);  // Not implemented.
+  void operator=(const vtkOutputCachePipeline&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,426 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkAlgorithmOutput.h"
+#include "vtkCallbackCommand.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkPipelineProfiler);
+
+//----------------------------------------------------------------------------
+class vtkPipelineProfilerInternals
+{
+public:
+  struct Event
+  {
+    int Algorithm;
+    std::string Pass;
+    int Thread;
+    double Start;
+    double WallTime;
+    double CPUTime;
+    unsigned long Memory;
+  };
+
+  struct Total
+  {
+    Total() : NumberOfEvents(0), WallTime(0.0), CPUTime(0.0) {}
+    int Algorithm;
+    std::string Pass;
+    int NumberOfEvents;
+    double WallTime;
+    double CPUTime;
+    bool operator<(const Total& other) const
+      {
+      return this->WallTime > other.WallTime;
+      }
+  };
+
+  struct AlgorithmEntry
+  {
+    int Id;
+    unsigned long DeleteObserver;
+  };
+
+  vtkPipelineProfilerInternals()
+  {
+    this->DeleteCallback = vtkCallbackCommand::New();
+    this->DeleteCallback->SetCallback(
+      &vtkPipelineProfilerInternals::AlgorithmDeleted);
+    this->DeleteCallback->SetClientData(this);
+  }
+
+  ~vtkPipelineProfilerInternals()
+  {
+    this->ForgetAlgorithms();
+    this->DeleteCallback->Delete();
+  }
+
+  // Get the id of an algorithm, giving it one if needed. The algorithm is
+  // forgotten when it is deleted, so that an algorithm allocated later at
+  // the same address gets a new id.
+  int GetAlgorithm(vtkAlgorithm* algorithm)
+  {
+    std::map<vtkAlgorithm*, AlgorithmEntry>::iterator found =
+      this->Algorithms.find(algorithm);
+    if (found != this->Algorithms.end())
+      {
+      return found->second.Id;
+      }
+    AlgorithmEntry entry;
+    entry.Id = static_cast<int>(this->ClassNames.size());
+    entry.DeleteObserver =
+      algorithm->AddObserver(vtkCommand::DeleteEvent, this->DeleteCallback);
+    this->Algorithms[algorithm] = entry;
+    this->ClassNames.push_back(algorithm->GetClassName());
+    this->InputIds.resize(this->ClassNames.size());
+    return entry.Id;
+  }
+
+  // Get the id of an algorithm, or -1 if it was never recorded or was
+  // deleted since.
+  int FindAlgorithm(vtkAlgorithm* algorithm)
+  {
+    std::map<vtkAlgorithm*, AlgorithmEntry>::iterator found =
+      this->Algorithms.find(algorithm);
+    return found != this->Algorithms.end() ? found->second.Id : -1;
+  }
+
+  // Stop observing the algorithms that are still alive.
+  void ForgetAlgorithms()
+  {
+    for (std::map<vtkAlgorithm*, AlgorithmEntry>::iterator it =
+         this->Algorithms.begin(); it != this->Algorithms.end(); ++it)
+      {
+      it->first->RemoveObserver(it->second.DeleteObserver);
+      }
+    this->Algorithms.clear();
+  }
+
+  static void AlgorithmDeleted(vtkObject* caller, unsigned long, void* self,
+                               void*)
+  {
+    vtkPipelineProfilerInternals* internals =
+      static_cast<vtkPipelineProfilerInternals*>(self);
+    internals->Lock.Lock();
+    internals->Algorithms.erase(static_cast<vtkAlgorithm*>(caller));
+    internals->Lock.Unlock();
+  }
+
+  // Get a small index for the calling thread.
+  int GetThread()
+  {
+    vtkMultiThreaderIDType id = vtkMultiThreader::GetCurrentThreadID();
+    for (size_t i = 0; i < this->Threads.size(); ++i)
+      {
+      if (vtkMultiThreader::ThreadsEqual(this->Threads[i], id))
+        {
+        return static_cast<int>(i);
+        }
+      }
+    this->Threads.push_back(id);
+    return static_cast<int>(this->Threads.size()) - 1;
+  }
+
+  std::vector<Total> ComputeTotals()
+  {
+    std::map<std::pair<int, std::string>, Total> totals;
+    for (size_t i = 0; i < this->Events.size(); ++i)
+      {
+      const Event& event = this->Events[i];
+      Total& total = totals[std::make_pair(event.Algorithm, event.Pass)];
+      total.Algorithm = event.Algorithm;
+      total.Pass = event.Pass;
+      total.NumberOfEvents++;
+      total.WallTime += event.WallTime;
+      total.CPUTime += event.CPUTime;
+      }
+    std::vector<Total> sorted;
+    for (std::map<std::pair<int, std::string>, Total>::iterator it =
+         totals.begin(); it != totals.end(); ++it)
+      {
+      sorted.push_back(it->second);
+      }
+    std::stable_sort(sorted.begin(), sorted.end());
+    return sorted;
+  }
+
+  vtkSimpleCriticalSection Lock;
+  double Origin;
+  std::vector<Event> Events;
+  // The algorithms alive that have an id.
+  std::map<vtkAlgorithm*, AlgorithmEntry> Algorithms;
+  vtkCallbackCommand* DeleteCallback;
+  // Indexed by algorithm id, including the deleted algorithms.
+  std::vector<std::string> ClassNames;
+  std::vector<std::set<int> > InputIds;
+  std::vector<vtkMultiThreaderIDType> Threads;
+};
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler::vtkPipelineProfiler()
+{
+  this->Internals = new vtkPipelineProfilerInternals;
+  this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler::~vtkPipelineProfiler()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Number Of Events: " << this->GetNumberOfEvents() << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::StartPass(double start[2])
+{
+  start[0] = vtkTimerLog::GetUniversalTime();
+  start[1] = vtkTimerLog::GetCPUTime();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::EndPass(const double start[2],
+                                  vtkAlgorithm* algorithm,
+                                  vtkInformation* request,
+                                  vtkInformationVector* outInfo)
+{
+  vtkPipelineProfilerInternals::Event event;
+  event.WallTime = vtkTimerLog::GetUniversalTime() - start[0];
+  event.CPUTime = vtkTimerLog::GetCPUTime() - start[1];
+
+  // The request is identified by its request key.
+  vtkInformationRequestKey* key = request->GetRequest();
+  event.Pass = key ? key->GetName() : "";
+
+  event.Memory = 0;
+  for (int i = 0; outInfo && i < outInfo->GetNumberOfInformationObjects(); ++i)
+    {
+    if (vtkDataObject* output =
+        outInfo->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT()))
+      {
+      event.Memory += output->GetActualMemorySize();
+      }
+    }
+
+  this->Internals->Lock.Lock();
+  event.Start = start[0] - this->Internals->Origin;
+  event.Thread = this->Internals->GetThread();
+  event.Algorithm = this->Internals->GetAlgorithm(algorithm);
+  for (int i = 0; i < algorithm->GetNumberOfInputPorts(); ++i)
+    {
+    for (int j = 0; j < algorithm->GetNumberOfInputConnections(i); ++j)
+      {
+      vtkAlgorithmOutput* input = algorithm->GetInputConnection(i, j);
+      if (input && input->GetProducer())
+        {
+        int producer = this->Internals->GetAlgorithm(input->GetProducer());
+        this->Internals->InputIds[event.Algorithm].insert(producer);
+        }
+      }
+    }
+  this->Internals->Events.push_back(event);
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::Clear()
+{
+  this->Internals->Lock.Lock();
+  this->Internals->Events.clear();
+  this->Internals->ForgetAlgorithms();
+  this->Internals->ClassNames.clear();
+  this->Internals->InputIds.clear();
+  this->Internals->Threads.clear();
+  this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::GetNumberOfEvents()
+{
+  this->Internals->Lock.Lock();
+  int numberOfEvents = static_cast<int>(this->Internals->Events.size());
+  this->Internals->Lock.Unlock();
+  return numberOfEvents;
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::GetNumberOfPasses(vtkAlgorithm* algorithm,
+                                           const char* pass)
+{
+  int numberOfPasses = 0;
+  this->Internals->Lock.Lock();
+  int id = this->Internals->FindAlgorithm(algorithm);
+  if (id >= 0 && pass)
+    {
+    for (size_t i = 0; i < this->Internals->Events.size(); ++i)
+      {
+      if (this->Internals->Events[i].Algorithm == id &&
+          this->Internals->Events[i].Pass == pass)
+        {
+        ++numberOfPasses;
+        }
+      }
+    }
+  this->Internals->Lock.Unlock();
+  return numberOfPasses;
+}
+
+//----------------------------------------------------------------------------
+double vtkPipelineProfiler::GetWallTime(vtkAlgorithm* algorithm,
+                                        const char* pass)
+{
+  double wallTime = 0.0;
+  this->Internals->Lock.Lock();
+  int id = this->Internals->FindAlgorithm(algorithm);
+  if (id >= 0 && pass)
+    {
+    for (size_t i = 0; i < this->Internals->Events.size(); ++i)
+      {
+      if (this->Internals->Events[i].Algorithm == id &&
+          this->Internals->Events[i].Pass == pass)
+        {
+        wallTime += this->Internals->Events[i].WallTime;
+        }
+      }
+    }
+  this->Internals->Lock.Unlock();
+  return wallTime;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintChromeTrace(ostream& os)
+{
+  this->Internals->Lock.Lock();
+  std::streamsize precision = os.precision(15);
+  os << "{\"traceEvents\":[";
+  for (size_t i = 0; i < this->Internals->Events.size(); ++i)
+    {
+    const vtkPipelineProfilerInternals::Event& event =
+      this->Internals->Events[i];
+    const std::set<int>& inputs = this->Internals->InputIds[event.Algorithm];
+    os << (i ? ",\n" : "\n")
+       << "{\"name\":\""
+       << this->Internals->ClassNames[event.Algorithm] << " ("
+       << event.Algorithm << ")\",\"cat\":\"" << event.Pass
+       << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.Thread
+       << ",\"ts\":" << event.Start * 1.0e6
+       << ",\"dur\":" << event.WallTime * 1.0e6
+       << ",\"args\":{\"pass\":\"" << event.Pass
+       << "\",\"algorithm\":" << event.Algorithm
+       << ",\"cpu_time\":" << event.CPUTime
+       << ",\"memory_kb\":" << event.Memory << ",\"inputs\":[";
+    for (std::set<int>::const_iterator it = inputs.begin();
+         it != inputs.end(); ++it)
+      {
+      os << (it == inputs.begin() ? "" : ",") << *it;
+      }
+    os << "]}}";
+    }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  os.precision(precision);
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::WriteChromeTrace(const char* filename)
+{
+  ofstream os(filename);
+  if (!os)
+    {
+    vtkErrorMacro("Cannot open " << (filename ? filename : "(null)"));
+    return 0;
+    }
+  this->PrintChromeTrace(os);
+  return os.good() ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintCSV(ostream& os)
+{
+  this->Internals->Lock.Lock();
+  std::streamsize precision = os.precision(15);
+  os << "algorithm,class,pass,thread,start,wall_time,cpu_time,memory_kb,"
+     << "inputs\n";
+  for (size_t i = 0; i < this->Internals->Events.size(); ++i)
+    {
+    const vtkPipelineProfilerInternals::Event& event =
+      this->Internals->Events[i];
+    const std::set<int>& inputs = this->Internals->InputIds[event.Algorithm];
+    os << event.Algorithm << ","
+       << this->Internals->ClassNames[event.Algorithm] << ","
+       << event.Pass << "," << event.Thread << "," << event.Start << ","
+       << event.WallTime << "," << event.CPUTime << "," << event.Memory << ",";
+    for (std::set<int>::const_iterator it = inputs.begin();
+         it != inputs.end(); ++it)
+      {
+      os << (it == inputs.begin() ? "" : " ") << *it;
+      }
+    os << "\n";
+    }
+  os.precision(precision);
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::WriteCSV(const char* filename)
+{
+  ofstream os(filename);
+  if (!os)
+    {
+    vtkErrorMacro("Cannot open " << (filename ? filename : "(null)"));
+    return 0;
+    }
+  this->PrintCSV(os);
+  return os.good() ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSummary(ostream& os)
+{
+  this->Internals->Lock.Lock();
+  std::vector<vtkPipelineProfilerInternals::Total> totals =
+    this->Internals->ComputeTotals();
+  os << "Wall time (s)\tCPU time (s)\tEvents\tPass\tAlgorithm\n";
+  for (size_t i = 0; i < totals.size(); ++i)
+    {
+    os << totals[i].WallTime << "\t" << totals[i].CPUTime << "\t"
+       << totals[i].NumberOfEvents << "\t" << totals[i].Pass << "\t"
+       << this->Internals->ClassNames[totals[i].Algorithm] << " ("
+       << totals[i].Algorithm << ")\n";
+    }
+  this->Internals->Lock.Unlock();
+}
@@ -0,0 +1,115 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPipelineProfiler - Record the time spent by every algorithm in
+// every pipeline pass.
+// .SECTION Description
+// Once set with vtkExecutive::SetProfiler(), vtkPipelineProfiler records an
+// event each time an executive invokes a request (REQUEST_DATA_OBJECT,
+// REQUEST_INFORMATION, REQUEST_UPDATE_EXTENT, REQUEST_DATA, ...) on its
+// algorithm, in all pipelines. An event holds the algorithm, the request,
+// the calling thread, the wall clock time and the CPU time spent in the
+// algorithm, and the memory used by its outputs afterwards. The time spent
+// updating the inputs is not included. For each algorithm, the algorithms
+// producing its inputs are recorded too.
+//
+// Each algorithm gets an id the first time it is recorded. The profiler
+// observes the DeleteEvent of the algorithms it knows, so that the events
+// of a deleted algorithm are kept under its id while an algorithm later
+// allocated at the same address gets a new one.
+//
+// The events are exported in the Chrome trace event format, to be loaded
+// in chrome://tracing or similar viewers, or as CSV. PrintSummary() lists
+// the total time of each algorithm and pass, the most expensive first.
+//
+// CPU time is the process CPU time (see vtkTimerLog::GetCPUTime()), which
+// includes the threads an algorithm uses but also whatever else runs
+// concurrently. Events may be recorded from several threads.
+//
+// .SECTION See Also
+// vtkExecutive vtkExecutionTimer vtkTimerLog
+
+#ifndef vtkPipelineProfiler_h
+#define vtkPipelineProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkInformation;
+class vtkInformationVector;
+class vtkPipelineProfilerInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineProfiler : public vtkObject
+{
+public:
+  static vtkPipelineProfiler* New();
+  vtkTypeMacro(vtkPipelineProfiler,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Called by the executives around the requests they invoke on their
+  // algorithm. StartPass() fills start with the wall clock and CPU times.
+  void StartPass(double start[2]);
+  void EndPass(const double start[2], vtkAlgorithm* algorithm,
+               vtkInformation* request, vtkInformationVector* outInfo);
+
+  // Description:
+  // Remove all the recorded events and algorithms. Event times are relative
+  // to the last call to Clear(), or to the construction of the profiler.
+  void Clear();
+
+  // Description:
+  // Get the number of recorded events.
+  int GetNumberOfEvents();
+
+  // Description:
+  // Get the number of times the given request (by the name of its key,
+  // "REQUEST_DATA" for example) was invoked on the algorithm, and the
+  // total wall clock time spent in it, in seconds. The algorithm must not
+  // have been deleted.
+  int GetNumberOfPasses(vtkAlgorithm* algorithm, const char* pass);
+  double GetWallTime(vtkAlgorithm* algorithm, const char* pass);
+
+  // Description:
+  // Export the events in the Chrome trace event format (JSON). The Write
+  // method returns 0 if the file could not be written.
+  void PrintChromeTrace(ostream& os);
+  int WriteChromeTrace(const char* filename);
+
+  // Description:
+  // Export the events as CSV, one line per event. Times are in seconds,
+  // memory in kibibytes, and inputs lists the ids of the algorithms
+  // producing the inputs. The Write method returns 0 if the file could not
+  // be written.
+  void PrintCSV(ostream& os);
+  int WriteCSV(const char* filename);
+
+  // Description:
+  // Print, for each algorithm and pass, the number of events and the total
+  // wall clock and CPU times, sorted by decreasing wall clock time.
+  void PrintSummary(ostream& os);
+
+protected:
+  vtkPipelineProfiler();
+  ~vtkPipelineProfiler();
+
+  vtkPipelineProfilerInternals* Internals;
+
+private:
+  vtkPipelineProfiler(const vtkPipelineProfiler&);  // Not implemented.
+  void operator=(const vtkPipelineProfiler&);  // Not implemented.
+};
+
+#endif
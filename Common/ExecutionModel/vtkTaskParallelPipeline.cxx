@@ -0,0 +1,485 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTaskParallelPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkTaskParallelPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkAtomicTypes.h"
+#include "vtkCollection.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataSet.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkTaskParallelPipeline);
+
+vtkInformationKeyMacro(vtkTaskParallelPipeline, THREAD_SAFE, Integer);
+
+namespace
+{
+// Number of graphs executing. Updates requested meanwhile use the serial
+// pipeline.
+vtkAtomicInt32 ActiveGraphs(0);
+
+// Compute the lazily built structures of a data set that its readers would
+// otherwise build concurrently.
+void PrepareForConcurrentReads(vtkDataObject* dataObject)
+{
+  if (vtkCompositeDataSet* composite =
+      vtkCompositeDataSet::SafeDownCast(dataObject))
+    {
+    vtkCompositeDataIterator* iter = composite->NewIterator();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+         iter->GoToNextItem())
+      {
+      PrepareForConcurrentReads(iter->GetCurrentDataObject());
+      }
+    iter->Delete();
+    return;
+    }
+  if (vtkDataSet* dataSet = vtkDataSet::SafeDownCast(dataObject))
+    {
+    double bounds[6];
+    dataSet->GetBounds(bounds);
+    }
+  vtkPolyData* polyData = vtkPolyData::SafeDownCast(dataObject);
+  if (polyData && polyData->GetNumberOfCells() > 0)
+    {
+    // Builds the cells if needed.
+    polyData->GetCellType(0);
+    }
+}
+}
+
+//----------------------------------------------------------------------------
+// The algorithms that need to execute to update one or more sinks, with
+// the producer to consumer dependencies between them.
+class vtkTaskParallelPipelineGraph
+{
+public:
+  struct Node
+  {
+    vtkExecutive* Executive;
+    vtkTaskParallelPipeline* Pipeline; // NULL for other executives.
+    int Port; // Output port requested, -1 for all of them.
+    bool Concurrent;
+    int Pending; // Producers not executed yet.
+    int Result; // 0 once the node or one of its producers failed.
+    std::vector<int> Consumers;
+  };
+
+  // Add the executive requested through port if it needs to execute, and
+  // recursively its producers. Returns the index of its node, -1 if it is
+  // up to date.
+  int Add(vtkExecutive* executive, int port);
+
+  // Execute the nodes, producers first. Returns 0 if one of them failed.
+  int Execute();
+
+  static void Run(Node& node);
+
+  std::vector<Node> Nodes;
+
+private:
+  std::map<vtkExecutive*, int> Index;
+  std::set<std::pair<vtkExecutive*, int> > UpToDate;
+};
+
+//----------------------------------------------------------------------------
+class vtkTaskParallelPipelineFunctor
+{
+public:
+  vtkTaskParallelPipelineFunctor(vtkTaskParallelPipelineGraph& graph,
+                                 const std::vector<int>& tasks)
+    : Graph(graph), Tasks(tasks)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkTaskParallelPipelineGraph::Run(this->Graph.Nodes[this->Tasks[i]]);
+      }
+  }
+
+  vtkTaskParallelPipelineGraph& Graph;
+  const std::vector<int>& Tasks;
+};
+
+//----------------------------------------------------------------------------
+int vtkTaskParallelPipelineGraph::Add(vtkExecutive* executive, int port)
+{
+  std::map<vtkExecutive*, int>::iterator found = this->Index.find(executive);
+  if (found != this->Index.end())
+    {
+    Node& node = this->Nodes[found->second];
+    if (node.Port != port)
+      {
+      node.Port = -1;
+      }
+    return found->second;
+    }
+  if (this->UpToDate.find(std::make_pair(executive, port)) !=
+      this->UpToDate.end())
+    {
+    return -1;
+    }
+
+  // As the serial pipeline, do not go upstream of algorithms that are up to
+  // date. Other executives are assumed to need to execute, they check for
+  // themselves when they do.
+  vtkTaskParallelPipeline* pipeline =
+    vtkTaskParallelPipeline::SafeDownCast(executive);
+  if (pipeline &&
+      !pipeline->NeedToExecuteData(port, pipeline->GetInputInformation(),
+                                   pipeline->GetOutputInformation()))
+    {
+    this->UpToDate.insert(std::make_pair(executive, port));
+    return -1;
+    }
+
+  vtkAlgorithm* algorithm = executive->GetAlgorithm();
+  int index = static_cast<int>(this->Nodes.size());
+  this->Index[executive] = index;
+  this->Nodes.push_back(Node());
+  Node& node = this->Nodes.back();
+  node.Executive = executive;
+  node.Pipeline = pipeline;
+  node.Port = port;
+  node.Pending = 0;
+  node.Result = 1;
+  int compositePort;
+  node.Concurrent = pipeline &&
+    algorithm->GetInformation()->Get(vtkTaskParallelPipeline::THREAD_SAFE()) &&
+    !pipeline->ShouldIterateOverInput(pipeline->GetInputInformation(),
+                                      compositePort);
+
+  // Executives sharing their input information never forward requests.
+  if (pipeline && pipeline->SharedInputInformation)
+    {
+    return index;
+    }
+  for (int i = 0; i < algorithm->GetNumberOfInputPorts(); ++i)
+    {
+    vtkInformationVector* inVector = executive->GetInputInformation()[i];
+    int numConnections = algorithm->GetNumberOfInputConnections(i);
+    for (int j = 0; j < numConnections; ++j)
+      {
+      vtkExecutive* producer;
+      int producerPort;
+      vtkExecutive::PRODUCER()->Get(inVector->GetInformationObject(j),
+                                    producer, producerPort);
+      if (!producer)
+        {
+        continue;
+        }
+      int producerIndex = this->Add(producer, producerPort);
+      if (producerIndex >= 0)
+        {
+        // Nodes may have been reallocated.
+        this->Nodes[producerIndex].Consumers.push_back(index);
+        this->Nodes[index].Pending++;
+        }
+      }
+    }
+  return index;
+}
+
+//----------------------------------------------------------------------------
+int vtkTaskParallelPipelineGraph::Execute()
+{
+  ++ActiveGraphs;
+
+  // Consumers release their inputs when they are done, while other
+  // consumers of the same data may still be reading it. Hold the release
+  // until the graph has executed.
+  std::vector<vtkInformation*> released;
+  for (size_t n = 0; n < this->Nodes.size(); ++n)
+    {
+    vtkExecutive* executive = this->Nodes[n].Executive;
+    for (int i = 0; i < executive->GetNumberOfInputPorts(); ++i)
+      {
+      vtkInformationVector* inVector = executive->GetInputInformation()[i];
+      for (int j = 0; j < inVector->GetNumberOfInformationObjects(); ++j)
+        {
+        vtkInformation* inInfo = inVector->GetInformationObject(j);
+        if (inInfo->Get(vtkDemandDrivenPipeline::RELEASE_DATA()))
+          {
+          inInfo->Set(vtkDemandDrivenPipeline::RELEASE_DATA(), 0);
+          released.push_back(inInfo);
+          }
+        }
+      }
+    }
+
+  std::vector<int> ready;
+  for (size_t n = 0; n < this->Nodes.size(); ++n)
+    {
+    if (this->Nodes[n].Pending == 0)
+      {
+      ready.push_back(static_cast<int>(n));
+      }
+    }
+
+  int result = 1;
+  while (!ready.empty())
+    {
+    std::vector<int> concurrent;
+    std::vector<int> serial;
+    for (size_t r = 0; r < ready.size(); ++r)
+      {
+      Node& node = this->Nodes[ready[r]];
+      if (node.Result)
+        {
+        (node.Concurrent ? concurrent : serial).push_back(ready[r]);
+        }
+      }
+
+    if (concurrent.size() > 1)
+      {
+      for (size_t c = 0; c < concurrent.size(); ++c)
+        {
+        vtkExecutive* executive = this->Nodes[concurrent[c]].Executive;
+        for (int i = 0; i < executive->GetNumberOfInputPorts(); ++i)
+          {
+          vtkInformationVector* inVector = executive->GetInputInformation()[i];
+          for (int j = 0; j < inVector->GetNumberOfInformationObjects(); ++j)
+            {
+            PrepareForConcurrentReads(
+              inVector->GetInformationObject(j)->Get(
+                vtkDataObject::DATA_OBJECT()));
+            }
+          }
+        }
+      vtkTaskParallelPipelineFunctor functor(*this, concurrent);
+      vtkSMPTools::For(0, static_cast<vtkIdType>(concurrent.size()), 1,
+                       functor);
+      }
+    else if (concurrent.size() == 1)
+      {
+      Run(this->Nodes[concurrent[0]]);
+      }
+    // The others execute alone.
+    for (size_t s = 0; s < serial.size(); ++s)
+      {
+      Run(this->Nodes[serial[s]]);
+      }
+
+    // Consumers of failed nodes are skipped, as when ForwardUpstream fails.
+    std::vector<int> next;
+    for (size_t r = 0; r < ready.size(); ++r)
+      {
+      Node& node = this->Nodes[ready[r]];
+      result = result && node.Result;
+      for (size_t c = 0; c < node.Consumers.size(); ++c)
+        {
+        Node& consumer = this->Nodes[node.Consumers[c]];
+        consumer.Result = consumer.Result && node.Result;
+        if (--consumer.Pending == 0)
+          {
+          next.push_back(node.Consumers[c]);
+          }
+        }
+      }
+    ready.swap(next);
+    }
+
+  for (size_t r = 0; r < released.size(); ++r)
+    {
+    released[r]->Set(vtkDemandDrivenPipeline::RELEASE_DATA(), 1);
+    if (vtkDataObject* dataObject =
+        released[r]->Get(vtkDataObject::DATA_OBJECT()))
+      {
+      dataObject->ReleaseData();
+      }
+    }
+
+  --ActiveGraphs;
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkTaskParallelPipelineGraph::Run(Node& node)
+{
+  vtkInformation* request = vtkInformation::New();
+  request->Set(vtkDemandDrivenPipeline::REQUEST_DATA());
+  request->Set(vtkExecutive::FORWARD_DIRECTION(),
+               vtkExecutive::RequestUpstream);
+  request->Set(vtkExecutive::ALGORITHM_AFTER_FORWARD(), 1);
+  request->Set(vtkDemandDrivenPipeline::FROM_OUTPUT_PORT(), node.Port);
+  if (node.Pipeline)
+    {
+    node.Pipeline->InScheduledExecution = 1;
+    }
+  node.Result = node.Executive->ProcessRequest(
+    request, node.Executive->GetInputInformation(),
+    node.Executive->GetOutputInformation());
+  if (node.Pipeline)
+    {
+    node.Pipeline->InScheduledExecution = 0;
+    }
+  request->Delete();
+}
+
+//----------------------------------------------------------------------------
+vtkTaskParallelPipeline::vtkTaskParallelPipeline()
+{
+  this->InScheduledExecution = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTaskParallelPipeline::~vtkTaskParallelPipeline()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkTaskParallelPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "InScheduledExecution: " << this->InScheduledExecution
+     << "\n";
+}
+
+//----------------------------------------------------------------------------
+int vtkTaskParallelPipeline::UpdateData(int outputPort)
+{
+  if (vtkDataObject::GetGlobalReleaseDataFlag() || ActiveGraphs > 0 ||
+      outputPort < -1 ||
+      outputPort >= this->Algorithm->GetNumberOfOutputPorts())
+    {
+    return this->Superclass::UpdateData(outputPort);
+    }
+
+  // The algorithm should not invoke anything on the executive.
+  if (!this->CheckAlgorithm("UpdateData", 0))
+    {
+    return 0;
+    }
+
+  vtkTaskParallelPipelineGraph graph;
+  graph.Add(this, outputPort);
+  return graph.Execute();
+}
+
+//----------------------------------------------------------------------------
+int vtkTaskParallelPipeline::UpdateAlgorithms(vtkCollection* algorithms)
+{
+  if (!algorithms)
+    {
+    return 1;
+    }
+
+  bool serial = vtkDataObject::GetGlobalReleaseDataFlag() || ActiveGraphs > 0;
+  std::vector<vtkAlgorithm*> others;
+  std::vector<std::pair<vtkTaskParallelPipeline*, int> > sinks;
+  int result = 1;
+  vtkCollectionSimpleIterator cookie;
+  algorithms->InitTraversal(cookie);
+  while (vtkObject* object = algorithms->GetNextItemAsObject(cookie))
+    {
+    vtkAlgorithm* algorithm = vtkAlgorithm::SafeDownCast(object);
+    if (!algorithm)
+      {
+      continue;
+      }
+    vtkTaskParallelPipeline* pipeline =
+      vtkTaskParallelPipeline::SafeDownCast(algorithm->GetExecutive());
+    if (serial || !pipeline)
+      {
+      others.push_back(algorithm);
+      continue;
+      }
+
+    // The passes before REQUEST_DATA, as in Update().
+    int port = algorithm->GetNumberOfOutputPorts() ? 0 : -1;
+    if (!pipeline->UpdateInformation())
+      {
+      result = 0;
+      continue;
+      }
+    pipeline->PropagateTime(port);
+    pipeline->UpdateTimeDependentInformation(port);
+    if (!pipeline->PropagateUpdateExtent(port))
+      {
+      result = 0;
+      continue;
+      }
+    if (!pipeline->LastPropogateUpdateExtentShortCircuited)
+      {
+      sinks.push_back(std::make_pair(pipeline, port));
+      }
+    }
+
+  if (!sinks.empty())
+    {
+    vtkTaskParallelPipelineGraph graph;
+    for (size_t s = 0; s < sinks.size(); ++s)
+      {
+      graph.Add(sinks[s].first, sinks[s].second);
+      }
+    result = graph.Execute() && result;
+
+    // Streaming algorithms asking for more passes get them one at a time.
+    for (size_t s = 0; s < sinks.size(); ++s)
+      {
+      if (sinks[s].first->ContinueExecuting)
+        {
+        result = sinks[s].first->Update(sinks[s].second) && result;
+        }
+      }
+    }
+
+  for (size_t o = 0; o < others.size(); ++o)
+    {
+    result = others[o]->GetExecutive()->Update() && result;
+    }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkTaskParallelPipeline::ForwardUpstream(vtkInformation* request)
+{
+  if (this->InScheduledExecution && request->Has(REQUEST_DATA()) &&
+      !this->SharedInputInformation)
+    {
+    return this->Algorithm->ModifyRequest(request, BeforeForward) &&
+      this->Algorithm->ModifyRequest(request, AfterForward);
+    }
+  return this->Superclass::ForwardUpstream(request);
+}
+
+//----------------------------------------------------------------------------
+int vtkTaskParallelPipeline::ForwardUpstream(
+  int i, int j, vtkInformation* request)
+{
+  if (this->InScheduledExecution && request->Has(REQUEST_DATA()) &&
+      !this->SharedInputInformation)
+    {
+    return this->Algorithm->ModifyRequest(request, BeforeForward) &&
+      this->Algorithm->ModifyRequest(request, AfterForward);
+    }
+  return this->Superclass::ForwardUpstream(i, j, request);
+}
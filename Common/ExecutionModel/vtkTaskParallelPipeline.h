@@ -0,0 +1,110 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTaskParallelPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkTaskParallelPipeline - Executive running independent branches
+// of a pipeline concurrently.
+// .SECTION Description
+// vtkTaskParallelPipeline executes the REQUEST_DATA pass of the pipeline
+// upstream of an algorithm as a graph of tasks instead of a depth-first
+// recursion. The algorithms that need to execute are scheduled in rounds:
+// each round runs every algorithm whose inputs are up to date, using
+// vtkSMPTools::For to run them concurrently. Sibling branches and the
+// inputs of fan-in filters (vtkAppendPolyData, vtkProbeFilter, ...) thus
+// execute in parallel. The data-object, information, time and update
+// extent passes are unchanged and run serially beforehand.
+//
+// The contract for concurrent execution is the following. An algorithm
+// runs concurrently with other algorithms only if
+// - it declares itself thread safe by setting THREAD_SAFE() to 1 in its
+//   information (vtkAlgorithm::GetInformation()), promising that
+//   RequestData only writes its own outputs and members and only reads its
+//   inputs (no lazily built locators or links on the inputs, no static
+//   state);
+// - its executive is a vtkTaskParallelPipeline;
+// - it is not iterated over the blocks of a composite input, which rewrites
+//   the information of the producer.
+// Other algorithms run one at a time on the calling thread, while no other
+// algorithm is executing. Before concurrent consumers read a data set, its
+// bounds (and the cells of a vtkPolyData) are computed on the calling
+// thread. Progress and other events of concurrent algorithms are invoked on
+// worker threads.
+//
+// Outputs flagged with RELEASE_DATA() are released once the whole graph
+// has executed rather than after each consumer. The serial pipeline is
+// used when the global release data flag is set, and when an update is
+// requested while a graph is executing (from within an algorithm for
+// example).
+//
+// UpdateAlgorithms() updates several sinks, possibly sharing upstream
+// algorithms, as a single graph. The sinks must then request compatible
+// update extents, pieces and time steps from the shared algorithms.
+//
+// .SECTION See Also
+// vtkCompositeDataPipeline vtkThreadedCompositeDataPipeline vtkSMPTools
+
+#ifndef vtkTaskParallelPipeline_h
+#define vtkTaskParallelPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class vtkCollection;
+class vtkInformationIntegerKey;
+class vtkTaskParallelPipelineGraph;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkTaskParallelPipeline :
+  public vtkCompositeDataPipeline
+{
+public:
+  static vtkTaskParallelPipeline* New();
+  vtkTypeMacro(vtkTaskParallelPipeline,vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Bring the given output port up to date, running the algorithms
+  // upstream as a graph of tasks.
+  virtual int UpdateData(int outputPort);
+
+  // Description:
+  // Update all the algorithms of the collection, running everything they
+  // depend on as one graph of tasks so that algorithms shared between them
+  // execute once. Returns 1 on success, 0 if an algorithm failed.
+  static int UpdateAlgorithms(vtkCollection* algorithms);
+
+  // Description:
+  // Key set to 1 in the information of an algorithm to declare that it may
+  // execute concurrently with other algorithms. See the class description
+  // for the contract.
+  static vtkInformationIntegerKey* THREAD_SAFE();
+
+protected:
+  vtkTaskParallelPipeline();
+  ~vtkTaskParallelPipeline();
+
+  // Do not bring the inputs up to date while executing as a task, the
+  // scheduler already did.
+  virtual int ForwardUpstream(vtkInformation* request);
+  virtual int ForwardUpstream(int i, int j, vtkInformation* request);
+
+  // True while the algorithm executes as a task of the scheduler.
+  int InScheduledExecution;
+
+private:
+  vtkTaskParallelPipeline(const vtkTaskParallelPipeline&);  // Not implemented.
+  void operator=(const vtkTaskParallelPipeline&);  // Not implemented.
+
+  friend class vtkTaskParallelPipelineGraph;
+};
+
+#endif
@@ -0,0 +1,695 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTemporalPrefetcher.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkTemporalPrefetcher.h"
+
+#include "vtkCompositeDataPipeline.h"
+#include "vtkConditionVariable.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <vector>
+
+vtkStandardNewMacro(vtkTemporalPrefetcher);
+
+//----------------------------------------------------------------------------
+// The executive of vtkTemporalPrefetcher. The passes hold the upstream lock
+// so that they do not run while the background thread executes the
+// pipeline upstream, and REQUEST_DATA is not forwarded upstream: the
+// algorithm fetches its input itself.
+class vtkTemporalPrefetcherExecutive : public vtkCompositeDataPipeline
+{
+public:
+  static vtkTemporalPrefetcherExecutive* New();
+  vtkTypeMacro(vtkTemporalPrefetcherExecutive,vtkCompositeDataPipeline);
+
+  virtual int ProcessRequest(vtkInformation* request,
+                             vtkInformationVector** inInfoVec,
+                             vtkInformationVector* outInfoVec)
+  {
+    vtkTemporalPrefetcher* prefetcher = this->GetPrefetcher();
+    if (!prefetcher)
+      {
+      return this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+      }
+    prefetcher->UpstreamLock->Lock();
+    int result =
+      this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+    prefetcher->UpstreamLock->Unlock();
+    return result;
+  }
+
+  virtual int ComputePipelineMTime(vtkInformation* request,
+                                   vtkInformationVector** inInfoVec,
+                                   vtkInformationVector* outInfoVec,
+                                   int requestFromOutputPort,
+                                   unsigned long* mtime)
+  {
+    vtkTemporalPrefetcher* prefetcher = this->GetPrefetcher();
+    if (!prefetcher)
+      {
+      return this->Superclass::ComputePipelineMTime(
+        request, inInfoVec, outInfoVec, requestFromOutputPort, mtime);
+      }
+    prefetcher->UpstreamLock->Lock();
+    int result = this->Superclass::ComputePipelineMTime(
+      request, inInfoVec, outInfoVec, requestFromOutputPort, mtime);
+    prefetcher->UpstreamLock->Unlock();
+    return result;
+  }
+
+protected:
+  vtkTemporalPrefetcherExecutive() {}
+  ~vtkTemporalPrefetcherExecutive() {}
+
+  virtual int ForwardUpstream(vtkInformation* request)
+  {
+    if (this->GetPrefetcher() && request->Has(REQUEST_DATA()))
+      {
+      return 1;
+      }
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  virtual int ForwardUpstream(int i, int j, vtkInformation* request)
+  {
+    if (this->GetPrefetcher() && request->Has(REQUEST_DATA()))
+      {
+      return 1;
+      }
+    return this->Superclass::ForwardUpstream(i, j, request);
+  }
+
+  vtkTemporalPrefetcher* GetPrefetcher()
+  {
+    return vtkTemporalPrefetcher::SafeDownCast(this->Algorithm);
+  }
+
+private:
+  vtkTemporalPrefetcherExecutive(const vtkTemporalPrefetcherExecutive&);  // Not implemented.
+  void operator=(const vtkTemporalPrefetcherExecutive&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkTemporalPrefetcherExecutive);
+
+//----------------------------------------------------------------------------
+class vtkTemporalPrefetcherInternals
+{
+public:
+  struct Entry
+  {
+    vtkSmartPointer<vtkDataObject> Data;
+    // Pipeline MTime upstream when the time step was fetched.
+    unsigned long PipelineMTime;
+    // Last request of the time step, for the least recently used eviction.
+    unsigned long LastUse;
+  };
+  typedef std::map<double, Entry> BufferType;
+
+  vtkTemporalPrefetcherInternals()
+    : Stride(1), LastIndex(-1), UseCount(0), ProducerPort(0),
+      Prefetching(false), StopThread(false)
+  {
+  }
+
+  // Add a time step to the buffer, evicting the least recently used
+  // entries that are neither current nor predicted.
+  void Insert(double time, vtkDataObject* data, unsigned long pipelineMTime,
+              int bufferSize)
+  {
+    Entry& entry = this->Buffer[time];
+    entry.Data = data;
+    entry.PipelineMTime = pipelineMTime;
+    entry.LastUse = this->UseCount;
+    while (static_cast<int>(this->Buffer.size()) > bufferSize)
+      {
+      BufferType::iterator victim = this->Buffer.end();
+      for (BufferType::iterator it = this->Buffer.begin();
+           it != this->Buffer.end(); ++it)
+        {
+        if (it->first != time &&
+            std::find(this->Wanted.begin(), this->Wanted.end(), it->first) ==
+            this->Wanted.end() &&
+            (victim == this->Buffer.end() ||
+             it->second.LastUse < victim->second.LastUse))
+          {
+          victim = it;
+          }
+        }
+      if (victim == this->Buffer.end())
+        {
+        // Only wanted time steps: drop the one just added.
+        this->Buffer.erase(time);
+        return;
+        }
+      this->Buffer.erase(victim);
+      }
+  }
+
+  // Time steps of the input, from REQUEST_INFORMATION.
+  std::vector<double> TimeSteps;
+  // Move between the last two requested time steps, in indices.
+  int Stride;
+  int LastIndex;
+
+  // The following are protected by BufferLock.
+  BufferType Buffer;
+  unsigned long UseCount;
+  // Current and predicted time steps.
+  std::vector<double> Wanted;
+  // Time steps to prefetch, in order.
+  std::deque<double> Scheduled;
+  // The output port the scheduled time steps are fetched from, referenced
+  // only while some are scheduled.
+  vtkSmartPointer<vtkAlgorithm> Producer;
+  int ProducerPort;
+  bool Prefetching;
+  bool StopThread;
+};
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkTemporalPrefetcherThreadStart(void* arg)
+{
+  vtkTemporalPrefetcher* self = static_cast<vtkTemporalPrefetcher*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData);
+  self->WorkerThread();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+vtkTemporalPrefetcher::vtkTemporalPrefetcher()
+{
+  this->NumberOfPrefetchedTimeSteps = 2;
+  this->BufferSize = 4;
+  this->Loop = 0;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->UpstreamLock = vtkMutexLock::New();
+  this->BufferLock = vtkMutexLock::New();
+  this->BufferCondition = vtkConditionVariable::New();
+  this->Threader = vtkMultiThreader::New();
+  this->ThreadId = -1;
+  this->Internals = new vtkTemporalPrefetcherInternals;
+  this->SetNumberOfInputPorts(1);
+  this->SetNumberOfOutputPorts(1);
+}
+
+//----------------------------------------------------------------------------
+vtkTemporalPrefetcher::~vtkTemporalPrefetcher()
+{
+  this->StopWorkerThread();
+  delete this->Internals;
+  this->Threader->Delete();
+  this->BufferCondition->Delete();
+  this->BufferLock->Delete();
+  this->UpstreamLock->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfPrefetchedTimeSteps: "
+     << this->NumberOfPrefetchedTimeSteps << "\n";
+  os << indent << "BufferSize: " << this->BufferSize << "\n";
+  os << indent << "Loop: " << this->Loop << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
+}
+
+//----------------------------------------------------------------------------
+vtkExecutive* vtkTemporalPrefetcher::CreateDefaultExecutive()
+{
+  return vtkTemporalPrefetcherExecutive::New();
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalPrefetcher::FillInputPortInformation(int,
+                                                    vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataObject");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalPrefetcher::FillOutputPortInformation(int,
+                                                     vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataObject");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::SetExecutive(vtkExecutive* executive)
+{
+  // Without an executive, the prefetcher never ran and has no worker.
+  if (this->HasExecutive() && executive != this->GetExecutive())
+    {
+    this->StopWorkerThread();
+    }
+  this->Superclass::SetExecutive(executive);
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::SetInputConnection(int port,
+                                               vtkAlgorithmOutput* input)
+{
+  if (this->GetNumberOfInputConnections(port) != 1 ||
+      this->GetInputConnection(port, 0) != input)
+    {
+    this->StopWorkerThread();
+    }
+  this->Superclass::SetInputConnection(port, input);
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::AddInputConnection(int port,
+                                               vtkAlgorithmOutput* input)
+{
+  this->StopWorkerThread();
+  this->Superclass::AddInputConnection(port, input);
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::RemoveInputConnection(int port,
+                                                  vtkAlgorithmOutput* input)
+{
+  this->StopWorkerThread();
+  this->Superclass::RemoveInputConnection(port, input);
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::RemoveInputConnection(int port, int idx)
+{
+  this->StopWorkerThread();
+  this->Superclass::RemoveInputConnection(port, idx);
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::SetNthInputConnection(int port, int index,
+                                                  vtkAlgorithmOutput* input)
+{
+  this->StopWorkerThread();
+  this->Superclass::SetNthInputConnection(port, index, input);
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::StopWorkerThread()
+{
+  if (this->ThreadId < 0)
+    {
+    return;
+    }
+  // The producer is released after the lock.
+  vtkSmartPointer<vtkAlgorithm> producer;
+  this->BufferLock->Lock();
+  this->Internals->Scheduled.clear();
+  producer = this->Internals->Producer;
+  this->Internals->Producer = 0;
+  this->Internals->StopThread = true;
+  this->BufferCondition->Broadcast();
+  this->BufferLock->Unlock();
+
+  // Waits for the time step being prefetched, if any.
+  this->Threader->TerminateThread(this->ThreadId);
+  this->ThreadId = -1;
+  this->Internals->StopThread = false;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalPrefetcher::ProcessRequest(vtkInformation* request,
+                                          vtkInformationVector** inputVector,
+                                          vtkInformationVector* outputVector)
+{
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
+    {
+    return this->RequestDataObject(request, inputVector, outputVector);
+    }
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_INFORMATION()))
+    {
+    return this->RequestInformation(request, inputVector, outputVector);
+    }
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+    {
+    return this->RequestData(request, inputVector, outputVector);
+    }
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalPrefetcher::RequestDataObject(vtkInformation*,
+                                             vtkInformationVector** inputVector,
+                                             vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkDataObject* input = inInfo ? inInfo->Get(vtkDataObject::DATA_OBJECT()) : 0;
+  if (!input)
+    {
+    return 0;
+    }
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!output || !output->IsA(input->GetClassName()))
+    {
+    vtkDataObject* newOutput = input->NewInstance();
+    outInfo->Set(vtkDataObject::DATA_OBJECT(), newOutput);
+    newOutput->Delete();
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalPrefetcher::RequestInformation(vtkInformation*,
+                                              vtkInformationVector** inputVector,
+                                              vtkInformationVector*)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  std::vector<double>& timeSteps = this->Internals->TimeSteps;
+  timeSteps.clear();
+  if (inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+    {
+    timeSteps.resize(
+      inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()));
+    if (!timeSteps.empty())
+      {
+      inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS(),
+                  &timeSteps[0]);
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalPrefetcher::RequestData(vtkInformation*,
+                                       vtkInformationVector**,
+                                       vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  vtkTemporalPrefetcherInternals* internals = this->Internals;
+
+  // The executive holds the upstream lock: nothing executes upstream.
+  int port;
+  vtkAlgorithm* producer = this->GetInputAlgorithm(0, 0, port);
+
+  unsigned long pipelineMTime;
+  if (!outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+    {
+    // Nothing to predict.
+    vtkDataObject* data =
+      this->FetchTimeStep(producer, port, 0, 0.0, pipelineMTime);
+    if (!data)
+      {
+      return 0;
+      }
+    output->ShallowCopy(data);
+    data->Delete();
+    return 1;
+    }
+  double time =
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+
+  vtkDemandDrivenPipeline* producerExecutive = producer ?
+    vtkDemandDrivenPipeline::SafeDownCast(producer->GetExecutive()) : 0;
+  unsigned long currentMTime = 0;
+  if (producerExecutive)
+    {
+    producerExecutive->UpdatePipelineMTime();
+    currentMTime = producerExecutive->GetPipelineMTime();
+    }
+
+  vtkSmartPointer<vtkDataObject> data;
+  this->BufferLock->Lock();
+  vtkTemporalPrefetcherInternals::BufferType::iterator it =
+    internals->Buffer.begin();
+  while (it != internals->Buffer.end())
+    {
+    if (it->second.PipelineMTime != currentMTime)
+      {
+      internals->Buffer.erase(it++);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+  it = internals->Buffer.find(time);
+  if (it != internals->Buffer.end())
+    {
+    data = it->second.Data;
+    it->second.LastUse = ++internals->UseCount;
+    }
+  this->BufferLock->Unlock();
+
+  if (data)
+    {
+    ++this->NumberOfHits;
+    }
+  else
+    {
+    ++this->NumberOfMisses;
+    data.TakeReference(
+      this->FetchTimeStep(producer, port, 1, time, pipelineMTime));
+    if (!data)
+      {
+      return 0;
+      }
+    this->BufferLock->Lock();
+    ++internals->UseCount;
+    internals->Insert(time, data, pipelineMTime, this->BufferSize);
+    this->BufferLock->Unlock();
+    }
+
+  output->ShallowCopy(data);
+  output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+
+  this->SchedulePrefetches(time, producer, port);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkTemporalPrefetcher::FetchTimeStep(
+  vtkAlgorithm* producer, int port, int hasTime, double time,
+  unsigned long& pipelineMTime)
+{
+  vtkStreamingDemandDrivenPipeline* executive = producer ?
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(producer->GetExecutive()) :
+    0;
+  if (!executive)
+    {
+    vtkErrorMacro("The input must be produced by an algorithm with a "
+                  "streaming demand driven executive.");
+    return 0;
+    }
+
+  vtkInformation* info = producer->GetOutputInformation(port);
+  if (hasTime)
+    {
+    vtkStreamingDemandDrivenPipeline::SetUpdateTimeStep(info, time);
+    }
+  else
+    {
+    info->Remove(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    }
+  if (!executive->Update(port))
+    {
+    return 0;
+    }
+  pipelineMTime = executive->GetPipelineMTime();
+
+  vtkDataObject* output = info->Get(vtkDataObject::DATA_OBJECT());
+  if (!output)
+    {
+    return 0;
+    }
+  vtkDataObject* data = output->NewInstance();
+  data->ShallowCopy(output);
+  return data;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::SchedulePrefetches(double time,
+                                               vtkAlgorithm* producer,
+                                               int port)
+{
+  vtkTemporalPrefetcherInternals* internals = this->Internals;
+  const std::vector<double>& timeSteps = internals->TimeSteps;
+  int numberOfTimeSteps = static_cast<int>(timeSteps.size());
+  if (numberOfTimeSteps == 0)
+    {
+    return;
+    }
+
+  // Index of the requested time step, or of the time step before it.
+  int index = static_cast<int>(
+    std::upper_bound(timeSteps.begin(), timeSteps.end(), time) -
+    timeSteps.begin()) - 1;
+  index = index < 0 ? 0 : index;
+  if (internals->LastIndex >= 0 && index != internals->LastIndex)
+    {
+    int stride = index - internals->LastIndex;
+    // Going from the end to the beginning is going forward.
+    if (this->Loop && 2 * (stride < 0 ? -stride : stride) > numberOfTimeSteps)
+      {
+      stride += stride > 0 ? -numberOfTimeSteps : numberOfTimeSteps;
+      }
+    internals->Stride = stride;
+    }
+  internals->LastIndex = index;
+
+  std::vector<double> predicted;
+  int count = std::min(this->NumberOfPrefetchedTimeSteps, this->BufferSize - 1);
+  for (int i = 1; i <= count; ++i)
+    {
+    int next = index + i * internals->Stride;
+    if (this->Loop)
+      {
+      next = ((next % numberOfTimeSteps) + numberOfTimeSteps) %
+        numberOfTimeSteps;
+      }
+    else if (next < 0 || next >= numberOfTimeSteps)
+      {
+      break;
+      }
+    if (timeSteps[next] != time &&
+        std::find(predicted.begin(), predicted.end(), timeSteps[next]) ==
+        predicted.end())
+      {
+      predicted.push_back(timeSteps[next]);
+      }
+    }
+
+  // Other consumers of the output of the producer would see it change
+  // under them, and could update the producer while the background thread
+  // does: prefetch only when the prefetcher is the only consumer.
+  if (producer && vtkExecutive::CONSUMERS()->Length(
+        producer->GetOutputInformation(port)) > 1)
+    {
+    predicted.clear();
+    }
+
+  this->BufferLock->Lock();
+  internals->Wanted = predicted;
+  internals->Wanted.push_back(time);
+  internals->Scheduled.clear();
+  for (size_t i = 0; i < predicted.size(); ++i)
+    {
+    if (internals->Buffer.find(predicted[i]) == internals->Buffer.end())
+      {
+      internals->Scheduled.push_back(predicted[i]);
+      }
+    }
+  internals->Producer = internals->Scheduled.empty() ? 0 : producer;
+  internals->ProducerPort = port;
+  if (!internals->Scheduled.empty() && this->ThreadId < 0)
+    {
+    this->ThreadId =
+      this->Threader->SpawnThread(vtkTemporalPrefetcherThreadStart, this);
+    }
+  this->BufferCondition->Broadcast();
+  this->BufferLock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::WorkerThread()
+{
+  vtkTemporalPrefetcherInternals* internals = this->Internals;
+  this->BufferLock->Lock();
+  while (true)
+    {
+    while (!internals->StopThread && internals->Scheduled.empty())
+      {
+      this->BufferCondition->Wait(this->BufferLock);
+      }
+    if (internals->StopThread)
+      {
+      break;
+      }
+    double time = internals->Scheduled.front();
+    internals->Scheduled.pop_front();
+    // Keep the producer referenced during the fetch, even if the pipeline
+    // releases it meanwhile.
+    vtkSmartPointer<vtkAlgorithm> producer = internals->Producer;
+    int port = internals->ProducerPort;
+    if (internals->Scheduled.empty())
+      {
+      internals->Producer = 0;
+      }
+    internals->Prefetching = true;
+    this->BufferLock->Unlock();
+
+    this->UpstreamLock->Lock();
+    unsigned long pipelineMTime;
+    vtkDataObject* data =
+      this->FetchTimeStep(producer, port, 1, time, pipelineMTime);
+    this->BufferLock->Lock();
+    if (data)
+      {
+      internals->Insert(time, data, pipelineMTime, this->BufferSize);
+      data->Delete();
+      }
+    internals->Prefetching = false;
+    this->BufferCondition->Broadcast();
+    this->BufferLock->Unlock();
+    this->UpstreamLock->Unlock();
+
+    // Release the producer without holding the locks.
+    producer = 0;
+    this->BufferLock->Lock();
+    }
+  this->BufferLock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::WaitForPrefetches()
+{
+  this->BufferLock->Lock();
+  while (!this->Internals->Scheduled.empty() || this->Internals->Prefetching)
+    {
+    this->BufferCondition->Wait(this->BufferLock);
+    }
+  this->BufferLock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalPrefetcher::CancelPrefetches()
+{
+  // The producer is released after the lock.
+  vtkSmartPointer<vtkAlgorithm> producer;
+  this->BufferLock->Lock();
+  this->Internals->Scheduled.clear();
+  producer = this->Internals->Producer;
+  this->Internals->Producer = 0;
+  while (this->Internals->Prefetching)
+    {
+    this->BufferCondition->Wait(this->BufferLock);
+    }
+  this->BufferLock->Unlock();
+}
@@ -0,0 +1,201 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTemporalPrefetcher.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkTemporalPrefetcher - Execute the pipeline upstream ahead of
+// time, for the time steps about to be requested.
+// .SECTION Description
+// vtkTemporalPrefetcher passes its input through for the requested time
+// step, like vtkTemporalDataSetCache, but also predicts the time steps
+// requested next and has a background thread execute the pipeline upstream
+// for them. When an animation then requests the next time step, it is
+// usually already in the buffer and the update costs neither reading nor
+// filtering.
+//
+// The prediction follows the last move between two requested time steps
+// (index in TIME_STEPS), so forward and backward playback, with any
+// stride, are prefetched. With Loop on, predictions wrap around the ends of
+// the time steps, and a jump from the last time step to the first is
+// considered a step forward. The NumberOfPrefetchedTimeSteps predicted
+// time steps are prefetched in order. The buffer holds at most BufferSize
+// time steps, the least recently used being evicted first, but never the
+// current or predicted ones. Buffered time steps are dropped when the
+// pipeline upstream is modified.
+//
+// The background thread and the updates requested from downstream never
+// execute the pipeline upstream at the same time: an update waits for the
+// time step being prefetched, if any. The thread does not execute anything
+// while the application modifies the pipeline upstream though; call
+// CancelPrefetches() before doing so. Changing the input connection or the
+// executive stops the thread, which is started again for the next
+// prefetches. The thread holds a reference to the algorithm producing the
+// input while it executes the pipeline upstream, and never goes through
+// the executive of the prefetcher, so that the pipeline may be released
+// meanwhile. The algorithms upstream execute on the background thread, and
+// so do their events.
+//
+// Nothing is prefetched while the output of the algorithm producing the
+// input has other consumers than the prefetcher, since they would see that
+// output change, and could update the producer at the same time as the
+// background thread. Connect other consumers to the output of the
+// prefetcher instead, or call CancelPrefetches() before connecting them.
+//
+// vtkTemporalPrefetcher uses its own executive; setting another one
+// disables the protection of the pipeline upstream.
+//
+// .SECTION See Also
+// vtkTemporalDataSetCache vtkOutputCachePipeline
+
+#ifndef vtkTemporalPrefetcher_h
+#define vtkTemporalPrefetcher_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkAlgorithm.h"
+
+class vtkConditionVariable;
+class vtkDataObject;
+class vtkMultiThreader;
+class vtkMutexLock;
+class vtkTemporalPrefetcherInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkTemporalPrefetcher :
+  public vtkAlgorithm
+{
+public:
+  static vtkTemporalPrefetcher* New();
+  vtkTypeMacro(vtkTemporalPrefetcher,vtkAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Number of time steps prefetched after each requested one. Defaults
+  // to 2. At most BufferSize - 1 are prefetched.
+  vtkSetClampMacro(NumberOfPrefetchedTimeSteps, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPrefetchedTimeSteps, int);
+
+  // Description:
+  // Maximum number of time steps kept in the buffer. Defaults to 4.
+  vtkSetClampMacro(BufferSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(BufferSize, int);
+
+  // Description:
+  // Whether playback loops: predictions then wrap around the ends of the
+  // time steps. Off by default.
+  vtkSetMacro(Loop, int);
+  vtkGetMacro(Loop, int);
+  vtkBooleanMacro(Loop, int);
+
+  // Description:
+  // Block until all the scheduled time steps have been prefetched.
+  void WaitForPrefetches();
+
+  // Description:
+  // Cancel the scheduled time steps and wait for the one being prefetched,
+  // if any. Call before modifying the pipeline upstream.
+  void CancelPrefetches();
+
+  // Description:
+  // Number of requested time steps found in the buffer, and executed on
+  // request, since construction or ResetStatistics().
+  vtkGetMacro(NumberOfHits, vtkIdType);
+  vtkGetMacro(NumberOfMisses, vtkIdType);
+  void ResetStatistics();
+
+  // Description:
+  // The loop of the background thread. Internal, do not call.
+  void WorkerThread();
+
+  // Description:
+  // Stop the background thread before changing the input connection.
+  virtual void SetInputConnection(int port, vtkAlgorithmOutput* input);
+  virtual void SetInputConnection(vtkAlgorithmOutput* input)
+    { this->Superclass::SetInputConnection(input); }
+  virtual void AddInputConnection(int port, vtkAlgorithmOutput* input);
+  virtual void AddInputConnection(vtkAlgorithmOutput* input)
+    { this->Superclass::AddInputConnection(input); }
+  virtual void RemoveInputConnection(int port, vtkAlgorithmOutput* input);
+  virtual void RemoveInputConnection(int port, int idx);
+
+  // Description:
+  // Stop the background thread before changing the executive.
+  virtual void SetExecutive(vtkExecutive* executive);
+
+  // Description:
+  // See vtkAlgorithm for details.
+  virtual int ProcessRequest(vtkInformation* request,
+                             vtkInformationVector** inputVector,
+                             vtkInformationVector* outputVector);
+
+protected:
+  vtkTemporalPrefetcher();
+  ~vtkTemporalPrefetcher();
+
+  virtual vtkExecutive* CreateDefaultExecutive();
+  virtual int FillInputPortInformation(int port, vtkInformation* info);
+  virtual int FillOutputPortInformation(int port, vtkInformation* info);
+
+  virtual int RequestDataObject(vtkInformation*,
+                                vtkInformationVector** inputVector,
+                                vtkInformationVector* outputVector);
+  virtual int RequestInformation(vtkInformation*,
+                                 vtkInformationVector** inputVector,
+                                 vtkInformationVector* outputVector);
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector);
+
+  virtual void SetNthInputConnection(int port, int index,
+                                     vtkAlgorithmOutput* input);
+
+  // Execute the pipeline upstream of the given output port of producer for
+  // the given time step, or for no time step if hasTime is 0, and return a
+  // shallow copy of its output along with its pipeline MTime. UpstreamLock
+  // must be held.
+  vtkDataObject* FetchTimeStep(vtkAlgorithm* producer, int port,
+                               int hasTime, double time,
+                               unsigned long& pipelineMTime);
+
+  // Predict the next time steps after the one requested and schedule them
+  // for prefetching from the given output port of producer.
+  void SchedulePrefetches(double time, vtkAlgorithm* producer, int port);
+
+  // Cancel the scheduled time steps and join the background thread, if
+  // started. Must not be called from the background thread.
+  void StopWorkerThread();
+
+  int NumberOfPrefetchedTimeSteps;
+  int BufferSize;
+  int Loop;
+  vtkIdType NumberOfHits;
+  vtkIdType NumberOfMisses;
+
+  // Held while the pipeline upstream executes, and during the passes of
+  // the executive.
+  vtkMutexLock* UpstreamLock;
+
+  // Protect the buffer and the scheduled time steps.
+  vtkMutexLock* BufferLock;
+  vtkConditionVariable* BufferCondition;
+
+  vtkMultiThreader* Threader;
+  int ThreadId;
+
+  vtkTemporalPrefetcherInternals* Internals;
+
+private:
+  vtkTemporalPrefetcher(const vtkTemporalPrefetcher&);  // Not implemented.
+  void operator=(const vtkTemporalPrefetcher&);  // Not implemented.
+
+  friend class vtkTemporalPrefetcherExecutive;
+};
+
+#endif
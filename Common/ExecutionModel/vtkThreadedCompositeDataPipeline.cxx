@@ -35,6 +35,7 @@
 #include "vtkSmartPointer.h"
 #include "vtkObjectFactory.h"
 #include "vtkDebugLeaks.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkImageData.h"
 
 #include "vtkSMPThreadLocal.h"
@@ -308,7 +309,17 @@ int vtkThreadedCompositeDataPipeline::CallAlgorithm(vtkInformation* request, int
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
   // Invoke the request on the algorithm.
+  vtkPipelineProfiler* profiler = vtkExecutive::GetProfiler();
+  double start[2];
+  if(profiler)
+    {
+    profiler->StartPass(start);
+    }
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
+  if(profiler)
+    {
+    profiler->EndPass(start, this->Algorithm, request, outInfo);
+    }
 
   // If the algorithm failed report it now.
   if(!result)
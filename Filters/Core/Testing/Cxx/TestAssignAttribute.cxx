@@ -30,6 +30,13 @@
 #define VTK_CREATE(type, name) \
   vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
+// The output arrays are copies of the input arrays sharing their memory.
+static bool SharesMemory(vtkDataArray *output, vtkDataArray *input)
+{
+  return output && output != input &&
+    output->GetReadVoidPointer(0) == input->GetReadVoidPointer(0);
+}
+
 int TestAssignAttribute(int, char *[])
 {
   int errors = 0;
@@ -76,7 +83,8 @@ int TestAssignAttribute(int, char *[])
   assign->Assign("scalars", vtkDataSetAttributes::SCALARS, vtkAssignAttribute::VERTEX_DATA);
   assign->Update();
   vtkGraph *output = vtkGraph::SafeDownCast(assign->GetOutput());
-  if (output->GetVertexData()->GetScalars() != scalars.GetPointer())
+  if (!SharesMemory(output->GetVertexData()->GetScalars(),
+                    scalars.GetPointer()))
     {
     cerr << "Vertex scalars not set properly" << endl;
     ++errors;
@@ -84,7 +92,8 @@ int TestAssignAttribute(int, char *[])
   assign->Assign("scalars", vtkDataSetAttributes::SCALARS, vtkAssignAttribute::EDGE_DATA);
   assign->Update();
   output = vtkGraph::SafeDownCast(assign->GetOutput());
-  if (output->GetEdgeData()->GetScalars() != scalars.GetPointer())
+  if (!SharesMemory(output->GetEdgeData()->GetScalars(),
+                    scalars.GetPointer()))
     {
     cerr << "Edge scalars not set properly" << endl;
     ++errors;
@@ -94,7 +103,8 @@ int TestAssignAttribute(int, char *[])
   assign->Assign("scalars", vtkDataSetAttributes::SCALARS, vtkAssignAttribute::POINT_DATA);
   assign->Update();
   vtkPolyData *outputPoly = vtkPolyData::SafeDownCast(assign->GetOutput());
-  if (outputPoly->GetPointData()->GetScalars() != scalars.GetPointer())
+  if (!SharesMemory(outputPoly->GetPointData()->GetScalars(),
+                    scalars.GetPointer()))
     {
     cerr << "Point scalars not set properly" << endl;
     ++errors;
@@ -102,7 +112,8 @@ int TestAssignAttribute(int, char *[])
   assign->Assign("scalars", vtkDataSetAttributes::SCALARS, vtkAssignAttribute::CELL_DATA);
   assign->Update();
   outputPoly = vtkPolyData::SafeDownCast(assign->GetOutput());
-  if (outputPoly->GetCellData()->GetScalars() != scalars.GetPointer())
+  if (!SharesMemory(outputPoly->GetCellData()->GetScalars(),
+                    scalars.GetPointer()))
     {
     cerr << "Cell scalars not set properly" << endl;
     ++errors;
@@ -112,7 +123,8 @@ int TestAssignAttribute(int, char *[])
     vtkDataSetAttributes::SCALARS, vtkAssignAttribute::POINT_DATA);
   assign->Update();
   outputPoly = vtkPolyData::SafeDownCast(assign->GetOutput());
-  if (outputPoly->GetPointData()->GetTensors() != tensors.GetPointer())
+  if (!SharesMemory(outputPoly->GetPointData()->GetTensors(),
+                    tensors.GetPointer()))
     {
     cerr << "Point scalar not set when name is empty" << endl;
     ++errors;
@@ -121,10 +133,11 @@ int TestAssignAttribute(int, char *[])
     vtkDataSetAttributes::SCALARS, vtkAssignAttribute::CELL_DATA);
   assign->Update();
   outputPoly = vtkPolyData::SafeDownCast(assign->GetOutput());
-  if (outputPoly->GetCellData()->GetTensors() != tensors.GetPointer())
+  if (!SharesMemory(outputPoly->GetCellData()->GetTensors(),
+                    tensors.GetPointer()))
     {
     cerr << "Cell scalar not set when name is empty" << endl;
     ++errors;
     }
-  return 0;
+  return errors;
 }
@@ -0,0 +1,351 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataNormalsThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test verifies that vtkPolyDataNormals, which computes the normals
+// and splits the points on feature edges in parallel, splits each point
+// once per region of polygons between feature edges and gives the split
+// points the normals of their polygons on piecewise planar surfaces. The
+// split points must hold the data of the input points they come from, in
+// several arrays copied by several threads at once. The output must be the
+// same with the Sequential and ThreadPool back-ends.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkVariant.h"
+
+#include <cstring>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// The number of cells along each side of the folded sheet.
+static const int RESOLUTION = 40;
+
+//------------------------------------------------------------------------------
+// A unit cube made of quads, one of them inward.
+static void MakeBox(vtkPolyData* box)
+{
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 8; ++i)
+    {
+    points->InsertNextPoint(i & 1, (i >> 1) & 1, (i >> 2) & 1);
+    }
+  const vtkIdType quads[6][4] = { {0,2,3,1}, {4,5,7,6}, {0,1,5,4},
+                                  {2,6,7,3}, {0,4,6,2}, {1,5,7,3} };
+  vtkNew<vtkCellArray> polys;
+  for (int i = 0; i < 6; ++i)
+    {
+    polys->InsertNextCell(4, quads[i]);
+    }
+  box->SetPoints(points.GetPointer());
+  box->SetPolys(polys.GetPointer());
+}
+
+//------------------------------------------------------------------------------
+// A sheet of triangles folded along x = 0, with a triangle strip along one
+// of its sides, and a point not used by any polygon.
+static void MakeSheet(vtkPolyData* sheet)
+{
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= RESOLUTION; ++j)
+    {
+    for (int i = 0; i <= RESOLUTION; ++i)
+      {
+      double x = i - 0.5 * RESOLUTION;
+      points->InsertNextPoint(x, j, fabs(x));
+      }
+    }
+  points->InsertNextPoint(0.0, -1.0, 0.0);
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < RESOLUTION - 1; ++j)
+    {
+    for (int i = 0; i < RESOLUTION; ++i)
+      {
+      vtkIdType p = i + j * (RESOLUTION + 1);
+      vtkIdType tri1[3] = { p, p + 1, p + RESOLUTION + 2 };
+      vtkIdType tri2[3] = { p, p + RESOLUTION + 2, p + RESOLUTION + 1 };
+      polys->InsertNextCell(3, tri1);
+      polys->InsertNextCell(3, tri2);
+      }
+    }
+  vtkNew<vtkCellArray> strips;
+  vtkIdType strip[2 * RESOLUTION + 2];
+  for (int i = 0; i <= RESOLUTION; ++i)
+    {
+    strip[2 * i] = i + (RESOLUTION - 1) * (RESOLUTION + 1);
+    strip[2 * i + 1] = i + RESOLUTION * (RESOLUTION + 1);
+    }
+  strips->InsertNextCell(2 * RESOLUTION + 2, strip);
+  sheet->SetPoints(points.GetPointer());
+  sheet->SetPolys(polys.GetPointer());
+  sheet->SetStrips(strips.GetPointer());
+
+  // Point data of several types, whose values depend on the point.
+  vtkIdType numPts = sheet->GetNumberOfPoints();
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfTuples(numPts);
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("Doubles");
+  doubles->SetNumberOfComponents(3);
+  doubles->SetNumberOfTuples(numPts);
+  vtkNew<vtkUnsignedCharArray> chars;
+  chars->SetName("Chars");
+  chars->SetNumberOfComponents(2);
+  chars->SetNumberOfTuples(numPts);
+  vtkNew<vtkStringArray> strings;
+  strings->SetName("Strings");
+  strings->SetNumberOfTuples(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+    pointIds->SetValue(ptId, ptId);
+    doubles->SetTuple3(ptId, ptId, 0.5 * ptId, -1.0 * ptId);
+    chars->SetTuple2(ptId, ptId % 256, (ptId + 1) % 256);
+    strings->SetValue(ptId, vtkVariant(ptId).ToString());
+    }
+  sheet->GetPointData()->AddArray(pointIds.GetPointer());
+  sheet->GetPointData()->AddArray(doubles.GetPointer());
+  sheet->GetPointData()->AddArray(chars.GetPointer());
+  sheet->GetPointData()->AddArray(strings.GetPointer());
+}
+
+//------------------------------------------------------------------------------
+// Checks that every output point has the coordinates and the data of the
+// input point it comes from.
+static bool CheckPointData(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkPointData* inPD = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  vtkIdTypeArray* pointIds =
+    vtkIdTypeArray::SafeDownCast(outPD->GetArray("PointIds"));
+  if (!pointIds)
+    {
+    cerr << "Missing point data." << endl;
+    return false;
+    }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+    {
+    vtkIdType inputId = pointIds->GetValue(ptId);
+    double x[3], y[3];
+    output->GetPoint(ptId, x);
+    input->GetPoint(inputId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+      cerr << "Wrong point " << ptId << "." << endl;
+      return false;
+      }
+    for (int i = 0; i < inPD->GetNumberOfArrays(); ++i)
+      {
+      vtkAbstractArray* inArray = inPD->GetAbstractArray(i);
+      vtkAbstractArray* outArray = outPD->GetAbstractArray(inArray->GetName());
+      int numComps = inArray->GetNumberOfComponents();
+      for (int c = 0; outArray && c < numComps; ++c)
+        {
+        if (outArray->GetVariantValue(ptId * numComps + c) !=
+            inArray->GetVariantValue(inputId * numComps + c))
+          {
+          outArray = NULL;
+          }
+        }
+      if (!outArray)
+        {
+        cerr << "Wrong " << inArray->GetName() << " at point " << ptId
+             << "." << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Checks that the normal of every point is the one of every polygon using
+// it.
+static bool CheckPlanarNormals(vtkPolyData* output)
+{
+  vtkDataArray* pointNormals = output->GetPointData()->GetNormals();
+  vtkDataArray* cellNormals = output->GetCellData()->GetNormals();
+  if (!pointNormals || !cellNormals ||
+      pointNormals->GetNumberOfTuples() != output->GetNumberOfPoints() ||
+      cellNormals->GetNumberOfTuples() != output->GetNumberOfPolys())
+    {
+    cerr << "Missing normals." << endl;
+    return false;
+    }
+  vtkCellArray* polys = output->GetPolys();
+  vtkIdType npts, *pts;
+  vtkIdType cellId = 0;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); ++cellId)
+    {
+    double cellNormal[3];
+    cellNormals->GetTuple(cellId, cellNormal);
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      double pointNormal[3];
+      pointNormals->GetTuple(pts[i], pointNormal);
+      if (vtkMath::Distance2BetweenPoints(pointNormal, cellNormal) > 1e-10)
+        {
+        cerr << "Point " << pts[i] << " of cell " << cellId
+             << " has the normal (" << pointNormal[0] << ", "
+             << pointNormal[1] << ", " << pointNormal[2]
+             << ") instead of (" << cellNormal[0] << ", " << cellNormal[1]
+             << ", " << cellNormal[2] << ")." << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static vtkSmartPointer<vtkPolyData> ComputeNormals(vtkPolyData* input,
+                                                   bool splitting)
+{
+  vtkNew<vtkPolyDataNormals> normals;
+  normals->SetInputData(input);
+  normals->SetSplitting(splitting);
+  normals->ComputeCellNormalsOn();
+  normals->Update();
+  return normals->GetOutput();
+}
+
+//------------------------------------------------------------------------------
+static bool TestNormals(vtkPolyData* box, vtkPolyData* sheet)
+{
+  bool ok = true;
+
+  // Every corner of the box is split in three, with the normals of the
+  // faces pointing outward.
+  vtkSmartPointer<vtkPolyData> output = ComputeNormals(box, true);
+  if (output->GetNumberOfPoints() != 24 || !CheckPlanarNormals(output))
+    {
+    cerr << "Wrong split box: " << output->GetNumberOfPoints()
+         << " points." << endl;
+    ok = false;
+    }
+  output = ComputeNormals(box, false);
+  vtkDataArray* normals = output->GetPointData()->GetNormals();
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+    {
+    double x[3], n[3];
+    output->GetPoint(ptId, x);
+    normals->GetTuple(ptId, n);
+    for (int i = 0; i < 3; ++i)
+      {
+      if (fabs(n[i] - (x[i] - 0.5) * 2.0 / sqrt(3.0)) > 1e-6)
+        {
+        cerr << "Wrong normal at the corner " << ptId << " of the box."
+             << endl;
+        ok = false;
+        break;
+        }
+      }
+    }
+
+  // The points along the fold of the sheet are split in two.
+  output = ComputeNormals(sheet, true);
+  if (output->GetNumberOfPoints() !=
+      sheet->GetNumberOfPoints() + RESOLUTION + 1 ||
+      !CheckPlanarNormals(output) || !CheckPointData(sheet, output))
+    {
+    cerr << "Wrong split sheet: " << output->GetNumberOfPoints()
+         << " points." << endl;
+    ok = false;
+    }
+
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+static bool SameOutput(vtkPolyData* output1, vtkPolyData* output2)
+{
+  vtkIdType numPts = output1->GetNumberOfPoints();
+  vtkIdType size = output1->GetPolys()->GetNumberOfConnectivityEntries();
+  vtkFloatArray* normals1 =
+    vtkFloatArray::SafeDownCast(output1->GetPointData()->GetNormals());
+  vtkFloatArray* normals2 =
+    vtkFloatArray::SafeDownCast(output2->GetPointData()->GetNormals());
+  if (output2->GetNumberOfPoints() != numPts ||
+      output2->GetPolys()->GetNumberOfConnectivityEntries() != size ||
+      !normals1 || !normals2 ||
+      memcmp(output1->GetPolys()->GetPointer(),
+             output2->GetPolys()->GetPointer(), size * sizeof(vtkIdType)) ||
+      memcmp(normals1->GetPointer(0), normals2->GetPointer(0),
+             3 * numPts * sizeof(float)))
+    {
+    return false;
+    }
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+    double x1[3], x2[3];
+    output1->GetPoint(ptId, x1);
+    output2->GetPoint(ptId, x2);
+    if (x1[0] != x2[0] || x1[1] != x2[1] || x1[2] != x2[2])
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int TestPolyDataNormalsThreads(int, char*[])
+{
+  vtkNew<vtkPolyData> box;
+  MakeBox(box.GetPointer());
+  vtkNew<vtkPolyData> sheet;
+  MakeSheet(sheet.GetPointer());
+
+  int status = TEST_SUCCESS;
+  vtkSmartPointer<vtkPolyData> outputs[2];
+  const char* backends[2] = { "Sequential", "ThreadPool" };
+  for (int i = 0; i < 2; ++i)
+    {
+    if (!vtkSMPTools::SetBackend(backends[i]))
+      {
+      continue;
+      }
+    vtkSMPTools::Initialize(8);
+    if (!TestNormals(box.GetPointer(), sheet.GetPointer()))
+      {
+      cerr << "Wrong normals with the " << backends[i] << " back-end."
+           << endl;
+      status = TEST_FAILURE;
+      }
+    outputs[i] = ComputeNormals(sheet.GetPointer(), true);
+    }
+
+  if (outputs[0] && outputs[1] &&
+      !SameOutput(outputs[0].GetPointer(), outputs[1].GetPointer()))
+    {
+    cerr << "The back-ends give different outputs." << endl;
+    status = TEST_FAILURE;
+    }
+
+  return status;
+}
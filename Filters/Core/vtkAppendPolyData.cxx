@@ -25,6 +25,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTaskParallelPipeline.h"
 #include "vtkTrivialProducer.h"
 
 vtkStandardNewMacro(vtkAppendPolyData);
@@ -35,6 +36,9 @@ vtkAppendPolyData::vtkAppendPolyData()
   this->ParallelStreaming = 0;
   this->UserManagedInputs = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+
+  // Only reads its inputs.
+  this->GetInformation()->Set(vtkTaskParallelPipeline::THREAD_SAFE(), 1);
 }
 
 //----------------------------------------------------------------------------
@@ -711,7 +715,7 @@ void vtkAppendPolyData::AppendData(vtkDataArray *dest, vtkDataArray *src,
 {
   switch (src->GetDataType())
     {
-    vtkDataArrayIteratorMacro(src,
+    vtkDataArrayReadIteratorMacro(src,
       AppendData(dest, src, offset, vtkDABegin, vtkDAEnd));
     }
 }
@@ -271,8 +271,13 @@ int vtkAssignAttribute::RequestData(
     // This has to be here because it initialized all field datas.
     dsOutput->CopyStructure( dsInput );
 
+    // The arrays passed share the memory of the input arrays until either
+    // is modified.
+    dsOutput->GetPointData()->CopyOnWriteOn();
+    dsOutput->GetCellData()->CopyOnWriteOn();
     if ( dsOutput->GetFieldData() && dsInput->GetFieldData() )
       {
+      dsOutput->GetFieldData()->CopyOnWriteOn();
       dsOutput->GetFieldData()->PassData( dsInput->GetFieldData() );
       }
     dsOutput->GetPointData()->PassData( dsInput->GetPointData() );
@@ -294,6 +299,12 @@ int vtkAssignAttribute::RequestData(
     {
     vtkGraph *graphInput = vtkGraph::SafeDownCast(input);
     vtkGraph *graphOutput = vtkGraph::SafeDownCast(output);
+    graphOutput->GetVertexData()->CopyOnWriteOn();
+    graphOutput->GetEdgeData()->CopyOnWriteOn();
+    if ( graphOutput->GetFieldData() )
+      {
+      graphOutput->GetFieldData()->CopyOnWriteOn();
+      }
     graphOutput->ShallowCopy( graphInput );
     switch (this->AttributeLocationAssignment)
       {
@@ -0,0 +1,354 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCellSubsetHelper.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellSubsetHelper.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataSetAttributesCopier.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Gives access to the point ids of the cells of any dataset, reading the
+// connectivity of unstructured grids directly.
+class vtkCellSubsetFunctor
+{
+public:
+  vtkDataSet* Input;
+  const unsigned char* KeepCells;
+  const vtkIdType* Connectivity;
+  const vtkIdType* Locations;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  vtkCellSubsetFunctor(vtkDataSet* input, const unsigned char* keepCells)
+    : Input(input), KeepCells(keepCells), Connectivity(0), Locations(0)
+  {
+    vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+    if (grid && grid->GetCells() && grid->GetCellLocationsArray())
+      {
+      this->Connectivity = grid->GetCells()->GetPointer();
+      this->Locations = grid->GetCellLocationsArray()->GetPointer(0);
+      }
+  }
+
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts, const vtkIdType*& pts,
+                     vtkIdList* cellPoints)
+  {
+    if (this->Connectivity)
+      {
+      const vtkIdType* cell = this->Connectivity + this->Locations[cellId];
+      npts = cell[0];
+      pts = cell + 1;
+      }
+    else
+      {
+      this->Input->GetCellPoints(cellId, cellPoints);
+      npts = cellPoints->GetNumberOfIds();
+      pts = cellPoints->GetPointer(0);
+      }
+  }
+};
+
+// First pass: the size in the output connectivity of each kept cell, zero
+// for the others, and the points used by the kept cells.
+class vtkCellSubsetCounter : public vtkCellSubsetFunctor
+{
+public:
+  vtkIdType* CellSizes;
+  unsigned char* UsedPoints;
+
+  vtkCellSubsetCounter(vtkDataSet* input, const unsigned char* keepCells,
+                       vtkIdType* cellSizes, unsigned char* usedPoints)
+    : vtkCellSubsetFunctor(input, keepCells), CellSizes(cellSizes),
+      UsedPoints(usedPoints)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* cellPoints = this->CellPoints.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      if (!this->KeepCells[cellId])
+        {
+        this->CellSizes[cellId] = 0;
+        continue;
+        }
+      vtkIdType npts;
+      const vtkIdType* pts;
+      this->GetCellPoints(cellId, npts, pts, cellPoints);
+      this->CellSizes[cellId] = npts + 1;
+      // Several threads may mark the same point, always with the same value.
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        this->UsedPoints[pts[i]] = 1;
+        }
+      }
+  }
+};
+
+// Second pass over the cells: each kept cell is written at the output id and
+// location given by the scans of the first pass.
+class vtkCellSubsetCellCopier : public vtkCellSubsetFunctor
+{
+public:
+  const vtkIdType* CellMap;
+  const vtkIdType* CellLocations;
+  const vtkIdType* PointMap;
+  const unsigned char* InputTypes;
+  unsigned char* Types;
+  vtkIdType* OutputLocations;
+  vtkIdType* OutputConnectivity;
+  vtkIdType* OriginalCellIds;
+  vtkDataSetAttributesCopier* CellDataCopier;
+
+  vtkCellSubsetCellCopier(vtkDataSet* input, const unsigned char* keepCells)
+    : vtkCellSubsetFunctor(input, keepCells), CellMap(0), CellLocations(0),
+      PointMap(0), InputTypes(0), Types(0), OutputLocations(0),
+      OutputConnectivity(0), OriginalCellIds(0), CellDataCopier(0)
+  {
+    vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+    if (this->Connectivity && grid->GetCellTypesArray())
+      {
+      this->InputTypes = grid->GetCellTypesArray()->GetPointer(0);
+      }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* cellPoints = this->CellPoints.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      if (!this->KeepCells[cellId])
+        {
+        continue;
+        }
+      vtkIdType newCellId = this->CellMap[cellId];
+      vtkIdType loc = this->CellLocations[cellId];
+      vtkIdType npts;
+      const vtkIdType* pts;
+      this->GetCellPoints(cellId, npts, pts, cellPoints);
+
+      this->Types[newCellId] = this->InputTypes ?
+        this->InputTypes[cellId] :
+        static_cast<unsigned char>(this->Input->GetCellType(cellId));
+      this->OutputLocations[newCellId] = loc;
+      vtkIdType* newPts = this->OutputConnectivity + loc;
+      *newPts++ = npts;
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        newPts[i] = this->PointMap[pts[i]];
+        }
+      this->CellDataCopier->Copy(cellId, newCellId);
+      if (this->OriginalCellIds)
+        {
+        this->OriginalCellIds[newCellId] = cellId;
+        }
+      }
+  }
+};
+
+// Second pass over the points.
+class vtkCellSubsetPointCopier
+{
+public:
+  vtkDataSet* Input;
+  const unsigned char* UsedPoints;
+  const vtkIdType* PointMap;
+  vtkPoints* NewPoints;
+  vtkDataSetAttributesCopier* PointDataCopier;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      if (this->UsedPoints[ptId])
+        {
+        vtkIdType newId = this->PointMap[ptId];
+        this->Input->GetPoint(ptId, x);
+        this->NewPoints->SetPoint(newId, x);
+        this->PointDataCopier->Copy(ptId, newId);
+        }
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+void vtkCellSubsetHelper::ExtractCells(vtkDataSet* input,
+                                       const unsigned char* keepCells,
+                                       const unsigned char* keepPoints,
+                                       vtkPoints* newPoints,
+                                       vtkUnstructuredGrid* output,
+                                       vtkIdTypeArray* originalCellIds)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* inPD = input->GetPointData();
+  vtkCellData* inCD = input->GetCellData();
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* outCD = output->GetCellData();
+
+  if (numCells > 0)
+    {
+    // Some datasets, such as vtkPolyData, build their cells on the first
+    // query, which must not happen concurrently.
+    input->GetCellType(0);
+    }
+
+  // First pass, then the output ids of the cells and points and the
+  // locations of the cells in the output connectivity.
+  std::vector<vtkIdType> cellLocations(numCells);
+  std::vector<unsigned char> usedPoints(numPts, 0);
+  if (keepPoints && numPts > 0)
+    {
+    std::copy(keepPoints, keepPoints + numPts, usedPoints.begin());
+    }
+  vtkCellSubsetCounter counter(input, keepCells,
+                               numCells ? &cellLocations[0] : 0,
+                               numPts ? &usedPoints[0] : 0);
+  vtkSMPTools::For(0, numCells, counter);
+
+  vtkIdType numNewCells = 0;
+  vtkIdType connectivitySize = 0;
+  std::vector<vtkIdType> cellMap(numCells);
+  if (numCells > 0)
+    {
+    vtkIdType lastSize = cellLocations[numCells - 1];
+    vtkSMPTools::ExclusiveScan(keepCells, keepCells + numCells,
+                               cellMap.begin(), static_cast<vtkIdType>(0));
+    vtkSMPTools::ExclusiveScan(cellLocations.begin(), cellLocations.end(),
+                               cellLocations.begin(),
+                               static_cast<vtkIdType>(0));
+    numNewCells = cellMap[numCells - 1] + keepCells[numCells - 1];
+    connectivitySize = cellLocations[numCells - 1] + lastSize;
+    }
+  vtkIdType numNewPts = 0;
+  std::vector<vtkIdType> pointMap(numPts);
+  if (numPts > 0)
+    {
+    vtkSMPTools::ExclusiveScan(usedPoints.begin(), usedPoints.end(),
+                               pointMap.begin(), static_cast<vtkIdType>(0));
+    numNewPts = pointMap[numPts - 1] + usedPoints[numPts - 1];
+    }
+
+  // Second pass, writing in place in the preallocated output.
+  newPoints->SetNumberOfPoints(numNewPts);
+  outPD->CopyAllocate(inPD, numNewPts);
+  outPD->SetNumberOfTuples(numNewPts);
+  vtkDataSetAttributesCopier pointDataCopier;
+  pointDataCopier.Initialize(inPD, outPD);
+  vtkCellSubsetPointCopier pointCopier;
+  pointCopier.Input = input;
+  pointCopier.UsedPoints = numPts ? &usedPoints[0] : 0;
+  pointCopier.PointMap = numPts ? &pointMap[0] : 0;
+  pointCopier.NewPoints = newPoints;
+  pointCopier.PointDataCopier = &pointDataCopier;
+  vtkSMPTools::For(0, numPts, pointCopier);
+
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numNewCells);
+  vtkNew<vtkIdTypeArray> locations;
+  locations->SetNumberOfValues(numNewCells);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(connectivitySize);
+  outCD->CopyAllocate(inCD, numNewCells);
+  outCD->SetNumberOfTuples(numNewCells);
+  if (originalCellIds)
+    {
+    originalCellIds->SetNumberOfComponents(1);
+    originalCellIds->SetNumberOfTuples(numNewCells);
+    }
+  vtkDataSetAttributesCopier cellDataCopier;
+  cellDataCopier.Initialize(inCD, outCD);
+  vtkCellSubsetCellCopier cellCopier(input, keepCells);
+  cellCopier.CellMap = numCells ? &cellMap[0] : 0;
+  cellCopier.CellLocations = numCells ? &cellLocations[0] : 0;
+  cellCopier.PointMap = numPts ? &pointMap[0] : 0;
+  cellCopier.Types = types->GetPointer(0);
+  cellCopier.OutputLocations = locations->GetPointer(0);
+  cellCopier.OutputConnectivity = connectivity->GetPointer(0);
+  cellCopier.OriginalCellIds =
+    originalCellIds ? originalCellIds->GetPointer(0) : 0;
+  cellCopier.CellDataCopier = &cellDataCopier;
+  vtkSMPTools::For(0, numCells, cellCopier);
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetCells(numNewCells, connectivity.GetPointer());
+  output->SetPoints(newPoints);
+
+  // The face streams of the polyhedra, if any, are renumbered serially.
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  vtkIdTypeArray* faces = grid ? grid->GetFaces() : 0;
+  vtkIdTypeArray* faceLocations = grid ? grid->GetFaceLocations() : 0;
+  if (faces && faceLocations)
+    {
+    vtkNew<vtkIdTypeArray> newFaces;
+    vtkNew<vtkIdTypeArray> newFaceLocations;
+    newFaceLocations->SetNumberOfValues(numNewCells);
+    bool hasPolyhedra = false;
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+      if (!keepCells[cellId])
+        {
+        continue;
+        }
+      vtkIdType newCellId = cellMap[cellId];
+      vtkIdType loc = faceLocations->GetValue(cellId);
+      if (loc < 0 || types->GetValue(newCellId) != VTK_POLYHEDRON)
+        {
+        newFaceLocations->SetValue(newCellId, -1);
+        continue;
+        }
+      hasPolyhedra = true;
+      newFaceLocations->SetValue(newCellId, newFaces->GetNumberOfTuples());
+      const vtkIdType* face = faces->GetPointer(loc);
+      vtkIdType numFaces = *face++;
+      newFaces->InsertNextValue(numFaces);
+      for (vtkIdType i = 0; i < numFaces; ++i)
+        {
+        vtkIdType npts = *face++;
+        newFaces->InsertNextValue(npts);
+        for (vtkIdType j = 0; j < npts; ++j)
+          {
+          newFaces->InsertNextValue(pointMap[*face++]);
+          }
+        }
+      }
+    if (hasPolyhedra)
+      {
+      output->SetCells(types.GetPointer(), locations.GetPointer(),
+                       cells.GetPointer(), newFaceLocations.GetPointer(),
+                       newFaces.GetPointer());
+      return;
+      }
+    }
+
+  output->SetCells(types.GetPointer(), locations.GetPointer(),
+                   cells.GetPointer());
+}
@@ -0,0 +1,72 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCellSubsetHelper.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkCellSubsetHelper - Utility class copying a subset of cells in parallel
+// .SECTION Description
+// vtkCellSubsetHelper is a utility class for the filters that extract some
+// of the cells of a vtkDataSet into a vtkUnstructuredGrid, such as
+// vtkThreshold, vtkExtractCells and vtkExtractGeometry. The filter marks
+// the cells to keep, then ExtractCells() builds the output in two parallel
+// passes with vtkSMPTools. The first pass sizes the connectivity of the
+// marked cells and marks the points they use. Exclusive scans of these
+// counts give the output id of every cell and point and the place of every
+// cell in the output connectivity, so that the second pass writes the
+// points, the cells and their attributes in place, without reallocation.
+//
+// The output lists the cells, and the points, in the order of their ids in
+// the input whatever the number of threads. The point and cell data are
+// copied into the preallocated output arrays with a
+// vtkDataSetAttributesCopier, since vtkDataSetAttributes::CopyData() cannot
+// be called from several threads at once. The face streams of polyhedra
+// are copied serially.
+// .SECTION See Also
+// vtkThreshold vtkExtractCells vtkExtractGeometry vtkSMPTools
+// vtkDataSetAttributesCopier
+
+#ifndef vtkCellSubsetHelper_h
+#define vtkCellSubsetHelper_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkType.h" // For vtkIdType
+
+class vtkDataSet;
+class vtkIdTypeArray;
+class vtkPoints;
+class vtkUnstructuredGrid;
+
+class VTKFILTERSCORE_EXPORT vtkCellSubsetHelper
+{
+public:
+  // Description:
+  // Set output to the cells of input whose entry in keepCells is 1, with
+  // the points they use and, if keepPoints is not NULL, the points whose
+  // entry in keepPoints is 1. The entries of both arrays, one per cell and
+  // one per point of input, must be 0 or 1. The output points are stored
+  // in newPoints, whose data type is left to the caller, and the point and
+  // cell data are copied according to the copy flags of the attributes of
+  // output. If originalCellIds is not NULL, it is filled with the input id
+  // of each output cell.
+  static void ExtractCells(vtkDataSet* input, const unsigned char* keepCells,
+                           const unsigned char* keepPoints,
+                           vtkPoints* newPoints, vtkUnstructuredGrid* output,
+                           vtkIdTypeArray* originalCellIds = 0);
+
+private:
+  vtkCellSubsetHelper();  // Not implemented.
+  vtkCellSubsetHelper(const vtkCellSubsetHelper&);  // Not implemented.
+  void operator=(const vtkCellSubsetHelper&);  // Not implemented.
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkCellSubsetHelper.h
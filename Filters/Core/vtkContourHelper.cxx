@@ -81,6 +81,11 @@ void vtkContourHelper::Contour(vtkCell* cell, double value, vtkDataArray *cellSc
     {
     this->PolyBuilder.Reset();
 
+    // As in vtkCell::Contour(), the cell data of the polys follows that of
+    // the verts and lines.
+    vtkIdType offset =
+      this->Verts->GetNumberOfCells() + this->Lines->GetNumberOfCells();
+
     vtkIdType cellSize;
     vtkIdType* cellVerts;
     while(this->Tris->GetNextCell(cellSize,cellVerts))
@@ -91,7 +96,8 @@ void vtkContourHelper::Contour(vtkCell* cell, double value, vtkDataArray *cellSc
         }
       else //for whatever reason, the cell contouring is already outputing polys
         {
-        vtkIdType outCellId = this->Polys->InsertNextCell(cellSize, cellVerts);
+        vtkIdType outCellId =
+          offset + this->Polys->InsertNextCell(cellSize, cellVerts);
         this->OutCd->CopyData(this->InCd, cellId, outCellId);
         }
       }
@@ -99,7 +105,7 @@ void vtkContourHelper::Contour(vtkCell* cell, double value, vtkDataArray *cellSc
     this->PolyBuilder.GetPolygon(this->Poly);
     if(this->Poly->GetNumberOfIds()!=0)
       {
-      vtkIdType outCellId = this->Polys->InsertNextCell(this->Poly);
+      vtkIdType outCellId = offset + this->Polys->InsertNextCell(this->Poly);
       this->OutCd->CopyData(this->InCd, cellId, outCellId);
       }
     }
@@ -22,6 +22,7 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkRangeDataArrayTemplate.h"
 
 vtkStandardNewMacro(vtkIdFilter);
 
@@ -34,6 +35,7 @@ vtkIdFilter::vtkIdFilter()
   this->FieldData = 0;
   this->IdsArrayName = NULL;
   this->SetIdsArrayName("vtkIdFilter_Ids");
+  this->ImplicitIds = 0;
 }
 
 vtkIdFilter::~vtkIdFilter()
@@ -41,6 +43,25 @@ vtkIdFilter::~vtkIdFilter()
   delete [] IdsArrayName;
 }
 
+vtkDataArray* vtkIdFilter::NewIds(vtkIdType numIds)
+{
+  if ( this->ImplicitIds )
+    {
+    vtkRangeDataArrayTemplate<vtkIdType> *ids =
+      vtkRangeDataArrayTemplate<vtkIdType>::New();
+    ids->SetNumberOfTuples(numIds);
+    return ids;
+    }
+
+  vtkIdTypeArray *ids = vtkIdTypeArray::New();
+  ids->SetNumberOfValues(numIds);
+  for (vtkIdType id=0; id < numIds; id++)
+    {
+    ids->SetValue(id, id);
+    }
+  return ids;
+}
+
 //
 // Map ids into attribute data
 //
@@ -59,9 +80,9 @@ int vtkIdFilter::RequestData(
   vtkDataSet *output = vtkDataSet::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts, numCells, id;
-  vtkIdTypeArray *ptIds;
-  vtkIdTypeArray *cellIds;
+  vtkIdType numPts, numCells;
+  vtkDataArray *ptIds;
+  vtkDataArray *cellIds;
   vtkPointData *inPD=input->GetPointData(), *outPD=output->GetPointData();
   vtkCellData *inCD=input->GetCellData(), *outCD=output->GetCellData();
 
@@ -79,13 +100,7 @@ int vtkIdFilter::RequestData(
   //
   if ( this->PointIds && numPts > 0 )
     {
-    ptIds = vtkIdTypeArray::New();
-    ptIds->SetNumberOfValues(numPts);
-
-    for (id=0; id < numPts; id++)
-      {
-      ptIds->SetValue(id, id);
-      }
+    ptIds = this->NewIds(numPts);
 
     ptIds->SetName(this->IdsArrayName);
     if ( ! this->FieldData )
@@ -106,13 +121,7 @@ int vtkIdFilter::RequestData(
   //
   if ( this->CellIds && numCells > 0 )
     {
-    cellIds = vtkIdTypeArray::New();
-    cellIds->SetNumberOfValues(numCells);
-
-    for (id=0; id < numCells; id++)
-      {
-      cellIds->SetValue(id, id);
-      }
+    cellIds = this->NewIds(numCells);
 
     cellIds->SetName(this->IdsArrayName);
     if ( ! this->FieldData )
@@ -144,4 +153,5 @@ void vtkIdFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Field Data: "   << (this->FieldData ? "On\n" : "Off\n");
   os << indent << "IdsArrayName: " << (this->IdsArrayName ? this->IdsArrayName
        : "(none)") << "\n";
+  os << indent << "Implicit Ids: " << (this->ImplicitIds ? "On\n" : "Off\n");
 }
@@ -30,6 +30,8 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkDataSetAlgorithm.h"
 
+class vtkDataArray;
+
 class VTKFILTERSCORE_EXPORT vtkIdFilter : public vtkDataSetAlgorithm
 {
 public:
@@ -67,6 +69,16 @@ public:
   vtkSetStringMacro(IdsArrayName);
   vtkGetStringMacro(IdsArrayName);
 
+  // Description:
+  // Set/Get the flag which controls whether the ids are generated as
+  // implicit arrays (vtkRangeDataArrayTemplate), computing each id on the
+  // fly instead of storing it. The implicit arrays are not vtkIdTypeArray
+  // and report the data type of vtkIdType's underlying C++ type; code
+  // downstream must use the generic vtkDataArray API. Default is off.
+  vtkSetMacro(ImplicitIds,int);
+  vtkGetMacro(ImplicitIds,int);
+  vtkBooleanMacro(ImplicitIds,int);
+
 protected:
   vtkIdFilter();
   ~vtkIdFilter();
@@ -77,6 +89,11 @@ protected:
   int CellIds;
   int FieldData;
   char *IdsArrayName;
+  int ImplicitIds;
+
+  // Description:
+  // Create the ids 0 to numIds - 1.
+  vtkDataArray* NewIds(vtkIdType numIds);
 
 private:
   vtkIdFilter(const vtkIdFilter&);  // Not implemented.
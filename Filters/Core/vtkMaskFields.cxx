@@ -466,9 +466,13 @@ int vtkMaskFields::RequestData(
       }
   }
 
-  // Pass all.
+  // Pass all. The arrays passed share the memory of the input arrays until
+  // either is modified.
+  output->GetPointData()->CopyOnWriteOn();
+  output->GetCellData()->CopyOnWriteOn();
   if ( output->GetFieldData() && input->GetFieldData() )
     {
+    output->GetFieldData()->CopyOnWriteOn();
     output->GetFieldData()->PassData( input->GetFieldData() );
     }
   output->GetPointData()->PassData( input->GetPointData() );
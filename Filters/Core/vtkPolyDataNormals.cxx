@@ -16,6 +16,8 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCompactCellArray.h"
+#include "vtkDataSetAttributesCopier.h"
 #include "vtkFloatArray.h"
 #include "vtkMath.h"
 #include "vtkInformation.h"
@@ -26,6 +28,13 @@
 #include "vtkPolygon.h"
 #include "vtkTriangleStrip.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
+
+#include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkPolyDataNormals);
 
@@ -49,6 +58,345 @@ vtkPolyDataNormals::vtkPolyDataNormals()
 #define VTK_CELL_NOT_VISITED     0
 #define VTK_CELL_VISITED         1
 
+namespace
+{
+// Computes the normal of each polygon.
+class vtkPolygonNormalsFunctor
+{
+public:
+  vtkPolyData* Mesh;
+  vtkPoints* Points;
+  float* Normals;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType npts, *pts;
+    double n[3];
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Mesh->GetCellPoints(cellId, npts, pts);
+      vtkPolygon::ComputeNormal(this->Points, npts, pts, n);
+      float* normal = this->Normals + 3 * cellId;
+      normal[0] = static_cast<float>(n[0]);
+      normal[1] = static_cast<float>(n[1]);
+      normal[2] = static_cast<float>(n[2]);
+      }
+  }
+};
+
+// Labels the regions of the polygons around each point that are connected
+// across edges other than feature edges. For N regions, N-1 copies of the
+// point are needed: the region of each polygon is stored at the place of
+// the point in its connectivity, and the number of copies per point.
+class vtkFeatureRegionsFunctor
+{
+public:
+  vtkCompactCellArray* OldPolys;
+  vtkStaticCellLinks* Links;
+  vtkPolyData* NewMesh;
+  const float* PolyNormals;
+  double CosAngle;
+  const vtkIdType* Connectivity;
+  int* CornerRegions;
+  vtkIdType* NumberOfCopies;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > Cells;
+  vtkSMPThreadLocal<std::vector<int> > Regions;
+
+  void Initialize()
+  {
+    this->CellIds.Local()->Allocate(VTK_CELL_SIZE);
+    this->PointIds.Local()->Allocate(VTK_CELL_SIZE);
+  }
+
+  void Reduce()
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* cellIds = this->CellIds.Local();
+    vtkIdList* pointIds = this->PointIds.Local();
+    std::vector<vtkIdType>& cells = this->Cells.Local();
+    std::vector<int>& regions = this->Regions.Local();
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      this->NumberOfCopies[ptId] = 0;
+      vtkIdType ncells = this->Links->GetNcells(ptId);
+      const vtkIdType *pointCells = this->Links->GetCells(ptId);
+      if (ncells <= 1)
+        {
+        continue; // point does not need to be further disconnected
+        }
+
+      // The links list the cells using the point in increasing order, once
+      // per use of the point.
+      cells.assign(pointCells, pointCells + ncells);
+      cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+      regions.assign(cells.size(), -1);
+
+      // Grow a region from each unvisited cell in both directions around
+      // the point, as long as the edge neighbor is unvisited and the angle
+      // between the normals is below the feature angle.
+      int numRegions = 0;
+      for (size_t j = 0; j < cells.size(); ++j)
+        {
+        if (regions[j] >= 0)
+          {
+          continue;
+          }
+        regions[j] = numRegions;
+        vtkIdType neiPt[2];
+        this->GetEdgePoints(cells[j], ptId, pointIds, neiPt);
+        for (int i = 0; i < 2; ++i)
+          {
+          vtkIdType cellId = cells[j];
+          vtkIdType nei = neiPt[i];
+          while (cellId >= 0)
+            {
+            this->Links->GetCellEdgeNeighbors(cellId, ptId, nei, cellIds);
+            vtkIdType neiCellId = cellIds->GetNumberOfIds() == 1 ?
+              cellIds->GetId(0) : -1;
+            int* neiRegion = neiCellId < 0 ? NULL : &regions[
+              std::lower_bound(cells.begin(), cells.end(), neiCellId) -
+              cells.begin()];
+            if (neiRegion && *neiRegion < 0 &&
+                this->Dot(cellId, neiCellId) > this->CosAngle)
+              {
+              *neiRegion = numRegions;
+              cellId = neiCellId;
+              vtkIdType edgePts[2];
+              this->GetEdgePoints(cellId, ptId, pointIds, edgePts);
+              nei = (edgePts[0] != nei ? edgePts[0] : edgePts[1]);
+              }
+            else
+              {
+              cellId = -1; // separated by edge angle, previous visit,
+                           // boundary, or non-manifold edge
+              }
+            }
+          }
+        ++numRegions;
+        }
+
+      if (numRegions <= 1)
+        {
+        continue; // a single region, no splitting ever required
+        }
+      this->NumberOfCopies[ptId] = numRegions - 1;
+      for (size_t j = 0; j < cells.size(); ++j)
+        {
+        if (regions[j] > 0)
+          {
+          vtkIdType npts, *pts;
+          this->NewMesh->GetCellPoints(cells[j], npts, pts);
+          for (vtkIdType i = 0; i < npts; ++i)
+            {
+            if (pts[i] == ptId)
+              {
+              this->CornerRegions[pts + i - this->Connectivity] = regions[j];
+              }
+            }
+          }
+        }
+      }
+  }
+
+  // The other points of the two edges of the cell using ptId. pointIds is
+  // the list of the calling thread that the point ids may be copied to.
+  void GetEdgePoints(vtkIdType cellId, vtkIdType ptId, vtkIdList* pointIds,
+                     vtkIdType neiPt[2])
+  {
+    vtkIdType npts;
+    const vtkIdType *pts;
+    this->OldPolys->GetCellAtId(cellId, npts, pts, pointIds);
+    vtkIdType spot;
+    for (spot = 0; spot < npts; ++spot)
+      {
+      if (pts[spot] == ptId)
+        {
+        break;
+        }
+      }
+    if (spot == 0)
+      {
+      neiPt[0] = pts[spot + 1];
+      neiPt[1] = pts[npts - 1];
+      }
+    else if (spot == npts - 1)
+      {
+      neiPt[0] = pts[spot - 1];
+      neiPt[1] = pts[0];
+      }
+    else
+      {
+      neiPt[0] = pts[spot + 1];
+      neiPt[1] = pts[spot - 1];
+      }
+  }
+
+  double Dot(vtkIdType cellId, vtkIdType neiCellId)
+  {
+    const float* n1 = this->PolyNormals + 3 * cellId;
+    const float* n2 = this->PolyNormals + 3 * neiCellId;
+    return static_cast<double>(n1[0]) * n2[0] +
+      static_cast<double>(n1[1]) * n2[1] + static_cast<double>(n1[2]) * n2[2];
+  }
+};
+
+// Replaces the points of the polygons outside the first region around them
+// with their copies, numbered after the input points in the order of the
+// points they copy.
+class vtkSplitPointsFunctor
+{
+public:
+  vtkPolyData* NewMesh;
+  vtkIdType* Connectivity;
+  const int* CornerRegions;
+  const vtkIdType* CopyOffsets;
+  vtkIdType NumberOfPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType npts, *pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->NewMesh->GetCellPoints(cellId, npts, pts);
+      const int* regions = this->CornerRegions + (pts - this->Connectivity);
+      for (vtkIdType i = 0; i < npts; ++i)
+        {
+        if (regions[i] > 0)
+          {
+          pts[i] = this->NumberOfPoints + this->CopyOffsets[pts[i]] +
+            regions[i] - 1;
+          }
+        }
+      }
+  }
+};
+
+// Maps the output points, including the copies, to the input points.
+class vtkSplitMapFunctor
+{
+public:
+  const vtkIdType* NumberOfCopies;
+  const vtkIdType* CopyOffsets;
+  vtkIdType NumberOfPoints;
+  vtkIdType* Map;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      this->Map[ptId] = ptId;
+      vtkIdType* copies =
+        this->Map + this->NumberOfPoints + this->CopyOffsets[ptId];
+      for (vtkIdType i = 0; i < this->NumberOfCopies[ptId]; ++i)
+        {
+        copies[i] = ptId;
+        }
+      }
+  }
+};
+
+// Copies the input points and their data to the output points.
+class vtkSplitPointsCopier
+{
+public:
+  const vtkIdType* Map;
+  vtkPoints* InPoints;
+  vtkPoints* NewPoints;
+  vtkDataSetAttributesCopier* DataCopier;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      vtkIdType oldId = this->Map[ptId];
+      this->InPoints->GetPoint(oldId, x);
+      this->NewPoints->SetPoint(ptId, x);
+      this->DataCopier->Copy(oldId, ptId);
+      }
+  }
+};
+
+// Sums the normals of the polygons using each input point, in the order of
+// the polygons, at the output point replacing it in each polygon, and
+// normalizes the sums. All the output points of an input point are handled
+// by the same thread.
+class vtkPointNormalsFunctor
+{
+public:
+  vtkStaticCellLinks* Links;
+  vtkPolyData* NewMesh;
+  const float* PolyNormals;
+  const vtkIdType* Map;
+  vtkIdType NumberOfPoints;
+  const vtkIdType* NumberOfCopies;
+  const vtkIdType* CopyOffsets;
+  double FlipDirection;
+  float* Normals;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      vtkIdType ncells = this->Links->GetNcells(ptId);
+      const vtkIdType *cells = this->Links->GetCells(ptId);
+      for (vtkIdType j = 0; j < ncells; ++j)
+        {
+        if (j > 0 && cells[j] == cells[j - 1])
+          {
+          continue;
+          }
+        const float* polyNormal = this->PolyNormals + 3 * cells[j];
+        vtkIdType npts, *pts;
+        this->NewMesh->GetCellPoints(cells[j], npts, pts);
+        for (vtkIdType i = 0; i < npts; ++i)
+          {
+          if (pts[i] == ptId ||
+              (pts[i] >= this->NumberOfPoints && this->Map[pts[i]] == ptId))
+            {
+            float* normal = this->Normals + 3 * pts[i];
+            for (int k = 0; k < 3; ++k)
+              {
+              normal[k] = static_cast<float>(
+                static_cast<double>(normal[k]) + polyNormal[k]);
+              }
+            }
+          }
+        }
+
+      this->Normalize(ptId);
+      if (this->NumberOfCopies)
+        {
+        vtkIdType copy = this->NumberOfPoints + this->CopyOffsets[ptId];
+        for (vtkIdType i = 0; i < this->NumberOfCopies[ptId]; ++i)
+          {
+          this->Normalize(copy + i);
+          }
+        }
+      }
+  }
+
+  void Normalize(vtkIdType ptId)
+  {
+    float* normal = this->Normals + 3 * ptId;
+    double n[3] = { normal[0], normal[1], normal[2] };
+    double length = vtkMath::Norm(n);
+    if (length != 0.0)
+      {
+      for (int k = 0; k < 3; ++k)
+        {
+        normal[k] = static_cast<float>(n[k] / length * this->FlipDirection);
+        }
+      }
+  }
+};
+}
+
 // Generate normals for polygon meshes
 int vtkPolyDataNormals::RequestData(
   vtkInformation *vtkNotUsed(request),
@@ -65,12 +413,9 @@ int vtkPolyDataNormals::RequestData(
   vtkPolyData *output = vtkPolyData::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  int j;
   vtkIdType npts = 0;
-  vtkIdType i;
   vtkIdType *pts = 0;
   vtkIdType numNewPts;
-  double polyNormal[3], vertNormal[3], length;
   double flipDirection=1.0;
   vtkIdType numPolys, numStrips;
   vtkIdType cellId;
@@ -83,7 +428,7 @@ int vtkPolyDataNormals::RequestData(
   vtkCellData *outCD;
   double n[3];
   vtkCellArray *newPolys;
-  vtkIdType ptId, oldId;
+  vtkIdType ptId;
 
   vtkDebugMacro(<<"Generating surface normals");
 
@@ -109,15 +454,15 @@ int vtkPolyDataNormals::RequestData(
   output->SetFieldData(input->GetFieldData());
 
   // Load data into cell structure.  We need two copies: one is a
-  // non-writable mesh used to perform topological queries.  The other
-  // is used to write into and modify the connectivity of the mesh.
+  // non-writable compact copy of the polygons, with the links from the
+  // points to them, used to perform topological queries from several
+  // threads.  The other is used to write into and modify the connectivity
+  // of the mesh.
   //
   inPts = input->GetPoints();
   inPolys = input->GetPolys();
   inStrips = input->GetStrips();
 
-  this->OldMesh = vtkPolyData::New();
-  this->OldMesh->SetPoints(inPts);
   if ( numStrips > 0 ) //have to decompose strips into triangles
     {
     if ( numPolys > 0 )
@@ -134,16 +479,16 @@ int vtkPolyDataNormals::RequestData(
       {
       vtkTriangleStrip::DecomposeStrip(npts, pts, polys);
       }
-    this->OldMesh->SetPolys(polys);
-    polys->Delete();
     numPolys = polys->GetNumberOfCells();//added some new triangles
     }
   else
     {
-    this->OldMesh->SetPolys(inPolys);
     polys = inPolys;
     }
-  this->OldMesh->BuildLinks();
+  this->OldPolys = vtkCompactCellArray::New();
+  this->OldPolys->ImportLegacyFormat(polys);
+  this->Links = vtkStaticCellLinks::New();
+  this->Links->BuildLinks(numPts, this->OldPolys);
   this->UpdateProgress(0.10);
 
   pd = input->GetPointData();
@@ -156,12 +501,16 @@ int vtkPolyDataNormals::RequestData(
   // create a copy because we're modifying it
   newPolys = vtkCellArray::New();
   newPolys->DeepCopy(polys);
+  if ( polys != inPolys )
+    {
+    polys->Delete();
+    }
   this->NewMesh->SetPolys(newPolys);
   this->NewMesh->BuildCells(); //builds connectivity
 
   // The visited array keeps track of which polygons have been visited.
   //
-  if ( this->Consistency || this->Splitting || this->AutoOrientNormals )
+  if ( this->Consistency || this->AutoOrientNormals )
     {
     this->Visited = new int[numPolys];
     memset(this->Visited, VTK_CELL_NOT_VISITED, numPolys*sizeof(int));
@@ -193,11 +542,10 @@ int vtkPolyDataNormals::RequestData(
     // the mesh. Report bugs/issues to cvolpe@ara.com.
     int foundLeftmostCell;
     vtkIdType leftmostCellID=-1, currentPointID, currentCellID;
-    vtkIdType *leftmostCells;
-    unsigned short nleftmostCells;
-    vtkIdType *cellPts;
-    vtkIdType nCellPts;
-    int cIdx;
+    const vtkIdType *leftmostCells;
+    vtkIdType nleftmostCells;
+    vtkIdList *cellPts = vtkIdList::New();
+    vtkIdType cIdx;
     double bestNormalAbsXComponent;
     int bestReverseFlag;
     vtkPriorityQueue *leftmostPoints = vtkPriorityQueue::New();
@@ -227,7 +575,8 @@ int vtkPolyDataNormals::RequestData(
       // at that point
       do {
         currentPointID = leftmostPoints->Pop();
-        this->OldMesh->GetPointCells(currentPointID, nleftmostCells, leftmostCells);
+        nleftmostCells = this->Links->GetNcells(currentPointID);
+        leftmostCells = this->Links->GetCells(currentPointID);
         bestNormalAbsXComponent = 0.0;
         bestReverseFlag = 0;
         for (cIdx = 0; cIdx < nleftmostCells; cIdx++)
@@ -237,8 +586,10 @@ int vtkPolyDataNormals::RequestData(
             {
             continue;
             }
-          this->OldMesh->GetCellPoints(currentCellID, nCellPts, cellPts);
-          vtkPolygon::ComputeNormal(inPts, nCellPts, cellPts, n);
+          this->OldPolys->GetCellAtId(currentCellID, cellPts);
+          vtkPolygon::ComputeNormal(inPts,
+                                    static_cast<int>(cellPts->GetNumberOfIds()),
+                                    cellPts->GetPointer(0), n);
           // Ok, see if this leftmost cell candidate is the best
           // so far
           if (fabs(n[0]) > bestNormalAbsXComponent)
@@ -272,6 +623,7 @@ int vtkPolyDataNormals::RequestData(
       } // Still some points in the queue
     this->Wave->Delete();
     this->Wave2->Delete();
+    cellPts->Delete();
     leftmostPoints->Delete();
     vtkDebugMacro(<<"Reversed ordering of " << this->NumFlips << " polygons");
     } // automatically orient normals
@@ -313,56 +665,79 @@ int vtkPolyDataNormals::RequestData(
   //
   this->PolyNormals = vtkFloatArray::New();
   this->PolyNormals->SetNumberOfComponents(3);
-  this->PolyNormals->Allocate(3*numPolys);
   this->PolyNormals->SetName("Normals");
   this->PolyNormals->SetNumberOfTuples(numPolys);
 
-  for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts);
-       cellId++ )
-    {
-    if ((cellId % 1000) == 0)
-      {
-      this->UpdateProgress (0.333 + 0.333 * (double) cellId / (double) numPolys);
-      if (this->GetAbortExecute())
-        {
-        break;
-        }
-      }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(cellId,n);
-    }
+  vtkPolygonNormalsFunctor polygonNormals;
+  polygonNormals.Mesh = this->NewMesh;
+  polygonNormals.Points = inPts;
+  polygonNormals.Normals = this->PolyNormals->GetPointer(0);
+  vtkSMPTools::For(0, numPolys, polygonNormals);
+
+  this->UpdateProgress(0.5);
 
   // Split mesh if sharp features
+  std::vector<vtkIdType> numberOfCopies;
+  std::vector<vtkIdType> copyOffsets;
+  this->Map = NULL;
   if ( this->Splitting )
     {
     //  Traverse all nodes; evaluate loops and feature edges.  If feature
     //  edges found, split mesh creating new nodes.  Update polygon
     // connectivity.
     //
-      this->CosAngle = cos( vtkMath::RadiansFromDegrees( this->FeatureAngle) );
+    this->CosAngle = cos( vtkMath::RadiansFromDegrees( this->FeatureAngle) );
+    vtkIdType *connectivity = newPolys->GetPointer();
+    std::vector<int> cornerRegions(newPolys->GetNumberOfConnectivityEntries(),
+                                   0);
+    numberOfCopies.resize(numPts);
+    copyOffsets.resize(numPts);
+
+    vtkFeatureRegionsFunctor featureRegions;
+    featureRegions.OldPolys = this->OldPolys;
+    featureRegions.Links = this->Links;
+    featureRegions.NewMesh = this->NewMesh;
+    featureRegions.PolyNormals = this->PolyNormals->GetPointer(0);
+    featureRegions.CosAngle = this->CosAngle;
+    featureRegions.Connectivity = connectivity;
+    featureRegions.CornerRegions =
+      cornerRegions.empty() ? NULL : &cornerRegions[0];
+    featureRegions.NumberOfCopies = &numberOfCopies[0];
+    vtkSMPTools::For(0, numPts, featureRegions);
+
+    //  The copies of each point follow the input points, in the order of
+    // the points they copy.
+    vtkSMPTools::ExclusiveScan(numberOfCopies.begin(), numberOfCopies.end(),
+                               copyOffsets.begin(), static_cast<vtkIdType>(0));
+    numNewPts = numPts + copyOffsets[numPts-1] + numberOfCopies[numPts-1];
+
+    vtkSplitPointsFunctor splitPoints;
+    splitPoints.NewMesh = this->NewMesh;
+    splitPoints.Connectivity = connectivity;
+    splitPoints.CornerRegions = featureRegions.CornerRegions;
+    splitPoints.CopyOffsets = &copyOffsets[0];
+    splitPoints.NumberOfPoints = numPts;
+    vtkSMPTools::For(0, numPolys, splitPoints);
+
+    vtkDebugMacro(<<"Created " << numNewPts-numPts << " new points");
+
     //  Splitting will create new points.  We have to create index array
     // to map new points into old points.
     //
     this->Map = vtkIdList::New();
-    this->Map->SetNumberOfIds(numPts);
-    for (i=0; i < numPts; i++)
-      {
-      this->Map->SetId(i,i);
-      }
-
-    for (ptId=0; ptId < numPts; ptId++)
-      {
-      this->MarkAndSplit(ptId);
-      }//for all input points
-
-    numNewPts = this->Map->GetNumberOfIds();
-
-    vtkDebugMacro(<<"Created " << numNewPts-numPts << " new points");
+    this->Map->SetNumberOfIds(numNewPts);
+    vtkSplitMapFunctor splitMap;
+    splitMap.NumberOfCopies = &numberOfCopies[0];
+    splitMap.CopyOffsets = &copyOffsets[0];
+    splitMap.NumberOfPoints = numPts;
+    splitMap.Map = this->Map->GetPointer(0);
+    vtkSMPTools::For(0, numPts, splitMap);
 
     //  Now need to map attributes of old points into new points.
     //
     outPD->CopyNormalsOff();
     outPD->CopyAllocate(pd,numNewPts);
+    outPD->SetNumberOfTuples(numNewPts);
 
     newPts = vtkPoints::New();
 
@@ -389,13 +764,14 @@ int vtkPolyDataNormals::RequestData(
       }
 
     newPts->SetNumberOfPoints(numNewPts);
-    for (ptId=0; ptId < numNewPts; ptId++)
-      {
-      oldId = this->Map->GetId(ptId);
-      newPts->SetPoint(ptId,inPts->GetPoint(oldId));
-      outPD->CopyData(pd,oldId,ptId);
-      }
-    this->Map->Delete();
+    vtkDataSetAttributesCopier dataCopier;
+    dataCopier.Initialize(pd, outPD);
+    vtkSplitPointsCopier pointsCopier;
+    pointsCopier.Map = this->Map->GetPointer(0);
+    pointsCopier.InPoints = inPts;
+    pointsCopier.NewPoints = newPts;
+    pointsCopier.DataCopier = &dataCopier;
+    vtkSMPTools::For(0, numNewPts, pointsCopier);
     } //splitting
 
   else //no splitting, so no new points
@@ -405,7 +781,7 @@ int vtkPolyDataNormals::RequestData(
     outPD->PassData(pd);
     }
 
-  if ( this->Consistency || this->Splitting )
+  if ( this->Consistency || this->AutoOrientNormals )
     {
     delete [] this->Visited;
     this->CellIds->Delete();
@@ -413,8 +789,8 @@ int vtkPolyDataNormals::RequestData(
 
   this->UpdateProgress(0.80);
 
-  //  Finally, traverse all elements, computing polygon normals and
-  //  accumulating them at the vertices.
+  //  Finally, accumulate the polygon normals at the vertices. Each input
+  //  point, and its copies, is handled by a single thread.
   //
   if ( this->FlipNormals && ! this->Consistency )
     {
@@ -425,43 +801,29 @@ int vtkPolyDataNormals::RequestData(
   newNormals->SetNumberOfComponents(3);
   newNormals->SetNumberOfTuples(numNewPts);
   newNormals->SetName("Normals");
-  n[0] = n[1] = n[2] = 0.0;
-  for (i=0; i < numNewPts; i++)
-    {
-    newNormals->SetTuple(i,n);
-    }
+  float *normals = newNormals->GetPointer(0);
+  vtkSMPTools::Fill(normals, normals + 3*numNewPts, 0.0f);
 
   if (this->ComputePointNormals)
     {
-    for (cellId=0, newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts);
-          cellId++ )
-      {
-      this->PolyNormals->GetTuple(cellId, polyNormal);
-
-      for (i=0; i < npts; i++)
-        {
-        newNormals->GetTuple(pts[i], vertNormal);
-        for (j=0; j < 3; j++)
-          {
-          n[j] = vertNormal[j] + polyNormal[j];
-          }
-        newNormals->SetTuple(pts[i],n);
-        }
-      }
+    vtkPointNormalsFunctor pointNormals;
+    pointNormals.Links = this->Links;
+    pointNormals.NewMesh = this->NewMesh;
+    pointNormals.PolyNormals = this->PolyNormals->GetPointer(0);
+    pointNormals.Map = this->Map ? this->Map->GetPointer(0) : NULL;
+    pointNormals.NumberOfPoints = numPts;
+    pointNormals.NumberOfCopies =
+      this->Map ? &numberOfCopies[0] : NULL;
+    pointNormals.CopyOffsets = this->Map ? &copyOffsets[0] : NULL;
+    pointNormals.FlipDirection = flipDirection;
+    pointNormals.Normals = normals;
+    vtkSMPTools::For(0, numPts, pointNormals);
+    }
 
-    for (i=0; i < numNewPts; i++)
-      {
-      newNormals->GetTuple(i, vertNormal);
-      length = vtkMath::Norm(vertNormal);
-      if (length != 0.0)
-        {
-        for (j=0; j < 3; j++)
-          {
-          n[j] = vertNormal[j] / length * flipDirection;
-          }
-        }
-      newNormals->SetTuple(i,n);
-      }
+  if (this->Map)
+    {
+    this->Map->Delete();
+    this->Map = NULL;
     }
 
   //  Update ourselves.  If no new nodes have been created (i.e., no
@@ -499,7 +861,8 @@ int vtkPolyDataNormals::RequestData(
   output->SetVerts(input->GetVerts());
   output->SetLines(input->GetLines());
 
-  this->OldMesh->Delete();
+  this->OldPolys->Delete();
+  this->Links->Delete();
   this->NewMesh->Delete();
 
   return 1;
@@ -530,7 +893,7 @@ void vtkPolyDataNormals::TraverseAndOrder (void)
         p1 = pts[j];
         p2 = pts[(j+1)%npts];
 
-        this->OldMesh->GetCellEdgeNeighbors(cellId, p1, p2, this->CellIds);
+        this->Links->GetCellEdgeNeighbors(cellId, p1, p2, this->CellIds);
 
         //  Check the direction of the neighbor ordering.  Should be
         //  consistent with us (i.e., if we are n1->n2,
@@ -577,167 +940,6 @@ void vtkPolyDataNormals::TraverseAndOrder (void)
   return;
 }
 
-//
-//  Mark polygons around vertex.  Create new vertex (if necessary) and
-//  replace (i.e., split mesh).
-//
-void vtkPolyDataNormals::MarkAndSplit (vtkIdType ptId)
-{
-  int i,j;
-
-  // Get the cells using this point and make sure that we have to do something
-  unsigned short ncells;
-  vtkIdType *cells;
-  this->OldMesh->GetPointCells(ptId,ncells,cells);
-  if ( ncells <= 1 )
-    {
-    return; //point does not need to be further disconnected
-    }
-
-  // Start moving around the "cycle" of points using the point. Label
-  // each point as requiring a visit. Then label each subregion of cells
-  // connected to this point that are connected (and not separated by
-  // a feature edge) with a given region number. For each N regions
-  // created, N-1 duplicate (split) points are created. The split point
-  // replaces the current point ptId in the polygons connectivity array.
-  //
-  // Start by initializing the cells as unvisited
-  for (i=0; i<ncells; i++)
-    {
-    this->Visited[cells[i]] = -1;
-    }
-
-  // Loop over all cells and mark the region that each is in.
-  //
-  vtkIdType numPts;
-  vtkIdType *pts;
-  int numRegions = 0;
-  vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
-  double thisNormal[3], neiNormal[3];
-  for (j=0; j<ncells; j++) //for all cells connected to point
-    {
-    if ( this->Visited[cells[j]] < 0 ) //for all unvisited cells
-      {
-      this->Visited[cells[j]] = numRegions;
-      //okay, mark all the cells connected to this seed cell and using ptId
-      this->OldMesh->GetCellPoints(cells[j],numPts,pts);
-
-      //find the two edges
-      for (spot=0; spot < numPts; spot++)
-        {
-        if ( pts[spot] == ptId )
-          {
-          break;
-          }
-        }
-
-      if ( spot == 0 )
-        {
-        neiPt[0] = pts[spot+1];
-        neiPt[1] = pts[numPts-1];
-        }
-      else if ( spot == (numPts-1) )
-        {
-        neiPt[0] = pts[spot-1];
-        neiPt[1] = pts[0];
-        }
-      else
-        {
-        neiPt[0] = pts[spot+1];
-        neiPt[1] = pts[spot-1];
-        }
-
-      for (i=0; i<2; i++) //for each of the two edges of the seed cell
-        {
-        cellId = cells[j];
-        nei = neiPt[i];
-        while ( cellId >= 0 ) //while we can grow this region
-          {
-          this->OldMesh->GetCellEdgeNeighbors(cellId,ptId,nei,this->CellIds);
-          if ( this->CellIds->GetNumberOfIds() == 1 &&
-               this->Visited[(neiCellId=this->CellIds->GetId(0))] < 0 )
-            {
-            this->PolyNormals->GetTuple(cellId, thisNormal);
-            this->PolyNormals->GetTuple(neiCellId, neiNormal);
-
-            if ( vtkMath::Dot(thisNormal,neiNormal) > CosAngle )
-              {
-              //visit and arrange to visit next edge neighbor
-              this->Visited[neiCellId] = numRegions;
-              cellId = neiCellId;
-              this->OldMesh->GetCellPoints(cellId,numPts,pts);
-
-              for (spot=0; spot < numPts; spot++)
-                {
-                if ( pts[spot] == ptId )
-                  {
-                  break;
-                  }
-                }
-
-              if (spot == 0)
-                {
-                nei = (pts[spot+1] != nei ? pts[spot+1] : pts[numPts-1]);
-                }
-              else if (spot == (numPts-1))
-                {
-                nei = (pts[spot-1] != nei ? pts[spot-1] : pts[0]);
-                }
-              else
-                {
-                nei = (pts[spot+1] != nei ? pts[spot+1] : pts[spot-1]);
-                }
-
-              }//if not separated by edge angle
-            else
-              {
-              cellId = -1; //separated by edge angle
-              }
-            }//if can move to edge neighbor
-          else
-            {
-            cellId = -1;//separated by previous visit, boundary, or non-manifold
-            }
-          }//while visit wave is propagating
-        }//for each of the two edges of the starting cell
-      numRegions++;
-      }//if cell is unvisited
-    }//for all cells connected to point ptId
-
-  if ( numRegions <=1 )
-    {
-    return; //a single region, no splitting ever required
-    }
-
-  // Okay, for all cells not in the first region, the ptId is
-  // replaced with a new ptId, which is a duplicate of the first
-  // point, but disconnected topologically.
-  //
-  vtkIdType lastId = this->Map->GetNumberOfIds();
-  vtkIdType replacementPoint;
-  for (j=0; j<ncells; j++)
-    {
-    if (this->Visited[cells[j]] > 0 ) //replace point if splitting needed
-      {
-      replacementPoint = lastId + this->Visited[cells[j]] - 1;
-
-      this->Map->InsertId(replacementPoint, ptId);
-
-      this->NewMesh->GetCellPoints(cells[j],numPts,pts);
-      for (i=0; i < numPts; i++)
-        {
-        if ( pts[i] == ptId )
-          {
-          pts[i] = replacementPoint; // this is very nasty! direct write!
-          break;
-          }
-        }//replace ptId with split point
-      }//if not in first regions and requiring splitting
-    }//for all cells connected to ptId
-
-  return;
-}
-
 void vtkPolyDataNormals::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
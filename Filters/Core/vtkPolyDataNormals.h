@@ -36,6 +36,18 @@
 // averaging them at shared points. When sharp edges are present, the edges
 // are split and new points generated to prevent blurry edges (due to
 // Gouraud shading).
+//
+// The polygon normals, the splitting of the points on feature edges and
+// the averaging of the normals at the points are computed in parallel with
+// vtkSMPTools. The polygons around each point are split into regions by a
+// thread independently of the other points, then the copies of the split
+// points are numbered after the input points, in the order of the points
+// they copy, so that the output does not depend on the number of threads.
+// The consistent ordering and the automatic orientation of the polygons
+// are serial traversals of the mesh. The neighborhood queries of all the
+// passes read a vtkCompactCellArray copy of the input polygons and the
+// vtkStaticCellLinks built from it, which take two flat allocations each
+// instead of the cell map and the per-point link lists of vtkPolyData.
 
 // .SECTION Caveats
 // Normals are computed only for polygons and triangle strips. Normals are
@@ -50,9 +62,11 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+class vtkCompactCellArray;
 class vtkFloatArray;
 class vtkIdList;
 class vtkPolyData;
+class vtkStaticCellLinks;
 
 class VTKFILTERSCORE_EXPORT vtkPolyDataNormals : public vtkPolyDataAlgorithm
 {
@@ -158,7 +172,8 @@ private:
   vtkIdList *Wave2;
   vtkIdList *CellIds;
   vtkIdList *Map;
-  vtkPolyData *OldMesh;
+  vtkCompactCellArray *OldPolys;
+  vtkStaticCellLinks *Links;
   vtkPolyData *NewMesh;
   int *Visited;
   vtkFloatArray *PolyNormals;
@@ -168,11 +183,6 @@ private:
   // checked and properly ordered polygons.
   void TraverseAndOrder(void);
 
-  // Check the point id give to see whether it lies on a feature
-  // edge. If so, split the point (i.e., duplicate it) to topologically
-  // separate the mesh.
-  void MarkAndSplit(vtkIdType ptId);
-
 private:
   vtkPolyDataNormals(const vtkPolyDataNormals&);  // Not implemented.
   void operator=(const vtkPolyDataNormals&);  // Not implemented.
@@ -25,6 +25,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
@@ -194,6 +195,7 @@ int vtkSmoothPolyDataFilter::RequestData(
   int iterationNumber;
   vtkIdType numSimple=0, numBEdges=0, numFixed=0, numFEdges=0;
   vtkPolyData *inMesh, *Mesh;
+  vtkStaticCellLinks *links;
   vtkPoints *inPts;
   vtkTriangleFilter *toTris=NULL;
   vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
@@ -334,7 +336,8 @@ int vtkSmoothPolyDataFilter::RequestData(
       Mesh = toTris->GetOutput();
       }
 
-    Mesh->BuildLinks(); //to do neighborhood searching
+    links = vtkStaticCellLinks::New();
+    links->BuildLinks(Mesh); //to do neighborhood searching
     polys = Mesh->GetPolys();
     this->UpdateProgress(0.375);
 
@@ -357,7 +360,7 @@ int vtkSmoothPolyDataFilter::RequestData(
           Verts[p2].edges->Allocate(16,6);
           }
 
-        Mesh->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
+        links->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
         numNei = neighbors->GetNumberOfIds();
 
         edge = VTK_SIMPLE_VERTEX;
@@ -435,6 +438,7 @@ int vtkSmoothPolyDataFilter::RequestData(
         }
       }
 
+    links->Delete();
     inMesh->Delete();
     if (toTris) {toTris->Delete();}
 
@@ -14,18 +14,22 @@
 =========================================================================*/
 #include "vtkThreshold.h"
 
-#include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkCellSubsetHelper.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkMath.h"
 
 #include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkThreshold);
 
@@ -90,6 +94,69 @@ void vtkThreshold::ThresholdBetween(double lower, double upper)
     }
 }
 
+// Marks the cells that satisfy the threshold criterion, in parallel.
+class vtkThresholdCellMarker
+{
+public:
+  vtkThreshold* Self;
+  vtkDataSet* Input;
+  vtkDataArray* Scalars;
+  int UsePointScalars;
+  unsigned char* KeepCells;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* cellPts = this->CellPoints.Local();
+    vtkThreshold* self = this->Self;
+    vtkDataArray* inScalars = this->Scalars;
+    vtkIdType ptId;
+    int i, numCellPts, keepCell;
+
+    for (vtkIdType cellId=begin; cellId < end; cellId++)
+      {
+      this->Input->GetCellPoints(cellId, cellPts);
+      numCellPts = cellPts->GetNumberOfIds();
+
+      if ( this->UsePointScalars )
+        {
+        if (self->AllScalars)
+          {
+          keepCell = 1;
+          for ( i=0; keepCell && (i < numCellPts); i++)
+            {
+            ptId = cellPts->GetId(i);
+            keepCell = self->EvaluateComponents( inScalars, ptId );
+            }
+          }
+        else
+          {
+          if(!self->UseContinuousCellRange)
+            {
+            keepCell = 0;
+            for ( i=0; (!keepCell) && (i < numCellPts); i++)
+              {
+              ptId = cellPts->GetId(i);
+              keepCell = self->EvaluateComponents( inScalars, ptId );
+              }
+            }
+          else
+            {
+            keepCell = self->EvaluateCell(inScalars, cellPts, numCellPts);
+            }
+          }
+        }
+      else //use cell scalars
+        {
+        keepCell = self->EvaluateComponents( inScalars, cellId );
+        }
+
+      // satisfied thresholding (also non-empty cell, i.e. not VTK_EMPTY_CELL)
+      this->KeepCells[cellId] = (numCellPts > 0 && keepCell) ? 1 : 0;
+      } // for all cells
+  }
+};
+
 int vtkThreshold::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
@@ -105,17 +172,10 @@ int vtkThreshold::RequestData(
   vtkUnstructuredGrid *output = vtkUnstructuredGrid::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType cellId, newCellId;
-  vtkIdList *cellPts, *pointMap;
-  vtkIdList *newCellPts;
-  vtkCell *cell;
   vtkPoints *newPoints;
-  int i, ptId, newId, numPts;
-  int numCellPts;
-  double x[3];
-  vtkPointData *pd=input->GetPointData(), *outPD=output->GetPointData();
-  vtkCellData *cd=input->GetCellData(), *outCD=output->GetCellData();
-  int keepCell, usePointScalars;
+  vtkIdType numPts, numCells;
+  vtkPointData *outPD=output->GetPointData();
+  vtkCellData *outCD=output->GetCellData();
 
   vtkDebugMacro(<< "Executing threshold filter");
 
@@ -134,12 +194,10 @@ int vtkThreshold::RequestData(
     }
 
   outPD->CopyGlobalIdsOn();
-  outPD->CopyAllocate(pd);
   outCD->CopyGlobalIdsOn();
-  outCD->CopyAllocate(cd);
 
   numPts = input->GetNumberOfPoints();
-  output->Allocate(input->GetNumberOfCells());
+  numCells = input->GetNumberOfCells();
 
   newPoints = vtkPoints::New();
 
@@ -165,103 +223,34 @@ int vtkThreshold::RequestData(
     newPoints->SetDataType(VTK_DOUBLE);
     }
 
-  newPoints->Allocate(numPts);
-
-  pointMap = vtkIdList::New(); //maps old point ids into new
-  pointMap->SetNumberOfIds(numPts);
-  for (i=0; i < numPts; i++)
+  if (numCells > 0)
     {
-    pointMap->SetId(i,-1);
+    // Some datasets build their cells on the first query, which must not
+    // happen concurrently.
+    input->GetCellType(0);
     }
 
-  newCellPts = vtkIdList::New();
-
+  // Check that the scalars of each cell satisfy the threshold criterion,
+  // then extract the cells that do with the points they use.
+  std::vector<unsigned char> keepCells(numCells);
+  vtkThresholdCellMarker marker;
+  marker.Self = this;
+  marker.Input = input;
+  marker.Scalars = inScalars;
   // are we using pointScalars?
-  usePointScalars = (inScalars->GetNumberOfTuples() == numPts);
+  marker.UsePointScalars = (inScalars->GetNumberOfTuples() == numPts);
+  marker.KeepCells = numCells ? &keepCells[0] : NULL;
+  vtkSMPTools::For(0, numCells, marker);
 
-  // Check that the scalars of each cell satisfy the threshold criterion
-  for (cellId=0; cellId < input->GetNumberOfCells(); cellId++)
-    {
-    cell = input->GetCell(cellId);
-    cellPts = cell->GetPointIds();
-    numCellPts = cell->GetNumberOfPoints();
-
-    if ( usePointScalars )
-      {
-      if (this->AllScalars)
-        {
-        keepCell = 1;
-        for ( i=0; keepCell && (i < numCellPts); i++)
-          {
-          ptId = cellPts->GetId(i);
-          keepCell = this->EvaluateComponents( inScalars, ptId );
-          }
-        }
-      else
-        {
-        if(!this->UseContinuousCellRange)
-          {
-          keepCell = 0;
-          for ( i=0; (!keepCell) && (i < numCellPts); i++)
-            {
-            ptId = cellPts->GetId(i);
-            keepCell = this->EvaluateComponents( inScalars, ptId );
-            }
-          }
-        else
-          {
-          keepCell = this->EvaluateCell(inScalars, cellPts, numCellPts);
-          }
-        }
-      }
-    else //use cell scalars
-      {
-      keepCell = this->EvaluateComponents( inScalars, cellId );
-      }
-
-    if (  numCellPts > 0 && keepCell )
-      {
-      // satisfied thresholding (also non-empty cell, i.e. not VTK_EMPTY_CELL)
-      for (i=0; i < numCellPts; i++)
-        {
-        ptId = cellPts->GetId(i);
-        if ( (newId = pointMap->GetId(ptId)) < 0 )
-          {
-          input->GetPoint(ptId, x);
-          newId = newPoints->InsertNextPoint(x);
-          pointMap->SetId(ptId,newId);
-          outPD->CopyData(pd,ptId,newId);
-          }
-        newCellPts->InsertId(i,newId);
-        }
-      // special handling for polyhedron cells
-      if (vtkUnstructuredGrid::SafeDownCast(input) &&
-          input->GetCellType(cellId) == VTK_POLYHEDRON)
-        {
-        newCellPts->Reset();
-        vtkUnstructuredGrid::SafeDownCast(input)->
-          GetFaceStream(cellId, newCellPts);
-        vtkUnstructuredGrid::ConvertFaceStreamPointIds(
-          newCellPts, pointMap->GetPointer(0));
-        }
-      newCellId = output->InsertNextCell(cell->GetCellType(),newCellPts);
-      outCD->CopyData(cd,cellId,newCellId);
-      newCellPts->Reset();
-      } // satisfied thresholding
-    } // for all cells
+  vtkCellSubsetHelper::ExtractCells(input, numCells ? &keepCells[0] : NULL,
+                                    NULL, newPoints, output);
 
   vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells()
                 << " number of cells.");
 
   // now clean up / update ourselves
-  pointMap->Delete();
-  newCellPts->Delete();
-
-  output->SetPoints(newPoints);
   newPoints->Delete();
 
-  output->Squeeze();
-
   return 1;
 }
 
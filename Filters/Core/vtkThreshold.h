@@ -27,6 +27,10 @@
 //
 // By default only the first scalar value is used in the decision. Use the ComponentMode
 // and SelectedComponent ivars to control this behavior.
+//
+// The cells are tested, and the output is filled, in parallel with
+// vtkSMPTools (see vtkCellSubsetHelper). The output lists the selected cells
+// and the points they use in the order of their ids in the input.
 
 // .SECTION See Also
 // vtkThresholdPoints vtkThresholdTextureCoords
@@ -185,6 +189,10 @@ protected:
   int EvaluateCell( vtkDataArray *scalars, vtkIdList* cellPts, int numCellPts );
   int EvaluateCell( vtkDataArray *scalars, int c, vtkIdList* cellPts, int numCellPts );
 private:
+  //BTX
+  friend class vtkThresholdCellMarker;
+  //ETX
+
   vtkThreshold(const vtkThreshold&);  // Not implemented.
   void operator=(const vtkThreshold&);  // Not implemented.
 };
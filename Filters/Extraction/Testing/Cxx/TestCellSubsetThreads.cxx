@@ -0,0 +1,505 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellSubsetThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test verifies that vtkThreshold, vtkExtractCells and
+// vtkExtractGeometry, which copy the cells they select in parallel, output
+// these cells in the order of their ids with the points they use in the
+// order of their ids, along with their data and the faces of polyhedra,
+// with the Sequential and ThreadPool back-ends. Many point and cell arrays
+// of various types are copied, so that the threads copy the tuples of
+// several arrays at the same time.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkExtractCells.h"
+#include "vtkExtractGeometry.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSphere.h"
+#include "vtkStringArray.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkVariant.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// The number of points along each axis of the datasets.
+static const int DIMENSION = 31;
+
+// The number of arrays of each type added to the point and cell data.
+static const int NUMBER_OF_ARRAYS = 4;
+
+//------------------------------------------------------------------------------
+// Arrays of doubles with one to three components, arrays of unsigned chars
+// and a string array, whose values depend on the tuple and the array.
+static void AddArrays(vtkFieldData* data, vtkIdType numTuples,
+                      const char* prefix)
+{
+  for (int k = 0; k < NUMBER_OF_ARRAYS; ++k)
+    {
+    vtkNew<vtkDoubleArray> doubles;
+    vtkNew<vtkUnsignedCharArray> chars;
+    doubles->SetName((std::string(prefix) + "Doubles" +
+                      vtkVariant(k).ToString()).c_str());
+    chars->SetName((std::string(prefix) + "Chars" +
+                    vtkVariant(k).ToString()).c_str());
+    doubles->SetNumberOfComponents(1 + k % 3);
+    chars->SetNumberOfComponents(1 + k);
+    doubles->SetNumberOfTuples(numTuples);
+    chars->SetNumberOfTuples(numTuples);
+    for (vtkIdType i = 0; i < numTuples; ++i)
+      {
+      for (int c = 0; c < doubles->GetNumberOfComponents(); ++c)
+        {
+        doubles->SetComponent(i, c, 0.5 * i + 10 * k + c);
+        }
+      for (int c = 0; c < chars->GetNumberOfComponents(); ++c)
+        {
+        chars->SetComponent(i, c, (i + 7 * k + c) % 256);
+        }
+      }
+    data->AddArray(doubles.GetPointer());
+    data->AddArray(chars.GetPointer());
+    }
+  vtkNew<vtkStringArray> strings;
+  strings->SetName((std::string(prefix) + "Strings").c_str());
+  strings->SetNumberOfTuples(numTuples);
+  for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+    strings->SetValue(i, vtkVariant(i).ToString());
+    }
+  data->AddArray(strings.GetPointer());
+}
+
+//------------------------------------------------------------------------------
+// Check that the tuple outId of every array of output is the tuple inId of
+// the array of input with the same name.
+static bool SameTuples(vtkFieldData* input, vtkFieldData* output,
+                       vtkIdType inId, vtkIdType outId)
+{
+  for (int i = 0; i < input->GetNumberOfArrays(); ++i)
+    {
+    vtkAbstractArray* inArray = input->GetAbstractArray(i);
+    vtkAbstractArray* outArray =
+      output->GetAbstractArray(inArray->GetName());
+    if (!outArray)
+      {
+      cerr << "Missing array " << inArray->GetName() << "." << endl;
+      return false;
+      }
+    int numComps = inArray->GetNumberOfComponents();
+    for (int c = 0; c < numComps; ++c)
+      {
+      if (inArray->GetVariantValue(inId * numComps + c) !=
+          outArray->GetVariantValue(outId * numComps + c))
+        {
+        cerr << "Wrong value in " << inArray->GetName() << "." << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// The ids of the points and cells as data, and the distance to the center
+// of the dataset as point scalars.
+static void AddData(vtkDataSet* dataSet)
+{
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfTuples(dataSet->GetNumberOfPoints());
+  vtkNew<vtkIdTypeArray> distances;
+  distances->SetName("Distance");
+  distances->SetNumberOfTuples(dataSet->GetNumberOfPoints());
+  double center = 0.5 * (DIMENSION - 1);
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    dataSet->GetPoint(i, x);
+    pointIds->SetValue(i, i);
+    distances->SetValue(i, static_cast<vtkIdType>(
+      (x[0] - center) * (x[0] - center) + (x[1] - center) * (x[1] - center) +
+      (x[2] - center) * (x[2] - center)));
+    }
+  dataSet->GetPointData()->AddArray(pointIds.GetPointer());
+  dataSet->GetPointData()->SetScalars(distances.GetPointer());
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(dataSet->GetNumberOfCells());
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfCells(); ++i)
+    {
+    cellIds->SetValue(i, i);
+    }
+  dataSet->GetCellData()->AddArray(cellIds.GetPointer());
+
+  AddArrays(dataSet->GetPointData(), dataSet->GetNumberOfPoints(), "Point");
+  AddArrays(dataSet->GetCellData(), dataSet->GetNumberOfCells(), "Cell");
+}
+
+//------------------------------------------------------------------------------
+// Five tetrahedra per voxel, except for one voxel out of fifty which is a
+// polyhedron.
+static void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < DIMENSION; ++k)
+    {
+    for (int j = 0; j < DIMENSION; ++j)
+      {
+      for (int i = 0; i < DIMENSION; ++i)
+        {
+        points->InsertNextPoint(i, j, k);
+        }
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->Allocate(5 * DIMENSION * DIMENSION * DIMENSION);
+
+  static const int tetras[5][4] =
+    { { 0, 1, 3, 5 }, { 0, 3, 2, 6 }, { 0, 5, 4, 6 }, { 3, 5, 6, 7 },
+      { 0, 3, 6, 5 } };
+  static const int faces[6][4] =
+    { { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 },
+      { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+  for (int k = 0; k < DIMENSION - 1; ++k)
+    {
+    for (int j = 0; j < DIMENSION - 1; ++j)
+      {
+      for (int i = 0; i < DIMENSION - 1; ++i)
+        {
+        vtkIdType voxel[8];
+        for (int c = 0; c < 8; ++c)
+          {
+          voxel[c] = (i + (c & 1)) + DIMENSION * ((j + ((c >> 1) & 1)) +
+                                                  DIMENSION * (k + (c >> 2)));
+          }
+        if ((i + DIMENSION * (j + DIMENSION * k)) % 50 == 0)
+          {
+          vtkIdType stream[6 * 5];
+          vtkIdType* face = stream;
+          for (int f = 0; f < 6; ++f)
+            {
+            *face++ = 4;
+            for (int c = 0; c < 4; ++c)
+              {
+              *face++ = voxel[faces[f][c]];
+              }
+            }
+          grid->InsertNextCell(VTK_POLYHEDRON, 8, voxel, 6, stream);
+          continue;
+          }
+        for (int t = 0; t < 5; ++t)
+          {
+          vtkIdType tetra[4];
+          for (int c = 0; c < 4; ++c)
+            {
+            tetra[c] = voxel[tetras[t][c]];
+            }
+          grid->InsertNextCell(VTK_TETRA, 4, tetra);
+          }
+        }
+      }
+    }
+  AddData(grid);
+}
+
+//------------------------------------------------------------------------------
+// Replace output point ids by the input ids of the points.
+static void InputIds(vtkIdTypeArray* pointIds, vtkIdList* ids)
+{
+  for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+    {
+    ids->SetId(i, pointIds->GetValue(ids->GetId(i)));
+    }
+}
+
+//------------------------------------------------------------------------------
+static bool SameIds(vtkIdList* a, vtkIdList* b)
+{
+  if (a->GetNumberOfIds() != b->GetNumberOfIds())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfIds(); ++i)
+    {
+    if (a->GetId(i) != b->GetId(i))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Check that output holds the cells of input whose entry in keepCells is
+// true, and the points they use or whose entry in keepPoints is true.
+static bool CheckSubset(vtkDataSet* input, vtkUnstructuredGrid* output,
+                        const std::vector<bool>& keepCells,
+                        const std::vector<bool>& keepPoints,
+                        const char* name)
+{
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  vtkIdTypeArray* cellIds = vtkIdTypeArray::SafeDownCast(
+    output->GetCellData()->GetArray("CellIds"));
+  vtkIdTypeArray* pointIds = vtkIdTypeArray::SafeDownCast(
+    output->GetPointData()->GetArray("PointIds"));
+  if (!cellIds || !pointIds)
+    {
+    cerr << name << ": missing data arrays." << endl;
+    return false;
+    }
+
+  std::set<vtkIdType> usedPoints;
+  vtkNew<vtkIdList> inputIds;
+  vtkNew<vtkIdList> outputIds;
+  vtkIdType outCellId = 0;
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+    {
+    if (!keepCells[cellId])
+      {
+      continue;
+      }
+    if (outCellId >= output->GetNumberOfCells() ||
+        cellIds->GetValue(outCellId) != cellId ||
+        output->GetCellType(outCellId) != input->GetCellType(cellId))
+      {
+      cerr << name << ": wrong cell " << outCellId << "." << endl;
+      return false;
+      }
+    if (!SameTuples(input->GetCellData(), output->GetCellData(), cellId,
+                    outCellId))
+      {
+      cerr << name << ": wrong data for cell " << outCellId << "." << endl;
+      return false;
+      }
+    input->GetCellPoints(cellId, inputIds.GetPointer());
+    output->GetCellPoints(outCellId, outputIds.GetPointer());
+    InputIds(pointIds, outputIds.GetPointer());
+    if (!SameIds(inputIds.GetPointer(), outputIds.GetPointer()))
+      {
+      cerr << name << ": wrong points for cell " << outCellId << "." << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < inputIds->GetNumberOfIds(); ++i)
+      {
+      usedPoints.insert(inputIds->GetId(i));
+      }
+    if (grid && input->GetCellType(cellId) == VTK_POLYHEDRON)
+      {
+      grid->GetFaceStream(cellId, inputIds.GetPointer());
+      output->GetFaceStream(outCellId, outputIds.GetPointer());
+      // Map the point ids after the count of faces and those of points.
+      vtkIdType* stream = outputIds->GetPointer(0);
+      vtkIdType numFaces = *stream++;
+      for (vtkIdType f = 0; f < numFaces; ++f)
+        {
+        vtkIdType npts = *stream++;
+        for (vtkIdType i = 0; i < npts; ++i, ++stream)
+          {
+          *stream = pointIds->GetValue(*stream);
+          }
+        }
+      if (!SameIds(inputIds.GetPointer(), outputIds.GetPointer()))
+        {
+        cerr << name << ": wrong faces for cell " << outCellId << "." << endl;
+        return false;
+        }
+      }
+    ++outCellId;
+    }
+  if (outCellId != output->GetNumberOfCells() || outCellId == 0)
+    {
+    cerr << name << ": " << output->GetNumberOfCells() << " cells instead of "
+         << outCellId << "." << endl;
+    return false;
+    }
+
+  for (vtkIdType ptId = 0; ptId < static_cast<vtkIdType>(keepPoints.size());
+       ++ptId)
+    {
+    if (keepPoints[ptId])
+      {
+      usedPoints.insert(ptId);
+      }
+    }
+  if (static_cast<vtkIdType>(usedPoints.size()) != output->GetNumberOfPoints())
+    {
+    cerr << name << ": " << output->GetNumberOfPoints()
+         << " points instead of " << usedPoints.size() << "." << endl;
+    return false;
+    }
+  vtkIdType outPtId = 0;
+  for (std::set<vtkIdType>::iterator it = usedPoints.begin();
+       it != usedPoints.end(); ++it, ++outPtId)
+    {
+    double x[3], y[3];
+    input->GetPoint(*it, x);
+    output->GetPoint(outPtId, y);
+    if (pointIds->GetValue(outPtId) != *it ||
+        x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+      cerr << name << ": wrong point " << outPtId << "." << endl;
+      return false;
+      }
+    if (!SameTuples(input->GetPointData(), output->GetPointData(), *it,
+                    outPtId))
+      {
+      cerr << name << ": wrong data for point " << outPtId << "." << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static bool TestSubsets(vtkDataSet* input)
+{
+  bool ok = true;
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkDataArray* distances = input->GetPointData()->GetScalars();
+  vtkNew<vtkIdList> cellPts;
+  std::vector<bool> noPoints;
+
+  // Cells with all (or any) of their points between 20 and 80.
+  for (int allScalars = 1; allScalars >= 0; --allScalars)
+    {
+    std::vector<bool> keepCells(numCells);
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+      input->GetCellPoints(cellId, cellPts.GetPointer());
+      int numIn = 0;
+      for (vtkIdType i = 0; i < cellPts->GetNumberOfIds(); ++i)
+        {
+        double d = distances->GetTuple1(cellPts->GetId(i));
+        numIn += (d >= 20 && d <= 80);
+        }
+      keepCells[cellId] = allScalars ?
+        numIn == cellPts->GetNumberOfIds() : numIn > 0;
+      }
+    vtkNew<vtkThreshold> threshold;
+    threshold->SetInputData(input);
+    threshold->ThresholdBetween(20, 80);
+    threshold->SetAllScalars(allScalars);
+    threshold->Update();
+    ok &= CheckSubset(input, threshold->GetOutput(), keepCells, noPoints,
+                      "vtkThreshold");
+    }
+
+  // Every third cell and a few ids out of range.
+  std::vector<bool> keepCells(numCells);
+  vtkNew<vtkExtractCells> extractCells;
+  extractCells->SetInputData(input);
+  for (vtkIdType cellId = 0; cellId < numCells; cellId += 3)
+    {
+    keepCells[cellId] = true;
+    extractCells->AddCellRange(cellId, cellId);
+    }
+  extractCells->AddCellRange(numCells, numCells + 10);
+  extractCells->Update();
+  ok &= CheckSubset(input, extractCells->GetOutput(), keepCells, noPoints,
+                    "vtkExtractCells");
+  vtkIdTypeArray* originalIds = vtkIdTypeArray::SafeDownCast(
+    extractCells->GetOutput()->GetCellData()->GetArray("vtkOriginalCellIds"));
+  for (vtkIdType i = 0; originalIds && i < originalIds->GetNumberOfTuples();
+       ++i)
+    {
+    if (originalIds->GetValue(i) != 3 * i)
+      {
+      originalIds = NULL;
+      }
+    }
+  if (!originalIds)
+    {
+    cerr << "vtkExtractCells: wrong original cell ids." << endl;
+    ok = false;
+    }
+
+  // Cells inside, and across, a sphere.
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(10.2, 11.3, 12.4);
+  sphere->SetRadius(9.1);
+  std::vector<bool> inside(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+    inside[ptId] = sphere->FunctionValue(input->GetPoint(ptId)) < 0.0;
+    }
+  for (int boundary = 0; boundary <= 1; ++boundary)
+    {
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+      input->GetCellPoints(cellId, cellPts.GetPointer());
+      int numIn = 0;
+      for (vtkIdType i = 0; i < cellPts->GetNumberOfIds(); ++i)
+        {
+        numIn += inside[cellPts->GetId(i)];
+        }
+      keepCells[cellId] = boundary ?
+        numIn > 0 : numIn == cellPts->GetNumberOfIds();
+      }
+    vtkNew<vtkExtractGeometry> extractGeometry;
+    extractGeometry->SetInputData(input);
+    extractGeometry->SetImplicitFunction(sphere.GetPointer());
+    extractGeometry->SetExtractBoundaryCells(boundary);
+    extractGeometry->Update();
+    ok &= CheckSubset(input, extractGeometry->GetOutput(), keepCells,
+                      boundary ? noPoints : inside, "vtkExtractGeometry");
+    }
+
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+int TestCellSubsetThreads(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid.GetPointer());
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(DIMENSION, DIMENSION, DIMENSION);
+  AddData(image.GetPointer());
+
+  int status = TEST_SUCCESS;
+  const char* backends[2] = { "Sequential", "ThreadPool" };
+  for (int i = 0; i < 2; ++i)
+    {
+    if (!vtkSMPTools::SetBackend(backends[i]))
+      {
+      continue;
+      }
+    vtkSMPTools::Initialize(8);
+    if (!TestSubsets(grid.GetPointer()) || !TestSubsets(image.GetPointer()))
+      {
+      cerr << "Subsets differ with the " << backends[i] << " back-end."
+           << endl;
+      status = TEST_FAILURE;
+      }
+    }
+
+  return status;
+}
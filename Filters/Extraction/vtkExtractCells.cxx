@@ -19,16 +19,14 @@
 
 #include "vtkExtractCells.h"
 
-#include "vtkCellArray.h"
+#include "vtkCell.h"
+#include "vtkCellSubsetHelper.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
-#include "vtkIntArray.h"
-#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
-#include "vtkCell.h"
 #include "vtkPoints.h"
 #include "vtkPointData.h"
 #include "vtkCellData.h"
-#include "vtkIntArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -36,7 +34,7 @@
 vtkStandardNewMacro(vtkExtractCells);
 
 #include <set>
-#include <algorithm>
+#include <vector>
 
 class vtkExtractCellsSTLCloak
 {
@@ -47,7 +45,6 @@ public:
 //----------------------------------------------------------------------------
 vtkExtractCells::vtkExtractCells()
 {
-  this->SubSetUGridCellArraySize = 0;
   this->InputIsUgrid = 0;
   this->CellList = new vtkExtractCellsSTLCloak;
 }
@@ -170,49 +167,49 @@ int vtkExtractCells::RequestData(
   vtkPointData *newPD = output->GetPointData();
   vtkCellData *newCD  = output->GetCellData();
 
-  vtkIdList *ptIdMap = reMapPointIds(input);
-
-  vtkIdType numPoints = ptIdMap->GetNumberOfIds();
+  // Mark the cells to extract, ignoring the ids out of range, and copy them
+  // in parallel with the points they use.
+  std::vector<unsigned char> keepCells(numCellsInput, 0);
+  std::set<vtkIdType>::iterator cellPtr;
+  for (cellPtr = this->CellList->IdTypeSet.lower_bound(0);
+       cellPtr != this->CellList->IdTypeSet.end() && *cellPtr < numCellsInput;
+       ++cellPtr)
+    {
+    keepCells[*cellPtr] = 1;
+    }
 
   newPD->CopyGlobalIdsOn();
-  newPD->CopyAllocate(PD, numPoints);
-
   newCD->CopyGlobalIdsOn();
-  newCD->CopyAllocate(CD, numCells);
 
   vtkPoints *pts = vtkPoints::New();
-  if(vtkPointSet* inputPS = vtkPointSet::SafeDownCast(input))
+  vtkPointSet* inputPS = vtkPointSet::SafeDownCast(input);
+  if(inputPS && inputPS->GetPoints())
     {
     // preserve input datatype
     pts->SetDataType(inputPS->GetPoints()->GetDataType());
     }
-  pts->SetNumberOfPoints(numPoints);
 
-  for (vtkIdType newId =0; newId<numPoints; newId++)
+  // We only create vtkOriginalCellIds for the output data set if it does not
+  // exist in the input data set.  If it is in the input data set then we
+  // let CopyData() take care of copying it over.
+  vtkIdTypeArray *origMap = 0;
+  if(CD->GetArray("vtkOriginalCellIds") == 0)
     {
-    vtkIdType oldId = ptIdMap->GetId(newId);
-
-    pts->SetPoint(newId, input->GetPoint(oldId));
-
-    newPD->CopyData(PD, oldId, newId);
+    origMap = vtkIdTypeArray::New();
+    origMap->SetNumberOfComponents(1);
+    origMap->SetName("vtkOriginalCellIds");
     }
 
-  output->SetPoints(pts);
+  vtkCellSubsetHelper::ExtractCells(input, numCellsInput ? &keepCells[0] : 0,
+                                    0, pts, output, origMap);
   pts->Delete();
 
-  if (this->InputIsUgrid)
-    {
-    this->CopyCellsUnstructuredGrid(ptIdMap, input, output);
-    }
-  else
+  if(origMap)
     {
-    this->CopyCellsDataSet(ptIdMap, input, output);
+    newCD->AddArray(origMap);
+    origMap->Delete();
     }
 
-  ptIdMap->Delete();
-
-  output->Squeeze();
-
   return 1;
 }
 
@@ -271,301 +268,6 @@ void vtkExtractCells::Copy(vtkDataSet *input, vtkUnstructuredGrid *output)
   return;
 }
 
-//----------------------------------------------------------------------------
-vtkIdType vtkExtractCells::findInSortedList(vtkIdList *idList, vtkIdType id)
-{
-  vtkIdType numids = idList->GetNumberOfIds();
-
-  if (numids < 8) return idList->IsId(id);
-
-  vtkIdType L, R, M;
-  L=0;
-  R=numids-1;
-
-  vtkIdType *ids = idList->GetPointer(0);
-
-  vtkIdType loc = -1;
-
-  while (R > L)
-    {
-    if (R == L+1)
-      {
-      if (ids[R] == id)
-        {
-        loc = R;
-        }
-      else if (ids[L] == id)
-        {
-        loc = L;
-        }
-      break;
-      }
-
-    M = (R + L) / 2;
-
-    if (ids[M] > id)
-      {
-      R = M;
-      continue;
-      }
-    else if (ids[M] < id)
-      {
-      L = M;
-      continue;
-      }
-    else
-      {
-      loc = M;
-      break;
-      }
-    }
-  return loc;
-}
-
-//----------------------------------------------------------------------------
-vtkIdList *vtkExtractCells::reMapPointIds(vtkDataSet *grid)
-{
-  vtkIdType totalPoints = grid->GetNumberOfPoints();
-
-  char *temp = new char [totalPoints];
-
-  if (!temp)
-    {
-    vtkErrorMacro(<< "vtkExtractCells::reMapPointIds memory allocation");
-    return NULL;
-    }
-  memset(temp, 0, totalPoints);
-
-  int numberOfIds = 0;
-  int i;
-  vtkIdType id;
-  vtkIdList *ptIds = vtkIdList::New();
-  std::set<vtkIdType>::iterator cellPtr;
-
-  if (!this->InputIsUgrid)
-    {
-    for (cellPtr = this->CellList->IdTypeSet.begin();
-         cellPtr != this->CellList->IdTypeSet.end();
-         ++cellPtr)
-      {
-      grid->GetCellPoints(*cellPtr, ptIds);
-
-      vtkIdType nIds = ptIds->GetNumberOfIds();
-
-      vtkIdType *ptId = ptIds->GetPointer(0);
-
-      for (i=0; i<nIds; i++)
-        {
-        id = *ptId++;
-
-        if (temp[id] == 0)
-          {
-          numberOfIds++;
-          temp[id] = 1;
-          }
-        }
-      }
-    }
-  else
-    {
-    vtkUnstructuredGrid *ugrid = vtkUnstructuredGrid::SafeDownCast(grid);
-
-    this->SubSetUGridCellArraySize = 0;
-
-    vtkIdType *cellArray = ugrid->GetCells()->GetPointer();
-    vtkIdType *locs = ugrid->GetCellLocationsArray()->GetPointer(0);
-
-    this->SubSetUGridCellArraySize = 0;
-    vtkIdType maxid = ugrid->GetCellLocationsArray()->GetMaxId();
-
-    for (cellPtr = this->CellList->IdTypeSet.begin();
-         cellPtr != this->CellList->IdTypeSet.end();
-         ++cellPtr)
-      {
-      if (*cellPtr > maxid) continue;
-
-      vtkIdType loc = locs[*cellPtr];
-
-      vtkIdType nIds = cellArray[loc++];
-
-      this->SubSetUGridCellArraySize += (1 + nIds);
-
-      for (i=0; i<nIds; i++)
-        {
-        id = cellArray[loc++];
-
-        if (temp[id] == 0)
-          {
-          numberOfIds++;
-          temp[id] = 1;
-          }
-        }
-      }
-    }
-
-  ptIds->SetNumberOfIds(numberOfIds);
-  vtkIdType next=0;
-
-  for (id=0; id<totalPoints; id++)
-    {
-    if (temp[id]) ptIds->SetId(next++, id);
-    }
-
-  delete [] temp;
-
-  return ptIds;
-}
-
-//----------------------------------------------------------------------------
-void vtkExtractCells::CopyCellsDataSet(vtkIdList *ptMap, vtkDataSet *input,
-                                       vtkUnstructuredGrid *output)
-{
-  output->Allocate(this->CellList->IdTypeSet.size());
-
-  vtkCellData *oldCD = input->GetCellData();
-  vtkCellData *newCD = output->GetCellData();
-
-  // We only create vtkOriginalCellIds for the output data set if it does not
-  // exist in the input data set.  If it is in the input data set then we
-  // let CopyData() take care of copying it over.
-  vtkIdTypeArray *origMap = 0;
-  if(oldCD->GetArray("vtkOriginalCellIds") == 0)
-    {
-    origMap = vtkIdTypeArray::New();
-    origMap->SetNumberOfComponents(1);
-    origMap->SetName("vtkOriginalCellIds");
-    newCD->AddArray(origMap);
-    origMap->Delete();
-    }
-
-  vtkIdList *cellPoints = vtkIdList::New();
-
-  std::set<vtkIdType>::iterator cellPtr;
-
-  for (cellPtr = this->CellList->IdTypeSet.begin();
-       cellPtr != this->CellList->IdTypeSet.end();
-       ++cellPtr)
-    {
-    vtkIdType cellId = *cellPtr;
-
-    input->GetCellPoints(cellId, cellPoints);
-
-    for (int i=0; i < cellPoints->GetNumberOfIds(); i++)
-      {
-      vtkIdType oldId = cellPoints->GetId(i);
-
-      vtkIdType newId = vtkExtractCells::findInSortedList(ptMap, oldId);
-
-      cellPoints->SetId(i, newId);
-      }
-    vtkIdType newId = output->InsertNextCell(input->GetCellType(cellId), cellPoints);
-
-    newCD->CopyData(oldCD, cellId, newId);
-    if(origMap)
-      {
-      origMap->InsertNextValue(cellId);
-      }
-    }
-
-  cellPoints->Delete();
-
-  return;
-}
-
-//----------------------------------------------------------------------------
-void vtkExtractCells::CopyCellsUnstructuredGrid(vtkIdList *ptMap,
-                                                vtkDataSet *input,
-                                                vtkUnstructuredGrid *output)
-{
-  vtkUnstructuredGrid *ugrid = vtkUnstructuredGrid::SafeDownCast(input);
-  if (ugrid == NULL)
-    {
-    this->CopyCellsDataSet(ptMap, input, output);
-    return;
-    }
-
-  vtkCellData *oldCD = input->GetCellData();
-  vtkCellData *newCD = output->GetCellData();
-
-  // We only create vtkOriginalCellIds for the output data set if it does not
-  // exist in the input data set.  If it is in the input data set then we
-  // let CopyData() take care of copying it over.
-  vtkIdTypeArray *origMap = 0;
-  if(oldCD->GetArray("vtkOriginalCellIds") == 0)
-    {
-    origMap = vtkIdTypeArray::New();
-    origMap->SetNumberOfComponents(1);
-    origMap->SetName("vtkOriginalCellIds");
-    newCD->AddArray(origMap);
-    origMap->Delete();
-    }
-
-  int numCells = static_cast<int>(this->CellList->IdTypeSet.size());
-
-  vtkCellArray *cellArray = vtkCellArray::New();                 // output
-  vtkIdTypeArray *newcells = vtkIdTypeArray::New();
-  newcells->SetNumberOfValues(this->SubSetUGridCellArraySize);
-  cellArray->SetCells(numCells, newcells);
-  int cellArrayIdx = 0;
-
-  vtkIdTypeArray *locationArray = vtkIdTypeArray::New();
-  locationArray->SetNumberOfValues(numCells);
-
-  vtkUnsignedCharArray *typeArray = vtkUnsignedCharArray::New();
-  typeArray->SetNumberOfValues(numCells);
-
-  int nextCellId = 0;
-
-  std::set<vtkIdType>::iterator cellPtr;                           // input
-  vtkIdType *cells = ugrid->GetCells()->GetPointer();
-  vtkIdType maxid = ugrid->GetCellLocationsArray()->GetMaxId();
-  vtkIdType *locs = ugrid->GetCellLocationsArray()->GetPointer(0);
-  vtkUnsignedCharArray *types = ugrid->GetCellTypesArray();
-
-  for (cellPtr = this->CellList->IdTypeSet.begin();
-       cellPtr != this->CellList->IdTypeSet.end();
-       ++cellPtr)
-    {
-    if (*cellPtr > maxid) continue;
-
-    vtkIdType oldCellId = *cellPtr;
-
-    vtkIdType loc = locs[oldCellId];
-    int size = static_cast<int>(cells[loc]);
-    vtkIdType *pts = cells + loc + 1;
-    unsigned char type = types->GetValue(oldCellId);
-
-    locationArray->SetValue(nextCellId, cellArrayIdx);
-    typeArray->SetValue(nextCellId, type);
-
-    newcells->SetValue(cellArrayIdx++, size);
-
-    for (int i=0; i<size; i++)
-      {
-      vtkIdType oldId = *pts++;
-      vtkIdType newId = vtkExtractCells::findInSortedList(ptMap, oldId);
-
-      newcells->SetValue(cellArrayIdx++, newId);
-      }
-
-    newCD->CopyData(oldCD, oldCellId, nextCellId);
-    if(origMap)
-      {
-      origMap->InsertNextValue(oldCellId);
-      }
-    nextCellId++;
-    }
-
-  output->SetCells(typeArray, locationArray, cellArray);
-
-  typeArray->Delete();
-  locationArray->Delete();
-  newcells->Delete();
-  cellArray->Delete();
-
-  return;
-}
-
 //----------------------------------------------------------------------------
 int vtkExtractCells::FillInputPortInformation(int, vtkInformation *info)
 {
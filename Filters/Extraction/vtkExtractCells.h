@@ -24,6 +24,10 @@
 //    composed of these cells.  If the cell list is empty when vtkExtractCells
 //    executes, it will set up the ugrid, point and cell arrays, with no points,
 //    cells or data.
+//
+//    The cells are copied in parallel with vtkSMPTools (see
+//    vtkCellSubsetHelper), in the order of their ids, with the points they
+//    use in the order of their ids.
 
 #ifndef vtkExtractCells_h
 #define vtkExtractCells_h
@@ -72,17 +76,9 @@ protected:
 private:
 
   void Copy(vtkDataSet *input, vtkUnstructuredGrid *output);
-  static vtkIdType findInSortedList(vtkIdList *idList, vtkIdType id);
-  vtkIdList *reMapPointIds(vtkDataSet *grid);
-
-  void CopyCellsDataSet(vtkIdList *ptMap, vtkDataSet *input,
-                        vtkUnstructuredGrid *output);
-  void CopyCellsUnstructuredGrid(vtkIdList *ptMap, vtkDataSet *input,
-                                 vtkUnstructuredGrid *output);
 
   vtkExtractCellsSTLCloak *CellList;
 
-  int SubSetUGridCellArraySize;
   char InputIsUgrid;
 
   vtkExtractCells(const vtkExtractCells&); // Not implemented
@@ -14,20 +14,21 @@
 =========================================================================*/
 #include "vtkExtractGeometry.h"
 
-#include "vtkCell.h"
 #include "vtkCellData.h"
-#include "vtkCellIterator.h"
-#include "vtkFloatArray.h"
+#include "vtkCellSubsetHelper.h"
 #include "vtkIdList.h"
 #include "vtkImplicitFunction.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
-#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
-#include "vtkSmartPointer.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkExtractGeometry);
 vtkCxxSetObjectMacro(vtkExtractGeometry,ImplicitFunction,vtkImplicitFunction);
 
@@ -68,6 +69,55 @@ unsigned long vtkExtractGeometry::GetMTime()
   return mTime;
 }
 
+//----------------------------------------------------------------------------
+// Marks the cells to extract, in parallel, given the points inside the
+// implicit function.
+class vtkExtractGeometryCellMarker
+{
+public:
+  vtkDataSet* Input;
+  const unsigned char* PointInside;
+  int ExtractBoundaryCells;
+  int ExtractOnlyBoundaryCells;
+  unsigned char* KeepCells;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* pointIdList = this->CellPoints.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      this->Input->GetCellPoints(cellId, pointIdList);
+      vtkIdType numCellPts = pointIdList->GetNumberOfIds();
+      vtkIdType npts = 0;
+      for (vtkIdType i = 0; i < numCellPts; ++i)
+        {
+        if (this->PointInside[pointIdList->GetId(i)])
+          {
+          npts++;
+          }
+        }
+
+      int extraction_condition = 0;
+      if ( this->ExtractOnlyBoundaryCells )
+        {
+        if ( npts != numCellPts && (this->ExtractBoundaryCells && npts > 0) )
+          {
+          extraction_condition = 1;
+          }
+        }
+      else
+        {
+        if ( npts >= numCellPts || (this->ExtractBoundaryCells && npts > 0) )
+          {
+          extraction_condition = 1;
+          }
+        }
+      this->KeepCells[cellId] = static_cast<unsigned char>(extraction_condition);
+      }
+  }
+};
+
 //----------------------------------------------------------------------------
 int vtkExtractGeometry::RequestData(
   vtkInformation *vtkNotUsed(request),
@@ -84,24 +134,11 @@ int vtkExtractGeometry::RequestData(
   vtkUnstructuredGrid *output = vtkUnstructuredGrid::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  // May be NULL, check before dereferencing.
-  vtkUnstructuredGrid *gridInput = vtkUnstructuredGrid::SafeDownCast(input);
-
-  vtkIdType ptId, numPts, numCells, i, newCellId, newId, *pointMap;
-  vtkSmartPointer<vtkCellIterator> cellIter =
-      vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
-  vtkIdList *pointIdList;
-  int cellType;
-  vtkIdType numCellPts;
+  vtkIdType ptId, numPts, numCells;
   double x[3];
   double multiplier;
-  vtkPoints *newPts;
-  vtkIdList *newCellPts;
-  vtkPointData *pd = input->GetPointData();
-  vtkCellData *cd = input->GetCellData();
   vtkPointData *outputPD = output->GetPointData();
   vtkCellData *outputCD = output->GetCellData();
-  int npts;
 
   vtkDebugMacro(<< "Extracting geometry");
 
@@ -116,9 +153,6 @@ int vtkExtractGeometry::RequestData(
   outputPD->CopyGlobalIdsOn();
   outputCD->CopyGlobalIdsOn();
 
-  newCellPts = vtkIdList::New();
-  newCellPts->Allocate(VTK_CELL_SIZE);
-
   if ( this->ExtractInside )
     {
     multiplier = 1.0;
@@ -128,164 +162,57 @@ int vtkExtractGeometry::RequestData(
     multiplier = -1.0;
     }
 
-  // Loop over all points determining whether they are inside the
-  // implicit function. Copy the points and point data if they are.
+  // Loop over all points determining whether they are inside the implicit
+  // function. This is done serially since not all implicit functions can
+  // be evaluated concurrently. Without boundary cells, the points inside
+  // are copied even if no cell uses them.
   //
   numPts = input->GetNumberOfPoints();
   numCells = input->GetNumberOfCells();
-  pointMap = new vtkIdType[numPts]; // maps old point ids into new
-  for (i=0; i < numPts; i++)
-    {
-    pointMap[i] = -1;
-    }
-
-  output->Allocate(numCells/4); //allocate storage for geometry/topology
-  newPts = vtkPoints::New();
-  newPts->Allocate(numPts/4,numPts);
-  outputPD->CopyAllocate(pd);
-  outputCD->CopyAllocate(cd);
-  vtkFloatArray *newScalars = NULL;
-
-  if ( ! this->ExtractBoundaryCells )
+  std::vector<unsigned char> pointInside(numPts);
+  for ( ptId=0; ptId < numPts; ptId++ )
     {
-    for ( ptId=0; ptId < numPts; ptId++ )
+    input->GetPoint(ptId, x);
+    double val = this->ImplicitFunction->FunctionValue(x) * multiplier;
+    if ( ! this->ExtractBoundaryCells )
       {
-      input->GetPoint(ptId, x);
-      if ( (this->ImplicitFunction->FunctionValue(x)*multiplier) < 0.0 )
-        {
-        newId = newPts->InsertNextPoint(x);
-        pointMap[ptId] = newId;
-        outputPD->CopyData(pd,ptId,newId);
-        }
+      pointInside[ptId] = (val < 0.0);
       }
-    }
-  else
-    {
-    // To extract boundary cells, we have to create supplemental information
-    double val;
-    newScalars = vtkFloatArray::New();
-    newScalars->SetNumberOfValues(numPts);
-
-    for (ptId=0; ptId < numPts; ptId++ )
+    else
       {
-      input->GetPoint(ptId, x);
-      val = this->ImplicitFunction->FunctionValue(x) * multiplier;
-      newScalars->SetValue(ptId, val);
+      // The boundary cells have always been found from single precision
+      // values.
+      pointInside[ptId] = (static_cast<float>(val) <= 0.0);
       }
     }
 
-  // Now loop over all cells to see whether they are inside implicit
-  // function (or on boundary if ExtractBoundaryCells is on).
-  //
-  for (cellIter->InitTraversal(); !cellIter->IsDoneWithTraversal();
-       cellIter->GoToNextCell())
+  if (numCells > 0)
     {
-    cellType = cellIter->GetCellType();
-    numCellPts = cellIter->GetNumberOfPoints();
-    pointIdList = cellIter->GetPointIds();
-
-    newCellPts->Reset();
-    if ( ! this->ExtractBoundaryCells ) //requires less work
-      {
-      for ( npts=0, i=0; i < numCellPts; i++, npts++)
-        {
-        ptId = pointIdList->GetId(i);
-        if ( pointMap[ptId] < 0 )
-          {
-          break; //this cell won't be inserted
-          }
-        else
-          {
-          newCellPts->InsertId(i,pointMap[ptId]);
-          }
-        }
-      } //if don't want to extract boundary cells
-
-    else //want boundary cells
-      {
-      for ( npts=0, i=0; i < numCellPts; i++ )
-        {
-        ptId = pointIdList->GetId(i);
-        if ( newScalars->GetValue(ptId) <= 0.0 )
-          {
-          npts++;
-          }
-        }
-      int extraction_condition = 0;
-      if ( this->ExtractOnlyBoundaryCells )
-        {
-        if ( ( npts > 0 ) && ( npts != numCellPts ) )
-          {
-          extraction_condition = 1;
-          }
-        }
-      else
-        {
-        if ( npts > 0 )
-          {
-          extraction_condition = 1;
-          }
-        }
-      if ( extraction_condition )
-        {
-        for ( i=0; i < numCellPts; i++ )
-          {
-          ptId = pointIdList->GetId(i);
-          if ( pointMap[ptId] < 0 )
-            {
-            input->GetPoint(ptId, x);
-            newId = newPts->InsertNextPoint(x);
-            pointMap[ptId] = newId;
-            outputPD->CopyData(pd,ptId,newId);
-            }
-          newCellPts->InsertId(i,pointMap[ptId]);
-          }
-        }//a boundary or interior cell
-      }//if mapping boundary cells
-
-    int extraction_condition = 0;
-    if ( this->ExtractOnlyBoundaryCells )
-      {
-      if ( npts != numCellPts && (this->ExtractBoundaryCells && npts > 0) )
-        {
-        extraction_condition = 1;
-        }
-      }
-    else
-      {
-      if ( npts >= numCellPts || (this->ExtractBoundaryCells && npts > 0) )
-        {
-        extraction_condition = 1;
-        }
-      }
-    if ( extraction_condition )
-      {
-      // special handling for polyhedron cells
-      if (gridInput && cellType == VTK_POLYHEDRON)
-        {
-        newCellPts->Reset();
-        gridInput->GetFaceStream(cellIter->GetCellId(), newCellPts);
-        vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts, pointMap);
-        }
-      newCellId = output->InsertNextCell(cellType,newCellPts);
-      outputCD->CopyData(cd, cellIter->GetCellId(), newCellId);
-      }
-    }//for all cells
+    // Some datasets build their cells on the first query, which must not
+    // happen concurrently.
+    input->GetCellType(0);
+    }
 
-  // Update ourselves and release memory
+  // Now loop over all cells to see whether they are inside implicit
+  // function (or on boundary if ExtractBoundaryCells is on), then extract
+  // them with the points they use.
   //
-  delete [] pointMap;
-  newCellPts->Delete();
-  output->SetPoints(newPts);
+  std::vector<unsigned char> keepCells(numCells);
+  vtkExtractGeometryCellMarker marker;
+  marker.Input = input;
+  marker.PointInside = numPts ? &pointInside[0] : NULL;
+  marker.ExtractBoundaryCells = this->ExtractBoundaryCells;
+  marker.ExtractOnlyBoundaryCells = this->ExtractOnlyBoundaryCells;
+  marker.KeepCells = numCells ? &keepCells[0] : NULL;
+  vtkSMPTools::For(0, numCells, marker);
+
+  vtkPoints *newPts = vtkPoints::New();
+  vtkCellSubsetHelper::ExtractCells(
+    input, numCells ? &keepCells[0] : NULL,
+    (!this->ExtractBoundaryCells && numPts) ? &pointInside[0] : NULL,
+    newPts, output);
   newPts->Delete();
 
-  if ( this->ExtractBoundaryCells )
-    {
-    newScalars->Delete();
-    }
-
-  output->Squeeze();
-
   return 1;
 }
 
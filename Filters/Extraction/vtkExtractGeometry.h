@@ -26,6 +26,10 @@
 // region.) An option exists to extract cells that are neither inside or
 // outside (i.e., boundary).
 //
+// The implicit function is evaluated serially, then the cells are selected
+// and copied in parallel with vtkSMPTools (see vtkCellSubsetHelper). The
+// output lists the cells and points in the order of their ids in the input.
+//
 // A more efficient version of this filter is available for vtkPolyData input.
 // See vtkExtractPolyDataGeometry.
 
@@ -77,5 +77,48 @@ int TestImageDataToPointSet(int, char*[])
       }
     }
 
+  // Implicit points must give the same coordinates and bounds.
+  vtkNew<vtkImageDataToPointSet> implicitImage2points;
+  implicitImage2points->SetInputConnection(wavelet->GetOutputPort());
+  implicitImage2points->ImplicitPointsOn();
+  implicitImage2points->Update();
+
+  vtkDataSet *implicitData = implicitImage2points->GetOutput();
+  if (implicitData->GetNumberOfPoints() != numPoints)
+    {
+    std::cout << "Got wrong number of implicit points." << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  for (vtkIdType pointId = 0; pointId < numPoints; pointId++)
+    {
+    double inPoint[3];
+    double outPoint[3];
+
+    inData->GetPoint(pointId, inPoint);
+    implicitData->GetPoint(pointId, outPoint);
+
+    if (   (inPoint[0] != outPoint[0])
+        || (inPoint[1] != outPoint[1])
+        || (inPoint[2] != outPoint[2]) )
+      {
+      std::cout << "Got mismatched implicit point coordinates." << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  double inBounds[6];
+  double outBounds[6];
+  inData->GetBounds(inBounds);
+  implicitData->GetBounds(outBounds);
+  for (int i = 0; i < 6; i++)
+    {
+    if (inBounds[i] != outBounds[i])
+      {
+      std::cout << "Got mismatched implicit bounds." << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,297 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPriorityPolyDataStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test verifies that vtkPriorityPolyDataStreamer requests the pieces
+// in priority order, skips the culled ones and stops when its budget is
+// spent.
+
+#include "vtkCellArray.h"
+#include "vtkCommand.h"
+#include "vtkDoubleArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleVectorMetaDataKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkPriorityPolyDataStreamer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// Piece i of 8 spans [i, i + 1] along x and its scalars [10 i, 10 i + 10].
+// Its bounds and scalar ranges are given as meta-data, or as a structured
+// extent.
+class TestPieceSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TestPieceSource *New();
+  vtkTypeMacro(TestPieceSource,vtkPolyDataAlgorithm);
+
+  std::vector<int> Pieces;
+  int Structured;
+  unsigned int Delay;
+
+protected:
+  TestPieceSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    this->Structured = 0;
+    this->Delay = 0;
+  }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkAlgorithm::CAN_HANDLE_PIECE_REQUEST(), 1);
+    if (this->Structured)
+      {
+      int wholeExtent[] = { 0, 8, 0, 0, 0, 0 };
+      double origin[] = { 0.0, 0.0, 0.0 };
+      double spacing[] = { 1.0, 1.0, 1.0 };
+      outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(),
+                   wholeExtent, 6);
+      outInfo->Set(vtkDataObject::ORIGIN(), origin, 3);
+      outInfo->Set(vtkDataObject::SPACING(), spacing, 3);
+      return 1;
+      }
+
+    double bounds[48];
+    double ranges[16];
+    for (int i = 0; i < 8; ++i)
+      {
+      double pieceBounds[] = { i, i + 1.0, 0.0, 1.0, 0.0, 1.0 };
+      std::copy(pieceBounds, pieceBounds + 6, bounds + 6 * i);
+      ranges[2 * i] = 10.0 * i;
+      ranges[2 * i + 1] = 10.0 * i + 10.0;
+      }
+    outInfo->Set(vtkPriorityPolyDataStreamer::PIECE_BOUNDS(), bounds, 48);
+    outInfo->Set(vtkPriorityPolyDataStreamer::PIECE_SCALAR_RANGES(),
+                 ranges, 16);
+    return 1;
+  }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    int piece =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    this->Pieces.push_back(piece);
+    if (this->Delay)
+      {
+      vtksys::SystemTools::Delay(this->Delay);
+      }
+
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkCellArray> verts;
+    vtkNew<vtkDoubleArray> scalars;
+    scalars->SetName("Scalars");
+    for (vtkIdType i = 0; i < 1000; ++i)
+      {
+      points->InsertNextPoint(piece + i / 1000.0, 0.5, 0.5);
+      verts->InsertNextCell(1, &i);
+      scalars->InsertNextValue(10.0 * piece + i / 100.0);
+      }
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->SetPoints(points.GetPointer());
+    output->SetVerts(verts.GetPointer());
+    output->GetPointData()->SetScalars(scalars.GetPointer());
+    return 1;
+  }
+
+private:
+  TestPieceSource(const TestPieceSource&); // Not implemented.
+  void operator=(const TestPieceSource&); // Not implemented.
+};
+
+vtkStandardNewMacro(TestPieceSource);
+
+// Counts the pieces delivered progressively.
+class TestPieceObserver : public vtkCommand
+{
+public:
+  static TestPieceObserver *New()
+  {
+    return new TestPieceObserver;
+  }
+
+  virtual void Execute(vtkObject*, unsigned long, void* callData)
+  {
+    if (vtkPolyData::SafeDownCast(static_cast<vtkObject*>(callData)))
+      {
+      this->NumberOfPieces++;
+      }
+  }
+
+  int NumberOfPieces;
+
+protected:
+  TestPieceObserver() : NumberOfPieces(0) {}
+};
+
+namespace
+{
+vtkPolyData* GetOutput(vtkPriorityPolyDataStreamer* streamer)
+{
+  return vtkPolyData::SafeDownCast(streamer->GetOutputDataObject(0));
+}
+
+// Update the streamer and check that the source executed the given pieces,
+// in order, and that the output holds them.
+bool UpdateAndCheck(TestPieceSource* source,
+                    vtkPriorityPolyDataStreamer* streamer,
+                    const int* pieces, int count)
+{
+  source->Pieces.clear();
+  source->Modified();
+  streamer->Update();
+
+  std::vector<int> expected(pieces, pieces + count);
+  vtkPolyData* output = GetOutput(streamer);
+  return source->Pieces == expected &&
+    streamer->GetNumberOfStreamedPieces() == count &&
+    output->GetNumberOfPoints() == 1000 * count;
+}
+}
+
+int TestPriorityPolyDataStreamer(int, char*[])
+{
+  vtkNew<TestPieceSource> source;
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(source->GetOutputPort());
+  vtkNew<vtkPriorityPolyDataStreamer> streamer;
+  streamer->SetInputConnection(elevation->GetOutputPort());
+  streamer->SetNumberOfStreamDivisions(8);
+  vtkNew<TestPieceObserver> observer;
+  streamer->AddObserver(vtkCommand::UpdateDataEvent, observer.GetPointer());
+
+  // Without criteria, the pieces come in their natural order.
+  const int natural[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  if (!UpdateAndCheck(source.GetPointer(), streamer.GetPointer(), natural, 8) ||
+      streamer->GetTerminatedEarly() || observer->NumberOfPieces != 8)
+    {
+    cerr << "Wrong natural order." << endl;
+    streamer->Print(cerr);
+    return TEST_FAILURE;
+    }
+
+  // The nearest pieces come first.
+  streamer->DistanceOrderingOn();
+  streamer->SetViewPoint(10.0, 0.5, 0.5);
+  const int nearest[] = { 7, 6, 5, 4, 3, 2, 1, 0 };
+  if (!UpdateAndCheck(source.GetPointer(), streamer.GetPointer(), nearest, 8))
+    {
+    cerr << "Wrong distance order." << endl;
+    return TEST_FAILURE;
+    }
+
+  // Only the pieces in the frustum, 2.5 <= x <= 5.5, are requested.
+  double planes[24] =
+    {
+    1.0, 0.0, 0.0, -2.5, -1.0, 0.0, 0.0, 5.5,
+    0.0, 1.0, 0.0, 10.0, 0.0, -1.0, 0.0, 10.0,
+    0.0, 0.0, 1.0, 10.0, 0.0, 0.0, -1.0, 10.0
+    };
+  streamer->FrustumCullingOn();
+  streamer->SetFrustumPlanes(planes);
+  const int visible[] = { 5, 4, 3, 2 };
+  if (!UpdateAndCheck(source.GetPointer(), streamer.GetPointer(), visible, 4) ||
+      streamer->GetNumberOfCulledPieces() != 4)
+    {
+    cerr << "Wrong frustum culling." << endl;
+    return TEST_FAILURE;
+    }
+  streamer->FrustumCullingOff();
+
+  // Only the pieces with scalars in [35, 45] are requested.
+  streamer->DistanceOrderingOff();
+  streamer->ScalarRangeCullingOn();
+  streamer->SetScalarRange(35.0, 45.0);
+  const int inRange[] = { 3, 4 };
+  if (!UpdateAndCheck(source.GetPointer(), streamer.GetPointer(), inRange, 2))
+    {
+    cerr << "Wrong scalar range culling." << endl;
+    return TEST_FAILURE;
+    }
+
+  // When every piece is culled, the output is empty.
+  streamer->SetScalarRange(100.0, 200.0);
+  source->Modified();
+  streamer->Update();
+  if (GetOutput(streamer.GetPointer())->GetNumberOfPoints() != 0 ||
+      streamer->GetNumberOfCulledPieces() != 8)
+    {
+    cerr << "Wrong output with every piece culled." << endl;
+    return TEST_FAILURE;
+    }
+  streamer->ScalarRangeCullingOff();
+
+  // Room for three pieces: the fourth one is executed, but not kept.
+  streamer->Update();
+  unsigned long pieceSize =
+    GetOutput(streamer.GetPointer())->GetActualMemorySize() / 8;
+  streamer->SetMemoryLimit(3 * pieceSize + pieceSize / 2);
+  source->Pieces.clear();
+  source->Modified();
+  streamer->Update();
+  if (source->Pieces.size() != 4 ||
+      streamer->GetNumberOfStreamedPieces() != 3 ||
+      GetOutput(streamer.GetPointer())->GetNumberOfPoints() != 3000 ||
+      !streamer->GetTerminatedEarly())
+    {
+    cerr << "Wrong memory budget." << endl;
+    streamer->Print(cerr);
+    return TEST_FAILURE;
+    }
+  streamer->SetMemoryLimit(0);
+
+  // Time for a few pieces only.
+  source->Delay = 20;
+  streamer->SetTimeLimit(0.05);
+  source->Modified();
+  streamer->Update();
+  if (streamer->GetNumberOfStreamedPieces() < 1 ||
+      streamer->GetNumberOfStreamedPieces() > 4 ||
+      !streamer->GetTerminatedEarly())
+    {
+    cerr << "Wrong time budget." << endl;
+    streamer->Print(cerr);
+    return TEST_FAILURE;
+    }
+  source->Delay = 0;
+  streamer->SetTimeLimit(0.0);
+
+  // The bounds of structured pieces are computed from their extent.
+  source->Structured = 1;
+  streamer->DistanceOrderingOn();
+  if (!UpdateAndCheck(source.GetPointer(), streamer.GetPointer(), nearest, 8))
+    {
+    cerr << "Wrong distance order of structured pieces." << endl;
+    return TEST_FAILURE;
+    }
+
+  return TEST_SUCCESS;
+}
@@ -118,5 +118,48 @@ int TestRectilinearGridToPointSet(int, char*[])
       }
     }
 
+  // Implicit points must give the same coordinates and bounds.
+  vtkNew<vtkRectilinearGridToPointSet> implicitRect2points;
+  implicitRect2points->SetInputData(inData);
+  implicitRect2points->ImplicitPointsOn();
+  implicitRect2points->Update();
+
+  vtkDataSet *implicitData = implicitRect2points->GetOutput();
+  if (implicitData->GetNumberOfPoints() != numPoints)
+    {
+    std::cout << "Got wrong number of implicit points." << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  for (vtkIdType pointId = 0; pointId < numPoints; pointId++)
+    {
+    double inPoint[3];
+    double outPoint[3];
+
+    inData->GetPoint(pointId, inPoint);
+    implicitData->GetPoint(pointId, outPoint);
+
+    if (   (inPoint[0] != outPoint[0])
+        || (inPoint[1] != outPoint[1])
+        || (inPoint[2] != outPoint[2]) )
+      {
+      std::cout << "Got mismatched implicit point coordinates." << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  double inBounds[6];
+  double outBounds[6];
+  inData->GetBounds(inBounds);
+  implicitData->GetBounds(outBounds);
+  for (int i = 0; i < 6; i++)
+    {
+    if (inBounds[i] != outBounds[i])
+      {
+      std::cout << "Got mismatched implicit bounds." << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
   return EXIT_SUCCESS;
 }
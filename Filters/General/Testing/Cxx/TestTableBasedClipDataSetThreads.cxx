@@ -0,0 +1,298 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTableBasedClipDataSetThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test verifies that vtkTableBasedClipDataSet produces the same output
+// whether the cells of large inputs are clipped by one thread or several,
+// that is, split into a different number of pieces, for each type of input
+// it clips with its tables, including cells it cannot clip that way.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkImageDataToPointSet.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSmartPointer.h"
+#include "vtkSMPTools.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTableBasedClipDataSet.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// The number of points along each axis of the volumes.
+static const int DIMENSION = 65;
+
+//------------------------------------------------------------------------------
+// Add the distance of the points to the center of the volumes, which is
+// clipped, and the ids of the cells, which are passed along.
+static void AddArrays(vtkDataSet* dataSet)
+{
+  vtkNew<vtkDoubleArray> distance;
+  distance->SetName("Distance");
+  distance->SetNumberOfTuples(dataSet->GetNumberOfPoints());
+  double center = 0.5 * (DIMENSION - 1);
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    dataSet->GetPoint(i, x);
+    distance->SetValue(i, sqrt((x[0] - center) * (x[0] - center) +
+                               (x[1] - center) * (x[1] - center) +
+                               (x[2] - center) * (x[2] - center)));
+    }
+  dataSet->GetPointData()->SetScalars(distance.GetPointer());
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(dataSet->GetNumberOfCells());
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfCells(); ++i)
+    {
+    cellIds->SetValue(i, i);
+    }
+  dataSet->GetCellData()->AddArray(cellIds.GetPointer());
+}
+
+//------------------------------------------------------------------------------
+static vtkSmartPointer<vtkImageData> MakeImageData()
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(DIMENSION, DIMENSION, DIMENSION);
+  return image;
+}
+
+//------------------------------------------------------------------------------
+// Five tetrahedra per voxel, with a poly-vertex, which is not clipped with
+// the tables, every thousand voxels.
+static vtkSmartPointer<vtkDataSet> MakeUnstructuredGrid()
+{
+  vtkSmartPointer<vtkImageData> image = MakeImageData();
+  vtkSmartPointer<vtkUnstructuredGrid> grid =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    points->SetPoint(i, image->GetPoint(i));
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->Allocate(6 * image->GetNumberOfCells());
+
+  static const int tetras[5][4] =
+    { { 0, 1, 3, 5 }, { 0, 3, 2, 6 }, { 0, 5, 4, 6 }, { 3, 5, 6, 7 },
+      { 0, 3, 6, 5 } };
+  for (int k = 0; k < DIMENSION - 1; ++k)
+    {
+    for (int j = 0; j < DIMENSION - 1; ++j)
+      {
+      for (int i = 0; i < DIMENSION - 1; ++i)
+        {
+        vtkIdType voxel[8];
+        for (int c = 0; c < 8; ++c)
+          {
+          voxel[c] = (i + (c & 1)) + DIMENSION * ((j + ((c >> 1) & 1)) +
+                                                  DIMENSION * (k + (c >> 2)));
+          }
+        for (int t = 0; t < 5; ++t)
+          {
+          vtkIdType tetra[4];
+          for (int c = 0; c < 4; ++c)
+            {
+            tetra[c] = voxel[tetras[t][c]];
+            }
+          grid->InsertNextCell(VTK_TETRA, 4, tetra);
+          }
+        if ((i + DIMENSION * (j + DIMENSION * k)) % 1000 == 0)
+          {
+          grid->InsertNextCell(VTK_POLY_VERTEX, 8, voxel);
+          }
+        }
+      }
+    }
+  AddArrays(grid);
+  return grid;
+}
+
+//------------------------------------------------------------------------------
+static vtkSmartPointer<vtkDataSet> MakeStructuredGrid()
+{
+  vtkNew<vtkImageDataToPointSet> toPointSet;
+  toPointSet->SetInputData(MakeImageData());
+  toPointSet->Update();
+  vtkSmartPointer<vtkStructuredGrid> grid = toPointSet->GetOutput();
+  AddArrays(grid);
+  return grid;
+}
+
+//------------------------------------------------------------------------------
+static vtkSmartPointer<vtkDataSet> MakeRectilinearGrid()
+{
+  vtkSmartPointer<vtkRectilinearGrid> grid =
+    vtkSmartPointer<vtkRectilinearGrid>::New();
+  grid->SetDimensions(DIMENSION, DIMENSION, DIMENSION);
+  vtkNew<vtkDoubleArray> coordinates;
+  coordinates->SetNumberOfTuples(DIMENSION);
+  for (int i = 0; i < DIMENSION; ++i)
+    {
+    coordinates->SetValue(i, i);
+    }
+  grid->SetXCoordinates(coordinates.GetPointer());
+  grid->SetYCoordinates(coordinates.GetPointer());
+  grid->SetZCoordinates(coordinates.GetPointer());
+  AddArrays(grid);
+  return grid;
+}
+
+//------------------------------------------------------------------------------
+// Quadrilaterals in the plane z = center, with poly-vertices, which are not
+// clipped with the tables, first.
+static vtkSmartPointer<vtkDataSet> MakePolyData()
+{
+  int resolution = 8 * (DIMENSION - 1);
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetOrigin(0, 0, 0.5 * (DIMENSION - 1));
+  plane->SetPoint1(DIMENSION - 1, 0, 0.5 * (DIMENSION - 1));
+  plane->SetPoint2(0, DIMENSION - 1, 0.5 * (DIMENSION - 1));
+  plane->SetResolution(resolution, resolution);
+  plane->Update();
+  vtkSmartPointer<vtkPolyData> polyData = plane->GetOutput();
+
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType i = 0; i + 3 < polyData->GetNumberOfPoints(); i += 1001)
+    {
+    vtkIdType ids[3] = { i, i + 1, i + 2 };
+    verts->InsertNextCell(3, ids);
+    }
+  polyData->SetVerts(verts.GetPointer());
+  AddArrays(polyData);
+  return polyData;
+}
+
+//------------------------------------------------------------------------------
+static bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+      {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static bool SameGrids(vtkUnstructuredGrid* a, vtkUnstructuredGrid* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfCells() != b->GetNumberOfCells())
+    {
+    cerr << "Output sizes differ: " << a->GetNumberOfPoints() << " points, "
+         << a->GetNumberOfCells() << " cells, and "
+         << b->GetNumberOfPoints() << " points, "
+         << b->GetNumberOfCells() << " cells." << endl;
+    return false;
+    }
+  if (!SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()))
+    {
+    cerr << "Output points differ." << endl;
+    return false;
+    }
+  if (!SameArrays(a->GetCellTypesArray(), b->GetCellTypesArray()) ||
+      !SameArrays(a->GetCells()->GetData(), b->GetCells()->GetData()))
+    {
+    cerr << "Output cells differ." << endl;
+    return false;
+    }
+  if (!SameArrays(a->GetPointData()->GetArray("Distance"),
+                  b->GetPointData()->GetArray("Distance")) ||
+      !SameArrays(a->GetCellData()->GetArray("CellIds"),
+                  b->GetCellData()->GetArray("CellIds")))
+    {
+    cerr << "Output attributes differ." << endl;
+    return false;
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static vtkSmartPointer<vtkUnstructuredGrid> Clip(vtkDataSet* input,
+                                                 const char* measurement)
+{
+  vtkNew<vtkTableBasedClipDataSet> clipper;
+  clipper->SetInputData(input);
+  clipper->SetValue(0.35 * (DIMENSION - 1));
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  clipper->Update();
+  timer->StopTimer();
+  cout << "<DartMeasurement name=\"" << measurement << "-"
+       << input->GetClassName() << "\" type=\"numeric/double\">"
+       << timer->GetElapsedTime() << "</DartMeasurement>" << endl;
+  return clipper->GetOutput();
+}
+
+//------------------------------------------------------------------------------
+int TestTableBasedClipDataSetThreads(int, char*[])
+{
+  vtkSmartPointer<vtkDataSet> inputs[4] =
+    { MakeUnstructuredGrid(), MakeStructuredGrid(), MakeRectilinearGrid(),
+      MakePolyData() };
+
+  int status = TEST_SUCCESS;
+  for (int i = 0; i < 4; ++i)
+    {
+    // Fewer pieces with a single thread than with several.
+    vtkSMPTools::SetBackend("Sequential");
+    vtkSmartPointer<vtkUnstructuredGrid> serial =
+      Clip(inputs[i], "Sequential");
+    vtkSMPTools::SetBackend("ThreadPool");
+    vtkSMPTools::Initialize(4);
+    vtkSmartPointer<vtkUnstructuredGrid> threaded =
+      Clip(inputs[i], "ThreadPool");
+
+    if (serial->GetNumberOfCells() == 0)
+      {
+      cerr << "Nothing clipped from " << inputs[i]->GetClassName() << endl;
+      status = TEST_FAILURE;
+      }
+    if (!SameGrids(serial, threaded))
+      {
+      cerr << "Clipping " << inputs[i]->GetClassName()
+           << " depends on the threads." << endl;
+      status = TEST_FAILURE;
+      }
+    }
+
+  return status;
+}
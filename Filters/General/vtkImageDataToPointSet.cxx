@@ -18,6 +18,7 @@
 ----------------------------------------------------------------------------*/
 #include "vtkImageDataToPointSet.h"
 
+#include "vtkAffineCoordinatesDataArrayTemplate.h"
 #include "vtkCellData.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -33,6 +34,7 @@ vtkStandardNewMacro(vtkImageDataToPointSet);
 //-------------------------------------------------------------------------
 vtkImageDataToPointSet::vtkImageDataToPointSet()
 {
+  this->ImplicitPoints = 0;
 }
 
 vtkImageDataToPointSet::~vtkImageDataToPointSet()
@@ -42,6 +44,8 @@ vtkImageDataToPointSet::~vtkImageDataToPointSet()
 void vtkImageDataToPointSet::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ImplicitPoints: "
+     << (this->ImplicitPoints ? "On" : "Off") << "\n";
 }
 
 //-------------------------------------------------------------------------
@@ -72,6 +76,16 @@ int vtkImageDataToPointSet::CopyStructure(vtkStructuredGrid *outData,
   outData->SetExtent(extent);
 
   vtkNew<vtkPoints> points;
+
+  if (this->ImplicitPoints)
+    {
+    vtkNew<vtkAffineCoordinatesDataArrayTemplate<double> > coords;
+    coords->SetGrid(extent, origin, spacing);
+    points->SetData(coords.GetPointer());
+    outData->SetPoints(points.GetPointer());
+    return 1;
+    }
+
   points->SetDataTypeToDouble();
   points->SetNumberOfPoints(inData->GetNumberOfPoints());
 
@@ -44,6 +44,16 @@ public:
 
   static vtkImageDataToPointSet *New();
 
+  // Description:
+  // Set/Get the flag which controls whether the output points are an
+  // implicit array (vtkAffineCoordinatesDataArrayTemplate) computing each
+  // point from the origin and spacing of the input instead of storing it.
+  // The points then take O(1) memory, but they are read only and
+  // GetVoidPointer() on them makes a full copy. Default is off.
+  vtkSetMacro(ImplicitPoints, int);
+  vtkGetMacro(ImplicitPoints, int);
+  vtkBooleanMacro(ImplicitPoints, int);
+
 protected:
   vtkImageDataToPointSet();
   ~vtkImageDataToPointSet();
@@ -54,6 +64,8 @@ protected:
 
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  int ImplicitPoints;
+
 private:
   vtkImageDataToPointSet(const vtkImageDataToPointSet &); // Not implemented
   void operator=(const vtkImageDataToPointSet &);         // Not implemented
@@ -199,6 +199,17 @@ int vtkPassArrays::RequestData(
   // Get the input and output objects
   vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
   vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+
+  // The arrays passed share the memory of the input arrays until either is
+  // modified.
+  for (int type = 0; type < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++type)
+    {
+    vtkFieldData* outData = output->GetAttributesAsFieldData(type);
+    if (outData)
+      {
+      outData->CopyOnWriteOn();
+      }
+    }
   output->ShallowCopy(input);
 
   // If we are specifying arrays to add, start with no arrays in output
@@ -263,7 +274,7 @@ int vtkPassArrays::RequestData(
       }
     else
       {
-      outData->AddArray(arr);
+      outData->PassArray(arr);
 
       // Preserve attribute type if applicable
       vtkDataSetAttributes* attrib = vtkDataSetAttributes::SafeDownCast(data);
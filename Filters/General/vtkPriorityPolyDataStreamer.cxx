@@ -0,0 +1,453 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPriorityPolyDataStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPriorityPolyDataStreamer.h"
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellData.h"
+#include "vtkCommand.h"
+#include "vtkExtentTranslator.h"
+#include "vtkFloatArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleVectorMetaDataKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkPriorityPolyDataStreamer);
+
+vtkInformationKeyMacro(vtkPriorityPolyDataStreamer, PIECE_BOUNDS, DoubleVectorMetaData);
+vtkInformationKeyMacro(vtkPriorityPolyDataStreamer, PIECE_SCALAR_RANGES, DoubleVectorMetaData);
+
+//----------------------------------------------------------------------------
+class vtkPriorityPolyDataStreamerInternals
+{
+public:
+  // The pieces to request, in order, as indices in the stream divisions.
+  std::vector<int> Order;
+
+  // The budget spent by the current update.
+  double StartTime;
+  unsigned long OutputSize;
+  bool BudgetSpent;
+};
+
+namespace
+{
+// Compare pieces by distance only, so that a stable sort keeps the pieces
+// at the same distance in their natural order.
+bool CloserPiece(const std::pair<double, int>& a,
+                 const std::pair<double, int>& b)
+{
+  return a.first < b.first;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkPriorityPolyDataStreamer::vtkPriorityPolyDataStreamer()
+{
+  this->SetNumberOfInputPorts(1);
+  this->SetNumberOfOutputPorts(1);
+
+  this->NumberOfPasses = 2;
+  this->FrustumCulling = 0;
+  for (int i = 0; i < 24; ++i)
+    {
+    this->FrustumPlanes[i] = 0.0;
+    }
+  this->DistanceOrdering = 0;
+  this->ViewPoint[0] = this->ViewPoint[1] = this->ViewPoint[2] = 0.0;
+  this->ScalarRangeCulling = 0;
+  this->ScalarRange[0] = 0.0;
+  this->ScalarRange[1] = 1.0;
+  this->TimeLimit = 0.0;
+  this->MemoryLimit = 0;
+  this->ColorByPiece = 0;
+
+  this->NumberOfStreamedPieces = 0;
+  this->NumberOfCulledPieces = 0;
+  this->TerminatedEarly = 0;
+
+  this->Append = vtkAppendPolyData::New();
+  this->Internals = new vtkPriorityPolyDataStreamerInternals;
+  this->Internals->StartTime = 0.0;
+  this->Internals->OutputSize = 0;
+  this->Internals->BudgetSpent = false;
+}
+
+//----------------------------------------------------------------------------
+vtkPriorityPolyDataStreamer::~vtkPriorityPolyDataStreamer()
+{
+  this->Append->Delete();
+  this->Append = 0;
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPriorityPolyDataStreamer::SetNumberOfStreamDivisions(int num)
+{
+  if (num < 1)
+    {
+    num = 1;
+    }
+  if (this->NumberOfPasses == (unsigned int)num)
+    {
+    return;
+    }
+
+  this->Modified();
+  this->NumberOfPasses = num;
+}
+
+//----------------------------------------------------------------------------
+int vtkPriorityPolyDataStreamer::GetPieceBounds(
+  vtkInformation* inInfo, int piece, int numPieces, double bounds[6])
+{
+  vtkInformationDoubleVectorMetaDataKey* key = PIECE_BOUNDS();
+  if (inInfo->Has(key) && key->Length(inInfo) == 6 * numPieces)
+    {
+    const double* pieceBounds = key->Get(inInfo) + 6 * piece;
+    std::copy(pieceBounds, pieceBounds + 6, bounds);
+    return 1;
+    }
+
+  if (inInfo->Has(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()) &&
+      inInfo->Has(vtkDataObject::ORIGIN()) &&
+      inInfo->Has(vtkDataObject::SPACING()))
+    {
+    int wholeExtent[6];
+    int extent[6];
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExtent);
+    vtkNew<vtkExtentTranslator> translator;
+    if (!translator->PieceToExtentThreadSafe(
+          piece, numPieces, 0, wholeExtent, extent,
+          vtkExtentTranslator::BLOCK_MODE, 0))
+      {
+      return 0;
+      }
+    double* origin = inInfo->Get(vtkDataObject::ORIGIN());
+    double* spacing = inInfo->Get(vtkDataObject::SPACING());
+    for (int i = 0; i < 3; ++i)
+      {
+      double a = origin[i] + extent[2 * i] * spacing[i];
+      double b = origin[i] + extent[2 * i + 1] * spacing[i];
+      bounds[2 * i] = std::min(a, b);
+      bounds[2 * i + 1] = std::max(a, b);
+      }
+    return 1;
+    }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPriorityPolyDataStreamer::ComputePieceOrder(
+  vtkInformation* inInfo, int outPiece, int outNumPieces)
+{
+  int numDivisions = static_cast<int>(this->NumberOfPasses);
+  int numPieces = outNumPieces * numDivisions;
+
+  vtkInformationDoubleVectorMetaDataKey* rangesKey = PIECE_SCALAR_RANGES();
+  const double* ranges = 0;
+  if (inInfo->Has(rangesKey) && rangesKey->Length(inInfo) == 2 * numPieces)
+    {
+    ranges = rangesKey->Get(inInfo);
+    }
+
+  std::vector<std::pair<double, int> > pieces;
+  this->NumberOfCulledPieces = 0;
+  for (int i = 0; i < numDivisions; ++i)
+    {
+    int piece = outPiece * numDivisions + i;
+    double bounds[6];
+    int hasBounds = this->GetPieceBounds(inInfo, piece, numPieces, bounds);
+
+    bool culled = false;
+    if (this->FrustumCulling && hasBounds)
+      {
+      // The box is outside when its corner farthest along the normal of
+      // one of the planes is outside.
+      for (int p = 0; p < 6 && !culled; ++p)
+        {
+        const double* plane = this->FrustumPlanes + 4 * p;
+        double distance = plane[3];
+        for (int j = 0; j < 3; ++j)
+          {
+          distance += plane[j] *
+            (plane[j] >= 0.0 ? bounds[2 * j + 1] : bounds[2 * j]);
+          }
+        culled = distance < 0.0;
+        }
+      }
+    if (this->ScalarRangeCulling && ranges)
+      {
+      const double* range = ranges + 2 * piece;
+      culled = culled || range[1] < this->ScalarRange[0] ||
+        range[0] > this->ScalarRange[1];
+      }
+    if (culled)
+      {
+      this->NumberOfCulledPieces++;
+      continue;
+      }
+
+    double distance2 = 0.0;
+    if (this->DistanceOrdering && hasBounds)
+      {
+      for (int j = 0; j < 3; ++j)
+        {
+        double d = 0.0;
+        if (this->ViewPoint[j] < bounds[2 * j])
+          {
+          d = bounds[2 * j] - this->ViewPoint[j];
+          }
+        else if (this->ViewPoint[j] > bounds[2 * j + 1])
+          {
+          d = this->ViewPoint[j] - bounds[2 * j + 1];
+          }
+        distance2 += d * d;
+        }
+      }
+    pieces.push_back(std::make_pair(distance2, i));
+    }
+
+  std::stable_sort(pieces.begin(), pieces.end(), CloserPiece);
+  this->Internals->Order.clear();
+  for (size_t i = 0; i < pieces.size(); ++i)
+    {
+    this->Internals->Order.push_back(pieces[i].second);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkPriorityPolyDataStreamer::RequestUpdateExtent(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  // get the info object
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  int outPiece = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  int outNumPieces = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+
+  if (this->CurrentIndex == 0)
+    {
+    this->ComputePieceOrder(inInfo, outPiece, outNumPieces);
+    this->Internals->StartTime = vtkTimerLog::GetUniversalTime();
+    this->Internals->OutputSize = 0;
+    this->Internals->BudgetSpent = false;
+    }
+
+  // When all the pieces are culled, the first one is still requested, and
+  // discarded.
+  const std::vector<int>& order = this->Internals->Order;
+  int index = 0;
+  if (this->CurrentIndex < order.size())
+    {
+    index = order[this->CurrentIndex];
+    }
+
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+              outPiece * this->NumberOfPasses + index);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+              outNumPieces * this->NumberOfPasses);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPriorityPolyDataStreamer::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  if (this->CurrentIndex == 0)
+    {
+    this->NumberOfStreamedPieces = 0;
+    this->TerminatedEarly = 0;
+    }
+
+  if (!this->Superclass::RequestData(request, inputVector, outputVector))
+    {
+    this->CurrentIndex = 0;
+    return 0;
+    }
+
+  // Stop before the NumberOfPasses divisions once the pieces left are
+  // culled or the budget is spent.
+  if (request->Has(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING()))
+    {
+    bool done = this->CurrentIndex >= this->Internals->Order.size();
+    if (!done && this->Internals->BudgetSpent)
+      {
+      this->TerminatedEarly = 1;
+      done = true;
+      }
+    if (done)
+      {
+      request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
+      this->CurrentIndex = 0;
+      if (!this->PostExecute(inputVector, outputVector))
+        {
+        return 0;
+        }
+      }
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPriorityPolyDataStreamer::ExecutePass(
+  vtkInformationVector **inputVector,
+  vtkInformationVector *vtkNotUsed(outputVector))
+{
+  size_t numberOfPieces = this->Internals->Order.size();
+  if (this->CurrentIndex >= numberOfPieces)
+    {
+    return 1;
+    }
+
+  // get the info objects
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+
+  // get the input and output
+  vtkPolyData *input = vtkPolyData::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  vtkPolyData *copy  = vtkPolyData::New();
+  copy->ShallowCopy(input);
+
+  if (this->ColorByPiece)
+    {
+    int inPiece = inInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    vtkFloatArray *pieceColors = vtkFloatArray::New();
+    pieceColors->SetName("Piece Colors");
+    vtkIdType numCells = input->GetNumberOfCells();
+    pieceColors->SetNumberOfTuples(numCells);
+    for (vtkIdType j = 0; j < numCells; ++j)
+      {
+      pieceColors->SetValue(j, inPiece);
+      }
+    int idx = copy->GetCellData()->AddArray(pieceColors);
+    copy->GetCellData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+    pieceColors->Delete();
+    }
+
+  // Discard the piece that does not fit in the memory budget, unless it is
+  // the first one.
+  unsigned long size = copy->GetActualMemorySize();
+  if (this->MemoryLimit > 0 && this->NumberOfStreamedPieces > 0 &&
+      this->Internals->OutputSize + size > this->MemoryLimit)
+    {
+    copy->Delete();
+    this->Internals->BudgetSpent = true;
+    this->TerminatedEarly = 1;
+    return 1;
+    }
+
+  this->Append->AddInputData(copy);
+  this->Internals->OutputSize += size;
+  this->NumberOfStreamedPieces++;
+  this->InvokeEvent(vtkCommand::UpdateDataEvent, copy);
+  copy->Delete();
+
+  if (this->TimeLimit > 0.0 &&
+      vtkTimerLog::GetUniversalTime() - this->Internals->StartTime >=
+      this->TimeLimit)
+    {
+    this->Internals->BudgetSpent = true;
+    }
+
+  this->UpdateProgress(
+    static_cast<double>(this->CurrentIndex + 1) / numberOfPieces);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPriorityPolyDataStreamer::PostExecute(
+  vtkInformationVector **vtkNotUsed(inputVector),
+  vtkInformationVector *outputVector)
+{
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  vtkPolyData *output = vtkPolyData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  if (this->Append->GetNumberOfInputConnections(0) == 0)
+    {
+    output->Initialize();
+    return 1;
+    }
+
+  this->Append->Update();
+  output->ShallowCopy(this->Append->GetOutput());
+  this->Append->RemoveAllInputConnections(0);
+  this->Append->GetOutput()->Initialize();
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPriorityPolyDataStreamer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "NumberOfStreamDivisions: " << this->NumberOfPasses << endl;
+  os << indent << "FrustumCulling: " << this->FrustumCulling << endl;
+  os << indent << "DistanceOrdering: " << this->DistanceOrdering << endl;
+  os << indent << "ViewPoint: (" << this->ViewPoint[0] << ", "
+     << this->ViewPoint[1] << ", " << this->ViewPoint[2] << ")" << endl;
+  os << indent << "ScalarRangeCulling: " << this->ScalarRangeCulling << endl;
+  os << indent << "ScalarRange: (" << this->ScalarRange[0] << ", "
+     << this->ScalarRange[1] << ")" << endl;
+  os << indent << "TimeLimit: " << this->TimeLimit << endl;
+  os << indent << "MemoryLimit: " << this->MemoryLimit << endl;
+  os << indent << "ColorByPiece: " << this->ColorByPiece << endl;
+  os << indent << "NumberOfStreamedPieces: "
+     << this->NumberOfStreamedPieces << endl;
+  os << indent << "NumberOfCulledPieces: "
+     << this->NumberOfCulledPieces << endl;
+  os << indent << "TerminatedEarly: " << this->TerminatedEarly << endl;
+}
+
+//----------------------------------------------------------------------------
+int vtkPriorityPolyDataStreamer::FillOutputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  // now add our info
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkPolyData");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPriorityPolyDataStreamer::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  return 1;
+}
@@ -0,0 +1,204 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPriorityPolyDataStreamer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPriorityPolyDataStreamer - Streamer requesting the most relevant
+// pieces first, within a time and memory budget.
+// .SECTION Description
+// vtkPriorityPolyDataStreamer divides its output piece into
+// NumberOfStreamDivisions pieces, like vtkPolyDataStreamer, and appends them
+// to its output. The pieces are however requested in priority order, pieces
+// that cannot contribute to the image are skipped, and streaming stops
+// early once a time or memory budget is spent. This makes it possible to
+// look at datasets larger than memory: the pieces nearest to the viewer are
+// loaded first, and loading stops before memory runs out.
+//
+// The priority of a piece is computed from its bounds and scalar range,
+// before it is requested:
+// - with FrustumCulling on, pieces outside the view frustum (FrustumPlanes,
+// as returned by vtkCamera::GetFrustumPlanes()) are skipped;
+// - with ScalarRangeCulling on, pieces whose scalar range does not
+// intersect ScalarRange are skipped, e.g. the pieces without the
+// iso-value of a contour filter upstream;
+// - with DistanceOrdering on, pieces are requested by increasing distance
+// of their bounds to ViewPoint, the camera position.
+// Pieces of same priority are requested in their natural order.
+//
+// The bounds of the pieces are computed from WHOLE_EXTENT, ORIGIN and
+// SPACING when the input comes from structured data, e.g. an image
+// contoured upstream. Otherwise, and for the scalar ranges, the reader or
+// source upstream provides them as meta-data during REQUEST_INFORMATION,
+// with the PIECE_BOUNDS() and PIECE_SCALAR_RANGES() keys, for a given
+// number of pieces. The meta-data is ignored when it does not describe the
+// number of pieces requested by the streamer. Without bounds or scalar
+// ranges, the corresponding criteria are not applied.
+//
+// With a TimeLimit, no other piece is requested once streaming took that
+// many seconds. With a MemoryLimit, a piece that would bring the output over
+// the limit is discarded, and streaming stops. The first piece is always
+// kept. GetNumberOfStreamedPieces() and GetTerminatedEarly() tell how the
+// last update went.
+//
+// An UpdateDataEvent is invoked after each piece is appended, with the
+// piece as call data, so that applications can render the pieces as they
+// arrive instead of waiting for the whole output.
+//
+// .SECTION See Also
+// vtkPolyDataStreamer vtkStreamerBase
+
+#ifndef vtkPriorityPolyDataStreamer_h
+#define vtkPriorityPolyDataStreamer_h
+
+#include "vtkFiltersGeneralModule.h" // For export macro
+#include "vtkStreamerBase.h"
+
+class vtkAppendPolyData;
+class vtkInformationDoubleVectorMetaDataKey;
+class vtkPriorityPolyDataStreamerInternals;
+
+class VTKFILTERSGENERAL_EXPORT vtkPriorityPolyDataStreamer :
+  public vtkStreamerBase
+{
+public:
+  static vtkPriorityPolyDataStreamer *New();
+  vtkTypeMacro(vtkPriorityPolyDataStreamer,vtkStreamerBase);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set the number of pieces to divide the problem into.
+  void SetNumberOfStreamDivisions(int num);
+  int GetNumberOfStreamDivisions()
+  {
+    return this->NumberOfPasses;
+  }
+
+  // Description:
+  // Skip the pieces outside the view frustum. Off by default.
+  vtkSetMacro(FrustumCulling, int);
+  vtkGetMacro(FrustumCulling, int);
+  vtkBooleanMacro(FrustumCulling, int);
+
+  // Description:
+  // The six planes of the view frustum, as four coefficients A, B, C, D of
+  // Ax + By + Cz + D = 0 each, the normals pointing inside. This is the
+  // layout of vtkCamera::GetFrustumPlanes().
+  vtkSetVectorMacro(FrustumPlanes, double, 24);
+  vtkGetVectorMacro(FrustumPlanes, double, 24);
+
+  // Description:
+  // Request the pieces nearest to ViewPoint first. Off by default.
+  vtkSetMacro(DistanceOrdering, int);
+  vtkGetMacro(DistanceOrdering, int);
+  vtkBooleanMacro(DistanceOrdering, int);
+
+  // Description:
+  // The position of the viewer, used by DistanceOrdering.
+  vtkSetVector3Macro(ViewPoint, double);
+  vtkGetVector3Macro(ViewPoint, double);
+
+  // Description:
+  // Skip the pieces whose scalar range does not intersect ScalarRange.
+  // Off by default.
+  vtkSetMacro(ScalarRangeCulling, int);
+  vtkGetMacro(ScalarRangeCulling, int);
+  vtkBooleanMacro(ScalarRangeCulling, int);
+
+  // Description:
+  // The range of scalars of interest, used by ScalarRangeCulling.
+  vtkSetVector2Macro(ScalarRange, double);
+  vtkGetVector2Macro(ScalarRange, double);
+
+  // Description:
+  // Time in seconds after which no other piece is requested. 0, the
+  // default, means no limit.
+  vtkSetClampMacro(TimeLimit, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(TimeLimit, double);
+
+  // Description:
+  // Maximum size of the output in kibibytes. 0, the default, means no
+  // limit.
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+
+  // Description:
+  // By default, this option is off.  When it is on, cell scalars are generated
+  // based on which piece they are in.
+  vtkSetMacro(ColorByPiece, int);
+  vtkGetMacro(ColorByPiece, int);
+  vtkBooleanMacro(ColorByPiece, int);
+
+  // Description:
+  // Number of pieces appended to the output, number of pieces skipped by
+  // the culling criteria, and whether a budget stopped streaming, during
+  // the last update.
+  vtkGetMacro(NumberOfStreamedPieces, int);
+  vtkGetMacro(NumberOfCulledPieces, int);
+  vtkGetMacro(TerminatedEarly, int);
+
+  // Description:
+  // Meta-data provided upstream during REQUEST_INFORMATION: the bounds
+  // (xmin, xmax, ymin, ymax, zmin, zmax) and the scalar range (min, max) of
+  // each piece, for a given number of pieces.
+  static vtkInformationDoubleVectorMetaDataKey* PIECE_BOUNDS();
+  static vtkInformationDoubleVectorMetaDataKey* PIECE_SCALAR_RANGES();
+
+protected:
+  vtkPriorityPolyDataStreamer();
+  ~vtkPriorityPolyDataStreamer();
+
+  // see algorithm for more info
+  virtual int FillOutputPortInformation(int port, vtkInformation* info);
+  virtual int FillInputPortInformation(int port, vtkInformation* info);
+
+  int RequestUpdateExtent(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+  virtual int RequestData(vtkInformation *request,
+                          vtkInformationVector **inputVector,
+                          vtkInformationVector *outputVector);
+  virtual int ExecutePass(vtkInformationVector **inputVector,
+                          vtkInformationVector *outputVector);
+  virtual int PostExecute(vtkInformationVector **inputVector,
+                          vtkInformationVector *outputVector);
+
+  // Compute the order in which the pieces are requested, from the
+  // meta-data available in inInfo.
+  void ComputePieceOrder(vtkInformation* inInfo, int outPiece,
+                         int outNumPieces);
+
+  // Get the bounds of the given input piece, from the meta-data or the
+  // structured extent. Returns 0 if they are unknown.
+  int GetPieceBounds(vtkInformation* inInfo, int piece, int numPieces,
+                     double bounds[6]);
+
+  int FrustumCulling;
+  double FrustumPlanes[24];
+  int DistanceOrdering;
+  double ViewPoint[3];
+  int ScalarRangeCulling;
+  double ScalarRange[2];
+  double TimeLimit;
+  unsigned long MemoryLimit;
+  int ColorByPiece;
+
+  int NumberOfStreamedPieces;
+  int NumberOfCulledPieces;
+  int TerminatedEarly;
+
+private:
+  vtkPriorityPolyDataStreamer(const vtkPriorityPolyDataStreamer&);  // Not implemented.
+  void operator=(const vtkPriorityPolyDataStreamer&);  // Not implemented.
+
+  vtkAppendPolyData* Append;
+  vtkPriorityPolyDataStreamerInternals* Internals;
+};
+
+#endif
@@ -23,6 +23,7 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkRectilinearCoordinatesDataArrayTemplate.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkStructuredGrid.h"
 
@@ -33,6 +34,7 @@ vtkStandardNewMacro(vtkRectilinearGridToPointSet);
 //-------------------------------------------------------------------------
 vtkRectilinearGridToPointSet::vtkRectilinearGridToPointSet()
 {
+  this->ImplicitPoints = 0;
 }
 
 vtkRectilinearGridToPointSet::~vtkRectilinearGridToPointSet()
@@ -42,6 +44,8 @@ vtkRectilinearGridToPointSet::~vtkRectilinearGridToPointSet()
 void vtkRectilinearGridToPointSet::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ImplicitPoints: "
+     << (this->ImplicitPoints ? "On" : "Off") << "\n";
 }
 
 //-------------------------------------------------------------------------
@@ -70,6 +74,16 @@ int vtkRectilinearGridToPointSet::CopyStructure(vtkStructuredGrid *outData,
   outData->SetExtent(extent);
 
   vtkNew<vtkPoints> points;
+
+  if (this->ImplicitPoints)
+    {
+    vtkNew<vtkRectilinearCoordinatesDataArrayTemplate<double> > coords;
+    coords->SetCoordinates(xcoord, ycoord, zcoord);
+    points->SetData(coords.GetPointer());
+    outData->SetPoints(points.GetPointer());
+    return 1;
+    }
+
   points->SetDataTypeToDouble();
   points->SetNumberOfPoints(inData->GetNumberOfPoints());
 
@@ -45,6 +45,17 @@ public:
 
   static vtkRectilinearGridToPointSet *New();
 
+  // Description:
+  // Set/Get the flag which controls whether the output points are an
+  // implicit array (vtkRectilinearCoordinatesDataArrayTemplate) computing
+  // each point from the coordinate arrays of the input instead of storing
+  // it. The points then share the input coordinates and take no more
+  // memory, but they are read only and GetVoidPointer() on them makes a
+  // full copy. Default is off.
+  vtkSetMacro(ImplicitPoints, int);
+  vtkGetMacro(ImplicitPoints, int);
+  vtkBooleanMacro(ImplicitPoints, int);
+
 protected:
   vtkRectilinearGridToPointSet();
   ~vtkRectilinearGridToPointSet();
@@ -55,6 +66,8 @@ protected:
 
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  int ImplicitPoints;
+
 private:
   vtkRectilinearGridToPointSet(const vtkRectilinearGridToPointSet &); // Not implemented
   void operator=(const vtkRectilinearGridToPointSet &);         // Not implemented
@@ -47,6 +47,7 @@
 #include "vtkImplicitFunction.h"
 
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkCellData.h"
 #include "vtkPointData.h"
 #include "vtkCellArray.h"
@@ -60,6 +61,9 @@
 
 #include "vtkTableBasedClipCases.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro( vtkTableBasedClipDataSet );
 vtkCxxSetObjectMacro( vtkTableBasedClipDataSet, ClipFunction, vtkImplicitFunction );
 
@@ -467,6 +471,7 @@ class vtkTableBasedClipperShapeList
     int            GetTotalNumberOfShapes() const;
     int            GetNumberOfLists() const;
     int            GetList(int, const int *& ) const;
+    void           AddShape( int cellId, const int * ids );
   protected:
     int         ** list;
     int            currentList;
@@ -633,6 +638,14 @@ class  vtkTableBasedClipperVolumeFromVolume :
     void     AddVertex(int z, int v0)
              { this->vertices.AddVertex( z, v0 ); }
 
+    // Append the points and shapes of a volume clipped from the cells
+    // following those of this volume, as if they had been clipped into
+    // this volume: the points on the edges already known are merged.
+    // This runs serially and inserts every edge point of the piece in the
+    // edge hash again, as the clipping of its cells did, which limits the
+    // speedup of the parallel clip.
+    void     Append( const vtkTableBasedClipperVolumeFromVolume & piece );
+
   protected:
     vtkTableBasedClipperCentroidPointList centroid_list;
     vtkTableBasedClipperHexList     hexes;
@@ -829,6 +842,43 @@ int  vtkTableBasedClipperShapeList::GetTotalNumberOfShapes() const
   return numFullLists * shapesPerList + numExtra;
 }
 
+void vtkTableBasedClipperShapeList::AddShape( int cellId, const int * ids )
+{
+  if ( currentShape >= shapesPerList )
+    {
+    if (  ( currentList + 1 ) >= listSize  )
+      {
+      int ** tmpList = new int * [ 2 * listSize ];
+
+      for ( int i = 0; i < listSize; i ++ )
+        {
+        tmpList[i] = list[i];
+        }
+
+      for ( int i = listSize; i < listSize * 2; i ++ )
+        {
+        tmpList[i] = NULL;
+        }
+
+      listSize *= 2;
+      delete [] list;
+      list = tmpList;
+      }
+
+    currentList ++;
+    list[ currentList ] = new int[  ( shapeSize + 1 ) * shapesPerList  ];
+    currentShape = 0;
+    }
+
+  int idx = ( shapeSize + 1 ) * currentShape;
+  list[ currentList ][ idx ] = cellId;
+  for ( int i = 0; i < shapeSize; i ++ )
+    {
+    list[ currentList ][ idx + 1 + i ] = ids[i];
+    }
+  currentShape ++;
+}
+
 vtkTableBasedClipperHexList::vtkTableBasedClipperHexList()
     : vtkTableBasedClipperShapeList( 8 )
 {
@@ -1582,6 +1632,75 @@ void vtkTableBasedClipperVolumeFromVolume::
   delete [] ptLookup;
 }
 
+void vtkTableBasedClipperVolumeFromVolume::
+     Append( const vtkTableBasedClipperVolumeFromVolume & piece )
+{
+  int   i, j, k, l;
+
+  //
+  // Add the points along edges, looking up those already added.
+  //
+  std::vector< int > edgeIds( piece.pt_list.GetTotalNumberOfPoints() );
+  int   nLists = piece.pt_list.GetNumberOfLists();
+  for ( l = 0, i = 0; i < nLists; i ++ )
+    {
+    const TableBasedClipperPointEntry * pe_list = NULL;
+    int nPts = piece.pt_list.GetList( i, pe_list );
+    for ( j = 0; j < nPts; j ++ )
+      {
+      edgeIds[ l ++ ] = this->AddPoint( pe_list[j].ptIds[0],
+                                        pe_list[j].ptIds[1],
+                                        pe_list[j].percent );
+      }
+    }
+
+  //
+  // The centroid points follow those of this volume. Their ids, and those
+  // of the points along edges, are translated to this volume.
+  //
+  int   centroidOffset = centroid_list.GetTotalNumberOfPoints();
+  int   ids[8];
+  nLists = piece.centroid_list.GetNumberOfLists();
+  for ( i = 0; i < nLists; i ++ )
+    {
+    const TableBasedClipperCentroidPointEntry * ce_list = NULL;
+    int nPts = piece.centroid_list.GetList( i, ce_list );
+    for ( j = 0; j < nPts; j ++ )
+      {
+      const TableBasedClipperCentroidPointEntry & ce = ce_list[j];
+      for ( k = 0; k < ce.nPts; k ++ )
+        {
+        int id = ce.ptIds[k];
+        ids[k] = ( id < 0 ? id - centroidOffset :
+                 ( id >= numPrevPts ? edgeIds[ id - numPrevPts ] : id ) );
+        }
+      centroid_list.AddPoint( ce.nPts, ids );
+      }
+    }
+
+  for ( i = 0; i < nshapes; i ++ )
+    {
+    int shapesize = shapes[i]->GetShapeSize();
+    nLists = piece.shapes[i]->GetNumberOfLists();
+    for ( j = 0; j < nLists; j ++ )
+      {
+      const int * list;
+      int listSize = piece.shapes[i]->GetList( j, list );
+      for ( k = 0; k < listSize; k ++ )
+        {
+        for ( l = 0; l < shapesize; l ++ )
+          {
+          int id = list[ l + 1 ];
+          ids[l] = ( id < 0 ? id - centroidOffset :
+                   ( id >= numPrevPts ? edgeIds[ id - numPrevPts ] : id ) );
+          }
+        shapes[i]->AddShape( list[0], ids );
+        list += shapesize + 1;
+        }
+      }
+    }
+}
+
 inline void GetPoint( double * pt, const double * X, const double * Y,
                       const double * Z, const int * dims, const int & index )
 {
@@ -1597,400 +1716,262 @@ inline void GetPoint( double * pt, const double * X, const double * Y,
 // ============================================================================
 
 
-//-----------------------------------------------------------------------------
-// Construct with user-specified implicit function; InsideOut turned off; value
-// set to 0.0; and generate clip scalars turned off.
-vtkTableBasedClipDataSet::vtkTableBasedClipDataSet( vtkImplicitFunction * cf )
-{
-  this->Locator      = NULL;
-  this->ClipFunction = cf;
+// ============================================================================
+// ================= vtkTableBasedClipperCellClipper (begin) ==================
+// ============================================================================
 
-  // setup a callback to report progress
-  this->InternalProgressObserver = vtkCallbackCommand::New();
-  this->InternalProgressObserver->SetCallback
-        ( &vtkTableBasedClipDataSet::InternalProgressCallbackFunction );
-  this->InternalProgressObserver->SetClientData( this );
 
-  this->Value     = 0.0;
-  this->InsideOut = 0;
-  this->MergeTolerance        = 0.01;
-  this->UseValueAsOffset      = true;
-  this->GenerateClipScalars   = 0;
-  this->GenerateClippedOutput = 0;
+// Inputs with fewer cells than this are clipped as a single piece.
+#define MIN_CELLS_PER_PIECE 16384
 
-  this->OutputPointsPrecision = DEFAULT_PRECISION;
+// ---- vtkTableBasedClipperCellClipper (begin)
+// Clips the cells of a dataset into a vtkTableBasedClipperVolumeFromVolume.
+// Large inputs are split into pieces of consecutive cells clipped in
+// parallel, each into a volume of its own, which are then appended in the
+// order of their cells: the output is the same as with a single piece.
+class vtkTableBasedClipperCellClipper
+{
+public:
+  vtkTableBasedClipperCellClipper( vtkTableBasedClipDataSet * self,
+                                   vtkDataArray * clipAray, double isoValue,
+                                   vtkIdType numPnts, vtkIdType numCells );
+  virtual ~vtkTableBasedClipperCellClipper();
 
-  this->SetNumberOfOutputPorts( 2 );
-  vtkUnstructuredGrid * output2 = vtkUnstructuredGrid::New();
-  this->GetExecutive()->SetOutputData( 1, output2 );
-  output2->Delete();
-  output2 = NULL;
+  // Clip all the cells into visItVFV, listing the ids of the cells that
+  // cannot be clipped with the tables in cants, in increasing order.
+  void Execute( vtkTableBasedClipperVolumeFromVolume * visItVFV,
+                std::vector< vtkIdType > & cants );
 
-  // process active point scalars by default
-  this->SetInputArrayToProcess
-        ( 0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS,
-          vtkDataSetAttributes::SCALARS );
-}
+  // Clip the pieces [begin, end), for vtkSMPTools.
+  void operator () ( vtkIdType begin, vtkIdType end );
 
-//-----------------------------------------------------------------------------
-vtkTableBasedClipDataSet::~vtkTableBasedClipDataSet()
+protected:
+  // Clip the cells [begin, end) into visItVFV.
+  virtual void ClipCells( vtkIdType begin, vtkIdType end,
+                          vtkTableBasedClipperVolumeFromVolume * visItVFV,
+                          std::vector< vtkIdType > & cants ) = 0;
+
+  vtkTableBasedClipDataSet * Self;
+  vtkDataArray * ClipAray;
+  double         IsoValue;
+  int            InsideOut;
+  int            OutputPointsPrecision;
+  vtkIdType      NumberOfPoints;
+  vtkIdType      NumberOfCells;
+  vtkIdType      PieceSize;
+
+  std::vector< vtkTableBasedClipperVolumeFromVolume * > Pieces;
+  std::vector< std::vector< vtkIdType > > PieceCants;
+
+private:
+  vtkTableBasedClipperCellClipper
+    ( const vtkTableBasedClipperCellClipper & ); // Not implemented.
+  void operator = ( const vtkTableBasedClipperCellClipper & ); // Not implemented.
+};
+// ---- vtkTableBasedClipperCellClipper (end)
+
+
+class vtkTableBasedClipperPolyDataClipper :
+      public vtkTableBasedClipperCellClipper
 {
-  if ( this->Locator )
-    {
-    this->Locator->UnRegister( this );
-    this->Locator = NULL;
-    }
-  this->SetClipFunction( NULL );
-  this->InternalProgressObserver->Delete();
-  this->InternalProgressObserver = NULL;
-}
+public:
+  vtkTableBasedClipperPolyDataClipper( vtkTableBasedClipDataSet * self,
+                                       vtkPolyData * polyData,
+                                       vtkDataArray * clipAray,
+                                       double isoValue );
 
-//-----------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::InternalProgressCallbackFunction
-   ( vtkObject * arg, unsigned long, void * clientdata, void * )
+protected:
+  virtual void ClipCells( vtkIdType begin, vtkIdType end,
+                          vtkTableBasedClipperVolumeFromVolume * visItVFV,
+                          std::vector< vtkIdType > & cants );
+
+  vtkPolyData * PolyData;
+};
+
+
+class vtkTableBasedClipperRectilinearGridClipper :
+      public vtkTableBasedClipperCellClipper
 {
-  reinterpret_cast < vtkTableBasedClipDataSet * > ( clientdata )
-    ->InternalProgressCallback(  static_cast < vtkAlgorithm * > ( arg )  );
-}
+public:
+  vtkTableBasedClipperRectilinearGridClipper( vtkTableBasedClipDataSet * self,
+                                              vtkRectilinearGrid * rectGrid,
+                                              vtkDataArray * clipAray,
+                                              double isoValue );
 
-//-----------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::InternalProgressCallback
-   ( vtkAlgorithm * algorithm )
+protected:
+  virtual void ClipCells( vtkIdType begin, vtkIdType end,
+                          vtkTableBasedClipperVolumeFromVolume * visItVFV,
+                          std::vector< vtkIdType > & cants );
+
+  vtkRectilinearGrid * RectGrid;
+};
+
+
+class vtkTableBasedClipperStructuredGridClipper :
+      public vtkTableBasedClipperCellClipper
 {
-  double progress = algorithm->GetProgress();
-  this->UpdateProgress( progress );
+public:
+  vtkTableBasedClipperStructuredGridClipper( vtkTableBasedClipDataSet * self,
+                                             vtkStructuredGrid * strcGrid,
+                                             vtkDataArray * clipAray,
+                                             double isoValue );
 
-  if ( this->AbortExecute )
-    {
-    algorithm->SetAbortExecute( 1 );
-    }
-}
+protected:
+  virtual void ClipCells( vtkIdType begin, vtkIdType end,
+                          vtkTableBasedClipperVolumeFromVolume * visItVFV,
+                          std::vector< vtkIdType > & cants );
 
-//-----------------------------------------------------------------------------
-unsigned long vtkTableBasedClipDataSet::GetMTime()
+  vtkStructuredGrid * StrcGrid;
+};
+
+
+class vtkTableBasedClipperUnstructuredGridClipper :
+      public vtkTableBasedClipperCellClipper
 {
-  unsigned long time;
-  unsigned long mTime = this->Superclass::GetMTime();
+public:
+  vtkTableBasedClipperUnstructuredGridClipper( vtkTableBasedClipDataSet * self,
+                                               vtkUnstructuredGrid * unstruct,
+                                               vtkDataArray * clipAray,
+                                               double isoValue );
 
-  if ( this->ClipFunction != NULL )
-    {
-    time  = this->ClipFunction->GetMTime();
-    mTime = ( time > mTime ? time : mTime );
-    }
+protected:
+  virtual void ClipCells( vtkIdType begin, vtkIdType end,
+                          vtkTableBasedClipperVolumeFromVolume * visItVFV,
+                          std::vector< vtkIdType > & cants );
 
-  if ( this->Locator != NULL )
-    {
-    time  = this->Locator->GetMTime();
-    mTime = ( time > mTime ? time : mTime );
-    }
+  vtkUnstructuredGrid * Unstruct;
+};
 
-  return mTime;
+vtkTableBasedClipperCellClipper::vtkTableBasedClipperCellClipper
+  ( vtkTableBasedClipDataSet * self, vtkDataArray * clipAray, double isoValue,
+    vtkIdType numPnts, vtkIdType numCells )
+{
+  Self                  = self;
+  ClipAray              = clipAray;
+  IsoValue              = isoValue;
+  InsideOut             = self->GetInsideOut();
+  OutputPointsPrecision = self->GetOutputPointsPrecision();
+  NumberOfPoints        = numPnts;
+  NumberOfCells         = numCells;
+  PieceSize             = numCells;
 }
 
-vtkUnstructuredGrid *vtkTableBasedClipDataSet::GetClippedOutput()
+vtkTableBasedClipperCellClipper::~vtkTableBasedClipperCellClipper()
 {
-  if ( !this->GenerateClippedOutput )
+  for ( size_t i = 0; i < Pieces.size(); i ++ )
     {
-    return NULL;
+    delete Pieces[i];
     }
-
-  return vtkUnstructuredGrid::SafeDownCast
-        (  this->GetExecutive()->GetOutputData( 1 )  );
 }
 
-//-----------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::SetLocator
-   ( vtkIncrementalPointLocator * locator )
+void vtkTableBasedClipperCellClipper::Execute
+  ( vtkTableBasedClipperVolumeFromVolume * visItVFV,
+    std::vector< vtkIdType > & cants )
 {
-  if ( this->Locator == locator)
+  // A few pieces per thread balance the cells that are not clipped with the
+  // cells that are.
+  vtkIdType numPieces = std::min
+    (  static_cast< vtkIdType >( 4 * vtkSMPTools::GetEstimatedNumberOfThreads() ),
+       NumberOfCells / MIN_CELLS_PER_PIECE  );
+  if ( numPieces < 2 )
     {
+    this->ClipCells( 0, NumberOfCells, visItVFV, cants );
     return;
     }
 
-  if ( this->Locator )
+  PieceSize = ( NumberOfCells + numPieces - 1 ) / numPieces;
+  numPieces = ( NumberOfCells + PieceSize - 1 ) / PieceSize;
+  Pieces.resize( numPieces, NULL );
+  PieceCants.resize( numPieces );
+  vtkSMPTools::For( 0, numPieces, 1, *this );
+
+  // The pieces are merged serially, see Append().
+  for ( vtkIdType i = 0; i < numPieces; i ++ )
     {
-    this->Locator->UnRegister( this );
-    this->Locator = NULL;
+    visItVFV->Append( *Pieces[i] );
+    delete Pieces[i];
+    Pieces[i] = NULL;
+    cants.insert( cants.end(), PieceCants[i].begin(), PieceCants[i].end() );
     }
+}
 
-  if ( locator )
+void vtkTableBasedClipperCellClipper::operator () ( vtkIdType begin,
+                                                    vtkIdType end )
+{
+  for ( vtkIdType i = begin; i < end; i ++ )
     {
-    locator->Register( this );
+    vtkIdType firstCell = i * PieceSize;
+    vtkIdType lastCell  = std::min( firstCell + PieceSize, NumberOfCells );
+    Pieces[i] = new vtkTableBasedClipperVolumeFromVolume
+      ( OutputPointsPrecision, NumberOfPoints,
+        int(  pow(  double( lastCell - firstCell ), double( 0.6667f )  )  )
+        * 5 + 100 );
+    this->ClipCells( firstCell, lastCell, Pieces[i], PieceCants[i] );
     }
-
-  this->Locator = locator;
-  this->Modified();
 }
 
-//-----------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::CreateDefaultLocator()
+vtkTableBasedClipperPolyDataClipper::vtkTableBasedClipperPolyDataClipper
+  ( vtkTableBasedClipDataSet * self, vtkPolyData * polyData,
+    vtkDataArray * clipAray, double isoValue )
+  : vtkTableBasedClipperCellClipper( self, clipAray, isoValue,
+                                     polyData->GetNumberOfPoints(),
+                                     polyData->GetNumberOfCells() )
 {
-  if ( this->Locator == NULL )
+  PolyData = polyData;
+
+  // The cells are built on demand, which the threads must not do.
+  if ( PolyData->GetNumberOfCells() > 0 )
     {
-    this->Locator = vtkMergePoints::New();
-    this->Locator->Register( this );
-    this->Locator->Delete();
+    PolyData->GetCellType( 0 );
     }
 }
 
-//-----------------------------------------------------------------------------
-int vtkTableBasedClipDataSet::FillInputPortInformation
-  ( int, vtkInformation * info )
+vtkTableBasedClipperRectilinearGridClipper::
+vtkTableBasedClipperRectilinearGridClipper
+  ( vtkTableBasedClipDataSet * self, vtkRectilinearGrid * rectGrid,
+    vtkDataArray * clipAray, double isoValue )
+  : vtkTableBasedClipperCellClipper( self, clipAray, isoValue,
+                                     rectGrid->GetNumberOfPoints(),
+                                     rectGrid->GetNumberOfCells() )
 {
-  info->Set( vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet" );
-  return 1;
+  RectGrid = rectGrid;
 }
 
-//-----------------------------------------------------------------------------
-int vtkTableBasedClipDataSet::RequestData( vtkInformation * vtkNotUsed( request ),
-    vtkInformationVector ** inputVector, vtkInformationVector * outputVector )
+vtkTableBasedClipperStructuredGridClipper::
+vtkTableBasedClipperStructuredGridClipper
+  ( vtkTableBasedClipDataSet * self, vtkStructuredGrid * strcGrid,
+    vtkDataArray * clipAray, double isoValue )
+  : vtkTableBasedClipperCellClipper( self, clipAray, isoValue,
+                                     strcGrid->GetNumberOfPoints(),
+                                     strcGrid->GetNumberOfCells() )
 {
-  // input and output information objects
-  vtkInformation * inputInf = inputVector[0]->GetInformationObject( 0 );
-  vtkInformation * outInfor = outputVector->GetInformationObject( 0 );
-
-  // Get the input of which we have to create a copy since the clipper requires
-  // that InterpolateAllocate() be invoked for the output based on its input in
-  // terms of the point data. If the input and output arrays are different,
-  // vtkCell3D's Clip will fail. The last argument of InterpolateAllocate makes
-  // sure that arrays are shallow-copied from theInput to cpyInput.
-  vtkDataSet * theInput = vtkDataSet::SafeDownCast
-                          (  inputInf->Get( vtkDataObject::DATA_OBJECT() )  );
-  vtkSmartPointer< vtkDataSet > cpyInput;
-  cpyInput.TakeReference( theInput->NewInstance() );
-  cpyInput->CopyStructure( theInput  );
-  cpyInput->GetCellData()->PassData( theInput->GetCellData() );
-  cpyInput->GetPointData()
-          ->InterpolateAllocate( theInput->GetPointData(), 0, 0, 1 );
-
-  // get the output (the remaining and the clipped parts)
-  vtkUnstructuredGrid * outputUG = vtkUnstructuredGrid::SafeDownCast
-                        (  outInfor->Get( vtkDataObject::DATA_OBJECT() )  );
-
-  inputInf = NULL;
-  outInfor = NULL;
-  theInput = NULL;
-  vtkDebugMacro( << "Clipping dataset" << endl );
+  StrcGrid = strcGrid;
+}
 
+vtkTableBasedClipperUnstructuredGridClipper::
+vtkTableBasedClipperUnstructuredGridClipper
+  ( vtkTableBasedClipDataSet * self, vtkUnstructuredGrid * unstruct,
+    vtkDataArray * clipAray, double isoValue )
+  : vtkTableBasedClipperCellClipper( self, clipAray, isoValue,
+                                     unstruct->GetNumberOfPoints(),
+                                     unstruct->GetNumberOfCells() )
+{
+  Unstruct = unstruct;
+}
 
-  int  i;
-  vtkIdType  numbPnts = cpyInput->GetNumberOfPoints();
+void vtkTableBasedClipperPolyDataClipper::ClipCells
+  ( vtkIdType begin, vtkIdType end,
+    vtkTableBasedClipperVolumeFromVolume * visItVFV,
+    std::vector< vtkIdType > & cants )
+{
+  vtkPolyData  * polyData = PolyData;
+  vtkDataArray * clipAray = ClipAray;
+  double         isoValue = IsoValue;
 
-  // handling exceptions
-  if ( numbPnts < 1 )
-    {
-    vtkDebugMacro( << "No data to clip" << endl );
-    outputUG = NULL;
-    return 1;
-    }
+  vtkIdType   i, j;
+  vtkIdType   numbPnts = 0;
 
-  if ( !this->ClipFunction && this->GenerateClipScalars )
-    {
-    vtkErrorMacro( << "Cannot generate clip scalars "
-                   << "if no clip function defined" << endl );
-    outputUG = NULL;
-    return 1;
-    }
-
-
-  vtkDataArray   * clipAray = NULL;
-  vtkDoubleArray * pScalars = NULL;
-
-  // check whether the cells are clipped with input scalars or a clip function
-  if ( this->ClipFunction )
-    {
-    pScalars = vtkDoubleArray::New();
-    pScalars->SetNumberOfTuples( numbPnts );
-    pScalars->SetName( "ClipDataSetScalars" );
-
-    // enable clipDataSetScalars to be passed to the output
-    if ( this->GenerateClipScalars )
-      {
-      cpyInput->GetPointData()->SetScalars( pScalars );
-      }
-
-    for ( i = 0; i < numbPnts; i ++ )
-      {
-      double s = this->ClipFunction->FunctionValue(  cpyInput->GetPoint( i )  );
-      pScalars->SetTuple1( i, s );
-      }
-
-    clipAray = pScalars;
-    }
-  else //using input scalars
-    {
-    clipAray = this->GetInputArrayToProcess( 0, inputVector );
-    if ( !clipAray )
-      {
-      vtkErrorMacro( << "no input scalars." << endl );
-      return 1;
-      }
-    }
-
-
-  int    gridType = cpyInput->GetDataObjectType();
-  double isoValue = ( !this->ClipFunction || this->UseValueAsOffset )
-                    ?  this->Value  :  0.0;
-  if ( gridType == VTK_IMAGE_DATA || gridType == VTK_STRUCTURED_POINTS )
-    {
-    int   numbDims;
-    int * dataDims = vtkImageData::SafeDownCast( cpyInput )->GetDimensions();
-    for ( numbDims = 3, i = 0; i < 3; i ++ )
-      {
-      numbDims -= (  ( dataDims[i] <= 1 ) ? 1 : 0  );
-      }
-    dataDims = NULL;
-
-    if ( numbDims == 3 )
-      {
-      this->ClipImageData( cpyInput.GetPointer(), clipAray, isoValue, outputUG );
-      }
-    }
-  else
-  if ( gridType == VTK_POLY_DATA )
-    {
-    this->ClipPolyData( cpyInput.GetPointer(), clipAray, isoValue, outputUG );
-    }
-  else
-  if ( gridType == VTK_RECTILINEAR_GRID )
-    {
-    this->ClipRectilinearGridData( cpyInput.GetPointer(), clipAray,
-                                   isoValue, outputUG );
-    }
-  else
-  if ( gridType == VTK_STRUCTURED_GRID )
-    {
-    this->ClipStructuredGridData( cpyInput.GetPointer(), clipAray,
-                                  isoValue, outputUG );
-    }
-  else
-  if ( gridType == VTK_UNSTRUCTURED_GRID )
-    {
-    this->ClipUnstructuredGridData( cpyInput.GetPointer(), clipAray,
-                                    isoValue, outputUG );
-    }
-  else
-    {
-    this->ClipDataSet( cpyInput.GetPointer(), clipAray, outputUG );
-    }
-
-  outputUG->Squeeze();
-
-  if ( pScalars )
-    {
-    pScalars->Delete();
-    }
-  pScalars = NULL;
-  outputUG = NULL;
-  clipAray = NULL;
-
-  return 1;
-}
-
-//-----------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipDataSet( vtkDataSet * pDataSet,
-     vtkDataArray * clipAray, vtkUnstructuredGrid * unstruct )
-{
-  vtkClipDataSet * clipData = vtkClipDataSet::New();
-  clipData->SetInputData( pDataSet );
-  clipData->SetValue( this->Value );
-  clipData->SetInsideOut( this->InsideOut );
-  clipData->SetClipFunction( this->ClipFunction );
-  clipData->SetUseValueAsOffset( this->UseValueAsOffset );
-  clipData->SetGenerateClipScalars( this->GenerateClipScalars );
-
-  if ( !this->ClipFunction )
-    {
-    pDataSet->GetPointData()->SetScalars( clipAray );
-    }
-
-  clipData->Update();
-  unstruct->ShallowCopy( clipData->GetOutput() );
-
-  clipData->Delete();
-  clipData = NULL;
-}
-
-//-----------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipImageData( vtkDataSet * inputGrd,
-     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
-{
-  int                  i, j;
-  int                  dataDims[3];
-  double               spacings[3];
-  double               tmpValue = 0.0;
-  double             * dataBBox = NULL;
-  vtkImageData       * volImage = NULL;
-  vtkDoubleArray     * pxCoords = NULL;
-  vtkDoubleArray     * pyCoords = NULL;
-  vtkDoubleArray     * pzCoords = NULL;
-  vtkRectilinearGrid * rectGrid = NULL;
-
-  volImage = vtkImageData::SafeDownCast( inputGrd );
-  volImage->GetDimensions( dataDims );
-  volImage->GetSpacing( spacings );
-  dataBBox = volImage->GetBounds();
-
-  pxCoords = vtkDoubleArray::New();
-  pyCoords = vtkDoubleArray::New();
-  pzCoords = vtkDoubleArray::New();
-  vtkDoubleArray * tmpArays[3] = { pxCoords, pyCoords, pzCoords };
-  for ( j = 0; j < 3; j ++ )
-    {
-    tmpArays[j]->SetNumberOfComponents( 1 );
-    tmpArays[j]->SetNumberOfTuples( dataDims[j] );
-    for ( tmpValue  = dataBBox[ j << 1 ], i = 0; i < dataDims[j]; i ++,
-          tmpValue += spacings[j] )
-      {
-      tmpArays[j]->SetComponent( i, 0, tmpValue );
-      }
-    tmpArays[j] = NULL;
-    }
-
-  rectGrid = vtkRectilinearGrid::New();
-  rectGrid->SetDimensions( dataDims );
-  rectGrid->SetXCoordinates( pxCoords );
-  rectGrid->SetYCoordinates( pyCoords );
-  rectGrid->SetZCoordinates( pzCoords );
-  rectGrid->GetPointData()->ShallowCopy( volImage->GetPointData() );
-  rectGrid->GetCellData()->ShallowCopy( volImage->GetCellData() );
-
-  this->ClipRectilinearGridData( rectGrid, clipAray, isoValue, outputUG );
-
-  pxCoords->Delete();
-  pyCoords->Delete();
-  pzCoords->Delete();
-  rectGrid->Delete();
-  pxCoords = NULL;
-  pyCoords = NULL;
-  pzCoords = NULL;
-  rectGrid = NULL;
-  volImage = NULL;
-  dataBBox = NULL;
-}
-
-//-----------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipPolyData( vtkDataSet * inputGrd,
-     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
-{
-  vtkPolyData * polyData = vtkPolyData::SafeDownCast( inputGrd );
-  int           numCells = polyData->GetNumberOfCells();
-
-  vtkTableBasedClipperVolumeFromVolume   * visItVFV = new
-  vtkTableBasedClipperVolumeFromVolume(
-     this->OutputPointsPrecision, polyData->GetNumberOfPoints(),
-     int(   pow(  double( numCells ),  double( 0.6667f )  )   ) * 5 + 100    );
-
-  vtkUnstructuredGrid * specials = vtkUnstructuredGrid::New();
-  specials->SetPoints( polyData->GetPoints() );
-  specials->GetPointData()->ShallowCopy( polyData->GetPointData() );
-  specials->Allocate( numCells );
-
-  vtkIdType   i, j;
-  vtkIdType   numbPnts = 0;
-  int         numCants = 0;  // number of cells not clipped by this filter
-
-  for ( i = 0; i < numCells; i ++ )
+  for ( i = begin; i < end; i ++ )
     {
     int         cellType = polyData->GetCellType( i );
     bool        bCanClip = false;
@@ -2155,8 +2136,9 @@ void vtkTableBasedClipDataSet::ClipPolyData( vtkDataSet * inputGrd,
             break;
 
           default:
-            vtkErrorMacro( << "An invalid output shape was found in "
-                           << "the ClipCases." << endl );
+            vtkErrorWithObjectMacro( this->Self,
+                                     << "An invalid output shape was found in "
+                                     << "the ClipCases." << endl );
           }
 
         if ( (!this->InsideOut && theColor == COLOR0 ) ||
@@ -2204,8 +2186,9 @@ void vtkTableBasedClipDataSet::ClipPolyData( vtkDataSet * inputGrd,
             }
           else
             {
-            vtkErrorMacro( << "An invalid output point value "
-                           << "was found in the ClipCases." << endl );
+            vtkErrorWithObjectMacro( this->Self,
+                                     << "An invalid output point value "
+                                     << "was found in the ClipCases." << endl );
             }
           }
 
@@ -2260,120 +2243,47 @@ void vtkTableBasedClipDataSet::ClipPolyData( vtkDataSet * inputGrd,
       }
     else
       {
-      if ( numCants == 0 )
-        {
-        specials->GetCellData()
-                ->CopyAllocate( polyData->GetCellData(), numCells );
-        }
-
-      specials->InsertNextCell( cellType, numbPnts, pntIndxs );
-      specials->GetCellData()
-              ->CopyData( polyData->GetCellData(), i, numCants );
-      numCants ++;
+      cants.push_back( i );
       }
 
     pntIndxs = NULL;
     }
+}
 
+void vtkTableBasedClipperRectilinearGridClipper::ClipCells
+  ( vtkIdType begin, vtkIdType end,
+    vtkTableBasedClipperVolumeFromVolume * visItVFV,
+    std::vector< vtkIdType > & vtkNotUsed( cants ) )
+{
+  vtkDataArray * clipAray = ClipAray;
+  double         isoValue = IsoValue;
 
-  int         toDelete = 0;
-  double    * theCords = NULL;
-  vtkPoints * inputPts = polyData->GetPoints();
-  if ( inputPts->GetDataType() == VTK_DOUBLE )
-    {
-    theCords = static_cast < double * > (  inputPts->GetVoidPointer( 0 )  );
-    }
-  else
-    {
-    toDelete = 1;
-    numbPnts = inputPts->GetNumberOfPoints();
-    theCords = new double [ numbPnts * 3 ];
-    for ( i = 0; i < numbPnts; i ++ )
-      {
-      inputPts->GetPoint( i, theCords + ( i << 1 ) + i );
-      }
-    }
-  inputPts = NULL;
+  vtkIdType i;
+  int   j;
+  int   isTwoDim = 0;
+  int   rectDims[3];
+  RectGrid->GetDimensions( rectDims );
+  isTwoDim = int( rectDims[2] <= 1 );
 
+  int   shiftLUT[3][8] = {
+                           { 0, 1, 1, 0, 0, 1, 1, 0 },
+                           { 0, 0, 1, 1, 0, 0, 1, 1 },
+                           { 0, 0, 0, 0, 1, 1, 1, 1 }
+                         };
+  int   cellDims[3] = { rectDims[0] - 1, rectDims[1] - 1, rectDims[2] - 1 };
+  int   cyStride    = cellDims[0];
+  int   czStride    = cellDims[0] * cellDims[1];
+  int   pyStride    = rectDims[0];
+  int   pzStride    = rectDims[0] * rectDims[1];
 
-  if ( numCants > 0 )
+  for ( i = begin; i < end; i ++ )
     {
-    vtkUnstructuredGrid * vtkUGrid  = vtkUnstructuredGrid::New();
-    this->ClipDataSet( specials, clipAray, vtkUGrid );
-
-    vtkUnstructuredGrid * visItGrd = vtkUnstructuredGrid::New();
-    visItVFV->ConstructDataSet( polyData, visItGrd, theCords );
-
-    vtkAppendFilter * appender = vtkAppendFilter::New();
-    appender->AddInputData( vtkUGrid );
-    appender->AddInputData( visItGrd );
-    appender->Update();
-
-    outputUG->ShallowCopy( appender->GetOutput() );
-
-    appender->Delete();
-    vtkUGrid->Delete();
-    visItGrd->Delete();
-    appender = NULL;
-    vtkUGrid = NULL;
-    visItGrd = NULL;
-    }
-  else
-    {
-    visItVFV->ConstructDataSet( polyData, outputUG, theCords );
-    }
-
-
-  specials->Delete();
-  delete visItVFV;
-  if ( toDelete )
-    {
-    delete [] theCords;
-    }
-  specials = NULL;
-  visItVFV = NULL;
-  theCords = NULL;
-  polyData = NULL;
-}
-
-//-----------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipRectilinearGridData( vtkDataSet * inputGrd,
-     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
-{
-  vtkRectilinearGrid * rectGrid = vtkRectilinearGrid::SafeDownCast( inputGrd );
-
-  int   i, j;
-  int   numCells = 0;
-  int   isTwoDim = 0;
-  int   rectDims[3];
-  rectGrid->GetDimensions( rectDims );
-  isTwoDim = int( rectDims[2] <= 1 );
-  numCells = rectGrid->GetNumberOfCells();
-
-  vtkTableBasedClipperVolumeFromVolume   * visItVFV = new
-  vtkTableBasedClipperVolumeFromVolume(
-      this->OutputPointsPrecision, rectGrid->GetNumberOfPoints(),
-      int(   pow(  double( numCells ), double( 0.6667f )  )   ) * 5 + 100    );
-
-  int   shiftLUT[3][8] = {
-                           { 0, 1, 1, 0, 0, 1, 1, 0 },
-                           { 0, 0, 1, 1, 0, 0, 1, 1 },
-                           { 0, 0, 0, 0, 1, 1, 1, 1 }
-                         };
-  int   cellDims[3] = { rectDims[0] - 1, rectDims[1] - 1, rectDims[2] - 1 };
-  int   cyStride    = cellDims[0];
-  int   czStride    = cellDims[0] * cellDims[1];
-  int   pyStride    = rectDims[0];
-  int   pzStride    = rectDims[0] * rectDims[1];
-
-  for ( i = 0; i < numCells; i ++ )
-    {
-    int    caseIndx = 0;
-    int    nCellPts = isTwoDim ? 4 : 8;
-    int    theCellI =   i % cellDims[0];
-    int    theCellJ = ( i / cyStride ) % cellDims[1];
-    int    theCellK = ( i / czStride );
-    double grdDiffs[8];
+    int    caseIndx = 0;
+    int    nCellPts = isTwoDim ? 4 : 8;
+    int    theCellI =   i % cellDims[0];
+    int    theCellJ = ( i / cyStride ) % cellDims[1];
+    int    theCellK = ( i / czStride );
+    double grdDiffs[8];
 
     for ( j = nCellPts - 1; j >= 0; j -- )
       {
@@ -2459,8 +2369,9 @@ void vtkTableBasedClipDataSet::ClipRectilinearGridData( vtkDataSet * inputGrd,
           break;
 
         default:
-          vtkErrorMacro( << "An invalid output shape was found in "
-                         << "the ClipCases." << endl );
+          vtkErrorWithObjectMacro( this->Self,
+                                   << "An invalid output shape was found in "
+                                   << "the ClipCases." << endl );
         }
 
       if ( (!this->InsideOut && theColor == COLOR0 ) ||
@@ -2552,8 +2463,9 @@ void vtkTableBasedClipDataSet::ClipRectilinearGridData( vtkDataSet * inputGrd,
           }
         else
           {
-          vtkErrorMacro( << "An invalid output point value "
-                         << "was found in the ClipCases." << endl );
+          vtkErrorWithObjectMacro( this->Self,
+                                   << "An invalid output point value "
+                                   << "was found in the ClipCases." << endl );
           }
         }
 
@@ -2606,92 +2518,36 @@ void vtkTableBasedClipDataSet::ClipRectilinearGridData( vtkDataSet * inputGrd,
 
     thisCase = NULL;
     }
-
-
-  int            toDelete    = 0;
-  double       * theCords[3] = { NULL, NULL, NULL };
-  vtkDataArray * theArays[3] = { NULL, NULL, NULL };
-
-  if ( rectGrid->GetXCoordinates()->GetDataType() == VTK_DOUBLE &&
-       rectGrid->GetYCoordinates()->GetDataType() == VTK_DOUBLE &&
-       rectGrid->GetZCoordinates()->GetDataType() == VTK_DOUBLE
-     )
-    {
-    theCords[0] = static_cast < double * >
-                  (  rectGrid->GetXCoordinates()->GetVoidPointer( 0 )  );
-    theCords[1] = static_cast < double * >
-                  (  rectGrid->GetYCoordinates()->GetVoidPointer( 0 )  );
-    theCords[2] = static_cast < double * >
-                  (  rectGrid->GetZCoordinates()->GetVoidPointer( 0 )  );
-    }
-  else
-    {
-    toDelete    = 1;
-    theArays[0] = rectGrid->GetXCoordinates();
-    theArays[1] = rectGrid->GetYCoordinates();
-    theArays[2] = rectGrid->GetZCoordinates();
-    for ( j = 0; j < 3; j ++ )
-      {
-      theCords[j] = new double [ rectDims[j] ];
-      for ( i = 0; i < rectDims[j]; i ++ )
-        {
-        theCords[j][i] = theArays[j]->GetComponent( i, 0 );
-        }
-      theArays[j] = NULL;
-      }
-    }
-
-  visItVFV->ConstructDataSet
-            ( rectGrid,
-              outputUG, rectDims, theCords[0], theCords[1], theCords[2] );
-
-  delete visItVFV;
-  visItVFV = NULL;
-  rectGrid = NULL;
-
-  for ( i = 0; i < 3; i ++ )
-    {
-    if ( toDelete )
-      {
-      delete [] theCords[i];
-      }
-    theCords[i] = NULL;
-    }
 }
 
-//-----------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipStructuredGridData( vtkDataSet * inputGrd,
-     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
+void vtkTableBasedClipperStructuredGridClipper::ClipCells
+  ( vtkIdType begin, vtkIdType end,
+    vtkTableBasedClipperVolumeFromVolume * visItVFV,
+    std::vector< vtkIdType > & vtkNotUsed( cants ) )
 {
-  vtkStructuredGrid * strcGrid = vtkStructuredGrid::SafeDownCast( inputGrd );
+  vtkDataArray * clipAray = ClipAray;
+  double         isoValue = IsoValue;
 
-  int   i, j;
+  vtkIdType i;
+  int   j;
   int   isTwoDim    = 0;
-  int   numCells    = 0;
+  int   numbPnts    = 0;
   int   gridDims[3] = { 0, 0, 0 };
-  strcGrid->GetDimensions( gridDims );
+  StrcGrid->GetDimensions( gridDims );
   isTwoDim = int( gridDims[2] <= 1 );
-  numCells = strcGrid->GetNumberOfCells();
-
-  vtkTableBasedClipperVolumeFromVolume  *  visItVFV = new
-  vtkTableBasedClipperVolumeFromVolume(
-      this->OutputPointsPrecision, strcGrid->GetNumberOfPoints(),
-      int(   pow(  double( numCells ), double( 0.6667f )  )   ) * 5 + 100    );
-
 
   int   shiftLUT[3][8] = {
                            { 0, 1, 1, 0, 0, 1, 1, 0 },
                            { 0, 0, 1, 1, 0, 0, 1, 1 },
                            { 0, 0, 0, 0, 1, 1, 1, 1 }
                          };
-  int   numbPnts    = 0;
   int   cellDims[3] = { gridDims[0] - 1, gridDims[1] - 1, gridDims[2] - 1 };
   int   cyStride    = cellDims[0];
   int   czStride    = cellDims[0] * cellDims[1];
   int   pyStride    = gridDims[0];
   int   pzStride    = gridDims[0] * gridDims[1];
 
-  for ( i = 0; i < numCells; i ++ )
+  for ( i = begin; i < end; i ++ )
     {
     int    caseIndx = 0;
     int    theCellI = i % cellDims[0];
@@ -2785,8 +2641,9 @@ void vtkTableBasedClipDataSet::ClipStructuredGridData( vtkDataSet * inputGrd,
           break;
 
         default:
-          vtkErrorMacro( << "An invalid output shape was found in "
-                         << "the ClipCases." << endl );
+          vtkErrorWithObjectMacro( this->Self,
+                                   << "An invalid output shape was found in "
+                                   << "the ClipCases." << endl );
         }
 
       if ( (!this->InsideOut && theColor == COLOR0 ) ||
@@ -2853,8 +2710,9 @@ void vtkTableBasedClipDataSet::ClipStructuredGridData( vtkDataSet * inputGrd,
           }
         else
           {
-          vtkErrorMacro( << "An invalid output point value "
-                         << "was found in the ClipCases." << endl );
+          vtkErrorWithObjectMacro( this->Self,
+                                   << "An invalid output point value "
+                                   << "was found in the ClipCases." << endl );
           }
         }
 
@@ -2907,63 +2765,21 @@ void vtkTableBasedClipDataSet::ClipStructuredGridData( vtkDataSet * inputGrd,
 
     thisCase = NULL;
     }
-
-  int         toDelete = 0;
-  double    * theCords = NULL;
-  vtkPoints * inputPts = strcGrid->GetPoints();
-  if ( inputPts->GetDataType() == VTK_DOUBLE )
-    {
-    theCords = static_cast < double * > (  inputPts->GetVoidPointer( 0 )  );
-    }
-  else
-    {
-    toDelete = 1;
-    numbPnts = inputPts->GetNumberOfPoints();
-    theCords = new double [ numbPnts * 3 ];
-    for ( i = 0; i < numbPnts; i ++ )
-      {
-      inputPts->GetPoint( i, theCords + ( i << 1 ) + i );
-      }
-    }
-  inputPts = NULL;
-
-  visItVFV->ConstructDataSet( strcGrid, outputUG, theCords );
-
-
-  delete visItVFV;
-  if ( toDelete )
-    {
-    delete [] theCords;
-    }
-  visItVFV = NULL;
-  theCords = NULL;
-  strcGrid = NULL;
 }
 
-//-----------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
-     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
+void vtkTableBasedClipperUnstructuredGridClipper::ClipCells
+  ( vtkIdType begin, vtkIdType end,
+    vtkTableBasedClipperVolumeFromVolume * visItVFV,
+    std::vector< vtkIdType > & cants )
 {
-  vtkUnstructuredGrid * unstruct = vtkUnstructuredGrid::SafeDownCast( inputGrd );
+  vtkUnstructuredGrid * unstruct = Unstruct;
+  vtkDataArray        * clipAray = ClipAray;
+  double                isoValue = IsoValue;
 
   vtkIdType   i, j;
   vtkIdType   numbPnts = 0;
-  int         numCants = 0; // number of cells not clipped by this filter
-  int         numCells = unstruct->GetNumberOfCells();
-
-  // volume from volume
-  vtkTableBasedClipperVolumeFromVolume   * visItVFV = new
-  vtkTableBasedClipperVolumeFromVolume(
-      this->OutputPointsPrecision, unstruct->GetNumberOfPoints(),
-      int(   pow(  double( numCells ), double( 0.6667f )  )   ) * 5 + 100    );
 
-  // the stuffs that can not be clipped by this filter
-  vtkUnstructuredGrid * specials = vtkUnstructuredGrid::New();
-  specials->SetPoints( unstruct->GetPoints() );
-  specials->GetPointData()->ShallowCopy( unstruct->GetPointData() );
-  specials->Allocate( numCells );
-
-  for ( i = 0; i < numCells; i ++ )
+  for ( i = begin; i < end; i ++ )
     {
     int         cellType = unstruct->GetCellType( i );
     vtkIdType * pntIndxs = NULL;
@@ -3149,8 +2965,9 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
             break;
 
           default:
-            vtkErrorMacro( << "An invalid output shape was found "
-                           << "in the ClipCases." << endl );
+            vtkErrorWithObjectMacro( this->Self,
+                                     << "An invalid output shape was found "
+                                     << "in the ClipCases." << endl );
           }
 
         if ( (!this->InsideOut && theColor == COLOR0 ) ||
@@ -3201,8 +3018,9 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
             }
           else
             {
-            vtkErrorMacro( << "An invalid output point value was found "
-                           << "in the ClipCases." << endl );
+            vtkErrorWithObjectMacro( this->Self,
+                                     << "An invalid output point value was found "
+                                     << "in the ClipCases." << endl );
             }
           }
 
@@ -3256,35 +3074,676 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
       edgeVtxs = NULL;
       thisCase = NULL;
       }
-    else if (cellType == VTK_POLYHEDRON)
-      {
-      if ( numCants == 0 )
-        {
-          specials->GetCellData()
-                  ->CopyAllocate( unstruct->GetCellData(), numCells );
-        }
-      vtkIdType nfaces, *facePtIds;
-      unstruct->GetFaceStream(i, nfaces, facePtIds);
-      specials->InsertNextCell(cellType, nfaces, facePtIds);
-      specials->GetCellData()
-              ->CopyData( unstruct->GetCellData(), i, numCants );
-      numCants ++;
-      }
     else
       {
-      if ( numCants == 0 )
-        {
-          specials->GetCellData()
-                  ->CopyAllocate( unstruct->GetCellData(), numCells );
-        }
-      specials->InsertNextCell( cellType, numbPnts, pntIndxs );
-      specials->GetCellData()
-              ->CopyData( unstruct->GetCellData(), i, numCants );
-      numCants ++;
+      cants.push_back( i );
       }
 
     pntIndxs = NULL;
     }
+}
+// ============================================================================
+// ================== vtkTableBasedClipperCellClipper ( end ) =================
+// ============================================================================
+
+
+//-----------------------------------------------------------------------------
+// Construct with user-specified implicit function; InsideOut turned off; value
+// set to 0.0; and generate clip scalars turned off.
+vtkTableBasedClipDataSet::vtkTableBasedClipDataSet( vtkImplicitFunction * cf )
+{
+  this->Locator      = NULL;
+  this->ClipFunction = cf;
+
+  // setup a callback to report progress
+  this->InternalProgressObserver = vtkCallbackCommand::New();
+  this->InternalProgressObserver->SetCallback
+        ( &vtkTableBasedClipDataSet::InternalProgressCallbackFunction );
+  this->InternalProgressObserver->SetClientData( this );
+
+  this->Value     = 0.0;
+  this->InsideOut = 0;
+  this->MergeTolerance        = 0.01;
+  this->UseValueAsOffset      = true;
+  this->GenerateClipScalars   = 0;
+  this->GenerateClippedOutput = 0;
+
+  this->OutputPointsPrecision = DEFAULT_PRECISION;
+
+  this->SetNumberOfOutputPorts( 2 );
+  vtkUnstructuredGrid * output2 = vtkUnstructuredGrid::New();
+  this->GetExecutive()->SetOutputData( 1, output2 );
+  output2->Delete();
+  output2 = NULL;
+
+  // process active point scalars by default
+  this->SetInputArrayToProcess
+        ( 0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS,
+          vtkDataSetAttributes::SCALARS );
+}
+
+//-----------------------------------------------------------------------------
+vtkTableBasedClipDataSet::~vtkTableBasedClipDataSet()
+{
+  if ( this->Locator )
+    {
+    this->Locator->UnRegister( this );
+    this->Locator = NULL;
+    }
+  this->SetClipFunction( NULL );
+  this->InternalProgressObserver->Delete();
+  this->InternalProgressObserver = NULL;
+}
+
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::InternalProgressCallbackFunction
+   ( vtkObject * arg, unsigned long, void * clientdata, void * )
+{
+  reinterpret_cast < vtkTableBasedClipDataSet * > ( clientdata )
+    ->InternalProgressCallback(  static_cast < vtkAlgorithm * > ( arg )  );
+}
+
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::InternalProgressCallback
+   ( vtkAlgorithm * algorithm )
+{
+  double progress = algorithm->GetProgress();
+  this->UpdateProgress( progress );
+
+  if ( this->AbortExecute )
+    {
+    algorithm->SetAbortExecute( 1 );
+    }
+}
+
+//-----------------------------------------------------------------------------
+unsigned long vtkTableBasedClipDataSet::GetMTime()
+{
+  unsigned long time;
+  unsigned long mTime = this->Superclass::GetMTime();
+
+  if ( this->ClipFunction != NULL )
+    {
+    time  = this->ClipFunction->GetMTime();
+    mTime = ( time > mTime ? time : mTime );
+    }
+
+  if ( this->Locator != NULL )
+    {
+    time  = this->Locator->GetMTime();
+    mTime = ( time > mTime ? time : mTime );
+    }
+
+  return mTime;
+}
+
+vtkUnstructuredGrid *vtkTableBasedClipDataSet::GetClippedOutput()
+{
+  if ( !this->GenerateClippedOutput )
+    {
+    return NULL;
+    }
+
+  return vtkUnstructuredGrid::SafeDownCast
+        (  this->GetExecutive()->GetOutputData( 1 )  );
+}
+
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::SetLocator
+   ( vtkIncrementalPointLocator * locator )
+{
+  if ( this->Locator == locator)
+    {
+    return;
+    }
+
+  if ( this->Locator )
+    {
+    this->Locator->UnRegister( this );
+    this->Locator = NULL;
+    }
+
+  if ( locator )
+    {
+    locator->Register( this );
+    }
+
+  this->Locator = locator;
+  this->Modified();
+}
+
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::CreateDefaultLocator()
+{
+  if ( this->Locator == NULL )
+    {
+    this->Locator = vtkMergePoints::New();
+    this->Locator->Register( this );
+    this->Locator->Delete();
+    }
+}
+
+//-----------------------------------------------------------------------------
+int vtkTableBasedClipDataSet::FillInputPortInformation
+  ( int, vtkInformation * info )
+{
+  info->Set( vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet" );
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int vtkTableBasedClipDataSet::RequestData( vtkInformation * vtkNotUsed( request ),
+    vtkInformationVector ** inputVector, vtkInformationVector * outputVector )
+{
+  // input and output information objects
+  vtkInformation * inputInf = inputVector[0]->GetInformationObject( 0 );
+  vtkInformation * outInfor = outputVector->GetInformationObject( 0 );
+
+  // Get the input of which we have to create a copy since the clipper requires
+  // that InterpolateAllocate() be invoked for the output based on its input in
+  // terms of the point data. If the input and output arrays are different,
+  // vtkCell3D's Clip will fail. The last argument of InterpolateAllocate makes
+  // sure that arrays are shallow-copied from theInput to cpyInput.
+  vtkDataSet * theInput = vtkDataSet::SafeDownCast
+                          (  inputInf->Get( vtkDataObject::DATA_OBJECT() )  );
+  vtkSmartPointer< vtkDataSet > cpyInput;
+  cpyInput.TakeReference( theInput->NewInstance() );
+  cpyInput->CopyStructure( theInput  );
+  cpyInput->GetCellData()->PassData( theInput->GetCellData() );
+  cpyInput->GetPointData()
+          ->InterpolateAllocate( theInput->GetPointData(), 0, 0, 1 );
+
+  // get the output (the remaining and the clipped parts)
+  vtkUnstructuredGrid * outputUG = vtkUnstructuredGrid::SafeDownCast
+                        (  outInfor->Get( vtkDataObject::DATA_OBJECT() )  );
+
+  inputInf = NULL;
+  outInfor = NULL;
+  theInput = NULL;
+  vtkDebugMacro( << "Clipping dataset" << endl );
+
+
+  int  i;
+  vtkIdType  numbPnts = cpyInput->GetNumberOfPoints();
+
+  // handling exceptions
+  if ( numbPnts < 1 )
+    {
+    vtkDebugMacro( << "No data to clip" << endl );
+    outputUG = NULL;
+    return 1;
+    }
+
+  if ( !this->ClipFunction && this->GenerateClipScalars )
+    {
+    vtkErrorMacro( << "Cannot generate clip scalars "
+                   << "if no clip function defined" << endl );
+    outputUG = NULL;
+    return 1;
+    }
+
+
+  vtkDataArray   * clipAray = NULL;
+  vtkDoubleArray * pScalars = NULL;
+
+  // check whether the cells are clipped with input scalars or a clip function
+  if ( this->ClipFunction )
+    {
+    pScalars = vtkDoubleArray::New();
+    pScalars->SetNumberOfTuples( numbPnts );
+    pScalars->SetName( "ClipDataSetScalars" );
+
+    // enable clipDataSetScalars to be passed to the output
+    if ( this->GenerateClipScalars )
+      {
+      cpyInput->GetPointData()->SetScalars( pScalars );
+      }
+
+    for ( i = 0; i < numbPnts; i ++ )
+      {
+      double s = this->ClipFunction->FunctionValue(  cpyInput->GetPoint( i )  );
+      pScalars->SetTuple1( i, s );
+      }
+
+    clipAray = pScalars;
+    }
+  else //using input scalars
+    {
+    clipAray = this->GetInputArrayToProcess( 0, inputVector );
+    if ( !clipAray )
+      {
+      vtkErrorMacro( << "no input scalars." << endl );
+      return 1;
+      }
+    }
+
+
+  int    gridType = cpyInput->GetDataObjectType();
+  double isoValue = ( !this->ClipFunction || this->UseValueAsOffset )
+                    ?  this->Value  :  0.0;
+  if ( gridType == VTK_IMAGE_DATA || gridType == VTK_STRUCTURED_POINTS )
+    {
+    int   numbDims;
+    int * dataDims = vtkImageData::SafeDownCast( cpyInput )->GetDimensions();
+    for ( numbDims = 3, i = 0; i < 3; i ++ )
+      {
+      numbDims -= (  ( dataDims[i] <= 1 ) ? 1 : 0  );
+      }
+    dataDims = NULL;
+
+    if ( numbDims == 3 )
+      {
+      this->ClipImageData( cpyInput.GetPointer(), clipAray, isoValue, outputUG );
+      }
+    }
+  else
+  if ( gridType == VTK_POLY_DATA )
+    {
+    this->ClipPolyData( cpyInput.GetPointer(), clipAray, isoValue, outputUG );
+    }
+  else
+  if ( gridType == VTK_RECTILINEAR_GRID )
+    {
+    this->ClipRectilinearGridData( cpyInput.GetPointer(), clipAray,
+                                   isoValue, outputUG );
+    }
+  else
+  if ( gridType == VTK_STRUCTURED_GRID )
+    {
+    this->ClipStructuredGridData( cpyInput.GetPointer(), clipAray,
+                                  isoValue, outputUG );
+    }
+  else
+  if ( gridType == VTK_UNSTRUCTURED_GRID )
+    {
+    this->ClipUnstructuredGridData( cpyInput.GetPointer(), clipAray,
+                                    isoValue, outputUG );
+    }
+  else
+    {
+    this->ClipDataSet( cpyInput.GetPointer(), clipAray, outputUG );
+    }
+
+  outputUG->Squeeze();
+
+  if ( pScalars )
+    {
+    pScalars->Delete();
+    }
+  pScalars = NULL;
+  outputUG = NULL;
+  clipAray = NULL;
+
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipDataSet( vtkDataSet * pDataSet,
+     vtkDataArray * clipAray, vtkUnstructuredGrid * unstruct )
+{
+  vtkClipDataSet * clipData = vtkClipDataSet::New();
+  clipData->SetInputData( pDataSet );
+  clipData->SetValue( this->Value );
+  clipData->SetInsideOut( this->InsideOut );
+  clipData->SetClipFunction( this->ClipFunction );
+  clipData->SetUseValueAsOffset( this->UseValueAsOffset );
+  clipData->SetGenerateClipScalars( this->GenerateClipScalars );
+
+  if ( !this->ClipFunction )
+    {
+    pDataSet->GetPointData()->SetScalars( clipAray );
+    }
+
+  clipData->Update();
+  unstruct->ShallowCopy( clipData->GetOutput() );
+
+  clipData->Delete();
+  clipData = NULL;
+}
+
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipImageData( vtkDataSet * inputGrd,
+     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
+{
+  int                  i, j;
+  int                  dataDims[3];
+  double               spacings[3];
+  double               tmpValue = 0.0;
+  double             * dataBBox = NULL;
+  vtkImageData       * volImage = NULL;
+  vtkDoubleArray     * pxCoords = NULL;
+  vtkDoubleArray     * pyCoords = NULL;
+  vtkDoubleArray     * pzCoords = NULL;
+  vtkRectilinearGrid * rectGrid = NULL;
+
+  volImage = vtkImageData::SafeDownCast( inputGrd );
+  volImage->GetDimensions( dataDims );
+  volImage->GetSpacing( spacings );
+  dataBBox = volImage->GetBounds();
+
+  pxCoords = vtkDoubleArray::New();
+  pyCoords = vtkDoubleArray::New();
+  pzCoords = vtkDoubleArray::New();
+  vtkDoubleArray * tmpArays[3] = { pxCoords, pyCoords, pzCoords };
+  for ( j = 0; j < 3; j ++ )
+    {
+    tmpArays[j]->SetNumberOfComponents( 1 );
+    tmpArays[j]->SetNumberOfTuples( dataDims[j] );
+    for ( tmpValue  = dataBBox[ j << 1 ], i = 0; i < dataDims[j]; i ++,
+          tmpValue += spacings[j] )
+      {
+      tmpArays[j]->SetComponent( i, 0, tmpValue );
+      }
+    tmpArays[j] = NULL;
+    }
+
+  rectGrid = vtkRectilinearGrid::New();
+  rectGrid->SetDimensions( dataDims );
+  rectGrid->SetXCoordinates( pxCoords );
+  rectGrid->SetYCoordinates( pyCoords );
+  rectGrid->SetZCoordinates( pzCoords );
+  rectGrid->GetPointData()->ShallowCopy( volImage->GetPointData() );
+  rectGrid->GetCellData()->ShallowCopy( volImage->GetCellData() );
+
+  this->ClipRectilinearGridData( rectGrid, clipAray, isoValue, outputUG );
+
+  pxCoords->Delete();
+  pyCoords->Delete();
+  pzCoords->Delete();
+  rectGrid->Delete();
+  pxCoords = NULL;
+  pyCoords = NULL;
+  pzCoords = NULL;
+  rectGrid = NULL;
+  volImage = NULL;
+  dataBBox = NULL;
+}
+
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipPolyData( vtkDataSet * inputGrd,
+     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
+{
+  vtkPolyData * polyData = vtkPolyData::SafeDownCast( inputGrd );
+  int           numCells = polyData->GetNumberOfCells();
+
+  vtkTableBasedClipperVolumeFromVolume   * visItVFV = new
+  vtkTableBasedClipperVolumeFromVolume(
+     this->OutputPointsPrecision, polyData->GetNumberOfPoints(),
+     int(   pow(  double( numCells ),  double( 0.6667f )  )   ) * 5 + 100    );
+
+  vtkUnstructuredGrid * specials = vtkUnstructuredGrid::New();
+  specials->SetPoints( polyData->GetPoints() );
+  specials->GetPointData()->ShallowCopy( polyData->GetPointData() );
+  specials->Allocate( numCells );
+
+  vtkIdType   i;
+  vtkIdType   numbPnts = 0;
+  int         numCants = 0;  // number of cells not clipped by this filter
+
+  std::vector< vtkIdType > cants;
+  vtkTableBasedClipperPolyDataClipper clipper
+    ( this, polyData, clipAray, isoValue );
+  clipper.Execute( visItVFV, cants );
+
+  for ( numCants = 0; numCants < static_cast< int >( cants.size() );
+        numCants ++ )
+    {
+    i = cants[ numCants ];
+    vtkIdType * pntIndxs = NULL;
+    polyData->GetCellPoints( i, numbPnts, pntIndxs );
+    if ( numCants == 0 )
+      {
+      specials->GetCellData()
+              ->CopyAllocate( polyData->GetCellData(), numCells );
+      }
+
+    specials->InsertNextCell( polyData->GetCellType( i ), numbPnts, pntIndxs );
+    specials->GetCellData()
+            ->CopyData( polyData->GetCellData(), i, numCants );
+    }
+
+
+  int         toDelete = 0;
+  double    * theCords = NULL;
+  vtkPoints * inputPts = polyData->GetPoints();
+  if ( inputPts->GetDataType() == VTK_DOUBLE )
+    {
+    theCords = static_cast < double * > (  inputPts->GetVoidPointer( 0 )  );
+    }
+  else
+    {
+    toDelete = 1;
+    numbPnts = inputPts->GetNumberOfPoints();
+    theCords = new double [ numbPnts * 3 ];
+    for ( i = 0; i < numbPnts; i ++ )
+      {
+      inputPts->GetPoint( i, theCords + ( i << 1 ) + i );
+      }
+    }
+  inputPts = NULL;
+
+
+  if ( numCants > 0 )
+    {
+    vtkUnstructuredGrid * vtkUGrid  = vtkUnstructuredGrid::New();
+    this->ClipDataSet( specials, clipAray, vtkUGrid );
+
+    vtkUnstructuredGrid * visItGrd = vtkUnstructuredGrid::New();
+    visItVFV->ConstructDataSet( polyData, visItGrd, theCords );
+
+    vtkAppendFilter * appender = vtkAppendFilter::New();
+    appender->AddInputData( vtkUGrid );
+    appender->AddInputData( visItGrd );
+    appender->Update();
+
+    outputUG->ShallowCopy( appender->GetOutput() );
+
+    appender->Delete();
+    vtkUGrid->Delete();
+    visItGrd->Delete();
+    appender = NULL;
+    vtkUGrid = NULL;
+    visItGrd = NULL;
+    }
+  else
+    {
+    visItVFV->ConstructDataSet( polyData, outputUG, theCords );
+    }
+
+
+  specials->Delete();
+  delete visItVFV;
+  if ( toDelete )
+    {
+    delete [] theCords;
+    }
+  specials = NULL;
+  visItVFV = NULL;
+  theCords = NULL;
+  polyData = NULL;
+}
+
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipRectilinearGridData( vtkDataSet * inputGrd,
+     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
+{
+  vtkRectilinearGrid * rectGrid = vtkRectilinearGrid::SafeDownCast( inputGrd );
+
+  int   i, j;
+  int   numCells = 0;
+  int   rectDims[3];
+  rectGrid->GetDimensions( rectDims );
+  numCells = rectGrid->GetNumberOfCells();
+
+  vtkTableBasedClipperVolumeFromVolume   * visItVFV = new
+  vtkTableBasedClipperVolumeFromVolume(
+      this->OutputPointsPrecision, rectGrid->GetNumberOfPoints(),
+      int(   pow(  double( numCells ), double( 0.6667f )  )   ) * 5 + 100    );
+
+  // all the cells (hexahedra or quads) can be clipped
+  std::vector< vtkIdType > cants;
+  vtkTableBasedClipperRectilinearGridClipper clipper
+    ( this, rectGrid, clipAray, isoValue );
+  clipper.Execute( visItVFV, cants );
+
+
+  int            toDelete    = 0;
+  double       * theCords[3] = { NULL, NULL, NULL };
+  vtkDataArray * theArays[3] = { NULL, NULL, NULL };
+
+  if ( rectGrid->GetXCoordinates()->GetDataType() == VTK_DOUBLE &&
+       rectGrid->GetYCoordinates()->GetDataType() == VTK_DOUBLE &&
+       rectGrid->GetZCoordinates()->GetDataType() == VTK_DOUBLE
+     )
+    {
+    theCords[0] = static_cast < double * >
+                  (  rectGrid->GetXCoordinates()->GetVoidPointer( 0 )  );
+    theCords[1] = static_cast < double * >
+                  (  rectGrid->GetYCoordinates()->GetVoidPointer( 0 )  );
+    theCords[2] = static_cast < double * >
+                  (  rectGrid->GetZCoordinates()->GetVoidPointer( 0 )  );
+    }
+  else
+    {
+    toDelete    = 1;
+    theArays[0] = rectGrid->GetXCoordinates();
+    theArays[1] = rectGrid->GetYCoordinates();
+    theArays[2] = rectGrid->GetZCoordinates();
+    for ( j = 0; j < 3; j ++ )
+      {
+      theCords[j] = new double [ rectDims[j] ];
+      for ( i = 0; i < rectDims[j]; i ++ )
+        {
+        theCords[j][i] = theArays[j]->GetComponent( i, 0 );
+        }
+      theArays[j] = NULL;
+      }
+    }
+
+  visItVFV->ConstructDataSet
+            ( rectGrid,
+              outputUG, rectDims, theCords[0], theCords[1], theCords[2] );
+
+  delete visItVFV;
+  visItVFV = NULL;
+  rectGrid = NULL;
+
+  for ( i = 0; i < 3; i ++ )
+    {
+    if ( toDelete )
+      {
+      delete [] theCords[i];
+      }
+    theCords[i] = NULL;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipStructuredGridData( vtkDataSet * inputGrd,
+     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
+{
+  vtkStructuredGrid * strcGrid = vtkStructuredGrid::SafeDownCast( inputGrd );
+
+  int   i;
+  int   numbPnts = 0;
+  int   numCells = strcGrid->GetNumberOfCells();
+
+  vtkTableBasedClipperVolumeFromVolume  *  visItVFV = new
+  vtkTableBasedClipperVolumeFromVolume(
+      this->OutputPointsPrecision, strcGrid->GetNumberOfPoints(),
+      int(   pow(  double( numCells ), double( 0.6667f )  )   ) * 5 + 100    );
+
+  // all the cells (hexahedra or quads) can be clipped
+  std::vector< vtkIdType > cants;
+  vtkTableBasedClipperStructuredGridClipper clipper
+    ( this, strcGrid, clipAray, isoValue );
+  clipper.Execute( visItVFV, cants );
+
+  int         toDelete = 0;
+  double    * theCords = NULL;
+  vtkPoints * inputPts = strcGrid->GetPoints();
+  if ( inputPts->GetDataType() == VTK_DOUBLE )
+    {
+    theCords = static_cast < double * > (  inputPts->GetVoidPointer( 0 )  );
+    }
+  else
+    {
+    toDelete = 1;
+    numbPnts = inputPts->GetNumberOfPoints();
+    theCords = new double [ numbPnts * 3 ];
+    for ( i = 0; i < numbPnts; i ++ )
+      {
+      inputPts->GetPoint( i, theCords + ( i << 1 ) + i );
+      }
+    }
+  inputPts = NULL;
+
+  visItVFV->ConstructDataSet( strcGrid, outputUG, theCords );
+
+
+  delete visItVFV;
+  if ( toDelete )
+    {
+    delete [] theCords;
+    }
+  visItVFV = NULL;
+  theCords = NULL;
+  strcGrid = NULL;
+}
+
+//-----------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipUnstructuredGridData( vtkDataSet * inputGrd,
+     vtkDataArray * clipAray, double isoValue, vtkUnstructuredGrid * outputUG )
+{
+  vtkUnstructuredGrid * unstruct = vtkUnstructuredGrid::SafeDownCast( inputGrd );
+
+  vtkIdType   i;
+  vtkIdType   numbPnts = 0;
+  int         numCants = 0; // number of cells not clipped by this filter
+  int         numCells = unstruct->GetNumberOfCells();
+
+  // volume from volume
+  vtkTableBasedClipperVolumeFromVolume   * visItVFV = new
+  vtkTableBasedClipperVolumeFromVolume(
+      this->OutputPointsPrecision, unstruct->GetNumberOfPoints(),
+      int(   pow(  double( numCells ), double( 0.6667f )  )   ) * 5 + 100    );
+
+  // the stuffs that can not be clipped by this filter
+  vtkUnstructuredGrid * specials = vtkUnstructuredGrid::New();
+  specials->SetPoints( unstruct->GetPoints() );
+  specials->GetPointData()->ShallowCopy( unstruct->GetPointData() );
+  specials->Allocate( numCells );
+
+  std::vector< vtkIdType > cants;
+  vtkTableBasedClipperUnstructuredGridClipper clipper
+    ( this, unstruct, clipAray, isoValue );
+  clipper.Execute( visItVFV, cants );
+
+  for ( numCants = 0; numCants < static_cast< int >( cants.size() );
+        numCants ++ )
+    {
+    i = cants[ numCants ];
+    int cellType = unstruct->GetCellType( i );
+    if ( numCants == 0 )
+      {
+      specials->GetCellData()
+              ->CopyAllocate( unstruct->GetCellData(), numCells );
+      }
+    if ( cellType == VTK_POLYHEDRON )
+      {
+      vtkIdType nfaces, *facePtIds;
+      unstruct->GetFaceStream(i, nfaces, facePtIds);
+      specials->InsertNextCell(cellType, nfaces, facePtIds);
+      }
+    else
+      {
+      vtkIdType * pntIndxs = NULL;
+      unstruct->GetCellPoints( i, numbPnts, pntIndxs );
+      specials->InsertNextCell( cellType, numbPnts, pntIndxs );
+      }
+    specials->GetCellData()
+            ->CopyData( unstruct->GetCellData(), i, numCants );
+    }
 
   int         toDelete = 0;
   double    * theCords = NULL;
@@ -68,6 +68,10 @@
 //  advantages are gained by adopting the unique clipping and triangulation tables
 //  proposed by VisIt.
 //
+//  The cells of large inputs are clipped in parallel with vtkSMPTools, in
+//  pieces of consecutive cells whose results are merged in the order of the
+//  cells, so the output does not depend on the number of threads.
+//
 // .SECTION Caveats
 //  vtkTableBasedClipDataSet makes use of a hash table (that is provided by class
 //  maintained by internal class vtkTableBasedClipperDataSetFromVolume) to achieve
@@ -265,6 +265,10 @@ int vtkTransformFilter::RequestData(
     outCD->CopyVectorsOff();
     }
 
+  // The arrays passed share the memory of the input arrays until either is
+  // modified.
+  outPD->CopyOnWriteOn();
+  outCD->CopyOnWriteOn();
   outPD->PassData(pd);
   outCD->PassData(cd);
 
@@ -280,6 +284,7 @@ int vtkTransformFilter::RequestData(
       // by the output
       outFD->Delete();
       }
+    outFD->CopyOnWriteOn();
     outFD->PassData(inFD);
     }
 
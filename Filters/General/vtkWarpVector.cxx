@@ -126,7 +126,7 @@ void vtkWarpVectorExecute(vtkWarpVector *self,
   // call templated function
   switch (vectors->GetDataType())
     {
-    vtkDataArrayIteratorMacro(vectors,
+    vtkDataArrayReadIteratorMacro(vectors,
       vtkWarpVectorExecute2(self, begin, end, outPts, vtkDABegin));
     default:
       break;
@@ -210,7 +210,7 @@ int vtkWarpVector::RequestData(
   // call templated function
   switch (input->GetPoints()->GetDataType())
     {
-    vtkDataArrayIteratorMacro(input->GetPoints()->GetData(),
+    vtkDataArrayReadIteratorMacro(input->GetPoints()->GetData(),
       vtkWarpVectorExecute(this, vtkDABegin, vtkDAEnd,
                            static_cast<vtkDAValueType*>(outPtr), vectors));
     default:
@@ -0,0 +1,537 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetSurfaceFilterThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test verifies that vtkDataSetSurfaceFilter, which extracts the
+// external faces of grids of linear 3D cells in parallel when
+// ParallelFaceExtraction is on, outputs the same oriented faces, points and
+// data as its serial face hash, in the order of the input cells, with and
+// without ghost points, with the Sequential and ThreadPool back-ends. The
+// point and cell data hold several arrays of different types, so that their
+// tuples are copied by several threads at once. It also checks that the
+// faces cached when CacheTopology is on are reused while the cells of the
+// input stay the same, that each output gets its own polygons, and that the
+// serial face hash is used by default.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkVariant.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// The number of cells along each axis of the grid.
+static const int DIMENSION = 10;
+
+// A vtkDataSetSurfaceFilter always using the serial face hash, even with
+// ParallelFaceExtraction on.
+class SerialSurfaceFilter : public vtkDataSetSurfaceFilter
+{
+public:
+  static SerialSurfaceFilter* New();
+  vtkTypeMacro(SerialSurfaceFilter, vtkDataSetSurfaceFilter);
+
+protected:
+  virtual int ThreadedUnstructuredGridExecute(vtkDataSet*, vtkPolyData*)
+  {
+    return 0;
+  }
+};
+vtkStandardNewMacro(SerialSurfaceFilter);
+
+//------------------------------------------------------------------------------
+static vtkIdType GridPoint(int i, int j, int k)
+{
+  return i + (DIMENSION + 1) * (j + (DIMENSION + 1) * k);
+}
+
+//------------------------------------------------------------------------------
+// Adds double arrays of 3 components, unsigned char arrays of 1 component
+// and a string array, whose values depend on the tuple.
+static void AddArrays(vtkFieldData* data, vtkIdType numTuples,
+                      const std::string& prefix)
+{
+  for (int k = 0; k < 2; ++k)
+    {
+    vtkNew<vtkDoubleArray> doubles;
+    doubles->SetName((prefix + "Doubles" + (k ? "1" : "0")).c_str());
+    doubles->SetNumberOfComponents(3);
+    doubles->SetNumberOfTuples(numTuples);
+    vtkNew<vtkUnsignedCharArray> chars;
+    chars->SetName((prefix + "Chars" + (k ? "1" : "0")).c_str());
+    chars->SetNumberOfTuples(numTuples);
+    for (vtkIdType i = 0; i < numTuples; ++i)
+      {
+      doubles->SetTuple3(i, i + k, 0.5 * i, -1.0 * i);
+      chars->SetValue(i, static_cast<unsigned char>((i + k) % 251));
+      }
+    data->AddArray(doubles.GetPointer());
+    data->AddArray(chars.GetPointer());
+    }
+  vtkNew<vtkStringArray> strings;
+  strings->SetName((prefix + "Strings").c_str());
+  strings->SetNumberOfTuples(numTuples);
+  for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+    strings->SetValue(i, vtkVariant(i).ToString());
+    }
+  data->AddArray(strings.GetPointer());
+}
+
+//------------------------------------------------------------------------------
+// A grid of cubes split in layers of hexahedra, voxels, wedges, tetrahedra
+// and pyramids, with the ids of its points and cells as data.
+static void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= DIMENSION; ++k)
+    {
+    for (int j = 0; j <= DIMENSION; ++j)
+      {
+      for (int i = 0; i <= DIMENSION; ++i)
+        {
+        points->InsertNextPoint(i, j, k + 0.1 * i * j);
+        }
+      }
+    }
+  grid->Allocate();
+  for (int k = 0; k < DIMENSION; ++k)
+    {
+    for (int j = 0; j < DIMENSION; ++j)
+      {
+      for (int i = 0; i < DIMENSION; ++i)
+        {
+        // The corners of the cube, the bit 0 of their index for x, 1 for y
+        // and 2 for z.
+        vtkIdType c[8];
+        for (int n = 0; n < 8; ++n)
+          {
+          c[n] = GridPoint(i + (n & 1), j + ((n >> 1) & 1), k + (n >> 2));
+          }
+        switch (k % 5)
+          {
+          case 0:
+            {
+            vtkIdType hex[8] = { c[0], c[1], c[3], c[2],
+                                 c[4], c[5], c[7], c[6] };
+            grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+            break;
+            }
+          case 1:
+            grid->InsertNextCell(VTK_VOXEL, 8, c);
+            break;
+          case 2:
+            {
+            vtkIdType wedge1[6] = { c[0], c[1], c[3], c[4], c[5], c[7] };
+            vtkIdType wedge2[6] = { c[0], c[3], c[2], c[4], c[7], c[6] };
+            grid->InsertNextCell(VTK_WEDGE, 6, wedge1);
+            grid->InsertNextCell(VTK_WEDGE, 6, wedge2);
+            break;
+            }
+          case 3:
+            {
+            // The tetrahedra along the paths from the first corner to the
+            // last one.
+            int axes[3] = { 1, 2, 4 };
+            do
+              {
+              vtkIdType tetra[4] = { c[0], c[axes[0]], c[axes[0] + axes[1]],
+                                     c[7] };
+              grid->InsertNextCell(VTK_TETRA, 4, tetra);
+              }
+            while (std::next_permutation(axes, axes + 3));
+            break;
+            }
+          default:
+            {
+            vtkIdType center =
+              points->InsertNextPoint(i + 0.5, j + 0.5, k + 0.5);
+            const int bases[6][4] = { {0,2,3,1}, {4,5,7,6}, {0,1,5,4},
+                                      {2,6,7,3}, {0,4,6,2}, {1,3,7,5} };
+            for (int f = 0; f < 6; ++f)
+              {
+              vtkIdType pyramid[5] = { c[bases[f][0]], c[bases[f][1]],
+                                       c[bases[f][2]], c[bases[f][3]],
+                                       center };
+              grid->InsertNextCell(VTK_PYRAMID, 5, pyramid);
+              }
+            }
+          }
+        }
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfTuples(grid->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+    {
+    pointIds->SetValue(i, i);
+    }
+  grid->GetPointData()->AddArray(pointIds.GetPointer());
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(grid->GetNumberOfCells());
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+    {
+    cellIds->SetValue(i, i);
+    }
+  grid->GetCellData()->AddArray(cellIds.GetPointer());
+
+  AddArrays(grid->GetPointData(), grid->GetNumberOfPoints(), "Point");
+  AddArrays(grid->GetCellData(), grid->GetNumberOfCells(), "Cell");
+}
+
+//------------------------------------------------------------------------------
+// Checks that the tuple outId of the arrays added by AddArrays() to output
+// is the tuple inId.
+static bool SameTuples(vtkFieldData* input, vtkFieldData* output,
+                       vtkIdType inId, vtkIdType outId)
+{
+  for (int i = 0; i < input->GetNumberOfArrays(); ++i)
+    {
+    vtkAbstractArray* inArray = input->GetAbstractArray(i);
+    vtkAbstractArray* outArray = output->GetAbstractArray(inArray->GetName());
+    if (!outArray)
+      {
+      return false;
+      }
+    int numComps = inArray->GetNumberOfComponents();
+    for (int c = 0; c < numComps; ++c)
+      {
+      if (outArray->GetVariantValue(outId * numComps + c) !=
+          inArray->GetVariantValue(inId * numComps + c))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// The faces of a surface, as their original cell id followed by the
+// original ids of their points starting from the smallest one. Checks the
+// points and data of the surface against input.
+static bool GetFaces(vtkUnstructuredGrid* input, vtkPolyData* surface,
+                     std::multiset<std::vector<vtkIdType> >& faces,
+                     bool& cellOrder)
+{
+  vtkIdTypeArray* originalCellIds = vtkIdTypeArray::SafeDownCast(
+    surface->GetCellData()->GetArray("vtkOriginalCellIds"));
+  vtkIdTypeArray* originalPointIds = vtkIdTypeArray::SafeDownCast(
+    surface->GetPointData()->GetArray("vtkOriginalPointIds"));
+  vtkIdTypeArray* cellIds = vtkIdTypeArray::SafeDownCast(
+    surface->GetCellData()->GetArray("CellIds"));
+  vtkIdTypeArray* pointIds = vtkIdTypeArray::SafeDownCast(
+    surface->GetPointData()->GetArray("PointIds"));
+  if (!originalCellIds || !originalPointIds || !cellIds || !pointIds ||
+      surface->GetNumberOfCells() != surface->GetNumberOfPolys())
+    {
+    cerr << "Missing arrays or cells other than polygons." << endl;
+    return false;
+    }
+
+  for (vtkIdType ptId = 0; ptId < surface->GetNumberOfPoints(); ++ptId)
+    {
+    vtkIdType inputId = originalPointIds->GetValue(ptId);
+    double x[3], y[3];
+    surface->GetPoint(ptId, x);
+    input->GetPoint(inputId, y);
+    if (pointIds->GetValue(ptId) != inputId ||
+        x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+        !SameTuples(input->GetPointData(), surface->GetPointData(),
+                    inputId, ptId))
+      {
+      cerr << "Wrong point " << ptId << "." << endl;
+      return false;
+      }
+    }
+
+  faces.clear();
+  cellOrder = true;
+  vtkCellArray* polys = surface->GetPolys();
+  vtkIdType npts, *pts;
+  vtkIdType cellId = 0;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); ++cellId)
+    {
+    vtkIdType inputId = originalCellIds->GetValue(cellId);
+    if (cellIds->GetValue(cellId) != inputId ||
+        !SameTuples(input->GetCellData(), surface->GetCellData(),
+                    inputId, cellId))
+      {
+      cerr << "Wrong data for cell " << cellId << "." << endl;
+      return false;
+      }
+    if (cellId > 0 && inputId < originalCellIds->GetValue(cellId - 1))
+      {
+      cellOrder = false;
+      }
+    std::vector<vtkIdType> face(1, inputId);
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      face.push_back(originalPointIds->GetValue(pts[i]));
+      }
+    std::rotate(face.begin() + 1,
+                std::min_element(face.begin() + 1, face.end()), face.end());
+    faces.insert(face);
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Compare the surface of input with the one of the serial hash.
+static bool CheckSurface(vtkUnstructuredGrid* input, vtkPolyData* surface)
+{
+  vtkNew<SerialSurfaceFilter> serial;
+  serial->SetInputData(input);
+  serial->PassThroughCellIdsOn();
+  serial->PassThroughPointIdsOn();
+  serial->Update();
+
+  std::multiset<std::vector<vtkIdType> > faces, expectedFaces;
+  bool cellOrder, expectedCellOrder;
+  if (!GetFaces(input, surface, faces, cellOrder) ||
+      !GetFaces(input, serial->GetOutput(), expectedFaces, expectedCellOrder))
+    {
+    return false;
+    }
+  if (faces.empty() || faces != expectedFaces)
+    {
+    cerr << "Got " << faces.size() << " faces instead of "
+         << expectedFaces.size() << " faces of the serial hash." << endl;
+    return false;
+    }
+  if (!cellOrder)
+    {
+    cerr << "The faces do not follow the order of their cells." << endl;
+    return false;
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// The memory of the point ids of the polygons, which the outputs reusing
+// the same cached faces share until they are modified. Traversing the
+// polygons gets a pointer to their point ids and gives the output its own
+// copy, so it is checked before CheckSurface().
+static const vtkIdType* FacesMemory(vtkPolyData* surface)
+{
+  return surface->GetPolys()->GetData()->GetReadPointer(0);
+}
+
+//------------------------------------------------------------------------------
+static bool TestSurfaces(vtkUnstructuredGrid* grid)
+{
+  bool ok = true;
+
+  vtkNew<vtkDataSetSurfaceFilter> surface;
+  surface->SetInputData(grid);
+  surface->ParallelFaceExtractionOn();
+  surface->PassThroughCellIdsOn();
+  surface->PassThroughPointIdsOn();
+  surface->Update();
+  ok &= CheckSurface(grid, surface->GetOutput());
+
+  // Without the faces whose points are all ghosts.
+  vtkNew<vtkUnstructuredGrid> ghostGrid;
+  ghostGrid->ShallowCopy(grid);
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfTuples(grid->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < grid->GetNumberOfPoints(); ++ptId)
+    {
+    ghosts->SetValue(ptId, grid->GetPoint(ptId)[0] < 1.5 ?
+                     vtkDataSetAttributes::DUPLICATEPOINT : 0);
+    }
+  ghostGrid->GetPointData()->AddArray(ghosts.GetPointer());
+  surface->SetInputData(ghostGrid.GetPointer());
+  surface->Update();
+  ok &= CheckSurface(ghostGrid.GetPointer(), surface->GetOutput());
+
+  // The cached faces are reused with other points and other arrays holding
+  // the same cells, but not once the cells are modified.
+  vtkNew<vtkUnstructuredGrid> movingGrid;
+  movingGrid->DeepCopy(grid);
+  surface->CacheTopologyOn();
+  surface->SetInputData(movingGrid.GetPointer());
+  surface->Update();
+  vtkSmartPointer<vtkPolyData> cached = vtkSmartPointer<vtkPolyData>::New();
+  cached->ShallowCopy(surface->GetOutput());
+  const vtkIdType* cachedFaces = FacesMemory(cached);
+  ok &= CheckSurface(movingGrid.GetPointer(), surface->GetOutput());
+
+  vtkNew<vtkPoints> movedPoints;
+  movedPoints->DeepCopy(grid->GetPoints());
+  for (vtkIdType ptId = 0; ptId < movedPoints->GetNumberOfPoints(); ++ptId)
+    {
+    double x[3];
+    movedPoints->GetPoint(ptId, x);
+    movedPoints->SetPoint(ptId, 2.0 * x[0], x[1] - x[2], x[2]);
+    }
+  movingGrid->SetPoints(movedPoints.GetPointer());
+  surface->Update();
+  if (FacesMemory(surface->GetOutput()) != cachedFaces)
+    {
+    cerr << "The cached faces are not reused with moved points." << endl;
+    ok = false;
+    }
+  ok &= CheckSurface(movingGrid.GetPointer(), surface->GetOutput());
+  if (surface->GetOutput()->GetPolys() == cached->GetPolys())
+    {
+    cerr << "The outputs share their polygons." << endl;
+    ok = false;
+    }
+
+  // Modifying the polygons of an output leaves the cached faces alone.
+  vtkIdType* firstFace = surface->GetOutput()->GetPolys()->GetPointer();
+  std::swap(firstFace[1], firstFace[2]);
+  surface->GetOutput()->GetPolys()->Modified();
+  if (FacesMemory(surface->GetOutput()) == cachedFaces)
+    {
+    cerr << "The output polygons were modified in the cache." << endl;
+    ok = false;
+    }
+
+  vtkNew<vtkUnstructuredGrid> copiedGrid;
+  copiedGrid->DeepCopy(movingGrid.GetPointer());
+  surface->SetInputData(copiedGrid.GetPointer());
+  surface->Update();
+  if (FacesMemory(surface->GetOutput()) != cachedFaces)
+    {
+    cerr << "The cached faces are not reused with copied cells." << endl;
+    ok = false;
+    }
+  ok &= CheckSurface(copiedGrid.GetPointer(), surface->GetOutput());
+
+  // The cached faces are reused with another ghost array holding the same
+  // values, but not once these values change.
+  vtkNew<vtkUnstructuredGrid> ghostCopy;
+  ghostCopy->DeepCopy(ghostGrid.GetPointer());
+  surface->SetInputData(ghostCopy.GetPointer());
+  surface->Update();
+  vtkSmartPointer<vtkPolyData> ghostCached =
+    vtkSmartPointer<vtkPolyData>::New();
+  ghostCached->ShallowCopy(surface->GetOutput());
+  const vtkIdType* ghostFaces = FacesMemory(ghostCached);
+  if (ghostFaces == cachedFaces)
+    {
+    cerr << "The cached faces are reused with other ghost values." << endl;
+    ok = false;
+    }
+  ok &= CheckSurface(ghostCopy.GetPointer(), surface->GetOutput());
+  surface->SetInputData(ghostGrid.GetPointer());
+  surface->Update();
+  if (FacesMemory(surface->GetOutput()) != ghostFaces)
+    {
+    cerr << "The cached faces are not reused with copied ghosts." << endl;
+    ok = false;
+    }
+  ok &= CheckSurface(ghostGrid.GetPointer(), surface->GetOutput());
+  for (vtkIdType ptId = 0; ptId < ghosts->GetNumberOfTuples(); ++ptId)
+    {
+    ghosts->SetValue(ptId, 0);
+    }
+  ghosts->Modified();
+  ghostGrid->Modified();
+  surface->Update();
+  ok &= CheckSurface(ghostGrid.GetPointer(), surface->GetOutput());
+  if (FacesMemory(surface->GetOutput()) == ghostFaces)
+    {
+    cerr << "The cached faces are reused with modified ghosts." << endl;
+    ok = false;
+    }
+  surface->SetInputData(copiedGrid.GetPointer());
+
+  // Turn the first hexahedron inside out.
+  vtkIdType* hex = copiedGrid->GetCells()->GetPointer() + 1;
+  std::swap_ranges(hex, hex + 4, hex + 4);
+  copiedGrid->GetCells()->Modified();
+  copiedGrid->Modified();
+  surface->Update();
+  ok &= CheckSurface(copiedGrid.GetPointer(), surface->GetOutput());
+  if (FacesMemory(surface->GetOutput()) == cachedFaces)
+    {
+    cerr << "The cached faces are reused with modified cells." << endl;
+    ok = false;
+    }
+
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+int TestDataSetSurfaceFilterThreads(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid.GetPointer());
+
+  int status = TEST_SUCCESS;
+
+  // By default, the output is the one of the serial face hash.
+  vtkNew<vtkDataSetSurfaceFilter> serialByDefault;
+  serialByDefault->SetInputData(grid.GetPointer());
+  serialByDefault->Update();
+  vtkNew<SerialSurfaceFilter> serial;
+  serial->SetInputData(grid.GetPointer());
+  serial->Update();
+  vtkIdTypeArray* polys = serialByDefault->GetOutput()->GetPolys()->GetData();
+  vtkIdTypeArray* serialPolys = serial->GetOutput()->GetPolys()->GetData();
+  if (polys->GetNumberOfTuples() != serialPolys->GetNumberOfTuples() ||
+      !std::equal(polys->GetReadPointer(0),
+                  polys->GetReadPointer(polys->GetNumberOfTuples()),
+                  serialPolys->GetReadPointer(0)))
+    {
+    cerr << "The faces are not extracted serially by default." << endl;
+    status = TEST_FAILURE;
+    }
+
+  const char* backends[2] = { "Sequential", "ThreadPool" };
+  for (int i = 0; i < 2; ++i)
+    {
+    if (!vtkSMPTools::SetBackend(backends[i]))
+      {
+      continue;
+      }
+    vtkSMPTools::Initialize(8);
+    if (!TestSurfaces(grid.GetPointer()))
+      {
+      cerr << "Surfaces differ with the " << backends[i] << " back-end."
+           << endl;
+      status = TEST_FAILURE;
+      }
+    }
+
+  return status;
+}
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
+#include "vtkDataSetAttributesCopier.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkHexahedron.h"
@@ -30,6 +31,8 @@
 #include "vtkPolyData.h"
 #include "vtkPyramid.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGridGeometryFilter.h"
@@ -46,6 +49,7 @@
 #include "vtkStructuredData.h"
 
 #include <algorithm>
+#include <vector>
 #include <vtksys/hash_map.hxx>
 
 #include <cassert>
@@ -99,6 +103,118 @@ protected:
   MapType Map;
 };
 
+// The external faces of an unstructured grid: the input cell of each output
+// polygon, the polygons, with the output point ids, and the input id of each
+// output point. When cached, the arrays the faces were extracted from are
+// held to recognize the next inputs with the same cells, along with a copy
+// of the point ghost values, which may be changed in place.
+class vtkDataSetSurfaceFilter::vtkUnstructuredGridFaces
+{
+public:
+  std::vector<vtkIdType> CellIds;
+  std::vector<vtkIdType> PointIds;
+  vtkSmartPointer<vtkCellArray> Polys;
+  unsigned long PolysMTime;
+
+  vtkSmartPointer<vtkCellArray> Cells;
+  unsigned long CellsMTime;
+  vtkSmartPointer<vtkUnsignedCharArray> Types;
+  unsigned long TypesMTime;
+  vtkSmartPointer<vtkUnsignedCharArray> Ghosts;
+  unsigned long GhostsMTime;
+  std::vector<unsigned char> GhostValues;
+  vtkIdType NumberOfPoints;
+
+  vtkUnstructuredGridFaces()
+    : PolysMTime(0), CellsMTime(0), TypesMTime(0), GhostsMTime(0),
+      NumberOfPoints(0) {}
+
+  void Record(vtkUnstructuredGrid* grid)
+  {
+    this->Cells = grid->GetCells();
+    this->CellsMTime = this->Cells->GetMTime();
+    this->Types = grid->GetCellTypesArray();
+    this->TypesMTime = this->Types->GetMTime();
+    this->Ghosts = grid->GetPointGhostArray();
+    this->GhostsMTime = this->Ghosts ? this->Ghosts->GetMTime() : 0;
+    this->GhostValues.clear();
+    if (this->Ghosts)
+      {
+      const unsigned char* ghosts = this->Ghosts->GetPointer(0);
+      this->GhostValues.assign(
+        ghosts, ghosts + this->Ghosts->GetNumberOfTuples());
+      }
+    this->NumberOfPoints = grid->GetNumberOfPoints();
+    this->PolysMTime = this->Polys->GetMTime();
+  }
+
+  // Whether the point ghost values of grid are those the faces were
+  // extracted with.
+  bool MatchesGhosts(vtkUnsignedCharArray* ghosts)
+  {
+    if (!ghosts || !this->Ghosts)
+      {
+      return !ghosts && !this->Ghosts;
+      }
+    vtkIdType numPts = ghosts->GetNumberOfTuples();
+    return numPts == static_cast<vtkIdType>(this->GhostValues.size()) &&
+      std::equal(ghosts->GetPointer(0), ghosts->GetPointer(0) + numPts,
+                 this->GhostValues.begin());
+  }
+
+  // Whether the faces were extracted from cells and point ghost values
+  // identical to those of grid.
+  bool Matches(vtkUnstructuredGrid* grid)
+  {
+    vtkCellArray* cells = grid->GetCells();
+    vtkUnsignedCharArray* types = grid->GetCellTypesArray();
+    vtkUnsignedCharArray* ghosts = grid->GetPointGhostArray();
+    // The polygons are shared with the outputs, which may have changed them.
+    if (!this->Cells || !this->Types ||
+        this->Polys->GetMTime() != this->PolysMTime ||
+        grid->GetNumberOfPoints() != this->NumberOfPoints)
+      {
+      return false;
+      }
+    bool sameGhosts = ghosts == this->Ghosts.GetPointer() &&
+      (!ghosts || ghosts->GetMTime() == this->GhostsMTime);
+    bool sameCells = cells == this->Cells.GetPointer() &&
+      cells->GetMTime() == this->CellsMTime &&
+      types == this->Types.GetPointer() &&
+      types->GetMTime() == this->TypesMTime;
+    if (sameGhosts && sameCells)
+      {
+      return true;
+      }
+    // Other arrays, such as those of the next time step of a reader, may
+    // hold the same cells and ghost values. A modified cell array cannot be
+    // compared with itself, so it never matches.
+    if (!sameGhosts && !this->MatchesGhosts(ghosts))
+      {
+      return false;
+      }
+    if (!sameCells)
+      {
+      vtkIdType size = cells->GetNumberOfConnectivityEntries();
+      vtkIdType numCells = types->GetNumberOfTuples();
+      if (cells == this->Cells.GetPointer() ||
+          types == this->Types.GetPointer() ||
+          size != this->Cells->GetNumberOfConnectivityEntries() ||
+          numCells != this->Types->GetNumberOfTuples() ||
+          !std::equal(cells->GetPointer(), cells->GetPointer() + size,
+                      this->Cells->GetPointer()) ||
+          !std::equal(types->GetPointer(0), types->GetPointer(0) + numCells,
+                      this->Types->GetPointer(0)))
+        {
+        return false;
+        }
+      }
+    this->Record(grid);
+    return true;
+  }
+};
+
+
 vtkStandardNewMacro(vtkDataSetSurfaceFilter);
 
 //----------------------------------------------------------------------------
@@ -128,6 +244,10 @@ vtkDataSetSurfaceFilter::vtkDataSetSurfaceFilter()
   this->OriginalPointIdsName = NULL;
 
   this->NonlinearSubdivisionLevel = 1;
+
+  this->ParallelFaceExtraction = 0;
+  this->CacheTopology = 0;
+  this->CachedFaces = NULL;
 }
 
 //----------------------------------------------------------------------------
@@ -144,6 +264,7 @@ vtkDataSetSurfaceFilter::~vtkDataSetSurfaceFilter()
     }
   this->SetOriginalCellIdsName(NULL);
   this->SetOriginalPointIdsName(NULL);
+  delete this->CachedFaces;
 }
 
 //----------------------------------------------------------------------------
@@ -1291,6 +1412,10 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "NonlinearSubdivisionLevel: "
      << this->NonlinearSubdivisionLevel << endl;
+  os << indent << "ParallelFaceExtraction: "
+     << (this->ParallelFaceExtraction ? "On\n" : "Off\n");
+  os << indent << "CacheTopology: "
+     << (this->CacheTopology ? "On\n" : "Off\n");
 }
 
 //========================================================================
@@ -1303,6 +1428,11 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
                                                      vtkPolyData *output)
 {
+  if (this->ThreadedUnstructuredGridExecute(dataSetInput, output))
+    {
+    return 1;
+    }
+
   vtkUnstructuredGridBase *input =
       vtkUnstructuredGridBase::SafeDownCast(dataSetInput);
 
@@ -1997,6 +2127,550 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   return 1;
 }
 
+namespace
+{
+// The faces of the cell types handled by the threaded extraction, oriented as
+// in UnstructuredGridExecute(), triangles ending with -1.
+const int vtkSurfaceTetraFaces[4][4] =
+  { {0,1,3,-1}, {0,2,1,-1}, {0,3,2,-1}, {1,2,3,-1} };
+const int vtkSurfaceHexahedronFaces[6][4] =
+  { {0,1,5,4}, {0,3,2,1}, {0,4,7,3}, {1,2,6,5}, {2,3,7,6}, {4,5,6,7} };
+const int vtkSurfaceVoxelFaces[6][4] =
+  { {0,1,5,4}, {0,2,3,1}, {0,4,6,2}, {1,3,7,5}, {2,6,7,3}, {4,5,7,6} };
+const int vtkSurfaceWedgeFaces[5][4] =
+  { {0,1,2,-1}, {3,5,4,-1}, {0,3,4,1}, {1,4,5,2}, {2,5,3,0} };
+const int vtkSurfacePyramidFaces[5][4] =
+  { {0,3,2,1}, {0,1,4,-1}, {1,2,4,-1}, {2,3,4,-1}, {3,0,4,-1} };
+
+typedef int vtkSurfaceFaceVerts[4];
+
+const vtkSurfaceFaceVerts* vtkSurfaceCellFaces(int cellType, int& numFaces)
+{
+  switch (cellType)
+    {
+    case VTK_TETRA:
+      numFaces = 4;
+      return vtkSurfaceTetraFaces;
+    case VTK_HEXAHEDRON:
+      numFaces = 6;
+      return vtkSurfaceHexahedronFaces;
+    case VTK_VOXEL:
+      numFaces = 6;
+      return vtkSurfaceVoxelFaces;
+    case VTK_WEDGE:
+      numFaces = 5;
+      return vtkSurfaceWedgeFaces;
+    case VTK_PYRAMID:
+      numFaces = 5;
+      return vtkSurfacePyramidFaces;
+    }
+  numFaces = 0;
+  return NULL;
+}
+
+// A face of a cell, identified by its point ids: the smallest first, then
+// the smaller of its two neighbors, so that the faces with the same points
+// in the same cyclic order, in either direction, have the same key. The
+// last id is -1 for triangles, whose key is then just the sorted ids.
+struct vtkSurfaceFace
+{
+  vtkIdType Key[4];
+  vtkIdType Face; // The cell id times 8 plus the index of the face.
+
+  bool operator<(const vtkSurfaceFace& other) const
+  {
+    for (int i = 0; i < 4; ++i)
+      {
+      if (this->Key[i] != other.Key[i])
+        {
+        return this->Key[i] < other.Key[i];
+        }
+      }
+    return this->Face < other.Face;
+  }
+  bool SamePoints(const vtkSurfaceFace& other) const
+  {
+    return this->Key[0] == other.Key[0] && this->Key[1] == other.Key[1] &&
+      this->Key[2] == other.Key[2] && this->Key[3] == other.Key[3];
+  }
+};
+
+typedef std::vector<std::vector<vtkSurfaceFace> > vtkSurfacePartitions;
+
+// Gives access to the faces of the cells of a grid.
+class vtkSurfaceCellFunctor
+{
+public:
+  const vtkIdType* Connectivity;
+  const vtkIdType* Locations;
+  const unsigned char* Types;
+
+  vtkSurfaceCellFunctor(vtkUnstructuredGrid* grid)
+    : Connectivity(grid->GetCells()->GetPointer()),
+      Locations(grid->GetCellLocationsArray()->GetPointer(0)),
+      Types(grid->GetCellTypesArray()->GetPointer(0))
+  {
+  }
+
+  // The number of points of the face, and its points starting from the
+  // smallest one in its cyclic order.
+  int GetFace(vtkIdType face, vtkIdType pts[4])
+  {
+    vtkIdType cellId = face >> 3;
+    int numFaces;
+    const int* verts =
+      vtkSurfaceCellFaces(this->Types[cellId], numFaces)[face & 7];
+    const vtkIdType* cellPts = this->Connectivity + this->Locations[cellId] + 1;
+    int numPts = verts[3] < 0 ? 3 : 4;
+    int first = 0;
+    for (int i = 1; i < numPts; ++i)
+      {
+      if (cellPts[verts[i]] < cellPts[verts[first]])
+        {
+        first = i;
+        }
+      }
+    for (int i = 0; i < numPts; ++i)
+      {
+      pts[i] = cellPts[verts[(first + i) % numPts]];
+      }
+    return numPts;
+  }
+};
+
+// Hashes the faces of the cells of each thread into partitions by their
+// smallest point id.
+class vtkSurfaceFaceHasher : public vtkSurfaceCellFunctor
+{
+public:
+  vtkIdType NumberOfPoints;
+  vtkIdType NumberOfPartitions;
+  vtkSMPThreadLocal<vtkSurfacePartitions> Partitions;
+  std::vector<vtkSurfacePartitions*> ThreadPartitions;
+
+  vtkSurfaceFaceHasher(vtkUnstructuredGrid* grid, vtkIdType numPartitions)
+    : vtkSurfaceCellFunctor(grid),
+      NumberOfPoints(grid->GetNumberOfPoints()),
+      NumberOfPartitions(numPartitions)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Partitions.Local().resize(this->NumberOfPartitions);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkSurfacePartitions& partitions = this->Partitions.Local();
+    vtkSurfaceFace face;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      int numFaces;
+      vtkSurfaceCellFaces(this->Types[cellId], numFaces);
+      for (int f = 0; f < numFaces; ++f)
+        {
+        face.Face = (cellId << 3) | f;
+        vtkIdType* key = face.Key;
+        if (this->GetFace(face.Face, key) == 3)
+          {
+          if (key[2] < key[1])
+            {
+            std::swap(key[1], key[2]);
+            }
+          key[3] = -1;
+          }
+        else if (key[3] < key[1])
+          {
+          std::swap(key[1], key[3]);
+          }
+        partitions[key[0] * this->NumberOfPartitions /
+                   this->NumberOfPoints].push_back(face);
+        }
+      }
+  }
+
+  void Reduce()
+  {
+    vtkSMPThreadLocal<vtkSurfacePartitions>::iterator iter;
+    for (iter = this->Partitions.begin(); iter != this->Partitions.end();
+         ++iter)
+      {
+      this->ThreadPartitions.push_back(&*iter);
+      }
+  }
+};
+
+// Merges the faces of each partition hashed by all the threads and keeps
+// those found once, unless all their points are ghosts.
+class vtkSurfaceFaceMerger
+{
+public:
+  std::vector<vtkSurfacePartitions*> ThreadPartitions;
+  const unsigned char* Ghosts;
+  std::vector<std::vector<vtkIdType> > Visible;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<vtkSurfaceFace> faces;
+    for (vtkIdType p = begin; p < end; ++p)
+      {
+      faces.clear();
+      for (size_t t = 0; t < this->ThreadPartitions.size(); ++t)
+        {
+        std::vector<vtkSurfaceFace>& part = (*this->ThreadPartitions[t])[p];
+        faces.insert(faces.end(), part.begin(), part.end());
+        std::vector<vtkSurfaceFace>().swap(part);
+        }
+      std::sort(faces.begin(), faces.end());
+      size_t numFaces = faces.size();
+      for (size_t i = 0; i < numFaces; )
+        {
+        size_t j = i + 1;
+        while (j < numFaces && faces[j].SamePoints(faces[i]))
+          {
+          ++j;
+          }
+        if (j == i + 1 && !this->AllGhosts(faces[i]))
+          {
+          this->Visible[p].push_back(faces[i].Face);
+          }
+        i = j;
+        }
+      }
+  }
+
+  bool AllGhosts(const vtkSurfaceFace& face)
+  {
+    if (!this->Ghosts)
+      {
+      return false;
+      }
+    for (int i = 0; i < 4 && face.Key[i] >= 0; ++i)
+      {
+      if (this->Ghosts[face.Key[i]] == 0)
+        {
+        return false;
+        }
+      }
+    return true;
+  }
+};
+
+// Sizes the output polygons and marks the points they use.
+class vtkSurfaceFaceCounter : public vtkSurfaceCellFunctor
+{
+public:
+  const vtkIdType* Faces;
+  vtkIdType* Sizes;
+  unsigned char* UsedPoints;
+
+  vtkSurfaceFaceCounter(vtkUnstructuredGrid* grid)
+    : vtkSurfaceCellFunctor(grid), Faces(NULL), Sizes(NULL), UsedPoints(NULL)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType pts[4];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      int numPts = this->GetFace(this->Faces[i], pts);
+      this->Sizes[i] = numPts + 1;
+      // Several threads may mark the same point, always with the same value.
+      for (int j = 0; j < numPts; ++j)
+        {
+        this->UsedPoints[pts[j]] = 1;
+        }
+      }
+  }
+};
+
+// Writes the output polygons at the locations given by the scan of their
+// sizes.
+class vtkSurfaceFaceWriter : public vtkSurfaceCellFunctor
+{
+public:
+  const vtkIdType* Faces;
+  const vtkIdType* Locations;
+  const vtkIdType* PointMap;
+  vtkIdType* Polys;
+  vtkIdType* CellIds;
+
+  vtkSurfaceFaceWriter(vtkUnstructuredGrid* grid)
+    : vtkSurfaceCellFunctor(grid), Faces(NULL), Locations(NULL),
+      PointMap(NULL), Polys(NULL), CellIds(NULL)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType pts[4];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      int numPts = this->GetFace(this->Faces[i], pts);
+      vtkIdType* poly = this->Polys + this->Locations[i];
+      *poly++ = numPts;
+      for (int j = 0; j < numPts; ++j)
+        {
+        poly[j] = this->PointMap[pts[j]];
+        }
+      this->CellIds[i] = this->Faces[i] >> 3;
+      }
+  }
+};
+
+// Stores the input id of each output point.
+class vtkSurfacePointIdsWriter
+{
+public:
+  const unsigned char* UsedPoints;
+  const vtkIdType* PointMap;
+  vtkIdType* PointIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+      if (this->UsedPoints[ptId])
+        {
+        this->PointIds[this->PointMap[ptId]] = ptId;
+        }
+      }
+  }
+};
+
+// Copies the output points, or cells, and their data from the input.
+class vtkSurfaceDataCopier
+{
+public:
+  const vtkIdType* InputIds;
+  vtkPoints* InputPoints;
+  vtkPoints* OutputPoints;
+  vtkDataSetAttributesCopier* DataCopier;
+  vtkIdType* OriginalIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType inputId = this->InputIds[i];
+      if (this->OutputPoints)
+        {
+        this->InputPoints->GetPoint(inputId, x);
+        this->OutputPoints->SetPoint(i, x);
+        }
+      this->DataCopier->Copy(inputId, i);
+      if (this->OriginalIds)
+        {
+        this->OriginalIds[i] = inputId;
+        }
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+int vtkDataSetSurfaceFilter::ThreadedUnstructuredGridExecute(
+  vtkDataSet *dataSetInput, vtkPolyData *output)
+{
+  vtkUnstructuredGrid *input = vtkUnstructuredGrid::SafeDownCast(dataSetInput);
+  if (!this->ParallelFaceExtraction || !this->CacheTopology)
+    {
+    delete this->CachedFaces;
+    this->CachedFaces = NULL;
+    }
+  if (!this->ParallelFaceExtraction ||
+      !input || !input->GetPoints() || !input->GetCells() ||
+      !input->GetCellTypesArray() || !input->GetCellLocationsArray())
+    {
+    return 0;
+    }
+
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkUnsignedCharArray *ghosts = input->GetPointGhostArray();
+
+  vtkUnstructuredGridFaces *faces = this->CachedFaces;
+  if (!faces || !faces->Matches(input))
+    {
+    delete this->CachedFaces;
+    this->CachedFaces = NULL;
+
+    const unsigned char *types = input->GetCellTypesArray()->GetPointer(0);
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+      int numFaces;
+      if (!vtkSurfaceCellFaces(types[cellId], numFaces))
+        {
+        return 0;
+        }
+      }
+
+    // Hash the faces of the cells in a few partitions per thread, then keep
+    // the faces found once in each partition.
+    vtkIdType numPartitions =
+      std::min(static_cast<vtkIdType>(
+                 8 * vtkSMPTools::GetEstimatedNumberOfThreads()), numPts);
+    vtkSurfaceFaceHasher hasher(input, numPartitions);
+    vtkSMPTools::For(0, numCells, hasher);
+    this->UpdateProgress(0.4);
+
+    vtkSurfaceFaceMerger merger;
+    merger.ThreadPartitions = hasher.ThreadPartitions;
+    merger.Ghosts = ghosts ? ghosts->GetPointer(0) : NULL;
+    merger.Visible.resize(numPartitions);
+    vtkSMPTools::For(0, numPartitions, 1, merger);
+    this->UpdateProgress(0.6);
+
+    // The output polygons follow the order of their cells.
+    std::vector<vtkIdType> visible;
+    for (vtkIdType p = 0; p < numPartitions; ++p)
+      {
+      visible.insert(visible.end(), merger.Visible[p].begin(),
+                     merger.Visible[p].end());
+      std::vector<vtkIdType>().swap(merger.Visible[p]);
+      }
+    vtkSMPTools::Sort(visible.begin(), visible.end());
+    vtkIdType numFaces = static_cast<vtkIdType>(visible.size());
+
+    // Size the polygons and number their points, then write them.
+    faces = new vtkUnstructuredGridFaces;
+    std::vector<vtkIdType> locations(numFaces);
+    std::vector<unsigned char> usedPoints(numPts, 0);
+    vtkIdType connectivitySize = 0;
+    vtkIdType numNewPts = 0;
+    std::vector<vtkIdType> pointMap(numPts);
+    if (numFaces > 0)
+      {
+      vtkSurfaceFaceCounter counter(input);
+      counter.Faces = &visible[0];
+      counter.Sizes = &locations[0];
+      counter.UsedPoints = &usedPoints[0];
+      vtkSMPTools::For(0, numFaces, counter);
+
+      vtkIdType lastSize = locations[numFaces - 1];
+      vtkSMPTools::ExclusiveScan(locations.begin(), locations.end(),
+                                 locations.begin(), static_cast<vtkIdType>(0));
+      connectivitySize = locations[numFaces - 1] + lastSize;
+      vtkSMPTools::ExclusiveScan(usedPoints.begin(), usedPoints.end(),
+                                 pointMap.begin(), static_cast<vtkIdType>(0));
+      numNewPts = pointMap[numPts - 1] + usedPoints[numPts - 1];
+      }
+
+    vtkNew<vtkIdTypeArray> polys;
+    polys->SetNumberOfValues(connectivitySize);
+    faces->CellIds.resize(numFaces);
+    faces->PointIds.resize(numNewPts);
+    if (numFaces > 0)
+      {
+      vtkSurfaceFaceWriter writer(input);
+      writer.Faces = &visible[0];
+      writer.Locations = &locations[0];
+      writer.PointMap = &pointMap[0];
+      writer.Polys = polys->GetPointer(0);
+      writer.CellIds = &faces->CellIds[0];
+      vtkSMPTools::For(0, numFaces, writer);
+
+      vtkSurfacePointIdsWriter pointIdsWriter;
+      pointIdsWriter.UsedPoints = &usedPoints[0];
+      pointIdsWriter.PointMap = &pointMap[0];
+      pointIdsWriter.PointIds = &faces->PointIds[0];
+      vtkSMPTools::For(0, numPts, pointIdsWriter);
+      }
+    faces->Polys = vtkSmartPointer<vtkCellArray>::New();
+    faces->Polys->SetCells(numFaces, polys.GetPointer());
+    faces->Record(input);
+    this->UpdateProgress(0.8);
+    }
+
+  // Copy the points and the data of the faces.
+  vtkPointData *inputPD = input->GetPointData();
+  vtkCellData *inputCD = input->GetCellData();
+  vtkPointData *outputPD = output->GetPointData();
+  vtkCellData *outputCD = output->GetCellData();
+  vtkIdType numNewPts = static_cast<vtkIdType>(faces->PointIds.size());
+  vtkIdType numNewCells = static_cast<vtkIdType>(faces->CellIds.size());
+
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(input->GetPoints()->GetData()->GetDataType());
+  newPts->SetNumberOfPoints(numNewPts);
+  outputPD->CopyGlobalIdsOn();
+  outputPD->CopyAllocate(inputPD, numNewPts);
+  outputPD->SetNumberOfTuples(numNewPts);
+  vtkSmartPointer<vtkIdTypeArray> originalPointIds;
+  if (this->PassThroughPointIds)
+    {
+    originalPointIds = vtkSmartPointer<vtkIdTypeArray>::New();
+    originalPointIds->SetName(this->GetOriginalPointIdsName());
+    originalPointIds->SetNumberOfValues(numNewPts);
+    }
+  vtkDataSetAttributesCopier pointDataCopier;
+  pointDataCopier.Initialize(inputPD, outputPD);
+  vtkSurfaceDataCopier pointCopier;
+  pointCopier.InputIds = numNewPts ? &faces->PointIds[0] : NULL;
+  pointCopier.InputPoints = input->GetPoints();
+  pointCopier.OutputPoints = newPts.GetPointer();
+  pointCopier.DataCopier = &pointDataCopier;
+  pointCopier.OriginalIds =
+    originalPointIds ? originalPointIds->GetPointer(0) : NULL;
+  vtkSMPTools::For(0, numNewPts, pointCopier);
+
+  outputCD->CopyGlobalIdsOn();
+  outputCD->CopyAllocate(inputCD, numNewCells);
+  outputCD->SetNumberOfTuples(numNewCells);
+  vtkSmartPointer<vtkIdTypeArray> originalCellIds;
+  if (this->PassThroughCellIds)
+    {
+    originalCellIds = vtkSmartPointer<vtkIdTypeArray>::New();
+    originalCellIds->SetName(this->GetOriginalCellIdsName());
+    originalCellIds->SetNumberOfValues(numNewCells);
+    }
+  vtkDataSetAttributesCopier cellDataCopier;
+  cellDataCopier.Initialize(inputCD, outputCD);
+  vtkSurfaceDataCopier cellCopier;
+  cellCopier.InputIds = numNewCells ? &faces->CellIds[0] : NULL;
+  cellCopier.InputPoints = NULL;
+  cellCopier.OutputPoints = NULL;
+  cellCopier.DataCopier = &cellDataCopier;
+  cellCopier.OriginalIds =
+    originalCellIds ? originalCellIds->GetPointer(0) : NULL;
+  vtkSMPTools::For(0, numNewCells, cellCopier);
+
+  if (originalCellIds)
+    {
+    outputCD->AddArray(originalCellIds);
+    }
+  if (originalPointIds)
+    {
+    outputPD->AddArray(originalPointIds);
+    }
+  output->SetPoints(newPts.GetPointer());
+
+  if (this->CacheTopology)
+    {
+    // The output gets its own cell array, whose connectivity shares the
+    // memory of the cached one until either is modified.
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->ShallowCopy(faces->Polys->GetData());
+    vtkNew<vtkCellArray> polys;
+    polys->SetCells(faces->Polys->GetNumberOfCells(),
+                    connectivity.GetPointer());
+    output->SetPolys(polys.GetPointer());
+    this->CachedFaces = faces;
+    }
+  else
+    {
+    output->SetPolys(faces->Polys);
+    delete faces;
+    }
+
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkDataSetSurfaceFilter::InitializeQuadHash(vtkIdType numPoints)
 {
@@ -18,6 +18,17 @@
 // does not have an option to select bounds.  It may use more memory than
 // vtkGeometryFilter.  It only has one option: whether to use triangle strips
 // when the input type is structured.
+//
+// When ParallelFaceExtraction is on, the external faces of unstructured
+// grids made only of tetrahedra, hexahedra, voxels, wedges and pyramids
+// are found in parallel with vtkSMPTools: each thread hashes the faces of
+// its cells by their point ids, and the faces found only once are then
+// picked out in parallel. The output polygons then follow the order of the
+// cells they come from, with the points in the order of their ids, which
+// differs from the order of the serial face hash used otherwise. When
+// CacheTopology is also on, these faces are kept and reused as long as the
+// cells of the input do not change, so that only the points and the data
+// are copied for the next time steps of a simulation whose points move.
 
 // .SECTION See Also
 // vtkGeometryFilter vtkStructuredGridGeometryFilter.
@@ -112,6 +123,30 @@ public:
   vtkSetMacro(NonlinearSubdivisionLevel, int);
   vtkGetMacro(NonlinearSubdivisionLevel, int);
 
+  // Description:
+  // If on, the external faces of unstructured grids made only of linear 3D
+  // cells are extracted in parallel (see above). The output points and
+  // polygons are then in another order than with the serial face hash.
+  // Off by default.
+  vtkSetMacro(ParallelFaceExtraction, int);
+  vtkGetMacro(ParallelFaceExtraction, int);
+  vtkBooleanMacro(ParallelFaceExtraction, int);
+
+  // Description:
+  // If on, the external faces extracted in parallel from an unstructured
+  // grid (see above) are kept for the next executions, which reuse them if
+  // the cell connectivity, cell types and point ghost values of their input
+  // are the same as those of the grid they were extracted from, even if its
+  // points or its other data changed. The connectivity and types arrays of
+  // that grid are held, and compared to the new ones unless they are the
+  // same unmodified arrays. A copy of the ghost values is kept, to which
+  // the new ghost array is compared unless it is the same unmodified array.
+  // Each output gets its own polygons, sharing the memory of the cached
+  // ones until either is modified. Off by default.
+  vtkSetMacro(CacheTopology, int);
+  vtkGetMacro(CacheTopology, int);
+  vtkBooleanMacro(CacheTopology, int);
+
   // Description:
   // Direct access methods that can be used to use the this class as an
   // algorithm without using it as a filter.
@@ -245,6 +280,24 @@ protected:
 
   int NonlinearSubdivisionLevel;
 
+  // Description:
+  // Extract the external faces of an unstructured grid in parallel, or
+  // reuse the cached ones. Returns 0, leaving output alone, if
+  // ParallelFaceExtraction is off, or if input is not a
+  // vtkUnstructuredGrid made only of cells whose faces are known, in
+  // which case UnstructuredGridExecute() uses the serial face hash.
+  // Subclasses that override the hash insertion methods should override
+  // this method to return 0.
+  virtual int ThreadedUnstructuredGridExecute(vtkDataSet *input,
+                                              vtkPolyData *output);
+
+  int ParallelFaceExtraction;
+  int CacheTopology;
+//BTX
+  class vtkUnstructuredGridFaces;
+//ETX
+  vtkUnstructuredGridFaces *CachedFaces;
+
 private:
   vtkDataSetSurfaceFilter(const vtkDataSetSurfaceFilter&);  // Not implemented.
   void operator=(const vtkDataSetSurfaceFilter&);  // Not implemented.
@@ -0,0 +1,301 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPCutter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test verifies that vtkSMPCutter cuts an unstructured grid of
+// tetrahedra, quadrilaterals and lines by several planes into the same
+// points and cells as vtkCutter, up to their order, with the cell data
+// following the cells. It also checks that a cut function not known to be
+// thread safe is evaluated by one thread.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCutter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPlane.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPCutter.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// The number of points along each axis of the grid.
+static const int DIMENSION = 41;
+
+// A plane counting its evaluations, which is not safe to evaluate from
+// several threads.
+class CountingPlane : public vtkPlane
+{
+public:
+  static CountingPlane* New();
+  vtkTypeMacro(CountingPlane, vtkPlane);
+
+  vtkIdType NumberOfEvaluations;
+  vtkMultiThreaderIDType Thread;
+  bool SeveralThreads;
+
+  virtual double EvaluateFunction(double x[3])
+  {
+    vtkMultiThreaderIDType thread = vtkMultiThreader::GetCurrentThreadID();
+    if (this->NumberOfEvaluations++ == 0)
+      {
+      this->Thread = thread;
+      }
+    else if (!vtkMultiThreader::ThreadsEqual(thread, this->Thread))
+      {
+      this->SeveralThreads = true;
+      }
+    return this->vtkPlane::EvaluateFunction(x);
+  }
+  virtual double EvaluateFunction(double x, double y, double z)
+  {
+    return this->vtkImplicitFunction::EvaluateFunction(x, y, z);
+  }
+
+protected:
+  CountingPlane() : NumberOfEvaluations(0), SeveralThreads(false) {}
+};
+
+vtkStandardNewMacro(CountingPlane);
+
+//------------------------------------------------------------------------------
+// Five tetrahedra per voxel, with a quadrilateral and a line along its
+// edges every hundred voxels, and the ids of the cells as cell data.
+static void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < DIMENSION; ++k)
+    {
+    for (int j = 0; j < DIMENSION; ++j)
+      {
+      for (int i = 0; i < DIMENSION; ++i)
+        {
+        points->InsertNextPoint(i, j, k);
+        }
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->Allocate(6 * DIMENSION * DIMENSION * DIMENSION);
+
+  static const int tetras[5][4] =
+    { { 0, 1, 3, 5 }, { 0, 3, 2, 6 }, { 0, 5, 4, 6 }, { 3, 5, 6, 7 },
+      { 0, 3, 6, 5 } };
+  for (int k = 0; k < DIMENSION - 1; ++k)
+    {
+    for (int j = 0; j < DIMENSION - 1; ++j)
+      {
+      for (int i = 0; i < DIMENSION - 1; ++i)
+        {
+        vtkIdType voxel[8];
+        for (int c = 0; c < 8; ++c)
+          {
+          voxel[c] = (i + (c & 1)) + DIMENSION * ((j + ((c >> 1) & 1)) +
+                                                  DIMENSION * (k + (c >> 2)));
+          }
+        for (int t = 0; t < 5; ++t)
+          {
+          vtkIdType tetra[4];
+          for (int c = 0; c < 4; ++c)
+            {
+            tetra[c] = voxel[tetras[t][c]];
+            }
+          grid->InsertNextCell(VTK_TETRA, 4, tetra);
+          }
+        if ((i + DIMENSION * (j + DIMENSION * k)) % 100 == 0)
+          {
+          vtkIdType quad[4] = { voxel[0], voxel[1], voxel[5], voxel[4] };
+          grid->InsertNextCell(VTK_QUAD, 4, quad);
+          vtkIdType line[2] = { voxel[0], voxel[7] };
+          grid->InsertNextCell(VTK_LINE, 2, line);
+          }
+        }
+      }
+    }
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(grid->GetNumberOfCells());
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+    {
+    cellIds->SetValue(i, i);
+    }
+  grid->GetCellData()->AddArray(cellIds.GetPointer());
+}
+
+//------------------------------------------------------------------------------
+// The sorted ids of the input cells the cells of the given array come from,
+// those of the polys following those of the verts and lines.
+static std::vector<vtkIdType> CellIds(vtkPolyData* polyData,
+                                      vtkCellArray* cells, vtkIdType offset)
+{
+  vtkIdTypeArray* cellIds = vtkIdTypeArray::SafeDownCast(
+    polyData->GetCellData()->GetArray("CellIds"));
+  std::vector<vtkIdType> ids;
+  for (vtkIdType i = 0; cellIds && i < cells->GetNumberOfCells(); ++i)
+    {
+    ids.push_back(cellIds->GetValue(offset + i));
+    }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+//------------------------------------------------------------------------------
+static std::vector<double> SortedPoints(vtkPolyData* polyData)
+{
+  std::vector<double> points;
+  std::vector<std::vector<double> > sorted(polyData->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < polyData->GetNumberOfPoints(); ++i)
+    {
+    double* x = polyData->GetPoint(i);
+    sorted[i].assign(x, x + 3);
+    }
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t i = 0; i < sorted.size(); ++i)
+    {
+    points.insert(points.end(), sorted[i].begin(), sorted[i].end());
+    }
+  return points;
+}
+
+//------------------------------------------------------------------------------
+static bool SameCuts(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfVerts() != b->GetNumberOfVerts() ||
+      a->GetNumberOfLines() != b->GetNumberOfLines() ||
+      a->GetNumberOfPolys() != b->GetNumberOfPolys())
+    {
+    cerr << "Output sizes differ: " << a->GetNumberOfPoints() << " points, "
+         << a->GetNumberOfVerts() << " verts, " << a->GetNumberOfLines()
+         << " lines, " << a->GetNumberOfPolys() << " polys, and "
+         << b->GetNumberOfPoints() << " points, "
+         << b->GetNumberOfVerts() << " verts, " << b->GetNumberOfLines()
+         << " lines, " << b->GetNumberOfPolys() << " polys." << endl;
+    return false;
+    }
+  if (SortedPoints(a) != SortedPoints(b))
+    {
+    cerr << "Output points differ." << endl;
+    return false;
+    }
+  vtkIdType numVerts = a->GetNumberOfVerts();
+  vtkIdType numLines = a->GetNumberOfLines();
+  if (CellIds(a, a->GetVerts(), 0) != CellIds(b, b->GetVerts(), 0) ||
+      CellIds(a, a->GetLines(), numVerts) !=
+        CellIds(b, b->GetLines(), numVerts) ||
+      CellIds(a, a->GetPolys(), numVerts + numLines) !=
+        CellIds(b, b->GetPolys(), numVerts + numLines))
+    {
+    cerr << "Output cell data differ." << endl;
+    return false;
+    }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int TestSMPCutter(int, char*[])
+{
+  // Use several threads even when the default back-end is sequential.
+  vtkSMPTools::SetBackend("ThreadPool");
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid.GetPointer());
+
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0, 0, 0);
+  plane->SetNormal(1, 0.71, 0.33);
+
+  vtkNew<vtkTimerLog> timer;
+  int status = TEST_SUCCESS;
+  for (int generateTriangles = 1; generateTriangles >= 0; --generateTriangles)
+    {
+    vtkNew<vtkCutter> cutter;
+    cutter->SetInputData(grid.GetPointer());
+    cutter->SetCutFunction(plane.GetPointer());
+    cutter->SetGenerateTriangles(generateTriangles);
+    cutter->SetSortBy(VTK_SORT_BY_VALUE);
+    cutter->GenerateValues(5, 5.5, 45.5);
+    timer->StartTimer();
+    cutter->Update();
+    timer->StopTimer();
+    cout << "Serial cut: " << timer->GetElapsedTime() << endl;
+
+    vtkNew<vtkSMPCutter> smpCutter;
+    smpCutter->SetInputData(grid.GetPointer());
+    smpCutter->SetCutFunction(plane.GetPointer());
+    smpCutter->SetGenerateTriangles(generateTriangles);
+    smpCutter->GenerateValues(5, 5.5, 45.5);
+    timer->StartTimer();
+    smpCutter->Update();
+    timer->StopTimer();
+    cout << "Parallel cut: " << timer->GetElapsedTime() << endl;
+
+    if (cutter->GetOutput()->GetNumberOfPolys() == 0 ||
+        cutter->GetOutput()->GetNumberOfLines() == 0 ||
+        cutter->GetOutput()->GetNumberOfVerts() == 0)
+      {
+      cerr << "Missing cuts." << endl;
+      status = TEST_FAILURE;
+      }
+    if (!SameCuts(cutter->GetOutput(), smpCutter->GetOutput()))
+      {
+      cerr << "Cuts differ with GenerateTriangles " << generateTriangles
+           << endl;
+      status = TEST_FAILURE;
+      }
+    }
+
+  // A cut function of another class is evaluated serially, unless
+  // ThreadSafeCutFunction is on.
+  vtkNew<CountingPlane> countingPlane;
+  countingPlane->SetOrigin(plane->GetOrigin());
+  countingPlane->SetNormal(plane->GetNormal());
+  vtkNew<vtkCutter> cutter;
+  cutter->SetInputData(grid.GetPointer());
+  cutter->SetCutFunction(plane.GetPointer());
+  cutter->GenerateValues(5, 5.5, 45.5);
+  cutter->Update();
+  vtkNew<vtkSMPCutter> smpCutter;
+  smpCutter->SetInputData(grid.GetPointer());
+  smpCutter->SetCutFunction(countingPlane.GetPointer());
+  smpCutter->GenerateValues(5, 5.5, 45.5);
+  smpCutter->Update();
+  if (countingPlane->NumberOfEvaluations != grid->GetNumberOfPoints() ||
+      countingPlane->SeveralThreads)
+    {
+    cerr << "The cut function was evaluated "
+         << countingPlane->NumberOfEvaluations << " times"
+         << (countingPlane->SeveralThreads ? " by several threads." : ".")
+         << endl;
+    status = TEST_FAILURE;
+    }
+  if (!SameCuts(cutter->GetOutput(), smpCutter->GetOutput()))
+    {
+    cerr << "Cuts differ with a cut function evaluated serially." << endl;
+    status = TEST_FAILURE;
+    }
+
+  return status;
+}
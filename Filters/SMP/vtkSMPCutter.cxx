@@ -0,0 +1,469 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPCutter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPCutter.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkContourHelper.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImplicitFunction.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPMergePoints.h"
+#include "vtkSMPMergePolyDataHelper.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+vtkStandardNewMacro(vtkSMPCutter);
+
+//----------------------------------------------------------------------------
+vtkSMPCutter::vtkSMPCutter()
+{
+  this->ThreadSafeCutFunction = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkSMPCutter::~vtkSMPCutter()
+{
+}
+
+namespace
+{
+
+// This functor evaluates the cut function at the points of the input.
+class vtkCutFunctionFunctor
+{
+public:
+  vtkUnstructuredGrid* Input;
+  vtkImplicitFunction* CutFunction;
+  double* CutScalars;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType ptId=begin; ptId<end; ptId++)
+      {
+      this->Input->GetPoint(ptId, x);
+      this->CutScalars[ptId] = this->CutFunction->FunctionValue(x);
+      }
+  }
+};
+
+struct vtkCutterLocalData
+{
+  vtkPolyData* Output;
+  vtkSMPMergePoints* Locator;
+  vtkIdList* VertOffsets;
+  vtkIdList* LineOffsets;
+  vtkIdList* PolyOffsets;
+  vtkContourHelper* Helper;
+  vtkGenericCell* Cell;
+  vtkDoubleArray* CellScalars;
+
+  vtkCutterLocalData() : Output(0)
+    {
+    }
+};
+
+// This functor cuts the cells of one dimension by all the cut values, each
+// thread adding to its own vtkPolyData. The 1D, 2D and then 3D cells are
+// cut in separate passes, so that the cell data of each vtkPolyData lists
+// its verts, then its lines and its polys, as vtkSMPMergePolyDataHelper
+// expects.
+class vtkCutterFunctor
+{
+public:
+  vtkSMPCutter* Filter;
+  vtkUnstructuredGrid* Input;
+  vtkDoubleArray* CutScalars;
+  vtkPointData* InPd;
+  int NumValues;
+  double* Values;
+  int Dimensionality;
+  unsigned char CellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+
+  vtkSMPThreadLocal<vtkCutterLocalData> LocalData;
+
+  vtkCutterFunctor(vtkSMPCutter* filter,
+                   vtkUnstructuredGrid* input,
+                   vtkDoubleArray* cutScalars,
+                   vtkPointData* inPd) : Filter(filter),
+                                         Input(input),
+                                         CutScalars(cutScalars),
+                                         InPd(inPd),
+                                         Dimensionality(0)
+  {
+    this->NumValues = filter->GetNumberOfContours();
+    this->Values = filter->GetValues();
+    vtkCutter::GetCellTypeDimensions(this->CellTypeDimensions);
+  }
+
+  ~vtkCutterFunctor()
+  {
+    vtkSMPThreadLocal<vtkCutterLocalData>::iterator dataIter =
+      this->LocalData.begin();
+    while(dataIter != this->LocalData.end())
+      {
+      delete (*dataIter).Helper;
+      (*dataIter).Output->Delete();
+      (*dataIter).Locator->Delete();
+      (*dataIter).VertOffsets->Delete();
+      (*dataIter).LineOffsets->Delete();
+      (*dataIter).PolyOffsets->Delete();
+      (*dataIter).Cell->Delete();
+      (*dataIter).CellScalars->Delete();
+      ++dataIter;
+      }
+  }
+
+  void Initialize()
+  {
+    // This gets called once per thread and pass, the thread local data
+    // persist across the passes.
+    vtkCutterLocalData& localData = this->LocalData.Local();
+    if (localData.Output)
+      {
+      return;
+      }
+
+    vtkIdType estimatedSize = static_cast<vtkIdType>(
+      pow(static_cast<double>(this->Input->GetNumberOfCells()),.75)) *
+      this->NumValues;
+    estimatedSize = estimatedSize / 1024 * 1024; //multiple of 1024
+    if (estimatedSize < 1024)
+      {
+      estimatedSize = 1024;
+      }
+
+    vtkPolyData* output = vtkPolyData::New();
+    localData.Output = output;
+
+    vtkPoints* newPts = vtkPoints::New();
+    // set precision for the points in the output
+    if(this->Filter->GetOutputPointsPrecision() == vtkAlgorithm::DEFAULT_PRECISION)
+      {
+      newPts->SetDataType(this->Input->GetPoints()->GetDataType());
+      }
+    else if(this->Filter->GetOutputPointsPrecision() == vtkAlgorithm::SINGLE_PRECISION)
+      {
+      newPts->SetDataType(VTK_FLOAT);
+      }
+    else if(this->Filter->GetOutputPointsPrecision() == vtkAlgorithm::DOUBLE_PRECISION)
+      {
+      newPts->SetDataType(VTK_DOUBLE);
+      }
+    newPts->Allocate(estimatedSize, estimatedSize);
+    output->SetPoints(newPts);
+    newPts->Delete();
+
+    // All the locators have the same bins, which vtkSMPMergePoints needs
+    // to merge them, and as the default locator of vtkCutter, so that
+    // points are merged as vtkCutter merges them.
+    localData.Locator = vtkSMPMergePoints::New();
+    localData.Locator->InitPointInsertion(newPts, this->Input->GetBounds());
+
+    localData.VertOffsets = vtkIdList::New();
+    localData.VertOffsets->Allocate(estimatedSize);
+    localData.LineOffsets = vtkIdList::New();
+    localData.LineOffsets->Allocate(estimatedSize);
+    localData.PolyOffsets = vtkIdList::New();
+    localData.PolyOffsets->Allocate(estimatedSize);
+
+    vtkCellArray* newVerts = vtkCellArray::New();
+    newVerts->Allocate(estimatedSize,estimatedSize);
+    output->SetVerts(newVerts);
+    newVerts->Delete();
+
+    vtkCellArray* newLines = vtkCellArray::New();
+    newLines->Allocate(estimatedSize,estimatedSize);
+    output->SetLines(newLines);
+    newLines->Delete();
+
+    vtkCellArray* newPolys = vtkCellArray::New();
+    newPolys->Allocate(estimatedSize,estimatedSize);
+    output->SetPolys(newPolys);
+    newPolys->Delete();
+
+    vtkPointData* outPd = output->GetPointData();
+    vtkCellData* outCd = output->GetCellData();
+    vtkCellData* inCd = this->Input->GetCellData();
+    outPd->InterpolateAllocate(this->InPd, estimatedSize, estimatedSize);
+    outCd->CopyAllocate(inCd, estimatedSize, estimatedSize);
+
+    localData.Helper = new vtkContourHelper(localData.Locator,
+                                            newVerts,
+                                            newLines,
+                                            newPolys,
+                                            this->InPd,
+                                            inCd,
+                                            outPd,
+                                            outCd,
+                                            estimatedSize,
+                                            this->Filter->GetGenerateTriangles() != 0);
+
+    localData.Cell = vtkGenericCell::New();
+    localData.CellScalars = vtkDoubleArray::New();
+    localData.CellScalars->Allocate(VTK_CELL_SIZE);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkCutterLocalData& localData = this->LocalData.Local();
+
+    vtkUnstructuredGrid* input = this->Input;
+    vtkGenericCell* cell = localData.Cell;
+    vtkDoubleArray* cellScalars = localData.CellScalars;
+    vtkContourHelper* helper = localData.Helper;
+    const double* scalars = this->CutScalars->GetPointer(0);
+
+    vtkCellArray* verts = localData.Output->GetVerts();
+    vtkCellArray* lines = localData.Output->GetLines();
+    vtkCellArray* polys = localData.Output->GetPolys();
+
+    const double* values = this->Values;
+    const double* valuesEnd = values + this->NumValues;
+    int dimensionality = this->Dimensionality;
+
+    vtkIdType npts, *pts;
+    double range[2];
+
+    for (vtkIdType cellId=begin; cellId<end; cellId++)
+      {
+      int cellType = input->GetCellType(cellId);
+      if (cellType >= VTK_NUMBER_OF_CELL_TYPES ||
+          this->CellTypeDimensions[cellType] != dimensionality)
+        {
+        continue;
+        }
+
+      input->GetCellPoints(cellId, npts, pts);
+
+      //find min and max values in scalar data
+      range[0] = range[1] = scalars[pts[0]];
+      for (vtkIdType i = 1; i < npts; i++)
+        {
+        double s = scalars[pts[i]];
+        range[0] = std::min(range[0], s);
+        range[1] = std::max(range[1], s);
+        } // for all points in this cell
+
+      // Check if the full cell is needed
+      const double* value;
+      for (value = values; value != valuesEnd; ++value)
+        {
+        if (*value >= range[0] && *value <= range[1])
+          {
+          break;
+          }
+        }
+      if (value == valuesEnd)
+        {
+        continue;
+        }
+
+      input->GetCell(cellId, cell);
+      cellScalars->SetNumberOfTuples(npts);
+      for (vtkIdType i = 0; i < npts; i++)
+        {
+        cellScalars->SetValue(i, scalars[pts[i]]);
+        }
+
+      // Loop over all contour values.
+      for (; value != valuesEnd; ++value)
+        {
+        if (*value < range[0] || *value > range[1])
+          {
+          continue;
+          }
+        vtkIdType begVertSize = verts->GetNumberOfConnectivityEntries();
+        vtkIdType begLineSize = lines->GetNumberOfConnectivityEntries();
+        vtkIdType begPolySize = polys->GetNumberOfConnectivityEntries();
+        helper->Contour(cell, *value, cellScalars, cellId);
+        // Keep track of where the cells of each cut start, for the parallel
+        // merge of the cell arrays.
+        if (verts->GetNumberOfConnectivityEntries() > begVertSize)
+          {
+          localData.VertOffsets->InsertNextId(begVertSize);
+          }
+        if (lines->GetNumberOfConnectivityEntries() > begLineSize)
+          {
+          localData.LineOffsets->InsertNextId(begLineSize);
+          }
+        if (polys->GetNumberOfConnectivityEntries() > begPolySize)
+          {
+          localData.PolyOffsets->InsertNextId(begPolySize);
+          }
+        } // for all contour values
+      } // for all cells
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPCutter::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkUnstructuredGrid *input = vtkUnstructuredGrid::GetData(inputVector[0]);
+  if (!input || !this->CutFunction ||
+      input->GetNumberOfPoints() < 1 || this->GetNumberOfContours() < 1)
+    {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+    }
+
+  vtkPolyData *output = vtkPolyData::GetData(outputVector);
+
+  vtkDebugMacro(<< "Executing threaded unstructured grid cutter");
+  this->ThreadedUnstructuredGridCutter(input, output);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMPCutter::ThreadedUnstructuredGridCutter(vtkUnstructuredGrid *input,
+                                                  vtkPolyData *output)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+
+  // Not thread safe so calculate first.
+  input->GetBounds();
+  if (numCells > 0)
+    {
+    input->GetCellType(0);
+    }
+
+  // Evaluate the cut function at all the points. The first evaluation is
+  // done here, in case the function has anything to update.
+  vtkDoubleArray *cutScalars = vtkDoubleArray::New();
+  cutScalars->SetNumberOfTuples(numPts);
+  vtkCutFunctionFunctor evaluate;
+  evaluate.Input = input;
+  evaluate.CutFunction = this->CutFunction;
+  evaluate.CutScalars = cutScalars->GetPointer(0);
+  if (this->CanEvaluateCutFunctionInParallel())
+    {
+    evaluate(0, 1);
+    vtkSMPTools::For(1, numPts, evaluate);
+    }
+  else
+    {
+    evaluate(0, numPts);
+    }
+
+  // Interpolate data along edge. If generating cut scalars, do necessary setup
+  vtkPointData *inPD;
+  if ( this->GenerateCutScalars )
+    {
+    inPD = vtkPointData::New();
+    inPD->ShallowCopy(input->GetPointData());//copies original attributes
+    inPD->SetScalars(cutScalars);
+    }
+  else
+    {
+    inPD = input->GetPointData();
+    }
+
+  // Cut the cells of each dimension in turn. We skip 0d cells (points),
+  // because they cannot be cut (generate no data).
+  vtkCutterFunctor cutter(this, input, cutScalars, inPD);
+  for (cutter.Dimensionality = 1; cutter.Dimensionality <= 3;
+       ++cutter.Dimensionality)
+    {
+    vtkSMPTools::For(0, numCells, cutter);
+    }
+
+  // Merge the outputs of the threads.
+  std::vector<vtkSMPMergePolyDataHelper::InputData> mpData;
+  vtkSMPThreadLocal<vtkCutterLocalData>::iterator itr =
+    cutter.LocalData.begin();
+  while (itr != cutter.LocalData.end())
+    {
+    mpData.push_back(vtkSMPMergePolyDataHelper::InputData((*itr).Output,
+                                                          (*itr).Locator,
+                                                          (*itr).VertOffsets,
+                                                          (*itr).LineOffsets,
+                                                          (*itr).PolyOffsets));
+    ++itr;
+    }
+  if (!mpData.empty())
+    {
+    vtkPolyData* moutput = vtkSMPMergePolyDataHelper::MergePolyData(mpData);
+    output->ShallowCopy(moutput);
+    moutput->Delete();
+    output->Squeeze();
+    }
+
+  cutScalars->Delete();
+  if ( this->GenerateCutScalars )
+    {
+    inPD->Delete();
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMPCutter::CanEvaluateCutFunctionInParallel()
+{
+  if (this->ThreadSafeCutFunction)
+    {
+    return true;
+    }
+  // The implicit functions whose EvaluateFunction() only reads their
+  // parameters. Subclasses may add state, so the exact class is checked.
+  static const char* statelessFunctions[] =
+    { "vtkBox", "vtkCone", "vtkCylinder", "vtkPlane", "vtkQuadric",
+      "vtkSphere", "vtkSuperquadric" };
+  if (this->CutFunction->GetTransform())
+    {
+    return false;
+    }
+  const char* className = this->CutFunction->GetClassName();
+  for (size_t i = 0;
+       i < sizeof(statelessFunctions) / sizeof(statelessFunctions[0]); ++i)
+    {
+    if (strcmp(className, statelessFunctions[i]) == 0)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMPCutter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Thread Safe Cut Function: "
+     << (this->ThreadSafeCutFunction ? "On\n" : "Off\n");
+}
@@ -0,0 +1,87 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPCutter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPCutter - a subclass of vtkCutter that cuts unstructured grids in parallel
+// .SECTION Description
+// vtkSMPCutter performs the same function as vtkCutter but cuts
+// vtkUnstructuredGrid inputs using multiple threads: the cut function is
+// evaluated at the points in parallel, then the cells are cut by all the
+// cut values in one pass, each thread producing its own vtkPolyData whose
+// points are merged by a vtkSMPMergePoints, and these outputs are finally
+// merged in parallel by vtkSMPMergePolyDataHelper.
+//
+// The cut function is evaluated at the points in parallel only when it is
+// known to be safe to call its FunctionValue() from several threads: when
+// it is a vtkPlane, vtkSphere, vtkBox, vtkCylinder, vtkCone, vtkQuadric or
+// vtkSuperquadric without a transform, or when ThreadSafeCutFunction is on.
+// Other implicit functions, such as vtkImplicitDataSet or vtkImplicitBoolean,
+// may update cached state during the evaluation and are evaluated by one
+// thread. The output lists, for each cell, the cuts of all the
+// values (as with VTK_SORT_BY_VALUE), and the order of its points and
+// cells depends on the number of threads. Progress is not reported
+// during the parallel passes. Other inputs are cut by vtkCutter.
+//
+// .SECTION See Also
+// vtkCutter vtkSMPContourGrid vtkThreadedSynchronizedTemplatesCutter3D
+
+#ifndef vtkSMPCutter_h
+#define vtkSMPCutter_h
+
+#include "vtkFiltersSMPModule.h" // For export macro
+#include "vtkCutter.h"
+
+class vtkUnstructuredGrid;
+
+class VTKFILTERSSMP_EXPORT vtkSMPCutter : public vtkCutter
+{
+public:
+  vtkTypeMacro(vtkSMPCutter,vtkCutter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Construct with user-specified implicit function; initial value of 0.0;
+  // and generating cut scalars turned off.
+  static vtkSMPCutter *New();
+
+  // Description:
+  // Set whether the FunctionValue() method of the cut function may be
+  // called from several threads at once. When off, the cut function is
+  // evaluated in parallel only if it is one of the stateless implicit
+  // functions listed above, and serially otherwise. Turn it on only for a
+  // function whose evaluation does not modify any state. Off by default.
+  vtkSetMacro(ThreadSafeCutFunction, int);
+  vtkGetMacro(ThreadSafeCutFunction, int);
+  vtkBooleanMacro(ThreadSafeCutFunction, int);
+
+protected:
+  vtkSMPCutter();
+  ~vtkSMPCutter();
+
+  virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+
+  void ThreadedUnstructuredGridCutter(vtkUnstructuredGrid *input,
+                                      vtkPolyData *output);
+
+  // Description:
+  // Whether the cut function can be evaluated from several threads.
+  bool CanEvaluateCutFunctionInParallel();
+
+  int ThreadSafeCutFunction;
+
+private:
+  vtkSMPCutter(const vtkSMPCutter&);  // Not implemented.
+  void operator=(const vtkSMPCutter&);  // Not implemented.
+};
+
+#endif
@@ -147,7 +147,8 @@ void vtkSMPMergePoints::Merge(vtkSMPMergePoints* locator,
 
   // points have to be added
   vtkIdType NumberOfInsertions = oldIdToMerge->GetNumberOfIds();
-  vtkIdType first_id = (this->AtomicInsertionId += NumberOfInsertions);
+  vtkIdType first_id =
+    (this->AtomicInsertionId += NumberOfInsertions) - NumberOfInsertions;
   bucket->Resize( bucket->GetNumberOfIds() + NumberOfInsertions );
   for ( i = 0; i < NumberOfInsertions; ++i )
     {
@@ -421,6 +421,18 @@ void vtkImageReaderUpdate1(vtkImageReader *self, vtkImageData *data, T *inPtr)
 void vtkImageReader::ExecuteDataWithInformation(vtkDataObject *output,
                                                 vtkInformation *outInfo)
 {
+  // Transformed or masked values must be read.
+  if (this->MemoryMapping && !this->Transform &&
+      this->DataMask == static_cast<vtkTypeUInt64>(~0UL))
+    {
+    vtkDataArray *scalars = this->MapFileData(output, outInfo);
+    if (scalars)
+      {
+      scalars->SetName(this->ScalarArrayName);
+      return;
+      }
+    }
+
   vtkImageData *data = this->AllocateOutputData(output, outInfo);
 
   void *ptr = NULL;
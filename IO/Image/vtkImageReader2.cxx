@@ -72,6 +72,8 @@ vtkImageReader2::vtkImageReader2()
   this->FileNameSliceOffset = 0;
   this->FileNameSliceSpacing = 1;
 
+  this->MemoryMapping = 0;
+
   // Left over from short reader
   this->SwapBytes = 0;
   this->FileLowerLeft = 0;
@@ -417,6 +419,9 @@ void vtkImageReader2::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Swap Bytes: " << (this->SwapBytes ? "On\n" : "Off\n");
 
+  os << indent << "MemoryMapping: "
+     << (this->MemoryMapping ? "On\n" : "Off\n");
+
   os << indent << "DataIncrements: (" << this->DataIncrements[0];
   for (idx = 1; idx < 2; ++idx)
     {
@@ -772,6 +777,16 @@ void vtkImageReader2Update(vtkImageReader2 *self, vtkImageData *data, OT *outPtr
 void vtkImageReader2::ExecuteDataWithInformation(vtkDataObject *output,
                                                  vtkInformation *outInfo)
 {
+  if (this->MemoryMapping)
+    {
+    vtkDataArray *scalars = this->MapFileData(output, outInfo);
+    if (scalars)
+      {
+      scalars->SetName("ImageFile");
+      return;
+      }
+    }
+
   vtkImageData *data = this->AllocateOutputData(output, outInfo);
 
   void *ptr;
@@ -803,6 +818,87 @@ void vtkImageReader2::ExecuteDataWithInformation(vtkDataObject *output,
     }
 }
 
+//----------------------------------------------------------------------------
+// The values of the update extent can be mapped when they are contiguous in
+// a single file and stored as they are in memory.
+vtkDataArray *vtkImageReader2::MapFileData(vtkDataObject *output,
+                                           vtkInformation *outInfo)
+{
+  vtkImageData *data = vtkImageData::SafeDownCast(output);
+  if (!data || this->MemoryBuffer || (!this->FileName && !this->FilePattern))
+    {
+    return NULL;
+    }
+  if ((this->SwapBytes &&
+       vtkAbstractArray::GetDataTypeSize(this->DataScalarType) > 1) ||
+      vtkImageData::GetScalarType(outInfo) != this->DataScalarType ||
+      vtkImageData::GetNumberOfScalarComponents(outInfo) !=
+      this->NumberOfScalarComponents)
+    {
+    return NULL;
+    }
+
+  int *ext = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
+  if (!ext || ext[0] > ext[1] || ext[2] > ext[3] || ext[4] > ext[5])
+    {
+    return NULL;
+    }
+  // Whole rows, whole slices unless there is a single one, and rows stored
+  // in the same order as in memory unless there is a single one.
+  if (ext[0] != this->DataExtent[0] || ext[1] != this->DataExtent[1] ||
+      (ext[4] != ext[5] &&
+       (ext[2] != this->DataExtent[2] || ext[3] != this->DataExtent[3])) ||
+      (!this->FileLowerLeft && ext[2] != ext[3]) ||
+      (this->FileDimensionality != 3 && ext[4] != ext[5]))
+    {
+    return NULL;
+    }
+
+  this->ComputeDataIncrements();
+  int slice = (this->FileDimensionality >= 3 ? 0 : ext[4]);
+
+  // The same position as SeekFile(ext[0], ext[2], ext[4]).
+  vtkTypeInt64 offset =
+    (ext[0] - this->DataExtent[0]) *
+    static_cast<vtkTypeInt64>(this->DataIncrements[0]);
+  if (this->FileLowerLeft)
+    {
+    offset += (ext[2] - this->DataExtent[2]) *
+      static_cast<vtkTypeInt64>(this->DataIncrements[1]);
+    }
+  else
+    {
+    offset += (this->DataExtent[3] - this->DataExtent[2] - ext[2]) *
+      static_cast<vtkTypeInt64>(this->DataIncrements[1]);
+    }
+  if (this->FileDimensionality >= 3)
+    {
+    offset += (ext[4] - this->DataExtent[4]) *
+      static_cast<vtkTypeInt64>(this->DataIncrements[2]);
+    }
+  offset += this->GetHeaderSize(slice);
+  this->ComputeInternalFileName(slice);
+
+  vtkIdType numberOfValues =
+    static_cast<vtkIdType>(ext[1] - ext[0] + 1) * (ext[3] - ext[2] + 1) *
+    (ext[5] - ext[4] + 1) * this->NumberOfScalarComponents;
+  vtkDataArray *scalars = vtkDataArray::CreateDataArray(this->DataScalarType);
+  scalars->SetNumberOfComponents(this->NumberOfScalarComponents);
+  if (!scalars->MapFile(this->InternalFileName, offset, numberOfValues, 1))
+    {
+    scalars->Delete();
+    return NULL;
+    }
+  vtkDebugMacro("Mapped extent: " << ext[0] << ", " << ext[1] << ", "
+                << ext[2] << ", " << ext[3] << ", " << ext[4] << ", "
+                << ext[5] << " from " << this->InternalFileName);
+
+  data->SetExtent(ext);
+  data->GetPointData()->SetScalars(scalars);
+  scalars->Delete();
+  return scalars;
+}
+
 //----------------------------------------------------------------------------
 void vtkImageReader2::SetMemoryBuffer(void *membuf)
 {
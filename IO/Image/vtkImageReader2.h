@@ -41,6 +41,7 @@
 #include "vtkIOImageModule.h" // For export macro
 #include "vtkImageAlgorithm.h"
 
+class vtkDataArray;
 class vtkStringArray;
 
 #define VTK_FILE_BYTE_ORDER_BIG_ENDIAN 0
@@ -206,6 +207,16 @@ public:
   vtkGetMacro(FileLowerLeft, int);
   vtkSetMacro(FileLowerLeft, int);
 
+  // Description:
+  // Map the file in memory instead of reading it, when the requested extent
+  // is contiguous in the file and its values need no conversion. The pages
+  // are then read by the system when they are first accessed. The mapping
+  // is copy-on-write: the output can be modified, the file never is. Off
+  // by default. Readers of compressed or encoded formats ignore it.
+  vtkSetMacro(MemoryMapping, int);
+  vtkGetMacro(MemoryMapping, int);
+  vtkBooleanMacro(MemoryMapping, int);
+
   // Description:
   // Set/Get the internal file name
   virtual void ComputeInternalFileName(int slice);
@@ -271,12 +282,20 @@ protected:
   int FileNameSliceOffset;
   int FileNameSliceSpacing;
 
+  int MemoryMapping;
+
   virtual int RequestInformation(vtkInformation* request,
                                  vtkInformationVector** inputVector,
                                  vtkInformationVector* outputVector);
   virtual void ExecuteInformation();
   virtual void ExecuteDataWithInformation(vtkDataObject *data, vtkInformation *outInfo);
   virtual void ComputeDataIncrements();
+
+  // Description:
+  // Set the scalars of the output to the values of the update extent,
+  // mapped from the file. Returns the scalars, or NULL if the values
+  // cannot be mapped and must be read.
+  vtkDataArray *MapFileData(vtkDataObject *output, vtkInformation *outInfo);
 private:
   vtkImageReader2(const vtkImageReader2&);  // Not implemented.
   void operator=(const vtkImageReader2&);  // Not implemented.
@@ -388,9 +388,11 @@ void vtkMPIImageReader::ExecuteDataWithInformation(vtkDataObject *output,
                                                    vtkInformation *outInfo)
 {
 #ifdef VTK_USE_MPI_IO
+  // Mapped files are paged in independently by each process, collective
+  // reads would only copy the values.
   vtkMPIController *MPIController
     = vtkMPIController::SafeDownCast(this->Controller);
-  if (!MPIController)
+  if (!MPIController || this->MemoryMapping)
     {
     this->Superclass::ExecuteDataWithInformation(output, outInfo);
     return;
@@ -39,6 +39,9 @@
 // use this class in applications that may or may not be compiled with MPI (or
 // may or may not actually be run with MPI).
 //
+// With MemoryMapping on, each process maps the part of the files it needs
+// instead, as vtkImageReader does, without collective reads.
+//
 // .SECTION See Also
 // vtkMultiProcessController, vtkImageReader, vtkImageReader2
 //
@@ -719,20 +719,24 @@ int vtkXMLDataReader::ReadArrayValues(
     return 0;
     }
   this->InReadData = 1;
-  int result;
-  // All arrays types except vtkBitArray.
-  vtkArrayIterator* iter = array->NewIterator();
-  switch (array->GetDataType())
-    {
-    vtkArrayIteratorTemplateMacro(
-      result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-        arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-  default:
-    result = 0;
-    }
-  if (iter)
+  int result = this->MapArrayValues(da, array, arrayIndex, startIndex,
+                                    numValues);
+  if (!result)
     {
-    iter->Delete();
+    // All arrays types except vtkBitArray.
+    vtkArrayIterator* iter = array->NewIterator();
+    switch (array->GetDataType())
+      {
+      vtkArrayIteratorTemplateMacro(
+        result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
+          arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
+    default:
+      result = 0;
+      }
+    if (iter)
+      {
+      iter->Delete();
+      }
     }
 
   this->ConvertGhostLevelsToGhostType(fieldType, array, startIndex, numValues);
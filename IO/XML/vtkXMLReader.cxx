@@ -15,6 +15,7 @@
 #include "vtkXMLReader.h"
 
 #include "vtkCallbackCommand.h"
+#include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataCompressor.h"
 #include "vtkDataSet.h"
@@ -88,6 +89,7 @@ vtkXMLReader::vtkXMLReader()
   this->StringStream = 0;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->MemoryMapping = 0;
   this->XMLParser = 0;
   this->FieldDataElement = 0;
   this->PointDataArraySelection = vtkDataArraySelection::New();
@@ -165,6 +167,8 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "Stream: (none)\n";
     }
+  os << indent << "MemoryMapping: "
+     << (this->MemoryMapping ? "On\n" : "Off\n");
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << ","
@@ -818,6 +822,34 @@ vtkAbstractArray* vtkXMLReader::CreateArray(vtkXMLDataElement* da)
   return array;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLReader::MapArrayValues(vtkXMLDataElement* da,
+                                 vtkAbstractArray* array,
+                                 vtkIdType arrayIndex, vtkIdType startIndex,
+                                 vtkIdType numValues)
+{
+  // Only whole arrays of appended data read from the file can be mapped.
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  if (!this->MemoryMapping || !dataArray || !this->FileName ||
+      !this->FileStream || this->Stream != this->FileStream ||
+      arrayIndex != 0 || numValues <= 0 ||
+      numValues != dataArray->GetNumberOfTuples() *
+      dataArray->GetNumberOfComponents() || !da->GetAttribute("offset"))
+    {
+    return 0;
+    }
+
+  vtkTypeInt64 offset = 0;
+  da->GetScalarAttribute("offset", offset);
+  vtkTypeInt64 position = this->XMLParser->GetAppendedDataStreamPosition(
+    offset, startIndex, numValues, dataArray->GetDataType());
+  if (position < 0)
+    {
+    return 0;
+    }
+  return dataArray->MapFile(this->FileName, position, numValues, 1);
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLReader::CanReadFile(const char* name)
 {
@@ -54,6 +54,16 @@ public:
   vtkBooleanMacro(ReadFromInputString,int);
   void SetInputString(std::string s) { this->InputString = s; }
 
+  // Description:
+  // Map the values of the arrays stored raw in the appended data of the
+  // file in memory instead of reading them, when they need no conversion.
+  // The pages are then read by the system when they are first accessed.
+  // The mapping is copy-on-write: the output can be modified, the file
+  // never is. Off by default.
+  vtkSetMacro(MemoryMapping, int);
+  vtkGetMacro(MemoryMapping, int);
+  vtkBooleanMacro(MemoryMapping, int);
+
   // Description:
   // Test whether the file (type) with the given name can be read by this
   // reader. If the file has a newer version than the reader, we still say
@@ -157,6 +167,13 @@ protected:
   // Does not allocate.
   vtkAbstractArray* CreateArray(vtkXMLDataElement* da);
 
+  // Map numValues values of an array element, from startIndex, to the
+  // whole array, when MemoryMapping is on and they can be used as they
+  // are stored in the file. Returns 0 if they must be read.
+  int MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array,
+                     vtkIdType arrayIndex, vtkIdType startIndex,
+                     vtkIdType numValues);
+
   // Create a vtkInformationKey from its coresponding XML representation.
   // Stores it in the instance of vtkInformationProvided. Does not allocate.
   int CreateInformationKey(vtkXMLDataElement *eInfoKey, vtkInformation *info);
@@ -236,6 +253,9 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether to map arrays from the file.
+  int MemoryMapping;
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
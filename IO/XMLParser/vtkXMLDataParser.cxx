@@ -916,6 +916,54 @@ size_t vtkXMLDataParser::ReadAppendedData(vtkTypeInt64 offset,
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkXMLDataParser::GetAppendedDataStreamPosition(
+  vtkTypeInt64 offset, vtkTypeUInt64 startWord, size_t numWords,
+  int wordType)
+{
+  // Base64 encoded, compressed and byte swapped data must be read.
+  if(this->Compressor ||
+     vtkBase64InputStream::SafeDownCast(this->AppendedDataStream))
+    {
+    return -1;
+    }
+#ifdef VTK_WORDS_BIGENDIAN
+  if(this->ByteOrder != vtkXMLDataParser::BigEndian)
+#else
+  if(this->ByteOrder != vtkXMLDataParser::LittleEndian)
+#endif
+    {
+    return -1;
+    }
+
+  // Read the length of the data.
+  this->DataStream = this->AppendedDataStream;
+  this->SeekG(this->AppendedDataPosition+offset);
+  this->DataStream->SetStream(this->Stream);
+  this->DataStream->StartReading();
+  vtksys::auto_ptr<vtkXMLDataHeader>
+    uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  size_t r = this->DataStream->Read(uh->Data(), headerSize);
+  this->DataStream->EndReading();
+  if(r < headerSize)
+    {
+    vtkErrorMacro("Error reading uncompressed binary data header.  "
+                  "Read " << r << " of " << headerSize << " bytes.");
+    return -1;
+    }
+  vtkTypeUInt64 size = uh->Get(0);
+
+  // Make sure the words fall within the data.
+  size_t wordSize = this->GetWordTypeSize(wordType);
+  if((startWord+numWords)*wordSize > size)
+    {
+    return -1;
+    }
+  return this->AppendedDataPosition + offset + headerSize +
+    static_cast<vtkTypeInt64>(startWord*wordSize);
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
@@ -73,6 +73,16 @@ public:
   { return this->ReadAppendedData(offset, buffer, startWord, numWords,
                                     VTK_CHAR); }
 
+  // Description:
+  // Get the position in the input stream of the first of numWords words,
+  // from startWord, of an appended data section starting at the given
+  // appended data offset. Returns -1 unless the words are stored as they
+  // are in memory: raw encoding, no compression and the byte order of this
+  // machine. They can then be used in place, e.g. mapped from the file.
+  vtkTypeInt64 GetAppendedDataStreamPosition(vtkTypeInt64 offset,
+                                             vtkTypeUInt64 startWord,
+                                             size_t numWords, int wordType);
+
   // Description:
   // Read from an ascii data section starting at the current position in
   // the stream.  Returns the number of words read.